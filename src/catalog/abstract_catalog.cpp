@@ -16,8 +16,10 @@
 
 #include "catalog/catalog.h"
 #include "catalog/database_catalog.h"
+#include "catalog/global_catalog_cache.h"
 #include "catalog/table_catalog.h"
 
+#include "concurrency/transaction_context.h"
 #include "index/index_factory.h"
 #include "optimizer/optimizer.h"
 #include "parser/postgresparser.h"
@@ -30,6 +32,7 @@
 
 #include "executor/executor_context.h"
 #include "executor/create_executor.h"
+#include "executor/logical_tile_factory.h"
 #include "executor/delete_executor.h"
 #include "executor/index_scan_executor.h"
 #include "executor/insert_executor.h"
@@ -41,6 +44,7 @@
 #include "storage/database.h"
 #include "storage/storage_manager.h"
 #include "storage/table_factory.h"
+#include "storage/tile.h"
 
 namespace peloton {
 namespace catalog {
@@ -57,6 +61,8 @@ AbstractCatalog::AbstractCatalog(storage::Database *pg_catalog,
       DEFAULT_TUPLES_PER_TILEGROUP, true, false, true);
   // Add catalog_table_ into pg_catalog database
   pg_catalog->AddTable(catalog_table_, true);
+  // Only DDL changes these catalogs, so their scans are cached server-wide
+  cached_ = true;
 }
 
 AbstractCatalog::AbstractCatalog(concurrency::TransactionContext *txn,
@@ -102,6 +108,7 @@ bool AbstractCatalog::InsertTuple(concurrency::TransactionContext *txn,
                                   std::unique_ptr<storage::Tuple> tuple) {
   if (txn == nullptr)
     throw CatalogException("Insert tuple requires transaction");
+  if (cached_) txn->SetCatalogModified();
 
   std::vector<type::Value> params;
   std::vector<std::string> columns;
@@ -143,6 +150,7 @@ bool AbstractCatalog::DeleteWithIndexScan(concurrency::TransactionContext *txn,
                                           std::vector<type::Value> values) {
   if (txn == nullptr)
     throw CatalogException("Delete tuple requires transaction");
+  if (cached_) txn->SetCatalogModified();
 
   std::unique_ptr<executor::ExecutorContext> context(
       new executor::ExecutorContext(txn));
@@ -196,6 +204,30 @@ AbstractCatalog::GetResultWithIndexScan(
     std::vector<type::Value> values) const {
   if (txn == nullptr) throw CatalogException("Scan table requires transaction");
 
+  std::unique_ptr<std::vector<std::unique_ptr<executor::LogicalTile>>>
+      result_tiles(new std::vector<std::unique_ptr<executor::LogicalTile>>());
+
+  // A transaction that changed the catalog must see its own changes, which
+  // are not in the global cache
+  auto &global_cache = GlobalCatalogCache::GetInstance();
+  bool use_cache = cached_ && !txn->IsCatalogModified();
+  std::string cache_key;
+  uint64_t cache_version = 0;
+  if (use_cache) {
+    cache_key = GlobalCatalogCache::GetKey(
+        catalog_table_->GetDatabaseOid(), catalog_table_->GetOid(),
+        index_offset, column_offsets, values);
+    cache_version = txn->GetCatalogVersion();
+    auto cached_result = global_cache.Find(cache_key, cache_version);
+    if (cached_result != nullptr) {
+      for (auto &tile : cached_result->tiles) {
+        result_tiles->push_back(std::unique_ptr<executor::LogicalTile>(
+            executor::LogicalTileFactory::WrapTiles({tile})));
+      }
+      return result_tiles;
+    }
+  }
+
   // Index scan
   std::unique_ptr<executor::ExecutorContext> context(
       new executor::ExecutorContext(txn));
@@ -219,14 +251,19 @@ AbstractCatalog::GetResultWithIndexScan(
 
   // Execute
   index_scan_executor.Init();
-  std::unique_ptr<std::vector<std::unique_ptr<executor::LogicalTile>>>
-      result_tiles(new std::vector<std::unique_ptr<executor::LogicalTile>>());
-
   while (index_scan_executor.Execute()) {
     result_tiles->push_back(std::unique_ptr<executor::LogicalTile>(
         index_scan_executor.GetOutput()));
   }
 
+  if (use_cache) {
+    std::vector<std::shared_ptr<storage::Tile>> tiles;
+    for (auto &result_tile : *result_tiles) {
+      tiles.emplace_back(result_tile->Materialize());
+    }
+    global_cache.Insert(cache_key, cache_version, std::move(tiles));
+  }
+
   return result_tiles;
 }
 
@@ -317,6 +354,7 @@ bool AbstractCatalog::UpdateWithIndexScan(concurrency::TransactionContext *txn,
                                           std::vector<oid_t> update_columns,
                                           std::vector<type::Value> update_values) {
   if (txn == nullptr) throw CatalogException("Scan table requires transaction");
+  if (cached_) txn->SetCatalogModified();
 
   std::unique_ptr<executor::ExecutorContext> context(
       new executor::ExecutorContext(txn));
@@ -15,17 +15,23 @@
 #include <sstream>
 
 #include "common/internal_types.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace catalog {
 
 void Column::SetLength(size_t column_length) {
-  // Set the column length based on whether it is inlined
+  // Set the column length based on whether it is inlined. Variable-length
+  // values are always stored in a varlen slot.
+  bool is_varlen = (column_type_ == type::TypeId::VARCHAR ||
+                    column_type_ == type::TypeId::VARBINARY);
   if (is_inlined_) {
-    fixed_length_ = column_length;
+    fixed_length_ =
+        is_varlen ? std::max(column_length, sizeof(type::VarlenSlot))
+                  : column_length;
     variable_length_ = 0;
   } else {
-    fixed_length_ = sizeof(uintptr_t);
+    fixed_length_ = sizeof(type::VarlenSlot);
     variable_length_ = column_length;
   }
 }
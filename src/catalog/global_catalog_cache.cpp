@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// global_catalog_cache.cpp
+//
+// Identification: src/catalog/global_catalog_cache.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/global_catalog_cache.h"
+
+#include "common/logger.h"
+#include "storage/tile.h"
+
+namespace peloton {
+namespace catalog {
+
+GlobalCatalogCache &GlobalCatalogCache::GetInstance() {
+  static GlobalCatalogCache global_catalog_cache;
+  return global_catalog_cache;
+}
+
+std::string GlobalCatalogCache::GetKey(
+    oid_t database_oid, oid_t table_oid, oid_t index_offset,
+    const std::vector<oid_t> &column_offsets,
+    const std::vector<type::Value> &values) {
+  std::string key;
+  auto append_oid = [&key](oid_t oid) {
+    key.append(reinterpret_cast<const char *>(&oid), sizeof(oid));
+  };
+
+  append_oid(database_oid);
+  append_oid(table_oid);
+  append_oid(index_offset);
+  append_oid(column_offsets.size());
+  for (auto column_offset : column_offsets) {
+    append_oid(column_offset);
+  }
+
+  // The values are length-prefixed, so that no two lists of values share a key
+  for (auto &value : values) {
+    append_oid(static_cast<oid_t>(value.GetTypeId()));
+    if (value.IsNull()) {
+      append_oid(INVALID_OID);
+      continue;
+    }
+    auto str = value.ToString();
+    append_oid(str.size());
+    key.append(str);
+  }
+  return key;
+}
+
+bool GlobalCatalogCache::IsCurrent(uint64_t version) const {
+  // A change counts itself in before bumping the version, and out after
+  // bumping it again, so checking in the opposite order misses none that
+  // overlaps with the transaction
+  return num_changing_.load() == 0 && version_.load() == version;
+}
+
+std::shared_ptr<CatalogScanResult> GlobalCatalogCache::Find(
+    const std::string &key, uint64_t version) const {
+  std::shared_ptr<CatalogScanResult> result;
+  if (IsCurrent(version) == false || results_.Find(key, result) == false ||
+      result->version != version) {
+    return nullptr;
+  }
+  return result;
+}
+
+void GlobalCatalogCache::Insert(
+    const std::string &key, uint64_t version,
+    std::vector<std::shared_ptr<storage::Tile>> tiles) {
+  if (IsCurrent(version) == false) {
+    return;
+  }
+  std::shared_ptr<CatalogScanResult> result(
+      new CatalogScanResult{version, std::move(tiles)});
+  results_.Upsert(key, result);
+}
+
+void GlobalCatalogCache::BeginChange() {
+  num_changing_++;
+  version_++;
+}
+
+void GlobalCatalogCache::Invalidate() {
+  version_++;
+  results_.Clear();
+  PELOTON_ASSERT(num_changing_ > 0);
+  num_changing_--;
+  LOG_TRACE("Invalidated global catalog cache");
+}
+
+}  // namespace catalog
+}  // namespace peloton
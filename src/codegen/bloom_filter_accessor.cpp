@@ -69,7 +69,8 @@ void BloomFilterAccessor::Add(CodeGen &codegen, llvm::Value *bloom_filter,
 
 llvm::Value *BloomFilterAccessor::Contains(
     CodeGen &codegen, llvm::Value *bloom_filter,
-    const std::vector<codegen::Value> &key) const {
+    const std::vector<codegen::Value> &key,
+    const ProbeCounters *counters) const {
   // Index of current hash being calculated
   llvm::Value *index = codegen.Const64(0);
   llvm::Value *num_hashes = LoadBloomFilterField(codegen, bloom_filter, 0);
@@ -79,9 +80,9 @@ llvm::Value *BloomFilterAccessor::Contains(
   llvm::Value *seed_hash2 =
       Hash::HashValues(codegen, key, util::BloomFilter::kSeedHashFuncs[1]);
   // Update statistic. Increase number of probing
-  llvm::Value *num_probe = LoadBloomFilterField(codegen, bloom_filter, 4);
-  StoreBloomFilterField(codegen, bloom_filter, 4,
-                        codegen->CreateAdd(num_probe, codegen.Const64(1)));
+  if (counters != nullptr) {
+    IncrementCounter(codegen, counters->num_probes);
+  }
 
   lang::Loop add_loop{codegen, end_cond, {{"i", index}}};
   {
@@ -104,9 +105,9 @@ llvm::Value *BloomFilterAccessor::Contains(
     lang::If bit_not_set{codegen, equal_zero, "BitNotSet"};
     {
       // Bit is not set. It means object not in bloom filter. break
-      llvm::Value *num_misses = LoadBloomFilterField(codegen, bloom_filter, 3);
-      StoreBloomFilterField(codegen, bloom_filter, 3,
-                            codegen->CreateAdd(num_misses, codegen.Const64(1)));
+      if (counters != nullptr) {
+        IncrementCounter(codegen, counters->num_misses);
+      }
       add_loop.Break();
     }
     bit_not_set.EndIf();
@@ -159,13 +160,32 @@ void BloomFilterAccessor::LocateBit(CodeGen &codegen, llvm::Value *bloom_filter,
       codegen->CreateInBoundsGEP(codegen.ByteType(), byte_array, byte_offset);
 }
 
-void BloomFilterAccessor::StoreBloomFilterField(
-    CodeGen &codegen, llvm::Value *bloom_filter, uint32_t field_id,
-    llvm::Value *new_field_val) const {
-  llvm::Type *bloom_filter_type = BloomFilterProxy::GetType(codegen);
-  codegen->CreateStore(new_field_val,
-                       codegen->CreateConstInBoundsGEP2_32(
-                           bloom_filter_type, bloom_filter, 0, field_id));
+BloomFilterAccessor::ProbeCounters BloomFilterAccessor::InitCounters(
+    CodeGen &codegen) const {
+  ProbeCounters counters;
+  counters.num_probes =
+      codegen.AllocateVariable(codegen.Int64Type(), "bloomFilterProbes");
+  counters.num_misses =
+      codegen.AllocateVariable(codegen.Int64Type(), "bloomFilterMisses");
+  codegen->CreateStore(codegen.Const64(0), counters.num_probes);
+  codegen->CreateStore(codegen.Const64(0), counters.num_misses);
+  return counters;
+}
+
+void BloomFilterAccessor::PublishCounters(CodeGen &codegen,
+                                          llvm::Value *bloom_filter,
+                                          const ProbeCounters &counters) const {
+  llvm::Value *num_probes = codegen->CreateLoad(counters.num_probes);
+  llvm::Value *num_misses = codegen->CreateLoad(counters.num_misses);
+  codegen.Call(BloomFilterProxy::AddStatistics,
+               {bloom_filter, num_probes, num_misses});
+}
+
+void BloomFilterAccessor::IncrementCounter(CodeGen &codegen,
+                                           llvm::Value *counter) const {
+  codegen->CreateStore(
+      codegen->CreateAdd(codegen->CreateLoad(counter), codegen.Const64(1)),
+      counter);
 }
 
 llvm::Value *BloomFilterAccessor::LoadBloomFilterField(
@@ -48,27 +48,21 @@ void BufferAccessor::Append(CodeGen &codegen, llvm::Value *buffer_ptr,
 
 void BufferAccessor::Iterate(CodeGen &codegen, llvm::Value *buffer_ptr,
                              BufferAccessor::IterateCallback &callback) const {
-  auto *start = codegen.Load(BufferProxy::buffer_start, buffer_ptr);
-  auto *end = codegen.Load(BufferProxy::buffer_pos, buffer_ptr);
+  auto *start = BufferStart(codegen, buffer_ptr);
+  auto *end = BufferEnd(codegen, buffer_ptr);
   lang::Loop loop{codegen, codegen->CreateICmpNE(start, end), {{"pos", start}}};
   {
     auto *pos = loop.GetLoopVar(0);
 
     // Read
     std::vector<codegen::Value> vals;
-    UpdateableStorage::NullBitmap null_bitmap(codegen, storage_format_, pos);
-    for (uint32_t col_id = 0; col_id < storage_format_.GetNumElements();
-         col_id++) {
-      auto val = storage_format_.GetValue(codegen, pos, col_id, null_bitmap);
-      vals.emplace_back(val);
-    }
+    LoadTuple(codegen, pos, vals);
 
     // Invoke callback
     callback.ProcessEntry(codegen, vals);
 
     // Move along
-    auto *next = codegen->CreateConstInBoundsGEP1_64(
-        pos, storage_format_.GetStorageSize());
+    auto *next = NextTuple(codegen, pos);
     loop.LoopEnd(codegen->CreateICmpNE(next, end), {next});
   }
 }
@@ -92,5 +86,37 @@ llvm::Value *BufferAccessor::NumTuples(CodeGen &codegen,
   return codegen->CreateTrunc(diff, codegen.Int32Type());
 }
 
+llvm::Value *BufferAccessor::BufferStart(CodeGen &codegen,
+                                         llvm::Value *buffer_ptr) const {
+  return codegen.Load(BufferProxy::buffer_start, buffer_ptr);
+}
+
+llvm::Value *BufferAccessor::BufferEnd(CodeGen &codegen,
+                                       llvm::Value *buffer_ptr) const {
+  return codegen.Load(BufferProxy::buffer_pos, buffer_ptr);
+}
+
+llvm::Value *BufferAccessor::NextTuple(CodeGen &codegen,
+                                       llvm::Value *pos) const {
+  return codegen->CreateConstInBoundsGEP1_64(pos,
+                                             storage_format_.GetStorageSize());
+}
+
+void BufferAccessor::LoadTuple(CodeGen &codegen, llvm::Value *pos,
+                               std::vector<codegen::Value> &vals) const {
+  UpdateableStorage::NullBitmap null_bitmap(codegen, storage_format_, pos);
+  for (uint32_t col_id = 0; col_id < storage_format_.GetNumElements();
+       col_id++) {
+    auto val = storage_format_.GetValue(codegen, pos, col_id, null_bitmap);
+    vals.emplace_back(val);
+  }
+}
+
+void BufferAccessor::StoreValue(CodeGen &codegen, llvm::Value *pos,
+                                uint32_t col_id,
+                                const codegen::Value &val) const {
+  storage_format_.SetValueSkipNull(codegen, pos, col_id, val);
+}
+
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
@@ -216,6 +216,32 @@ llvm::Value *CodeGen::Sqrt(llvm::Value *val) {
   return CallFunc(sqrt_func, {val});
 }
 
+llvm::Value *CodeGen::ByteSwap(llvm::Value *val) {
+  llvm::Function *bswap_func = llvm::Intrinsic::getDeclaration(
+      &GetModule(), llvm::Intrinsic::bswap, val->getType());
+  return CallFunc(bswap_func, {val});
+}
+
+void CodeGen::Prefetch(llvm::Value *addr, bool for_write, uint32_t locality) {
+  static constexpr uint32_t kDataCache = 1;
+  PELOTON_ASSERT(locality <= 3);
+
+  // LLVM's prefetch intrinsic signature is:
+  //
+  //   void prefetch(i8* addr, i32 rw, i32 locality, i32 cache-type)
+  //
+  // The arguments are as follows:
+  //       addr - the address we want to prefetch
+  //         rw - is this prefetch for a read (0) or a write (1)
+  //   locality - temporal locality specifier between 0 and 3 inclusive
+  // cache type - prefetching from instruction cache (0) or data cache (1)
+  llvm::Function *prefetch_func =
+      llvm::Intrinsic::getDeclaration(&GetModule(), llvm::Intrinsic::prefetch);
+  CallFunc(prefetch_func, {GetBuilder().CreateBitCast(addr, CharPtrType()),
+                           Const32(for_write ? 1 : 0), Const32(locality),
+                           Const32(kDataCache)});
+}
+
 llvm::Value *CodeGen::CallAddWithOverflow(llvm::Value *left, llvm::Value *right,
                                           llvm::Value *&overflow_bit) {
   PELOTON_ASSERT(left->getType() == right->getType());
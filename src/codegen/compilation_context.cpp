@@ -146,6 +146,12 @@ llvm::Function *CompilationContext::GenerateInitFunction() {
       translator->InitializeQueryState();
     }
 
+    // Allow each expression to initialize their state
+    for (auto &iter : exp_translators_) {
+      auto &translator = iter.second;
+      translator->InitializeQueryState();
+    }
+
     // Finish the function
     init_func.ReturnAndFinish();
   }
@@ -189,6 +195,12 @@ llvm::Function *CompilationContext::GenerateTearDownFunction() {
       translator->TearDownQueryState();
     }
 
+    // Allow each expression to clean up their state
+    for (auto &iter : exp_translators_) {
+      auto &translator = iter.second;
+      translator->TearDownQueryState();
+    }
+
     // Finish the function
     tear_down_func.ReturnAndFinish();
   }
@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table.cpp
+//
+// Identification: src/codegen/concurrent_aggregation_table.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/concurrent_aggregation_table.h"
+
+#include <algorithm>
+
+#include "codegen/hash.h"
+#include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/concurrent_aggregation_table_proxy.h"
+#include "codegen/type/sql_type.h"
+
+namespace peloton {
+namespace codegen {
+
+ConcurrentAggregationTable::ConcurrentAggregationTable() = default;
+
+ConcurrentAggregationTable::ConcurrentAggregationTable(
+    CodeGen &codegen, const std::vector<type::Type> &key_type,
+    const std::vector<UpdateOp> &update_ops)
+    : update_ops_(update_ops) {
+  PELOTON_ASSERT(update_ops.size() <=
+                 util::ConcurrentAggregationTable::kMaxNumValues);
+
+  // Keys are compared bytewise, so they can't refer to data outside the table
+  PELOTON_ASSERT(std::none_of(key_type.begin(), key_type.end(),
+                              [](const type::Type &type) {
+                                return type.GetSqlType().IsVariableLength();
+                              }));
+  key_storage_.Setup(codegen, key_type);
+}
+
+void ConcurrentAggregationTable::Init(CodeGen &codegen, llvm::Value *exec_ctx,
+                                      llvm::Value *table_ptr,
+                                      uint64_t num_groups) const {
+  uint64_t update_ops = 0;
+  for (uint32_t i = 0; i < update_ops_.size(); i++) {
+    update_ops |= static_cast<uint64_t>(update_ops_[i])
+                  << (i * util::ConcurrentAggregationTable::kUpdateOpBits);
+  }
+
+  auto *key_size = codegen.Const32(key_storage_.MaxStorageSize());
+  auto *num_values = codegen.Const32(static_cast<uint32_t>(update_ops_.size()));
+  codegen.Call(ConcurrentAggregationTableProxy::Init,
+               {table_ptr, exec_ctx, key_size, num_values,
+                codegen.Const64(update_ops), codegen.Const64(num_groups)});
+}
+
+void ConcurrentAggregationTable::Upsert(
+    CodeGen &codegen, llvm::Value *table_ptr,
+    const std::vector<codegen::Value> &key,
+    const std::vector<llvm::Value *> &values) const {
+  PELOTON_ASSERT(values.size() == update_ops_.size());
+
+  // Serialize the key and the values, then hand them to the table
+  auto *key_buf = codegen.AllocateBuffer(
+      codegen.ByteType(), key_storage_.MaxStorageSize(), "aggKey");
+  key_storage_.StoreValues(codegen, key_buf, key);
+
+  auto *values_buf = codegen.AllocateBuffer(
+      codegen.Int64Type(), static_cast<uint32_t>(values.size()), "aggValues");
+  for (uint32_t i = 0; i < values.size(); i++) {
+    auto *val = codegen->CreateSExtOrTrunc(values[i], codegen.Int64Type());
+    codegen->CreateStore(val,
+                         codegen->CreateConstInBoundsGEP1_32(
+                             codegen.Int64Type(), values_buf, i));
+  }
+
+  llvm::Value *hash = Hash::HashValues(codegen, key);
+  codegen.Call(ConcurrentAggregationTableProxy::Upsert,
+               {table_ptr, hash, key_buf, values_buf});
+}
+
+void ConcurrentAggregationTable::Iterate(CodeGen &codegen,
+                                         llvm::Value *table_ptr,
+                                         IterateCallback &callback) const {
+  const auto num_values = static_cast<uint32_t>(update_ops_.size());
+  const uint32_t slot_size = util::ConcurrentAggregationTable::SlotSize(
+      key_storage_.MaxStorageSize(), num_values);
+  const uint64_t occupied = util::ConcurrentAggregationTable::kOccupied;
+
+  llvm::Value *slots = codegen.Load(ConcurrentAggregationTableProxy::slots,
+                                    table_ptr);
+  llvm::Value *capacity = codegen.Load(
+      ConcurrentAggregationTableProxy::capacity, table_ptr);
+
+  llvm::Value *idx = codegen.Const64(0);
+  lang::Loop loop{codegen, codegen->CreateICmpULT(idx, capacity), {{"i", idx}}};
+  {
+    idx = loop.GetLoopVar(0);
+    llvm::Value *slot = codegen->CreateInBoundsGEP(
+        codegen.ByteType(), slots,
+        codegen->CreateMul(idx, codegen.Const64(slot_size)));
+
+    // Skip free slots
+    llvm::Value *tag = codegen->CreateLoad(codegen->CreatePointerCast(
+        slot, codegen.Int64Type()->getPointerTo()));
+    llvm::Value *is_occupied = codegen->CreateICmpNE(
+        codegen->CreateAnd(tag, codegen.Const64(occupied)),
+        codegen.Const64(0));
+    lang::If occupied_slot{codegen, is_occupied};
+    {
+      auto *values_ptr = codegen->CreatePointerCast(
+          codegen->CreateConstInBoundsGEP1_32(
+              codegen.ByteType(), slot,
+              util::ConcurrentAggregationTable::ValuesOffset()),
+          codegen.Int64Type()->getPointerTo());
+      std::vector<llvm::Value *> aggregates;
+      for (uint32_t i = 0; i < num_values; i++) {
+        aggregates.push_back(codegen->CreateLoad(
+            codegen->CreateConstInBoundsGEP1_32(codegen.Int64Type(),
+                                                values_ptr, i)));
+      }
+
+      auto *key_ptr = codegen->CreateConstInBoundsGEP1_32(
+          codegen.ByteType(), slot,
+          util::ConcurrentAggregationTable::KeyOffset(num_values));
+      std::vector<codegen::Value> key;
+      key_storage_.LoadValues(codegen, key_ptr, key);
+
+      callback.ProcessEntry(codegen, key, aggregates);
+    }
+    occupied_slot.EndIf();
+
+    idx = codegen->CreateAdd(idx, codegen.Const64(1));
+    loop.LoopEnd(codegen->CreateICmpULT(idx, capacity), {idx});
+  }
+}
+
+void ConcurrentAggregationTable::Destroy(CodeGen &codegen,
+                                         llvm::Value *table_ptr) const {
+  codegen.Call(ConcurrentAggregationTableProxy::Destroy, {table_ptr});
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -74,6 +74,12 @@ void ConsumerContext::Consume(RowBatch::Row &row) {
   consumer.ConsumeResult(*this, row);
 }
 
+void ConsumerContext::ConsumeAndRewind(RowBatch::Row &row) {
+  auto position = pipeline_.pipeline_index_;
+  Consume(row);
+  pipeline_.pipeline_index_ = position;
+}
+
 CodeGen &ConsumerContext::GetCodeGen() const {
   return compilation_context_.GetCodeGen();
 }
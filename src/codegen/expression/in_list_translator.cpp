@@ -0,0 +1,209 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// in_list_translator.cpp
+//
+// Identification: src/codegen/expression/in_list_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/expression/in_list_translator.h"
+
+#include "codegen/compilation_context.h"
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/in_list_proxy.h"
+#include "codegen/type/boolean_type.h"
+#include "expression/comparison_expression.h"
+
+namespace peloton {
+namespace codegen {
+
+namespace {
+
+bool IsIntegral(peloton::type::TypeId type_id) {
+  switch (type_id) {
+    case peloton::type::TypeId::TINYINT:
+    case peloton::type::TypeId::SMALLINT:
+    case peloton::type::TypeId::INTEGER:
+    case peloton::type::TypeId::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+// Constructor
+InListTranslator::InListTranslator(
+    const expression::ComparisonExpression &in_list,
+    CompilationContext &context)
+    : ExpressionTranslator(in_list, context),
+      use_sorted_(false),
+      nullable_(false) {
+  PELOTON_ASSERT(in_list.GetChildrenSize() == 2);
+  const auto *needle = in_list.GetChild(0);
+  const auto *list = in_list.GetChild(1);
+  if (list->GetExpressionType() != ExpressionType::VALUE_VECTOR) {
+    throw Exception{"IN is only supported over a list of values"};
+  }
+
+  // The values of the list come from the query parameters. Integral values
+  // can be sorted by the runtime when the query starts.
+  use_sorted_ = list->GetChildrenSize() > kMaxCompareAllSize &&
+                IsIntegral(needle->GetValueType());
+  nullable_ = needle->IsNullable();
+  for (uint32_t i = 0; i < list->GetChildrenSize(); i++) {
+    const auto *value = list->GetChild(i);
+    auto value_type = value->GetExpressionType();
+    use_sorted_ &= (value_type == ExpressionType::VALUE_CONSTANT ||
+                    value_type == ExpressionType::VALUE_PARAMETER) &&
+                   IsIntegral(value->GetValueType());
+    nullable_ |= value->IsNullable();
+  }
+
+  if (use_sorted_) {
+    CodeGen &codegen = context.GetCodeGen();
+    in_list_id_ = context.GetQueryState().RegisterState(
+        "inList", InListProxy::GetType(codegen));
+  }
+}
+
+void InListTranslator::InitializeQueryState() {
+  if (!use_sorted_) {
+    return;
+  }
+
+  // The values of the list are consecutive query parameters
+  const auto *list = GetExpressionAs<expression::ComparisonExpression>()
+                         .GetChild(1);
+  const auto &parameter_cache = context_.GetParameterCache();
+  uint32_t first_index = parameter_cache.GetIndex(list->GetChild(0));
+  for (uint32_t i = 1; i < list->GetChildrenSize(); i++) {
+    PELOTON_ASSERT(parameter_cache.GetIndex(list->GetChild(i)) ==
+                   first_index + i);
+  }
+
+  CodeGen &codegen = context_.GetCodeGen();
+  auto *in_list_ptr =
+      context_.GetQueryState().LoadStatePtr(codegen, in_list_id_);
+  auto *query_parameters_ptr =
+      context_.GetExecutionConsumer().GetQueryParametersPtr(context_);
+  codegen.Call(InListProxy::Init,
+               {in_list_ptr, query_parameters_ptr, codegen.Const32(first_index),
+                codegen.Const32(list->GetChildrenSize())});
+}
+
+// Produce the result of checking if the left value is in the list
+codegen::Value InListTranslator::DeriveValue(CodeGen &codegen,
+                                             RowBatch::Row &row) const {
+  const auto &in_list = GetExpressionAs<expression::ComparisonExpression>();
+  codegen::Value needle = row.DeriveValue(codegen, *in_list.GetChild(0));
+  if (use_sorted_) {
+    return LookupSorted(codegen, needle);
+  } else {
+    return CompareAll(codegen, row, needle);
+  }
+}
+
+void InListTranslator::TearDownQueryState() {
+  if (!use_sorted_) {
+    return;
+  }
+  CodeGen &codegen = context_.GetCodeGen();
+  codegen.Call(InListProxy::Destroy,
+               {context_.GetQueryState().LoadStatePtr(codegen, in_list_id_)});
+}
+
+codegen::Value InListTranslator::CompareAll(
+    CodeGen &codegen, RowBatch::Row &row, const codegen::Value &needle) const {
+  const auto *list =
+      GetExpressionAs<expression::ComparisonExpression>().GetChild(1);
+
+  // We evaluate every comparison and combine their results without branching,
+  // which is cheaper for short lists than a mispredicted branch per value
+  llvm::Value *found = codegen.ConstBool(false);
+  llvm::Value *has_null = needle.IsNull(codegen);
+  for (uint32_t i = 0; i < list->GetChildrenSize(); i++) {
+    codegen::Value value = row.DeriveValue(codegen, *list->GetChild(i));
+    codegen::Value is_equal = needle.CompareEq(codegen, value);
+    llvm::Value *match = is_equal.GetValue();
+    if (is_equal.IsNullable()) {
+      match = codegen->CreateAnd(match, is_equal.IsNotNull(codegen));
+    }
+    found = codegen->CreateOr(found, match);
+    has_null = codegen->CreateOr(has_null, value.IsNull(codegen));
+  }
+  return MakeResult(codegen, found, has_null);
+}
+
+codegen::Value InListTranslator::LookupSorted(
+    CodeGen &codegen, const codegen::Value &needle) const {
+  auto *in_list_ptr =
+      context_.GetQueryState().LoadStatePtr(codegen, in_list_id_);
+  auto *values = codegen.Load(InListProxy::values, in_list_ptr);
+  auto *num_values = codegen.Load(InListProxy::num_values, in_list_ptr);
+  auto *key = codegen->CreateSExtOrTrunc(needle.GetValue(),
+                                         codegen.Int64Type());
+
+  // Find the last position whose value is not greater than the key. Every
+  // step halves the range with a select instead of a branch, so the number
+  // of iterations only depends on the length of the list.
+  llvm::Value *pos = nullptr;
+  {
+    lang::Loop search{codegen,
+                      codegen->CreateICmpUGT(num_values, codegen.Const64(1)),
+                      {{"base", codegen.Const64(0)}, {"len", num_values}}};
+    {
+      auto *base = search.GetLoopVar(0);
+      auto *len = search.GetLoopVar(1);
+      auto *half = codegen->CreateLShr(len, codegen.Const64(1));
+      auto *mid = codegen->CreateAdd(base, half);
+      auto *mid_value =
+          codegen->CreateLoad(codegen->CreateInBoundsGEP(values, mid));
+      auto *next_base =
+          codegen->CreateSelect(codegen->CreateICmpSLE(mid_value, key), mid,
+                                base);
+      auto *next_len = codegen->CreateSub(len, half);
+      search.LoopEnd(codegen->CreateICmpUGT(next_len, codegen.Const64(1)),
+                     {next_base, next_len});
+    }
+    std::vector<llvm::Value *> final_vals;
+    search.CollectFinalLoopVariables(final_vals);
+    pos = final_vals[0];
+  }
+
+  // There is always room for one value, even if the list is empty
+  auto *pos_value =
+      codegen->CreateLoad(codegen->CreateInBoundsGEP(values, pos));
+  auto *found = codegen->CreateAnd(
+      codegen->CreateICmpNE(num_values, codegen.Const64(0)),
+      codegen->CreateICmpEQ(pos_value, key));
+  found = codegen->CreateAnd(found, needle.IsNotNull(codegen));
+
+  llvm::Value *has_null = needle.IsNull(codegen);
+  if (nullable_) {
+    has_null = codegen->CreateOr(
+        has_null, codegen.Load(InListProxy::has_null, in_list_ptr));
+  }
+  return MakeResult(codegen, found, has_null);
+}
+
+codegen::Value InListTranslator::MakeResult(CodeGen &codegen,
+                                            llvm::Value *found,
+                                            llvm::Value *has_null) const {
+  if (!nullable_) {
+    return codegen::Value{type::Boolean::Instance(), found};
+  }
+
+  // Without a match, the result is NULL if the needle or any value is NULL
+  auto *is_null = codegen->CreateAnd(has_null, codegen->CreateNot(found));
+  return codegen::Value{type::Type{type::Boolean::Instance(), true}, found,
+                        nullptr, is_null};
+}
+
+}  // namespace codegen
+}  // namespace peloton
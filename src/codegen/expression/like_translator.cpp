@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_translator.cpp
+//
+// Identification: src/codegen/expression/like_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/expression/like_translator.h"
+
+#include "codegen/compilation_context.h"
+#include "codegen/proxy/like_matcher_proxy.h"
+#include "codegen/type/boolean_type.h"
+#include "expression/comparison_expression.h"
+
+namespace peloton {
+namespace codegen {
+
+// Constructor
+LikeTranslator::LikeTranslator(const expression::ComparisonExpression &like,
+                               CompilationContext &context)
+    : ExpressionTranslator(like, context) {
+  PELOTON_ASSERT(IsSupported(like));
+  CodeGen &codegen = context.GetCodeGen();
+  matcher_id_ = context.GetQueryState().RegisterState(
+      "likeMatcher", LikeMatcherProxy::GetType(codegen));
+}
+
+bool LikeTranslator::IsSupported(const expression::ComparisonExpression &like) {
+  const auto *input = like.GetChild(0);
+  const auto *pattern = like.GetChild(1);
+  auto pattern_type = pattern->GetExpressionType();
+  return input->GetValueType() == peloton::type::TypeId::VARCHAR &&
+         pattern->GetValueType() == peloton::type::TypeId::VARCHAR &&
+         (pattern_type == ExpressionType::VALUE_CONSTANT ||
+          pattern_type == ExpressionType::VALUE_PARAMETER);
+}
+
+void LikeTranslator::InitializeQueryState() {
+  const auto *pattern =
+      GetExpressionAs<expression::ComparisonExpression>().GetChild(1);
+  uint32_t index = context_.GetParameterCache().GetIndex(pattern);
+
+  CodeGen &codegen = context_.GetCodeGen();
+  auto *matcher_ptr =
+      context_.GetQueryState().LoadStatePtr(codegen, matcher_id_);
+  auto *query_parameters_ptr =
+      context_.GetExecutionConsumer().GetQueryParametersPtr(context_);
+  codegen.Call(LikeMatcherProxy::Init,
+               {matcher_ptr, query_parameters_ptr, codegen.Const32(index)});
+}
+
+// Produce the result of matching the left value against the pattern
+codegen::Value LikeTranslator::DeriveValue(CodeGen &codegen,
+                                           RowBatch::Row &row) const {
+  const auto &like = GetExpressionAs<expression::ComparisonExpression>();
+  codegen::Value input = row.DeriveValue(codegen, *like.GetChild(0));
+
+  // Like the interpreted LIKE, a NULL input matches nothing. The matcher
+  // never reads the (empty) string of a NULL value, so we need not branch.
+  auto *matcher_ptr =
+      context_.GetQueryState().LoadStatePtr(codegen, matcher_id_);
+  llvm::Value *matched =
+      codegen.Call(LikeMatcherProxy::Match,
+                   {matcher_ptr, input.GetValue(), input.GetLength()});
+  if (input.IsNullable()) {
+    matched = codegen->CreateAnd(matched, input.IsNotNull(codegen));
+  }
+  return codegen::Value{type::Boolean::Instance(), matched};
+}
+
+void LikeTranslator::TearDownQueryState() {
+  CodeGen &codegen = context_.GetCodeGen();
+  codegen.Call(LikeMatcherProxy::Destroy,
+               {context_.GetQueryState().LoadStatePtr(codegen, matcher_id_)});
+}
+
+}  // namespace codegen
+}  // namespace peloton
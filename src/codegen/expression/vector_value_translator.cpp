@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_value_translator.cpp
+//
+// Identification: src/codegen/expression/vector_value_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/expression/vector_value_translator.h"
+
+#include "expression/vector_value_expression.h"
+
+namespace peloton {
+namespace codegen {
+
+// Constructor
+VectorValueTranslator::VectorValueTranslator(
+    const expression::VectorValueExpression &vector_exp,
+    CompilationContext &context)
+    : ExpressionTranslator(vector_exp, context) {}
+
+codegen::Value VectorValueTranslator::DeriveValue(
+    UNUSED_ATTRIBUTE CodeGen &codegen,
+    UNUSED_ATTRIBUTE RowBatch::Row &row) const {
+  throw Exception{"A value vector can only be derived by its parent"};
+}
+
+}  // namespace codegen
+}  // namespace peloton
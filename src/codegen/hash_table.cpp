@@ -220,8 +220,21 @@ void HashTable::Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
 void HashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
                         const std::vector<codegen::Value> &key,
                         IterateCallback &callback) const {
-  llvm::Value *hash = Hash::HashValues(codegen, key);
+  FindAllWithHash(codegen, ht_ptr, HashKey(codegen, key), key, callback);
+}
+
+void HashTable::FindAllWithHash(CodeGen &codegen, llvm::Value *ht_ptr,
+                                llvm::Value *hash,
+                                const std::vector<codegen::Value> &key,
+                                IterateCallback &callback) const {
+  FindAllUntil(codegen, ht_ptr, hash, key, callback, nullptr);
+}
 
+void HashTable::FindAllUntil(CodeGen &codegen, llvm::Value *ht_ptr,
+                             llvm::Value *hash,
+                             const std::vector<codegen::Value> &key,
+                             IterateCallback &callback,
+                             llvm::Value *done_ptr) const {
   llvm::Value *mask = codegen.Load(HashTableProxy::mask, ht_ptr);
   llvm::Value *bucket_idx = codegen->CreateAnd(hash, mask);
   llvm::Value *directory = codegen.Load(HashTableProxy::directory, ht_ptr);
@@ -231,9 +244,16 @@ void HashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
   llvm::Type *entry_type = EntryProxy::GetType(codegen);
   llvm::Value *null = codegen.NullPtr(entry_type->getPointerTo());
 
-  // Loop chain
-  llvm::Value *end_condition = codegen->CreateICmpNE(bucket, null);
-  lang::Loop chain_loop(codegen, end_condition, {{"iter", bucket}});
+  // Loop chain, until its end or until the caller is done
+  auto continue_cond = [&codegen, &null, done_ptr](llvm::Value *entry) {
+    llvm::Value *cond = codegen->CreateICmpNE(entry, null);
+    if (done_ptr != nullptr) {
+      llvm::Value *done = codegen->CreateLoad(done_ptr);
+      cond = codegen->CreateAnd(cond, codegen->CreateNot(done));
+    }
+    return cond;
+  };
+  lang::Loop chain_loop(codegen, continue_cond(bucket), {{"iter", bucket}});
   {
     llvm::Value *entry = chain_loop.GetLoopVar(0);
 
@@ -256,10 +276,36 @@ void HashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
       hash_match.EndIf();
     }
     entry = codegen.Load(EntryProxy::next, entry);
-    chain_loop.LoopEnd(codegen->CreateICmpNE(entry, null), {entry});
+    chain_loop.LoopEnd(continue_cond(entry), {entry});
   }
 }
 
+llvm::Value *HashTable::HashKey(CodeGen &codegen,
+                                const std::vector<codegen::Value> &key) const {
+  return Hash::HashValues(codegen, key);
+}
+
+void HashTable::PrefetchBucket(CodeGen &codegen, llvm::Value *ht_ptr,
+                               llvm::Value *hash) const {
+  llvm::Value *mask = codegen.Load(HashTableProxy::mask, ht_ptr);
+  llvm::Value *bucket_idx = codegen->CreateAnd(hash, mask);
+  llvm::Value *directory = codegen.Load(HashTableProxy::directory, ht_ptr);
+  codegen.Prefetch(codegen->CreateInBoundsGEP(directory, {bucket_idx}), false,
+                   3);
+}
+
+void HashTable::PrefetchBucketHead(CodeGen &codegen, llvm::Value *ht_ptr,
+                                   llvm::Value *hash) const {
+  // Prefetching is only a hint and never faults, so an empty bucket (with a
+  // NULL head) needs no special care
+  llvm::Value *mask = codegen.Load(HashTableProxy::mask, ht_ptr);
+  llvm::Value *bucket_idx = codegen->CreateAnd(hash, mask);
+  llvm::Value *directory = codegen.Load(HashTableProxy::directory, ht_ptr);
+  llvm::Value *bucket =
+      codegen->CreateLoad(codegen->CreateInBoundsGEP(directory, {bucket_idx}));
+  codegen.Prefetch(bucket, false, 3);
+}
+
 void HashTable::Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const {
   codegen.Call(HashTableProxy::Destroy, {ht_ptr});
 }
@@ -1698,6 +1698,9 @@ void BytecodeBuilder::TranslateCall(const llvm::Instruction *instruction) {
           {call_instruction, call_instruction->getOperand(0),
            call_instruction->getOperand(1)});
 
+    } else if (function_name.find("llvm.prefetch") == 0) {
+      // Prefetching is only a hint, which makes no sense to the interpreter
+
     } else {
       Opcode opcode =
           BytecodeFunction::GetExplicitCallOpcodeByString(function_name);
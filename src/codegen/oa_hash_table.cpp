@@ -706,28 +706,9 @@ void OAHashTable::PrefetchBucket(CodeGen &codegen, llvm::Value *ht_ptr,
                                  llvm::Value *hash,
                                  OAHashTable::PrefetchType pf_type,
                                  OAHashTable::Locality locality) const {
-  static constexpr uint32_t kDataCache = 1;
-
   auto pos = GetEntryByHash(codegen, ht_ptr, hash);
-  llvm::Value *entry_ptr =
-      codegen->CreateBitCast(pos.entry_ptr, codegen.CharPtrType());
-
-  // LLVM's prefetch intrinsic signature is:
-  //
-  //   void prefetch(i8* addr, i32 rw, i32 locality, i32 cache-type)
-  //
-  // The arguments are as follows:
-  //       addr - the address we want to prefetch
-  //         rw - is this prefetch for a read (0) or a write (1)
-  //   locality - temporal locality specifier between 0 and 3 inclusive
-  // cache type - prefetching from instruction cache (0) or data cache (1)
-  llvm::Function *prefetch_func = llvm::Intrinsic::getDeclaration(
-      &codegen.GetModule(), llvm::Intrinsic::prefetch);
-  std::vector<llvm::Value *> fn_args = {
-      entry_ptr, codegen.Const32(static_cast<uint32_t>(pf_type)),
-      codegen.Const32(static_cast<uint32_t>(locality)),
-      codegen.Const32(kDataCache)};
-  codegen.CallFunc(prefetch_func, fn_args);
+  codegen.Prefetch(pos.entry_ptr, pf_type == PrefetchType::Write,
+                   static_cast<uint32_t>(locality));
 }
 
 void OAHashTable::OAHashTableAccess::ExtractBucketKeys(
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_translator.cpp
+//
+// Identification: src/codegen/operator/append_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/append_translator.h"
+
+#include "codegen/compilation_context.h"
+#include "planner/append_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+/**
+ * Every input of the append produces its rows into a pipeline that continues
+ * with the operators above the append, so a UNION ALL over many tables costs
+ * no more than scanning each of them. In the last pipeline of the query, each
+ * input pipeline runs in parallel if its source allows it.
+ *
+ * The inputs are only matched up by position. The parent operators refer to
+ * the attributes of the first input, so rows of any other input have their
+ * values registered under those attributes before they are passed on.
+ */
+
+AppendTranslator::AppendTranslator(const planner::AppendPlan &plan,
+                                   CompilationContext &context,
+                                   Pipeline &pipeline)
+    : OperatorTranslator(plan, context, pipeline) {
+  PELOTON_ASSERT(plan.GetChildrenSize() > 0);
+
+  // Operators above us that keep thread-local state in a parallel pipeline
+  // merge it when the pipeline finishes, which only happens once for all
+  // inputs. Outside of the last pipeline, we therefore run serially.
+  if (plan.GetChildrenSize() > 1 && !context.IsLastPipeline(pipeline)) {
+    pipeline.SetSerial();
+  }
+
+  for (uint32_t i = 1; i < plan.GetChildrenSize(); i++) {
+    input_pipelines_.emplace_back(new Pipeline(pipeline, this));
+  }
+
+  // Operators above us that finish their work once all rows were consumed may
+  // only do so in the pipeline of the last input, which runs last
+  if (!input_pipelines_.empty()) {
+    pipeline.DeferFinish(this);
+    for (uint32_t i = 0; i + 1 < input_pipelines_.size(); i++) {
+      input_pipelines_[i]->DeferFinish(this);
+    }
+  }
+
+  // Prepare the inputs
+  context.Prepare(*plan.GetChild(0), pipeline);
+  for (uint32_t i = 1; i < plan.GetChildrenSize(); i++) {
+    context.Prepare(*plan.GetChild(i), *input_pipelines_[i - 1]);
+  }
+}
+
+void AppendTranslator::Produce() const {
+  for (const auto &child : GetPlan().GetChildren()) {
+    GetCompilationContext().Produce(*child);
+  }
+}
+
+void AppendTranslator::Consume(ConsumerContext &context,
+                               RowBatch::Row &row) const {
+  const auto &plan = GetPlanAs<planner::AppendPlan>();
+
+  // Find the input the row comes from
+  uint32_t child_idx = 0;
+  for (uint32_t i = 0; i < input_pipelines_.size(); i++) {
+    if (context.GetPipeline().GetId() == input_pipelines_[i]->GetId()) {
+      child_idx = i + 1;
+    }
+  }
+
+  if (child_idx != 0) {
+    CodeGen &codegen = GetCodeGen();
+    const auto &output_ais = plan.GetInputAttributes(0);
+    const auto &input_ais = plan.GetInputAttributes(child_idx);
+    PELOTON_ASSERT(output_ais.size() == input_ais.size());
+    for (uint32_t i = 0; i < output_ais.size(); i++) {
+      row.RegisterAttributeValue(output_ais[i],
+                                 row.DeriveValue(codegen, input_ais[i]));
+    }
+  }
+
+  context.Consume(row);
+}
+
+}  // namespace codegen
+}  // namespace peloton
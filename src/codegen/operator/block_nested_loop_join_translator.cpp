@@ -16,8 +16,11 @@
 #include "codegen/compilation_context.h"
 #include "codegen/function_builder.h"
 #include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
 #include "codegen/operator/projection_translator.h"
 #include "codegen/proxy/buffer_proxy.h"
+#include "codegen/type/boolean_type.h"
+#include "codegen/vector.h"
 #include "planner/nested_loop_join_plan.h"
 #include "settings/settings_manager.h"
 
@@ -52,6 +55,29 @@ namespace codegen {
 /// auxiliary function. This function implements the logic for the right-side
 /// query pipeline.
 ///
+/// LEFT, FULL, SEMI and ANTI joins store a matched flag with every buffered
+/// tuple. Once all right tuples have been joined with the buffer, "joinBuffer"
+/// produces the buffered tuples depending on their flag. SEMI and ANTI joins
+/// produce only left tuples, like the plans expect of them. RIGHT and FULL
+/// joins need to know whether a right tuple has any join partner at all, so
+/// they buffer the whole left input and call "joinBuffer" only once:
+///
+/// function joinBuffer(Buffer b):
+///   for s in S:
+///     matched = false
+///     for r in b:
+///       if pred(r, s):
+///         matched = r.matched = true
+///         emit(r, s)                        (not for SEMI and ANTI joins)
+///     if !matched:
+///       emit(NULL, s)                       (RIGHT and FULL joins)
+///   for r in b:
+///     if !r.matched:
+///       emit(r, NULL)                       (LEFT and FULL joins)
+///       emit(r)                             (ANTI joins)
+///     else:
+///       emit(r)                             (SEMI joins)
+///
 ////////////////////////////////////////////////////////////////////////////////
 
 BlockNestedLoopJoinTranslator::BlockNestedLoopJoinTranslator(
@@ -90,11 +116,21 @@ BlockNestedLoopJoinTranslator::BlockNestedLoopJoinTranslator(
     }
   }
 
-  // Construct the layout of tuples we store in our buffer
+  // Construct the layout of tuples we store in our buffer. LEFT, FULL, SEMI
+  // and ANTI joins add a flag at the end that tracks whether the tuple found a
+  // join partner.
   std::vector<type::Type> left_input_desc;
   for (const auto *ai : unique_left_attributes_) {
     left_input_desc.push_back(ai->type);
   }
+  if (TracksLeftMatches()) {
+    left_input_desc.push_back(type::Boolean::Instance());
+
+    // The left tuples are produced at the end of the right pipeline
+    pipeline.SetSerial();
+  }
+
+  buffer_all_left_ = ProducesUnmatchedRight();
 
   // Allocate buffer instance in runtime state and configure its accessor
   CodeGen &codegen = GetCodeGen();
@@ -134,8 +170,15 @@ void BlockNestedLoopJoinTranslator::Produce() const {
   // Let the left child produce tuples we'll batch-process in Consume()
   GetCompilationContext().Produce(*GetPlan().GetChild(0));
 
-  // Flush any remaining buffered tuples through the join
+  // Joins that produce the right tuples without a join partner must run the
+  // right side even if there are no left tuples
   CodeGen &codegen = GetCodeGen();
+  if (ProducesUnmatchedRight()) {
+    join_buffer_func_.Call(codegen);
+    return;
+  }
+
+  // Flush any remaining buffered tuples through the join
   auto *num_tuples = buffer_.NumTuples(codegen, LoadStatePtr(buffer_id_));
   auto *flush_buffer = codegen->CreateICmpNE(num_tuples, codegen.Const32(0));
   lang::If has_tuples(codegen, flush_buffer);
@@ -160,11 +203,19 @@ void BlockNestedLoopJoinTranslator::ConsumeFromLeft(
   for (const auto &left_ai : unique_left_attributes_) {
     tuple.push_back(row.DeriveValue(codegen, left_ai));
   }
+  if (TracksLeftMatches()) {
+    tuple.emplace_back(type::Boolean::Instance(), codegen.ConstBool(false));
+  }
 
   // Append tuple to buffer
   auto *buffer_ptr = LoadStatePtr(buffer_id_);
   buffer_.Append(codegen, buffer_ptr, tuple);
 
+  // If we need all left tuples at once, the buffer is processed in Produce()
+  if (buffer_all_left_) {
+    return;
+  }
+
   // Check if we should process the filled buffer
   auto *buf_size = buffer_.NumTuples(codegen, buffer_ptr);
   auto *flush_buffer_cond =
@@ -278,9 +329,216 @@ void BufferedTupleCallback::ProjectAndConsume() const {
 void BlockNestedLoopJoinTranslator::FindMatchesForRow(
     ConsumerContext &ctx, RowBatch::Row &row) const {
   const auto &plan = GetPlanAs<planner::NestedLoopJoinPlan>();
+  if (plan.GetJoinType() != JoinType::INNER) {
+    FindPartnersForRow(ctx, row);
+    return;
+  }
+
   BufferedTupleCallback callback{plan, unique_left_attributes_, ctx, row};
   buffer_.Iterate(GetCodeGen(), LoadStatePtr(buffer_id_), callback);
 }
 
+void BlockNestedLoopJoinTranslator::FindPartnersForRow(
+    ConsumerContext &ctx, RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::NestedLoopJoinPlan>();
+  const auto join_type = plan.GetJoinType();
+
+  // Semi and anti joins only mark the buffered tuples the row joins with,
+  // which are produced once all right rows have been joined with the buffer
+  bool marks_only = join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+
+  // RIGHT and FULL joins track whether the row finds a join partner
+  llvm::Value *matched_ptr = nullptr;
+  if (ProducesUnmatchedRight()) {
+    matched_ptr = codegen.AllocateVariable(codegen.BoolType(), "matched");
+    codegen->CreateStore(codegen.ConstBool(false), matched_ptr);
+  }
+
+  // The row is produced from more than one place, so the attributes of the
+  // projection are made available up front
+  std::vector<RowBatch::ExpressionAccess> derived_attribute_access;
+  const auto *projection_info = plan.GetProjInfo();
+  if (projection_info != nullptr) {
+    ProjectionTranslator::AddNonTrivialAttributes(
+        row.GetBatch(), *projection_info, derived_attribute_access);
+  }
+
+  auto *buffer_ptr = LoadStatePtr(buffer_id_);
+  auto *end = buffer_.BufferEnd(codegen, buffer_ptr);
+  auto continue_cond = [&](llvm::Value *pos) {
+    return codegen->CreateICmpNE(pos, end);
+  };
+
+  auto *start = buffer_.BufferStart(codegen, buffer_ptr);
+  lang::Loop loop{codegen, continue_cond(start), {{"pos", start}}};
+  {
+    auto *pos = loop.GetLoopVar(0);
+
+    // The left attributes only go into a copy of the row, since the row itself
+    // may be produced again after the loop
+    std::vector<codegen::Value> left_tuple;
+    buffer_.LoadTuple(codegen, pos, left_tuple);
+    RowBatch::Row match_row{row};
+    for (uint32_t i = 0; i < unique_left_attributes_.size(); i++) {
+      match_row.RegisterAttributeValue(unique_left_attributes_[i],
+                                       left_tuple[i]);
+    }
+
+    auto on_match = [&]() {
+      if (TracksLeftMatches()) {
+        buffer_.StoreValue(
+            codegen, pos, static_cast<uint32_t>(unique_left_attributes_.size()),
+            codegen::Value{type::Boolean::Instance(), codegen.ConstBool(true)});
+      }
+      if (matched_ptr != nullptr) {
+        codegen->CreateStore(codegen.ConstBool(true), matched_ptr);
+      }
+      if (marks_only) {
+        // The buffered tuple is produced after all right rows
+      } else if (ProducesUnmatchedRight()) {
+        ctx.ConsumeAndRewind(match_row);
+      } else {
+        ctx.Consume(match_row);
+      }
+    };
+
+    auto *predicate = plan.GetPredicate();
+    if (predicate == nullptr) {
+      on_match();
+    } else {
+      const auto &valid = match_row.DeriveValue(codegen, *predicate);
+      lang::If valid_match(codegen, valid);
+      {
+        on_match();
+      }
+      valid_match.EndIf();
+    }
+
+    auto *next = buffer_.NextTuple(codegen, pos);
+    loop.LoopEnd(continue_cond(next), {next});
+  }
+
+  if (matched_ptr == nullptr) {
+    return;
+  }
+
+  // RIGHT and FULL joins produce the row if it found no join partner, padded
+  // with NULL values for the left side
+  llvm::Value *matched = codegen->CreateLoad(matched_ptr);
+  lang::If no_partner{codegen, codegen->CreateNot(matched)};
+  {
+    for (const auto *ai : unique_left_attributes_) {
+      row.RegisterAttributeValue(ai,
+                                 ai->type.GetSqlType().GetNullValue(codegen));
+    }
+    ctx.Consume(row);
+  }
+  no_partner.EndIf();
+}
+
+namespace {
+
+// This is the callback that produces the buffered tuples once all right tuples
+// have been joined with them: those that didn't find a join partner, with NULL
+// values for the right side in LEFT and FULL joins, or those that did in SEMI
+// joins
+class FlaggedTupleCallback : public BufferAccessor::IterateCallback {
+ public:
+  FlaggedTupleCallback(
+      const planner::NestedLoopJoinPlan &plan,
+      const std::vector<const planner::AttributeInfo *> &left_attributes,
+      ConsumerContext &ctx, Vector &selection_vector)
+      : plan_(plan),
+        left_attributes_(left_attributes),
+        ctx_(ctx),
+        selection_vector_(selection_vector) {}
+
+  void ProcessEntry(CodeGen &codegen,
+                    const std::vector<codegen::Value> &left_row) const override {
+    // The matched flag follows the attributes
+    PELOTON_ASSERT(left_row.size() == left_attributes_.size() + 1);
+    const auto join_type = plan_.GetJoinType();
+    llvm::Value *matched = left_row.back().GetValue();
+    if (join_type != JoinType::SEMI) {
+      matched = codegen->CreateNot(matched);
+    }
+    lang::If produce{codegen, matched};
+    {
+      // Create a row-batch of one row, place all the attributes into the row
+      RowBatch batch{ctx_.GetCompilationContext(), codegen.Const32(0),
+                     codegen.Const32(1), selection_vector_, false};
+      RowBatch::Row row = batch.GetRowAt(codegen.Const32(0));
+      for (size_t i = 0; i < left_attributes_.size(); i++) {
+        row.RegisterAttributeValue(left_attributes_[i], left_row[i]);
+      }
+      if (join_type == JoinType::LEFT || join_type == JoinType::OUTER) {
+        for (const auto *ai : plan_.GetRightAttributes()) {
+          row.RegisterAttributeValue(
+              ai, ai->type.GetSqlType().GetNullValue(codegen));
+        }
+      }
+
+      std::vector<RowBatch::ExpressionAccess> derived_attribute_access;
+      const auto *projection_info = plan_.GetProjInfo();
+      if (projection_info != nullptr) {
+        ProjectionTranslator::AddNonTrivialAttributes(
+            batch, *projection_info, derived_attribute_access);
+      }
+
+      ctx_.Consume(row);
+    }
+    produce.EndIf();
+  }
+
+ private:
+  // The plan
+  const planner::NestedLoopJoinPlan &plan_;
+  // The attributes produced by the left child
+  const std::vector<const planner::AttributeInfo *> &left_attributes_;
+  // The consumer context
+  ConsumerContext &ctx_;
+  // The selection vector of the single-row batch we produce
+  Vector &selection_vector_;
+};
+
+}  // anonymous namespace
+
+void BlockNestedLoopJoinTranslator::FinishConsume(
+    ConsumerContext &context) const {
+  if (IsFromLeftChild(context.GetPipeline()) || !TracksLeftMatches()) {
+    return;
+  }
+
+  // All right tuples have been joined with the buffer. Produce the buffered
+  // tuples that (didn't) find a join partner, one row at a time.
+  CodeGen &codegen = GetCodeGen();
+  auto *raw_vec =
+      codegen.AllocateBuffer(codegen.Int32Type(), 1, "unmatchedSelVector");
+  Vector selection_vector{raw_vec, 1, codegen.Int32Type()};
+  selection_vector.SetValue(codegen, codegen.Const32(0), codegen.Const32(0));
+
+  const auto &plan = GetPlanAs<planner::NestedLoopJoinPlan>();
+  FlaggedTupleCallback callback{plan, unique_left_attributes_, context,
+                                  selection_vector};
+  buffer_.Iterate(codegen, LoadStatePtr(buffer_id_), callback);
+}
+
+bool BlockNestedLoopJoinTranslator::ProducesUnmatchedLeft() const {
+  const auto join_type = GetPlanAs<planner::NestedLoopJoinPlan>().GetJoinType();
+  return join_type == JoinType::LEFT || join_type == JoinType::OUTER;
+}
+
+bool BlockNestedLoopJoinTranslator::TracksLeftMatches() const {
+  const auto join_type = GetPlanAs<planner::NestedLoopJoinPlan>().GetJoinType();
+  return ProducesUnmatchedLeft() || join_type == JoinType::SEMI ||
+         join_type == JoinType::ANTI;
+}
+
+bool BlockNestedLoopJoinTranslator::ProducesUnmatchedRight() const {
+  const auto join_type = GetPlanAs<planner::NestedLoopJoinPlan>().GetJoinType();
+  return join_type == JoinType::RIGHT || join_type == JoinType::OUTER;
+}
+
 }  // namespace codegen
 }  // namespace peloton
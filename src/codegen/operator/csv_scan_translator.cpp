@@ -15,6 +15,7 @@
 #include "codegen/compilation_context.h"
 #include "codegen/function_builder.h"
 #include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
 #include "codegen/operator/projection_translator.h"
 #include "codegen/pipeline.h"
 #include "codegen/proxy/csv_scanner_proxy.h"
@@ -29,8 +30,13 @@ namespace codegen {
 CSVScanTranslator::CSVScanTranslator(const planner::CSVScanPlan &scan,
                                      CompilationContext &context,
                                      Pipeline &pipeline)
-    : OperatorTranslator(scan, context, pipeline) {
-  // Register the CSV scanner instance
+    : OperatorTranslator(scan, context, pipeline), consumer_func_(nullptr) {
+  // Set ourselves as the source of the pipeline
+  auto parallelism = scan.IsParallel() ? Pipeline::Parallelism::Parallel
+                                       : Pipeline::Parallelism::Serial;
+  pipeline.MarkSource(this, parallelism);
+
+  // Register the CSV scanner instance used in serial scans
   auto &query_state = context.GetQueryState();
   scanner_id_ = query_state.RegisterState(
       "csvScanner", CSVScannerProxy::GetType(GetCodeGen()));
@@ -39,32 +45,39 @@ CSVScanTranslator::CSVScanTranslator(const planner::CSVScanPlan &scan,
   scan.GetAttributes(output_attributes_);
 }
 
-void CSVScanTranslator::InitializeQueryState() {
-  auto &codegen = GetCodeGen();
-
-  auto &scan = GetPlanAs<planner::CSVScanPlan>();
-
-  // Arguments
-  llvm::Value *scanner_ptr = LoadStatePtr(scanner_id_);
-  llvm::Value *exec_ctx_ptr = GetExecutorContextPtr();
-  llvm::Value *file_path = codegen.ConstString(scan.GetFileName(), "filePath");
-
-  auto num_cols = static_cast<uint32_t>(output_attributes_.size());
-
+llvm::Value *CSVScanTranslator::ConstColumnTypes(CodeGen &codegen) const {
   // We need to generate an array of type::Type. To do so, we construct a vector
   // of the types of the output columns, and we create an LLVM constant that is
   // a copy of the underlying bytes.
-
   std::vector<codegen::type::Type> col_types_vec;
-  col_types_vec.reserve(num_cols);
+  col_types_vec.reserve(output_attributes_.size());
   for (const auto *ai : output_attributes_) {
     col_types_vec.push_back(ai->type);
   }
   llvm::Value *raw_col_type_bytes = codegen.ConstGenericBytes(
       col_types_vec.data(), static_cast<uint32_t>(col_types_vec.capacity()),
       "colTypes");
-  llvm::Value *output_col_types = codegen->CreatePointerCast(
+  return codegen->CreatePointerCast(
       raw_col_type_bytes, TypeProxy::GetType(codegen)->getPointerTo());
+}
+
+void CSVScanTranslator::InitializeQueryState() {
+  // Parallel scans create thread-local scanners at runtime
+  if (GetPipeline().IsParallel()) {
+    return;
+  }
+
+  auto &codegen = GetCodeGen();
+
+  auto &scan = GetPlanAs<planner::CSVScanPlan>();
+
+  // Arguments
+  llvm::Value *scanner_ptr = LoadStatePtr(scanner_id_);
+  llvm::Value *exec_ctx_ptr = GetExecutorContextPtr();
+  llvm::Value *file_path = codegen.ConstString(scan.GetFileName(), "filePath");
+
+  auto num_cols = static_cast<uint32_t>(output_attributes_.size());
+  llvm::Value *output_col_types = ConstColumnTypes(codegen);
 
   // Now create a pointer to the consumer function
   using ConsumerFuncType = void (*)(void *);
@@ -244,13 +257,47 @@ class CSVColumnAccess : public RowBatch::AttributeAccess {
 
 }  // namespace
 
+void CSVScanTranslator::ConsumeRow(ConsumerContext &ctx,
+                                   llvm::Value *scanner_ptr) const {
+  CodeGen &codegen = GetCodeGen();
+
+  auto &scan = GetPlanAs<planner::CSVScanPlan>();
+
+  Vector v{nullptr, 1, nullptr};
+  RowBatch one{GetCompilationContext(), codegen.Const32(0), codegen.Const32(1),
+               v, false};
+
+  // Load the pointer to the columns view
+  llvm::Value *cols = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+      CSVScannerProxy::GetType(codegen), scanner_ptr, 0, 1));
+
+  llvm::Value *null_str = codegen.ConstString(scan.GetNullString(), "null");
+
+  // Add accessors for all columns into the row batch
+  std::vector<CSVColumnAccess> column_accessors;
+  for (uint32_t i = 0; i < output_attributes_.size(); i++) {
+    column_accessors.emplace_back(output_attributes_[i], cols,
+                                  scan.GetNullString(), null_str);
+  }
+  for (uint32_t i = 0; i < output_attributes_.size(); i++) {
+    one.AddAttribute(output_attributes_[i], &column_accessors[i]);
+  }
+
+  // Push the row through the pipeline
+  RowBatch::Row row{one, nullptr, nullptr};
+  ctx.Consume(row);
+}
+
 // We define the callback/consumer function for CSV parsing here
 void CSVScanTranslator::DefineAuxiliaryFunctions() {
+  // Parallel scans pull rows from the scanner, there is no callback
+  if (GetPipeline().IsParallel()) {
+    return;
+  }
+
   CodeGen &codegen = GetCodeGen();
   CompilationContext &cc = GetCompilationContext();
 
-  auto &scan = GetPlanAs<planner::CSVScanPlan>();
-
   // Define consumer function here
   std::vector<FunctionDeclaration::ArgumentInfo> arg_types = {
       {"queryState", cc.GetQueryState().GetType()->getPointerTo()}};
@@ -261,29 +308,8 @@ void CSVScanTranslator::DefineAuxiliaryFunctions() {
   {
     ConsumerContext ctx{cc, GetPipeline()};
 
-    Vector v{nullptr, 1, nullptr};
-    RowBatch one{GetCompilationContext(), codegen.Const32(0),
-                 codegen.Const32(1), v, false};
-
-    // Load the pointer to the columns view
-    llvm::Value *cols = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
-        CSVScannerProxy::GetType(codegen), LoadStatePtr(scanner_id_), 0, 1));
-
-    llvm::Value *null_str = codegen.ConstString(scan.GetNullString(), "null");
-
-    // Add accessors for all columns into the row batch
-    std::vector<CSVColumnAccess> column_accessors;
-    for (uint32_t i = 0; i < output_attributes_.size(); i++) {
-      column_accessors.emplace_back(output_attributes_[i], cols,
-                                    scan.GetNullString(), null_str);
-    }
-    for (uint32_t i = 0; i < output_attributes_.size(); i++) {
-      one.AddAttribute(output_attributes_[i], &column_accessors[i]);
-    }
-
-    // Push the row through the pipeline
-    RowBatch::Row row{one, nullptr, nullptr};
-    ctx.Consume(row);
+    // Push the current row through the pipeline
+    ConsumeRow(ctx, LoadStatePtr(scanner_id_));
 
     // Done
     scan_consumer.ReturnAndFinish();
@@ -293,12 +319,67 @@ void CSVScanTranslator::DefineAuxiliaryFunctions() {
   consumer_func_ = scan_consumer.GetFunction();
 }
 
-void CSVScanTranslator::Produce() const {
+void CSVScanTranslator::ProduceSerial() const {
   auto *scanner_ptr = LoadStatePtr(scanner_id_);
   GetCodeGen().Call(CSVScannerProxy::Produce, {scanner_ptr});
 }
 
+void CSVScanTranslator::ProduceParallel() const {
+  CodeGen &codegen = GetCodeGen();
+
+  auto &scan = GetPlanAs<planner::CSVScanPlan>();
+
+  // We use CSVScanner::ExecuteParallel() to launch a parallel scan. It splits
+  // the file into morsels and invokes the pipeline function once per thread
+  // with a thread-local scanner we pull rows from.
+  auto *dispatcher = CSVScannerProxy::ExecuteParallel.GetFunction(codegen);
+  std::vector<llvm::Value *> dispatch_args = {
+      codegen.ConstString(scan.GetFileName(), "filePath"),
+      ConstColumnTypes(codegen),
+      codegen.Const32(static_cast<uint32_t>(output_attributes_.size())),
+      codegen.Const8(scan.GetDelimiterChar()),
+      codegen.Const8(scan.GetQuoteChar()),
+      codegen.Const8(scan.GetEscapeChar())};
+
+  // Our function receives the thread-local scanner
+  std::vector<llvm::Type *> pipeline_arg_types = {
+      CSVScannerProxy::GetType(codegen)->getPointerTo()};
+
+  // Parallel production
+  auto producer = [this, &codegen](ConsumerContext &ctx,
+                                   const std::vector<llvm::Value *> &params) {
+    PELOTON_ASSERT(params.size() == 1);
+    llvm::Value *scanner_ptr = params[0];
+
+    // Loop over all rows the scanner produces
+    llvm::Value *has_row = codegen.Call(CSVScannerProxy::NextRow, {scanner_ptr});
+    lang::Loop row_loop{codegen, has_row, {}};
+    {
+      ConsumeRow(ctx, scanner_ptr);
+
+      // Move along
+      has_row = codegen.Call(CSVScannerProxy::NextRow, {scanner_ptr});
+      row_loop.LoopEnd(has_row, {});
+    }
+  };
+
+  // Execute parallel
+  auto &pipeline = GetPipeline();
+  pipeline.RunParallel(dispatcher, dispatch_args, pipeline_arg_types, producer);
+}
+
+void CSVScanTranslator::Produce() const {
+  if (GetPipeline().IsParallel()) {
+    ProduceParallel();
+  } else {
+    ProduceSerial();
+  }
+}
+
 void CSVScanTranslator::TearDownQueryState() {
+  if (GetPipeline().IsParallel()) {
+    return;
+  }
   auto *scanner_ptr = LoadStatePtr(scanner_id_);
   GetCodeGen().Call(CSVScannerProxy::Destroy, {scanner_ptr});
 }
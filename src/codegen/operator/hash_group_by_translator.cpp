@@ -12,18 +12,24 @@
 
 #include "codegen/operator/hash_group_by_translator.h"
 
+#include <limits>
+
 #include "codegen/compilation_context.h"
 #include "codegen/lang/if.h"
+#include "codegen/proxy/concurrent_aggregation_table_proxy.h"
 #include "codegen/proxy/oa_hash_table_proxy.h"
+#include "codegen/proxy/string_id_map_proxy.h"
 #include "codegen/operator/projection_translator.h"
 #include "codegen/lang/vectorized_loop.h"
+#include "codegen/type/bigint_type.h"
+#include "codegen/type/decimal_type.h"
 #include "codegen/type/integer_type.h"
+#include "codegen/varlen.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
 
-std::atomic<bool> HashGroupByTranslator::kUsePrefetch{false};
-
 //===----------------------------------------------------------------------===//
 // HASH GROUP BY TRANSLATOR
 //===----------------------------------------------------------------------===//
@@ -33,8 +39,19 @@ HashGroupByTranslator::HashGroupByTranslator(
     const planner::AggregatePlan &group_by, CompilationContext &context,
     Pipeline &pipeline)
     : OperatorTranslator(group_by, context, pipeline),
-      child_pipeline_(this, Pipeline::Parallelism::Serial),
-      aggregation_(context.GetQueryState()) {
+      child_pipeline_(this, CanShareHashTable()
+                                ? Pipeline::Parallelism::Flexible
+                                : Pipeline::Parallelism::Serial),
+      aggregation_(context.GetQueryState()),
+      use_shared_table_(false) {
+  // Prefetching only pays off once the hash table outgrows the caches, which a
+  // table small enough to be shared never does
+  use_prefetch_ =
+      !CanShareHashTable() &&
+      EstimateHashTableSize() >=
+          static_cast<uint64_t>(settings::SettingsManager::GetInt(
+              settings::SettingId::min_prefetch_hash_table_size));
+
   // If we should be prefetching into the hash-table, install a boundary in the
   // pipeline at the input into this translator to ensure it receives a vector
   // of input tuples
@@ -42,31 +59,52 @@ HashGroupByTranslator::HashGroupByTranslator(
     child_pipeline_.InstallStageBoundary(this);
   }
 
-  // Register the hash-table instance in the runtime state
   CodeGen &codegen = GetCodeGen();
   QueryState &query_state = context.GetQueryState();
-  hash_table_id_ =
-      query_state.RegisterState("groupBy", OAHashTableProxy::GetType(codegen));
 
   // Prepare the input operator to this group by
   context.Prepare(*group_by.GetChild(0), child_pipeline_);
 
+  // The input runs in parallel only if the threads can share the hash table
+  use_shared_table_ = child_pipeline_.IsParallel();
+
   // Prepare the predicate if one exists
   if (group_by.GetPredicate() != nullptr) {
     context.Prepare(*group_by.GetPredicate());
   }
 
+  // Strings read by a scan are grouped on query-wide IDs, which the rows of
+  // frozen tile groups look up by their dictionary code. Distinct aggregates
+  // need the actual keys, and so does prefetching, which hashes the keys of a
+  // batch before they are consumed.
+  auto &aggregates = group_by.GetUniqueAggTerms();
+  bool use_string_ids =
+      !use_prefetch_ && !use_shared_table_ &&
+      group_by.GetChild(0)->GetPlanNodeType() == PlanNodeType::SEQSCAN;
+  for (const auto &agg_term : aggregates) {
+    use_string_ids = use_string_ids && !agg_term.distinct;
+  }
+
   // Prepare the grouping expressions
   // TODO: We need to handle grouping keys that are expressions (i.e., prepare)
   std::vector<type::Type> key_type;
   const auto &grouping_ais = group_by.GetGroupbyAIs();
   for (const auto *grouping_ai : grouping_ais) {
-    key_type.push_back(grouping_ai->type);
+    bool string_id_key =
+        use_string_ids && grouping_ai->type.GetSqlType().IsVariableLength();
+    string_id_keys_.push_back(string_id_key);
+    string_id_ais_.push_back(planner::AttributeInfo{
+        type::Integer::Instance(), 0, grouping_ai->name + ".id"});
+    key_type.push_back(string_id_key ? type::Integer::Instance()
+                                     : grouping_ai->type);
+  }
+  if (HasStringIdKeys()) {
+    string_id_map_id_ = query_state.RegisterState(
+        "groupByStringIds", StringIdMapProxy::GetType(codegen));
   }
 
   // Prepare all the aggregation expressions and setup the storage format of
   // values/aggregates in the hash table
-  auto &aggregates = group_by.GetUniqueAggTerms();
   for (const auto &agg_term : aggregates) {
     if (agg_term.expression != nullptr) {
       context.Prepare(*agg_term.expression);
@@ -82,14 +120,60 @@ HashGroupByTranslator::HashGroupByTranslator(
   // Setup the aggregation logic for this group by
   aggregation_.Setup(codegen, aggregates, false, key_type);
 
-  // Create the hash table
-  hash_table_ =
-      OAHashTable{codegen, key_type, aggregation_.GetAggregatesStorageSize()};
+  if (!use_shared_table_) {
+    // Register the hash-table instance in the runtime state
+    hash_table_id_ = query_state.RegisterState(
+        "groupBy", OAHashTableProxy::GetType(codegen));
+
+    // Create the hash table
+    hash_table_ =
+        OAHashTable{codegen, key_type, aggregation_.GetAggregatesStorageSize()};
+    return;
+  }
+
+  // Lay out the aggregates in the shared hash table
+  std::vector<ConcurrentAggregationTable::UpdateOp> update_ops;
+  for (const auto &agg_term : aggregates) {
+    SharedAggregateInfo agg_info;
+    agg_info.value_index = static_cast<uint32_t>(update_ops.size());
+    switch (agg_term.aggtype) {
+      case ExpressionType::AGGREGATE_MIN:
+        update_ops.push_back(ConcurrentAggregationTable::UpdateOp::Min);
+        break;
+      case ExpressionType::AGGREGATE_MAX:
+        update_ops.push_back(ConcurrentAggregationTable::UpdateOp::Max);
+        break;
+      default:
+        update_ops.push_back(ConcurrentAggregationTable::UpdateOp::Add);
+        break;
+    }
+    agg_info.count_index = static_cast<uint32_t>(update_ops.size());
+    if (agg_term.aggtype != ExpressionType::AGGREGATE_COUNT &&
+        agg_term.aggtype != ExpressionType::AGGREGATE_COUNT_STAR) {
+      update_ops.push_back(ConcurrentAggregationTable::UpdateOp::Add);
+    }
+    shared_aggregates_.push_back(agg_info);
+  }
+
+  // Register the shared hash-table instance in the runtime state
+  shared_table_id_ = query_state.RegisterState(
+      "sharedGroupBy", ConcurrentAggregationTableProxy::GetType(codegen));
+  shared_table_ = ConcurrentAggregationTable{codegen, key_type, update_ops};
 }
 
 // Initialize the hash table instance
 void HashGroupByTranslator::InitializeQueryState() {
-  hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
+  if (use_shared_table_) {
+    shared_table_.Init(GetCodeGen(), GetExecutorContextPtr(),
+                       LoadStatePtr(shared_table_id_),
+                       EstimateHashTableSize());
+  } else {
+    hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
+  }
+  if (HasStringIdKeys()) {
+    GetCodeGen().Call(StringIdMapProxy::Init,
+                      {LoadStatePtr(string_id_map_id_)});
+  }
   aggregation_.InitializeQueryState(GetCodeGen());
 }
 
@@ -98,6 +182,22 @@ void HashGroupByTranslator::Produce() const {
   // Let the left child produce its tuples which we aggregate in our hash-table
   GetCompilationContext().Produce(*GetPlan().GetChild(0));
 
+  if (use_shared_table_) {
+    // Send each group up as a batch of its own
+    auto producer = [this](ConsumerContext &ctx) {
+      CodeGen &codegen = GetCodeGen();
+      auto *raw_vec = codegen.AllocateBuffer(codegen.Int32Type(), 1,
+                                             "hgbSharedSelVector");
+      Vector selection_vec{raw_vec, 1, codegen.Int32Type()};
+
+      ProduceSharedResults produce_results{ctx, *this, selection_vec};
+      shared_table_.Iterate(codegen, LoadStatePtr(shared_table_id_),
+                            produce_results);
+    };
+    GetPipeline().RunSerial(producer);
+    return;
+  }
+
   // Send aggregates up in separate pipeline function
   auto producer = [this](ConsumerContext &ctx) {
     CodeGen &codegen = GetCodeGen();
@@ -108,9 +208,16 @@ void HashGroupByTranslator::Produce() const {
     auto *raw_vec = codegen.AllocateBuffer(i32_type, vec_size, "hgbSelVector");
     Vector selection_vec{raw_vec, vec_size, i32_type};
 
+    // The map the IDs of string keys are looked up in
+    llvm::Value *string_ids = nullptr;
+    if (HasStringIdKeys()) {
+      string_ids = LoadStatePtr(string_id_map_id_);
+    }
+
     // Iterate
     const auto &plan = GetPlanAs<planner::AggregatePlan>();
-    ProduceResults produce_results{ctx, plan, aggregation_};
+    ProduceResults produce_results{ctx, plan, aggregation_, string_id_keys_,
+                                   string_ids};
     hash_table_.VectorizedIterate(codegen, LoadStatePtr(hash_table_id_),
                                   selection_vec, produce_results);
   };
@@ -120,6 +227,11 @@ void HashGroupByTranslator::Produce() const {
 
 void HashGroupByTranslator::Consume(ConsumerContext &context,
                                     RowBatch &batch) const {
+  if (HasStringIdKeys()) {
+    ConsumeWithStringIds(context, batch);
+    return;
+  }
+
   if (!UsePrefetching()) {
     OperatorTranslator::Consume(context, batch);
     return;
@@ -128,85 +240,41 @@ void HashGroupByTranslator::Consume(ConsumerContext &context,
   // This aggregation uses prefetching
 
   CodeGen &codegen = GetCodeGen();
+  llvm::Value *hash_table = LoadStatePtr(hash_table_id_);
 
-  // The vector holding the hash values for the group
-  auto *raw_vec = codegen.AllocateBuffer(
-      codegen.Int64Type(), OAHashTable::kDefaultGroupPrefetchSize, "pfVector");
-  Vector hashes{raw_vec, OAHashTable::kDefaultGroupPrefetchSize,
-                codegen.Int64Type()};
-
-  auto group_prefetch = [&](
-      RowBatch::VectorizedIterateCallback::IterationInstance &iter_instance) {
-    llvm::Value *p = codegen.Const32(0);
-    llvm::Value *end =
-        codegen->CreateSub(iter_instance.end, iter_instance.start);
-
-    // The first loop does hash computation and prefetching
-    lang::Loop prefetch_loop{
-        codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
-    {
-      p = prefetch_loop.GetLoopVar(0);
-      RowBatch::Row row =
-          batch.GetRowAt(codegen->CreateAdd(p, iter_instance.start));
-
-      // Collect keys
-      std::vector<codegen::Value> key;
-      CollectHashKeys(row, key);
-
-      // Hash the key and store in prefetch vector
-      llvm::Value *hash_val = hash_table_.HashKey(codegen, key);
-
-      // StoreValue hashed val in prefetch vector
-      hashes.SetValue(codegen, p, hash_val);
-
-      // Prefetch the actual hash table bucket
-      hash_table_.PrefetchBucket(codegen, LoadStatePtr(hash_table_id_),
-                                 hash_val, OAHashTable::PrefetchType::Read,
-                                 OAHashTable::Locality::Medium);
-
-      // End prefetch loop
-      p = codegen->CreateAdd(p, codegen.Const32(1));
-      prefetch_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
-    }
-
-    p = codegen.Const32(0);
-    std::vector<lang::Loop::LoopVariable> loop_vars = {
-        {"p", p}, {"writeIdx", iter_instance.write_pos}};
-    lang::Loop process_loop{codegen, codegen->CreateICmpULT(p, end), loop_vars};
-    {
-      p = process_loop.GetLoopVar(0);
-      llvm::Value *write_pos = process_loop.GetLoopVar(1);
-
-      llvm::Value *read_pos = codegen->CreateAdd(p, iter_instance.start);
-      RowBatch::OutputTracker tracker{batch.GetSelectionVector(), write_pos};
-      RowBatch::Row row = batch.GetRowAt(read_pos, &tracker);
-
-      codegen::Value row_hash{type::Integer::Instance(),
-                              hashes.GetValue(codegen, p)};
-      row.RegisterAttributeValue(&OAHashTable::kHashAI, row_hash);
-
-      // Consume row
-      Consume(context, row);
-
-      // End prefetch loop
-      p = codegen->CreateAdd(p, codegen.Const32(1));
-      process_loop.LoopEnd(codegen->CreateICmpULT(p, end),
-                           {p, tracker.GetFinalOutputPos()});
-    }
+  auto hash_and_prefetch = [&](RowBatch::Row &row) {
+    // Collect keys
+    std::vector<codegen::Value> key;
+    CollectHashKeys(row, key);
+
+    // Hash the key, and prefetch the actual hash table bucket
+    llvm::Value *hash_val = hash_table_.HashKey(codegen, key);
+    hash_table_.PrefetchBucket(codegen, hash_table, hash_val,
+                               OAHashTable::PrefetchType::Read,
+                               OAHashTable::Locality::Medium);
+    return hash_val;
+  };
 
-    std::vector<llvm::Value *> final_vals;
-    process_loop.CollectFinalLoopVariables(final_vals);
+  auto consume = [&](RowBatch::Row &row, llvm::Value *hash_val) {
+    codegen::Value row_hash{type::Integer::Instance(), hash_val};
+    row.RegisterAttributeValue(&OAHashTable::kHashAI, row_hash);
 
-    return final_vals[0];
+    // Consume row
+    Consume(context, row);
   };
 
-  batch.VectorizedIterate(codegen, OAHashTable::kDefaultGroupPrefetchSize,
-                          group_prefetch);
+  ConsumeWithPrefetch(batch, OAHashTable::kDefaultGroupPrefetchSize,
+                      hash_and_prefetch, nullptr, consume);
 }
 
 // Consume the tuples from the context, grouping them into the hash table
 void HashGroupByTranslator::Consume(ConsumerContext &,
                                     RowBatch::Row &row) const {
+  if (use_shared_table_) {
+    ConsumeShared(row);
+    return;
+  }
+
   CodeGen &codegen = GetCodeGen();
 
   // Collect the keys we use to probe the hash table
@@ -239,28 +307,333 @@ void HashGroupByTranslator::Consume(ConsumerContext &,
 
 // Cleanup by destroying the aggregation hash-table
 void HashGroupByTranslator::TearDownQueryState() {
-  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
+  if (use_shared_table_) {
+    shared_table_.Destroy(GetCodeGen(), LoadStatePtr(shared_table_id_));
+  } else {
+    hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
+  }
+  if (HasStringIdKeys()) {
+    GetCodeGen().Call(StringIdMapProxy::Destroy,
+                      {LoadStatePtr(string_id_map_id_)});
+  }
   aggregation_.TearDownQueryState(GetCodeGen());
 }
 
 // Estimate the size of the dynamically constructed hash-table
 uint64_t HashGroupByTranslator::EstimateHashTableSize() const {
-  // TODO: Implement me
-  return 0;
+  // There is one entry for every group the aggregation produces
+  int cardinality = GetPlan().GetCardinality();
+  return cardinality > 0 ? static_cast<uint64_t>(cardinality) : 0;
 }
 
 // Should this aggregation use prefetching
-bool HashGroupByTranslator::UsePrefetching() const {
-  // TODO: Implement me
-  return kUsePrefetch;
-}
+bool HashGroupByTranslator::UsePrefetching() const { return use_prefetch_; }
 
 void HashGroupByTranslator::CollectHashKeys(
     RowBatch::Row &row, std::vector<codegen::Value> &key) const {
   CodeGen &codegen = GetCodeGen();
+  const auto &grouping_ais =
+      GetPlanAs<planner::AggregatePlan>().GetGroupbyAIs();
+  for (uint32_t i = 0; i < grouping_ais.size(); i++) {
+    if (!string_id_keys_[i]) {
+      key.push_back(row.DeriveValue(codegen, grouping_ais[i]));
+    } else if (row.HasAttribute(&string_id_ais_[i])) {
+      key.push_back(row.DeriveValue(codegen, &string_id_ais_[i]));
+    } else {
+      // The ID wasn't looked up with the rest of the batch
+      llvm::Value *id =
+          GetStringId(codegen, LoadStatePtr(string_id_map_id_),
+                      row.DeriveValue(codegen, grouping_ais[i]));
+      key.emplace_back(type::Integer::Instance(), id);
+    }
+  }
+}
+
+bool HashGroupByTranslator::HasStringIdKeys() const {
+  for (bool string_id_key : string_id_keys_) {
+    if (string_id_key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Group the rows of the batch on the IDs of their string keys. The IDs of the
+// dictionary a key is encoded with are looked up once for the batch, and then
+// every row just loads the ID of its code. Only the rows of tile groups that
+// aren't frozen look up their string.
+void HashGroupByTranslator::ConsumeWithStringIds(ConsumerContext &context,
+                                                 RowBatch &batch) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *string_ids = LoadStatePtr(string_id_map_id_);
+  const auto &grouping_ais =
+      GetPlanAs<planner::AggregatePlan>().GetGroupbyAIs();
+
+  // The IDs of the dictionary of every string key, which are null if the key
+  // isn't encoded in this batch
+  std::vector<RowBatch::AttributeAccess *> dictionary_keys(grouping_ais.size(),
+                                                           nullptr);
+  std::vector<llvm::Value *> dictionary_ids(grouping_ais.size(), nullptr);
+  for (uint32_t i = 0; i < grouping_ais.size(); i++) {
+    auto *access = batch.GetAttributeAccess(grouping_ais[i]);
+    if (!string_id_keys_[i] || access == nullptr || !access->HasDictionary()) {
+      continue;
+    }
+    llvm::Value *dictionary = nullptr, *dictionary_size = nullptr;
+    access->GetDictionary(codegen, dictionary, dictionary_size);
+    dictionary_keys[i] = access;
+    dictionary_ids[i] = codegen.Call(StringIdMapProxy::GetDictionaryIds,
+                                     {string_ids, dictionary, dictionary_size});
+  }
+
+  batch.Iterate(codegen, [&](RowBatch::Row &row) {
+    for (uint32_t i = 0; i < grouping_ais.size(); i++) {
+      if (!string_id_keys_[i]) {
+        continue;
+      }
+
+      llvm::Value *id = nullptr;
+      if (dictionary_keys[i] == nullptr) {
+        id = GetStringId(codegen, string_ids,
+                         row.DeriveValue(codegen, grouping_ais[i]));
+      } else {
+        // The code and the string are loaded straight from the accessor, so
+        // the row doesn't cache values that are only set on one branch. The
+        // TID must be cached before branching for the same reason.
+        auto *access = dictionary_keys[i];
+        row.GetTID(codegen);
+        lang::If has_dictionary{codegen,
+                                codegen->CreateIsNotNull(dictionary_ids[i])};
+        llvm::Value *code_id = codegen->CreateLoad(codegen->CreateInBoundsGEP(
+            codegen.Int32Type(), dictionary_ids[i],
+            access->AccessCode(codegen, row)));
+        has_dictionary.ElseBlock();
+        llvm::Value *string_id = GetStringId(codegen, string_ids,
+                                             access->Access(codegen, row));
+        has_dictionary.EndIf();
+        id = has_dictionary.BuildPHI(code_id, string_id);
+      }
+      row.RegisterAttributeValue(&string_id_ais_[i],
+                                 codegen::Value{type::Integer::Instance(), id});
+    }
+
+    Consume(context, row);
+  });
+}
+
+llvm::Value *HashGroupByTranslator::GetStringId(
+    CodeGen &codegen, llvm::Value *string_ids,
+    const codegen::Value &val) const {
+  // A NULL string is looked up as a null pointer
+  llvm::Value *str = val.GetValue();
+  if (val.IsNullable()) {
+    str = codegen->CreateSelect(
+        val.IsNull(codegen),
+        llvm::ConstantPointerNull::get(
+            llvm::cast<llvm::PointerType>(str->getType())),
+        str);
+  }
+  return codegen.Call(StringIdMapProxy::GetId,
+                      {string_ids, str, val.GetLength()});
+}
+
+// The shared hash table pays off for few groups, where merging the tables of
+// every thread would cost about as much as aggregating. It compares keys
+// bytewise, and updates every aggregate with a single 64-bit add, min or max.
+bool HashGroupByTranslator::CanShareHashTable() const {
   const auto &plan = GetPlanAs<planner::AggregatePlan>();
+  auto max_groups = settings::SettingsManager::GetInt(
+      settings::SettingId::max_shared_aggregation_groups);
+  if (max_groups == 0 ||
+      EstimateHashTableSize() > static_cast<uint64_t>(max_groups)) {
+    return false;
+  }
+
   for (const auto *gb_ai : plan.GetGroupbyAIs()) {
-    key.push_back(row.DeriveValue(codegen, gb_ai));
+    if (gb_ai->type.GetSqlType().IsVariableLength()) {
+      return false;
+    }
+  }
+
+  uint32_t num_values = 0;
+  for (const auto &agg_term : plan.GetUniqueAggTerms()) {
+    if (agg_term.distinct) {
+      return false;
+    }
+    if (agg_term.aggtype == ExpressionType::AGGREGATE_COUNT ||
+        agg_term.aggtype == ExpressionType::AGGREGATE_COUNT_STAR) {
+      num_values++;
+      continue;
+    }
+
+    // The rest must aggregate integers, and a sum is only checked for overflow
+    // once it's finalized, so it must not be able to overflow 64 bits
+    auto type_id = agg_term.expression->ResultType().GetSqlType().TypeId();
+    switch (type_id) {
+      case peloton::type::TypeId::TINYINT:
+      case peloton::type::TypeId::SMALLINT:
+      case peloton::type::TypeId::INTEGER:
+        break;
+      case peloton::type::TypeId::BIGINT:
+        if (agg_term.aggtype == ExpressionType::AGGREGATE_MIN ||
+            agg_term.aggtype == ExpressionType::AGGREGATE_MAX) {
+          break;
+        }
+        return false;
+      default:
+        return false;
+    }
+    if (agg_term.aggtype != ExpressionType::AGGREGATE_SUM &&
+        agg_term.aggtype != ExpressionType::AGGREGATE_AVG &&
+        agg_term.aggtype != ExpressionType::AGGREGATE_MIN &&
+        agg_term.aggtype != ExpressionType::AGGREGATE_MAX) {
+      return false;
+    }
+    num_values += 2;
+  }
+  return num_values <= util::ConcurrentAggregationTable::kMaxNumValues;
+}
+
+// Fold the row into the hash table that all threads share
+void HashGroupByTranslator::ConsumeShared(RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+
+  // The table compares keys bytewise, so all NULL keys must look the same
+  std::vector<codegen::Value> key;
+  CollectHashKeys(row, key);
+  for (auto &key_val : key) {
+    if (key_val.IsNullable()) {
+      llvm::Value *is_null = key_val.IsNull(codegen);
+      llvm::Value *raw_val = codegen->CreateSelect(
+          is_null, llvm::Constant::getNullValue(key_val.GetValue()->getType()),
+          key_val.GetValue());
+      key_val = codegen::Value{key_val.GetType(), raw_val, nullptr, is_null};
+    }
+  }
+
+  // Collect the values to fold into the aggregates, in the order they were
+  // laid out in. A NULL value leaves its aggregate as it is.
+  const auto &aggregates =
+      GetPlanAs<planner::AggregatePlan>().GetUniqueAggTerms();
+  std::vector<llvm::Value *> vals;
+  for (const auto &agg_term : aggregates) {
+    if (agg_term.aggtype == ExpressionType::AGGREGATE_COUNT_STAR) {
+      vals.push_back(codegen.Const64(1));
+      continue;
+    }
+
+    codegen::Value val = row.DeriveValue(codegen, *agg_term.expression);
+    llvm::Value *not_null = val.IsNotNull(codegen);
+    llvm::Value *not_null_count =
+        codegen->CreateZExt(not_null, codegen.Int64Type());
+    if (agg_term.aggtype == ExpressionType::AGGREGATE_COUNT) {
+      vals.push_back(not_null_count);
+      continue;
+    }
+
+    int64_t identity = 0;
+    if (agg_term.aggtype == ExpressionType::AGGREGATE_MIN) {
+      identity = std::numeric_limits<int64_t>::max();
+    } else if (agg_term.aggtype == ExpressionType::AGGREGATE_MAX) {
+      identity = std::numeric_limits<int64_t>::min();
+    }
+    llvm::Value *raw_val =
+        codegen->CreateSExtOrTrunc(val.GetValue(), codegen.Int64Type());
+    vals.push_back(
+        codegen->CreateSelect(not_null, raw_val, codegen.Const64(identity)));
+    vals.push_back(not_null_count);
+  }
+
+  shared_table_.Upsert(codegen, LoadStatePtr(shared_table_id_), key, vals);
+}
+
+void HashGroupByTranslator::FinalizeSharedAggregates(
+    CodeGen &codegen, const std::vector<llvm::Value *> &aggregates,
+    std::vector<codegen::Value> &vals) const {
+  const auto &agg_terms =
+      GetPlanAs<planner::AggregatePlan>().GetUniqueAggTerms();
+  for (uint32_t i = 0; i < agg_terms.size(); i++) {
+    const auto &agg_term = agg_terms[i];
+    const auto &agg_info = shared_aggregates_[i];
+    llvm::Value *agg_val = aggregates[agg_info.value_index];
+    switch (agg_term.aggtype) {
+      case ExpressionType::AGGREGATE_COUNT:
+      case ExpressionType::AGGREGATE_COUNT_STAR: {
+        vals.emplace_back(type::BigInt::Instance(), agg_val);
+        break;
+      }
+      case ExpressionType::AGGREGATE_SUM:
+      case ExpressionType::AGGREGATE_MIN:
+      case ExpressionType::AGGREGATE_MAX: {
+        // Bring the aggregate back to the type of its input
+        auto result_type = agg_term.expression->ResultType().AsNullable();
+        llvm::Type *val_type = nullptr, *len_type = nullptr;
+        result_type.GetSqlType().GetTypeForMaterialization(codegen, val_type,
+                                                           len_type);
+        llvm::Value *raw_val = codegen->CreateTrunc(agg_val, val_type);
+        if (agg_term.aggtype == ExpressionType::AGGREGATE_SUM) {
+          llvm::Value *overflow = codegen->CreateICmpNE(
+              codegen->CreateSExt(raw_val, codegen.Int64Type()), agg_val);
+          codegen.ThrowIfOverflow(overflow);
+        }
+
+        // The aggregate is NULL if all values of the group were
+        llvm::Value *is_null = codegen->CreateICmpEQ(
+            aggregates[agg_info.count_index], codegen.Const64(0));
+        vals.emplace_back(result_type, raw_val, nullptr, is_null);
+        break;
+      }
+      case ExpressionType::AGGREGATE_AVG: {
+        codegen::Value sum{type::BigInt::Instance(), agg_val};
+        codegen::Value count{type::BigInt::Instance(),
+                             aggregates[agg_info.count_index]};
+        codegen::Value sum_casted =
+            sum.CastTo(codegen, type::Decimal::Instance());
+        codegen::Value count_casted =
+            count.CastTo(codegen, type::Decimal::Instance());
+        vals.push_back(
+            sum_casted.Div(codegen, count_casted, OnError::ReturnNull));
+        break;
+      }
+      default: {
+        std::string message = StringUtil::Format(
+            "Unexpected aggregate type [%s] when finalizing shared aggregates",
+            ExpressionTypeToString(agg_term.aggtype).c_str());
+        LOG_ERROR("%s", message.c_str());
+        throw Exception{ExceptionType::UNKNOWN_TYPE, message};
+      }
+    }
+  }
+}
+
+void HashGroupByTranslator::SendResults(ConsumerContext &ctx,
+                                        const planner::AggregatePlan &plan,
+                                        RowBatch &batch) {
+  std::vector<RowBatch::ExpressionAccess> derived_attribute_accessors;
+  const auto *project_info = plan.GetProjectInfo();
+  if (project_info != nullptr) {
+    ProjectionTranslator::AddNonTrivialAttributes(batch, *project_info,
+                                                  derived_attribute_accessors);
+  }
+
+  // Row batch is set up, send it up
+  auto *predicate = plan.GetPredicate();
+  if (predicate != nullptr) {
+    // Iterate over the batch, performing a branching predicate check
+    CodeGen &codegen = ctx.GetCompilationContext().GetCodeGen();
+    batch.Iterate(codegen, [&](RowBatch::Row &row) {
+      codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+      lang::If is_valid_row{codegen, valid_row};
+      {
+        // The row is valid, send along the pipeline
+        ctx.Consume(row);
+      }
+      is_valid_row.EndIf();
+    });
+
+  } else {
+    // There isn't a predicate, just send the entire batch as-is
+    ctx.Consume(batch);
   }
 }
 
@@ -307,14 +680,50 @@ codegen::Value HashGroupByTranslator::AggregateAccess::Access(
   return final_agg_vals[agg_index_];
 }
 
+//===----------------------------------------------------------------------===//
+// STRING KEY ACCESS
+//===----------------------------------------------------------------------===//
+
+HashGroupByTranslator::StringKeyAccess::StringKeyAccess(
+    AggregateFinalizer &finalizer, uint32_t key_index, const type::Type &type,
+    llvm::Value *strings)
+    : finalizer_(finalizer),
+      key_index_(key_index),
+      type_(type),
+      strings_(strings) {}
+
+codegen::Value HashGroupByTranslator::StringKeyAccess::Access(
+    CodeGen &codegen, RowBatch::Row &row) {
+  auto *pos = row.GetTID(codegen);
+  const auto &final_agg_vals = finalizer_.GetAggregates(codegen, pos);
+  llvm::Value *id = final_agg_vals[key_index_].GetValue();
+
+  // The string of the ID is a varlen slot, like those of the column it's from
+  llvm::Value *slot_size = codegen.Const32(sizeof(peloton::type::VarlenSlot));
+  llvm::Value *slot = codegen->CreateInBoundsGEP(
+      codegen.ByteType(), strings_, codegen->CreateMul(id, slot_size));
+  llvm::Value *val = nullptr, *length = nullptr, *is_null = nullptr;
+  if (type_.nullable) {
+    Varlen::GetPtrAndLength(codegen, slot, val, length, is_null);
+  } else {
+    Varlen::SafeGetPtrAndLength(codegen, slot, val, length);
+  }
+  return codegen::Value{type_, val, length, is_null};
+}
+
 //===----------------------------------------------------------------------===//
 // PRODUCE RESULTS
 //===----------------------------------------------------------------------===//
 
 HashGroupByTranslator::ProduceResults::ProduceResults(
     ConsumerContext &ctx, const planner::AggregatePlan &plan,
-    const Aggregation &aggregation)
-    : ctx_(ctx), plan_(plan), aggregation_(aggregation) {}
+    const Aggregation &aggregation, const std::vector<bool> &string_id_keys,
+    llvm::Value *string_ids)
+    : ctx_(ctx),
+      plan_(plan),
+      aggregation_(aggregation),
+      string_id_keys_(string_id_keys),
+      string_ids_(string_ids) {}
 
 void HashGroupByTranslator::ProduceResults::ProcessEntries(
     CodeGen &codegen, llvm::Value *start, llvm::Value *end,
@@ -334,11 +743,26 @@ void HashGroupByTranslator::ProduceResults::ProcessEntries(
     accessors.emplace_back(finalizer, i);
   }
 
+  // String keys are stored as their IDs, and turned back into strings
+  std::vector<StringKeyAccess> string_key_accessors;
+  if (string_ids_ != nullptr) {
+    llvm::Value *strings =
+        codegen.Call(StringIdMapProxy::GetStrings, {string_ids_});
+    for (uint64_t i = 0; i < grouping_ais.size(); i++) {
+      string_key_accessors.emplace_back(finalizer, i, grouping_ais[i]->type,
+                                        strings);
+    }
+  }
+
   // Register attributes in the row batch
   for (uint64_t i = 0; i < grouping_ais.size(); i++) {
     LOG_DEBUG("Adding aggregate key attribute '%s' (%p) to batch",
               grouping_ais[i]->name.c_str(), grouping_ais[i]);
-    batch.AddAttribute(grouping_ais[i], &accessors[i]);
+    if (string_id_keys_[i]) {
+      batch.AddAttribute(grouping_ais[i], &string_key_accessors[i]);
+    } else {
+      batch.AddAttribute(grouping_ais[i], &accessors[i]);
+    }
   }
   for (uint64_t i = 0; i < aggregates.size(); i++) {
     auto &agg_term = aggregates[i];
@@ -347,31 +771,48 @@ void HashGroupByTranslator::ProduceResults::ProcessEntries(
     batch.AddAttribute(&agg_term.agg_ai, &accessors[i + grouping_ais.size()]);
   }
 
-  std::vector<RowBatch::ExpressionAccess> derived_attribute_accessors;
-  const auto *project_info = plan_.GetProjectInfo();
-  if (project_info != nullptr) {
-    ProjectionTranslator::AddNonTrivialAttributes(batch, *project_info,
-                                                  derived_attribute_accessors);
-  }
+  SendResults(ctx_, plan_, batch);
+}
 
-  // Row batch is set up, send it up
-  auto *predicate = plan_.GetPredicate();
-  if (predicate != nullptr) {
-    // Iterate over the batch, performing a branching predicate check
-    batch.Iterate(codegen, [&](RowBatch::Row &row) {
-      codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
-      lang::If is_valid_row{codegen, valid_row};
-      {
-        // The row is valid, send along the pipeline
-        ctx_.Consume(row);
-      }
-      is_valid_row.EndIf();
-    });
+//===----------------------------------------------------------------------===//
+// PRODUCE SHARED RESULTS
+//===----------------------------------------------------------------------===//
 
-  } else {
-    // There isn't a predicate, just send the entire batch as-is
-    ctx_.Consume(batch);
+HashGroupByTranslator::ProduceSharedResults::ProduceSharedResults(
+    ConsumerContext &ctx, const HashGroupByTranslator &translator,
+    Vector &selection_vector)
+    : ctx_(ctx), translator_(translator), selection_vector_(selection_vector) {}
+
+void HashGroupByTranslator::ProduceSharedResults::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    const std::vector<llvm::Value *> &aggregates) const {
+  const auto &plan = translator_.GetPlanAs<planner::AggregatePlan>();
+
+  // The attributes of the group: its keys, then its finalized aggregates
+  std::vector<codegen::Value> vals(key);
+  translator_.FinalizeSharedAggregates(codegen, aggregates, vals);
+
+  // A row batch of the one group. Operators above may have filtered the last
+  // batch, so reset its selection vector.
+  selection_vector_.SetValue(codegen, codegen.Const32(0), codegen.Const32(0));
+  RowBatch batch{ctx_.GetCompilationContext(), codegen.Const32(0),
+                 codegen.Const32(1), selection_vector_, false};
+
+  auto &grouping_ais = plan.GetGroupbyAIs();
+  auto &agg_terms = plan.GetUniqueAggTerms();
+  std::vector<SharedAggregateAccess> accessors;
+  for (uint32_t i = 0; i < vals.size(); i++) {
+    accessors.emplace_back(vals, i);
+  }
+  for (uint32_t i = 0; i < grouping_ais.size(); i++) {
+    batch.AddAttribute(grouping_ais[i], &accessors[i]);
   }
+  for (uint32_t i = 0; i < agg_terms.size(); i++) {
+    batch.AddAttribute(&agg_terms[i].agg_ai,
+                       &accessors[i + grouping_ais.size()]);
+  }
+
+  SendResults(ctx_, plan, batch);
 }
 
 //===----------------------------------------------------------------------===//
@@ -12,19 +12,26 @@
 
 #include "codegen/operator/hash_join_translator.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "codegen/expression/tuple_value_translator.h"
 #include "codegen/lang/if.h"
 #include "codegen/lang/vectorized_loop.h"
+#include "codegen/oa_hash_table.h"
+#include "codegen/operator/table_scan_translator.h"
 #include "codegen/proxy/bloom_filter_proxy.h"
 #include "codegen/proxy/hash_table_proxy.h"
+#include "codegen/type/sql_type.h"
+#include "codegen/vector.h"
 #include "expression/tuple_value_expression.h"
 #include "planner/hash_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
 
-std::atomic<bool> HashJoinTranslator::kUsePrefetch{false};
-
 /**
  * The callback used when we probe the hash table with right-side tuples during
  * the probe phase of the join.
@@ -38,10 +45,13 @@ class HashJoinTranslator::ProbeRight : public HashTable::IterateCallback {
    * @param context The context reference
    * @param row A reference to the row from the right side of the join
    * @param right_key A reference to the key from the right side of the join
+   * @param matched_ptr A variable set when the row finds a join partner, or
+   * NULL if the join doesn't need to know
    */
   ProbeRight(const HashJoinTranslator &join_translator,
              ConsumerContext &context, RowBatch::Row &row,
-             const std::vector<codegen::Value> &right_key);
+             const std::vector<codegen::Value> &right_key,
+             llvm::Value *matched_ptr);
 
   /**
    * The callback function called to process each matching tuple found in the
@@ -65,6 +75,9 @@ class HashJoinTranslator::ProbeRight : public HashTable::IterateCallback {
 
   // The value of the key used during the probe
   const std::vector<codegen::Value> &right_key_;
+
+  // The variable tracking whether the row found a join partner
+  llvm::Value *matched_ptr_;
 };
 
 /**
@@ -76,12 +89,12 @@ class HashJoinTranslator::InsertLeft : public HashTable::InsertCallback {
   /**
    * Constructor
    *
-   * @param storage The storage format to serialize values into the table
+   * @param join_translator The translator reference
    * @param values The actual values to store in the table
    */
-  InsertLeft(const CompactStorage &storage,
+  InsertLeft(const HashJoinTranslator &join_translator,
              const std::vector<codegen::Value> &values)
-      : storage_(storage), values_(values) {}
+      : join_translator_(join_translator), values_(values) {}
 
   /**
    * Callback used to serialize a set of values into the table.
@@ -90,7 +103,11 @@ class HashJoinTranslator::InsertLeft : public HashTable::InsertCallback {
    * @param data_space Memory space where the value can be stored.
    */
   void StoreValue(CodeGen &codegen, llvm::Value *space) const override {
-    storage_.StoreValues(codegen, space, values_);
+    join_translator_.left_value_storage_.StoreValues(codegen, space, values_);
+    if (join_translator_.ProducesUnmatchedLeft()) {
+      codegen->CreateStore(codegen.Const8(0),
+                           join_translator_.MatchedFlagPtr(codegen, space));
+    }
   }
 
   /**
@@ -100,17 +117,58 @@ class HashJoinTranslator::InsertLeft : public HashTable::InsertCallback {
    * @return The number of bytes needed to store the value
    */
   llvm::Value *GetValueSize(CodeGen &codegen) const override {
-    return codegen.Const32(storage_.MaxStorageSize());
+    return codegen.Const32(join_translator_.GetValueSize());
   }
 
  private:
-  // The storage format of the values in the hash table
-  const CompactStorage &storage_;
+  // The translator (we need its storage format of the values)
+  const HashJoinTranslator &join_translator_;
 
   // The attribute values from the left side
   const std::vector<codegen::Value> &values_;
 };
 
+/**
+ * The callback used to produce the left tuples that found no join partner in
+ * LEFT and FULL joins, once all right rows have probed the hash table.
+ */
+class HashJoinTranslator::ProduceUnmatchedLeft
+    : public HashTable::IterateCallback {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param join_translator The translator reference
+   * @param context The context reference
+   * @param selection_vector A selection vector for a batch of a single row
+   */
+  ProduceUnmatchedLeft(const HashJoinTranslator &join_translator,
+                       ConsumerContext &context, Vector &selection_vector)
+      : join_translator_(join_translator),
+        context_(context),
+        selection_vector_(selection_vector) {}
+
+  /**
+   * Produce the tuple in the given hash table entry, if it has no partner.
+   *
+   * @param codegen The codegen instance
+   * @param key The key stored in the table
+   * @param data_area Memory space where the value is stored
+   */
+  void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                    llvm::Value *data_area) const override;
+
+ private:
+  // The translator
+  const HashJoinTranslator &join_translator_;
+
+  // The context
+  ConsumerContext &context_;
+
+  // The selection vector of the single-row batch we produce
+  Vector &selection_vector_;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Hash Join Translator
@@ -121,15 +179,22 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
                                        CompilationContext &context,
                                        Pipeline &pipeline)
     : OperatorTranslator(join, context, pipeline),
-      left_pipeline_(this, Pipeline::Parallelism::Flexible) {
+      left_pipeline_(this, Pipeline::Parallelism::Flexible),
+      bloom_filter_pushed_down_(false),
+      tracks_key_range_(false) {
   CodeGen &codegen = GetCodeGen();
   QueryState &query_state = context.GetQueryState();
 
-  // If we should be prefetching into the hash-table, install a boundary in the
-  // both the left and right pipeline at the input into this translator to
-  // ensure it receives a vector of input tuples
+  // Prefetching only pays off once the hash table outgrows the caches
+  use_prefetch_ =
+      EstimateHashTableSize() >=
+      static_cast<uint64_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::min_prefetch_hash_table_size));
+
+  // If we should be prefetching from the hash-table, install a boundary in the
+  // right pipeline at the input into this translator to ensure it receives a
+  // vector of input tuples
   if (UsePrefetching()) {
-    left_pipeline_.InstallStageBoundary(this);
     pipeline.InstallStageBoundary(this);
   }
 
@@ -181,6 +246,11 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   PELOTON_ASSERT(std::equal(left_key_type.begin(), left_key_type.end(),
                             right_key_type.begin()));
 
+  // Let the probe side drop the rows without a join partner as early as it can
+  if (join.IsBloomFilterEnabled()) {
+    PushDownBloomFilter(context);
+  }
+
   // Collect (unique) attributes that are stored in hash-table
   std::unordered_set<const planner::AttributeInfo *> left_key_ais;
   for (auto *left_key_exp : left_key_exprs_) {
@@ -212,9 +282,14 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   }
   needs_output_vector_ = false;
 
+  // LEFT and FULL joins produce left tuples after all right rows have probed
+  // the hash table, which requires a serial probe
+  if (ProducesUnmatchedLeft()) {
+    pipeline.SetSerial();
+  }
+
   // Create the hash table
-  hash_table_ =
-      HashTable{codegen, left_key_type, left_value_storage_.MaxStorageSize()};
+  hash_table_ = HashTable{codegen, left_key_type, GetValueSize()};
 }
 
 // Initialize the hash-table instance
@@ -225,6 +300,14 @@ void HashJoinTranslator::InitializeQueryState() {
     bloom_filter_.Init(GetCodeGen(), LoadStatePtr(bloom_filter_id_),
                        EstimateCardinalityLeft());
   }
+  if (tracks_key_range_) {
+    // The range starts out empty
+    CodeGen &codegen = GetCodeGen();
+    codegen->CreateStore(codegen.Const64(std::numeric_limits<int64_t>::max()),
+                         LoadStatePtr(key_min_id_));
+    codegen->CreateStore(codegen.Const64(std::numeric_limits<int64_t>::min()),
+                         LoadStatePtr(key_max_id_));
+  }
 }
 
 // Produce!
@@ -240,96 +323,57 @@ void HashJoinTranslator::Produce() const {
 
 void HashJoinTranslator::Consume(ConsumerContext &context,
                                  RowBatch &batch) const {
-  OperatorTranslator::Consume(context, batch);
-#if 0
-  if (!UsePrefetching()) {
+  if (IsFromLeftChild(context)) {
     OperatorTranslator::Consume(context, batch);
     return;
   }
 
-  // This aggregation uses prefetching
-  // TODO: This code is copied verbatime from aggregation ... REFACTOR!
-
   CodeGen &codegen = GetCodeGen();
 
-  // The vector holding the hash values for the group
-  auto *raw_vec = codegen.AllocateBuffer(
-      codegen.Int64Type(), OAHashTable::kDefaultGroupPrefetchSize, "pfVector");
-  Vector hashes{raw_vec, OAHashTable::kDefaultGroupPrefetchSize,
-                codegen.Int64Type()};
-
-  auto group_prefetch = [&](
-      RowBatch::VectorizedIterateCallback::IterationInstance &iter_instance) {
-    llvm::Value *p = codegen.Const32(0);
-    llvm::Value *end =
-        codegen->CreateSub(iter_instance.end, iter_instance.start);
-
-    // The first loop does hash computation and prefetching
-    lang::Loop prefetch_loop{
-        codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
-    {
-      p = prefetch_loop.GetLoopVar(0);
-      RowBatch::Row row =
-          batch.GetRowAt(codegen->CreateAdd(p, iter_instance.start));
-
-      // Collect keys
-      std::vector<codegen::Value> key;
-      if (IsFromLeftChild(context)) {
-        CollectKeys(row, left_key_exprs_, key);
-      } else {
-        CollectKeys(row, right_key_exprs_, key);
-      }
-
-      // Hash the key and store in prefetch vector
-      llvm::Value *hash_val = hash_table_.HashKey(codegen, key);
-
-      // StoreValue hashed val in prefetch vector
-      hashes.SetValue(codegen, p, hash_val);
-
-      // Prefetch the actual hash table bucket
-      hash_table_.PrefetchBucket(codegen, LoadStatePtr(hash_table_id_),
-                                 hash_val, OAHashTable::PrefetchType::Read,
-                                 OAHashTable::Locality::Medium);
-
-      // End prefetch loop
-      p = codegen->CreateAdd(p, codegen.Const32(1));
-      prefetch_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
-    }
-
-    p = codegen.Const32(0);
-    std::vector<lang::Loop::LoopVariable> loop_vars = {
-        {"p", p}, {"writeIdx", iter_instance.write_pos}};
-    lang::Loop process_loop{codegen, codegen->CreateICmpULT(p, end), loop_vars};
-    {
-      p = process_loop.GetLoopVar(0);
-      llvm::Value *write_pos = process_loop.GetLoopVar(1);
-
-      llvm::Value *read_pos = codegen->CreateAdd(p, iter_instance.start);
-      RowBatch::OutputTracker tracker{batch.GetSelectionVector(), write_pos};
-      RowBatch::Row row = batch.GetRowAt(read_pos, &tracker);
-
-      codegen::Value row_hash{type::Type{peloton::type::TypeId::INTEGER, false},
-                              hashes.GetValue(codegen, p)};
-      row.RegisterAttributeValue(&OAHashTable::kHashAI, row_hash);
-
-      // Consume row
-      Consume(context, row);
-
-      // End prefetch loop
-      p = codegen->CreateAdd(p, codegen.Const32(1));
-      process_loop.LoopEnd(codegen->CreateICmpULT(p, end),
-                           {p, tracker.GetFinalOutputPos()});
-    }
+  // The bloom filter probes of the batch are counted locally, and added to
+  // the statistics of the shared filter once the batch is done
+  bool probe_bloom_filter =
+      GetJoinPlan().IsBloomFilterEnabled() && !bloom_filter_pushed_down_;
+  BloomFilterAccessor::ProbeCounters counters{nullptr, nullptr};
+  if (probe_bloom_filter) {
+    counters = bloom_filter_.InitCounters(codegen);
+  }
+  const auto *counters_ptr = probe_bloom_filter ? &counters : nullptr;
 
-    std::vector<llvm::Value *> final_vals;
-    process_loop.CollectFinalLoopVariables(final_vals);
+  // Only probing the hash table uses prefetching
+  if (!UsePrefetching()) {
+    batch.Iterate(codegen, [&](RowBatch::Row &row) {
+      ConsumeFromRight(context, row, nullptr, counters_ptr);
+    });
+  } else {
+    llvm::Value *ht_ptr = LoadStatePtr(hash_table_id_);
 
-    return final_vals[0];
-  };
+    // Hash the keys of the rows, prefetching the slots of their buckets in
+    // the directory first, and then the entries at the heads of the buckets
+    auto hash_and_prefetch = [&](RowBatch::Row &row) {
+      std::vector<codegen::Value> key;
+      CollectKeys(row, right_key_exprs_, key);
+      llvm::Value *hash = hash_table_.HashKey(codegen, key);
+      hash_table_.PrefetchBucket(codegen, ht_ptr, hash);
+      return hash;
+    };
+
+    auto prefetch_head = [&](llvm::Value *hash) {
+      hash_table_.PrefetchBucketHead(codegen, ht_ptr, hash);
+    };
+
+    auto consume = [&](RowBatch::Row &row, llvm::Value *hash) {
+      ConsumeFromRight(context, row, hash, counters_ptr);
+    };
+
+    ConsumeWithPrefetch(batch, OAHashTable::kDefaultGroupPrefetchSize,
+                        hash_and_prefetch, prefetch_head, consume);
+  }
 
-  batch.VectorizedIterate(codegen, OAHashTable::kDefaultGroupPrefetchSize,
-                          group_prefetch);
-#endif
+  if (probe_bloom_filter) {
+    bloom_filter_.PublishCounters(codegen, LoadStatePtr(bloom_filter_id_),
+                                  counters);
+  }
 }
 
 // Consume the tuples produced by a child operator
@@ -338,7 +382,7 @@ void HashJoinTranslator::Consume(ConsumerContext &context,
   if (IsFromLeftChild(context)) {
     ConsumeFromLeft(context, row);
   } else {
-    ConsumeFromRight(context, row);
+    ConsumeFromRight(context, row, nullptr, nullptr);
   }
 }
 
@@ -371,13 +415,47 @@ void HashJoinTranslator::ConsumeFromLeft(ConsumerContext &ctx,
   }
 
   // Insert tuples from the left side into the hash table
-  InsertLeft insert_left{left_value_storage_, vals};
+  InsertLeft insert_left{*this, vals};
   hash_table_.InsertLazy(codegen, ht_ptr, hash, key, insert_left);
 
   // Update bloom filter, if enabled
   if (GetJoinPlan().IsBloomFilterEnabled()) {
     bloom_filter_.Add(codegen, LoadStatePtr(bloom_filter_id_), key);
   }
+  if (tracks_key_range_) {
+    UpdateKeyRange(ctx, key[0]);
+  }
+}
+
+void HashJoinTranslator::UpdateKeyRange(ConsumerContext &context,
+                                        const codegen::Value &key) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *min_ptr = LoadStatePtr(key_min_id_);
+  llvm::Value *max_ptr = LoadStatePtr(key_max_id_);
+
+  // NULL keys find no join partner, so they're left out of the range
+  lang::If not_null{codegen, key.IsNotNull(codegen)};
+  {
+    llvm::Value *val =
+        codegen->CreateSExtOrTrunc(key.GetValue(), codegen.Int64Type());
+    if (!context.GetPipeline().IsParallel()) {
+      llvm::Value *min = codegen->CreateLoad(min_ptr);
+      llvm::Value *max = codegen->CreateLoad(max_ptr);
+      codegen->CreateStore(
+          codegen->CreateSelect(codegen->CreateICmpSLT(val, min), val, min),
+          min_ptr);
+      codegen->CreateStore(
+          codegen->CreateSelect(codegen->CreateICmpSGT(val, max), val, max),
+          max_ptr);
+    } else {
+      // All threads build the range together
+      codegen->CreateAtomicRMW(llvm::AtomicRMWInst::BinOp::Min, min_ptr, val,
+                               llvm::AtomicOrdering::Monotonic);
+      codegen->CreateAtomicRMW(llvm::AtomicRMWInst::BinOp::Max, max_ptr, val,
+                               llvm::AtomicOrdering::Monotonic);
+    }
+  }
+  not_null.EndIf();
 }
 
 void HashJoinTranslator::RegisterPipelineState(PipelineContext &pipeline_ctx) {
@@ -431,39 +509,140 @@ void HashJoinTranslator::TearDownPipelineState(PipelineContext &pipeline_ctx) {
 }
 
 // The given row is from the right child. Probe hash-table.
-void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
-                                          RowBatch::Row &row) const {
+void HashJoinTranslator::ConsumeFromRight(
+    ConsumerContext &context, RowBatch::Row &row, llvm::Value *hash,
+    const BloomFilterAccessor::ProbeCounters *counters) const {
+  CodeGen &codegen = GetCodeGen();
+
   // Pull out the values of the keys we probe the hash-table with
   std::vector<codegen::Value> key;
   CollectKeys(row, right_key_exprs_, key);
 
-  if (GetJoinPlan().IsBloomFilterEnabled()) {
+  // RIGHT, FULL, SEMI and ANTI joins track whether the row finds a join
+  // partner
+  llvm::Value *matched_ptr = nullptr;
+  if (ProducesUnmatchedRight() || ProducesRightOnly()) {
+    matched_ptr = codegen.AllocateVariable(codegen.BoolType(), "matched");
+    codegen->CreateStore(codegen.ConstBool(false), matched_ptr);
+  }
+
+  if (GetJoinPlan().IsBloomFilterEnabled() && !bloom_filter_pushed_down_) {
     // Prefilter the tuple using Bloom Filter
     llvm::Value *contains = bloom_filter_.Contains(
-        GetCodeGen(), LoadStatePtr(bloom_filter_id_), key);
+        codegen, LoadStatePtr(bloom_filter_id_), key, counters);
 
-    lang::If is_valid_row{GetCodeGen(), contains};
+    lang::If is_valid_row{codegen, contains};
     {
       // For each tuple that passes the bloom filter, probe the hash table
       // to eliminate the false positives.
-      CodegenHashProbe(context, row, key);
+      CodegenHashProbe(context, row, hash, key, matched_ptr);
     }
     is_valid_row.EndIf();
   } else {
     // Bloom filter is not enabled. Directly probe the hash table
-    CodegenHashProbe(context, row, key);
+    CodegenHashProbe(context, row, hash, key, matched_ptr);
+  }
+
+  if (matched_ptr != nullptr) {
+    ProduceProbedRow(context, row, matched_ptr);
   }
 }
 
-void HashJoinTranslator::CodegenHashProbe(
-    ConsumerContext &context, RowBatch::Row &row,
-    std::vector<codegen::Value> &key) const {
+void HashJoinTranslator::CodegenHashProbe(ConsumerContext &context,
+                                          RowBatch::Row &row,
+                                          llvm::Value *hash,
+                                          std::vector<codegen::Value> &key,
+                                          llvm::Value *matched_ptr) const {
+  CodeGen &codegen = GetCodeGen();
+  auto *ht_ptr = LoadStatePtr(hash_table_id_);
+  if (hash == nullptr) {
+    hash = hash_table_.HashKey(codegen, key);
+  }
+
   if (GetJoinPlan().GetJoinType() == JoinType::INNER) {
     // For inner joins, find all join partners
-    ProbeRight probe_right{*this, context, row, key};
-    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), key,
-                        probe_right);
+    ProbeRight probe_right{*this, context, row, key, matched_ptr};
+    hash_table_.FindAllWithHash(codegen, ht_ptr, hash, key, probe_right);
+    return;
   }
+
+  // The row may be produced again after probing, so the left attributes of a
+  // partner are only placed into a copy of the row
+  RowBatch::Row probe_row{row};
+  ProbeRight probe_right{*this, context, probe_row, key, matched_ptr};
+  if (ProducesRightOnly()) {
+    // SEMI and ANTI joins only need to know whether the row has a partner, so
+    // the probe stops at the first one
+    hash_table_.FindAllUntil(codegen, ht_ptr, hash, key, probe_right,
+                             matched_ptr);
+  } else {
+    hash_table_.FindAllWithHash(codegen, ht_ptr, hash, key, probe_right);
+  }
+}
+
+void HashJoinTranslator::ProduceProbedRow(ConsumerContext &context,
+                                          RowBatch::Row &row,
+                                          llvm::Value *matched_ptr) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *matched = codegen->CreateLoad(matched_ptr);
+
+  // SEMI joins produce the rows with a partner. RIGHT, FULL and ANTI joins
+  // produce those without one, the former with NULL values for the left
+  // attributes.
+  const bool semi = GetJoinPlan().GetJoinType() == JoinType::SEMI;
+  lang::If produce{codegen, semi ? matched : codegen->CreateNot(matched)};
+  {
+    if (ProducesUnmatchedRight()) {
+      RegisterNullLeftValues(codegen, row);
+    }
+    context.Consume(row);
+  }
+  produce.EndIf();
+}
+
+void HashJoinTranslator::ProduceMatch(ConsumerContext &context,
+                                      RowBatch::Row &row,
+                                      llvm::Value *data_area,
+                                      llvm::Value *matched_ptr) const {
+  CodeGen &codegen = GetCodeGen();
+
+  // Remember the left tuple and the right row found a join partner
+  if (ProducesUnmatchedLeft()) {
+    codegen->CreateStore(codegen.Const8(1), MatchedFlagPtr(codegen, data_area));
+  }
+  if (matched_ptr != nullptr) {
+    codegen->CreateStore(codegen.ConstBool(true), matched_ptr);
+  }
+
+  if (ProducesRightOnly()) {
+    // The right row is produced after probing, which ends with this partner
+    return;
+  }
+
+  if (ProducesUnmatchedRight()) {
+    // The right row may be produced again after probing
+    context.ConsumeAndRewind(row);
+  } else {
+    // Send the row up to the parent
+    context.Consume(row);
+  }
+}
+
+void HashJoinTranslator::FinishConsume(ConsumerContext &context) const {
+  if (IsFromLeftChild(context) || !ProducesUnmatchedLeft()) {
+    return;
+  }
+
+  // Every right row has probed the hash table. Produce the left tuples that
+  // (didn't) find a join partner, one row at a time.
+  CodeGen &codegen = GetCodeGen();
+  auto *raw_vec =
+      codegen.AllocateBuffer(codegen.Int32Type(), 1, "unmatchedSelVector");
+  Vector selection_vector{raw_vec, 1, codegen.Int32Type()};
+  selection_vector.SetValue(codegen, codegen.Const32(0), codegen.Const32(0));
+
+  ProduceUnmatchedLeft produce_unmatched{*this, context, selection_vector};
+  hash_table_.Iterate(codegen, LoadStatePtr(hash_table_id_), produce_unmatched);
 }
 
 // Cleanup by destroying the hash-table instance
@@ -477,8 +656,8 @@ void HashJoinTranslator::TearDownQueryState() {
 
 // Estimate the size of the dynamically constructed hash-table
 uint64_t HashJoinTranslator::EstimateHashTableSize() const {
-  // TODO: Implement me
-  return 0;
+  // Every tuple from the left child is inserted
+  return EstimateCardinalityLeft();
 }
 
 // Return the estimated number of tuples produced by the left child
@@ -490,9 +669,70 @@ uint64_t HashJoinTranslator::EstimateCardinalityLeft() const {
 }
 
 // Should this aggregation use prefetching
-bool HashJoinTranslator::UsePrefetching() const {
-  // TODO: Implement me
-  return kUsePrefetch;
+bool HashJoinTranslator::UsePrefetching() const { return use_prefetch_; }
+
+void HashJoinTranslator::PushDownBloomFilter(CompilationContext &context) {
+  // Only joins that drop the right rows without a join partner can drop them
+  // before they reach the join
+  if (ProducesUnmatchedRight() ||
+      GetJoinPlan().GetJoinType() == JoinType::ANTI) {
+    return;
+  }
+
+  // The right side must be a table scan that produces all the keys itself
+  const auto &right_plan = *GetJoinPlan().GetChild(1)->GetChild(0);
+  if (right_plan.GetPlanNodeType() != PlanNodeType::SEQSCAN) {
+    return;
+  }
+  std::vector<const planner::AttributeInfo *> scan_ais;
+  static_cast<const planner::SeqScanPlan &>(right_plan).GetAttributes(scan_ais);
+
+  TableScanTranslator::RuntimeFilter filter;
+  for (const auto *right_key : right_key_exprs_) {
+    if (right_key->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+      return;
+    }
+    const auto *ai =
+        static_cast<const expression::TupleValueExpression *>(right_key)
+            ->GetAttributeRef();
+    if (std::find(scan_ais.begin(), scan_ais.end(), ai) == scan_ais.end()) {
+      return;
+    }
+    filter.attributes.push_back(ai);
+  }
+  filter.bloom_filter_id = bloom_filter_id_;
+
+  // The range of a single integral key also lets the scan skip tile groups.
+  // Both sides widen their key to a BIGINT, so both keys must be integral.
+  const auto is_integral = [](const expression::AbstractExpression &exp) {
+    switch (exp.ResultType().type_id) {
+      case peloton::type::TypeId::TINYINT:
+      case peloton::type::TypeId::SMALLINT:
+      case peloton::type::TypeId::INTEGER:
+      case peloton::type::TypeId::BIGINT:
+        return true;
+      default:
+        return false;
+    }
+  };
+  filter.has_range = false;
+  if (left_key_exprs_.size() == 1 && is_integral(*left_key_exprs_[0]) &&
+      is_integral(*right_key_exprs_[0])) {
+    CodeGen &codegen = GetCodeGen();
+    QueryState &query_state = context.GetQueryState();
+    key_min_id_ = query_state.RegisterState("keyMin", codegen.Int64Type());
+    key_max_id_ = query_state.RegisterState("keyMax", codegen.Int64Type());
+    tracks_key_range_ = true;
+    filter.has_range = true;
+    filter.min_id = key_min_id_;
+    filter.max_id = key_max_id_;
+  }
+
+  auto *scan = static_cast<TableScanTranslator *>(
+      context.GetTranslator(right_plan));
+  PELOTON_ASSERT(scan != nullptr);
+  scan->AddRuntimeFilter(filter);
+  bloom_filter_pushed_down_ = true;
 }
 
 void HashJoinTranslator::CollectKeys(
@@ -516,6 +756,71 @@ const planner::HashJoinPlan &HashJoinTranslator::GetJoinPlan() const {
   return GetPlanAs<planner::HashJoinPlan>();
 }
 
+void HashJoinTranslator::RegisterLeftValues(
+    CodeGen &codegen, RowBatch::Row &row,
+    const std::vector<codegen::Value> &key, llvm::Value *data_area) const {
+  // LoadValues all the values from the hash entry
+  std::vector<codegen::Value> left_vals;
+  left_value_storage_.LoadValues(codegen, data_area, left_vals);
+
+  // Put the values directly into the row
+  for (uint32_t i = 0; i < left_val_ais_.size(); i++) {
+    row.RegisterAttributeValue(left_val_ais_[i], left_vals[i]);
+  }
+
+  for (uint32_t i = 0; i < left_key_exprs_.size(); i++) {
+    const auto *exp = left_key_exprs_[i];
+    if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
+      codegen::Value v = key[i];
+      LOG_DEBUG("Putting AI %s (%p) into row",
+                tve->GetAttributeRef()->name.c_str(), tve->GetAttributeRef());
+      row.RegisterAttributeValue(tve->GetAttributeRef(), v);
+    }
+  }
+}
+
+void HashJoinTranslator::RegisterNullLeftValues(CodeGen &codegen,
+                                                RowBatch::Row &row) const {
+  for (const auto *ai : left_val_ais_) {
+    row.RegisterAttributeValue(ai, ai->type.GetSqlType().GetNullValue(codegen));
+  }
+  for (const auto *exp : left_key_exprs_) {
+    if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *ai = static_cast<const expression::TupleValueExpression *>(exp)
+                     ->GetAttributeRef();
+      row.RegisterAttributeValue(ai,
+                                 ai->type.GetSqlType().GetNullValue(codegen));
+    }
+  }
+}
+
+bool HashJoinTranslator::ProducesUnmatchedLeft() const {
+  const auto join_type = GetJoinPlan().GetJoinType();
+  return join_type == JoinType::LEFT || join_type == JoinType::OUTER;
+}
+
+bool HashJoinTranslator::ProducesRightOnly() const {
+  const auto join_type = GetJoinPlan().GetJoinType();
+  return join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+}
+
+bool HashJoinTranslator::ProducesUnmatchedRight() const {
+  const auto join_type = GetJoinPlan().GetJoinType();
+  return join_type == JoinType::RIGHT || join_type == JoinType::OUTER;
+}
+
+llvm::Value *HashJoinTranslator::MatchedFlagPtr(CodeGen &codegen,
+                                                llvm::Value *data_area) const {
+  return codegen->CreateConstInBoundsGEP1_32(
+      codegen.ByteType(), data_area, left_value_storage_.MaxStorageSize());
+}
+
+uint32_t HashJoinTranslator::GetValueSize() const {
+  uint32_t flag_size = ProducesUnmatchedLeft() ? 1 : 0;
+  return left_value_storage_.MaxStorageSize() + flag_size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// ProbeRight
@@ -524,42 +829,22 @@ const planner::HashJoinPlan &HashJoinTranslator::GetJoinPlan() const {
 
 HashJoinTranslator::ProbeRight::ProbeRight(
     const HashJoinTranslator &join_translator, ConsumerContext &context,
-    RowBatch::Row &row, const std::vector<codegen::Value> &right_key)
+    RowBatch::Row &row, const std::vector<codegen::Value> &right_key,
+    llvm::Value *matched_ptr)
     : join_translator_(join_translator),
       context_(context),
       row_(row),
-      right_key_(right_key) {}
+      right_key_(right_key),
+      matched_ptr_(matched_ptr) {}
 
 void HashJoinTranslator::ProbeRight::ProcessEntry(
     CodeGen &codegen, const std::vector<codegen::Value> &key,
     llvm::Value *data_area) const {
-  const auto &storage = join_translator_.left_value_storage_;
-
   if (join_translator_.needs_output_vector_) {
     // Use output vector for attribute access
     throw Exception{"Shouldn't need output"};
   } else {
-    // LoadValues all the values from the hash entry
-    std::vector<codegen::Value> left_vals;
-    storage.LoadValues(codegen, data_area, left_vals);
-
-    // Put the values directly into the row
-    const auto &left_val_ais = join_translator_.left_val_ais_;
-    for (uint32_t i = 0; i < left_val_ais.size(); i++) {
-      row_.RegisterAttributeValue(left_val_ais[i], left_vals[i]);
-    }
-
-    const auto &left_key_exprs = join_translator_.left_key_exprs_;
-    for (uint32_t i = 0; i < left_key_exprs.size(); i++) {
-      const auto *exp = left_key_exprs[i];
-      if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
-        auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
-        codegen::Value v = key[i];
-        LOG_DEBUG("Putting AI %s (%p) into row",
-                  tve->GetAttributeRef()->name.c_str(), tve->GetAttributeRef());
-        row_.RegisterAttributeValue(tve->GetAttributeRef(), v);
-      }
-    }
+    join_translator_.RegisterLeftValues(codegen, row_, key, data_area);
   }
 
   // Check predicate if one exists
@@ -570,13 +855,45 @@ void HashJoinTranslator::ProbeRight::ProcessEntry(
     lang::If is_valid_row{codegen, valid_row};
     {
       // Send row up to the parent
-      context_.Consume(row_);
+      join_translator_.ProduceMatch(context_, row_, data_area, matched_ptr_);
     }
     is_valid_row.EndIf();
   } else {
     // Send the row up to the parent
-    context_.Consume(row_);
+    join_translator_.ProduceMatch(context_, row_, data_area, matched_ptr_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// ProduceUnmatchedLeft
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinTranslator::ProduceUnmatchedLeft::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  auto *matched_flag = join_translator_.MatchedFlagPtr(codegen, data_area);
+  llvm::Value *unmatched =
+      codegen->CreateICmpEQ(codegen->CreateLoad(matched_flag), codegen.Const8(0));
+
+  lang::If no_partner{codegen, unmatched};
+  {
+    // Create a row-batch of one row with the values of the left tuple, and
+    // NULL values for all right attributes
+    RowBatch batch{context_.GetCompilationContext(), codegen.Const32(0),
+                   codegen.Const32(1), selection_vector_, false};
+    RowBatch::Row row = batch.GetRowAt(codegen.Const32(0));
+
+    join_translator_.RegisterLeftValues(codegen, row, key, data_area);
+    for (const auto *ai : join_translator_.GetJoinPlan().GetRightAttributes()) {
+      row.RegisterAttributeValue(ai,
+                                 ai->type.GetSqlType().GetNullValue(codegen));
+    }
+
+    context_.Consume(row);
   }
+  no_partner.EndIf();
 }
 
 }  // namespace codegen
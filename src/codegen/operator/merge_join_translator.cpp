@@ -0,0 +1,333 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// merge_join_translator.cpp
+//
+// Identification: src/codegen/operator/merge_join_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/merge_join_translator.h"
+
+#include <algorithm>
+
+#include "codegen/compilation_context.h"
+#include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
+#include "codegen/operator/projection_translator.h"
+#include "codegen/proxy/buffer_proxy.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/merge_join_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// This class implements a merge join of two inputs that are sorted on their
+/// join keys. Since the left child is produced in its own pipeline before the
+/// right child, we materialize the left input into a Buffer (an expandable,
+/// contiguous memory region), which keeps it in sorted order. Tuples from the
+/// right side are then merged with the buffer, advancing a cursor into the
+/// buffer as their keys grow. The psuedocode for an INNER join would be:
+///
+/// function main():
+///   Buffer b
+///   for r in R:
+///     if r.key is not NULL:
+///       b.insert(r)
+///
+///   cursor = b.begin()
+///   for s in S:
+///     if s.key is NULL:
+///       continue
+///     while cursor != b.end() and cursor.key < s.key:
+///       cursor++
+///     for r in [cursor, b.end()) while r.key == s.key:
+///       if pred(r, s):
+///         emit(r, s)
+///
+/// Unlike a hash join, the buffer needs no hash table, and every buffered
+/// tuple is compared to a bounded number of right tuples.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Collect the attributes of the left input the expression references
+void CollectLeftAttributes(
+    const expression::AbstractExpression &expr,
+    std::vector<const planner::AttributeInfo *> &left_ais) {
+  if (expr.GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    const auto &tve =
+        static_cast<const expression::TupleValueExpression &>(expr);
+    if (tve.GetTupleId() == 0 &&
+        std::find(left_ais.begin(), left_ais.end(), tve.GetAttributeRef()) ==
+            left_ais.end()) {
+      left_ais.push_back(tve.GetAttributeRef());
+    }
+  }
+  for (uint32_t i = 0; i < expr.GetChildrenSize(); i++) {
+    CollectLeftAttributes(*expr.GetChild(i), left_ais);
+  }
+}
+
+}  // anonymous namespace
+
+MergeJoinTranslator::MergeJoinTranslator(
+    const planner::MergeJoinPlan &join_plan, CompilationContext &context,
+    Pipeline &pipeline)
+    : OperatorTranslator(join_plan, context, pipeline),
+      left_pipeline_(this, Pipeline::Parallelism::Serial) {
+  PELOTON_ASSERT(join_plan.GetChildrenSize() == 2 &&
+                 "Merge join must have exactly two children");
+
+  // Right tuples advance the shared cursor in key order, so they must arrive
+  // one after the other
+  pipeline.SetSerial();
+
+  // Prepare children
+  context.Prepare(*join_plan.GetChild(0), left_pipeline_);
+  context.Prepare(*join_plan.GetChild(1), pipeline);
+
+  // Prepare the join keys
+  std::vector<type::Type> left_input_desc;
+  for (const auto &join_clause : *join_plan.GetJoinClauses()) {
+    PELOTON_ASSERT(!join_clause.reversed_);
+    left_key_exprs_.push_back(join_clause.left_.get());
+    right_key_exprs_.push_back(join_clause.right_.get());
+    context.Prepare(*join_clause.left_);
+    context.Prepare(*join_clause.right_);
+    left_input_desc.push_back(join_clause.left_->ResultType());
+  }
+
+  // Prepare join predicate (if one exists)
+  auto *predicate = join_plan.GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+  }
+
+  // Prepare projection (if one exists)
+  auto *projection = join_plan.GetProjInfo();
+  if (projection != nullptr) {
+    ProjectionTranslator::PrepareProjection(context, *projection);
+  }
+
+  // Collect (unique) attributes from the left side that we buffer alongside
+  // the keys, which are those the projection and the predicate need
+  std::vector<const planner::AttributeInfo *> left_key_ais;
+  for (const auto *left_key_exp : left_key_exprs_) {
+    if (left_key_exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *tve =
+          static_cast<const expression::TupleValueExpression *>(left_key_exp);
+      left_key_ais.push_back(tve->GetAttributeRef());
+    }
+  }
+  std::vector<const planner::AttributeInfo *> left_ais{
+      join_plan.GetLeftAttributes()};
+  if (predicate != nullptr) {
+    CollectLeftAttributes(*predicate, left_ais);
+  }
+  for (const auto *left_ai : left_ais) {
+    if (std::find(left_key_ais.begin(), left_key_ais.end(), left_ai) ==
+            left_key_ais.end() &&
+        std::find(left_val_ais_.begin(), left_val_ais_.end(), left_ai) ==
+            left_val_ais_.end()) {
+      left_val_ais_.push_back(left_ai);
+    }
+  }
+  for (const auto *ai : left_val_ais_) {
+    left_input_desc.push_back(ai->type);
+  }
+
+  // Allocate the buffer and the cursor in runtime state
+  CodeGen &codegen = GetCodeGen();
+  QueryState &query_state = context.GetQueryState();
+  buffer_id_ =
+      query_state.RegisterState("buffer", BufferProxy::GetType(codegen));
+  cursor_id_ = query_state.RegisterState("cursor", codegen.CharPtrType());
+  buffer_ = BufferAccessor(codegen, left_input_desc);
+}
+
+void MergeJoinTranslator::InitializeQueryState() {
+  buffer_.Init(GetCodeGen(), LoadStatePtr(buffer_id_));
+}
+
+void MergeJoinTranslator::TearDownQueryState() {
+  buffer_.Destroy(GetCodeGen(), LoadStatePtr(buffer_id_));
+}
+
+void MergeJoinTranslator::Produce() const {
+  // Let the left child produce the tuples we buffer in Consume()
+  GetCompilationContext().Produce(*GetPlan().GetChild(0));
+
+  // Start merging at the first buffered tuple
+  CodeGen &codegen = GetCodeGen();
+  auto *start = buffer_.BufferStart(codegen, LoadStatePtr(buffer_id_));
+  codegen->CreateStore(start, LoadStatePtr(cursor_id_));
+
+  // Let the right child produce the tuples we merge with the buffer
+  GetCompilationContext().Produce(*GetPlan().GetChild(1));
+}
+
+void MergeJoinTranslator::Consume(ConsumerContext &context,
+                                  RowBatch::Row &row) const {
+  if (IsFromLeftChild(context.GetPipeline())) {
+    ConsumeFromLeft(context, row);
+  } else {
+    ConsumeFromRight(context, row);
+  }
+}
+
+void MergeJoinTranslator::ConsumeFromLeft(
+    UNUSED_ATTRIBUTE ConsumerContext &context, RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+
+  // A NULL key never matches, there's no need to buffer the tuple
+  std::vector<codegen::Value> tuple;
+  auto *key_is_null = CollectKeys(row, left_key_exprs_, tuple);
+  lang::If key_not_null{codegen, codegen->CreateNot(key_is_null)};
+  {
+    for (const auto *left_ai : left_val_ais_) {
+      tuple.push_back(row.DeriveValue(codegen, left_ai));
+    }
+    buffer_.Append(codegen, LoadStatePtr(buffer_id_), tuple);
+  }
+  key_not_null.EndIf();
+}
+
+void MergeJoinTranslator::ConsumeFromRight(ConsumerContext &context,
+                                           RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+
+  std::vector<codegen::Value> right_key;
+  auto *key_is_null = CollectKeys(row, right_key_exprs_, right_key);
+  lang::If key_not_null{codegen, codegen->CreateNot(key_is_null)};
+  {
+    auto *cursor_ptr = LoadStatePtr(cursor_id_);
+    auto *end = buffer_.BufferEnd(codegen, LoadStatePtr(buffer_id_));
+    auto *zero = codegen.Const32(0);
+
+    // Move the cursor past all the buffered tuples with a smaller key. Right
+    // keys only grow, so these never match any later right tuple either.
+    llvm::Value *pos = codegen->CreateLoad(cursor_ptr);
+    lang::Loop skip_loop{
+        codegen, codegen->CreateICmpNE(pos, end), {{"pos", pos}}};
+    {
+      pos = skip_loop.GetLoopVar(0);
+      std::vector<codegen::Value> left_tuple;
+      buffer_.LoadTuple(codegen, pos, left_tuple);
+      auto *is_less =
+          codegen->CreateICmpSLT(CompareKeys(left_tuple, right_key), zero);
+      auto *next =
+          codegen->CreateSelect(is_less, buffer_.NextTuple(codegen, pos), pos);
+      skip_loop.LoopEnd(
+          codegen->CreateAnd(is_less, codegen->CreateICmpNE(next, end)),
+          {next});
+    }
+    std::vector<llvm::Value *> final_pos;
+    skip_loop.CollectFinalLoopVariables(final_pos);
+    pos = final_pos[0];
+    codegen->CreateStore(pos, cursor_ptr);
+
+    // Join the row with all the buffered tuples with an equal key, which start
+    // at the cursor. We don't move the cursor, the next right tuple may have
+    // the same key.
+    lang::Loop match_loop{
+        codegen, codegen->CreateICmpNE(pos, end), {{"matchPos", pos}}};
+    {
+      auto *match_pos = match_loop.GetLoopVar(0);
+      std::vector<codegen::Value> left_tuple;
+      buffer_.LoadTuple(codegen, match_pos, left_tuple);
+      auto *is_match =
+          codegen->CreateICmpEQ(CompareKeys(left_tuple, right_key), zero);
+      lang::If found_match{codegen, is_match};
+      {
+        // Put the left key and values into the row
+        for (uint32_t i = 0; i < left_key_exprs_.size(); i++) {
+          const auto *exp = left_key_exprs_[i];
+          if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+            auto *tve =
+                static_cast<const expression::TupleValueExpression *>(exp);
+            row.RegisterAttributeValue(tve->GetAttributeRef(), left_tuple[i]);
+          }
+        }
+        for (uint32_t i = 0; i < left_val_ais_.size(); i++) {
+          row.RegisterAttributeValue(
+              left_val_ais_[i], left_tuple[left_key_exprs_.size() + i]);
+        }
+
+        std::vector<RowBatch::ExpressionAccess> derived_attribute_access;
+        const auto *projection_info = GetJoinPlan().GetProjInfo();
+        if (projection_info != nullptr) {
+          ProjectionTranslator::AddNonTrivialAttributes(
+              row.GetBatch(), *projection_info, derived_attribute_access);
+        }
+
+        // Check the predicate if one exists, then send the row to the parent
+        auto *predicate = GetJoinPlan().GetPredicate();
+        if (predicate != nullptr) {
+          auto valid_row = row.DeriveValue(codegen, *predicate);
+          lang::If is_valid_row{codegen, valid_row};
+          {
+            context.Consume(row);
+          }
+          is_valid_row.EndIf();
+        } else {
+          context.Consume(row);
+        }
+      }
+      found_match.EndIf();
+
+      auto *next = buffer_.NextTuple(codegen, match_pos);
+      match_loop.LoopEnd(
+          codegen->CreateAnd(is_match, codegen->CreateICmpNE(next, end)),
+          {next});
+    }
+  }
+  key_not_null.EndIf();
+}
+
+llvm::Value *MergeJoinTranslator::CollectKeys(
+    RowBatch::Row &row,
+    const std::vector<const expression::AbstractExpression *> &key_exprs,
+    std::vector<codegen::Value> &keys) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *is_null = codegen.ConstBool(false);
+  for (const auto *exp : key_exprs) {
+    keys.push_back(row.DeriveValue(codegen, *exp));
+    if (keys.back().IsNullable()) {
+      is_null = codegen->CreateOr(is_null, keys.back().IsNull(codegen));
+    }
+  }
+  return is_null;
+}
+
+llvm::Value *MergeJoinTranslator::CompareKeys(
+    const std::vector<codegen::Value> &left_tuple,
+    const std::vector<codegen::Value> &right_key) const {
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *result = nullptr;
+  for (uint32_t i = 0; i < right_key.size(); i++) {
+    auto cmp = left_tuple[i].CompareForSort(codegen, right_key[i]);
+    PELOTON_ASSERT(!cmp.IsNullable());
+    if (result == nullptr) {
+      result = cmp.GetValue();
+    } else {
+      // Only look at this key if all previous keys were equal
+      auto *prev_zero = codegen->CreateICmpEQ(result, codegen.Const32(0));
+      result = codegen->CreateSelect(prev_zero, cmp.GetValue(), result);
+    }
+  }
+  return result;
+}
+
+const planner::MergeJoinPlan &MergeJoinTranslator::GetJoinPlan() const {
+  return GetPlanAs<planner::MergeJoinPlan>();
+}
+
+}  // namespace codegen
+}  // namespace peloton
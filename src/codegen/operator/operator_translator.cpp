@@ -13,6 +13,8 @@
 #include "codegen/operator/operator_translator.h"
 
 #include "codegen/compilation_context.h"
+#include "codegen/lang/loop.h"
+#include "codegen/vector.h"
 
 namespace peloton {
 namespace codegen {
@@ -40,6 +42,78 @@ llvm::Value *OperatorTranslator::GetStorageManagerPtr() const {
   return context_.GetExecutionConsumer().GetStorageManagerPtr(context_);
 }
 
+void OperatorTranslator::ConsumeWithPrefetch(
+    RowBatch &batch, uint32_t group_size,
+    const std::function<llvm::Value *(RowBatch::Row &)> &hash_and_prefetch,
+    const std::function<void(llvm::Value *)> &prefetch_next,
+    const std::function<void(RowBatch::Row &, llvm::Value *)> &consume) const {
+  CodeGen &codegen = GetCodeGen();
+
+  // The vector holding the hash values of the rows in the group
+  auto *raw_vec =
+      codegen.AllocateBuffer(codegen.Int64Type(), group_size, "pfVector");
+  Vector hashes{raw_vec, group_size, codegen.Int64Type()};
+
+  auto group_prefetch = [&](
+      RowBatch::VectorizedIterateCallback::IterationInstance &iter_instance) {
+    llvm::Value *end =
+        codegen->CreateSub(iter_instance.end, iter_instance.start);
+
+    // The first loop does hash computation and prefetching
+    llvm::Value *p = codegen.Const32(0);
+    lang::Loop hash_loop{codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
+    {
+      p = hash_loop.GetLoopVar(0);
+      RowBatch::Row row =
+          batch.GetRowAt(codegen->CreateAdd(p, iter_instance.start));
+      hashes.SetValue(codegen, p, hash_and_prefetch(row));
+
+      p = codegen->CreateAdd(p, codegen.Const32(1));
+      hash_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
+    }
+
+    // The second loop prefetches further, with what the first one prefetched
+    if (prefetch_next) {
+      p = codegen.Const32(0);
+      lang::Loop prefetch_loop{
+          codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
+      {
+        p = prefetch_loop.GetLoopVar(0);
+        prefetch_next(hashes.GetValue(codegen, p));
+
+        p = codegen->CreateAdd(p, codegen.Const32(1));
+        prefetch_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
+      }
+    }
+
+    // The last loop consumes the rows
+    p = codegen.Const32(0);
+    std::vector<lang::Loop::LoopVariable> loop_vars = {
+        {"p", p}, {"writeIdx", iter_instance.write_pos}};
+    lang::Loop process_loop{codegen, codegen->CreateICmpULT(p, end), loop_vars};
+    {
+      p = process_loop.GetLoopVar(0);
+      llvm::Value *write_pos = process_loop.GetLoopVar(1);
+
+      llvm::Value *read_pos = codegen->CreateAdd(p, iter_instance.start);
+      RowBatch::OutputTracker tracker{batch.GetSelectionVector(), write_pos};
+      RowBatch::Row row = batch.GetRowAt(read_pos, &tracker);
+      consume(row, hashes.GetValue(codegen, p));
+
+      p = codegen->CreateAdd(p, codegen.Const32(1));
+      process_loop.LoopEnd(codegen->CreateICmpULT(p, end),
+                           {p, tracker.GetFinalOutputPos()});
+    }
+
+    std::vector<llvm::Value *> final_vals;
+    process_loop.CollectFinalLoopVariables(final_vals);
+
+    return final_vals[0];
+  };
+
+  batch.VectorizedIterate(codegen, group_size, group_prefetch);
+}
+
 llvm::Value *OperatorTranslator::GetThreadStatesPtr() const {
   return context_.GetExecutionConsumer().GetThreadStatesPtr(context_);
 }
@@ -0,0 +1,291 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_translator.cpp
+//
+// Identification: src/codegen/operator/set_op_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/set_op_translator.h"
+
+#include "codegen/compilation_context.h"
+#include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/oa_hash_table_proxy.h"
+#include "planner/set_op_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// We count how often every distinct tuple appears in either input, and
+/// compute the number of copies of it in the result from both counts:
+///
+/// function main():
+///   for t in L:
+///     ht[t].left++
+///   for t in R:
+///     if t in ht:
+///       ht[t].right++
+///
+///   for t, counts in ht:
+///     for i in 1..copies(counts):
+///       emit(t)
+///
+/// where copies() is
+///
+///   INTERSECT:      right > 0 ? 1 : 0
+///   INTERSECT ALL:  min(left, right)
+///   EXCEPT:         right > 0 ? 0 : 1
+///   EXCEPT ALL:     max(left - right, 0)
+///
+/// Both inputs feed the hash table in pipelines of their own, which are serial
+/// since the hash table is shared.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// The number of counters stored per distinct tuple, one per input
+const uint32_t kNumCounters = 2;
+
+}  // namespace
+
+SetOpTranslator::SetOpTranslator(const planner::SetOpPlan &set_op_plan,
+                                 CompilationContext &context,
+                                 Pipeline &pipeline)
+    : OperatorTranslator(set_op_plan, context, pipeline),
+      left_pipeline_(this, Pipeline::Parallelism::Serial),
+      right_pipeline_(this, Pipeline::Parallelism::Serial) {
+  PELOTON_ASSERT(set_op_plan.GetChildrenSize() == 2);
+  CodeGen &codegen = GetCodeGen();
+
+  // Prepare both inputs
+  context.Prepare(*set_op_plan.GetChild(0), left_pipeline_);
+  context.Prepare(*set_op_plan.GetChild(1), right_pipeline_);
+
+  // The hash table is keyed on entire tuples. A column is nullable if it is
+  // nullable in either input.
+  const auto &left_ais = set_op_plan.GetInputAttributes(0);
+  const auto &right_ais = set_op_plan.GetInputAttributes(1);
+  PELOTON_ASSERT(left_ais.size() == right_ais.size());
+  std::vector<type::Type> key_type;
+  for (uint32_t i = 0; i < left_ais.size(); i++) {
+    auto type = left_ais[i]->type;
+    if (right_ais[i]->type.nullable) {
+      type = type.AsNullable();
+    }
+    key_type.push_back(type);
+  }
+
+  hash_table_id_ =
+      context.GetQueryState().RegisterState("setOpHash",
+                                            OAHashTableProxy::GetType(codegen));
+  hash_table_ =
+      OAHashTable{codegen, key_type, kNumCounters * sizeof(int64_t)};
+}
+
+void SetOpTranslator::InitializeQueryState() {
+  hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
+}
+
+void SetOpTranslator::Produce() const {
+  // Count the tuples of both inputs
+  const auto &plan = GetSetOpPlan();
+  GetCompilationContext().Produce(*plan.GetChild(0));
+  GetCompilationContext().Produce(*plan.GetChild(1));
+
+  // Send the result up in a separate pipeline function
+  auto producer = [this](ConsumerContext &ctx) {
+    CodeGen &codegen = GetCodeGen();
+    auto *raw_vec =
+        codegen.AllocateBuffer(codegen.Int32Type(), 1, "setOpSelVector");
+    Vector selection_vector{raw_vec, 1, codegen.Int32Type()};
+    selection_vector.SetValue(codegen, codegen.Const32(0), codegen.Const32(0));
+
+    ProduceTuples produce_tuples{*this, ctx, selection_vector};
+    hash_table_.Iterate(codegen, LoadStatePtr(hash_table_id_),
+                        produce_tuples);
+  };
+  GetPipeline().RunSerial(producer);
+}
+
+void SetOpTranslator::Consume(ConsumerContext &context,
+                              RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+  auto *hash_table = LoadStatePtr(hash_table_id_);
+
+  if (context.GetPipeline() == left_pipeline_) {
+    std::vector<codegen::Value> tuple;
+    CollectTuple(codegen, row, 0, tuple);
+
+    CountLeft count_left{*this};
+    InsertTuple insert_tuple{*this};
+    hash_table_.ProbeOrInsert(codegen, hash_table, nullptr, tuple, count_left,
+                              insert_tuple);
+  } else {
+    PELOTON_ASSERT(context.GetPipeline() == right_pipeline_);
+    std::vector<codegen::Value> tuple;
+    CollectTuple(codegen, row, 1, tuple);
+
+    CountRight count_right{*this};
+    hash_table_.FindAll(codegen, hash_table, tuple, count_right);
+  }
+}
+
+void SetOpTranslator::TearDownQueryState() {
+  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
+}
+
+llvm::Value *SetOpTranslator::CounterPtr(CodeGen &codegen,
+                                         llvm::Value *data_area,
+                                         uint32_t child_idx) const {
+  PELOTON_ASSERT(child_idx < kNumCounters);
+  auto *counters =
+      codegen->CreateBitCast(data_area, codegen.Int64Type()->getPointerTo());
+  return codegen->CreateConstInBoundsGEP1_32(codegen.Int64Type(), counters,
+                                             child_idx);
+}
+
+void SetOpTranslator::IncrementCounter(CodeGen &codegen, llvm::Value *data_area,
+                                       uint32_t child_idx) const {
+  auto *counter_ptr = CounterPtr(codegen, data_area, child_idx);
+  auto *counter = codegen->CreateLoad(counter_ptr);
+  codegen->CreateStore(codegen->CreateAdd(counter, codegen.Const64(1)),
+                       counter_ptr);
+}
+
+void SetOpTranslator::CollectTuple(CodeGen &codegen, RowBatch::Row &row,
+                                   uint32_t child_idx,
+                                   std::vector<codegen::Value> &tuple) const {
+  for (const auto *ai : GetSetOpPlan().GetInputAttributes(child_idx)) {
+    tuple.push_back(row.DeriveValue(codegen, ai));
+  }
+}
+
+llvm::Value *SetOpTranslator::NumOutputCopies(CodeGen &codegen,
+                                              llvm::Value *data_area) const {
+  auto *left = codegen->CreateLoad(CounterPtr(codegen, data_area, 0));
+  auto *right = codegen->CreateLoad(CounterPtr(codegen, data_area, 1));
+  auto *zero = codegen.Const64(0);
+  auto *one = codegen.Const64(1);
+  auto *in_right = codegen->CreateICmpUGT(right, zero);
+
+  switch (GetSetOpPlan().GetSetOp()) {
+    case SetOpType::INTERSECT:
+      return codegen->CreateSelect(in_right, one, zero);
+    case SetOpType::INTERSECT_ALL:
+      return codegen->CreateSelect(codegen->CreateICmpULT(left, right), left,
+                                   right);
+    case SetOpType::EXCEPT:
+      return codegen->CreateSelect(in_right, zero, one);
+    case SetOpType::EXCEPT_ALL:
+      return codegen->CreateSelect(codegen->CreateICmpUGT(left, right),
+                                   codegen->CreateSub(left, right), zero);
+    default:
+      throw Exception{"Unsupported set operation: " +
+                      SetOpTypeToString(GetSetOpPlan().GetSetOp())};
+  }
+}
+
+const planner::SetOpPlan &SetOpTranslator::GetSetOpPlan() const {
+  return GetPlanAs<planner::SetOpPlan>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Count Left
+///
+////////////////////////////////////////////////////////////////////////////////
+
+SetOpTranslator::CountLeft::CountLeft(const SetOpTranslator &translator)
+    : translator_(translator) {}
+
+void SetOpTranslator::CountLeft::ProcessEntry(CodeGen &codegen,
+                                              llvm::Value *data_area) const {
+  translator_.IncrementCounter(codegen, data_area, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Count Right
+///
+////////////////////////////////////////////////////////////////////////////////
+
+SetOpTranslator::CountRight::CountRight(const SetOpTranslator &translator)
+    : translator_(translator) {}
+
+void SetOpTranslator::CountRight::ProcessEntry(
+    CodeGen &codegen, UNUSED_ATTRIBUTE const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  translator_.IncrementCounter(codegen, data_area, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Insert Tuple
+///
+////////////////////////////////////////////////////////////////////////////////
+
+SetOpTranslator::InsertTuple::InsertTuple(const SetOpTranslator &translator)
+    : translator_(translator) {}
+
+void SetOpTranslator::InsertTuple::StoreValue(CodeGen &codegen,
+                                              llvm::Value *data_space) const {
+  // The first appearance of the tuple in the left input
+  codegen->CreateStore(codegen.Const64(1),
+                       translator_.CounterPtr(codegen, data_space, 0));
+  codegen->CreateStore(codegen.Const64(0),
+                       translator_.CounterPtr(codegen, data_space, 1));
+}
+
+llvm::Value *SetOpTranslator::InsertTuple::GetValueSize(
+    CodeGen &codegen) const {
+  return codegen.Const32(kNumCounters * sizeof(int64_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Produce Tuples
+///
+////////////////////////////////////////////////////////////////////////////////
+
+SetOpTranslator::ProduceTuples::ProduceTuples(
+    const SetOpTranslator &translator, ConsumerContext &context,
+    Vector &selection_vector)
+    : translator_(translator),
+      context_(context),
+      selection_vector_(selection_vector) {}
+
+void SetOpTranslator::ProduceTuples::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  const auto &output_ais = translator_.GetSetOpPlan().GetInputAttributes(0);
+  PELOTON_ASSERT(key.size() == output_ais.size());
+
+  auto *num_copies = translator_.NumOutputCopies(codegen, data_area);
+  auto *zero = codegen.Const64(0);
+  lang::Loop copy_loop{
+      codegen, codegen->CreateICmpUGT(num_copies, zero), {{"copy", zero}}};
+  {
+    // Create a row-batch of one row holding the tuple
+    RowBatch batch{context_.GetCompilationContext(), codegen.Const32(0),
+                   codegen.Const32(1), selection_vector_, false};
+    RowBatch::Row row = batch.GetRowAt(codegen.Const32(0));
+    for (uint32_t i = 0; i < output_ais.size(); i++) {
+      row.RegisterAttributeValue(output_ais[i], key[i]);
+    }
+    context_.Consume(row);
+
+    auto *next = codegen->CreateAdd(copy_loop.GetLoopVar(0), codegen.Const64(1));
+    copy_loop.LoopEnd(codegen->CreateICmpULT(next, num_copies), {next});
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,275 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// sorted_group_by_translator.cpp
+//
+// Identification: src/codegen/operator/sorted_group_by_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/sorted_group_by_translator.h"
+
+#include "codegen/compilation_context.h"
+#include "codegen/lang/if.h"
+#include "codegen/operator/projection_translator.h"
+#include "planner/aggregate_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Since the input is sorted on the grouping columns, a group is complete as
+/// soon as we see a row with different grouping keys. We keep the keys and
+/// the aggregates of the current group in the runtime state, and only need
+/// one key comparison per row instead of a hash table probe:
+///
+/// function main():
+///   for r in R:
+///     if has_group and r.keys == group.keys:
+///       group.advance(r)
+///     else:
+///       if has_group:
+///         emit(group.keys, group.finalize())
+///       group = new group(r)
+///       has_group = true
+///   if has_group:
+///     emit(group.keys, group.finalize())
+///
+/// Groups are sent to the parent as soon as they are complete, so the parent
+/// operators belong to the same pipeline as our child. The last group is only
+/// complete once the child has produced all rows, and is sent to the parent
+/// when the (serial) pipeline finishes.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+SortedGroupByTranslator::SortedGroupByTranslator(
+    const planner::AggregatePlan &group_by, CompilationContext &context,
+    Pipeline &pipeline)
+    : OperatorTranslator(group_by, context, pipeline),
+      aggregation_(context.GetQueryState()) {
+  CodeGen &codegen = GetCodeGen();
+
+  // The current group lives in the query state, and the last one is sent up
+  // when the pipeline finishes, both of which need a serial pipeline
+  pipeline.SetSerial();
+
+  // Prepare the input operator to this group by
+  context.Prepare(*group_by.GetChild(0), pipeline);
+
+  // Prepare the predicate if one exists
+  if (group_by.GetPredicate() != nullptr) {
+    context.Prepare(*group_by.GetPredicate());
+  }
+
+  // The storage format of the grouping keys
+  std::vector<type::Type> key_type;
+  for (const auto *grouping_ai : group_by.GetGroupbyAIs()) {
+    key_type.push_back(grouping_ai->type);
+    group_key_storage_.AddType(grouping_ai->type);
+  }
+  auto *group_keys_type = group_key_storage_.Finalize(codegen);
+
+  // Prepare all the aggregation expressions
+  auto &aggregates = group_by.GetUniqueAggTerms();
+  for (const auto &agg_term : aggregates) {
+    if (agg_term.expression != nullptr) {
+      context.Prepare(*agg_term.expression);
+    }
+  }
+
+  // Prepare the projection (if one exists)
+  const auto *projection_info = group_by.GetProjectInfo();
+  if (projection_info != nullptr) {
+    ProjectionTranslator::PrepareProjection(context, *projection_info);
+  }
+
+  // Setup the aggregation logic for this group by
+  aggregation_.Setup(codegen, aggregates, false, key_type);
+
+  auto *aggregate_storage = aggregation_.GetAggregateStorage().GetStorageType();
+  PELOTON_ASSERT(aggregate_storage->isStructTy());
+  auto *group_aggs_type = llvm::StructType::create(
+      codegen.GetContext(),
+      llvm::cast<llvm::StructType>(aggregate_storage)->elements(), "Group",
+      true);
+
+  // Allocate the state of the current group
+  QueryState &query_state = context.GetQueryState();
+  group_keys_id_ = query_state.RegisterState("groupKeys", group_keys_type);
+  group_aggs_id_ = query_state.RegisterState("groupAggs", group_aggs_type);
+  has_group_id_ = query_state.RegisterState("hasGroup", codegen.BoolType());
+}
+
+void SortedGroupByTranslator::InitializeQueryState() {
+  CodeGen &codegen = GetCodeGen();
+  codegen->CreateStore(codegen.ConstBool(false), LoadStatePtr(has_group_id_));
+  aggregation_.InitializeQueryState(codegen);
+}
+
+void SortedGroupByTranslator::Produce() const {
+  // Let the child produce its tuples which we aggregate group by group
+  GetCompilationContext().Produce(*GetPlan().GetChild(0));
+}
+
+void SortedGroupByTranslator::Consume(ConsumerContext &context,
+                                      RowBatch::Row &row) const {
+  CodeGen &codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::AggregatePlan>();
+
+  // Collect the grouping keys and the values to aggregate
+  std::vector<codegen::Value> keys;
+  for (const auto *grouping_ai : plan.GetGroupbyAIs()) {
+    keys.push_back(row.DeriveValue(codegen, grouping_ai));
+  }
+
+  auto &aggregates = plan.GetUniqueAggTerms();
+  std::vector<codegen::Value> vals{aggregates.size()};
+  for (uint32_t i = 0; i < aggregates.size(); i++) {
+    const auto &agg_term = aggregates[i];
+    if (agg_term.expression != nullptr) {
+      vals[i] = row.DeriveValue(codegen, *agg_term.expression);
+    }
+  }
+
+  // Check if the row belongs to the current group. NULL keys compare equal
+  // to each other, as they should for grouping.
+  auto *has_group = codegen->CreateLoad(LoadStatePtr(has_group_id_));
+  llvm::Value *same_group = nullptr;
+  lang::If check_keys{codegen, has_group};
+  {
+    std::vector<codegen::Value> group_keys;
+    LoadGroupKeys(group_keys);
+    same_group = codegen.ConstBool(true);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+      auto cmp = group_keys[i].CompareForSort(codegen, keys[i]);
+      same_group = codegen->CreateAnd(
+          same_group,
+          codegen->CreateICmpEQ(cmp.GetValue(), codegen.Const32(0)));
+    }
+  }
+  check_keys.EndIf();
+  same_group = check_keys.BuildPHI(same_group, codegen.ConstBool(false));
+
+  auto *group_aggs = LoadStatePtr(group_aggs_id_);
+  lang::If in_group{codegen, same_group};
+  {
+    // Advance the aggregates of the current group
+    aggregation_.AdvanceValues(codegen, group_aggs, vals, keys);
+  }
+  in_group.ElseBlock();
+  {
+    // The row starts a new group, which means the current one is complete
+    lang::If finish_group{codegen, has_group};
+    {
+      FinishGroup(context);
+    }
+    finish_group.EndIf();
+
+    auto *group_keys = LoadStatePtr(group_keys_id_);
+    UpdateableStorage::NullBitmap null_bitmap{codegen, group_key_storage_,
+                                              group_keys};
+    for (uint32_t i = 0; i < keys.size(); i++) {
+      group_key_storage_.SetValue(codegen, group_keys, i, keys[i],
+                                  null_bitmap);
+    }
+    null_bitmap.WriteBack(codegen);
+
+    aggregation_.CreateInitialValues(codegen, group_aggs, vals, keys);
+    codegen->CreateStore(codegen.ConstBool(true), LoadStatePtr(has_group_id_));
+  }
+  in_group.EndIf();
+}
+
+void SortedGroupByTranslator::FinishConsume(ConsumerContext &context) const {
+  // The last group is only complete once the child has produced all tuples
+  CodeGen &codegen = GetCodeGen();
+  auto *has_group = codegen->CreateLoad(LoadStatePtr(has_group_id_));
+  lang::If finish_last_group{codegen, has_group};
+  {
+    FinishGroup(context);
+  }
+  finish_last_group.EndIf();
+}
+
+void SortedGroupByTranslator::TearDownQueryState() {
+  aggregation_.TearDownQueryState(GetCodeGen());
+}
+
+void SortedGroupByTranslator::LoadGroupKeys(
+    std::vector<codegen::Value> &keys) const {
+  CodeGen &codegen = GetCodeGen();
+  auto *group_keys = LoadStatePtr(group_keys_id_);
+  UpdateableStorage::NullBitmap null_bitmap{codegen, group_key_storage_,
+                                            group_keys};
+  for (uint32_t i = 0; i < group_key_storage_.GetNumElements(); i++) {
+    keys.push_back(
+        group_key_storage_.GetValue(codegen, group_keys, i, null_bitmap));
+  }
+}
+
+void SortedGroupByTranslator::FinishGroup(ConsumerContext &context) const {
+  CodeGen &codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::AggregatePlan>();
+
+  std::vector<codegen::Value> group;
+  LoadGroupKeys(group);
+
+  std::vector<codegen::Value> aggregate_vals;
+  aggregation_.FinalizeValues(codegen, LoadStatePtr(group_aggs_id_),
+                              aggregate_vals);
+  group.insert(group.end(), aggregate_vals.begin(), aggregate_vals.end());
+
+  // Create a row-batch of one row, place all the attributes into the row
+  auto *raw_vec =
+      codegen.AllocateBuffer(codegen.Int32Type(), 1, "sortedGbSelVector");
+  Vector selection_vector{raw_vec, 1, codegen.Int32Type()};
+  selection_vector.SetValue(codegen, codegen.Const32(0), codegen.Const32(0));
+
+  RowBatch batch{GetCompilationContext(), codegen.Const32(0),
+                 codegen.Const32(1), selection_vector, false};
+
+  auto &grouping_ais = plan.GetGroupbyAIs();
+  auto &aggregates = plan.GetUniqueAggTerms();
+  PELOTON_ASSERT(group.size() == grouping_ais.size() + aggregates.size());
+
+  std::vector<GroupAttributeAccess> accessors;
+  for (uint32_t i = 0; i < group.size(); i++) {
+    accessors.emplace_back(group, i);
+  }
+  for (uint32_t i = 0; i < grouping_ais.size(); i++) {
+    batch.AddAttribute(grouping_ais[i], &accessors[i]);
+  }
+  for (uint32_t i = 0; i < aggregates.size(); i++) {
+    batch.AddAttribute(&aggregates[i].agg_ai,
+                       &accessors[i + grouping_ais.size()]);
+  }
+
+  std::vector<RowBatch::ExpressionAccess> derived_attribute_accessors;
+  const auto *project_info = plan.GetProjectInfo();
+  if (project_info != nullptr) {
+    ProjectionTranslator::AddNonTrivialAttributes(batch, *project_info,
+                                                  derived_attribute_accessors);
+  }
+
+  // Check the predicate (i.e., the HAVING clause) if one exists
+  auto *predicate = plan.GetPredicate();
+  if (predicate != nullptr) {
+    batch.Iterate(codegen, [&](RowBatch::Row &row) {
+      codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+      lang::If is_valid_row{codegen, valid_row};
+      {
+        context.Consume(row);
+      }
+      is_valid_row.EndIf();
+    });
+  } else {
+    context.Consume(batch);
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -12,10 +12,14 @@
 
 #include "codegen/operator/table_scan_translator.h"
 
+#include "codegen/bloom_filter_accessor.h"
 #include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/bloom_filter_proxy.h"
 #include "codegen/proxy/executor_context_proxy.h"
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/proxy/storage_manager_proxy.h"
+#include "codegen/proxy/tile_group_proxy.h"
 #include "codegen/proxy/transaction_runtime_proxy.h"
 #include "codegen/proxy/zone_map_proxy.h"
 #include "codegen/type/boolean_type.h"
@@ -50,6 +54,23 @@ class TableScanTranslator::AttributeAccess : public RowBatch::AttributeAccess {
     return raw_row.LoadColumn(codegen, ai_->attribute_id);
   }
 
+  // String columns are encoded with a dictionary in frozen tile groups
+  bool HasDictionary() const override {
+    return ai_->type.GetSqlType().IsVariableLength();
+  }
+
+  void GetDictionary(CodeGen &, llvm::Value *&dictionary,
+                     llvm::Value *&dictionary_size) override {
+    const auto &layout = tile_group_access_.GetLayout(ai_->attribute_id);
+    dictionary = layout.dictionary;
+    dictionary_size = layout.dictionary_size;
+  }
+
+  llvm::Value *AccessCode(CodeGen &codegen, RowBatch::Row &row) override {
+    auto raw_row = tile_group_access_.GetRow(row.GetTID(codegen));
+    return raw_row.LoadCode(codegen, ai_->attribute_id);
+  }
+
   const planner::AttributeInfo *GetAttributeRef() const { return ai_; }
 
  private:
@@ -74,12 +95,22 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
  public:
   // Constructor
   ScanConsumer(ConsumerContext &ctx, const planner::SeqScanPlan &plan,
+               const std::vector<RuntimeFilter> &runtime_filters,
+               const planner::AttributeInfo *dictionary_filter_ai,
                Vector &selection_vector)
       : ctx_(ctx),
         plan_(plan),
+        runtime_filters_(runtime_filters),
+        dictionary_filter_ai_(dictionary_filter_ai),
         selection_vector_(selection_vector),
         tile_group_id_(nullptr),
-        tile_group_ptr_(nullptr) {}
+        tile_group_ptr_(nullptr),
+        code_results_(nullptr),
+        filter_by_code_(nullptr) {}
+
+  // Skip the tile groups whose values are outside the range of a filter
+  llvm::Value *ShouldScanTileGroup(CodeGen &codegen, llvm::Value *table_ptr,
+                                   llvm::Value *tile_group_idx) override;
 
   // The callback when starting iteration over a new tile group
   void TileGroupStart(CodeGen &, llvm::Value *tile_group_id,
@@ -88,6 +119,10 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
     tile_group_ptr_ = tile_group_ptr;
   }
 
+  // Evaluate the predicate over the dictionary of the tile group, if it has one
+  void TileGroupLayout(CodeGen &codegen,
+                       TileGroup::TileGroupAccess &tile_group_access) override;
+
   // The code that forms the body of the scan loop
   void ProcessTuples(CodeGen &codegen, llvm::Value *tid_start,
                      llvm::Value *tid_end,
@@ -107,6 +142,13 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
 
   void PerformReads(CodeGen &codegen, Vector &selection_vector) const;
 
+  // Filter the rows whose TIDs are in the range [tid_start, tid_end] by the
+  // filters pushed into the scan
+  void FilterRowsByRuntimeFilters(CodeGen &codegen,
+                                  const TileGroup::TileGroupAccess &access,
+                                  llvm::Value *tid_start, llvm::Value *tid_end,
+                                  Vector &selection_vector) const;
+
   // Filter all the rows whose TIDs are in the range [tid_start, tid_end] and
   // store their TIDs in the output TID selection vector
   void FilterRowsByPredicate(CodeGen &codegen,
@@ -114,17 +156,28 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
                              llvm::Value *tid_start, llvm::Value *tid_end,
                              Vector &selection_vector) const;
 
+  // The largest dictionary the predicate is evaluated over
+  static constexpr uint32_t kMaxDictionarySize = 1024;
+
  private:
   // The consumer context
   ConsumerContext &ctx_;
   // The plan node
   const planner::SeqScanPlan &plan_;
+  // The filters pushed into the scan
+  const std::vector<RuntimeFilter> &runtime_filters_;
+  // The attribute the predicate can be evaluated per dictionary entry of
+  const planner::AttributeInfo *dictionary_filter_ai_;
   // The selection vector used for vectorized scans
   Vector &selection_vector_;
   // The current tile group id we're scanning over
   llvm::Value *tile_group_id_;
   // The current tile group we're scanning over
   llvm::Value *tile_group_ptr_;
+  // The result of the predicate for every code of the dictionary, and whether
+  // the rows of the current tile group are filtered by looking them up
+  llvm::Value *code_results_;
+  llvm::Value *filter_by_code_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -136,7 +189,9 @@ class TableScanTranslator::ScanConsumer : public codegen::ScanCallback {
 TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
                                          CompilationContext &context,
                                          Pipeline &pipeline)
-    : OperatorTranslator(scan, context, pipeline), table_(*scan.GetTable()) {
+    : OperatorTranslator(scan, context, pipeline),
+      table_(*scan.GetTable()),
+      dictionary_filter_ai_(nullptr) {
   // Set ourselves as the source of the pipeline
   auto parallelism = scan.IsParallel() ? Pipeline::Parallelism::Parallel
                                        : Pipeline::Parallelism::Serial;
@@ -147,6 +202,18 @@ TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
   if (predicate != nullptr) {
     context.Prepare(*predicate);
   }
+
+  // A predicate that only reads a string column, and gives the same result
+  // every time it sees the same value, can be evaluated once per entry of the
+  // dictionary the column is encoded with in frozen tile groups
+  if (predicate != nullptr && predicate->IsDeterministic()) {
+    std::unordered_set<const planner::AttributeInfo *> used_attributes;
+    predicate->GetUsedAttributes(used_attributes);
+    if (used_attributes.size() == 1 &&
+        (*used_attributes.begin())->type.GetSqlType().IsVariableLength()) {
+      dictionary_filter_ai_ = *used_attributes.begin();
+    }
+  }
 }
 
 // TODO merge serial and parallel since there is a lot of duplication
@@ -184,16 +251,19 @@ void TableScanTranslator::ProduceSerial() const {
         AbstractExpressionProxy::GetType(codegen)->getPointerTo());
     size_t num_preds = 0;
 
-    auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
-    if (predicate != nullptr && zone_map_manager->ZoneMapTableExists()) {
-      if (predicate->IsZoneMappable()) {
-        num_preds = predicate->GetNumberofParsedPredicates();
-      }
+    // Frozen tile groups are checked against their own value ranges, even
+    // without zone maps in the catalog
+    const auto &parameters_map =
+        ctx.GetCompilationContext().GetParameterCache().GetParametersMap();
+    if (predicate != nullptr && predicate->IsZoneMappable(&parameters_map)) {
+      num_preds = predicate->GetNumberofParsedPredicates();
     }
 
-    ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
+    ScanConsumer scan_consumer{ctx, GetScanPlan(), runtime_filters_,
+                               dictionary_filter_ai_, position_list};
     table_.GenerateScan(codegen, table_ptr, nullptr, nullptr, vec_size,
-                        predicate_ptr, num_preds, scan_consumer);
+                        GetExecutorContextPtr(), predicate_ptr, num_preds,
+                        scan_consumer);
   };
 
   // Execute serially
@@ -241,17 +311,20 @@ void TableScanTranslator::ProduceParallel() const {
         AbstractExpressionProxy::GetType(codegen)->getPointerTo());
     size_t num_preds = 0;
 
-    auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
-    if (predicate != nullptr && zone_map_manager->ZoneMapTableExists()) {
-      if (predicate->IsZoneMappable()) {
-        num_preds = predicate->GetNumberofParsedPredicates();
-      }
+    // Frozen tile groups are checked against their own value ranges, even
+    // without zone maps in the catalog
+    const auto &parameters_map =
+        ctx.GetCompilationContext().GetParameterCache().GetParametersMap();
+    if (predicate != nullptr && predicate->IsZoneMappable(&parameters_map)) {
+      num_preds = predicate->GetNumberofParsedPredicates();
     }
 
     // Scan the given range of the table
-    ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
+    ScanConsumer scan_consumer{ctx, GetScanPlan(), runtime_filters_,
+                               dictionary_filter_ai_, position_list};
     table_.GenerateScan(codegen, table_ptr, tilegroup_start, tilegroup_end,
-                        vec_size, predicate_ptr, num_preds, scan_consumer);
+                        vec_size, GetExecutorContextPtr(), predicate_ptr,
+                        num_preds, scan_consumer);
   };
 
   // Execute parallel
@@ -284,7 +357,14 @@ void TableScanTranslator::ScanConsumer::ProcessTuples(
   // 1. Filter the rows in the range [tid_start, tid_end) by txn visibility
   FilterRowsByVisibility(codegen, tid_start, tid_end, selection_vector_);
 
-  // 2. Filter rows by the given predicate (if one exists)
+  // 2. Filter rows by the filters pushed into the scan (if any), which are
+  //    usually cheaper and more selective than the predicate
+  if (!runtime_filters_.empty()) {
+    FilterRowsByRuntimeFilters(codegen, tile_group_access, tid_start, tid_end,
+                               selection_vector_);
+  }
+
+  // 3. Filter rows by the given predicate (if one exists)
   auto *predicate = plan_.GetPredicate();
   if (predicate != nullptr) {
     // First perform a vectorized filter, putting TIDs into the selection vector
@@ -292,20 +372,77 @@ void TableScanTranslator::ScanConsumer::ProcessTuples(
                           selection_vector_);
   }
 
-  // 3. Record reads for all of the tuple that are visible and pass predicate
+  // 4. Record reads for all of the tuple that are visible and pass predicate
   PerformReads(codegen, selection_vector_);
 
-  // 4. Setup the (filtered) row batch and setup attribute accessors
+  // 5. Setup the (filtered) row batch and setup attribute accessors
   RowBatch batch{ctx_.GetCompilationContext(), tile_group_id_, tid_start,
                  tid_end, selection_vector_, true};
 
   std::vector<TableScanTranslator::AttributeAccess> attribute_accesses;
   SetupRowBatch(batch, tile_group_access, attribute_accesses);
 
-  // 5. Push the batch into the pipeline
+  // 6. Push the batch into the pipeline
   ctx_.Consume(batch);
 }
 
+void TableScanTranslator::ScanConsumer::TileGroupLayout(
+    CodeGen &codegen, TileGroup::TileGroupAccess &tile_group_access) {
+  if (dictionary_filter_ai_ == nullptr) {
+    return;
+  }
+
+  // Evaluating the predicate over the dictionary only pays off if it has
+  // fewer entries than the tile group has rows
+  uint32_t col_idx = dictionary_filter_ai_->attribute_id;
+  const auto &layout = tile_group_access.GetLayout(col_idx);
+  llvm::Value *num_tuples =
+      codegen.Call(TileGroupProxy::GetNextTupleSlot, {tile_group_ptr_});
+  llvm::Value *dictionary_size = layout.dictionary_size;
+  filter_by_code_ = codegen->CreateAnd(
+      tile_group_access.HasDictionary(codegen, col_idx),
+      codegen->CreateAnd(
+          codegen->CreateICmpULE(dictionary_size,
+                                 codegen.Const32(kMaxDictionarySize)),
+          codegen->CreateICmpULT(dictionary_size, num_tuples)));
+
+  if (code_results_ == nullptr) {
+    code_results_ = codegen.AllocateBuffer(
+        codegen.BoolType(), kMaxDictionarySize, "scanCodeResults");
+  }
+
+  lang::If evaluate_dictionary{codegen, filter_by_code_};
+  {
+    // The rows of the dictionary only have the attribute the predicate reads
+    RowBatch dictionary{ctx_.GetCompilationContext(), codegen.Const32(0),
+                        dictionary_size, selection_vector_, false};
+    const auto *predicate = plan_.GetPredicate();
+
+    llvm::Value *code = codegen.Const32(0);
+    lang::Loop code_loop{codegen,
+                         codegen->CreateICmpULT(code, dictionary_size),
+                         {{"code", code}}};
+    {
+      code = code_loop.GetLoopVar(0);
+      RowBatch::Row row = dictionary.GetRowAt(code);
+      row.RegisterAttributeValue(
+          dictionary_filter_ai_,
+          tile_group_access.LoadDictionaryEntry(codegen, col_idx, code));
+
+      codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+      llvm::Value *bool_val =
+          type::Boolean::Instance().Reify(codegen, valid_row);
+      codegen->CreateStore(
+          bool_val, codegen->CreateInBoundsGEP(codegen.BoolType(),
+                                               code_results_, code));
+
+      code = codegen->CreateAdd(code, codegen.Const32(1));
+      code_loop.LoopEnd(codegen->CreateICmpULT(code, dictionary_size), {code});
+    }
+  }
+  evaluate_dictionary.EndIf();
+}
+
 void TableScanTranslator::ScanConsumer::SetupRowBatch(
     RowBatch &batch, TileGroup::TileGroupAccess &tile_group_access,
     std::vector<TableScanTranslator::AttributeAccess> &access) const {
@@ -345,6 +482,115 @@ void TableScanTranslator::ScanConsumer::FilterRowsByVisibility(
   selection_vector.SetNumElements(out_idx);
 }
 
+llvm::Value *TableScanTranslator::ScanConsumer::ShouldScanTileGroup(
+    CodeGen &codegen, llvm::Value *table_ptr, llvm::Value *tile_group_idx) {
+  QueryState &query_state = ctx_.GetCompilationContext().GetQueryState();
+  llvm::Value *zone_map_manager = nullptr;
+
+  llvm::Value *should_scan = codegen.ConstBool(true);
+  for (const auto &filter : runtime_filters_) {
+    if (!filter.has_range) {
+      continue;
+    }
+    if (zone_map_manager == nullptr) {
+      zone_map_manager = codegen.Call(ZoneMapManagerProxy::GetInstance, {});
+    }
+    llvm::Value *min = query_state.LoadStateValue(codegen, filter.min_id);
+    llvm::Value *max = query_state.LoadStateValue(codegen, filter.max_id);
+    llvm::Value *col_id = codegen.Const32(filter.attributes[0]->attribute_id);
+    llvm::Value *overlaps =
+        codegen.Call(ZoneMapManagerProxy::TileGroupOverlapsRange,
+                     {zone_map_manager, table_ptr, tile_group_idx, col_id,
+                      min, max});
+    should_scan = codegen->CreateAnd(should_scan, overlaps);
+  }
+  return should_scan;
+}
+
+void TableScanTranslator::ScanConsumer::FilterRowsByRuntimeFilters(
+    CodeGen &codegen, const TileGroup::TileGroupAccess &access,
+    llvm::Value *tid_start, llvm::Value *tid_end,
+    Vector &selection_vector) const {
+  QueryState &query_state = ctx_.GetCompilationContext().GetQueryState();
+
+  // The batch we're filtering
+  RowBatch batch{ctx_.GetCompilationContext(), tile_group_id_, tid_start,
+                 tid_end, selection_vector, true};
+
+  // Setup the row batch with attribute accessors for the filtered attributes
+  std::unordered_set<const planner::AttributeInfo *> used_attributes;
+  for (const auto &filter : runtime_filters_) {
+    used_attributes.insert(filter.attributes.begin(), filter.attributes.end());
+  }
+  std::vector<AttributeAccess> attribute_accessors;
+  for (const auto *ai : used_attributes) {
+    attribute_accessors.emplace_back(access, ai);
+  }
+  for (auto &accessor : attribute_accessors) {
+    batch.AddAttribute(accessor.GetAttributeRef(), &accessor);
+  }
+
+  // Load the state of the filters once for the whole batch. A bloom filter
+  // that lets almost every row pass isn't worth probing, which the filter
+  // decides from its statistics. The probes of the batch are counted locally
+  // and only added to those statistics once the batch is done.
+  BloomFilterAccessor bloom_filter;
+  std::vector<llvm::Value *> bloom_filter_ptrs, probe_bloom_filter, mins, maxs;
+  std::vector<BloomFilterAccessor::ProbeCounters> counters;
+  for (const auto &filter : runtime_filters_) {
+    llvm::Value *bloom_filter_ptr =
+        query_state.LoadStatePtr(codegen, filter.bloom_filter_id);
+    bloom_filter_ptrs.push_back(bloom_filter_ptr);
+    probe_bloom_filter.push_back(
+        codegen.Call(BloomFilterProxy::IsSelective, {bloom_filter_ptr}));
+    counters.push_back(bloom_filter.InitCounters(codegen));
+    if (filter.has_range) {
+      mins.push_back(query_state.LoadStateValue(codegen, filter.min_id));
+      maxs.push_back(query_state.LoadStateValue(codegen, filter.max_id));
+    } else {
+      mins.push_back(nullptr);
+      maxs.push_back(nullptr);
+    }
+  }
+
+  batch.Iterate(codegen, [&](RowBatch::Row &row) {
+    llvm::Value *valid = codegen.ConstBool(true);
+    for (uint32_t i = 0; i < runtime_filters_.size(); i++) {
+      const auto &filter = runtime_filters_[i];
+      std::vector<codegen::Value> key;
+      for (const auto *ai : filter.attributes) {
+        key.push_back(row.DeriveValue(codegen, ai));
+      }
+
+      // The row must be in the range, and a NULL value is in no range
+      if (filter.has_range) {
+        llvm::Value *val =
+            codegen->CreateSExtOrTrunc(key[0].GetValue(), codegen.Int64Type());
+        llvm::Value *in_range =
+            codegen->CreateAnd(codegen->CreateICmpSGE(val, mins[i]),
+                               codegen->CreateICmpSLE(val, maxs[i]));
+        in_range = codegen->CreateAnd(
+            in_range, codegen->CreateNot(key[0].IsNull(codegen)));
+        valid = codegen->CreateAnd(valid, in_range);
+      }
+
+      // Only probe the bloom filter with rows that are still valid
+      lang::If probe{codegen, codegen->CreateAnd(valid, probe_bloom_filter[i])};
+      llvm::Value *contains = bloom_filter.Contains(
+          codegen, bloom_filter_ptrs[i], key, &counters[i]);
+      probe.EndIf();
+      valid = probe.BuildPHI(contains, valid);
+    }
+
+    // Set the validity of the row
+    row.SetValidity(codegen, valid);
+  });
+
+  for (uint32_t i = 0; i < runtime_filters_.size(); i++) {
+    bloom_filter.PublishCounters(codegen, bloom_filter_ptrs[i], counters[i]);
+  }
+}
+
 void TableScanTranslator::ScanConsumer::FilterRowsByPredicate(
     CodeGen &codegen, const TileGroup::TileGroupAccess &access,
     llvm::Value *tid_start, llvm::Value *tid_end,
@@ -369,18 +615,42 @@ void TableScanTranslator::ScanConsumer::FilterRowsByPredicate(
     batch.AddAttribute(accessor.GetAttributeRef(), &accessor);
   }
 
-  // Iterate over the batch using a scalar loop
-  batch.Iterate(codegen, [&](RowBatch::Row &row) {
-    // Evaluate the predicate to determine row validity
+  // Evaluate the predicate to determine row validity
+  auto evaluate_predicate = [&](RowBatch::Row &row) {
     codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
 
     // Reify the boolean value since it may be NULL
     PELOTON_ASSERT(valid_row.GetType().GetSqlType() ==
                    type::Boolean::Instance());
-    llvm::Value *bool_val = type::Boolean::Instance().Reify(codegen, valid_row);
+    return type::Boolean::Instance().Reify(codegen, valid_row);
+  };
+
+  // Iterate over the batch using a scalar loop
+  batch.Iterate(codegen, [&](RowBatch::Row &row) {
+    if (dictionary_filter_ai_ == nullptr) {
+      row.SetValidity(codegen, evaluate_predicate(row));
+      return;
+    }
+
+    // Look the result of the predicate up by the code of the row if it was
+    // evaluated over the dictionary of the tile group
+    llvm::Value *tid = row.GetTID(codegen);
+    llvm::Value *code_valid, *row_valid;
+    lang::If by_code{codegen, filter_by_code_};
+    {
+      llvm::Value *code = access.GetRow(tid).LoadCode(
+          codegen, dictionary_filter_ai_->attribute_id);
+      code_valid = codegen->CreateLoad(codegen->CreateInBoundsGEP(
+          codegen.BoolType(), code_results_, code));
+    }
+    by_code.ElseBlock();
+    {
+      row_valid = evaluate_predicate(row);
+    }
+    by_code.EndIf();
 
     // Set the validity of the row
-    row.SetValidity(codegen, bool_val);
+    row.SetValidity(codegen, by_code.BuildPHI(code_valid, row_valid));
   });
 }
 
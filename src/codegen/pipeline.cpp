@@ -234,9 +234,11 @@ Pipeline &PipelineContext::GetPipeline() { return pipeline_; }
 
 Pipeline::Pipeline(CompilationContext &compilation_ctx)
     : id_(compilation_ctx.RegisterPipeline(*this)),
+      origin_id_(id_),
       compilation_ctx_(compilation_ctx),
       pipeline_index_(0),
-      parallelism_(Pipeline::Parallelism::Flexible) {}
+      parallelism_(Pipeline::Parallelism::Flexible),
+      num_deferred_finish_(0) {}
 
 Pipeline::Pipeline(OperatorTranslator *translator,
                    Pipeline::Parallelism parallelism)
@@ -244,6 +246,27 @@ Pipeline::Pipeline(OperatorTranslator *translator,
   Add(translator, parallelism);
 }
 
+Pipeline::Pipeline(const Pipeline &pipeline,
+                   const OperatorTranslator *translator)
+    : Pipeline(pipeline.compilation_ctx_) {
+  origin_id_ = pipeline.origin_id_;
+  parallelism_ = pipeline.parallelism_;
+  num_deferred_finish_ = pipeline.num_deferred_finish_;
+
+  // Take over the operators up to and including the translator, along with
+  // the stage boundaries between them
+  auto iter = std::find(pipeline.pipeline_.begin(), pipeline.pipeline_.end(),
+                        translator);
+  PELOTON_ASSERT(iter != pipeline.pipeline_.end());
+  pipeline_.assign(pipeline.pipeline_.begin(), iter + 1);
+  pipeline_index_ = static_cast<uint32_t>(pipeline_.size()) - 1;
+  for (auto boundary : pipeline.stage_boundaries_) {
+    if (boundary <= pipeline_index_) {
+      stage_boundaries_.push_back(boundary);
+    }
+  }
+}
+
 void Pipeline::Add(OperatorTranslator *translator, Parallelism parallelism) {
   // Add the operator to the pipeline
   pipeline_.push_back(translator);
@@ -303,6 +326,13 @@ void Pipeline::MarkSource(OperatorTranslator *translator,
   }
 }
 
+void Pipeline::DeferFinish(const OperatorTranslator *translator) {
+  auto iter = std::find(pipeline_.begin(), pipeline_.end(), translator);
+  PELOTON_ASSERT(iter != pipeline_.end());
+  auto num_deferred = static_cast<uint32_t>(iter - pipeline_.begin()) + 1;
+  num_deferred_finish_ = std::max(num_deferred_finish_, num_deferred);
+}
+
 // Move to the next step in this pipeline
 const OperatorTranslator *Pipeline::NextStep() {
   if (pipeline_index_ > 0) {
@@ -445,9 +475,9 @@ void Pipeline::InitializePipeline(PipelineContext &pipeline_ctx) {
 
 void Pipeline::CompletePipeline(PipelineContext &pipeline_ctx) {
   // Let operators in the pipeline do some post-pipeline work
-  for (auto riter = pipeline_.rbegin(), rend = pipeline_.rend(); riter != rend;
-       ++riter) {
-    (*riter)->FinishPipeline(pipeline_ctx);
+  for (auto i = static_cast<uint32_t>(pipeline_.size());
+       i > num_deferred_finish_; i--) {
+    pipeline_[i - 1]->FinishPipeline(pipeline_ctx);
   }
 
   if (!IsParallel()) {
@@ -564,6 +594,17 @@ void Pipeline::DoRun(
                         func.GetExitBlock());
     body(ctx, pipeline_args);
 
+    // All rows have been consumed. Let the operators produce what they could
+    // not produce before, starting from the bottom of the pipeline so that the
+    // rows pass through all operators above.
+    if (!IsParallel()) {
+      for (auto i = static_cast<uint32_t>(pipeline_.size());
+           i > num_deferred_finish_; i--) {
+        pipeline_index_ = i - 1;
+        pipeline_[i - 1]->FinishConsume(ctx);
+      }
+    }
+
     // Finish
     func.ReturnAndFinish();
   }
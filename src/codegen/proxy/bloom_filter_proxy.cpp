@@ -15,11 +15,18 @@
 namespace peloton {
 namespace codegen {
 
+// The statistics are atomics on the C++ side but plain 64-bit integers here.
+// Generated code never touches them directly, it goes through AddStatistics.
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "BloomFilter statistics must be laid out as uint64_t");
+
 DEFINE_TYPE(BloomFilter, "peloton::BloomFilter", num_hash_funcs, bytes,
             num_bits, num_misses, num_probes);
 
 DEFINE_METHOD(peloton::codegen::util, BloomFilter, Init);
 DEFINE_METHOD(peloton::codegen::util, BloomFilter, Destroy);
+DEFINE_METHOD(peloton::codegen::util, BloomFilter, IsSelective);
+DEFINE_METHOD(peloton::codegen::util, BloomFilter, AddStatistics);
 
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
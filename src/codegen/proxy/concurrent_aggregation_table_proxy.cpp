@@ -0,0 +1,29 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table_proxy.cpp
+//
+// Identification: src/codegen/proxy/concurrent_aggregation_table_proxy.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/concurrent_aggregation_table_proxy.h"
+
+#include "codegen/proxy/executor_context_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+DEFINE_TYPE(ConcurrentAggregationTable, "peloton::ConcurrentAggregationTable",
+            memory, key_size, num_values, update_ops, slot_size, slots,
+            capacity, mask, resize_threshold, num_entries, resize);
+
+DEFINE_METHOD(peloton::codegen::util, ConcurrentAggregationTable, Init);
+DEFINE_METHOD(peloton::codegen::util, ConcurrentAggregationTable, Upsert);
+DEFINE_METHOD(peloton::codegen::util, ConcurrentAggregationTable, Destroy);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -26,6 +26,8 @@ DEFINE_TYPE(CSVScannerColumn, "util::CSVScanner::Column", type, ptr, len,
 DEFINE_METHOD(peloton::codegen::util, CSVScanner, Init);
 DEFINE_METHOD(peloton::codegen::util, CSVScanner, Destroy);
 DEFINE_METHOD(peloton::codegen::util, CSVScanner, Produce);
+DEFINE_METHOD(peloton::codegen::util, CSVScanner, ExecuteParallel);
+DEFINE_METHOD(peloton::codegen::util, CSVScanner, NextRow);
 
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
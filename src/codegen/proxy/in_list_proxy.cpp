@@ -0,0 +1,24 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// in_list_proxy.cpp
+//
+// Identification: src/codegen/proxy/in_list_proxy.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/in_list_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+DEFINE_TYPE(InList, "peloton::InList", values, num_values, has_null);
+
+DEFINE_METHOD(peloton::codegen::util, InList, Init);
+DEFINE_METHOD(peloton::codegen::util, InList, Destroy);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,25 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_matcher_proxy.cpp
+//
+// Identification: src/codegen/proxy/like_matcher_proxy.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/like_matcher_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+DEFINE_TYPE(LikeMatcher, "peloton::LikeMatcher", opaque);
+
+DEFINE_METHOD(peloton::codegen::util, LikeMatcher, Init);
+DEFINE_METHOD(peloton::codegen::util, LikeMatcher, Match);
+DEFINE_METHOD(peloton::codegen::util, LikeMatcher, Destroy);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_id_map_proxy.cpp
+//
+// Identification: src/codegen/proxy/string_id_map_proxy.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/string_id_map_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+DEFINE_TYPE(StringIdMap, "peloton::StringIdMap", opaque);
+
+DEFINE_METHOD(peloton::codegen::util, StringIdMap, Init);
+DEFINE_METHOD(peloton::codegen::util, StringIdMap, Destroy);
+DEFINE_METHOD(peloton::codegen::util, StringIdMap, GetId);
+DEFINE_METHOD(peloton::codegen::util, StringIdMap, GetDictionaryIds);
+DEFINE_METHOD(peloton::codegen::util, StringIdMap, GetStrings);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -23,6 +23,7 @@ DEFINE_TYPE(PredicateInfo, "peloton::storage::PredicateInfo", col_id,
 DEFINE_TYPE(ZoneMapManager, "peloton::storage::ZoneMapManager", opaque);
 
 DEFINE_METHOD(peloton::storage, ZoneMapManager, ShouldScanTileGroup);
+DEFINE_METHOD(peloton::storage, ZoneMapManager, TileGroupOverlapsRange);
 DEFINE_METHOD(peloton::storage, ZoneMapManager, GetInstance);
 
 }  // namespace codegen
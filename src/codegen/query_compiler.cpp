@@ -17,6 +17,7 @@
 #include "planner/hash_join_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "planner/set_op_plan.h"
 
 namespace peloton {
 namespace codegen {
@@ -74,13 +75,30 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
     }
     case PlanNodeType::NESTLOOP:
     case PlanNodeType::HASHJOIN: {
+      // Inner, outer, semi and anti joins are all supported
       const auto &join = static_cast<const planner::AbstractJoinPlan &>(plan);
-      // Right now, only support inner joins
-      if (join.GetJoinType() == JoinType::INNER) {
-        break;
+      if (join.GetJoinType() == JoinType::INVALID) {
+        return false;
+      }
+      break;
+    }
+    case PlanNodeType::MERGEJOIN: {
+      // Right now, merge joins only support inner joins
+      const auto &join = static_cast<const planner::AbstractJoinPlan &>(plan);
+      if (join.GetJoinType() != JoinType::INNER) {
+        return false;
       }
+      break;
+    }
+    case PlanNodeType::HASH:
+    case PlanNodeType::APPEND: {
+      break;
     }
-    case PlanNodeType::HASH: {
+    case PlanNodeType::SETOP: {
+      const auto &set_op = static_cast<const planner::SetOpPlan &>(plan);
+      if (set_op.GetSetOp() == SetOpType::INVALID) {
+        return false;
+      }
       break;
     }
     default: { return false; }
@@ -99,9 +117,11 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
       pred = agg_plan.GetPredicate();
       break;
     }
-    case PlanNodeType::HASHJOIN: {
-      auto &hj_plan = static_cast<const planner::HashJoinPlan &>(plan);
-      pred = hj_plan.GetPredicate();
+    case PlanNodeType::NESTLOOP:
+    case PlanNodeType::HASHJOIN:
+    case PlanNodeType::MERGEJOIN: {
+      auto &join_plan = static_cast<const planner::AbstractJoinPlan &>(plan);
+      pred = join_plan.GetPredicate();
       break;
     }
     default: { break; }
@@ -127,6 +147,13 @@ bool QueryCompiler::IsExpressionSupported(
   switch (expr.GetExpressionType()) {
     case ExpressionType::STAR:
       return false;
+    case ExpressionType::COMPARE_IN:
+      // Only IN-lists, not sub-queries
+      if (expr.GetChild(1)->GetExpressionType() !=
+          ExpressionType::VALUE_VECTOR) {
+        return false;
+      }
+      break;
     default:
       break;
   }
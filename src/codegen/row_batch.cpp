@@ -358,6 +358,12 @@ llvm::Value *RowBatch::GetNumTotalRows(CodeGen &codegen) {
 
 llvm::Value *RowBatch::GetTileGroupID() const { return tile_group_id_; }
 
+RowBatch::AttributeAccess *RowBatch::GetAttributeAccess(
+    const planner::AttributeInfo *ai) const {
+  auto iter = attributes_.find(ai);
+  return iter != attributes_.end() ? iter->second : nullptr;
+}
+
 void RowBatch::UpdateWritePosition(llvm::Value *sz) {
   selection_vector_.SetNumElements(sz);
   filtered_ = true;
@@ -22,6 +22,7 @@
 #include "common/synchronization/count_down_latch.h"
 #include "expression/abstract_expression.h"
 #include "storage/data_table.h"
+#include "storage/compressed_tile.h"
 #include "storage/layout.h"
 #include "storage/storage_manager.h"
 #include "storage/tile.h"
@@ -84,10 +85,13 @@ storage::TileGroup *RuntimeFunctions::GetTileGroup(storage::DataTable *table,
 //===----------------------------------------------------------------------===//
 // Fills in the Predicate Array for the Zone Map to compare against.
 // Predicates are converted into an array of struct.
-// Each struct contains the column id, operator id and predicate value.
+// Each struct contains the column id, operator id and predicate value. The
+// value of a predicate on a parameter is the value of the parameter in the
+// query being executed.
 //===----------------------------------------------------------------------===//
 void RuntimeFunctions::FillPredicateArray(
     const expression::AbstractExpression *expr,
+    executor::ExecutorContext *executor_context,
     storage::PredicateInfo *predicate_array) {
   const std::vector<storage::PredicateInfo> *parsed_predicates;
   parsed_predicates = expr->GetParsedPredicates();
@@ -97,11 +101,16 @@ void RuntimeFunctions::FillPredicateArray(
     predicate_array[i].col_id = (*parsed_predicates)[i].col_id;
     predicate_array[i].comparison_operator =
         (*parsed_predicates)[i].comparison_operator;
-    predicate_array[i].predicate_value =
-        (*parsed_predicates)[i].predicate_value;
+    const auto &predicate_value = (*parsed_predicates)[i].predicate_value;
+    if (predicate_value.GetTypeId() ==
+        peloton::type::TypeId::PARAMETER_OFFSET) {
+      predicate_array[i].predicate_value =
+          executor_context->GetParamValues().at(
+              predicate_value.GetAs<int32_t>());
+    } else {
+      predicate_array[i].predicate_value = predicate_value;
+    }
   }
-  auto temp_expr = (expression::AbstractExpression *)expr;
-  temp_expr->ClearParsedPredicates();
 }
 
 //===----------------------------------------------------------------------===//
@@ -123,6 +132,16 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
     auto tile_idx = tile_entry.first;
     auto *tile = tile_group->GetTile(tile_idx);
     auto tile_schema = tile->GetSchema();
+    // The tiles of frozen tile groups are decompressed for the scans that get
+    // past the zone map check of the tile group, and stay pinned until
+    // ReleaseTileGroupLayout()
+    const auto *compressed_tile =
+        tile->IsCompressed()
+            ? static_cast<const storage::CompressedTile *>(tile)
+            : nullptr;
+    const char *tile_data = compressed_tile != nullptr
+                                ? compressed_tile->PinDecompressedData()
+                                : tile->GetTupleLocation(0);
     // Map the current column to a tile and a column offset in the tile.
     for (auto column_entry : tile_entry.second) {
       // Now grab the column information
@@ -130,10 +149,28 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
       oid_t tile_col_offset = column_entry.second;
       // Ensure that the col_idx is within the num_cols range
       PELOTON_ASSERT(col_idx < num_cols);
-      infos[col_idx].column =
-          tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_col_offset);
+      infos[col_idx].column = const_cast<char *>(tile_data) +
+                              tile_schema->GetOffset(tile_col_offset);
       infos[col_idx].stride = tile_schema->GetLength();
       infos[col_idx].is_columnar = tile_schema->GetColumnCount() == 1;
+      if (compressed_tile != nullptr &&
+          compressed_tile->HasStringDictionary(tile_col_offset)) {
+        infos[col_idx].codes =
+            const_cast<char *>(compressed_tile->GetCodes(tile_col_offset));
+        infos[col_idx].code_width =
+            compressed_tile->GetCodeWidth(tile_col_offset);
+        const auto *dictionary =
+            compressed_tile->GetDictionary(tile_col_offset);
+        infos[col_idx].dictionary = const_cast<char *>(
+            reinterpret_cast<const char *>(dictionary));
+        infos[col_idx].dictionary_size =
+            compressed_tile->GetDictionarySize(tile_col_offset);
+      } else {
+        infos[col_idx].codes = nullptr;
+        infos[col_idx].code_width = 0;
+        infos[col_idx].dictionary = nullptr;
+        infos[col_idx].dictionary_size = 0;
+      }
       last_col_idx = col_idx;
       LOG_TRACE("Col [%u] start: %p, stride: %u, columnar: %s", col_idx,
                 infos[col_idx].column, infos[col_idx].stride,
@@ -145,6 +182,21 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
                  (last_col_idx == (num_cols - 1)));
 }
 
+//===----------------------------------------------------------------------===//
+// Release the decompressed tiles GetTileGroupLayout() pinned for the scan of
+// the tile group, so that the cache can evict them.
+//===----------------------------------------------------------------------===//
+void RuntimeFunctions::ReleaseTileGroupLayout(
+    const storage::TileGroup *tile_group) {
+  for (const auto &tile_entry : tile_group->GetLayout().GetTileMap()) {
+    auto *tile = tile_group->GetTile(tile_entry.first);
+    if (tile->IsCompressed()) {
+      static_cast<const storage::CompressedTile *>(tile)
+          ->UnpinDecompressedData();
+    }
+  }
+}
+
 void RuntimeFunctions::ExecuteTableScan(
     void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
     uint32_t db_oid, uint32_t table_oid, void *func) {
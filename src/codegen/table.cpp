@@ -57,8 +57,10 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
 // num_tile_groups = GetTileGroupCount(table_ptr)
 //
 // for (; tile_group_idx < num_tile_groups; ++tile_group_idx) {
-//   if (ShouldScanTileGroup(predicate_array, tile_group_idx)) {
-//      tile_group_ptr := GetTileGroup(table_ptr, tile_group_idx)
+//   tile_group_ptr := GetTileGroup(table_ptr, tile_group_idx)
+//   if (tile_group_ptr != nullptr &&
+//       ShouldScanTileGroup(predicate_array, tile_group_idx) &&
+//       consumer.ShouldScanTileGroup(table_ptr, tile_group_idx)) {
 //      consumer.TileGroupStart(tile_group_ptr);
 //      tile_group.TidScan(tile_group_ptr, column_layouts, vector_size,
 //                         consumer);
@@ -70,6 +72,7 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
 void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                          llvm::Value *tilegroup_start,
                          llvm::Value *tilegroup_end, uint32_t batch_size,
+                         llvm::Value *executor_context_ptr,
                          llvm::Value *predicate_ptr, size_t num_predicates,
                          ScanCallback &consumer) const {
   // Allocate some space for the column layouts
@@ -85,7 +88,7 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
     predicate_array = codegen.AllocateBuffer(
         PredicateInfoProxy::GetType(codegen), num_predicates, "predicateInfo");
     codegen.Call(RuntimeFunctionsProxy::FillPredicateArray,
-                 {predicate_ptr, predicate_array});
+                 {predicate_ptr, executor_context_ptr, predicate_array});
   }
 
   // Get the number of tile groups in the given table
@@ -103,28 +106,40 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
     tile_group_idx = loop.GetLoopVar(0);
     llvm::Value *tile_group_ptr =
         GetTileGroup(codegen, table_ptr, tile_group_idx);
-    llvm::Value *tile_group_id =
-        tile_group_.GetTileGroupId(codegen, tile_group_ptr);
 
-    // Check zone map
-    llvm::Value *cond = codegen.Call(
-        ZoneMapManagerProxy::ShouldScanTileGroup,
-        {GetZoneMapManager(codegen), predicate_array,
-         codegen.Const32(num_predicates), table_ptr, tile_group_idx});
-
-    codegen::lang::If should_scan_tilegroup{codegen, cond};
+    // Skip tile groups that were retired by compaction
+    codegen::lang::If tile_group_exists{codegen,
+                                        codegen->CreateIsNotNull(tile_group_ptr)};
     {
-      // Inform the consumer that we're starting iteration over the tile group
-      consumer.TileGroupStart(codegen, tile_group_id, tile_group_ptr);
-
-      // Generate the scan cover over the given tile group
-      tile_group_.GenerateTidScan(codegen, tile_group_ptr, column_layouts,
-                                  batch_size, consumer);
-
-      // Inform the consumer that we've finished iteration over the tile group
-      consumer.TileGroupFinish(codegen, tile_group_ptr);
+      llvm::Value *tile_group_id =
+          tile_group_.GetTileGroupId(codegen, tile_group_ptr);
+
+      // Check zone map
+      llvm::Value *cond = codegen.Call(
+          ZoneMapManagerProxy::ShouldScanTileGroup,
+          {GetZoneMapManager(codegen), predicate_array,
+           codegen.Const32(num_predicates), table_ptr, tile_group_idx});
+      cond = codegen->CreateAnd(
+          cond,
+          consumer.ShouldScanTileGroup(codegen, table_ptr, tile_group_idx));
+
+      codegen::lang::If should_scan_tilegroup{codegen, cond};
+      {
+        // Inform the consumer that we're starting iteration over the tile
+        // group
+        consumer.TileGroupStart(codegen, tile_group_id, tile_group_ptr);
+
+        // Generate the scan cover over the given tile group
+        tile_group_.GenerateTidScan(codegen, tile_group_ptr, column_layouts,
+                                    batch_size, consumer);
+
+        // Inform the consumer that we've finished iteration over the tile
+        // group
+        consumer.TileGroupFinish(codegen, tile_group_ptr);
+      }
+      should_scan_tilegroup.EndIf();
     }
-    should_scan_tilegroup.EndIf();
+    tile_group_exists.EndIf();
 
     // Move to next tile group in the table
     tile_group_idx = codegen->CreateAdd(tile_group_idx, codegen.Const64(1));
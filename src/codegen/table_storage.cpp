@@ -18,6 +18,7 @@
 #include "codegen/type/sql_type.h"
 #include "codegen/type/type.h"
 #include "codegen/value.h"
+#include "codegen/varlen.h"
 
 namespace peloton {
 namespace codegen {
@@ -42,10 +43,7 @@ void TableStorage::StoreValues(CodeGen &codegen, llvm::Value *tuple_ptr,
       auto val_ptr = codegen->CreateBitCast(ptr, val_type);
       lang::If value_is_null{codegen, value.IsNull(codegen)};
       {
-        auto null_val = sql_type.GetNullValue(codegen);
-        codegen->CreateStore(
-            null_val.GetValue(),
-            codegen->CreateBitCast(ptr, val_type->getPointerTo()));
+        Varlen::StoreNull(codegen, ptr);
       }
       value_is_null.ElseBlock();
       {
@@ -22,6 +22,7 @@
 #include "codegen/vector.h"
 #include "codegen/lang/vectorized_loop.h"
 #include "codegen/type/boolean_type.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace codegen {
@@ -36,12 +37,15 @@ TileGroup::TileGroup(const catalog::Schema &schema) : schema_(schema) {}
 //
 // @code
 // col_layouts := GetColumnLayouts(tile_group_ptr, column_layouts)
+// TileGroupLayout(col_layouts)
 // num_tuples := GetNumTuples(tile_group_ptr)
 //
 // for (start := 0; start < num_tuples; start += vector_size) {
 //   end := min(start + vector_size, num_tuples)
 //   ProcessTuples(start, end, tile_group_ptr);
 // }
+//
+// ReleaseTileGroupLayout(tile_group_ptr)
 // @endcode
 //
 void TileGroup::GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
@@ -50,6 +54,8 @@ void TileGroup::GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
                                 ScanCallback &consumer) const {
   // Get the column layouts
   auto col_layouts = GetColumnLayouts(codegen, tile_group_ptr, column_layouts);
+  TileGroupAccess tile_group_access{*this, col_layouts};
+  consumer.TileGroupLayout(codegen, tile_group_access);
 
   llvm::Value *num_tuples = GetNumTuples(codegen, tile_group_ptr);
   lang::VectorizedLoop loop{codegen, num_tuples, batch_size, {}};
@@ -57,12 +63,15 @@ void TileGroup::GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
     lang::VectorizedLoop::Range curr_range = loop.GetCurrentRange();
 
     // Pass the vector to the consumer
-    TileGroupAccess tile_group_access{*this, col_layouts};
     consumer.ProcessTuples(codegen, curr_range.start, curr_range.end,
                            tile_group_access);
 
     loop.LoopEnd(codegen, {});
   }
+
+  // Let go of the decompressed tiles of a frozen tile group
+  codegen.Call(RuntimeFunctionsProxy::ReleaseTileGroupLayout,
+               {tile_group_ptr});
 }
 
 // Call TileGroup::GetNextTupleSlot(...) to determine # of tuples in tile group.
@@ -84,6 +93,9 @@ llvm::Value *TileGroup::GetTileGroupId(CodeGen &codegen,
 // 1. The starting memory address (where the first value of the column is)
 // 2. The stride length
 // 3. Whether the column is in columnar layout
+//
+// String columns also get their codes and dictionary, which are null unless
+// the tile group is frozen.
 //===----------------------------------------------------------------------===//
 std::vector<TileGroup::ColumnLayout> TileGroup::GetColumnLayouts(
     CodeGen &codegen, llvm::Value *tile_group_ptr,
@@ -104,7 +116,33 @@ std::vector<TileGroup::ColumnLayout> TileGroup::GetColumnLayouts(
         layout_type, column_layout_infos, col_id, 1));
     auto *columnar = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
         layout_type, column_layout_infos, col_id, 2));
-    layouts.push_back(ColumnLayout{col_id, start, stride, columnar});
+    ColumnLayout layout{col_id, start, stride, columnar};
+    const auto &column = schema_.GetColumn(col_id);
+    if (type::SqlType::LookupType(column.GetType()).IsVariableLength()) {
+      layout.codes = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+          layout_type, column_layout_infos, col_id, 3));
+      layout.code_width =
+          codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+              layout_type, column_layout_infos, col_id, 4));
+      layout.dictionary =
+          codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+              layout_type, column_layout_infos, col_id, 5));
+      layout.dictionary_size =
+          codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+              layout_type, column_layout_infos, col_id, 6));
+
+      // Codes are read as 4-byte integers, of which only the low code_width
+      // bytes belong to the code
+      llvm::Value *code_bits = codegen->CreateZExt(
+          codegen->CreateMul(layout.code_width, codegen.Const32(8)),
+          codegen.Int64Type());
+      layout.code_mask = codegen->CreateTrunc(
+          codegen->CreateSub(
+              codegen->CreateShl(codegen.Const64(1), code_bits),
+              codegen.Const64(1)),
+          codegen.Int32Type());
+    }
+    layouts.push_back(layout);
   }
   return layouts;
 }
@@ -128,15 +166,28 @@ codegen::Value TileGroup::LoadColumn(
 
   // Check if it's a string or numeric value
   if (sql_type.IsVariableLength()) {
-    auto *varlen_type = VarlenProxy::GetType(codegen);
-    auto *varlen_ptr_ptr = codegen->CreateBitCast(
-        col_address, varlen_type->getPointerTo()->getPointerTo());
+    // Short strings live inside their varlen slot, and the slots of a frozen
+    // tile group are only decompressed while its scan runs. Strings may be
+    // used after that (e.g., as hash table keys), so frozen tile groups hand
+    // out the slots of their dictionary, which lives as long as the tile.
+    if (layout.dictionary != nullptr) {
+      lang::If has_dictionary{codegen,
+                              codegen->CreateIsNotNull(layout.dictionary)};
+      llvm::Value *entry_address = codegen->CreateInBoundsGEP(
+          codegen.ByteType(), layout.dictionary,
+          codegen->CreateMul(
+              LoadCode(codegen, tid, layout),
+              codegen.Const32(sizeof(peloton::type::VarlenSlot))));
+      has_dictionary.EndIf();
+      col_address = has_dictionary.BuildPHI(entry_address, col_address);
+    }
+
+    // The column stores a varlen slot
     if (is_nullable) {
-      codegen::Varlen::GetPtrAndLength(
-          codegen, codegen->CreateLoad(varlen_ptr_ptr), val, length, is_null);
+      codegen::Varlen::GetPtrAndLength(codegen, col_address, val, length,
+                                       is_null);
     } else {
-      codegen::Varlen::SafeGetPtrAndLength(
-          codegen, codegen->CreateLoad(varlen_ptr_ptr), val, length);
+      codegen::Varlen::SafeGetPtrAndLength(codegen, col_address, val, length);
     }
     PELOTON_ASSERT(val != nullptr && length != nullptr);
   } else {
@@ -178,6 +229,40 @@ codegen::Value TileGroup::LoadColumn(
   return codegen::Value{type, val, length, is_null};
 }
 
+// Load the dictionary code of a string column for the row with the given TID
+llvm::Value *TileGroup::LoadCode(CodeGen &codegen, llvm::Value *tid,
+                                 const TileGroup::ColumnLayout &layout) const {
+  PELOTON_ASSERT(layout.codes != nullptr);
+
+  // code = *(uint32_t *)(codes + (tid * code_width)) & code_mask;
+  llvm::Value *code_address =
+      codegen->CreateInBoundsGEP(codegen.ByteType(), layout.codes,
+                                 codegen->CreateMul(tid, layout.code_width));
+  llvm::Value *code = codegen->CreateAlignedLoad(
+      codegen->CreateBitCast(code_address,
+                             codegen.Int32Type()->getPointerTo()),
+      1);
+  code = codegen->CreateAnd(code, layout.code_mask);
+  code->setName(schema_.GetColumn(layout.col_id).GetName() + ".code");
+  return code;
+}
+
+// Load the entry with the given code from the dictionary of a string column.
+// The entries are varlen slots, just like the column itself stores.
+codegen::Value TileGroup::LoadDictionaryEntry(
+    CodeGen &codegen, llvm::Value *code,
+    const TileGroup::ColumnLayout &layout) const {
+  PELOTON_ASSERT(layout.dictionary != nullptr);
+  ColumnLayout dictionary_layout = layout;
+  dictionary_layout.col_start_ptr = layout.dictionary;
+  dictionary_layout.col_stride =
+      codegen.Const32(sizeof(peloton::type::VarlenSlot));
+  dictionary_layout.is_columnar = codegen.ConstBool(true);
+  dictionary_layout.codes = nullptr;
+  dictionary_layout.dictionary = nullptr;
+  return LoadColumn(codegen, code, dictionary_layout);
+}
+
 //===----------------------------------------------------------------------===//
 // TILE GROUP ROW
 //===----------------------------------------------------------------------===//
@@ -193,6 +278,12 @@ codegen::Value TileGroup::TileGroupAccess::Row::LoadColumn(
   return tile_group_.LoadColumn(codegen, GetTID(), layout_[col_idx]);
 }
 
+llvm::Value *TileGroup::TileGroupAccess::Row::LoadCode(CodeGen &codegen,
+                                                       uint32_t col_idx) const {
+  PELOTON_ASSERT(col_idx < layout_.size());
+  return tile_group_.LoadCode(codegen, GetTID(), layout_[col_idx]);
+}
+
 //===----------------------------------------------------------------------===//
 // TILE GROUP
 //===----------------------------------------------------------------------===//
@@ -207,5 +298,19 @@ TileGroup::TileGroupAccess::Row TileGroup::TileGroupAccess::GetRow(
   return TileGroup::TileGroupAccess::Row{tile_group_, layout_, tid};
 }
 
+llvm::Value *TileGroup::TileGroupAccess::HasDictionary(
+    CodeGen &codegen, uint32_t col_idx) const {
+  const auto &layout = GetLayout(col_idx);
+  if (layout.dictionary == nullptr) {
+    return codegen.ConstBool(false);
+  }
+  return codegen->CreateIsNotNull(layout.dictionary);
+}
+
+codegen::Value TileGroup::TileGroupAccess::LoadDictionaryEntry(
+    CodeGen &codegen, uint32_t col_idx, llvm::Value *code) const {
+  return tile_group_.LoadDictionaryEntry(codegen, code, GetLayout(col_idx));
+}
+
 }  // namespace codegen
 }  // namespace peloton
@@ -18,10 +18,14 @@
 #include "codegen/expression/conjunction_translator.h"
 #include "codegen/expression/constant_translator.h"
 #include "codegen/expression/function_translator.h"
+#include "codegen/expression/in_list_translator.h"
+#include "codegen/expression/like_translator.h"
 #include "codegen/expression/negation_translator.h"
 #include "codegen/expression/null_check_translator.h"
 #include "codegen/expression/parameter_translator.h"
 #include "codegen/expression/tuple_value_translator.h"
+#include "codegen/expression/vector_value_translator.h"
+#include "codegen/operator/append_translator.h"
 #include "codegen/operator/block_nested_loop_join_translator.h"
 #include "codegen/operator/csv_scan_translator.h"
 #include "codegen/operator/delete_translator.h"
@@ -31,8 +35,11 @@
 #include "codegen/operator/hash_translator.h"
 #include "codegen/operator/insert_translator.h"
 #include "codegen/operator/limit_translator.h"
+#include "codegen/operator/merge_join_translator.h"
 #include "codegen/operator/order_by_translator.h"
 #include "codegen/operator/projection_translator.h"
+#include "codegen/operator/set_op_translator.h"
+#include "codegen/operator/sorted_group_by_translator.h"
 #include "codegen/operator/table_scan_translator.h"
 #include "codegen/operator/update_translator.h"
 #include "expression/aggregate_expression.h"
@@ -43,17 +50,21 @@
 #include "expression/function_expression.h"
 #include "expression/operator_expression.h"
 #include "expression/tuple_value_expression.h"
+#include "expression/vector_value_expression.h"
 #include "planner/aggregate_plan.h"
+#include "planner/append_plan.h"
 #include "planner/csv_scan_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/limit_plan.h"
+#include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "planner/set_op_plan.h"
 #include "planner/update_plan.h"
 
 namespace peloton {
@@ -93,6 +104,11 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new BlockNestedLoopJoinTranslator(join, context, pipeline);
       break;
     }
+    case PlanNodeType::MERGEJOIN: {
+      auto &join = static_cast<const planner::MergeJoinPlan &>(plan_node);
+      translator = new MergeJoinTranslator(join, context, pipeline);
+      break;
+    }
     case PlanNodeType::HASH: {
       auto &hash = static_cast<const planner::HashPlan &>(plan_node);
       translator = new HashTranslator(hash, context, pipeline);
@@ -101,12 +117,16 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
     case PlanNodeType::AGGREGATE_V2: {
       const auto &aggregate_plan =
           static_cast<const planner::AggregatePlan &>(plan_node);
-      // An aggregation without any grouping clause is simpler to handle. All
-      // other aggregations are handled using a hash-group-by for now.
-      // TODO: Implement other (non hash) group-by algorithms
+      // An aggregation without any grouping clause is simpler to handle. An
+      // input sorted on the grouping columns is aggregated group by group, all
+      // other aggregations are handled using a hash-group-by.
       if (aggregate_plan.IsGlobal()) {
         translator =
             new GlobalGroupByTranslator(aggregate_plan, context, pipeline);
+      } else if (aggregate_plan.GetAggregateStrategy() ==
+                 AggregateType::SORTED) {
+        translator =
+            new SortedGroupByTranslator(aggregate_plan, context, pipeline);
       } else {
         translator =
             new HashGroupByTranslator(aggregate_plan, context, pipeline);
@@ -138,6 +158,16 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new LimitTranslator(limit_plan, context, pipeline);
       break;
     }
+    case PlanNodeType::APPEND: {
+      auto &append_plan = static_cast<const planner::AppendPlan &>(plan_node);
+      translator = new AppendTranslator(append_plan, context, pipeline);
+      break;
+    }
+    case PlanNodeType::SETOP: {
+      auto &set_op_plan = static_cast<const planner::SetOpPlan &>(plan_node);
+      translator = new SetOpTranslator(set_op_plan, context, pipeline);
+      break;
+    }
     default: {
       throw Exception{"We don't have a translator for plan node type: " +
                       PlanNodeTypeToString(plan_node.GetPlanNodeType())};
@@ -178,13 +208,34 @@ std::unique_ptr<ExpressionTranslator> TranslatorFactory::CreateTranslator(
     case ExpressionType::COMPARE_LESSTHAN:
     case ExpressionType::COMPARE_GREATERTHAN:
     case ExpressionType::COMPARE_LESSTHANOREQUALTO:
-    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
-    case ExpressionType::COMPARE_LIKE: {
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO: {
       const auto &cmp_exp =
           static_cast<const expression::ComparisonExpression &>(exp);
       translator = new ComparisonTranslator(cmp_exp, context);
       break;
     }
+    case ExpressionType::COMPARE_LIKE: {
+      const auto &like_exp =
+          static_cast<const expression::ComparisonExpression &>(exp);
+      if (LikeTranslator::IsSupported(like_exp)) {
+        translator = new LikeTranslator(like_exp, context);
+      } else {
+        translator = new ComparisonTranslator(like_exp, context);
+      }
+      break;
+    }
+    case ExpressionType::COMPARE_IN: {
+      const auto &in_list_exp =
+          static_cast<const expression::ComparisonExpression &>(exp);
+      translator = new InListTranslator(in_list_exp, context);
+      break;
+    }
+    case ExpressionType::VALUE_VECTOR: {
+      const auto &vector_exp =
+          static_cast<const expression::VectorValueExpression &>(exp);
+      translator = new VectorValueTranslator(vector_exp, context);
+      break;
+    }
     case ExpressionType::CONJUNCTION_AND:
     case ExpressionType::CONJUNCTION_OR: {
       const auto &conjunction_exp =
@@ -24,6 +24,7 @@
 #include "codegen/value.h"
 #include "codegen/vector.h"
 #include "common/exception.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace codegen {
@@ -55,11 +56,92 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
     return codegen.Call(StringFunctionsProxy::CompareStrings, args);
   }
 
+  // Load the first four bytes of the string, which must be at least that long.
+  // Strings of up to type::VARLEN_SLOT_INLINE_LENGTH bytes read from a table
+  // point into their varlen slot, so these are the prefix stored in the slot.
+  llvm::Value *LoadPrefix(CodeGen &codegen, const Value &str) const {
+    auto *prefix_ptr = codegen->CreateBitCast(
+        str.GetValue(), codegen.Int32Type()->getPointerTo());
+    return codegen->CreateAlignedLoad(prefix_ptr, 1);
+  }
+
+  // Like CompareStrings(), but decides on the first four bytes of the strings
+  // without a call if they differ. The prefixes are byte-swapped so that
+  // comparing them as unsigned integers orders them like memcmp().
+  llvm::Value *CompareStringsByPrefix(CodeGen &codegen, const Value &left,
+                                      const Value &right) const {
+    auto *prefix_len =
+        codegen.Const32(peloton::type::VARLEN_SLOT_PREFIX_LENGTH);
+    llvm::Value *have_prefixes = codegen->CreateAnd(
+        codegen->CreateICmpUGE(left.GetLength(), prefix_len),
+        codegen->CreateICmpUGE(right.GetLength(), prefix_len));
+    llvm::Value *prefix_result = nullptr;
+    lang::If prefixes_exist{codegen, have_prefixes};
+    {
+      auto *left_prefix = codegen.ByteSwap(LoadPrefix(codegen, left));
+      auto *right_prefix = codegen.ByteSwap(LoadPrefix(codegen, right));
+      // Zero if the prefixes are equal
+      prefix_result = codegen->CreateSelect(
+          codegen->CreateICmpULT(left_prefix, right_prefix),
+          codegen.Const32(-1),
+          codegen->CreateZExt(
+              codegen->CreateICmpNE(left_prefix, right_prefix),
+              codegen.Int32Type()));
+    }
+    prefixes_exist.EndIf();
+    prefix_result =
+        prefixes_exist.BuildPHI(prefix_result, codegen.Const32(0));
+
+    llvm::Value *result = nullptr;
+    lang::If prefixes_match{
+        codegen, codegen->CreateICmpEQ(prefix_result, codegen.Const32(0))};
+    {
+      result = CompareStrings(codegen, left, right);
+    }
+    prefixes_match.EndIf();
+    return prefixes_match.BuildPHI(result, prefix_result);
+  }
+
+  // Strings of different lengths are never equal, so the strings are only
+  // compared if the lengths match. Then their first four bytes are compared,
+  // and CompareStrings() is only called if those match too.
+  llvm::Value *EqualStrings(CodeGen &codegen, const Value &left,
+                            const Value &right) const {
+    llvm::Value *same_length =
+        codegen->CreateICmpEQ(left.GetLength(), right.GetLength());
+    llvm::Value *is_eq = nullptr;
+    lang::If lengths_match{codegen, same_length};
+    {
+      llvm::Value *has_prefix = codegen->CreateICmpUGE(
+          left.GetLength(),
+          codegen.Const32(peloton::type::VARLEN_SLOT_PREFIX_LENGTH));
+      llvm::Value *same_prefix = nullptr;
+      lang::If prefix_exists{codegen, has_prefix};
+      {
+        same_prefix = codegen->CreateICmpEQ(LoadPrefix(codegen, left),
+                                            LoadPrefix(codegen, right));
+      }
+      prefix_exists.EndIf();
+      same_prefix =
+          prefix_exists.BuildPHI(same_prefix, codegen.ConstBool(true));
+
+      lang::If prefixes_match{codegen, same_prefix};
+      {
+        llvm::Value *result = CompareStrings(codegen, left, right);
+        is_eq = codegen->CreateICmpEQ(result, codegen.Const32(0));
+      }
+      prefixes_match.EndIf();
+      is_eq = prefixes_match.BuildPHI(is_eq, codegen.ConstBool(false));
+    }
+    lengths_match.EndIf();
+    return lengths_match.BuildPHI(is_eq, codegen.ConstBool(false));
+  }
+
   Value CompareLtImpl(CodeGen &codegen, const Value &left,
                       const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
     // Call CompareStrings, check is result is < 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
+    llvm::Value *result = CompareStringsByPrefix(codegen, left, right);
     llvm::Value *is_lt_0 = codegen->CreateICmpSLT(result, codegen.Const32(0));
     return Value{Boolean::Instance(), is_lt_0};
   }
@@ -68,7 +150,7 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
                        const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
     // Call CompareStrings, check is result is <= 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
+    llvm::Value *result = CompareStringsByPrefix(codegen, left, right);
     llvm::Value *is_lte_0 = codegen->CreateICmpSLE(result, codegen.Const32(0));
     return Value{Boolean::Instance(), is_lte_0};
   }
@@ -76,26 +158,23 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
   Value CompareEqImpl(CodeGen &codegen, const Value &left,
                       const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
-    // Call CompareStrings, check is result is == 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
-    llvm::Value *is_eq_0 = codegen->CreateICmpEQ(result, codegen.Const32(0));
-    return Value{Boolean::Instance(), is_eq_0};
+    // Compare the lengths, then call CompareStrings
+    return Value{Boolean::Instance(), EqualStrings(codegen, left, right)};
   }
 
   Value CompareNeImpl(CodeGen &codegen, const Value &left,
                       const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
-    // Call CompareStrings, check is result is != 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
-    llvm::Value *is_ne_0 = codegen->CreateICmpNE(result, codegen.Const32(0));
-    return Value{Boolean::Instance(), is_ne_0};
+    // Compare the lengths, then call CompareStrings
+    llvm::Value *is_eq = EqualStrings(codegen, left, right);
+    return Value{Boolean::Instance(), codegen->CreateNot(is_eq)};
   }
 
   Value CompareGtImpl(CodeGen &codegen, const Value &left,
                       const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
     // Call CompareStrings, check is result is <= 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
+    llvm::Value *result = CompareStringsByPrefix(codegen, left, right);
     llvm::Value *is_gt_0 = codegen->CreateICmpSGT(result, codegen.Const32(0));
     return Value{Boolean::Instance(), is_gt_0};
   }
@@ -104,7 +183,7 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
                        const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
     // Call CompareStrings, check is result is >= 0
-    llvm::Value *result = CompareStrings(codegen, left, right);
+    llvm::Value *result = CompareStringsByPrefix(codegen, left, right);
     llvm::Value *is_gte_0 = codegen->CreateICmpSGE(result, codegen.Const32(0));
     return Value{Boolean::Instance(), is_gte_0};
   }
@@ -113,7 +192,7 @@ struct CompareVarchar : public TypeSystem::ExpensiveComparisonHandleNull {
                            const Value &right) const override {
     PELOTON_ASSERT(SupportsTypes(left.GetType(), right.GetType()));
     // Call CompareStrings, return result directly
-    llvm::Value *result = CompareStrings(codegen, left, right);
+    llvm::Value *result = CompareStringsByPrefix(codegen, left, right);
     return Value{Integer::Instance(), result};
   }
 };
@@ -34,6 +34,10 @@ const double BloomFilter::kFalsePositiveRate = 0.1;
 // Set it to OPTIMAL_NUM_HASH_FUNC to minimize bloom filter memory footprint
 const uint64_t BloomFilter::kNumHashFuncs = 1;
 
+const uint64_t BloomFilter::kSelectivitySampleSize = 4096;
+
+const double BloomFilter::kMinMissRate = 0.1;
+
 //===----------------------------------------------------------------------===//
 // Member Functions
 //===----------------------------------------------------------------------===//
@@ -64,18 +68,40 @@ void BloomFilter::Init(uint64_t estimated_num_tuples) {
   PELOTON_MEMSET(bytes_, 0, num_bytes);
 
   // Initialize Statistics
-  num_misses_ = 0;
-  num_probes_ = 0;
+  num_misses_.store(0, std::memory_order_relaxed);
+  num_probes_.store(0, std::memory_order_relaxed);
 }
 
 void BloomFilter::Destroy() {
   // Free memory of underlying bytes array
+  uint64_t num_probes = num_probes_.load(std::memory_order_relaxed);
+  uint64_t num_misses = num_misses_.load(std::memory_order_relaxed);
   LOG_DEBUG("Bloom Filter, num_probes: %lu, misses: %lu, Selectivity: %f",
-            (unsigned long)num_probes_, (unsigned long)num_misses_,
-            (double)(num_probes_ - num_misses_) / num_probes_);
+            (unsigned long)num_probes, (unsigned long)num_misses,
+            (double)(num_probes - num_misses) / num_probes);
   delete[] bytes_;
 }
 
+bool BloomFilter::IsSelective() const {
+  // The counters are added to independently, so the pair may be slightly out
+  // of sync under concurrent scans. That is fine for a sampled estimate.
+  uint64_t num_probes = num_probes_.load(std::memory_order_relaxed);
+  uint64_t num_misses = num_misses_.load(std::memory_order_relaxed);
+  return num_probes < kSelectivitySampleSize ||
+         num_misses >= kMinMissRate * num_probes;
+}
+
+void BloomFilter::AddStatistics(uint64_t num_probes, uint64_t num_misses) {
+  // Batches that skipped the filter leave its cache line alone
+  if (num_probes == 0) {
+    return;
+  }
+  num_probes_.fetch_add(num_probes, std::memory_order_relaxed);
+  if (num_misses != 0) {
+    num_misses_.fetch_add(num_misses, std::memory_order_relaxed);
+  }
+}
+
 }  // namespace util
 }  // namespace codegen
 }  // namespace peloton
@@ -0,0 +1,331 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table.cpp
+//
+// Identification: src/codegen/util/concurrent_aggregation_table.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/concurrent_aggregation_table.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "common/platform.h"
+#include "type/abstract_pool.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+static const uint64_t kMinCapacity = 256;
+
+// The number of old slots a thread claims at once when moving them
+static const uint64_t kPartitionSize = 1024;
+
+constexpr uint32_t ConcurrentAggregationTable::kUpdateOpBits;
+constexpr uint32_t ConcurrentAggregationTable::kMaxNumValues;
+constexpr uint64_t ConcurrentAggregationTable::kOccupied;
+
+ConcurrentAggregationTable::ConcurrentAggregationTable(
+    ::peloton::type::AbstractPool &memory, uint32_t key_size,
+    uint32_t num_values, uint64_t update_ops, uint64_t num_groups)
+    : memory_(memory),
+      key_size_(key_size),
+      num_values_(num_values),
+      update_ops_(update_ops),
+      slot_size_(SlotSize(key_size, num_values)),
+      num_entries_(0) {
+  PELOTON_ASSERT(num_values <= kMaxNumValues);
+
+  // Start out at most half full
+  capacity_ = std::max(kMinCapacity, NextPowerOf2(num_groups * 2));
+  mask_ = capacity_ - 1;
+  resize_threshold_ = capacity_ / 2;
+  slots_ = AllocateSlots(capacity_);
+
+  resize_.resizing = false;
+  resize_.moving = false;
+  resize_.num_upserting = 0;
+  resize_.num_helping = 0;
+  resize_.new_slots = nullptr;
+  resize_.new_capacity = 0;
+  resize_.next_partition = 0;
+  resize_.num_moved = 0;
+  resize_.num_partitions = 0;
+}
+
+ConcurrentAggregationTable::~ConcurrentAggregationTable() {
+  if (slots_ != nullptr) {
+    memory_.Free(slots_);
+    slots_ = nullptr;
+  }
+}
+
+void ConcurrentAggregationTable::Init(ConcurrentAggregationTable &table,
+                                      executor::ExecutorContext &exec_ctx,
+                                      uint32_t key_size, uint32_t num_values,
+                                      uint64_t update_ops,
+                                      uint64_t num_groups) {
+  new (&table) ConcurrentAggregationTable(*exec_ctx.GetPool(), key_size,
+                                          num_values, update_ops, num_groups);
+}
+
+void ConcurrentAggregationTable::Destroy(ConcurrentAggregationTable &table) {
+  table.~ConcurrentAggregationTable();
+}
+
+void ConcurrentAggregationTable::Upsert(uint64_t hash, const char *key,
+                                        const int64_t *values) {
+  while (true) {
+    if (resize_.resizing) {
+      WaitForResize();
+      continue;
+    }
+
+    // Announce the upsert before checking for a resize again, so that a
+    // resize either sees the upsert or this thread sees the resize
+    resize_.num_upserting++;
+    if (resize_.resizing) {
+      resize_.num_upserting--;
+      continue;
+    }
+
+    uint64_t capacity = capacity_;
+    bool inserted = false;
+    bool success = TryUpsert(hash, key, values, inserted);
+    bool needs_resize =
+        !success || (inserted && num_entries_ > resize_threshold_);
+    resize_.num_upserting--;
+
+    if (needs_resize) {
+      Resize(capacity);
+    }
+    if (success) {
+      return;
+    }
+  }
+}
+
+bool ConcurrentAggregationTable::TryUpsert(uint64_t hash, const char *key,
+                                           const int64_t *values,
+                                           bool &inserted) {
+  const uint64_t tag = hash | kOccupied;
+
+  // The tag of a slot while its group is being set up, which no key matches
+  const uint64_t claimed = 1;
+
+  uint64_t slot_idx = hash & mask_;
+  for (uint64_t probes = 0; probes < capacity_; probes++) {
+    char *slot = slots_ + slot_idx * slot_size_;
+    std::atomic<uint64_t> &slot_tag = Tag(slot);
+
+    uint64_t curr = slot_tag.load(std::memory_order_acquire);
+    if (curr == 0) {
+      if (slot_tag.compare_exchange_strong(curr, claimed)) {
+        // The slot is ours. Set up the group, then publish it.
+        std::atomic<int64_t> *aggregates = Aggregates(slot);
+        for (uint32_t i = 0; i < num_values_; i++) {
+          switch (GetUpdateOp(i)) {
+            case UpdateOp::Add:
+              aggregates[i].store(0, std::memory_order_relaxed);
+              break;
+            case UpdateOp::Min:
+              aggregates[i].store(std::numeric_limits<int64_t>::max(),
+                                  std::memory_order_relaxed);
+              break;
+            case UpdateOp::Max:
+              aggregates[i].store(std::numeric_limits<int64_t>::min(),
+                                  std::memory_order_relaxed);
+              break;
+          }
+        }
+        std::memcpy(slot + KeyOffset(num_values_), key, key_size_);
+        slot_tag.store(tag, std::memory_order_release);
+
+        Update(slot, values);
+        num_entries_++;
+        inserted = true;
+        return true;
+      }
+      // Someone else claimed it first, and the tag is in curr now
+    }
+
+    // Wait until the group in the slot is set up
+    while (curr == claimed) {
+      _mm_pause();
+      curr = slot_tag.load(std::memory_order_acquire);
+    }
+
+    if (curr == tag &&
+        std::memcmp(slot + KeyOffset(num_values_), key, key_size_) == 0) {
+      Update(slot, values);
+      return true;
+    }
+
+    slot_idx = (slot_idx + 1) & mask_;
+  }
+
+  // All slots are taken
+  return false;
+}
+
+void ConcurrentAggregationTable::Update(char *slot,
+                                        const int64_t *values) const {
+  std::atomic<int64_t> *aggregates = Aggregates(slot);
+  for (uint32_t i = 0; i < num_values_; i++) {
+    const int64_t val = values[i];
+    std::atomic<int64_t> &aggregate = aggregates[i];
+    switch (GetUpdateOp(i)) {
+      case UpdateOp::Add: {
+        aggregate.fetch_add(val, std::memory_order_relaxed);
+        break;
+      }
+      case UpdateOp::Min: {
+        int64_t curr = aggregate.load(std::memory_order_relaxed);
+        while (val < curr && !aggregate.compare_exchange_weak(
+                                 curr, val, std::memory_order_relaxed)) {
+        }
+        break;
+      }
+      case UpdateOp::Max: {
+        int64_t curr = aggregate.load(std::memory_order_relaxed);
+        while (val > curr && !aggregate.compare_exchange_weak(
+                                 curr, val, std::memory_order_relaxed)) {
+        }
+        break;
+      }
+    }
+  }
+}
+
+void ConcurrentAggregationTable::Resize(uint64_t capacity) {
+  bool resizing = false;
+  if (!resize_.resizing.compare_exchange_strong(resizing, true)) {
+    // Someone else is resizing already
+    WaitForResize();
+    return;
+  }
+
+  // Let the upserts in flight finish, new ones wait for the resize
+  while (resize_.num_upserting != 0) {
+    _mm_pause();
+  }
+
+  if (capacity_ != capacity) {
+    // Someone else resized the table in the meantime
+    resize_.resizing = false;
+    return;
+  }
+
+  // Set up the new slots and the partitions of the old ones, then let the
+  // waiting threads help to move them
+  resize_.new_capacity = capacity_ * 2;
+  resize_.new_slots = AllocateSlots(resize_.new_capacity);
+  resize_.num_partitions = (capacity_ + kPartitionSize - 1) / kPartitionSize;
+  resize_.next_partition = 0;
+  resize_.num_moved = 0;
+  resize_.moving = true;
+
+  MovePartitions();
+  while (resize_.num_moved != resize_.num_partitions) {
+    _mm_pause();
+  }
+
+  // Wait for the helpers to leave before the old slots go away
+  resize_.moving = false;
+  while (resize_.num_helping != 0) {
+    _mm_pause();
+  }
+
+  memory_.Free(slots_);
+  slots_ = resize_.new_slots;
+  capacity_ = resize_.new_capacity;
+  mask_ = capacity_ - 1;
+  resize_threshold_ = capacity_ / 2;
+  resize_.new_slots = nullptr;
+
+  resize_.resizing = false;
+}
+
+void ConcurrentAggregationTable::WaitForResize() {
+  while (resize_.resizing) {
+    resize_.num_helping++;
+    if (resize_.moving) {
+      MovePartitions();
+    }
+    resize_.num_helping--;
+    _mm_pause();
+  }
+}
+
+void ConcurrentAggregationTable::MovePartitions() {
+  const uint64_t new_mask = resize_.new_capacity - 1;
+  char *new_slots = resize_.new_slots;
+
+  while (true) {
+    uint64_t partition = resize_.next_partition++;
+    if (partition >= resize_.num_partitions) {
+      return;
+    }
+
+    uint64_t begin = partition * kPartitionSize;
+    uint64_t end = std::min(begin + kPartitionSize, capacity_);
+    for (uint64_t old_idx = begin; old_idx < end; old_idx++) {
+      char *old_slot = slots_ + old_idx * slot_size_;
+      uint64_t tag = Tag(old_slot).load(std::memory_order_relaxed);
+      if (tag == 0) {
+        continue;
+      }
+
+      // The keys are unique, so the first free slot will do. Other threads
+      // only look for free slots as well, so the tag can be set right away.
+      uint64_t new_idx = tag & new_mask;
+      while (true) {
+        char *new_slot = new_slots + new_idx * slot_size_;
+        uint64_t free = 0;
+        if (Tag(new_slot).compare_exchange_strong(free, tag)) {
+          std::memcpy(new_slot + sizeof(uint64_t),
+                      old_slot + sizeof(uint64_t),
+                      slot_size_ - sizeof(uint64_t));
+          break;
+        }
+        new_idx = (new_idx + 1) & new_mask;
+      }
+    }
+
+    resize_.num_moved++;
+  }
+}
+
+char *ConcurrentAggregationTable::AllocateSlots(uint64_t capacity) {
+  uint64_t size = capacity * slot_size_;
+  auto *slots = reinterpret_cast<char *>(memory_.Allocate(size));
+  std::memset(slots, 0, size);
+  return slots;
+}
+
+const int64_t *ConcurrentAggregationTable::Values(uint64_t slot_idx) const {
+  char *slot = slots_ + slot_idx * slot_size_;
+  if (Tag(slot).load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+  return reinterpret_cast<const int64_t *>(slot + ValuesOffset());
+}
+
+const char *ConcurrentAggregationTable::Key(uint64_t slot_idx) const {
+  char *slot = slots_ + slot_idx * slot_size_;
+  if (Tag(slot).load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+  return slot + KeyOffset(num_values_);
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -12,17 +12,127 @@
 
 #include "codegen/util/csv_scanner.h"
 
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <exception>
+#include <mutex>
+
 #include <boost/filesystem.hpp>
 
 #include "common/exception.h"
+#include "common/synchronization/count_down_latch.h"
+#include "common/timer.h"
 #include "executor/executor_context.h"
+#include "threadpool/mono_queue_pool.h"
 #include "type/abstract_pool.h"
+#include "type/ephemeral_pool.h"
 #include "util/string_util.h"
 
 namespace peloton {
 namespace codegen {
 namespace util {
 
+namespace {
+
+// The quoting state of the CSV at a given position is captured in two bits:
+// whether we're in a quoted section, and whether the last character was an
+// escape character (which can only happen within a quoted section).
+constexpr uint8_t kInQuote = 1u;
+constexpr uint8_t kLastWasEscape = 2u;
+
+// Advance the quoting state machine by a single character. This must mirror
+// the logic in CSVScanner::NextLine().
+inline uint8_t StepQuoteState(uint8_t state, char c, char quote, char escape) {
+  bool in_quote = (state & kInQuote) != 0;
+  bool last_was_escape = (state & kLastWasEscape) != 0;
+  if (in_quote && c == escape) {
+    last_was_escape = !last_was_escape;
+  }
+  if (c == quote && !last_was_escape) {
+    in_quote = !in_quote;
+  }
+  if (c != escape) {
+    last_was_escape = false;
+  }
+  return static_cast<uint8_t>((in_quote ? kInQuote : 0u) |
+                              (last_was_escape ? kLastWasEscape : 0u));
+}
+
+// Validate that the given path refers to a readable regular file
+void CheckFilePath(const std::string &file_path) {
+  boost::filesystem::path path(file_path);
+
+  if (!boost::filesystem::exists(path)) {
+    throw ExecutorException(StringUtil::Format("input path '%s' does not exist",
+                                               file_path.c_str()));
+  } else if (!boost::filesystem::is_regular_file(file_path)) {
+    auto msg =
+        StringUtil::Format("unable to read file '%s'", file_path.c_str());
+    throw ExecutorException(msg);
+  }
+}
+
+}  // namespace
+
+/**
+ * The state shared by all scanners participating in a parallel scan. The file
+ * is split into fixed-size morsels whose boundaries are generally not line
+ * boundaries. A morsel is responsible for all lines that *begin* within its
+ * byte range, which may mean reading past its nominal end to finish the last
+ * line. The quoting state at the start of each morsel is computed up front so
+ * line boundaries can be found without scanning the file from the beginning.
+ */
+struct CSVScanner::ParallelState {
+  // The mapped file contents
+  const char *data;
+  uint64_t size;
+
+  // The nominal size of each morsel, and the number of morsels
+  uint64_t morsel_size;
+  uint32_t num_morsels;
+
+  // The quoting state at the start of each morsel
+  std::vector<uint8_t> start_states;
+
+  // The quote and (effective) escape characters
+  char quote;
+  char escape;
+
+  // The next morsel to hand out
+  std::atomic<uint32_t> next_morsel;
+
+  // Return the position of the first line that begins at or after the nominal
+  // start of the given morsel
+  const char *LineStart(uint32_t morsel_idx) const {
+    if (morsel_idx == 0) {
+      return data;
+    }
+    if (morsel_idx >= num_morsels) {
+      return data + size;
+    }
+
+    uint64_t pos = morsel_idx * morsel_size;
+    uint8_t state = start_states[morsel_idx];
+
+    // If the previous character was an un-quoted new-line, we're aligned
+    if (state == 0 && data[pos - 1] == '\n') {
+      return data + pos;
+    }
+
+    // Otherwise, skip past the first un-quoted new-line
+    for (; pos < size; pos++) {
+      char c = data[pos];
+      state = StepQuoteState(state, c, quote, escape);
+      if (c == '\n' && (state & kInQuote) == 0) {
+        return data + pos + 1;
+      }
+    }
+    return data + size;
+  }
+};
+
 CSVScanner::CSVScanner(peloton::type::AbstractPool &pool,
                        const std::string &file_path,
                        const codegen::type::Type *col_types, uint32_t num_cols,
@@ -34,10 +144,15 @@ CSVScanner::CSVScanner(peloton::type::AbstractPool &pool,
       buffer_(nullptr),
       buffer_pos_(0),
       buffer_end_(0),
+      parallel_state_(nullptr),
+      morsel_pos_(nullptr),
+      morsel_end_(nullptr),
       line_(nullptr),
       line_len_(0),
       line_maxlen_(0),
       line_number_(0),
+      in_quote_(false),
+      last_was_escape_(false),
       delimiter_(delimiter),
       quote_(quote),
       escape_(escape),
@@ -100,19 +215,234 @@ void CSVScanner::Produce() {
   }
 }
 
-void CSVScanner::Initialize() {
-  // Let's first perform a few validity checks
-  boost::filesystem::path path(file_path_);
+void CSVScanner::ExecuteParallel(
+    void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+    const char *file_path, const codegen::type::Type *col_types,
+    uint32_t num_cols, char delimiter, char quote, char escape, void *func) {
+  ProduceParallel(query_state, thread_states, file_path, col_types, num_cols,
+                  delimiter, quote, escape,
+                  reinterpret_cast<ParallelScanFunc>(func), kDefaultMorselSize);
+}
 
-  if (!boost::filesystem::exists(path)) {
-    throw ExecutorException(StringUtil::Format("input path '%s' does not exist",
-                                               file_path_.c_str()));
-  } else if (!boost::filesystem::is_regular_file(file_path_)) {
-    auto msg =
-        StringUtil::Format("unable to read file '%s'", file_path_.c_str());
-    throw ExecutorException(msg);
+void CSVScanner::ProduceParallel(
+    void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+    const std::string &file_path, const codegen::type::Type *col_types,
+    uint32_t num_cols, char delimiter, char quote, char escape,
+    CSVScanner::ParallelScanFunc func, uint64_t morsel_size) {
+  PELOTON_ASSERT(morsel_size > 0);
+
+  // Validate and map the file
+  CheckFilePath(file_path);
+
+  peloton::util::File file;
+  file.Open(file_path, peloton::util::File::AccessMode::ReadOnly);
+
+  ParallelState state;
+  state.size = file.Size();
+  state.data = (state.size > 0 ? file.Map(state.size) : nullptr);
+  state.morsel_size = morsel_size;
+  state.num_morsels = static_cast<uint32_t>(
+      std::max(1ul, (state.size + morsel_size - 1) / morsel_size));
+  state.start_states.resize(state.num_morsels, 0);
+  state.quote = quote;
+  state.escape = (quote == escape ? static_cast<char>('\0') : escape);
+  state.next_morsel = 0;
+
+  // The worker pool we use to execute parallel work
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+
+  Timer<std::milli> timer;
+  timer.Start();
+
+  ////////////////////////////////////////////////////////////////////
+  /// Step 1 - Compute the quoting state at the start of each morsel
+  ////////////////////////////////////////////////////////////////////
+  if (state.num_morsels > 1) {
+    // For each morsel, compute the state at its end for every possible state
+    // at its start (i.e., outside a quote, in a quote, and in a quote after an
+    // escape character). This can be done for all morsels independently.
+    static constexpr uint8_t kNumStates = kInQuote | kLastWasEscape;
+    std::vector<std::array<uint8_t, kNumStates + 1>> transitions(
+        state.num_morsels - 1);
+
+    common::synchronization::CountDownLatch latch(transitions.size());
+    for (uint32_t morsel_idx = 0; morsel_idx < transitions.size();
+         morsel_idx++) {
+      work_pool.SubmitTask([&state, &transitions, &latch, morsel_idx]() {
+        const char *begin = state.data + morsel_idx * state.morsel_size;
+        const char *end = begin + state.morsel_size;
+
+        uint8_t out_state = 0, in_state = kInQuote,
+                esc_state = kInQuote | kLastWasEscape;
+
+        // Morsels without any quote or escape characters leave the state
+        // as-is, except that a pending escape is cleared
+        auto len = static_cast<size_t>(end - begin);
+        bool has_quote = std::memchr(begin, state.quote, len) != nullptr;
+        bool has_escape = state.escape != '\0' &&
+                          std::memchr(begin, state.escape, len) != nullptr;
+        if (!has_quote && !has_escape) {
+          esc_state = kInQuote;
+        } else {
+          for (const char *pos = begin; pos != end; pos++) {
+            out_state =
+                StepQuoteState(out_state, *pos, state.quote, state.escape);
+            in_state =
+                StepQuoteState(in_state, *pos, state.quote, state.escape);
+            esc_state =
+                StepQuoteState(esc_state, *pos, state.quote, state.escape);
+          }
+        }
+
+        auto &transition = transitions[morsel_idx];
+        transition[0] = out_state;
+        transition[kInQuote] = in_state;
+        transition[kInQuote | kLastWasEscape] = esc_state;
+
+        latch.CountDown();
+      });
+    }
+    latch.Await(0);
+
+    // Now stitch the transitions together
+    for (uint32_t morsel_idx = 1; morsel_idx < state.num_morsels;
+         morsel_idx++) {
+      uint8_t prev_state = state.start_states[morsel_idx - 1];
+      state.start_states[morsel_idx] = transitions[morsel_idx - 1][prev_state];
+    }
+  }
+
+  timer.Stop();
+  LOG_DEBUG("Split %" PRIu64 " byte CSV file into %u morsels in %.2lf ms",
+            state.size, state.num_morsels, timer.GetDuration());
+  timer.Reset();
+  timer.Start();
+
+  ////////////////////////////////////////////////////////////////////
+  /// Step 2 - Scan the morsels, one task per worker
+  ////////////////////////////////////////////////////////////////////
+  auto num_tasks = std::min(work_pool.NumWorkers(), state.num_morsels);
+  num_tasks = std::max(num_tasks, 1u);
+
+  thread_states.Allocate(num_tasks);
+
+  // The first error encountered by any task
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  {
+    common::synchronization::CountDownLatch latch(num_tasks);
+    for (uint32_t task_id = 0; task_id < num_tasks; task_id++) {
+      work_pool.SubmitTask([&, task_id]() {
+        try {
+          // Each task gets its own pool and scanner
+          peloton::type::EphemeralPool pool;
+          CSVScanner scanner(pool, file_path, col_types, num_cols, nullptr,
+                             nullptr, delimiter, quote, escape);
+          scanner.parallel_state_ = &state;
+
+          func(query_state, thread_states.AccessThreadState(task_id),
+               &scanner);
+        } catch (...) {
+          // Stop handing out morsels and remember the first error
+          state.next_morsel = state.num_morsels;
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (error == nullptr) {
+            error = std::current_exception();
+          }
+        }
+        latch.CountDown();
+      });
+    }
+    latch.Await(0);
+  }
+
+  if (state.data != nullptr) {
+    peloton::util::File::Unmap(state.data, state.size);
+  }
+
+  timer.Stop();
+  LOG_DEBUG("Parallel scan of CSV file '%s' took %.2lf ms", file_path.c_str(),
+            timer.GetDuration());
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool CSVScanner::NextRow() {
+  PELOTON_ASSERT(parallel_state_ != nullptr);
+  while (morsel_pos_ == morsel_end_) {
+    if (!NextMorsel()) {
+      return false;
+    }
+  }
+  ParseLine(NextLineInMorsel());
+  return true;
+}
+
+bool CSVScanner::NextMorsel() {
+  auto &state = *parallel_state_;
+
+  // Claim a morsel
+  uint32_t morsel_idx = state.next_morsel++;
+  if (morsel_idx >= state.num_morsels) {
+    return false;
+  }
+
+  // Lines are owned by the morsel they begin in
+  morsel_pos_ = state.LineStart(morsel_idx);
+  morsel_end_ = std::max(morsel_pos_, state.LineStart(morsel_idx + 1));
+
+  // Lazily allocate the line buffer
+  if (line_ == nullptr) {
+    line_ = static_cast<char *>(memory_.Allocate(kDefaultBufferSize));
+    line_len_ = 0;
+    line_maxlen_ = kDefaultBufferSize - 1;
   }
 
+  return true;
+}
+
+char *CSVScanner::NextLineInMorsel() {
+  PELOTON_ASSERT(morsel_pos_ < morsel_end_);
+
+  const char *begin = morsel_pos_;
+  auto remaining = static_cast<size_t>(morsel_end_ - begin);
+
+  // Optimistically assume there isn't a quoted new-line in the line
+  const auto *nl = static_cast<const char *>(std::memchr(begin, '\n', remaining));
+  const char *end = (nl != nullptr ? nl : morsel_end_);
+  if (std::memchr(begin, quote_, static_cast<size_t>(end - begin)) != nullptr) {
+    // There are quotes, run the state machine to find the real line end
+    const char escape = (quote_ == escape_ ? static_cast<char>('\0') : escape_);
+    uint8_t state = 0;
+    for (end = begin; end != morsel_end_; end++) {
+      state = StepQuoteState(state, *end, quote_, escape);
+      if (*end == '\n' && (state & kInQuote) == 0) {
+        break;
+      }
+    }
+  }
+
+  // Transfer the line to the line buffer, without the new-line
+  line_len_ = 0;
+  line_[0] = '\0';
+  if (end > begin) {
+    AppendToLineBuffer(begin, static_cast<uint32_t>(end - begin));
+  }
+  morsel_pos_ = (end == morsel_end_ ? end : end + 1);
+
+  // Increment line number
+  line_number_++;
+
+  return line_;
+}
+
+void CSVScanner::Initialize() {
+  // Let's first perform a few validity checks
+  CheckFilePath(file_path_);
+
   // The path looks okay, let's try opening it
   file_.Open(file_path_, peloton::util::File::AccessMode::ReadOnly);
 
@@ -161,7 +491,7 @@ void CSVScanner::AppendToLineBuffer(const char *data, uint32_t len) {
     // need to resize it. Let's find an allocation size large enough to fit the
     // new bytes.
     uint32_t new_maxlen = line_maxlen_ * 2;
-    while (new_maxlen < len) {
+    while (new_maxlen <= line_len_ + len) {
       new_maxlen *= 2;
     }
 
@@ -274,7 +604,84 @@ char *CSVScanner::NextLine() {
   return line_;
 }
 
+void CSVScanner::Feed(const char *data, uint32_t len) {
+  // Lazily allocate the line buffer. There is no read-buffer when pushing data.
+  if (line_ == nullptr) {
+    line_ = static_cast<char *>(memory_.Allocate(kDefaultBufferSize));
+    line_len_ = 0;
+    line_maxlen_ = kDefaultBufferSize - 1;
+  }
+
+  const char quote = quote_;
+  const char escape = (quote_ == escape_ ? static_cast<char>('\0') : escape_);
+
+  uint32_t line_start = 0;
+  for (uint32_t pos = 0; pos < len; pos++) {
+    char c = data[pos];
+
+    if (in_quote_ && c == escape) {
+      last_was_escape_ = !last_was_escape_;
+    }
+    if (c == quote && !last_was_escape_) {
+      in_quote_ = !in_quote_;
+    }
+    if (c != escape) {
+      last_was_escape_ = false;
+    }
+
+    if (c == '\n' && !in_quote_) {
+      // Transfer the remainder of the line, excluding the new-line character
+      if (pos > line_start) {
+        AppendToLineBuffer(data + line_start, pos - line_start);
+      }
+      line_start = pos + 1;
+      ProduceBufferedLine();
+    }
+  }
+
+  // Stash the partial line until the next chunk arrives
+  if (line_start < len) {
+    AppendToLineBuffer(data + line_start, len - line_start);
+  }
+}
+
+void CSVScanner::Finish() {
+  if (in_quote_) {
+    throw Exception(StringUtil::Format(
+        "unterminated CSV quoted field on line %u", line_number_ + 1));
+  }
+  if (line_ != nullptr && line_len_ > 0) {
+    ProduceBufferedLine();
+  }
+}
+
+void CSVScanner::ProduceBufferedLine() {
+  line_number_++;
+
+  // Tolerate CRLF line endings
+  if (line_len_ > 0 && line_[line_len_ - 1] == '\r') {
+    line_len_--;
+  }
+  line_[line_len_] = '\0';
+
+  // Skip the end-of-data marker that older clients send
+  bool end_marker = (line_len_ == 2 && line_[0] == '\\' && line_[1] == '.');
+  if (!end_marker) {
+    ProduceCSV(line_);
+  }
+
+  line_len_ = 0;
+}
+
 void CSVScanner::ProduceCSV(char *line) {
+  // Split the line into columns
+  ParseLine(line);
+
+  // Invoke callback
+  func_(opaque_state_);
+}
+
+void CSVScanner::ParseLine(char *line) {
   const char delimiter = delimiter_;
   const char quote = quote_;
   const char escape = escape_;
@@ -365,9 +772,6 @@ void CSVScanner::ProduceCSV(char *line) {
     // Eat delimiter, moving to next column
     iter++;
   }
-
-  // Invoke callback
-  func_(opaque_state_);
 }
 
 }  // namespace util
@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// in_list.cpp
+//
+// Identification: src/codegen/util/in_list.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/in_list.h"
+
+#include <algorithm>
+
+#include "codegen/query_parameters.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+void InList::Init(const QueryParameters &parameters, uint32_t first_index,
+                  uint32_t num_values) {
+  values_ = new int64_t[std::max<uint32_t>(num_values, 1)];
+  num_values_ = 0;
+  has_null_ = false;
+
+  const auto &parameter_values = parameters.GetParameterValues();
+  for (uint32_t i = first_index; i < first_index + num_values; i++) {
+    const auto &value = parameter_values[i];
+    if (value.IsNull()) {
+      has_null_ = true;
+    } else {
+      values_[num_values_++] =
+          value.CastAs(peloton::type::TypeId::BIGINT).GetAs<int64_t>();
+    }
+  }
+
+  std::sort(values_, values_ + num_values_);
+  num_values_ = std::unique(values_, values_ + num_values_) - values_;
+}
+
+void InList::Destroy() {
+  delete[] values_;
+  values_ = nullptr;
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_matcher.cpp
+//
+// Identification: src/codegen/util/like_matcher.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/like_matcher.h"
+
+#include "codegen/query_parameters.h"
+#include "function/like_pattern.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+void LikeMatcher::Init(const QueryParameters &parameters, uint32_t index) {
+  const auto &value = parameters.GetParameterValues()[index];
+  pattern_ = value.IsNull() ? nullptr
+                            : new function::LikePattern(value.GetData(),
+                                                        value.GetLength());
+}
+
+bool LikeMatcher::Match(const char *str, uint32_t length) const {
+  return pattern_ != nullptr && pattern_->Match(str, length);
+}
+
+void LikeMatcher::Destroy() {
+  delete pattern_;
+  pattern_ = nullptr;
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_id_map.cpp
+//
+// Identification: src/codegen/util/string_id_map.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/string_id_map.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+StringIdMap::StringIdMap() : last_dictionary_(nullptr) {
+  // The ID of NULL
+  strings_.emplace_back();
+  peloton::type::VarlenSlot::SetNull(
+      reinterpret_cast<char *>(&strings_.back()));
+}
+
+StringIdMap::~StringIdMap() {
+  // The copies of long strings were allocated from the heap
+  for (const auto &slot : strings_) {
+    delete[] slot.GetArea();
+  }
+}
+
+void StringIdMap::Init(StringIdMap &map) { new (&map) StringIdMap(); }
+
+void StringIdMap::Destroy(StringIdMap &map) { map.~StringIdMap(); }
+
+uint32_t StringIdMap::GetId(const char *str, uint32_t length) {
+  if (str == nullptr) {
+    return 0;
+  }
+
+  key_.assign(str, length);
+  auto iter = ids_.find(key_);
+  if (iter != ids_.end()) {
+    return iter->second;
+  }
+
+  // A new string, give it the next ID
+  auto id = static_cast<uint32_t>(strings_.size());
+  strings_.emplace_back();
+  peloton::type::VarlenSlot::Set(reinterpret_cast<char *>(&strings_.back()),
+                                 str, length, nullptr);
+  ids_.emplace(key_, id);
+  return id;
+}
+
+const uint32_t *StringIdMap::GetDictionaryIds(const char *dictionary,
+                                              uint32_t size) {
+  if (dictionary == nullptr) {
+    return nullptr;
+  }
+  if (dictionary == last_dictionary_) {
+    return dictionary_ids_.data();
+  }
+
+  const auto *entries =
+      reinterpret_cast<const peloton::type::VarlenSlot *>(dictionary);
+  dictionary_ids_.resize(size);
+  for (uint32_t code = 0; code < size; code++) {
+    const auto &entry = entries[code];
+    dictionary_ids_[code] =
+        entry.IsNull() ? 0 : GetId(entry.GetData(), entry.length);
+  }
+  last_dictionary_ = dictionary;
+  return dictionary_ids_.data();
+}
+
+const char *StringIdMap::GetStrings() const {
+  return reinterpret_cast<const char *>(strings_.data());
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -25,12 +25,21 @@ namespace storage {
 class TileGroup;
 }
 
+namespace catalog {
+struct CatalogScanResult;
+}
+
+namespace optimizer {
+struct CachedTableStats;
+}
+
 namespace stats {
 class BackendStatsContext;
 class IndexMetric;
 }  // namespace stats
 
 class StatementCache;
+class CachedPlan;
 
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 CUCKOO_MAP_TYPE::CuckooMap() {}
@@ -125,4 +134,15 @@ template class CuckooMap<std::shared_ptr<oid_t>, std::shared_ptr<oid_t>>;
 // Used in StatementCacheManager
 template class CuckooMap<StatementCache *, StatementCache *>;
 
+// Used in GlobalCatalogCache
+template class CuckooMap<std::string,
+                         std::shared_ptr<catalog::CatalogScanResult>>;
+
+// Used in StatsStorage
+template class CuckooMap<uint64_t,
+                         std::shared_ptr<optimizer::CachedTableStats>>;
+
+// Used in PlanCache
+template class CuckooMap<std::string, std::shared_ptr<CachedPlan>>;
+
 }  // namespace peloton
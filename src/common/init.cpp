@@ -21,7 +21,10 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
+#include "optimizer/stats/auto_analyzer.h"
 #include "settings/settings_manager.h"
+#include "storage/tile_group_compactor.h"
+#include "storage/tile_group_freezer.h"
 #include "threadpool/mono_queue_pool.h"
 #include "tuning/index_tuner.h"
 #include "tuning/layout_tuner.h"
@@ -76,6 +79,23 @@ void PelotonInit::Initialize() {
     layout_tuner.Start();
   }
 
+  // start tile group freezer
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::tile_group_freezer)) {
+    storage::TileGroupFreezer::GetInstance().Start();
+  }
+
+  // start tile group compactor
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::tile_group_compactor)) {
+    storage::TileGroupCompactor::GetInstance().Start();
+  }
+
+  // start auto analyzer
+  if (settings::SettingsManager::GetBool(settings::SettingId::auto_analyze)) {
+    optimizer::AutoAnalyzer::GetInstance().Start();
+  }
+
   // Initialize catalog
   auto pg_catalog = catalog::Catalog::GetInstance();
   pg_catalog->Bootstrap();  // Additional catalogs
@@ -108,6 +128,23 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down tile group freezer
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::tile_group_freezer)) {
+    storage::TileGroupFreezer::GetInstance().Stop();
+  }
+
+  // shut down tile group compactor
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::tile_group_compactor)) {
+    storage::TileGroupCompactor::GetInstance().Stop();
+  }
+
+  // shut down auto analyzer
+  if (settings::SettingsManager::GetBool(settings::SettingId::auto_analyze)) {
+    optimizer::AutoAnalyzer::GetInstance().Stop();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
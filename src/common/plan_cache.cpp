@@ -0,0 +1,413 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache.cpp
+//
+// Identification: src/common/plan_cache.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/plan_cache.h"
+
+#include "brain/query_logger.h"
+#include "catalog/global_catalog_cache.h"
+#include "common/sql_node_visitor.h"
+#include "expression/case_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/subquery_expression.h"
+#include "parser/statements.h"
+#include "planner/abstract_plan.h"
+
+namespace peloton {
+
+namespace {
+
+/**
+ * Appends everything the fingerprint of a statement ignores to its plan cache
+ * key: the values of its constants (other than the lifted ones), its limit
+ * and offset and the aliases of its output columns.
+ */
+class PlanKeyVisitor : public SqlNodeVisitor {
+ public:
+  PlanKeyVisitor(std::string &key,
+                 const std::set<const expression::AbstractExpression *>
+                     *lifted_constants = nullptr)
+      : key_(key), lifted_constants_(lifted_constants), cacheable_(true) {}
+
+  bool IsCacheable() const { return cacheable_; }
+
+  void Visit(parser::SelectStatement *node) override {
+    for (auto &expr : node->select_list) {
+      AppendString(expr->alias);
+      expr->Accept(this);
+    }
+    if (node->from_table != nullptr) {
+      node->from_table->Accept(this);
+    }
+    if (node->where_clause != nullptr) {
+      node->where_clause->Accept(this);
+    }
+    if (node->group_by != nullptr) {
+      node->group_by->Accept(this);
+    }
+    if (node->order != nullptr) {
+      node->order->Accept(this);
+    }
+    if (node->limit != nullptr) {
+      node->limit->Accept(this);
+    } else {
+      AppendString("");
+    }
+    if (node->union_select != nullptr) {
+      node->union_select->Accept(this);
+    }
+  }
+
+  void Visit(parser::JoinDefinition *node) override {
+    node->left->Accept(this);
+    node->right->Accept(this);
+    if (node->condition != nullptr) {
+      node->condition->Accept(this);
+    }
+  }
+
+  void Visit(parser::TableRef *node) override {
+    if (node->select != nullptr) {
+      node->select->Accept(this);
+    }
+    for (auto &table_ref : node->list) {
+      table_ref->Accept(this);
+    }
+    if (node->join != nullptr) {
+      node->join->Accept(this);
+    }
+  }
+
+  void Visit(parser::GroupByDescription *node) override {
+    for (auto &column : node->columns) {
+      column->Accept(this);
+    }
+    if (node->having != nullptr) {
+      node->having->Accept(this);
+    }
+  }
+
+  void Visit(parser::OrderDescription *node) override {
+    for (auto &expr : node->exprs) {
+      expr->Accept(this);
+    }
+  }
+
+  void Visit(parser::LimitDescription *node) override {
+    AppendString(std::to_string(node->limit) + "," +
+                 std::to_string(node->offset));
+  }
+
+  void Visit(parser::UpdateStatement *node) override {
+    node->table->Accept(this);
+    for (auto &update : node->updates) {
+      update->value->Accept(this);
+    }
+    if (node->where != nullptr) {
+      node->where->Accept(this);
+    }
+  }
+
+  void Visit(parser::DeleteStatement *node) override {
+    if (node->expr != nullptr) {
+      node->expr->Accept(this);
+    }
+  }
+
+  void Visit(expression::ConstantValueExpression *expr) override {
+    if (lifted_constants_ != nullptr && lifted_constants_->count(expr) != 0) {
+      return;
+    }
+    auto value = expr->GetValue();
+    AppendString(std::to_string(static_cast<int>(value.GetTypeId())));
+    AppendString(value.IsNull() ? "" : value.ToString());
+  }
+
+  // The clauses of a CASE expression are not its children
+  void Visit(expression::CaseExpression *) override { cacheable_ = false; }
+
+  // A query of the simple query protocol has no parameters of its own
+  void Visit(expression::ParameterValueExpression *) override {
+    cacheable_ = false;
+  }
+
+  void Visit(expression::SubqueryExpression *expr) override {
+    expr->GetSubSelect()->Accept(this);
+  }
+
+ private:
+  // The strings are length-prefixed, so that no two lists of them share a key
+  void AppendString(const std::string &str) {
+    key_.append(std::to_string(str.size()));
+    key_.push_back(':');
+    key_.append(str);
+  }
+
+  std::string &key_;
+
+  // The constants that are lifted into parameters, which are not part of the
+  // key
+  const std::set<const expression::AbstractExpression *> *lifted_constants_;
+
+  bool cacheable_;
+};
+
+bool IsLiftableComparison(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Find the non-NULL constants that are compared with a column, in the order
+ * they appear in the predicate. Each is given by its comparison and the index
+ * of the constant among the children of the comparison.
+ */
+void FindLiftableConstants(
+    expression::AbstractExpression *expr,
+    std::vector<std::pair<expression::AbstractExpression *, int>> &constants) {
+  if (IsLiftableComparison(expr->GetExpressionType()) &&
+      expr->GetChildrenSize() == 2) {
+    for (int i = 0; i < 2; i++) {
+      auto *child = expr->GetChild(i);
+      auto *other = expr->GetChild(1 - i);
+      if (child->GetExpressionType() != ExpressionType::VALUE_CONSTANT ||
+          other->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+        continue;
+      }
+      if (static_cast<const expression::ConstantValueExpression *>(child)
+              ->GetValue()
+              .IsNull()) {
+        continue;
+      }
+      constants.emplace_back(expr, i);
+    }
+    return;
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    FindLiftableConstants(expr->GetModifiableChild(i), constants);
+  }
+}
+
+// The predicate whose constants are lifted, if the plan of the statement can
+// be cached
+expression::AbstractExpression *GetLiftablePredicate(
+    parser::SQLStatement *statement, bool &cacheable) {
+  cacheable = true;
+  switch (statement->GetType()) {
+    case StatementType::SELECT:
+      return static_cast<parser::SelectStatement *>(statement)
+          ->where_clause.get();
+    case StatementType::UPDATE:
+      return static_cast<parser::UpdateStatement *>(statement)->where.get();
+    case StatementType::DELETE:
+      return static_cast<parser::DeleteStatement *>(statement)->expr.get();
+    default:
+      cacheable = false;
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// Cached Plan
+//===--------------------------------------------------------------------===//
+
+std::shared_ptr<planner::AbstractPlan> CachedPlan::Acquire() {
+  std::shared_ptr<planner::AbstractPlan> plan;
+  {
+    std::lock_guard<std::mutex> lock(idle_plans_lock_);
+    if (idle_plans_.empty()) {
+      return nullptr;
+    }
+    plan = std::move(idle_plans_.back());
+    idle_plans_.pop_back();
+  }
+  return Wrap(std::move(plan));
+}
+
+std::shared_ptr<planner::AbstractPlan> CachedPlan::Wrap(
+    std::shared_ptr<planner::AbstractPlan> plan) {
+  auto *plan_ptr = plan.get();
+  auto cached_plan = shared_from_this();
+  return std::shared_ptr<planner::AbstractPlan>(
+      plan_ptr, [cached_plan, plan](planner::AbstractPlan *) {
+        cached_plan->Release(plan);
+      });
+}
+
+void CachedPlan::Invalidate() {
+  std::lock_guard<std::mutex> lock(idle_plans_lock_);
+  invalid_ = true;
+  idle_plans_.clear();
+}
+
+void CachedPlan::Release(std::shared_ptr<planner::AbstractPlan> plan) {
+  std::lock_guard<std::mutex> lock(idle_plans_lock_);
+  if (invalid_) {
+    return;
+  }
+  idle_plans_.push_back(std::move(plan));
+}
+
+//===--------------------------------------------------------------------===//
+// Plan Cache
+//===--------------------------------------------------------------------===//
+
+PlanCache &PlanCache::GetInstance() {
+  static PlanCache plan_cache;
+  return plan_cache;
+}
+
+std::string PlanCache::GetKey(const std::string &query_string,
+                              const std::string &database_name,
+                              parser::SQLStatement *statement,
+                              std::vector<type::Value> &parameters) {
+  bool cacheable;
+  auto *predicate = GetLiftablePredicate(statement, cacheable);
+  if (!cacheable) {
+    return "";
+  }
+
+  brain::QueryLogger::Fingerprint fingerprint{query_string};
+  if (fingerprint.GetFingerprint().empty()) {
+    return "";
+  }
+
+  // Check that every constant of the statement can be found
+  std::string key;
+  PlanKeyVisitor check_visitor{key};
+  statement->Accept(&check_visitor);
+  if (!check_visitor.IsCacheable()) {
+    return "";
+  }
+
+  std::vector<std::pair<expression::AbstractExpression *, int>> constants;
+  if (predicate != nullptr) {
+    FindLiftableConstants(predicate, constants);
+  }
+  parameters.clear();
+  std::set<const expression::AbstractExpression *> lifted_constants;
+  for (auto &constant : constants) {
+    auto *child = constant.first->GetChild(constant.second);
+    parameters.push_back(
+        static_cast<const expression::ConstantValueExpression *>(child)
+            ->GetValue());
+    lifted_constants.insert(child);
+  }
+
+  key = database_name;
+  key.push_back('\0');
+  key.append(fingerprint.GetFingerprint());
+  key.push_back('\0');
+  for (auto &parameter : parameters) {
+    key.append(std::to_string(static_cast<int>(parameter.GetTypeId())));
+    key.push_back(',');
+  }
+  key.push_back('\0');
+  PlanKeyVisitor key_visitor{key, &lifted_constants};
+  statement->Accept(&key_visitor);
+  return key;
+}
+
+void PlanCache::LiftConstants(parser::SQLStatement *statement) {
+  bool cacheable;
+  auto *predicate = GetLiftablePredicate(statement, cacheable);
+  if (predicate == nullptr) {
+    return;
+  }
+  std::vector<std::pair<expression::AbstractExpression *, int>> constants;
+  FindLiftableConstants(predicate, constants);
+  for (size_t i = 0; i < constants.size(); i++) {
+    constants[i].first->SetChild(
+        constants[i].second,
+        new expression::ParameterValueExpression(static_cast<int>(i)));
+  }
+}
+
+std::shared_ptr<CachedPlan> PlanCache::Find(const std::string &key,
+                                            uint64_t catalog_version) const {
+  std::shared_ptr<CachedPlan> plan;
+  if (catalog::GlobalCatalogCache::GetInstance().IsCurrent(catalog_version) ==
+          false ||
+      plans_.Find(key, plan) == false ||
+      plan->GetCatalogVersion() != catalog_version) {
+    return nullptr;
+  }
+  return plan;
+}
+
+void PlanCache::Insert(const std::string &key,
+                       std::shared_ptr<CachedPlan> plan) {
+  if (catalog::GlobalCatalogCache::GetInstance().IsCurrent(
+          plan->GetCatalogVersion()) == false) {
+    return;
+  }
+  // Ad-hoc queries rarely have this many distinct shapes, so start over
+  // rather than track the usage of the plans
+  if (plans_.GetSize() >= DEFAULT_PLAN_CACHE_CAPACITY) {
+    Clear();
+  }
+  if (plans_.Update(key, plan) == false) {
+    plans_.Insert(key, plan);
+  }
+}
+
+void PlanCache::InvalidateTableOid(oid_t table_oid) {
+  InvalidateTableOids({table_oid});
+}
+
+void PlanCache::InvalidateTableOids(const std::set<oid_t> &table_oids) {
+  if (table_oids.empty() || plans_.IsEmpty()) return;
+
+  std::vector<std::string> keys;
+  {
+    // Lock the table by grabbing the iterator
+    auto iterator = plans_.GetIterator();
+    for (auto &iter : iterator) {
+      auto &referenced_tables = iter.second->GetReferencedTables();
+      for (auto table_oid : table_oids) {
+        if (referenced_tables.count(table_oid) != 0) {
+          iter.second->Invalidate();
+          keys.push_back(iter.first);
+          break;
+        }
+      }
+    }
+  }
+
+  for (auto &key : keys) {
+    plans_.Erase(key);
+  }
+  LOG_TRACE("Invalidated %lu cached plans", keys.size());
+}
+
+void PlanCache::Clear() {
+  {
+    auto iterator = plans_.GetIterator();
+    for (auto &iter : iterator) {
+      iter.second->Invalidate();
+    }
+  }
+  plans_.Clear();
+}
+
+}  // namespace peloton
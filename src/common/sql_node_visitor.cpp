@@ -22,6 +22,7 @@
 #include "expression/constant_value_expression.h"
 #include "expression/case_expression.h"
 #include "expression/subquery_expression.h"
+#include "expression/vector_value_expression.h"
 
 namespace peloton {
 void SqlNodeVisitor::Visit(expression::ComparisonExpression *expr) {
@@ -60,5 +61,8 @@ void SqlNodeVisitor::Visit(expression::TupleValueExpression *expr) {
 void SqlNodeVisitor::Visit(expression::SubqueryExpression *expr) {
   expr->AcceptChildren(this);
 }
+void SqlNodeVisitor::Visit(expression::VectorValueExpression *expr) {
+  expr->AcceptChildren(this);
+}
 
 }  // peloton
@@ -12,6 +12,8 @@
 
 #include "common/statement_cache_manager.h"
 
+#include "common/plan_cache.h"
+
 namespace peloton {
 
 void StatementCacheManager::RegisterStatementCache(StatementCache *stmt_cache) {
@@ -23,6 +25,9 @@ void StatementCacheManager::UnRegisterStatementCache(StatementCache *stmt_cache)
 }
 
 void StatementCacheManager::InvalidateTableOid(oid_t table_id) {
+  // The shared plans are not registered with the manager
+  PlanCache::GetInstance().InvalidateTableOid(table_id);
+
   if (statement_caches_.IsEmpty()) 
     return;
 
@@ -38,6 +43,8 @@ void StatementCacheManager::InvalidateTableOid(oid_t table_id) {
 }
 
 void StatementCacheManager::InvalidateTableOids(std::set<oid_t> &table_ids) {
+  PlanCache::GetInstance().InvalidateTableOids(table_ids);
+
   if (table_ids.empty() || statement_caches_.IsEmpty())
     return;
 
@@ -20,11 +20,13 @@ namespace concurrency {
   // enter epoch with thread id
   cid_t DecentralizedEpochManager::EnterEpoch(const size_t thread_id, const TimestampType ts_type) {
 
-    PELOTON_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
+    PELOTON_ASSERT(thread_id < MAX_EPOCH_THREAD_COUNT &&
+                   local_epochs_[thread_id] != nullptr);
+    auto &local_epoch = local_epochs_[thread_id];
 
     if (ts_type == TimestampType::SNAPSHOT_READ) {
 
-      local_epochs_.at(thread_id)->EnterEpoch(snapshot_global_epoch_id_, ts_type);
+      local_epoch->EnterEpoch(snapshot_global_epoch_id_, ts_type);
 
       return (snapshot_global_epoch_id_ << 32) | 0x0;
 
@@ -34,7 +36,7 @@ namespace concurrency {
         uint64_t epoch_id = GetCurrentEpochId();
 
         // enter the corresponding local epoch.
-        bool rt = local_epochs_.at(thread_id)->EnterEpoch(epoch_id, ts_type);
+        bool rt = local_epoch->EnterEpoch(epoch_id, ts_type);
 
         // if successfully entered local epoch
         if (rt == true) {
@@ -50,10 +52,11 @@ namespace concurrency {
 
   void DecentralizedEpochManager::ExitEpoch(const size_t thread_id, const eid_t epoch_id) {
 
-    PELOTON_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
+    PELOTON_ASSERT(thread_id < MAX_EPOCH_THREAD_COUNT &&
+                   local_epochs_[thread_id] != nullptr);
 
     // exit from the corresponding local epoch.
-    local_epochs_.at(thread_id)->ExitEpoch(epoch_id);
+    local_epochs_[thread_id]->ExitEpoch(epoch_id);
  
   }
 
@@ -62,16 +65,23 @@ namespace concurrency {
     eid_t global_expired_eid = MAX_EID;
     
     // for all the local epoch contexts, obtain the minimum max committed epoch id.
-    for (auto &local_epoch_itr : local_epochs_) {
-      
+    // hold the latch so that no thread is deregistered during the scan.
+    local_epoch_lock_.Lock();
+    for (size_t i = 0; i < thread_count_; ++i) {
+      auto &local_epoch = local_epochs_[i];
+      if (local_epoch == nullptr) {
+        continue;
+      }
+
       // the centralized epoch manager must notify each local epoch
       // the current global epoch.
-      eid_t local_expired_eid = local_epoch_itr.second->GetExpiredEpochId(current_global_epoch_id_);
+      eid_t local_expired_eid = local_epoch->GetExpiredEpochId(current_global_epoch_id_);
       
       if (local_expired_eid < global_expired_eid) {
         global_expired_eid = local_expired_eid;
       }
     }
+    local_epoch_lock_.Unlock();
 
     // if we observe that global_expired_eid is larger than snapshot_global_epoch,
     // then it means the current thread's progress is too slow.
@@ -25,13 +25,13 @@ namespace concurrency {
     if (epoch_id_lower_bound_ == UINT64_MAX) {
 
       epoch_id_lower_bound_ = epoch_id - 1;
-    
+
     } else if (epoch_id_lower_bound_ >= epoch_id) {
-    
+
       if (ts_type == TimestampType::SNAPSHOT_READ) {
-    
+
         epoch_id_lower_bound_ = epoch_id - 1;
-    
+
       } else {
         // epoch_id_lower_bound_ has already been updated by the GC.
         // have to grab a newer epoch_id.
@@ -43,19 +43,33 @@ namespace concurrency {
 
     if (ts_type != TimestampType::COMMIT) {
 
-      auto epoch_map_itr = epoch_map_.find(epoch_id);
-      // check whether the corresponding epoch exists.
-      if (epoch_map_itr == epoch_map_.end()) {
-
-        std::shared_ptr<Epoch> epoch_ptr(new Epoch(epoch_id, 1));
-
-        epoch_queue_.push(epoch_ptr);
-        epoch_map_[epoch_id] = epoch_ptr;
+      EpochSlot *free_slot = nullptr;
+      bool found = false;
+      for (auto &slot : epoch_slots_) {
+        if (slot.txn_count_ == 0) {
+          if (free_slot == nullptr) {
+            free_slot = &slot;
+          }
+        } else if (slot.epoch_id_ == epoch_id) {
+          slot.txn_count_++;
+          found = true;
+          break;
+        }
+      }
 
-      } else {
-        epoch_map_itr->second->txn_count_++;
+      // check whether the corresponding epoch exists.
+      if (found == false) {
+        auto overflow_itr = overflow_epochs_.find(epoch_id);
+        if (overflow_itr != overflow_epochs_.end()) {
+          overflow_itr->second++;
+        } else if (free_slot != nullptr) {
+          free_slot->epoch_id_ = epoch_id;
+          free_slot->txn_count_ = 1;
+        } else {
+          overflow_epochs_[epoch_id] = 1;
+        }
       }
-      
+
     }
 
     epoch_lock_.Unlock();
@@ -66,50 +80,65 @@ namespace concurrency {
   void LocalEpoch::ExitEpoch(const eid_t epoch_id) {
     epoch_lock_.Lock();
 
-    PELOTON_ASSERT(epoch_map_.find(epoch_id) != epoch_map_.end());
-    epoch_map_.at(epoch_id)->txn_count_--;
-
-    while (epoch_queue_.size() != 0) {
-      auto &epoch_ptr = epoch_queue_.top();
-      if (epoch_ptr->txn_count_ == 0) {
-        epoch_map_.erase(epoch_ptr->epoch_id_);
-        epoch_queue_.pop();
-      } else {
-        PELOTON_ASSERT(epoch_ptr->epoch_id_ > epoch_id_lower_bound_);
-        epoch_id_lower_bound_ = epoch_ptr->epoch_id_ - 1;
+    bool found = false;
+    for (auto &slot : epoch_slots_) {
+      if (slot.txn_count_ != 0 && slot.epoch_id_ == epoch_id) {
+        slot.txn_count_--;
+        found = true;
         break;
       }
     }
 
+    if (found == false) {
+      auto overflow_itr = overflow_epochs_.find(epoch_id);
+      PELOTON_ASSERT(overflow_itr != overflow_epochs_.end());
+      if (--overflow_itr->second == 0) {
+        overflow_epochs_.erase(overflow_itr);
+      }
+    }
+
+    uint64_t min_epoch_id = GetMinActiveEpochId();
+    if (min_epoch_id != 0) {
+      PELOTON_ASSERT(min_epoch_id > epoch_id_lower_bound_);
+      epoch_id_lower_bound_ = min_epoch_id - 1;
+    }
+
     epoch_lock_.Unlock();
   }
 
   uint64_t LocalEpoch::GetExpiredEpochId(const uint64_t epoch_id) {
     epoch_lock_.Lock();
+
+    uint64_t min_epoch_id = GetMinActiveEpochId();
     // there's no epoch in this thread.
     // which indicates that this thread is never used or has been GC'd for some time.
-    if (epoch_queue_.size() == 0) {
+    if (min_epoch_id == 0) {
       epoch_id_lower_bound_ = epoch_id - 1;
     } else {
-      while (epoch_queue_.size() != 0) {
-        // get the smallest epoch.
-        auto &epoch_ptr = epoch_queue_.top();
-        // if there's no transaction in the epoch
-        if (epoch_ptr->txn_count_ == 0) {
-          epoch_map_.erase(epoch_ptr->epoch_id_);
-          epoch_queue_.pop();
-        } else {
-          PELOTON_ASSERT(epoch_ptr->epoch_id_ > epoch_id_lower_bound_);
-          epoch_id_lower_bound_ = epoch_ptr->epoch_id_ - 1;
-          break;
-        }
-      }
+      PELOTON_ASSERT(min_epoch_id > epoch_id_lower_bound_);
+      epoch_id_lower_bound_ = min_epoch_id - 1;
     }
     uint64_t ret = epoch_id_lower_bound_;
-    
+
     epoch_lock_.Unlock();
     return ret;
   }
 
+  uint64_t LocalEpoch::GetMinActiveEpochId() const {
+    // the smallest epoch that still has transactions, in the overflow map
+    // or in the slots.
+    uint64_t min_epoch_id = 0;
+    if (overflow_epochs_.empty() == false) {
+      min_epoch_id = overflow_epochs_.begin()->first;
+    }
+    for (auto &slot : epoch_slots_) {
+      if (slot.txn_count_ != 0 &&
+          (min_epoch_id == 0 || slot.epoch_id_ < min_epoch_id)) {
+        min_epoch_id = slot.epoch_id_;
+      }
+    }
+    return min_epoch_id;
+  }
+
 }
 }
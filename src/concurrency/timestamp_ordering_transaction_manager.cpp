@@ -15,6 +15,7 @@
 #include "storage/storage_manager.h"
 
 #include "catalog/catalog_defaults.h"
+#include "catalog/global_catalog_cache.h"
 #include "catalog/manager.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -131,6 +132,14 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
     if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
       latch.Unlock();
 
+      return false;
+    } else if (tile_group_header->IsSealed() == true) {
+      // the tile group is being replaced by a frozen copy (see
+      // DataTable::FreezeTileGroup()), which checks for owned tuples only
+      // after sealing it. so either it sees our ownership, or we see the seal.
+      tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+      latch.Unlock();
+
       return false;
     } else {
       latch.Unlock();
@@ -596,6 +605,12 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   //// handle other isolation levels
   //////////////////////////////////////////////////////////
 
+  // no cached catalog scans are used while the catalog changes become
+  // visible, until EndTransaction() invalidates them
+  if (current_txn->IsCatalogModified()) {
+    catalog::GlobalCatalogCache::GetInstance().BeginChange();
+  }
+
   auto storage_manager = storage::StorageManager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
@@ -763,6 +778,13 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   PELOTON_ASSERT(!current_txn->IsReadOnly());
 
   LOG_TRACE("Aborting peloton txn : %" PRId64, current_txn->GetTransactionId());
+
+  // no cached catalog scans are used while the catalog changes are rolled
+  // back, until EndTransaction() invalidates them
+  if (current_txn->IsCatalogModified()) {
+    catalog::GlobalCatalogCache::GetInstance().BeginChange();
+  }
+
   auto storage_manager = storage::StorageManager::GetInstance();
 
   auto &rw_set = current_txn->GetReadWriteSet();
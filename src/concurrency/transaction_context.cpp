@@ -84,6 +84,7 @@ void TransactionContext::Init(const size_t thread_id,
   gc_object_set_ = std::make_shared<GCObjectSet>();
 
   on_commit_triggers_.reset();
+  on_end_actions_.clear();
 }
 
 RWType TransactionContext::GetRWType(const ItemPointer &location) {
@@ -157,5 +158,20 @@ void TransactionContext::ExecOnCommitTriggers() {
   }
 }
 
+void TransactionContext::AddOnEndAction(std::function<void()> action,
+                                        bool commit_only) {
+  on_end_actions_.push_back(EndAction{std::move(action), commit_only});
+}
+
+void TransactionContext::ExecOnEndActions() {
+  bool committed = result_ == ResultType::SUCCESS;
+  for (auto &end_action : on_end_actions_) {
+    if (committed || !end_action.commit_only) {
+      end_action.action();
+    }
+  }
+  on_end_actions_.clear();
+}
+
 }  // namespace concurrency
 }  // namespace peloton
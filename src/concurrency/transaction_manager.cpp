@@ -12,6 +12,7 @@
 
 #include "concurrency/transaction_manager.h"
 
+#include "catalog/global_catalog_cache.h"
 #include "catalog/manager.h"
 #include "concurrency/transaction_context.h"
 #include "function/date_functions.h"
@@ -35,6 +36,11 @@ TransactionContext *TransactionManager::BeginTransaction(
     const size_t thread_id, const IsolationLevelType type, bool read_only) {
   TransactionContext *txn = nullptr;
 
+  // Read the catalog version before taking the snapshot, so that a catalog
+  // change the snapshot misses is newer than the version
+  uint64_t catalog_version =
+      catalog::GlobalCatalogCache::GetInstance().GetVersion();
+
   if (type == IsolationLevelType::SNAPSHOT) {
     // transaction processing with decentralized epoch manager
     // the DBMS must acquire
@@ -66,6 +72,7 @@ TransactionContext *TransactionManager::BeginTransaction(
   }
 
   txn->SetTimestamp(function::DateFunctions::Now());
+  txn->SetCatalogVersion(catalog_version);
 
   return txn;
 }
@@ -75,6 +82,7 @@ void TransactionManager::EndTransaction(TransactionContext *current_txn) {
   if (current_txn->GetResult() == ResultType::SUCCESS) {
     current_txn->ExecOnCommitTriggers();
   }
+  current_txn->ExecOnEndActions();
 
   // log RWSet and result stats
   const auto &stats_type = static_cast<StatsType>(
@@ -85,6 +93,13 @@ void TransactionManager::EndTransaction(TransactionContext *current_txn) {
     RecordTransactionStats(current_txn);
   }
 
+  // the catalog changes are visible now (or rolled back), so the cached
+  // catalog scans may be stale. this pairs with the BeginChange() of the
+  // commit or abort.
+  if (current_txn->IsCatalogModified()) {
+    catalog::GlobalCatalogCache::GetInstance().Invalidate();
+  }
+
   // pass transaction context to garbage collector
   if (gc::GCManagerFactory::GetGCType() == GarbageCollectionType::ON) {
     gc::GCManagerFactory::GetInstance().RecycleTransaction(current_txn);
@@ -297,8 +297,12 @@ void AbstractJoinExecutor::BufferRightTile(LogicalTile *right_tile) {
   switch (join_type_) {
     case JoinType::RIGHT:
     case JoinType::OUTER:
+    case JoinType::ANTI:
       UpdateRightJoinRowSets();
       break;
+    case JoinType::SEMI:
+      matching_right_row_sets_.emplace_back();
+      break;
     default:
       break;
   }
@@ -368,7 +372,15 @@ bool AbstractJoinExecutor::BuildOuterJoinOutput() {
   switch (join_type_) {
     case JoinType::LEFT: { return BuildLeftJoinOutput(); }
 
-    case JoinType::RIGHT: { return BuildRightJoinOutput(); }
+    case JoinType::RIGHT:
+    case JoinType::ANTI: {
+      return BuildRightJoinOutput(no_matching_right_row_sets_);
+    }
+
+    // SEMI joins only produce the right rows with a match, once each
+    case JoinType::SEMI: {
+      return BuildRightJoinOutput(matching_right_row_sets_);
+    }
 
     case JoinType::OUTER: {
       bool status = BuildLeftJoinOutput();
@@ -376,7 +388,7 @@ bool AbstractJoinExecutor::BuildOuterJoinOutput() {
       if (status == true) {
         return status;
       } else {
-        return BuildRightJoinOutput();
+        return BuildRightJoinOutput(no_matching_right_row_sets_);
       }
       break;
     }
@@ -436,11 +448,11 @@ bool AbstractJoinExecutor::BuildLeftJoinOutput() {
 
 /*
  * build right join output by adding null rows for every row from left tile
- * which doesn't have a match
+ * which doesn't have a match, or for the given rows of the right tiles
  */
-bool AbstractJoinExecutor::BuildRightJoinOutput() {
-  while (right_matching_idx < no_matching_right_row_sets_.size()) {
-    if (no_matching_right_row_sets_[right_matching_idx].empty()) {
+bool AbstractJoinExecutor::BuildRightJoinOutput(const RowSets &right_row_sets) {
+  while (right_matching_idx < right_row_sets.size()) {
+    if (right_row_sets[right_matching_idx].empty()) {
       right_matching_idx++;
       continue;
     }
@@ -463,7 +475,7 @@ bool AbstractJoinExecutor::BuildRightJoinOutput() {
           LogicalTile::PositionListsBuilder(left_tile, right_tile);
     }
     // add rows with null values on the left
-    for (auto right_row_itr : no_matching_right_row_sets_[right_matching_idx]) {
+    for (auto right_row_itr : right_row_sets[right_matching_idx]) {
       pos_lists_builder.AddLeftNullRow(right_row_itr);
     }
     PELOTON_ASSERT(pos_lists_builder.Size() > 0);
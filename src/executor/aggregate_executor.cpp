@@ -101,6 +101,19 @@ bool AggregateExecutor::DExecute() {
       // Initialize the aggregator
       switch (node.GetAggregateStrategy()) {
         case AggregateType::HASH:
+        case AggregateType::PLAIN:
+          if (VectorizedAggregator::IsSupported(&node, tile.get())) {
+            LOG_TRACE("Use VectorizedAggregator");
+            aggregator.reset(new VectorizedAggregator(
+                &node, output_table, executor_context_, tile.get()));
+            break;
+          }
+          if (node.GetAggregateStrategy() == AggregateType::PLAIN) {
+            LOG_TRACE("Use PlainAggregator");
+            aggregator.reset(
+                new PlainAggregator(&node, output_table, executor_context_));
+            break;
+          }
           LOG_TRACE("Use HashAggregator");
           aggregator.reset(new HashAggregator(
               &node, output_table, executor_context_, tile->GetColumnCount()));
@@ -110,11 +123,6 @@ bool AggregateExecutor::DExecute() {
           aggregator.reset(new SortedAggregator(
               &node, output_table, executor_context_, tile->GetColumnCount()));
           break;
-        case AggregateType::PLAIN:
-          LOG_TRACE("Use PlainAggregator");
-          aggregator.reset(
-              new PlainAggregator(&node, output_table, executor_context_));
-          break;
         default:
           LOG_ERROR("Invalid aggregate type. Return.");
           return false;
@@ -123,13 +131,8 @@ bool AggregateExecutor::DExecute() {
 
     LOG_TRACE("Looping over tile..");
 
-    for (oid_t tuple_id : *tile) {
-      std::unique_ptr<ContainerTuple<LogicalTile>> cur_tuple(
-          new ContainerTuple<LogicalTile>(tile.get(), tuple_id));
-
-      if (aggregator->Advance(cur_tuple.get()) == false) {
-        return false;
-      }
+    if (aggregator->AdvanceTile(tile.get()) == false) {
+      return false;
     }
     LOG_TRACE("Finished processing logical tile");
   }
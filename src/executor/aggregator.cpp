@@ -12,11 +12,20 @@
 
 #include "executor/aggregator.h"
 
+#include <cstring>
+#include <limits>
+
 #include "catalog/manager.h"
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "expression/tuple_value_expression.h"
 #include "storage/abstract_table.h"
+#include "storage/compressed_tile.h"
+#include "storage/tile.h"
+#include "type/limits.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace executor {
@@ -80,38 +89,35 @@ type::Value AbstractAttributeAggregator::Finalize() {
   return DFinalize();
 }
 
+bool AbstractAggregator::AdvanceTile(LogicalTile *tile) {
+  for (oid_t tuple_id : *tile) {
+    ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
+    if (!Advance(&cur_tuple)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*
- * Helper method responsible for inserting the results of the aggregation
- * into a new tuple in the output tile group as well as passing through any
- * additional columns from the input tile group.
+ * Insert a tuple for a group into the output table, given the group's
+ * finalized aggregate values.
  *
  * Output tuple is projected from two tuples:
  * Left is the 'delegate' tuple, which is usually the first tuple in the group,
  * used to retrieve pass-through values;
  * Right is the tuple holding all aggregated values.
  */
-bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **aggregates,
-            storage::AbstractTable *output_table,
-            const AbstractTuple *delegate_tuple,
-            executor::ExecutorContext *econtext) {
+bool InsertGroup(const planner::AggregatePlan *node,
+                 std::vector<type::Value> &aggregate_values,
+                 storage::AbstractTable *output_table,
+                 const AbstractTuple *delegate_tuple,
+                 executor::ExecutorContext *econtext) {
   auto schema = output_table->GetSchema();
   std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
 
   /*
-   * 1) Construct a vector of aggregated values
-   */
-  std::vector<type::Value> aggregate_values;
-  auto &aggregate_terms = node->GetUniqueAggTerms();
-  for (oid_t column_itr = 0; column_itr < aggregate_terms.size();
-       column_itr++) {
-    if (aggregates[column_itr] != nullptr) {
-      type::Value final_val = aggregates[column_itr]->Finalize();
-      aggregate_values.push_back(final_val);
-    }
-  }
-
-  /*
-   * 2) Evaluate filter predicate;
+   * 1) Evaluate filter predicate;
    * if fail, just return
    */
   std::unique_ptr<ContainerTuple<std::vector<type::Value>>>
@@ -126,7 +132,7 @@ bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **ag
   }
 
   /*
-   * 3) Construct the tuple to insert using projectInfo
+   * 2) Construct the tuple to insert using projectInfo
    */
   node->GetProjectInfo()->Evaluate(tuple.get(), delegate_tuple,
                                    aggref_tuple.get(), econtext);
@@ -146,6 +152,30 @@ bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **ag
   return true;
 }
 
+/*
+ * Helper method responsible for inserting the results of the aggregation
+ * into a new tuple in the output tile group as well as passing through any
+ * additional columns from the input tile group.
+ */
+bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **aggregates,
+            storage::AbstractTable *output_table,
+            const AbstractTuple *delegate_tuple,
+            executor::ExecutorContext *econtext) {
+  // Construct a vector of aggregated values
+  std::vector<type::Value> aggregate_values;
+  auto &aggregate_terms = node->GetUniqueAggTerms();
+  for (oid_t column_itr = 0; column_itr < aggregate_terms.size();
+       column_itr++) {
+    if (aggregates[column_itr] != nullptr) {
+      type::Value final_val = aggregates[column_itr]->Finalize();
+      aggregate_values.push_back(final_val);
+    }
+  }
+
+  return InsertGroup(node, aggregate_values, output_table, delegate_tuple,
+                     econtext);
+}
+
 //===--------------------------------------------------------------------===//
 // Hash Aggregator
 //===--------------------------------------------------------------------===//
@@ -240,6 +270,782 @@ bool HashAggregator::Finalize() {
   return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Vectorized Aggregator
+//===--------------------------------------------------------------------===//
+namespace {
+
+// The NULL sentinel a fixed-width value is stored as
+template <typename T>
+T NullValue();
+template <>
+int8_t NullValue<int8_t>() { return type::PELOTON_INT8_NULL; }
+template <>
+int16_t NullValue<int16_t>() { return type::PELOTON_INT16_NULL; }
+template <>
+int32_t NullValue<int32_t>() { return type::PELOTON_INT32_NULL; }
+template <>
+int64_t NullValue<int64_t>() { return type::PELOTON_INT64_NULL; }
+template <>
+uint64_t NullValue<uint64_t>() { return type::PELOTON_TIMESTAMP_NULL; }
+template <>
+double NullValue<double>() { return type::PELOTON_DECIMAL_NULL; }
+
+// Return the type of a column of a logical tile
+type::TypeId GetColumnType(LogicalTile *tile, oid_t column_id) {
+  const auto &column_info = tile->GetColumnInfo(column_id);
+  return column_info.base_tile->GetSchema()->GetType(
+      column_info.origin_column_id);
+}
+
+bool IsIntegerType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether we can pack values of the given type into a group-by key
+bool IsKeyType(type::TypeId type_id) {
+  return IsIntegerType(type_id) || type_id == type::TypeId::BOOLEAN ||
+         type_id == type::TypeId::TIMESTAMP;
+}
+
+bool IsStringType(type::TypeId type_id) {
+  return type_id == type::TypeId::VARCHAR || type_id == type::TypeId::VARBINARY;
+}
+
+// The ID of a string code that was not mapped to its string's ID yet
+const int64_t kUnmappedCode = -1;
+
+/*
+ * Read the values of a column for the given visible tuples of a tile straight
+ * from the base tile's storage. Values missing from the tile (e.g., the outer
+ * side of a join) are read as NULL.
+ */
+template <typename T>
+void GatherColumn(LogicalTile *tile, oid_t column_id,
+                  const std::vector<oid_t> &tuple_ids, std::vector<T> &values) {
+  const auto &column_info = tile->GetColumnInfo(column_id);
+  const auto &positions =
+      tile->GetPositionLists()[column_info.position_list_idx];
+  const auto *base_tile = column_info.base_tile.get();
+  const size_t offset =
+      base_tile->GetSchema()->GetOffset(column_info.origin_column_id);
+
+  // The tiles of frozen tile groups have no slots to read from
+  const auto *compressed_tile =
+      base_tile->IsCompressed()
+          ? static_cast<const storage::CompressedTile *>(base_tile)
+          : nullptr;
+
+  values.resize(tuple_ids.size());
+  for (size_t i = 0; i < tuple_ids.size(); i++) {
+    oid_t position = positions[tuple_ids[i]];
+    if (position == NULL_OID) {
+      values[i] = NullValue<T>();
+    } else if (compressed_tile != nullptr) {
+      compressed_tile->DecodeColumn(column_info.origin_column_id, position,
+                                    position + 1,
+                                    reinterpret_cast<char *>(&values[i]),
+                                    sizeof(T));
+    } else {
+      PELOTON_MEMCPY(&values[i], base_tile->GetTupleLocation(position) + offset,
+                     sizeof(T));
+    }
+  }
+}
+
+// Read a fixed-width value of a single tuple, NULLs as their sentinel
+template <typename T>
+T GetNativeValue(const type::Value &value) {
+  return value.IsNull() ? NullValue<T>() : value.GetAs<T>();
+}
+
+/*
+ * Pack a group-by column into its word of the keys of the given tuples.
+ * NULLs are packed as their sentinel, so they all fall in the same group.
+ */
+template <typename T>
+void PackKeyColumn(LogicalTile *tile, oid_t column_id,
+                   const std::vector<oid_t> &tuple_ids, size_t key_idx,
+                   size_t num_keys, std::vector<int64_t> &keys) {
+  std::vector<T> values;
+  GatherColumn<T>(tile, column_id, tuple_ids, values);
+  for (size_t i = 0; i < values.size(); i++) {
+    keys[i * num_keys + key_idx] = static_cast<int64_t>(values[i]);
+  }
+}
+
+void PackKeyColumn(LogicalTile *tile, oid_t column_id,
+                   const std::vector<oid_t> &tuple_ids, size_t key_idx,
+                   size_t num_keys, std::vector<int64_t> &keys) {
+  switch (GetColumnType(tile, column_id)) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+      PackKeyColumn<int8_t>(tile, column_id, tuple_ids, key_idx, num_keys,
+                            keys);
+      break;
+    case type::TypeId::SMALLINT:
+      PackKeyColumn<int16_t>(tile, column_id, tuple_ids, key_idx, num_keys,
+                             keys);
+      break;
+    case type::TypeId::INTEGER:
+      PackKeyColumn<int32_t>(tile, column_id, tuple_ids, key_idx, num_keys,
+                             keys);
+      break;
+    case type::TypeId::BIGINT:
+      PackKeyColumn<int64_t>(tile, column_id, tuple_ids, key_idx, num_keys,
+                             keys);
+      break;
+    case type::TypeId::TIMESTAMP:
+      PackKeyColumn<uint64_t>(tile, column_id, tuple_ids, key_idx, num_keys,
+                              keys);
+      break;
+    default:
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      "Unsupported group-by column type");
+  }
+}
+
+uint64_t HashKey(const int64_t *key, size_t num_keys) {
+  uint64_t hash = num_keys;
+  for (size_t i = 0; i < num_keys; i++) {
+    // Finalizer of MurmurHash3, so that the low bits we probe with are mixed
+    uint64_t word = static_cast<uint64_t>(key[i]) ^ (hash * 0x9e3779b97f4a7c15);
+    word ^= word >> 33;
+    word *= 0xff51afd7ed558ccd;
+    word ^= word >> 33;
+    word *= 0xc4ceb9fe1a85ec53;
+    word ^= word >> 33;
+    hash = word;
+  }
+  return hash;
+}
+
+// Add a value to a running sum, with the same range check as type::Value::Add
+// on values of type T. Sums of integers are kept in 64 bits.
+template <typename T>
+int64_t CheckedAdd(int64_t sum, T value) {
+  int64_t result;
+  if (__builtin_add_overflow(sum, static_cast<int64_t>(value), &result) ||
+      result < std::numeric_limits<T>::min() ||
+      result > std::numeric_limits<T>::max()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+  }
+  return result;
+}
+
+double CheckedAdd(double sum, double value) { return sum + value; }
+
+template <typename T>
+struct SumType {
+  using type = int64_t;
+};
+template <>
+struct SumType<double> {
+  using type = double;
+};
+
+// Box a value of a fixed-width column of the given type
+type::Value MakeValue(type::TypeId type_id, int64_t value) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(static_cast<int8_t>(value));
+    case type::TypeId::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(static_cast<int16_t>(value));
+    case type::TypeId::INTEGER:
+      return type::ValueFactory::GetIntegerValue(static_cast<int32_t>(value));
+    case type::TypeId::BIGINT:
+      return type::ValueFactory::GetBigIntValue(value);
+    case type::TypeId::TIMESTAMP:
+      return type::ValueFactory::GetTimestampValue(value);
+    default:
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      "Unsupported aggregate column type " +
+                          TypeIdToString(type_id));
+  }
+}
+
+type::Value MakeValue(type::TypeId type_id UNUSED_ATTRIBUTE, double value) {
+  PELOTON_ASSERT(type_id == type::TypeId::DECIMAL);
+  return type::ValueFactory::GetDecimalValue(value);
+}
+
+// COUNT(*)
+class CountStarAccumulator : public AbstractVectorAccumulator {
+ public:
+  void Resize(size_t num_groups) override { counts_.resize(num_groups, 0); }
+
+  void Advance(LogicalTile *tile UNUSED_ATTRIBUTE,
+               const std::vector<oid_t> &tuple_ids UNUSED_ATTRIBUTE,
+               const std::vector<uint32_t> &group_ids) override {
+    for (uint32_t group_id : group_ids) {
+      counts_[group_id]++;
+    }
+  }
+
+  void Advance(const AbstractTuple *tuple UNUSED_ATTRIBUTE,
+               uint32_t group_id) override {
+    counts_[group_id]++;
+  }
+
+  type::Value Finalize(uint32_t group_id) const override {
+    return type::ValueFactory::GetBigIntValue(counts_[group_id]);
+  }
+
+ private:
+  std::vector<int64_t> counts_;
+};
+
+// COUNT(column)
+template <typename T>
+class CountAccumulator : public AbstractVectorAccumulator {
+ public:
+  explicit CountAccumulator(oid_t column_id) : column_id_(column_id) {}
+
+  void Resize(size_t num_groups) override { counts_.resize(num_groups, 0); }
+
+  void Advance(LogicalTile *tile, const std::vector<oid_t> &tuple_ids,
+               const std::vector<uint32_t> &group_ids) override {
+    GatherColumn<T>(tile, column_id_, tuple_ids, values_);
+    for (size_t i = 0; i < values_.size(); i++) {
+      counts_[group_ids[i]] += (values_[i] != NullValue<T>());
+    }
+  }
+
+  void Advance(const AbstractTuple *tuple, uint32_t group_id) override {
+    counts_[group_id] += !tuple->GetValue(column_id_).IsNull();
+  }
+
+  type::Value Finalize(uint32_t group_id) const override {
+    return type::ValueFactory::GetBigIntValue(counts_[group_id]);
+  }
+
+ private:
+  const oid_t column_id_;
+  std::vector<int64_t> counts_;
+  std::vector<T> values_;
+};
+
+// SUM(column) and AVG(column)
+template <typename T, bool kAverage>
+class SumAccumulator : public AbstractVectorAccumulator {
+ public:
+  SumAccumulator(oid_t column_id, type::TypeId type_id)
+      : column_id_(column_id), type_id_(type_id) {}
+
+  void Resize(size_t num_groups) override {
+    sums_.resize(num_groups, 0);
+    counts_.resize(num_groups, 0);
+  }
+
+  void Advance(LogicalTile *tile, const std::vector<oid_t> &tuple_ids,
+               const std::vector<uint32_t> &group_ids) override {
+    GatherColumn<T>(tile, column_id_, tuple_ids, values_);
+    for (size_t i = 0; i < values_.size(); i++) {
+      Update(group_ids[i], values_[i]);
+    }
+  }
+
+  void Advance(const AbstractTuple *tuple, uint32_t group_id) override {
+    Update(group_id, GetNativeValue<T>(tuple->GetValue(column_id_)));
+  }
+
+  type::Value Finalize(uint32_t group_id) const override {
+    if (counts_[group_id] == 0) {
+      return type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER);
+    }
+    type::Value sum = MakeValue(type_id_, sums_[group_id]);
+    if (!kAverage) {
+      return sum;
+    }
+    return sum.Divide(type::ValueFactory::GetDecimalValue(
+        static_cast<double>(counts_[group_id])));
+  }
+
+ private:
+  void Update(uint32_t group_id, T value) {
+    if (value == NullValue<T>()) {
+      return;
+    }
+    sums_[group_id] = CheckedAdd(sums_[group_id], value);
+    counts_[group_id]++;
+  }
+
+  const oid_t column_id_;
+  const type::TypeId type_id_;
+  std::vector<typename SumType<T>::type> sums_;
+  std::vector<int64_t> counts_;
+  std::vector<T> values_;
+};
+
+// MIN(column) and MAX(column)
+template <typename T, bool kMax>
+class MinMaxAccumulator : public AbstractVectorAccumulator {
+ public:
+  MinMaxAccumulator(oid_t column_id, type::TypeId type_id)
+      : column_id_(column_id), type_id_(type_id) {}
+
+  void Resize(size_t num_groups) override {
+    extremes_.resize(num_groups, NullValue<T>());
+  }
+
+  void Advance(LogicalTile *tile, const std::vector<oid_t> &tuple_ids,
+               const std::vector<uint32_t> &group_ids) override {
+    GatherColumn<T>(tile, column_id_, tuple_ids, values_);
+    for (size_t i = 0; i < values_.size(); i++) {
+      Update(group_ids[i], values_[i]);
+    }
+  }
+
+  void Advance(const AbstractTuple *tuple, uint32_t group_id) override {
+    Update(group_id, GetNativeValue<T>(tuple->GetValue(column_id_)));
+  }
+
+  type::Value Finalize(uint32_t group_id) const override {
+    if (extremes_[group_id] == NullValue<T>()) {
+      return type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER);
+    }
+    return MakeValue(type_id_, static_cast<typename SumType<T>::type>(
+                                   extremes_[group_id]));
+  }
+
+ private:
+  void Update(uint32_t group_id, T value) {
+    if (value == NullValue<T>()) {
+      return;
+    }
+    T &extreme = extremes_[group_id];
+    if (extreme == NullValue<T>() ||
+        (kMax ? value > extreme : value < extreme)) {
+      extreme = value;
+    }
+  }
+
+  const oid_t column_id_;
+  const type::TypeId type_id_;
+  std::vector<T> extremes_;
+  std::vector<T> values_;
+};
+
+template <typename T>
+AbstractVectorAccumulator *CreateAccumulator(ExpressionType agg_type,
+                                             oid_t column_id,
+                                             type::TypeId type_id) {
+  switch (agg_type) {
+    case ExpressionType::AGGREGATE_COUNT:
+      return new CountAccumulator<T>(column_id);
+    case ExpressionType::AGGREGATE_SUM:
+      return new SumAccumulator<T, false>(column_id, type_id);
+    case ExpressionType::AGGREGATE_AVG:
+      return new SumAccumulator<T, true>(column_id, type_id);
+    case ExpressionType::AGGREGATE_MIN:
+      return new MinMaxAccumulator<T, false>(column_id, type_id);
+    case ExpressionType::AGGREGATE_MAX:
+      return new MinMaxAccumulator<T, true>(column_id, type_id);
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE,
+                      "Unknown aggregate type " + ExpressionTypeToString(agg_type));
+  }
+}
+
+// Sums of timestamps are not supported by type::Value either
+template <>
+AbstractVectorAccumulator *CreateAccumulator<uint64_t>(ExpressionType agg_type,
+                                                       oid_t column_id,
+                                                       type::TypeId type_id) {
+  switch (agg_type) {
+    case ExpressionType::AGGREGATE_COUNT:
+      return new CountAccumulator<uint64_t>(column_id);
+    case ExpressionType::AGGREGATE_MIN:
+      return new MinMaxAccumulator<uint64_t, false>(column_id, type_id);
+    case ExpressionType::AGGREGATE_MAX:
+      return new MinMaxAccumulator<uint64_t, true>(column_id, type_id);
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE,
+                      "Unsupported aggregate over timestamps " +
+                          ExpressionTypeToString(agg_type));
+  }
+}
+
+// Return the input column of an aggregate term, or INVALID_OID if the term
+// is not a plain column reference
+oid_t GetAggregateColumn(const planner::AggregatePlan::AggTerm &agg_term) {
+  auto *expr = agg_term.expression;
+  if (expr == nullptr || expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    return INVALID_OID;
+  }
+  auto *tuple_value =
+      static_cast<const expression::TupleValueExpression *>(expr);
+  if (tuple_value->GetTupleId() != 0) {
+    return INVALID_OID;
+  }
+  return tuple_value->GetColumnId();
+}
+
+}  // namespace
+
+VectorizedAggregator::VectorizedAggregator(const planner::AggregatePlan *node,
+                                           storage::AbstractTable *output_table,
+                                           executor::ExecutorContext *econtext,
+                                           LogicalTile *tile)
+    : AbstractAggregator(node, output_table, econtext),
+      num_input_columns_(tile->GetColumnCount()),
+      slots_(1024, 0) {
+  PELOTON_ASSERT(IsSupported(node, tile));
+
+  input_types_.reserve(num_input_columns_);
+  for (oid_t column_id = 0; column_id < num_input_columns_; column_id++) {
+    input_types_.push_back(GetColumnType(tile, column_id));
+  }
+
+  for (const auto &agg_term : node->GetUniqueAggTerms()) {
+    if (agg_term.aggtype == ExpressionType::AGGREGATE_COUNT_STAR) {
+      accumulators_.emplace_back(new CountStarAccumulator());
+      continue;
+    }
+    oid_t column_id = GetAggregateColumn(agg_term);
+    type::TypeId type_id = GetColumnType(tile, column_id);
+    AbstractVectorAccumulator *accumulator = nullptr;
+    switch (type_id) {
+      case type::TypeId::BOOLEAN:
+        // Only counted, see IsSupported()
+        accumulator = new CountAccumulator<int8_t>(column_id);
+        break;
+      case type::TypeId::TINYINT:
+        accumulator =
+            CreateAccumulator<int8_t>(agg_term.aggtype, column_id, type_id);
+        break;
+      case type::TypeId::SMALLINT:
+        accumulator =
+            CreateAccumulator<int16_t>(agg_term.aggtype, column_id, type_id);
+        break;
+      case type::TypeId::INTEGER:
+        accumulator =
+            CreateAccumulator<int32_t>(agg_term.aggtype, column_id, type_id);
+        break;
+      case type::TypeId::BIGINT:
+        accumulator =
+            CreateAccumulator<int64_t>(agg_term.aggtype, column_id, type_id);
+        break;
+      case type::TypeId::TIMESTAMP:
+        accumulator =
+            CreateAccumulator<uint64_t>(agg_term.aggtype, column_id, type_id);
+        break;
+      case type::TypeId::DECIMAL:
+        accumulator =
+            CreateAccumulator<double>(agg_term.aggtype, column_id, type_id);
+        break;
+      default:
+        throw Exception(ExceptionType::MISMATCH_TYPE,
+                        "Unsupported aggregate column type " +
+                            TypeIdToString(type_id));
+    }
+    accumulators_.emplace_back(accumulator);
+  }
+
+  // Without group-by columns, there is exactly one group, even if there are
+  // no input tuples
+  if (node->GetGroupbyColIds().empty()) {
+    group_hashes_.push_back(0);
+    first_tuple_values_.emplace_back();
+    for (auto &accumulator : accumulators_) {
+      accumulator->Resize(1);
+    }
+  }
+}
+
+bool VectorizedAggregator::IsSupported(const planner::AggregatePlan *node,
+                                       LogicalTile *tile) {
+  for (oid_t column_id : node->GetGroupbyColIds()) {
+    if (column_id >= tile->GetColumnCount() ||
+        (!IsKeyType(GetColumnType(tile, column_id)) &&
+         !IsStringType(GetColumnType(tile, column_id)))) {
+      return false;
+    }
+  }
+
+  for (const auto &agg_term : node->GetUniqueAggTerms()) {
+    if (agg_term.distinct) {
+      return false;
+    }
+    if (agg_term.aggtype == ExpressionType::AGGREGATE_COUNT_STAR) {
+      continue;
+    }
+    oid_t column_id = GetAggregateColumn(agg_term);
+    if (column_id == INVALID_OID || column_id >= tile->GetColumnCount()) {
+      return false;
+    }
+    type::TypeId type_id = GetColumnType(tile, column_id);
+    switch (agg_term.aggtype) {
+      case ExpressionType::AGGREGATE_COUNT:
+        if (!IsKeyType(type_id) && type_id != type::TypeId::DECIMAL) {
+          return false;
+        }
+        break;
+      case ExpressionType::AGGREGATE_SUM:
+      case ExpressionType::AGGREGATE_AVG:
+        if (!IsIntegerType(type_id) && type_id != type::TypeId::DECIMAL) {
+          return false;
+        }
+        break;
+      case ExpressionType::AGGREGATE_MIN:
+      case ExpressionType::AGGREGATE_MAX:
+        if (!IsIntegerType(type_id) && type_id != type::TypeId::DECIMAL &&
+            type_id != type::TypeId::TIMESTAMP) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool VectorizedAggregator::SupportsTile(LogicalTile *tile) const {
+  if (tile->GetColumnCount() != num_input_columns_) {
+    return false;
+  }
+  for (oid_t column_id = 0; column_id < num_input_columns_; column_id++) {
+    if (GetColumnType(tile, column_id) != input_types_[column_id]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool VectorizedAggregator::Advance(AbstractTuple *next_tuple) {
+  const auto &groupby_col_ids = node->GetGroupbyColIds();
+  const size_t num_keys = groupby_col_ids.size();
+
+  uint32_t group_id = 0;
+  if (num_keys > 0) {
+    tile_keys_.resize(num_keys);
+    for (size_t key_idx = 0; key_idx < num_keys; key_idx++) {
+      oid_t column_id = groupby_col_ids[key_idx];
+      tile_keys_[key_idx] = PackKeyValue(next_tuple->GetValue(column_id),
+                                         input_types_[column_id]);
+    }
+    group_id = FindOrCreateGroup(tile_keys_.data(),
+                                 HashKey(tile_keys_.data(), num_keys),
+                                 next_tuple);
+  }
+
+  for (auto &accumulator : accumulators_) {
+    accumulator->Resize(group_hashes_.size());
+    accumulator->Advance(next_tuple, group_id);
+  }
+  return true;
+}
+
+bool VectorizedAggregator::AdvanceTile(LogicalTile *tile) {
+  // The accumulators read the columns straight from the base tiles, which
+  // only works if they have the types we're specialized on
+  if (!SupportsTile(tile)) {
+    return AbstractAggregator::AdvanceTile(tile);
+  }
+
+  tuple_ids_.clear();
+  for (oid_t tuple_id : *tile) {
+    tuple_ids_.push_back(tuple_id);
+  }
+  const size_t num_tuples = tuple_ids_.size();
+  if (num_tuples == 0) {
+    return true;
+  }
+
+  // 1) Pack the group-by keys of all tuples, one column at a time
+  const auto &groupby_col_ids = node->GetGroupbyColIds();
+  const size_t num_keys = groupby_col_ids.size();
+  tile_keys_.resize(num_tuples * num_keys);
+  for (size_t key_idx = 0; key_idx < num_keys; key_idx++) {
+    if (IsStringType(GetColumnType(tile, groupby_col_ids[key_idx]))) {
+      PackStringKeyColumn(tile, groupby_col_ids[key_idx], key_idx, num_keys);
+    } else {
+      PackKeyColumn(tile, groupby_col_ids[key_idx], tuple_ids_, key_idx,
+                    num_keys, tile_keys_);
+    }
+  }
+  tile_hashes_.resize(num_tuples);
+  for (size_t i = 0; i < num_tuples; i++) {
+    tile_hashes_[i] = HashKey(tile_keys_.data() + i * num_keys, num_keys);
+  }
+
+  // 2) Map every tuple to its group
+  group_ids_.resize(num_tuples);
+  for (size_t i = 0; i < num_tuples; i++) {
+    if (num_keys == 0) {
+      group_ids_[i] = 0;
+      continue;
+    }
+    ContainerTuple<LogicalTile> tuple(tile, tuple_ids_[i]);
+    group_ids_[i] = FindOrCreateGroup(tile_keys_.data() + i * num_keys,
+                                      tile_hashes_[i], &tuple);
+  }
+
+  // 3) Advance the aggregates, one column at a time
+  for (auto &accumulator : accumulators_) {
+    accumulator->Resize(group_hashes_.size());
+    accumulator->Advance(tile, tuple_ids_, group_ids_);
+  }
+  return true;
+}
+
+uint32_t VectorizedAggregator::FindOrCreateGroup(const int64_t *key,
+                                                 uint64_t hash,
+                                                 const AbstractTuple *tuple) {
+  const size_t num_keys = node->GetGroupbyColIds().size();
+  const size_t mask = slots_.size() - 1;
+
+  size_t slot = hash & mask;
+  for (; slots_[slot] != 0; slot = (slot + 1) & mask) {
+    uint32_t group_id = slots_[slot] - 1;
+    if (group_hashes_[group_id] == hash &&
+        std::memcmp(&group_keys_[group_id * num_keys], key,
+                    num_keys * sizeof(int64_t)) == 0) {
+      return group_id;
+    }
+  }
+
+  // Group not found. Make a new one.
+  auto group_id = static_cast<uint32_t>(group_hashes_.size());
+  group_hashes_.push_back(hash);
+  group_keys_.insert(group_keys_.end(), key, key + num_keys);
+
+  // Make a deep copy of the first tuple we meet
+  first_tuple_values_.emplace_back();
+  auto &first_tuple_values = first_tuple_values_.back();
+  first_tuple_values.reserve(num_input_columns_);
+  for (oid_t col_id = 0; col_id < num_input_columns_; col_id++) {
+    first_tuple_values.push_back(tuple->GetValue(col_id));
+  }
+
+  slots_[slot] = group_id + 1;
+  if (group_hashes_.size() * 2 > slots_.size()) {
+    Grow();
+  }
+  return group_id;
+}
+
+void VectorizedAggregator::PackStringKeyColumn(LogicalTile *tile,
+                                               oid_t column_id, size_t key_idx,
+                                               size_t num_keys) {
+  const auto &column_info = tile->GetColumnInfo(column_id);
+  const auto &positions =
+      tile->GetPositionLists()[column_info.position_list_idx];
+  const auto *base_tile = column_info.base_tile.get();
+  const oid_t origin_column_id = column_info.origin_column_id;
+  const size_t offset = base_tile->GetSchema()->GetOffset(origin_column_id);
+
+  // The codes of a frozen tile are mapped to IDs as they are met
+  const auto *compressed_tile =
+      base_tile->IsCompressed()
+          ? static_cast<const storage::CompressedTile *>(base_tile)
+          : nullptr;
+  if (compressed_tile != nullptr) {
+    code_ids_.assign(compressed_tile->GetDictionarySize(origin_column_id),
+                     kUnmappedCode);
+  }
+
+  for (size_t i = 0; i < tuple_ids_.size(); i++) {
+    oid_t position = positions[tuple_ids_[i]];
+    int64_t &key = tile_keys_[i * num_keys + key_idx];
+    if (position == NULL_OID) {
+      key = NullValue<int64_t>();
+    } else if (compressed_tile != nullptr) {
+      uint32_t code = compressed_tile->GetCode(origin_column_id, position);
+      if (code_ids_[code] == kUnmappedCode) {
+        code_ids_[code] = GetStringId(
+            compressed_tile->GetDictionaryEntry(origin_column_id, code));
+      }
+      key = code_ids_[code];
+    } else {
+      key = GetStringId(*reinterpret_cast<const type::VarlenSlot *>(
+          base_tile->GetTupleLocation(position) + offset));
+    }
+  }
+}
+
+int64_t VectorizedAggregator::PackKeyValue(const type::Value &value,
+                                           type::TypeId type_id) {
+  // Must match the keys PackKeyColumn() and PackStringKeyColumn() produce
+  switch (type_id) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+      return GetNativeValue<int8_t>(value);
+    case type::TypeId::SMALLINT:
+      return GetNativeValue<int16_t>(value);
+    case type::TypeId::INTEGER:
+      return GetNativeValue<int32_t>(value);
+    case type::TypeId::BIGINT:
+      return GetNativeValue<int64_t>(value);
+    case type::TypeId::TIMESTAMP:
+      return static_cast<int64_t>(GetNativeValue<uint64_t>(value));
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY:
+      if (value.IsNull()) {
+        return NullValue<int64_t>();
+      }
+      return GetStringId(value.GetData(), value.GetLength());
+    default:
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      "Unsupported group-by column type");
+  }
+}
+
+int64_t VectorizedAggregator::GetStringId(const type::VarlenSlot &slot) {
+  if (slot.IsNull()) {
+    return NullValue<int64_t>();
+  }
+  return GetStringId(slot.GetData(), slot.length);
+}
+
+int64_t VectorizedAggregator::GetStringId(const char *data, uint32_t length) {
+  // IDs count up from 0, so they never collide with the NULL sentinel
+  int64_t next_id = string_ids_.size();
+  return string_ids_.emplace(std::string{data, length}, next_id).first->second;
+}
+
+void VectorizedAggregator::Grow() {
+  slots_.assign(slots_.size() * 2, 0);
+  const size_t mask = slots_.size() - 1;
+  for (uint32_t group_id = 0; group_id < group_hashes_.size(); group_id++) {
+    size_t slot = group_hashes_[group_id] & mask;
+    while (slots_[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = group_id + 1;
+  }
+}
+
+bool VectorizedAggregator::Finalize() {
+  const bool has_groupby = !node->GetGroupbyColIds().empty();
+  std::vector<type::Value> aggregate_values;
+  for (uint32_t group_id = 0; group_id < group_hashes_.size(); group_id++) {
+    aggregate_values.clear();
+    for (const auto &accumulator : accumulators_) {
+      aggregate_values.push_back(accumulator->Finalize(group_id));
+    }
+
+    // Like the PlainAggregator, there is no delegate tuple without group-by
+    ContainerTuple<std::vector<type::Value>> first_tuple(
+        &first_tuple_values_[group_id]);
+    if (!InsertGroup(node, aggregate_values, output_table,
+                     has_groupby ? &first_tuple : nullptr,
+                     this->executor_context)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Sort Aggregator
 //===--------------------------------------------------------------------===//
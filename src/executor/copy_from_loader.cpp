@@ -0,0 +1,379 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// copy_from_loader.cpp
+//
+// Identification: src/executor/copy_from_loader.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/copy_from_loader.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "common/exception.h"
+#include "concurrency/transaction_context.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "function/date_functions.h"
+#include "function/numeric_functions.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+#include "type/varlen_slot.h"
+#include "util/string_util.h"
+
+namespace peloton {
+namespace executor {
+
+CopyFromLoader::CopyFromLoader(storage::DataTable *table,
+                               concurrency::TransactionContext *txn,
+                               char delimiter, char quote, char escape,
+                               bool bulk_load, ExternalFileFormat format)
+    : table_(table),
+      txn_(txn),
+      delimiter_(delimiter),
+      bulk_load_(bulk_load && table->LockForBulkLoad(txn)),
+      num_rows_loaded_(0) {
+  const auto *schema = table_->GetSchema();
+  const auto num_cols = schema->GetColumnCount();
+
+  col_types_.reserve(num_cols);
+  col_offsets_.reserve(num_cols);
+  null_values_.reserve(num_cols);
+  for (oid_t col_idx = 0; col_idx < num_cols; col_idx++) {
+    const auto &column = schema->GetColumn(col_idx);
+    col_types_.emplace_back(column.GetType(), !column.IsNotNull());
+    col_offsets_.push_back(static_cast<uint32_t>(column.GetOffset()));
+    null_values_.push_back(
+        type::ValueFactory::GetNullValueByType(column.GetType()));
+  }
+
+  if (format == ExternalFileFormat::TEXT) {
+    for (const auto &col_type : col_types_) {
+      text_cols_.push_back(
+          codegen::util::CSVScanner::Column{col_type, nullptr, 0, false});
+    }
+  } else {
+    scanner_.reset(new codegen::util::CSVScanner(
+        pool_, "", col_types_.data(), static_cast<uint32_t>(num_cols),
+        LoadRowCallback, this, delimiter, quote, escape));
+  }
+}
+
+CopyFromLoader::~CopyFromLoader() {
+  // The scanner allocates from our pool, tear it down first. The bulk load
+  // lock is released by the transaction when it commits or aborts.
+  scanner_.reset();
+}
+
+void CopyFromLoader::Consume(const char *data, uint32_t len) {
+  if (scanner_ != nullptr) {
+    scanner_->Feed(data, len);
+    return;
+  }
+
+  // Text format can't quote new-lines, so every one of them ends a line
+  const char *end = data + len;
+  while (data < end) {
+    const auto *nl = static_cast<const char *>(memchr(data, '\n', end - data));
+    if (nl == nullptr) {
+      text_line_.append(data, end - data);
+      break;
+    }
+    text_line_.append(data, nl - data);
+    LoadTextLine();
+    data = nl + 1;
+  }
+}
+
+void CopyFromLoader::Finish() {
+  if (scanner_ != nullptr) {
+    scanner_->Finish();
+  } else if (!text_line_.empty()) {
+    LoadTextLine();
+  }
+
+  if (!bulk_load_ || tile_groups_.empty()) {
+    return;
+  }
+  if (!table_->BulkLoad(tile_groups_, txn_)) {
+    throw ConstraintException(StringUtil::Format(
+        "COPY into table '%s' violates a unique or foreign key constraint",
+        table_->GetName().c_str()));
+  }
+  tile_groups_.clear();
+}
+
+uint64_t CopyFromLoader::GetNumRowsLoaded() const { return num_rows_loaded_; }
+
+void CopyFromLoader::LoadRowCallback(void *loader) {
+  auto *copy_loader = static_cast<CopyFromLoader *>(loader);
+  copy_loader->LoadRow(copy_loader->scanner_->GetColumns());
+}
+
+void CopyFromLoader::LoadTextLine() {
+  char *line = &text_line_[0];
+  auto len = static_cast<uint32_t>(text_line_.size());
+
+  // Tolerate CRLF line endings, and skip the end-of-data marker
+  if (len > 0 && line[len - 1] == '\r') {
+    len--;
+  }
+  if (len == 2 && line[0] == '\\' && line[1] == '.') {
+    text_line_.clear();
+    return;
+  }
+
+  // Split the line into its attributes, unescaping them in place. The
+  // unescaped attribute is never longer than its raw representation.
+  uint32_t pos = 0;
+  for (uint32_t col_idx = 0; col_idx < text_cols_.size(); col_idx++) {
+    if (pos > len) {
+      throw Exception(StringUtil::Format(
+          "missing data for column %u on line %lu", col_idx + 1,
+          num_rows_loaded_ + 1));
+    }
+    // NULL is the raw "\N", which must be seen before unescaping overwrites it
+    bool is_null = (pos + 1 < len && line[pos] == '\\' &&
+                    line[pos + 1] == 'N' &&
+                    (pos + 2 == len || line[pos + 2] == delimiter_));
+    uint32_t raw_begin = pos;
+    char *out = line + pos;
+    while (pos < len && line[pos] != delimiter_) {
+      char c = line[pos++];
+      if (c == '\\' && pos < len) {
+        c = line[pos++];
+        switch (c) {
+          case 'b':
+            c = '\b';
+            break;
+          case 'f':
+            c = '\f';
+            break;
+          case 'n':
+            c = '\n';
+            break;
+          case 'r':
+            c = '\r';
+            break;
+          case 't':
+            c = '\t';
+            break;
+          case 'v':
+            c = '\v';
+            break;
+          case 'x': {
+            // Up to two hex digits, a lone 'x' stands for itself
+            int val = 0, num_digits = 0;
+            while (num_digits < 2 && pos < len &&
+                   isxdigit(static_cast<unsigned char>(line[pos]))) {
+              char d = line[pos++];
+              val = (val << 4) +
+                    (isdigit(d) ? d - '0' : (tolower(d) - 'a') + 10);
+              num_digits++;
+            }
+            if (num_digits > 0) c = static_cast<char>(val);
+            break;
+          }
+          default: {
+            // Up to three octal digits, anything else stands for itself
+            if (c >= '0' && c <= '7') {
+              int val = c - '0', num_digits = 1;
+              while (num_digits < 3 && pos < len && line[pos] >= '0' &&
+                     line[pos] <= '7') {
+                val = (val << 3) + (line[pos++] - '0');
+                num_digits++;
+              }
+              c = static_cast<char>(val);
+            }
+            break;
+          }
+        }
+      }
+      *out++ = c;
+    }
+
+    auto &col = text_cols_[col_idx];
+    col.ptr = line + raw_begin;
+    col.len = static_cast<uint32_t>(out - col.ptr);
+    col.is_null = is_null;
+
+    // Eat the delimiter
+    pos++;
+  }
+  if (pos <= len) {
+    throw Exception(
+        StringUtil::Format("extra data after last expected column on line %lu",
+                           num_rows_loaded_ + 1));
+  }
+
+  LoadRow(text_cols_.data());
+  text_line_.clear();
+}
+
+void CopyFromLoader::LoadRow(const codegen::util::CSVScanner::Column *cols) {
+  // Claim a slot
+  ItemPointer location;
+  std::shared_ptr<storage::TileGroup> tile_group;
+  if (bulk_load_) {
+    location = GetBulkLoadSlot();
+    tile_group = tile_groups_.back();
+  } else {
+    location = table_->GetEmptyTupleSlot(nullptr);
+    tile_group = table_->GetTileGroupById(location.block);
+  }
+
+  // Like the compiled inserter, we write the attributes straight into the
+  // slot if the whole tuple lives in the first tile of the tile group. Any
+  // other layout gets the tuple copied into it, as the regular insert path
+  // does.
+  if (tile_group->GetLayout().IsRowStore()) {
+    auto *tile = tile_group->GetTile(0);
+    WriteRow(cols, tile->GetTupleLocation(location.offset), *tile->GetPool());
+  } else {
+    if (scratch_tuple_ == nullptr) {
+      scratch_tuple_.reset(new storage::Tuple(table_->GetSchema(), true));
+    }
+    WriteRow(cols, scratch_tuple_->GetData(), pool_);
+    tile_group->CopyTuple(scratch_tuple_.get(), location.offset);
+    FreeVarlenAreas(scratch_tuple_->GetData());
+  }
+
+  // Constraints and indexes are taken care of when the tile groups are
+  // published in Finish()
+  if (bulk_load_) {
+    num_rows_loaded_++;
+    return;
+  }
+
+  // Install the tuple into the indexes and register it with the transaction
+  ContainerTuple<storage::TileGroup> tuple(tile_group.get(), location.offset);
+  ItemPointer *index_entry_ptr = nullptr;
+  if (!table_->InsertTuple(&tuple, location, txn_, &index_entry_ptr)) {
+    throw ConstraintException(StringUtil::Format(
+        "COPY row %lu of table '%s' violates a unique or foreign key "
+        "constraint",
+        num_rows_loaded_ + 1, table_->GetName().c_str()));
+  }
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.PerformInsert(txn_, location, index_entry_ptr);
+
+  num_rows_loaded_++;
+}
+
+void CopyFromLoader::WriteRow(const codegen::util::CSVScanner::Column *cols,
+                              char *storage, type::AbstractPool &pool) {
+  for (uint32_t col_idx = 0; col_idx < col_types_.size(); col_idx++) {
+    char *attr = storage + col_offsets_[col_idx];
+    if (cols[col_idx].is_null) {
+      null_values_[col_idx].SerializeTo(attr, false, &pool);
+    } else {
+      WriteAttribute(col_idx, cols[col_idx].ptr, cols[col_idx].len, attr,
+                     pool);
+    }
+  }
+}
+
+void CopyFromLoader::FreeVarlenAreas(char *storage) {
+  const auto *schema = table_->GetSchema();
+  for (uint32_t col_idx = 0; col_idx < col_types_.size(); col_idx++) {
+    if (schema->IsInlined(col_idx)) {
+      continue;
+    }
+    auto *slot =
+        reinterpret_cast<type::VarlenSlot *>(storage + col_offsets_[col_idx]);
+    char *area = slot->GetArea();
+    if (area != nullptr) {
+      pool_.Free(area);
+    }
+  }
+}
+
+ItemPointer CopyFromLoader::GetBulkLoadSlot() {
+  oid_t tuple_slot = INVALID_OID;
+  if (!tile_groups_.empty()) {
+    tuple_slot = tile_groups_.back()->InsertTuple(nullptr);
+  }
+  if (tuple_slot == INVALID_OID) {
+    tile_groups_.emplace_back(
+        table_->GetTileGroupWithLayout(table_->GetDefaultLayout()));
+    tuple_slot = tile_groups_.back()->InsertTuple(nullptr);
+  }
+  return ItemPointer(tile_groups_.back()->GetTileGroupId(), tuple_slot);
+}
+
+void CopyFromLoader::WriteAttribute(uint32_t col_idx, const char *ptr,
+                                    uint32_t len, char *storage,
+                                    type::AbstractPool &pool) const {
+  const auto &col_type = col_types_[col_idx];
+  switch (col_type.type_id) {
+    case type::TypeId::BOOLEAN: {
+      *reinterpret_cast<int8_t *>(storage) =
+          function::NumericFunctions::InputBoolean(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::TINYINT: {
+      *reinterpret_cast<int8_t *>(storage) =
+          function::NumericFunctions::InputTinyInt(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::SMALLINT: {
+      *reinterpret_cast<int16_t *>(storage) =
+          function::NumericFunctions::InputSmallInt(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::INTEGER: {
+      *reinterpret_cast<int32_t *>(storage) =
+          function::NumericFunctions::InputInteger(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::BIGINT: {
+      *reinterpret_cast<int64_t *>(storage) =
+          function::NumericFunctions::InputBigInt(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::DECIMAL: {
+      *reinterpret_cast<double *>(storage) =
+          function::NumericFunctions::InputDecimal(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::DATE: {
+      *reinterpret_cast<int32_t *>(storage) =
+          function::DateFunctions::InputDate(col_type, ptr, len);
+      break;
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      // Varlens are stored in a varlen slot, long ones in a length-prefixed
+      // area allocated from the tile's pool. VARCHARs also store their
+      // null-terminator.
+      bool is_varchar = (col_type.type_id == type::TypeId::VARCHAR);
+      uint32_t stored_len = (is_varchar ? len + 1 : len);
+      char *data = type::VarlenSlot::Reserve(storage, stored_len, &pool);
+      PELOTON_MEMCPY(data, ptr, len);
+      if (is_varchar) {
+        data[len] = '\0';
+      }
+      type::VarlenSlot::CopyPrefix(storage);
+      break;
+    }
+    default: {
+      // No dedicated input function (e.g., TIMESTAMP), go through a cast
+      auto str_val =
+          type::ValueFactory::GetVarcharValue(std::string(ptr, len), nullptr);
+      str_val.CastAs(col_type.type_id).SerializeTo(storage, false, &pool);
+      break;
+    }
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -135,6 +135,15 @@ bool HashJoinExecutor::DExecute() {
 
         RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
 
+        // SEMI and ANTI joins produce the right (outer) rows once all left
+        // rows are probed
+        if (join_type_ == JoinType::SEMI || join_type_ == JoinType::ANTI) {
+          for (auto &location : right_tuples->second) {
+            RecordMatchedRightRow(location.first, location.second);
+          }
+          continue;
+        }
+
         // Go over the matching right tuples
         for (auto &location : right_tuples->second) {
           // Check if we got a new right tile itr
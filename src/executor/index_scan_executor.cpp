@@ -217,6 +217,11 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
     auto tile_group = storage_manager->GetTileGroup(tuple_location.block);
+    // the tile group of a version may have been retired (e.g., by compaction),
+    // in which case the version is invisible to every running transaction.
+    if (tile_group == nullptr) {
+      continue;
+    }
     auto tile_group_header = tile_group.get()->GetHeader();
     size_t chain_length = 0;
 
@@ -294,6 +299,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
               *(tile_group_header->GetIndirection(tuple_location.offset));
           auto storage_manager = storage::StorageManager::GetInstance();
           tile_group = storage_manager->GetTileGroup(tuple_location.block);
+          if (tile_group == nullptr) {
+            // retired along with its tile group, so invisible to us.
+            break;
+          }
           tile_group_header = tile_group.get()->GetHeader();
           chain_length = 0;
           continue;
@@ -320,6 +329,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         // search for next version.
         auto storage_manager = storage::StorageManager::GetInstance();
         tile_group = storage_manager->GetTileGroup(tuple_location.block);
+        if (tile_group == nullptr) {
+          // retired along with its tile group, so invisible to us.
+          break;
+        }
         tile_group_header = tile_group.get()->GetHeader();
         continue;
       }
@@ -464,6 +477,12 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     ItemPointer tuple_location = *tuple_location_ptr;
     if (tuple_location.block != last_block) {
       tile_group = storage_manager->GetTileGroup(tuple_location.block);
+      // the tile group of a version may have been retired (e.g., by
+      // compaction), in which case the version is invisible to every running
+      // transaction.
+      if (tile_group == nullptr) {
+        continue;
+      }
       tile_group_header = tile_group.get()->GetHeader();
     }
 #ifdef LOG_TRACE_ENABLED
@@ -565,6 +584,10 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
           tile_group = storage_manager->GetTileGroup(tuple_location.block);
+          if (tile_group == nullptr) {
+            // retired along with its tile group, so invisible to us.
+            break;
+          }
           tile_group_header = tile_group.get()->GetHeader();
           chain_length = 0;
           continue;
@@ -594,6 +617,10 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
         // search for next version.
         tile_group = storage_manager->GetTileGroup(tuple_location.block);
+        if (tile_group == nullptr) {
+          // retired along with its tile group, so invisible to us.
+          break;
+        }
         tile_group_header = tile_group.get()->GetHeader();
       }
     }
@@ -24,7 +24,9 @@
 #include "expression/comparison_expression.h"
 #include "common/container_tuple.h"
 #include "planner/create_plan.h"
+#include "storage/compressed_tile.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -33,6 +35,33 @@
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// Find the only column of the scanned tuple the expression reads. Returns
+// false if it reads no column, or more than one.
+bool GetOnlyColumn(const expression::AbstractExpression *expr,
+                   oid_t &column_id) {
+  if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    auto *tuple_value =
+        static_cast<const expression::TupleValueExpression *>(expr);
+    oid_t expr_column_id = tuple_value->GetColumnId();
+    if (tuple_value->GetTupleId() != 0 ||
+        (column_id != INVALID_OID && column_id != expr_column_id)) {
+      return false;
+    }
+    column_id = expr_column_id;
+    return true;
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    if (!GetOnlyColumn(expr->GetChild(i), column_id)) {
+      return false;
+    }
+  }
+  return column_id != INVALID_OID;
+}
+
+}  // namespace
+
 /**
  * @brief Constructor for seqscan executor.
  * @param node Seqscan node corresponding to this executor.
@@ -154,10 +183,48 @@ bool SeqScanExecutor::DExecute() {
     while (current_tile_group_offset_ < table_tile_group_count_) {
       auto tile_group =
           target_table_->GetTileGroup(current_tile_group_offset_++);
+      // Skip tile groups that were retired by compaction
+      if (tile_group == nullptr) {
+        continue;
+      }
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+      // If the predicate only reads a dictionary-encoded column of a frozen
+      // tile group, evaluate it once per distinct value and look the result
+      // up by code for every tuple. This is only correct for predicates that
+      // give the same result every time they see the same value.
+      const storage::CompressedTile *dictionary_tile = nullptr;
+      oid_t dictionary_column_id = INVALID_OID;
+      std::vector<bool> code_results;
+      oid_t predicate_column_id = INVALID_OID;
+      if (predicate_ != nullptr && tile_group->IsFrozen() &&
+          predicate_->IsDeterministic() &&
+          GetOnlyColumn(predicate_, predicate_column_id)) {
+        oid_t tile_id, tile_column_id;
+        tile_group->GetLayout().LocateTileAndColumn(predicate_column_id,
+                                                    tile_id, tile_column_id);
+        auto *tile = static_cast<const storage::CompressedTile *>(
+            tile_group->GetTile(tile_id));
+        if (tile->IsDictionaryEncoded(tile_column_id) &&
+            tile->GetDictionarySize(tile_column_id) < active_tuple_count) {
+          dictionary_tile = tile;
+          dictionary_column_id = tile_column_id;
+          std::vector<type::Value> values(
+              target_table_->GetSchema()->GetColumnCount());
+          ContainerTuple<std::vector<type::Value>> tuple(&values);
+          for (uint32_t code = 0;
+               code < tile->GetDictionarySize(tile_column_id); code++) {
+            values[predicate_column_id] =
+                tile->GetDictionaryValue(tile_column_id, code);
+            code_results.push_back(
+                predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                    .IsTrue());
+          }
+        }
+      }
+
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
@@ -182,13 +249,20 @@ bool SeqScanExecutor::DExecute() {
               return res;
             }
           } else {
-            ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                     tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval =
-                predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
+            bool is_true;
+            if (dictionary_tile != nullptr) {
+              is_true = code_results[dictionary_tile->GetCode(
+                  dictionary_column_id, tuple_id)];
+            } else {
+              ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                       tuple_id);
+              LOG_TRACE("Evaluate predicate for a tuple");
+              auto eval =
+                  predicate_->Evaluate(&tuple, nullptr, executor_context_);
+              LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
+              is_true = eval.IsTrue();
+            }
+            if (is_true) {
               position_list.push_back(tuple_id);
               auto res = transaction_manager.PerformRead(current_txn,
                                                          location,
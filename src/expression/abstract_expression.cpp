@@ -157,9 +157,13 @@ hash_t AbstractExpression::HashForExactMatch() const {
   return hash;
 }
 
-bool AbstractExpression::IsZoneMappable() {
-  bool is_zone_mappable =
-      ExpressionUtil::GetPredicateForZoneMap(parsed_predicates, this);
+bool AbstractExpression::IsZoneMappable(
+    const codegen::QueryParametersMap *parameters_map) {
+  // The parsed predicates stay around for every scan that fills its predicate
+  // array from them, until the expression is parsed again
+  parsed_predicates.clear();
+  bool is_zone_mappable = ExpressionUtil::GetPredicateForZoneMap(
+      parsed_predicates, this, parameters_map);
   return is_zone_mappable;
 }
 
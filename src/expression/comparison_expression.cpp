@@ -27,6 +27,9 @@ type::Value ComparisonExpression::Evaluate(
     executor::ExecutorContext *context) const {
   PELOTON_ASSERT(children_.size() == 2);
   auto vl = children_[0]->Evaluate(tuple1, tuple2, context);
+  if (exp_type_ == ExpressionType::COMPARE_IN) {
+    return EvaluateInList(vl, tuple1, tuple2, context);
+  }
   auto vr = children_[1]->Evaluate(tuple1, tuple2, context);
   switch (exp_type_) {
     case (ExpressionType::COMPARE_EQUAL):
@@ -55,6 +58,32 @@ type::Value ComparisonExpression::Evaluate(
   }
 }
 
+type::Value ComparisonExpression::EvaluateInList(
+    const type::Value &needle, const AbstractTuple *tuple1,
+    const AbstractTuple *tuple2, executor::ExecutorContext *context) const {
+  const auto *list = children_[1].get();
+  if (list->GetExpressionType() != ExpressionType::VALUE_VECTOR) {
+    throw Exception("IN is only supported over a list of values");
+  }
+
+  // As in SQL, the result is true if the value matches any list element. If
+  // it does not, the result is NULL if the value or any element is NULL.
+  bool has_null = needle.IsNull();
+  for (uint32_t i = 0; i < list->GetChildrenSize(); i++) {
+    auto element = list->GetChild(i)->Evaluate(tuple1, tuple2, context);
+    if (element.IsNull()) {
+      has_null = true;
+    } else if (!needle.IsNull() &&
+               needle.CompareEquals(element) == CmpBool::CmpTrue) {
+      return type::ValueFactory::GetBooleanValue(true);
+    }
+  }
+  if (has_null) {
+    return type::ValueFactory::GetBooleanValue(type::PELOTON_BOOLEAN_NULL);
+  }
+  return type::ValueFactory::GetBooleanValue(false);
+}
+
 AbstractExpression *ComparisonExpression::Copy() const {
   return new ComparisonExpression(GetExpressionType(), GetChild(0)->Copy(),
                                   GetChild(1)->Copy());
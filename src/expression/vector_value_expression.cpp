@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_value_expression.cpp
+//
+// Identification: src/expression/vector_value_expression.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/vector_value_expression.h"
+
+#include <sstream>
+
+#include "common/exception.h"
+#include "util/string_util.h"
+
+namespace peloton {
+namespace expression {
+
+type::Value VectorValueExpression::Evaluate(
+    UNUSED_ATTRIBUTE const AbstractTuple *tuple1,
+    UNUSED_ATTRIBUTE const AbstractTuple *tuple2,
+    UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+  throw Exception("A value vector can only be evaluated by its parent");
+}
+
+const std::string VectorValueExpression::GetInfo(int num_indent) const {
+  std::ostringstream os;
+
+  os << StringUtil::Indent(num_indent) << "-[Expression :: "
+     << "Vector]\n"
+     << StringUtil::Indent(num_indent + 1)
+     << "number of values = " << children_.size() << "\n";
+
+  for (const auto &child : children_) {
+    os << child.get()->GetInfo(num_indent + 2);
+  }
+
+  return os.str();
+}
+
+const std::string VectorValueExpression::GetInfo() const {
+  std::ostringstream os;
+  os << GetInfo(0);
+
+  return os.str();
+}
+
+}  // namespace expression
+}  // namespace peloton
@@ -0,0 +1,247 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_pattern.cpp
+//
+// Identification: src/function/like_pattern.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "function/like_pattern.h"
+
+#include <cstring>
+
+#include "common/platform.h"
+
+namespace peloton {
+namespace function {
+
+namespace {
+
+inline bool IsUpper(char c) { return c >= 'A' && c <= 'Z'; }
+
+inline bool IsLower(char c) { return c >= 'a' && c <= 'z'; }
+
+inline char ToLower(char c) { return IsUpper(c) ? c + ('a' - 'A') : c; }
+
+inline char ToUpper(char c) { return IsLower(c) ? c - ('a' - 'A') : c; }
+
+}  // namespace
+
+void LikePattern::Compile(const char *pattern, uint32_t length) {
+  never_matches_ = false;
+  leading_wildcard_ = false;
+  trailing_wildcard_ = false;
+  caseless_ = true;
+  bytes_.clear();
+  any_.clear();
+  segments_.clear();
+
+  if (length > 0 && pattern[length - 1] == '\0') {
+    length--;
+  }
+
+  bool in_segment = false, has_any = false;
+  for (uint32_t i = 0; i < length; i++) {
+    char c = pattern[i];
+    if (c == '%') {
+      leading_wildcard_ |= (i == 0);
+      trailing_wildcard_ |= (i == length - 1);
+      in_segment = false;
+      continue;
+    }
+
+    bool any = false;
+    if (c == '\\') {
+      if (++i == length) {
+        never_matches_ = true;
+        break;
+      }
+      c = pattern[i];
+    } else if (c == '_') {
+      any = true;
+    }
+
+    if (!in_segment) {
+      segments_.push_back(
+          Segment{static_cast<uint32_t>(bytes_.size()), 0, false});
+      in_segment = true;
+    }
+    caseless_ &= (any || (!IsUpper(c) && !IsLower(c)));
+    bytes_.push_back(any ? '_' : ToLower(c));
+    any_.push_back(any);
+    segments_.back().length++;
+    segments_.back().has_any |= any;
+    has_any |= any;
+  }
+
+  // Classify the pattern
+  if (segments_.size() > 1 || has_any) {
+    kind_ = Kind::GENERAL;
+  } else if (!leading_wildcard_ && !trailing_wildcard_) {
+    kind_ = Kind::EXACT;
+  } else if (!leading_wildcard_) {
+    kind_ = Kind::PREFIX;
+  } else if (!trailing_wildcard_) {
+    kind_ = Kind::SUFFIX;
+  } else {
+    kind_ = Kind::CONTAINS;
+  }
+}
+
+bool LikePattern::MatchAt(const Segment &segment, const char *str) const {
+  const char *bytes = bytes_.data() + segment.offset;
+  if (caseless_ && !segment.has_any) {
+    return std::memcmp(str, bytes, segment.length) == 0;
+  }
+  for (uint32_t i = 0; i < segment.length; i++) {
+    if (ToLower(str[i]) != bytes[i] && !any_[segment.offset + i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t LikePattern::Find(const Segment &segment, const char *str,
+                           uint32_t begin, uint32_t end) const {
+  const uint32_t length = segment.length;
+  if (end < begin || end - begin < length) {
+    return end;
+  }
+  const uint32_t last_start = end - length;
+  uint32_t pos = begin;
+
+  // Only positions where both the first and the last byte of the segment
+  // match are candidates, which we find a whole block of positions at a time
+  const char *bytes = bytes_.data() + segment.offset;
+  if (!any_[segment.offset] && !any_[segment.offset + length - 1]) {
+    const char first = bytes[0], last = bytes[length - 1];
+#if defined(__AVX2__)
+    const __m256i first_lower = _mm256_set1_epi8(first);
+    const __m256i first_upper = _mm256_set1_epi8(ToUpper(first));
+    const __m256i last_lower = _mm256_set1_epi8(last);
+    const __m256i last_upper = _mm256_set1_epi8(ToUpper(last));
+    for (; pos + 32 <= last_start + 1; pos += 32) {
+      const __m256i block_first = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(str + pos));
+      const __m256i block_last = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(str + pos + length - 1));
+      const __m256i eq_first =
+          _mm256_or_si256(_mm256_cmpeq_epi8(block_first, first_lower),
+                          _mm256_cmpeq_epi8(block_first, first_upper));
+      const __m256i eq_last =
+          _mm256_or_si256(_mm256_cmpeq_epi8(block_last, last_lower),
+                          _mm256_cmpeq_epi8(block_last, last_upper));
+      uint32_t mask = static_cast<uint32_t>(
+          _mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)));
+      for (; mask != 0; mask &= mask - 1) {
+        uint32_t candidate = pos + __builtin_ctz(mask);
+        if (MatchAt(segment, str + candidate)) {
+          return candidate;
+        }
+      }
+    }
+#elif defined(__SSE2__)
+    const __m128i first_lower = _mm_set1_epi8(first);
+    const __m128i first_upper = _mm_set1_epi8(ToUpper(first));
+    const __m128i last_lower = _mm_set1_epi8(last);
+    const __m128i last_upper = _mm_set1_epi8(ToUpper(last));
+    for (; pos + 16 <= last_start + 1; pos += 16) {
+      const __m128i block_first =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + pos));
+      const __m128i block_last = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(str + pos + length - 1));
+      const __m128i eq_first =
+          _mm_or_si128(_mm_cmpeq_epi8(block_first, first_lower),
+                       _mm_cmpeq_epi8(block_first, first_upper));
+      const __m128i eq_last =
+          _mm_or_si128(_mm_cmpeq_epi8(block_last, last_lower),
+                       _mm_cmpeq_epi8(block_last, last_upper));
+      uint32_t mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+      for (; mask != 0; mask &= mask - 1) {
+        uint32_t candidate = pos + __builtin_ctz(mask);
+        if (MatchAt(segment, str + candidate)) {
+          return candidate;
+        }
+      }
+    }
+#endif
+  }
+
+  // The remaining positions, one at a time
+  for (; pos <= last_start; pos++) {
+    if (MatchAt(segment, str + pos)) {
+      return pos;
+    }
+  }
+  return end;
+}
+
+bool LikePattern::Match(const char *str, uint32_t length) const {
+  if (never_matches_) {
+    return false;
+  }
+  if (length > 0 && str[length - 1] == '\0') {
+    length--;
+  }
+
+  // Only wildcards, or the empty pattern
+  if (segments_.empty()) {
+    return leading_wildcard_ || trailing_wildcard_ || length == 0;
+  }
+
+  const Segment &front = segments_.front(), &back = segments_.back();
+  switch (kind_) {
+    case Kind::EXACT:
+      return length == front.length && MatchAt(front, str);
+    case Kind::PREFIX:
+      return length >= front.length && MatchAt(front, str);
+    case Kind::SUFFIX:
+      return length >= front.length &&
+             MatchAt(front, str + length - front.length);
+    case Kind::CONTAINS:
+      return Find(front, str, 0, length) < length;
+    case Kind::GENERAL:
+      break;
+  }
+
+  // A single segment without '%' must cover the whole string
+  if (!leading_wildcard_ && !trailing_wildcard_ && segments_.size() == 1) {
+    return length == front.length && MatchAt(front, str);
+  }
+
+  // Match the anchored segments at the ends, and every other segment at its
+  // leftmost occurrence between them
+  uint32_t begin = 0, end = length;
+  size_t first = 0, last = segments_.size();
+  if (!leading_wildcard_) {
+    if (length < front.length || !MatchAt(front, str)) {
+      return false;
+    }
+    begin = front.length;
+    first++;
+  }
+  if (!trailing_wildcard_) {
+    if (length < begin + back.length ||
+        !MatchAt(back, str + length - back.length)) {
+      return false;
+    }
+    end = length - back.length;
+    last--;
+  }
+  for (size_t i = first; i < last; i++) {
+    uint32_t pos = Find(segments_[i], str, begin, end);
+    if (pos == end) {
+      return false;
+    }
+    begin = pos + segments_[i].length;
+  }
+  return true;
+}
+
+}  // namespace function
+}  // namespace peloton
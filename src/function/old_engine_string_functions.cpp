@@ -17,6 +17,7 @@
 #include <string>
 
 #include "executor/executor_context.h"
+#include "function/like_pattern.h"
 #include "function/string_functions.h"
 #include "type/value_factory.h"
 
@@ -44,10 +45,20 @@ type::Value OldEngineStringFunctions::Like(
     return type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER);
   }
 
-  executor::ExecutorContext ctx{nullptr};
-  bool ret = StringFunctions::Like(
-      ctx, args[0].GetAs<const char *>(), args[0].GetLength(),
-      args[1].GetAs<const char *>(), args[1].GetLength());
+  // The pattern is the same for every row almost always, so we keep the last
+  // pattern this thread compiled
+  thread_local std::string last_pattern;
+  thread_local LikePattern compiled_pattern;
+  const char *pattern = args[1].GetAs<const char *>();
+  uint32_t pattern_length = args[1].GetLength();
+  if (last_pattern.size() != pattern_length ||
+      last_pattern.compare(0, pattern_length, pattern, pattern_length) != 0) {
+    last_pattern.assign(pattern, pattern_length);
+    compiled_pattern.Compile(pattern, pattern_length);
+  }
+
+  bool ret = compiled_pattern.Match(args[0].GetAs<const char *>(),
+                                    args[0].GetLength());
   return type::ValueFactory::GetBooleanValue(ret);
 }
 
@@ -14,8 +14,10 @@
 
 #include "common/macros.h"
 #include "executor/executor_context.h"
+#include "function/like_pattern.h"
 #include "type/type_util.h"
 #include "type/abstract_pool.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace function {
@@ -26,74 +28,14 @@ uint32_t StringFunctions::Ascii(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
   return length <= 1 ? 0 : static_cast<uint32_t>(str[0]);
 }
 
-#define NextByte(p, plen) ((p)++, (plen)--)
-
 bool StringFunctions::Like(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
                            const char *t, uint32_t tlen, const char *p,
                            uint32_t plen) {
   PELOTON_ASSERT(t != nullptr);
   PELOTON_ASSERT(p != nullptr);
-  if (plen == 1 && *p == '%') return true;
-
-  while (tlen > 0 && plen > 0) {
-    if (*p == '\\') {
-      NextByte(p, plen);
-      if (plen <= 0) return false;
-      if (tolower(*p) != tolower(*t)) return false;
-    } else if (*p == '%') {
-      char firstpat;
-      NextByte(p, plen);
-
-      while (plen > 0) {
-        if (*p == '%')
-          NextByte(p, plen);
-        else if (*p == '_') {
-          if (tlen <= 0) return false;
-          NextByte(t, tlen);
-          NextByte(p, plen);
-        } else
-          break;
-      }
-
-      if (plen <= 0) return true;
-
-      if (*p == '\\') {
-        if (plen < 2) return false;
-        firstpat = tolower(p[1]);
-      } else
-        firstpat = tolower(*p);
-
-      while (tlen > 0) {
-        if (tolower(*t) == firstpat) {
-          int matched = Like(ctx, t, tlen, p, plen);
-
-          if (matched != false) return matched;
-        }
-
-        NextByte(t, tlen);
-      }
-      return false;
-    } else if (*p == '_') {
-      NextByte(t, tlen);
-      NextByte(p, plen);
-      continue;
-    } else if (tolower(*p) != tolower(*t)) {
-      return false;
-    }
-    NextByte(t, tlen);
-    NextByte(p, plen);
-  }
-
-  if (tlen > 0) return false;
-
-  while (plen > 0 && *p == '%') NextByte(p, plen);
-  if (plen <= 0) return true;
-
-  return false;
+  return LikePattern{p, plen}.Match(t, tlen);
 }
 
-#undef NextByte
-
 StringFunctions::StrWithLen StringFunctions::Substr(
     UNUSED_ATTRIBUTE executor::ExecutorContext &ctx, const char *str,
     uint32_t str_length, int32_t from, int32_t len) {
@@ -229,20 +171,8 @@ int32_t StringFunctions::CompareStrings(const char *str1, uint32_t len1,
 
 void StringFunctions::WriteString(const char *data, uint32_t len, char *buf,
                                   peloton::type::AbstractPool &pool) {
-  struct Varlen {
-    uint32_t len;
-    char data[0];
-  };
-
-  // Allocate memory for the Varlen object
-  auto *area = static_cast<Varlen *>(pool.Allocate(sizeof(uint32_t) + len));
-
-  // Populate it
-  area->len = len;
-  PELOTON_MEMCPY(area->data, data, len);
-
-  // Store a pointer to the Varlen object into the target memory space
-  *reinterpret_cast<Varlen **>(buf) = area;
+  // Short strings are stored in the slot itself, longer ones in the pool
+  peloton::type::VarlenSlot::Set(buf, data, len, &pool);
 }
 
 // TODO(pmenon): UTF8 checking, string checking, lots of error handling here
@@ -22,6 +22,28 @@
 namespace peloton {
 namespace gc {
 
+common::synchronization::ReadWriteLatch GCManager::index_latch_;
+
+std::unordered_set<index::Index *> GCManager::indexes_;
+
+void GCManager::RegisterIndex(index::Index *index) {
+  index_latch_.WriteLock();
+  indexes_.insert(index);
+  index_latch_.Unlock();
+}
+
+void GCManager::DeregisterIndex(index::Index *index) {
+  index_latch_.WriteLock();
+  indexes_.erase(index);
+  index_latch_.Unlock();
+}
+
+void GCManager::RecycleTileGroup(
+    std::shared_ptr<storage::TileGroup> tile_group) {
+  std::lock_guard<std::mutex> lock(replaced_tile_groups_mutex_);
+  replaced_tile_groups_.push_back(std::move(tile_group));
+}
+
 // Check a tuple and reclaim all varlen field
 void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tile_group,
                                              oid_t tuple_id) {
@@ -35,6 +57,11 @@ void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tile_group,
   for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
     storage::Tile *tile = tile_group->GetTile(tile_itr);
     PELOTON_ASSERT(tile);
+    // The variable-length values of a compressed tile are shared by all the
+    // tuples that have them, and are freed with the tile
+    if (tile->IsCompressed()) {
+      continue;
+    }
     const catalog::Schema *schema = tile->GetSchema();
     tile_col_count = schema->GetColumnCount();
     for (oid_t tile_col_itr = 0; tile_col_itr < tile_col_count;
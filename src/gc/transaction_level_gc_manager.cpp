@@ -30,7 +30,14 @@ namespace gc {
 
 bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
   auto storage_manager = storage::StorageManager::GetInstance();
-  auto tile_group = storage_manager->GetTileGroup(location.block).get();
+  auto tile_group_ptr = storage_manager->GetTileGroup(location.block);
+
+  // The tile group may have been dropped along with its table, or retired by
+  // compaction
+  if (tile_group_ptr == nullptr) {
+    return false;
+  }
+  auto tile_group = tile_group_ptr.get();
 
   auto tile_group_header = tile_group->GetHeader();
 
@@ -65,7 +72,9 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
     }
 
     int reclaimed_count = Reclaim(thread_id, expired_eid);
+    reclaimed_count += ReclaimTileGroups(thread_id, expired_eid);
     int unlinked_count = Unlink(thread_id, expired_eid);
+    ReclaimIndexGarbage(thread_id);
 
     if (is_running_ == false) {
       return;
@@ -88,6 +97,19 @@ void TransactionLevelGCManager::RecycleTransaction(
     concurrency::TransactionContext *txn) {
   auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
 
+  // Keep the tile groups of the garbage versions from being retired until they
+  // are recycled. This must happen before the epoch of the transaction may
+  // expire, which is when the versions look dead to DataTable::RetireTileGroup.
+  if (!txn->IsReadOnly() && txn->IsGCSetEmpty() != true) {
+    auto storage_manager = storage::StorageManager::GetInstance();
+    for (auto &entry : *(txn->GetGCSetPtr().get())) {
+      auto tile_group = storage_manager->GetTileGroup(entry.first);
+      if (tile_group != nullptr) {
+        tile_group->GetHeader()->AddGCPendingVersions(entry.second.size());
+      }
+    }
+  }
+
   epoch_manager.ExitEpoch(txn->GetThreadId(), txn->GetEpochId());
 
   if (!txn->IsReadOnly() && \
@@ -210,6 +232,36 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id,
   return gc_counter;
 }
 
+void TransactionLevelGCManager::RecycleTileGroup(
+    std::shared_ptr<storage::TileGroup> tile_group) {
+  // The transactions that may still read the tile group started no later than
+  // the current epoch
+  eid_t replaced_eid =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+  auto thread_id = HashToThread(tile_group->GetTileGroupId());
+  tile_group_queues_[thread_id]->Enqueue(
+      std::make_pair(replaced_eid, std::move(tile_group)));
+}
+
+// executed by a single thread. so no synchronization is required.
+int TransactionLevelGCManager::ReclaimTileGroups(const int &thread_id,
+                                                 const eid_t &expired_eid) {
+  auto &reclaim_map = tile_group_reclaim_maps_[thread_id];
+  ReplacedTileGroup replaced;
+  while (tile_group_queues_[thread_id]->Dequeue(replaced) == true) {
+    reclaim_map.insert(std::move(replaced));
+  }
+
+  int gc_counter = 0;
+  auto entry = reclaim_map.begin();
+  while (entry != reclaim_map.end() && entry->first <= expired_eid) {
+    entry = reclaim_map.erase(entry);
+    gc_counter++;
+  }
+  LOG_TRACE("Released %d replaced tile groups", gc_counter);
+  return gc_counter;
+}
+
 // Multiple GC thread share the same recycle map
 void TransactionLevelGCManager::AddToRecycleMap(
     concurrency::TransactionContext *txn_ctx) {
@@ -218,10 +270,9 @@ void TransactionLevelGCManager::AddToRecycleMap(
     auto tile_group = storage_manager->GetTileGroup(entry.first);
 
     // During the resetting, a table may be deconstructed because of the DROP
-    // TABLE request
+    // TABLE request, or the tile group may have been retired by compaction
     if (tile_group == nullptr) {
-      delete txn_ctx;
-      return;
+      continue;
     }
 
     PELOTON_ASSERT(tile_group != nullptr);
@@ -233,7 +284,9 @@ void TransactionLevelGCManager::AddToRecycleMap(
     oid_t table_id = table->GetOid();
     auto tile_group_header = tile_group->GetHeader();
     PELOTON_ASSERT(tile_group_header != nullptr);
-    bool immutable = tile_group_header->GetImmutability();
+    // The free slots of frozen and draining tile groups must not be reused
+    bool reusable = !tile_group_header->GetImmutability() &&
+                    !tile_group_header->IsDraining();
 
     for (auto &element : entry.second) {
       // as this transaction has been committed, we should reclaim older
@@ -244,8 +297,9 @@ void TransactionLevelGCManager::AddToRecycleMap(
       if (ResetTuple(location) == false) {
         continue;
       }
-      // if immutable is false and the entry for table_id exists.
-      if ((!immutable) &&
+      tile_group_header->RemoveGCPendingVersion();
+      // if the slot is reusable and the entry for table_id exists.
+      if (reusable &&
           recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
         recycle_queue_map_[table_id]->Enqueue(location);
       }
@@ -291,7 +345,17 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   PELOTON_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
   auto recycle_queue = recycle_queue_map_[table_id];
 
-  if (recycle_queue->Dequeue(location) == true) {
+  while (recycle_queue->Dequeue(location) == true) {
+    // Slots recycled before their tile group was frozen, started draining
+    // (i.e., it is being compacted or migrated) or was retired must not be
+    // reused
+    auto tile_group =
+        storage::StorageManager::GetInstance()->GetTileGroup(location.block);
+    if (tile_group == nullptr ||
+        tile_group->GetHeader()->GetImmutability() == true ||
+        tile_group->GetHeader()->IsDraining() == true) {
+      continue;
+    }
     LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
               location.offset, table_id);
     return location;
@@ -309,6 +373,8 @@ void TransactionLevelGCManager::ClearGarbage(int thread_id) {
     Reclaim(thread_id, MAX_CID);
   }
 
+  ReclaimTileGroups(thread_id, MAX_CID);
+
   return;
 }
 
@@ -323,11 +389,38 @@ void TransactionLevelGCManager::StopGC() {
 
 void TransactionLevelGCManager::UnlinkVersions(
     concurrency::TransactionContext *txn_ctx) {
+  // GC threads delete index entries outside of any transaction, so no index
+  // garbage may be freed meanwhile (see ReclaimIndexGarbage())
+  index_unlink_latch_.ReadLock();
   for (auto entry : *(txn_ctx->GetGCSetPtr().get())) {
     for (auto &element : entry.second) {
       UnlinkVersion(ItemPointer(entry.first, element.first), element.second);
     }
   }
+  index_unlink_latch_.Unlock();
+}
+
+void TransactionLevelGCManager::ReclaimIndexGarbage(const int &thread_id) {
+  // Every index is reclaimed by a single GC thread
+  std::vector<index::Index *> garbage_indexes;
+  index_latch_.ReadLock();
+  for (auto *index : indexes_) {
+    if (HashToThread(index->GetOid()) == (unsigned int)thread_id &&
+        index->NeedGC()) {
+      garbage_indexes.push_back(index);
+    }
+  }
+
+  if (garbage_indexes.empty() == false) {
+    // The index nodes are tagged with the epoch in which they were unlinked,
+    // and each index frees those no active transaction could still see
+    index_unlink_latch_.WriteLock();
+    for (auto *index : garbage_indexes) {
+      index->PerformGC();
+    }
+    index_unlink_latch_.Unlock();
+  }
+  index_latch_.Unlock();
 }
 
 // delete a tuple from all its indexes it belongs to.
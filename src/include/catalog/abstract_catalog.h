@@ -100,6 +100,9 @@ class AbstractCatalog {
   std::atomic<oid_t> oid_ = ATOMIC_VAR_INIT(START_OID + OID_OFFSET);
 
   storage::DataTable *catalog_table_;
+
+  // Whether the index scans on this catalog go through the GlobalCatalogCache
+  bool cached_ = false;
 };
 
 }  // namespace catalog
@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// global_catalog_cache.h
+//
+// Identification: src/include/catalog/global_catalog_cache.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/container/cuckoo_map.h"
+#include "common/internal_types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace storage {
+class Tile;
+}  // namespace storage
+
+namespace catalog {
+
+// The materialized result of an index scan on a system catalog table
+struct CatalogScanResult {
+  // The catalog version the result was read at
+  uint64_t version;
+
+  std::vector<std::shared_ptr<storage::Tile>> tiles;
+};
+
+//===--------------------------------------------------------------------===//
+// Global Catalog Cache
+//===--------------------------------------------------------------------===//
+
+/**
+ * Server-wide cache of the index scans on the system catalog tables
+ * (pg_database, pg_namespace, pg_table, pg_attribute, pg_index, pg_layout and
+ * pg_constraint), shared by all transactions.
+ *
+ * Unlike the CatalogCache of a transaction, which holds the catalog entries
+ * the transaction has built, this cache holds the rows those entries are built
+ * from, so a new transaction can resolve names and oids without scanning the
+ * catalog tables.
+ *
+ * Every cached result is stamped with the catalog version of the transaction
+ * that read it, which is the version when the transaction began. A
+ * transaction that writes to one of the catalog tables bumps the version
+ * before its changes become visible, and again once they are (or are rolled
+ * back), which invalidates all cached results at once. A transaction only uses
+ * the cache if the catalog has not changed since it began, and no change is
+ * in progress; its snapshot then has the same catalog as the cached results.
+ * A transaction that wrote to the catalog tables bypasses the cache, so it
+ * sees its own changes.
+ */
+class GlobalCatalogCache {
+ public:
+  GlobalCatalogCache() : version_(0), num_changing_(0) {}
+  DISALLOW_COPY(GlobalCatalogCache)
+
+  static GlobalCatalogCache &GetInstance();
+
+  static std::string GetKey(oid_t database_oid, oid_t table_oid,
+                            oid_t index_offset,
+                            const std::vector<oid_t> &column_offsets,
+                            const std::vector<type::Value> &values);
+
+  uint64_t GetVersion() const { return version_.load(); }
+
+  /**
+   * Whether a transaction that began at the given catalog version has the
+   * current catalog in its snapshot, i.e., the catalog has not changed since
+   * and no change is in progress.
+   */
+  bool IsCurrent(uint64_t version) const;
+
+  /**
+   * Get the cached result of a scan for a transaction that began at the given
+   * catalog version. Returns nullptr if the result is not cached, was read at
+   * another catalog version, or the catalog changed since the transaction
+   * began.
+   */
+  std::shared_ptr<CatalogScanResult> Find(const std::string &key,
+                                          uint64_t version) const;
+
+  /**
+   * Cache the result of a scan of a transaction that began at the given
+   * catalog version. The result is dropped if the catalog changed meanwhile.
+   */
+  void Insert(const std::string &key, uint64_t version,
+              std::vector<std::shared_ptr<storage::Tile>> tiles);
+
+  // Called before the catalog changes of a transaction become visible, or are
+  // rolled back. No cached results are used until Invalidate() is called.
+  void BeginChange();
+
+  // Drop all cached results, once the catalog changes of a transaction are
+  // visible or rolled back
+  void Invalidate();
+
+  size_t GetSize() const { return results_.GetSize(); }
+
+ private:
+  std::atomic<uint64_t> version_;
+
+  // The number of transactions whose catalog changes are being made visible
+  // or rolled back
+  std::atomic<uint32_t> num_changing_;
+
+  CuckooMap<std::string, std::shared_ptr<CatalogScanResult>> results_;
+};
+
+}  // namespace catalog
+}  // namespace peloton
@@ -25,6 +25,12 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class BloomFilterAccessor {
  public:
+  // Probe statistics counted in local variables of the generated function
+  struct ProbeCounters {
+    llvm::Value *num_probes;
+    llvm::Value *num_misses;
+  };
+
   // Codegen the bloom filter init
   void Init(CodeGen &codegen, llvm::Value *bloom_filter,
             uint64_t estimated_num_tuples) const;
@@ -36,14 +42,24 @@ class BloomFilterAccessor {
   void Add(CodeGen &codegen, llvm::Value *bloom_filter,
            const std::vector<codegen::Value> &key) const;
 
-  // Codegen the bloom filter probe
+  // Codegen the bloom filter probe. The probe and its outcome are counted in
+  // the given local counters, if any.
   llvm::Value *Contains(CodeGen &codegen, llvm::Value *bloom_filter,
-                        const std::vector<codegen::Value> &key) const;
+                        const std::vector<codegen::Value> &key,
+                        const ProbeCounters *counters = nullptr) const;
+
+  // Allocate local probe counters and zero them
+  ProbeCounters InitCounters(CodeGen &codegen) const;
+
+  // Add the local probe counters to the statistics of the bloom filter. The
+  // filter is shared by all threads of a parallel scan, so this is meant to
+  // be done once per batch rather than once per probe.
+  void PublishCounters(CodeGen &codegen, llvm::Value *bloom_filter,
+                       const ProbeCounters &counters) const;
 
  private:
-  void StoreBloomFilterField(CodeGen &codegen, llvm::Value *bloom_filter,
-                             uint32_t field_id,
-                             llvm::Value *new_field_val) const;
+  // Bump a local counter
+  void IncrementCounter(CodeGen &codegen, llvm::Value *counter) const;
 
   llvm::Value *LoadBloomFilterField(CodeGen &codegen, llvm::Value *bloom_filter,
                                     uint32_t field_id) const;
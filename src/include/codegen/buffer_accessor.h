@@ -40,6 +40,22 @@ class BufferAccessor {
 
   llvm::Value *NumTuples(CodeGen &codegen, llvm::Value *buffer_ptr) const;
 
+  // Positional access to the buffered tuples, for callers that walk through
+  // the buffer themselves rather than through Iterate()
+  llvm::Value *BufferStart(CodeGen &codegen, llvm::Value *buffer_ptr) const;
+
+  llvm::Value *BufferEnd(CodeGen &codegen, llvm::Value *buffer_ptr) const;
+
+  llvm::Value *NextTuple(CodeGen &codegen, llvm::Value *pos) const;
+
+  void LoadTuple(CodeGen &codegen, llvm::Value *pos,
+                 std::vector<codegen::Value> &vals) const;
+
+  // Overwrite an attribute of the buffered tuple at the given position. The
+  // attribute must not be nullable.
+  void StoreValue(CodeGen &codegen, llvm::Value *pos, uint32_t col_id,
+                  const codegen::Value &val) const;
+
   uint32_t GetTupleSize() const { return storage_format_.GetStorageSize(); }
 
   struct IterateCallback {
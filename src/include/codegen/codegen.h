@@ -137,6 +137,11 @@ class CodeGen {
   llvm::Value *Memcmp(llvm::Value *ptr1, llvm::Value *ptr2,
                       llvm::Value *len);
   llvm::Value *Sqrt(llvm::Value *val);
+  llvm::Value *ByteSwap(llvm::Value *val);
+
+  // Prefetch the cache line holding the given address, for a read or a write.
+  // The locality ranges from 0 (none) to 3 (keep in all levels of the cache).
+  void Prefetch(llvm::Value *addr, bool for_write, uint32_t locality);
 
   //===--------------------------------------------------------------------===//
   // Arithmetic with overflow logic - These methods perform the desired math op,
@@ -80,7 +80,7 @@ class CompilationContext {
     return pos;
   }
 
-  bool IsLastPipeline(const Pipeline &p) const { return p.GetId() == 0; }
+  bool IsLastPipeline(const Pipeline &p) const { return p == *pipelines_[0]; }
 
   //////////////////////////////////////////////////////////////////////////////
   ///
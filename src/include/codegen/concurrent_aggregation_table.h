@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table.h
+//
+// Identification: src/include/codegen/concurrent_aggregation_table.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "codegen/codegen.h"
+#include "codegen/compact_storage.h"
+#include "codegen/util/concurrent_aggregation_table.h"
+#include "codegen/value.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// Our interface to the aggregation hash table that all threads of a parallel
+// pipeline share. Each group has a key of fixed-size SQL values, and a list of
+// 64-bit integer aggregates, each with its own update operation. Groups are
+// upserted into the table from any number of threads. Once they're done, the
+// groups can be iterated.
+//===----------------------------------------------------------------------===//
+class ConcurrentAggregationTable {
+ public:
+  using UpdateOp = util::ConcurrentAggregationTable::UpdateOp;
+
+  // The callback used when iterating over the groups in the table
+  class IterateCallback {
+   public:
+    virtual ~IterateCallback() = default;
+
+    // Process the group with the given key and aggregates
+    virtual void ProcessEntry(
+        CodeGen &codegen, const std::vector<codegen::Value> &key,
+        const std::vector<llvm::Value *> &aggregates) const = 0;
+  };
+
+  // Constructors
+  ConcurrentAggregationTable();
+  ConcurrentAggregationTable(CodeGen &codegen,
+                             const std::vector<type::Type> &key_type,
+                             const std::vector<UpdateOp> &update_ops);
+
+  // Initialize the table, sized for the estimated number of groups
+  void Init(CodeGen &codegen, llvm::Value *exec_ctx, llvm::Value *table_ptr,
+            uint64_t num_groups) const;
+
+  // Fold the given 64-bit values into the aggregates of the group with the
+  // given key. Any thread may do this at the same time.
+  void Upsert(CodeGen &codegen, llvm::Value *table_ptr,
+              const std::vector<codegen::Value> &key,
+              const std::vector<llvm::Value *> &values) const;
+
+  // Iterate over all groups in the table, when no thread is upserting anymore
+  void Iterate(CodeGen &codegen, llvm::Value *table_ptr,
+               IterateCallback &callback) const;
+
+  // Clean up the table
+  void Destroy(CodeGen &codegen, llvm::Value *table_ptr) const;
+
+ private:
+  // The storage format of the keys
+  CompactStorage key_storage_;
+
+  // The update operation of each aggregate
+  std::vector<UpdateOp> update_ops_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -49,6 +49,11 @@ class ConsumerContext {
   void Consume(RowBatch &batch);
   void Consume(RowBatch::Row &row);
 
+  // Pass the row to the parent of the caller, then rewind the pipeline to the
+  // caller. This lets an operator send rows to its parent from more than one
+  // place in the generated code; all but the last of them must use this.
+  void ConsumeAndRewind(RowBatch::Row &row);
+
   CompilationContext &GetCompilationContext() { return compilation_context_; }
 
   // Get the code generator instance
@@ -41,10 +41,17 @@ class ExpressionTranslator {
   // Destructor
   virtual ~ExpressionTranslator() = default;
 
+  // Codegen any initialization work for this expression, e.g., to build
+  // lookup structures from the query parameters
+  virtual void InitializeQueryState() {}
+
   // Compute this expression
   virtual codegen::Value DeriveValue(CodeGen &codegen,
                                      RowBatch::Row &row) const = 0;
 
+  // Codegen any cleanup work for this expression
+  virtual void TearDownQueryState() {}
+
   template <typename T>
   const T &GetExpressionAs() const {
     return static_cast<const T &>(expression_);
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// in_list_translator.h
+//
+// Identification: src/include/codegen/expression/in_list_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/expression/expression_translator.h"
+#include "codegen/query_state.h"
+
+namespace peloton {
+
+namespace expression {
+class ComparisonExpression;
+}  // namespace expression
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for "x IN (v1, v2, ...)" over a list of values. Short lists are
+// checked with one comparison per value, all of which are evaluated without
+// branching. Long lists of integral constants or parameters are sorted once
+// when the query starts and looked up with a branch-free binary search. Both
+// read the values from the query parameters, so the compiled query can be
+// reused for other lists of the same length.
+//===----------------------------------------------------------------------===//
+class InListTranslator : public ExpressionTranslator {
+ public:
+  // Constructor
+  InListTranslator(const expression::ComparisonExpression &in_list,
+                   CompilationContext &context);
+
+  // Sort the values of the list, if we look them up in a sorted array
+  void InitializeQueryState() override;
+
+  // Produce the result of checking if the left value is in the list
+  codegen::Value DeriveValue(CodeGen &codegen,
+                             RowBatch::Row &row) const override;
+
+  // Free the sorted values of the list
+  void TearDownQueryState() override;
+
+ private:
+  // Check the needle against every value of the list
+  codegen::Value CompareAll(CodeGen &codegen, RowBatch::Row &row,
+                            const codegen::Value &needle) const;
+
+  // Look up the needle in the sorted values of the list
+  codegen::Value LookupSorted(CodeGen &codegen,
+                              const codegen::Value &needle) const;
+
+  // Combine whether the needle was found, and whether the needle or any
+  // value of the list is NULL, into the SQL result of the IN-list
+  codegen::Value MakeResult(CodeGen &codegen, llvm::Value *found,
+                            llvm::Value *has_null) const;
+
+ private:
+  // Lists longer than this are looked up in a sorted array, if possible
+  static constexpr uint32_t kMaxCompareAllSize = 16;
+
+  // Do we look up the needle in a sorted array of the list's values?
+  bool use_sorted_;
+
+  // Can the needle or any value of the list be NULL?
+  bool nullable_;
+
+  // The sorted values of the list in the runtime state
+  QueryState::Id in_list_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
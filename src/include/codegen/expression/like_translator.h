@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_translator.h
+//
+// Identification: src/include/codegen/expression/like_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/expression/expression_translator.h"
+#include "codegen/query_state.h"
+
+namespace peloton {
+
+namespace expression {
+class ComparisonExpression;
+}  // namespace expression
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for "x LIKE 'pattern'" where the pattern is a constant or a
+// parameter of the query. The pattern is compiled once when the query starts
+// (see util::LikeMatcher), instead of being interpreted again for every row.
+// Other LIKE expressions are handled by the ComparisonTranslator.
+//===----------------------------------------------------------------------===//
+class LikeTranslator : public ExpressionTranslator {
+ public:
+  // Constructor
+  LikeTranslator(const expression::ComparisonExpression &like,
+                 CompilationContext &context);
+
+  // Can the given LIKE expression use a compiled pattern?
+  static bool IsSupported(const expression::ComparisonExpression &like);
+
+  // Compile the pattern
+  void InitializeQueryState() override;
+
+  // Produce the result of matching the left value against the pattern
+  codegen::Value DeriveValue(CodeGen &codegen,
+                             RowBatch::Row &row) const override;
+
+  // Free the compiled pattern
+  void TearDownQueryState() override;
+
+ private:
+  // The compiled pattern in the runtime state
+  QueryState::Id matcher_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_value_translator.h
+//
+// Identification: src/include/codegen/expression/vector_value_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/expression/expression_translator.h"
+
+namespace peloton {
+
+namespace expression {
+class VectorValueExpression;
+}  // namespace expression
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for a list of values. It only prepares the values of the list,
+// the parent expression (e.g., an IN-list) derives each of them on its own.
+//===----------------------------------------------------------------------===//
+class VectorValueTranslator : public ExpressionTranslator {
+ public:
+  // Constructor
+  VectorValueTranslator(const expression::VectorValueExpression &vector_exp,
+                        CompilationContext &context);
+
+  // A list does not have a single value
+  codegen::Value DeriveValue(CodeGen &codegen,
+                             RowBatch::Row &row) const override;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -227,6 +227,41 @@ class HashTable {
                        const std::vector<codegen::Value> &key,
                        IterateCallback &callback) const;
 
+  /**
+   * Like FindAll(), for a key whose hash was already computed with HashKey().
+   */
+  void FindAllWithHash(CodeGen &codegen, llvm::Value *ht_ptr, llvm::Value *hash,
+                       const std::vector<codegen::Value> &key,
+                       IterateCallback &callback) const;
+
+  /**
+   * Like FindAllWithHash(), but stops walking the matching entries once the
+   * boolean variable pointed to by done_ptr is true. The callback sets the
+   * variable when it doesn't need to see any more entries.
+   */
+  void FindAllUntil(CodeGen &codegen, llvm::Value *ht_ptr, llvm::Value *hash,
+                    const std::vector<codegen::Value> &key,
+                    IterateCallback &callback, llvm::Value *done_ptr) const;
+
+  /**
+   * Compute the hash of the given key, as probing the table does.
+   */
+  llvm::Value *HashKey(CodeGen &codegen,
+                       const std::vector<codegen::Value> &key) const;
+
+  /**
+   * Prefetch the slot in the directory of the bucket for the given hash.
+   */
+  void PrefetchBucket(CodeGen &codegen, llvm::Value *ht_ptr,
+                      llvm::Value *hash) const;
+
+  /**
+   * Prefetch the first entry in the bucket for the given hash. This loads the
+   * directory slot of the bucket, which should have been prefetched before.
+   */
+  void PrefetchBucketHead(CodeGen &codegen, llvm::Value *ht_ptr,
+                          llvm::Value *hash) const;
+
   virtual void Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const;
 
  private:
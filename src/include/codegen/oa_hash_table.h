@@ -100,10 +100,10 @@ class OAHashTable : public HashTable {
                HashTable::IterateCallback &callback) const override;
 
   // An enum class indicating the type of prefetch (i.e., read or write)
-  enum class PrefetchType : uint32_t { Read = 0, Write = 0 };
+  enum class PrefetchType : uint32_t { Read = 0, Write = 1 };
 
   // An enum class indicating the temporal locality of the prefetched address
-  enum class Locality : uint32_t { None = 0, High = 1, Medium = 2, Low = 3 };
+  enum class Locality : uint32_t { None = 0, Low = 1, Medium = 2, High = 3 };
 
   // Prefetch the first bucket with the given hash value from the hash table
   void PrefetchBucket(CodeGen &codegen, llvm::Value *ht_ptr, llvm::Value *hash,
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_translator.h
+//
+// Identification: src/include/codegen/operator/append_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "codegen/operator/operator_translator.h"
+
+namespace peloton {
+
+namespace planner {
+class AppendPlan;
+}  // namespace planner
+
+namespace codegen {
+
+/**
+ * This is the translator for the append operator (i.e., UNION ALL). Rows of
+ * all inputs are passed on to the parent as they arrive, without being
+ * materialized. The first input runs in the pipeline of the operator, every
+ * other input runs in a pipeline forked from it.
+ */
+class AppendTranslator : public OperatorTranslator {
+ public:
+  AppendTranslator(const planner::AppendPlan &plan, CompilationContext &context,
+                   Pipeline &pipeline);
+
+  // No state
+  void InitializeQueryState() override {}
+
+  // No extra functions needed
+  void DefineAuxiliaryFunctions() override {}
+
+  void Produce() const override;
+
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // No state to tear down
+  void TearDownQueryState() override {}
+
+ private:
+  // The pipelines of all inputs but the first, in the order of the inputs
+  std::vector<std::unique_ptr<Pipeline>> input_pipelines_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
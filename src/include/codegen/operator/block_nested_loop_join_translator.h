@@ -45,6 +45,10 @@ class BlockNestedLoopJoinTranslator : public OperatorTranslator {
 
   void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
 
+  // Produce the buffered left tuples without a join partner in LEFT, FULL and
+  // ANTI joins, and those with one in SEMI joins
+  void FinishConsume(ConsumerContext &context) const override;
+
  private:
   bool IsFromLeftChild(const Pipeline &pipeline) const;
 
@@ -53,6 +57,18 @@ class BlockNestedLoopJoinTranslator : public OperatorTranslator {
 
   void FindMatchesForRow(ConsumerContext &ctx, RowBatch::Row &row) const;
 
+  // Like FindMatchesForRow(), but also tracks which rows and buffered tuples
+  // found a join partner, for outer, semi and anti joins
+  void FindPartnersForRow(ConsumerContext &ctx, RowBatch::Row &row) const;
+
+  // Does the join produce left or right tuples without a join partner?
+  bool ProducesUnmatchedLeft() const;
+  bool ProducesUnmatchedRight() const;
+
+  // Does the join track which buffered tuples found a join partner? LEFT,
+  // FULL, SEMI and ANTI joins produce them based on it.
+  bool TracksLeftMatches() const;
+
  private:
   // The pipeline for the left subtree of the plan
   Pipeline left_pipeline_;
@@ -60,6 +76,10 @@ class BlockNestedLoopJoinTranslator : public OperatorTranslator {
   // All the attributes from the left input that are materialized
   std::vector<const planner::AttributeInfo *> unique_left_attributes_;
 
+  // Whether the join must see all left tuples at once. This is the case when
+  // the join needs to know if a right row has a join partner at all.
+  bool buffer_all_left_;
+
   // The memory space we use to buffer left input tuples
   QueryState::Id buffer_id_;
   BufferAccessor buffer_;
@@ -67,7 +87,7 @@ class BlockNestedLoopJoinTranslator : public OperatorTranslator {
   // This controls the number of tuples we buffer before performing the nested
   // loop join. Ideally, we want the buffer to always be, at least, L2 cache
   // resident. Knowing the tuple layout coming from the left child, we calculate
-  // this value accurately.
+  // this value accurately. Unused if all left tuples are buffered.
   uint32_t max_buf_rows_;
 
   // This is the function called when enough tuples from the left side have been
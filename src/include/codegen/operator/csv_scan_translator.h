@@ -50,6 +50,17 @@ class CSVScanTranslator : public OperatorTranslator {
   // Similar to InitializeState(), file scans don't have any state
   void TearDownQueryState() override;
 
+ private:
+  // Functions to produce tuples serially or in parallel
+  void ProduceSerial() const;
+  void ProduceParallel() const;
+
+  // Generate a constant array of the types of the columns in the CSV file
+  llvm::Value *ConstColumnTypes(CodeGen &codegen) const;
+
+  // Push the row the given scanner is positioned on through the pipeline
+  void ConsumeRow(ConsumerContext &ctx, llvm::Value *scanner_ptr) const;
+
  private:
   // The set of attributes output by the csv scan
   std::vector<const planner::AttributeInfo *> output_attributes_;
@@ -57,7 +68,7 @@ class CSVScanTranslator : public OperatorTranslator {
   // The scanner state ID
   QueryState::Id scanner_id_;
 
-  // The generated CSV scan consumer function
+  // The generated CSV scan consumer function (serial scans only)
   llvm::Function *consumer_func_;
 };
 
@@ -13,9 +13,11 @@
 #pragma once
 
 #include "codegen/aggregation.h"
+#include "codegen/concurrent_aggregation_table.h"
 #include "codegen/oa_hash_table.h"
 #include "codegen/operator/operator_translator.h"
 #include "codegen/updateable_storage.h"
+#include "planner/attribute_info.h"
 
 namespace peloton {
 
@@ -30,9 +32,6 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class HashGroupByTranslator : public OperatorTranslator {
  public:
-  // Global/configurable variable controlling whether hash aggregations prefetch
-  static std::atomic<bool> kUsePrefetch;
-
   // Constructor
   HashGroupByTranslator(const planner::AggregatePlan &group_by,
                         CompilationContext &context, Pipeline &pipeline);
@@ -61,7 +60,9 @@ class HashGroupByTranslator : public OperatorTranslator {
    public:
     // Constructor
     ProduceResults(ConsumerContext &ctx, const planner::AggregatePlan &plan,
-                   const Aggregation &aggregation);
+                   const Aggregation &aggregation,
+                   const std::vector<bool> &string_id_keys,
+                   llvm::Value *string_ids);
 
     // The callback
     void ProcessEntries(CodeGen &codegen, llvm::Value *start, llvm::Value *end,
@@ -72,6 +73,32 @@ class HashGroupByTranslator : public OperatorTranslator {
     ConsumerContext &ctx_;
     const planner::AggregatePlan &plan_;
     const Aggregation &aggregation_;
+    // Which grouping keys are stored as string IDs, and the map of the IDs
+    const std::vector<bool> &string_id_keys_;
+    llvm::Value *string_ids_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback the group-by uses when iterating the groups of the hash table
+  // shared by all threads of a parallel aggregation
+  //===--------------------------------------------------------------------===//
+  class ProduceSharedResults
+      : public ConcurrentAggregationTable::IterateCallback {
+   public:
+    // Constructor
+    ProduceSharedResults(ConsumerContext &ctx,
+                         const HashGroupByTranslator &translator,
+                         Vector &selection_vector);
+
+    // The callback
+    void ProcessEntry(
+        CodeGen &codegen, const std::vector<codegen::Value> &key,
+        const std::vector<llvm::Value *> &aggregates) const override;
+
+   private:
+    ConsumerContext &ctx_;
+    const HashGroupByTranslator &translator_;
+    Vector &selection_vector_;
   };
 
   //===--------------------------------------------------------------------===//
@@ -166,9 +193,88 @@ class HashGroupByTranslator : public OperatorTranslator {
     uint32_t agg_index_;
   };
 
+  //===--------------------------------------------------------------------===//
+  // This class provides (delayed) access to a string grouping key in the result
+  // of the aggregation, which the hash table stores as the ID of the string.
+  //===--------------------------------------------------------------------===//
+  class StringKeyAccess : public RowBatch::AttributeAccess {
+   public:
+    StringKeyAccess(AggregateFinalizer &finalizer, uint32_t key_index,
+                    const type::Type &type, llvm::Value *strings);
+
+    codegen::Value Access(CodeGen &codegen, RowBatch::Row &row) override;
+
+   private:
+    // The associate finalizer
+    AggregateFinalizer &finalizer_;
+    // The index of the key in the tuple's attributes
+    uint32_t key_index_;
+    // The type of the key
+    type::Type type_;
+    // The string of every ID, as an array of varlen slots
+    llvm::Value *strings_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // This class provides access to the attributes of a group produced from the
+  // shared hash table, which are finalized up front.
+  //===--------------------------------------------------------------------===//
+  class SharedAggregateAccess : public RowBatch::AttributeAccess {
+   public:
+    SharedAggregateAccess(const std::vector<codegen::Value> &vals,
+                          uint32_t index)
+        : vals_(vals), index_(index) {}
+
+    codegen::Value Access(CodeGen &, RowBatch::Row &) override {
+      return vals_[index_];
+    }
+
+   private:
+    // The grouping keys, followed by the finalized aggregates
+    const std::vector<codegen::Value> &vals_;
+    // The index in the tuple's attributes
+    uint32_t index_;
+  };
+
+  // Where the aggregate of an aggregation term is in the shared hash table.
+  // Every aggregate but COUNT(...) and COUNT(*) also counts the non-NULL values
+  // it was updated with, to tell whether it is NULL.
+  struct SharedAggregateInfo {
+    uint32_t value_index;
+    uint32_t count_index;
+  };
+
   void CollectHashKeys(RowBatch::Row &row,
                        std::vector<codegen::Value> &key) const;
 
+  // Does the aggregation group on the IDs of some string keys?
+  bool HasStringIdKeys() const;
+
+  // Group the rows of the batch, looking up the IDs of their string keys
+  void ConsumeWithStringIds(ConsumerContext &context, RowBatch &batch) const;
+
+  // Look up the ID of the given string
+  llvm::Value *GetStringId(CodeGen &codegen, llvm::Value *string_ids,
+                           const codegen::Value &val) const;
+
+  // Can the threads of a parallel aggregation share one hash table instead of
+  // running the input serially?
+  bool CanShareHashTable() const;
+
+  // Fold the row into the hash table shared by all threads
+  void ConsumeShared(RowBatch::Row &row) const;
+
+  // Finalize the aggregates of a group in the shared hash table, appending
+  // them to the given values
+  void FinalizeSharedAggregates(CodeGen &codegen,
+                                const std::vector<llvm::Value *> &aggregates,
+                                std::vector<codegen::Value> &vals) const;
+
+  // Send a batch of result rows, with all the attributes of the groups set up,
+  // to the parent operator
+  static void SendResults(ConsumerContext &ctx,
+                          const planner::AggregatePlan &plan, RowBatch &batch);
+
   // Estimate the size of the constructed hash table
   uint64_t EstimateHashTableSize() const;
 
@@ -187,6 +293,23 @@ class HashGroupByTranslator : public OperatorTranslator {
 
   // The aggregation handler
   Aggregation aggregation_;
+
+  // Does the aggregation prefetch from the hash table? Decided once per plan
+  // from the estimated size of the hash table.
+  bool use_prefetch_;
+
+  // Which grouping keys the hash table stores as string IDs, the attributes
+  // their IDs are registered as in a row, and the map of the IDs
+  std::vector<bool> string_id_keys_;
+  std::vector<planner::AttributeInfo> string_id_ais_;
+  QueryState::Id string_id_map_id_;
+
+  // Do the threads of a parallel input pipeline share one hash table? If so,
+  // the table above is not used.
+  bool use_shared_table_;
+  QueryState::Id shared_table_id_;
+  ConcurrentAggregationTable shared_table_;
+  std::vector<SharedAggregateInfo> shared_aggregates_;
 };
 
 }  // namespace codegen
@@ -32,9 +32,6 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class HashJoinTranslator : public OperatorTranslator {
  public:
-  // Global/configurable variable controlling whether hash aggregations prefetch
-  static std::atomic<bool> kUsePrefetch;
-
   HashJoinTranslator(const planner::HashJoinPlan &join,
                      CompilationContext &context, Pipeline &pipeline);
 
@@ -47,6 +44,9 @@ class HashJoinTranslator : public OperatorTranslator {
   void Consume(ConsumerContext &context, RowBatch &batch) const override;
   void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
 
+  // Produce the left tuples without a join partner in LEFT and FULL joins
+  void FinishConsume(ConsumerContext &context) const override;
+
   void RegisterPipelineState(PipelineContext &pipeline_ctx) override;
   void InitializePipelineState(PipelineContext &pipeline_ctx) override;
   void TearDownPipelineState(PipelineContext &pipeline_ctx) override;
@@ -56,9 +56,13 @@ class HashJoinTranslator : public OperatorTranslator {
   void TearDownQueryState() override;
 
  private:
-  // Consume the given context from the left/build side or the right/probe side
+  // Consume the given context from the left/build side or the right/probe side.
+  // The hash of the probe key can be provided if it was already computed, and
+  // the bloom filter probe is counted in the given counters, if any.
   void ConsumeFromLeft(ConsumerContext &context, RowBatch::Row &row) const;
-  void ConsumeFromRight(ConsumerContext &context, RowBatch::Row &row) const;
+  void ConsumeFromRight(
+      ConsumerContext &context, RowBatch::Row &row, llvm::Value *hash,
+      const BloomFilterAccessor::ProbeCounters *counters) const;
 
   bool IsLeftPipeline(const Pipeline &pipeline) const {
     return pipeline == left_pipeline_;
@@ -78,7 +82,43 @@ class HashJoinTranslator : public OperatorTranslator {
                      std::vector<codegen::Value> &values) const;
 
   void CodegenHashProbe(ConsumerContext &context, RowBatch::Row &row,
-                        std::vector<codegen::Value> &key) const;
+                        llvm::Value *hash, std::vector<codegen::Value> &key,
+                        llvm::Value *matched_ptr) const;
+
+  // Produce the right row after probing, depending on whether it found a join
+  // partner. This is where RIGHT, FULL and ANTI joins produce their unmatched
+  // rows, and SEMI joins their matched ones.
+  void ProduceProbedRow(ConsumerContext &context, RowBatch::Row &row,
+                        llvm::Value *matched_ptr) const;
+
+  // Handle a valid join partner of a right row, whose entry in the hash table
+  // stores its values in the given data area
+  void ProduceMatch(ConsumerContext &context, RowBatch::Row &row,
+                    llvm::Value *data_area, llvm::Value *matched_ptr) const;
+
+  // Place the left attributes stored in a hash table entry, or NULL values if
+  // there is no entry, into the row
+  void RegisterLeftValues(CodeGen &codegen, RowBatch::Row &row,
+                          const std::vector<codegen::Value> &key,
+                          llvm::Value *data_area) const;
+  void RegisterNullLeftValues(CodeGen &codegen, RowBatch::Row &row) const;
+
+  // Does the join produce left or right tuples without a join partner?
+  bool ProducesUnmatchedLeft() const;
+  bool ProducesUnmatchedRight() const;
+
+  // Does the join only produce right rows, each at most once? SEMI and ANTI
+  // joins build the hash table over the inner side and probe it with the outer
+  // side.
+  bool ProducesRightOnly() const;
+
+  // Return a pointer to the flag in the data area of a hash table entry that
+  // tracks whether the tuple found a join partner
+  llvm::Value *MatchedFlagPtr(CodeGen &codegen, llvm::Value *data_area) const;
+
+  // Return the size of the value in every hash table entry: the left values,
+  // followed by the matched flag if the join needs one
+  uint32_t GetValueSize() const;
 
   /// Estimate the size of the constructed hash table
   uint64_t EstimateHashTableSize() const;
@@ -89,6 +129,14 @@ class HashJoinTranslator : public OperatorTranslator {
   /// Should this operator employ prefetching?
   bool UsePrefetching() const;
 
+  /// Push the bloom filter over the build-side keys into the table scan that
+  /// produces the probe-side keys, if the join allows it
+  void PushDownBloomFilter(CompilationContext &context);
+
+  /// Extend the range of the build-side keys by the given key
+  void UpdateKeyRange(ConsumerContext &context,
+                      const codegen::Value &key) const;
+
   const planner::HashJoinPlan &GetJoinPlan() const;
 
  private:
@@ -100,6 +148,9 @@ class HashJoinTranslator : public OperatorTranslator {
   /// Callback used when inserting a tuple in the hash table during build
   class InsertLeft;
 
+  /// Callback used to produce the left tuples without a join partner
+  class ProduceUnmatchedLeft;
+
  private:
   // The build-side pipeline
   Pipeline left_pipeline_;
@@ -111,6 +162,16 @@ class HashJoinTranslator : public OperatorTranslator {
   // The ID of the bloom filter in the runtime state
   QueryState::Id bloom_filter_id_;
 
+  // Was the bloom filter pushed into the scan on the probe side? The scan then
+  // probes it instead of the join.
+  bool bloom_filter_pushed_down_;
+
+  // The IDs of the smallest and largest build-side key in the runtime state,
+  // if the join tracks their range for the scan on the probe side
+  bool tracks_key_range_;
+  QueryState::Id key_min_id_;
+  QueryState::Id key_max_id_;
+
   // The hash table we use to perform the join
   HashTable hash_table_;
 
@@ -129,6 +190,10 @@ class HashJoinTranslator : public OperatorTranslator {
 
   // Does this join need an output vector
   bool needs_output_vector_;
+
+  // Does the probe prefetch from the hash table? Decided once per plan from
+  // the estimated size of the hash table.
+  bool use_prefetch_;
 };
 
 }  // namespace codegen
@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// merge_join_translator.h
+//
+// Identification: src/include/codegen/operator/merge_join_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/buffer_accessor.h"
+#include "codegen/operator/operator_translator.h"
+
+namespace peloton {
+
+namespace planner {
+class MergeJoinPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for a merge join. Both inputs must be sorted ascending on
+// their join keys.
+//===----------------------------------------------------------------------===//
+class MergeJoinTranslator : public OperatorTranslator {
+ public:
+  MergeJoinTranslator(const planner::MergeJoinPlan &join_plan,
+                      CompilationContext &context, Pipeline &pipeline);
+
+  void InitializeQueryState() override;
+
+  void DefineAuxiliaryFunctions() override {}
+
+  void TearDownQueryState() override;
+
+  void Produce() const override;
+
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+ private:
+  bool IsFromLeftChild(const Pipeline &pipeline) const {
+    return pipeline == left_pipeline_;
+  }
+
+  void ConsumeFromLeft(ConsumerContext &context, RowBatch::Row &row) const;
+  void ConsumeFromRight(ConsumerContext &context, RowBatch::Row &row) const;
+
+  // Derive the values of the given key expressions, and whether any is NULL
+  llvm::Value *CollectKeys(
+      RowBatch::Row &row,
+      const std::vector<const expression::AbstractExpression *> &key_exprs,
+      std::vector<codegen::Value> &keys) const;
+
+  // Compare the key of a buffered left tuple with the key of a right tuple,
+  // returning a negative, zero or positive value
+  llvm::Value *CompareKeys(const std::vector<codegen::Value> &left_tuple,
+                           const std::vector<codegen::Value> &right_key) const;
+
+  const planner::MergeJoinPlan &GetJoinPlan() const;
+
+ private:
+  // The pipeline for the left subtree of the plan
+  Pipeline left_pipeline_;
+
+  // The join key expressions of both sides
+  std::vector<const expression::AbstractExpression *> left_key_exprs_;
+  std::vector<const expression::AbstractExpression *> right_key_exprs_;
+
+  // The (non-key) attributes from the left input we materialize
+  std::vector<const planner::AttributeInfo *> left_val_ais_;
+
+  // The buffer the left input is materialized in, in sorted order. Every
+  // buffered tuple starts with its key values, followed by the left values.
+  QueryState::Id buffer_id_;
+  BufferAccessor buffer_;
+
+  // The position in the buffer of the first tuple whose key is not less than
+  // the key of the last right tuple
+  QueryState::Id cursor_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
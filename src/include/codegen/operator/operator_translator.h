@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "codegen/codegen.h"
 #include "codegen/pipeline.h"
 #include "codegen/query_state.h"
@@ -89,6 +91,13 @@ class OperatorTranslator {
   virtual void Consume(ConsumerContext &context, RowBatch &batch) const;
   virtual void Consume(ConsumerContext &context, RowBatch::Row &row) const = 0;
 
+  /// Called at the end of every serial pipeline the operator is part of, once
+  /// all rows of the pipeline have been consumed. Operators that can only
+  /// produce some of their output at that point (e.g., the unmatched tuples of
+  /// an outer join) send them to their parent here. Such operators must make
+  /// the pipeline serial.
+  virtual void FinishConsume(ConsumerContext &) const {}
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Accessors
@@ -121,6 +130,19 @@ class OperatorTranslator {
   llvm::Value *LoadStatePtr(const QueryState::Id &state_id) const;
   llvm::Value *LoadStateValue(const QueryState::Id &state_id) const;
 
+  // Consume the rows of the batch in groups of the given size, to hide the
+  // latency of cache misses when probing a hash table. A first pass over each
+  // group computes the hash of every row with hash_and_prefetch(), which also
+  // prefetches what probing with the hash touches first. An optional second
+  // pass, prefetch_next(), prefetches what the probe touches after that. Only
+  // then are the rows consumed with their hash, one at a time, by consume().
+  void ConsumeWithPrefetch(
+      RowBatch &batch, uint32_t group_size,
+      const std::function<llvm::Value *(RowBatch::Row &)> &hash_and_prefetch,
+      const std::function<void(llvm::Value *)> &prefetch_next,
+      const std::function<void(RowBatch::Row &, llvm::Value *)> &consume)
+      const;
+
  private:
   // The plan node
   const planner::AbstractPlan &plan_;
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_translator.h
+//
+// Identification: src/include/codegen/operator/set_op_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/oa_hash_table.h"
+#include "codegen/operator/operator_translator.h"
+
+namespace peloton {
+
+namespace planner {
+class SetOpPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for a hash-based set operation, i.e., INTERSECT [ALL] and
+// EXCEPT [ALL]. UNION ALL is an append, and UNION a distinct over an append.
+//===----------------------------------------------------------------------===//
+class SetOpTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  SetOpTranslator(const planner::SetOpPlan &set_op_plan,
+                  CompilationContext &context, Pipeline &pipeline);
+
+  // Codegen any initialization work for this operator
+  void InitializeQueryState() override;
+
+  // No helper functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // The method that consumes tuples from child operators
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // Codegen any cleanup work for this translator
+  void TearDownQueryState() override;
+
+ private:
+  // Pointer to the number of times a distinct tuple appears in the given
+  // input. Both counters are stored as the value of the hash table entry.
+  llvm::Value *CounterPtr(CodeGen &codegen, llvm::Value *data_area,
+                          uint32_t child_idx) const;
+
+  // Count one more appearance of a tuple in the given input
+  void IncrementCounter(CodeGen &codegen, llvm::Value *data_area,
+                        uint32_t child_idx) const;
+
+  // Collect the values of a tuple of the given input
+  void CollectTuple(CodeGen &codegen, RowBatch::Row &row, uint32_t child_idx,
+                    std::vector<codegen::Value> &tuple) const;
+
+  // The number of copies of a distinct tuple in the result
+  llvm::Value *NumOutputCopies(CodeGen &codegen, llvm::Value *data_area) const;
+
+  const planner::SetOpPlan &GetSetOpPlan() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // The callback used when a left tuple finds its entry in the hash table
+  //===--------------------------------------------------------------------===//
+  class CountLeft : public HashTable::ProbeCallback {
+   public:
+    // Constructor
+    explicit CountLeft(const SetOpTranslator &translator);
+
+    // Count the tuple
+    void ProcessEntry(CodeGen &codegen, llvm::Value *data_area) const override;
+
+   private:
+    const SetOpTranslator &translator_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback used when a right tuple finds its entry in the hash table.
+  // Right tuples without an entry never appear in the result, so they are
+  // not inserted.
+  //===--------------------------------------------------------------------===//
+  class CountRight : public HashTable::IterateCallback {
+   public:
+    // Constructor
+    explicit CountRight(const SetOpTranslator &translator);
+
+    // Count the tuple
+    void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                      llvm::Value *data_area) const override;
+
+   private:
+    const SetOpTranslator &translator_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback used when a left tuple is seen for the first time
+  //===--------------------------------------------------------------------===//
+  class InsertTuple : public HashTable::InsertCallback {
+   public:
+    // Constructor
+    explicit InsertTuple(const SetOpTranslator &translator);
+
+    // Store the initial counters of the tuple
+    void StoreValue(CodeGen &codegen, llvm::Value *data_space) const override;
+
+    llvm::Value *GetValueSize(CodeGen &codegen) const override;
+
+   private:
+    const SetOpTranslator &translator_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback used to produce the result from the hash table
+  //===--------------------------------------------------------------------===//
+  class ProduceTuples : public HashTable::IterateCallback {
+   public:
+    // Constructor
+    ProduceTuples(const SetOpTranslator &translator, ConsumerContext &context,
+                  Vector &selection_vector);
+
+    // The callback
+    void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                      llvm::Value *data_area) const override;
+
+   private:
+    const SetOpTranslator &translator_;
+    ConsumerContext &context_;
+    Vector &selection_vector_;
+  };
+
+ private:
+  // The pipelines of the left and right input
+  Pipeline left_pipeline_;
+  Pipeline right_pipeline_;
+
+  // The ID of the hash table in the runtime state
+  QueryState::Id hash_table_id_;
+
+  // The hash table of all distinct tuples of the left input, with the number
+  // of times each appears in either input
+  OAHashTable hash_table_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// sorted_group_by_translator.h
+//
+// Identification: src/include/codegen/operator/sorted_group_by_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/aggregation.h"
+#include "codegen/operator/operator_translator.h"
+#include "codegen/updateable_storage.h"
+
+namespace peloton {
+
+namespace planner {
+class AggregatePlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for a sort-based group-by operator. The input must be sorted
+// on the grouping columns, so that all rows of a group arrive one after the
+// other, and we only ever keep the aggregates of a single group around. Since
+// a group is complete as soon as the next one starts, the operator isn't a
+// pipeline breaker: groups are sent to the parent from within the pipeline
+// of the child.
+//===----------------------------------------------------------------------===//
+class SortedGroupByTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  SortedGroupByTranslator(const planner::AggregatePlan &group_by,
+                          CompilationContext &context, Pipeline &pipeline);
+
+  // Codegen any initialization work for this operator
+  void InitializeQueryState() override;
+
+  // No helper functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // The method that consumes tuples from child operators
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // Send the last group to the parent once the child has produced all tuples
+  void FinishConsume(ConsumerContext &context) const override;
+
+  // Codegen any cleanup work for this translator
+  void TearDownQueryState() override;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // An accessor into a single attribute of a finished group
+  //===--------------------------------------------------------------------===//
+  class GroupAttributeAccess : public RowBatch::AttributeAccess {
+   public:
+    // Constructor
+    GroupAttributeAccess(const std::vector<codegen::Value> &group_vals,
+                         uint32_t index)
+        : group_vals_(group_vals), index_(index) {}
+
+    Value Access(CodeGen &, RowBatch::Row &) override {
+      return group_vals_[index_];
+    }
+
+   private:
+    // All the values of the group
+    const std::vector<codegen::Value> &group_vals_;
+
+    // The value this accessor is for
+    uint32_t index_;
+  };
+
+  // Load the grouping keys of the current group
+  void LoadGroupKeys(std::vector<codegen::Value> &keys) const;
+
+  // Finalize the aggregates of the current group and send the group to the
+  // parent
+  void FinishGroup(ConsumerContext &context) const;
+
+ private:
+  // The class responsible for handling the aggregation for all our aggregates
+  Aggregation aggregation_;
+
+  // The grouping keys and aggregates of the current group in the runtime
+  // state, and whether we have seen any row yet
+  UpdateableStorage group_key_storage_;
+  QueryState::Id group_keys_id_;
+  QueryState::Id group_aggs_id_;
+  QueryState::Id has_group_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -35,6 +35,27 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class TableScanTranslator : public OperatorTranslator {
  public:
+  /**
+   * A filter on the scanned rows whose contents are only known at runtime. A
+   * hash join builds one over the keys of its build side and pushes it into the
+   * scan of its probe side, where rows without a join partner are dropped
+   * before the predicate is evaluated, and tile groups outside the range of the
+   * keys are not scanned at all.
+   */
+  struct RuntimeFilter {
+    // The scanned attributes, in the order the filter was built over
+    std::vector<const planner::AttributeInfo *> attributes;
+
+    // The bloom filter over the values of the attributes
+    QueryState::Id bloom_filter_id;
+
+    // For a single integral attribute, the smallest and largest value (as a
+    // BIGINT) that can pass the filter
+    bool has_range;
+    QueryState::Id min_id;
+    QueryState::Id max_id;
+  };
+
   // Constructor
   TableScanTranslator(const planner::SeqScanPlan &scan,
                       CompilationContext &context, Pipeline &pipeline);
@@ -55,6 +76,12 @@ class TableScanTranslator : public OperatorTranslator {
   // Similar to InitializeQueryState(), table scans don't have any state
   void TearDownQueryState() override {}
 
+  // Install a filter built by an operator the scan produces rows for. The
+  // filter must be complete before the scan starts.
+  void AddRuntimeFilter(const RuntimeFilter &filter) {
+    runtime_filters_.push_back(filter);
+  }
+
  private:
   // Load the table pointer
   llvm::Value *LoadTablePtr(CodeGen &codegen) const;
@@ -74,6 +101,13 @@ class TableScanTranslator : public OperatorTranslator {
  private:
   // The code-generating table instance
   codegen::Table table_;
+
+  // The filters pushed into the scan
+  std::vector<RuntimeFilter> runtime_filters_;
+
+  // The string attribute the predicate reads, if the predicate only reads one
+  // and can be evaluated once per entry of the dictionary of the attribute
+  const planner::AttributeInfo *dictionary_filter_ai_;
 };
 
 }  // namespace codegen
@@ -42,6 +42,13 @@ class ParameterCache {
   codegen::Value GetValue(uint32_t index) const;
   codegen::Value GetValue(const expression::AbstractExpression *expr) const;
 
+  // Get the position of the given expression's value in the query parameters
+  uint32_t GetIndex(const expression::AbstractExpression *expr) const {
+    return parameters_map_.GetIndex(expr);
+  }
+
+  const QueryParametersMap &GetParametersMap() const { return parameters_map_; }
+
   // Clear all cache parameter values
   void Reset();
 
@@ -157,12 +157,25 @@ class Pipeline {
 
   Pipeline(OperatorTranslator *translator, Parallelism parallelism);
 
+  /**
+   * Create a pipeline that runs the operators of the given pipeline from the
+   * given translator upwards, for operators with several inputs that each run
+   * in the position of the operator (e.g., UNION ALL). The new pipeline is
+   * equal to the one it was forked from, but has an ID of its own.
+   */
+  Pipeline(const Pipeline &pipeline, const OperatorTranslator *translator);
+
   void Add(OperatorTranslator *translator, Parallelism parallelism);
 
   void SetSerial() { parallelism_ = Pipeline::Parallelism::Serial; }
 
   void MarkSource(OperatorTranslator *translator, Parallelism parallelism);
 
+  /// Do not call FinishConsume() and FinishPipeline() on the given translator
+  /// and the operators above it at the end of this pipeline, because a
+  /// pipeline forked from this one that runs after it does so
+  void DeferFinish(const OperatorTranslator *translator);
+
   const OperatorTranslator *NextStep();
 
   //////////////////////////////////////////////////////////////////////////////
@@ -203,8 +216,11 @@ class Pipeline {
   /// Return the unique ID of this pipeline
   uint32_t GetId() const { return id_; }
 
-  /// Pipeline equality check (this is more of an **identity** equality check)
-  bool operator==(const Pipeline &other) const { return id_ == other.id_; }
+  /// Pipeline equality check (this is more of an **identity** equality check).
+  /// Forked pipelines are equal to the pipeline they were forked from.
+  bool operator==(const Pipeline &other) const {
+    return origin_id_ == other.origin_id_;
+  }
   bool operator!=(const Pipeline &other) const { return !(*this == other); }
 
   /// Compilation context accessor
@@ -235,9 +251,15 @@ class Pipeline {
   uint32_t GetNumStages() const;
 
  private:
+  // The consumer context rewinds the pipeline, see ConsumeAndRewind()
+  friend class ConsumerContext;
+
   // Unique ID of this pipeline
   uint32_t id_;
 
+  // The ID of the pipeline this one was forked from, or our own ID
+  uint32_t origin_id_;
+
   // The compilation context
   CompilationContext &compilation_ctx_;
 
@@ -254,6 +276,10 @@ class Pipeline {
 
   // Level of parallelism
   Parallelism parallelism_;
+
+  // The number of operators at the top of the pipeline that are finished by
+  // another pipeline, see DeferFinish()
+  uint32_t num_deferred_finish_;
 };
 
 }  // namespace codegen
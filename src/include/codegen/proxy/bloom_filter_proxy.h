@@ -31,6 +31,8 @@ PROXY(BloomFilter) {
   // Methods
   DECLARE_METHOD(Init);
   DECLARE_METHOD(Destroy);
+  DECLARE_METHOD(IsSelective);
+  DECLARE_METHOD(AddStatistics);
 };
 
 TYPE_BUILDER(BloomFilter, util::BloomFilter);
@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table_proxy.h
+//
+// Identification: src/include/codegen/proxy/concurrent_aggregation_table_proxy.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/proxy/proxy.h"
+#include "codegen/util/concurrent_aggregation_table.h"
+
+namespace peloton {
+namespace codegen {
+
+PROXY(ConcurrentAggregationTable) {
+  DECLARE_MEMBER(0, char *, memory);
+  DECLARE_MEMBER(1, uint64_t, key_size);
+  DECLARE_MEMBER(2, uint64_t, num_values);
+  DECLARE_MEMBER(3, uint64_t, update_ops);
+  DECLARE_MEMBER(4, uint64_t, slot_size);
+  DECLARE_MEMBER(5, char *, slots);
+  DECLARE_MEMBER(6, uint64_t, capacity);
+  DECLARE_MEMBER(7, uint64_t, mask);
+  DECLARE_MEMBER(8, uint64_t, resize_threshold);
+  DECLARE_MEMBER(9, uint64_t, num_entries);
+  DECLARE_MEMBER(10,
+                 char[sizeof(util::ConcurrentAggregationTable::ResizeState)],
+                 resize);
+  DECLARE_TYPE;
+
+  DECLARE_METHOD(Init);
+  DECLARE_METHOD(Upsert);
+  DECLARE_METHOD(Destroy);
+};
+
+TYPE_BUILDER(ConcurrentAggregationTable, util::ConcurrentAggregationTable);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -41,6 +41,8 @@ PROXY(CSVScanner) {
   DECLARE_METHOD(Init);
   DECLARE_METHOD(Destroy);
   DECLARE_METHOD(Produce);
+  DECLARE_METHOD(ExecuteParallel);
+  DECLARE_METHOD(NextRow);
 };
 
 TYPE_BUILDER(CSVScanner, codegen::util::CSVScanner);
@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// in_list_proxy.h
+//
+// Identification: src/include/codegen/proxy/in_list_proxy.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/proxy/proxy.h"
+#include "codegen/proxy/query_parameters_proxy.h"
+#include "codegen/util/in_list.h"
+
+namespace peloton {
+namespace codegen {
+
+PROXY(InList) {
+  // Member Variables
+  DECLARE_MEMBER(0, int64_t *, values);
+  DECLARE_MEMBER(1, uint64_t, num_values);
+  DECLARE_MEMBER(2, bool, has_null);
+
+  DECLARE_TYPE;
+
+  // Methods
+  DECLARE_METHOD(Init);
+  DECLARE_METHOD(Destroy);
+};
+
+TYPE_BUILDER(InList, util::InList);
+
+}  // namespace codegen
+}  // namespace peloton
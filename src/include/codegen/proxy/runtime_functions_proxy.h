@@ -25,6 +25,10 @@ PROXY(ColumnLayoutInfo) {
   DECLARE_MEMBER(0, char *, col_start_ptr);
   DECLARE_MEMBER(1, uint32_t, stride);
   DECLARE_MEMBER(2, bool, columnar);
+  DECLARE_MEMBER(3, char *, codes);
+  DECLARE_MEMBER(4, uint32_t, code_width);
+  DECLARE_MEMBER(5, char *, dictionary);
+  DECLARE_MEMBER(6, uint32_t, dictionary_size);
   DECLARE_TYPE;
 };
 
@@ -43,6 +47,7 @@ PROXY(RuntimeFunctions) {
   DECLARE_METHOD(HashCrc64);
   DECLARE_METHOD(GetTileGroup);
   DECLARE_METHOD(GetTileGroupLayout);
+  DECLARE_METHOD(ReleaseTileGroupLayout);
   DECLARE_METHOD(FillPredicateArray);
   DECLARE_METHOD(ExecuteTableScan);
   DECLARE_METHOD(ExecutePerState);
@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_id_map_proxy.h
+//
+// Identification: src/include/codegen/proxy/string_id_map_proxy.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/proxy/proxy.h"
+#include "codegen/util/string_id_map.h"
+
+namespace peloton {
+namespace codegen {
+
+PROXY(StringIdMap) {
+  /// We don't need access to internal fields, so use an opaque byte array
+  DECLARE_MEMBER(0, char[sizeof(util::StringIdMap)], opaque);
+  DECLARE_TYPE;
+
+  // Methods
+  DECLARE_METHOD(Init);
+  DECLARE_METHOD(Destroy);
+  DECLARE_METHOD(GetId);
+  DECLARE_METHOD(GetDictionaryIds);
+  DECLARE_METHOD(GetStrings);
+};
+
+TYPE_BUILDER(StringIdMap, util::StringIdMap);
+
+}  // namespace codegen
+}  // namespace peloton
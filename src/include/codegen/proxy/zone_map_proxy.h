@@ -30,6 +30,7 @@ PROXY(ZoneMapManager) {
   DECLARE_MEMBER(0, char[sizeof(storage::ZoneMapManager)], opaque);
   DECLARE_TYPE;
   DECLARE_METHOD(ShouldScanTileGroup);
+  DECLARE_METHOD(TileGroupOverlapsRange);
   DECLARE_METHOD(GetInstance);
 };
 
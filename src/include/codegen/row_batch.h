@@ -50,6 +50,18 @@ class RowBatch {
 
     // Access the value given the row
     virtual codegen::Value Access(CodeGen &codegen, Row &row) = 0;
+
+    // Is the attribute read from a string column that may be encoded with a
+    // dictionary? If so, GetDictionary() returns the dictionary (an array of
+    // varlen slots) and its size for the current batch, or a null dictionary
+    // if the column isn't encoded in it. AccessCode() returns the code of the
+    // attribute in a row of a batch that has a dictionary.
+    virtual bool HasDictionary() const { return false; }
+    virtual void GetDictionary(CodeGen &, llvm::Value *&dictionary,
+                               llvm::Value *&dictionary_size) {
+      dictionary = dictionary_size = nullptr;
+    }
+    virtual llvm::Value *AccessCode(CodeGen &, Row &) { return nullptr; }
   };
 
   //===--------------------------------------------------------------------===//
@@ -241,6 +253,9 @@ class RowBatch {
 
   llvm::Value *GetTileGroupID() const;
 
+  // Return the accessor of the given attribute, or null if there is none
+  AttributeAccess *GetAttributeAccess(const planner::AttributeInfo *ai) const;
+
   // Return a const reference to the selection vector
   const Vector &GetSelectionVector() const { return selection_vector_; }
 
@@ -50,6 +50,7 @@ class RuntimeFunctions {
                                           uint64_t tile_group_index);
 
   static void FillPredicateArray(const expression::AbstractExpression *expr,
+                                 executor::ExecutorContext *executor_context,
                                  storage::PredicateInfo *predicate_array);
 
   // This struct represents the layout (or configuration) of a column in a
@@ -60,10 +61,19 @@ class RuntimeFunctions {
   // doing strided accesses to mimic columnar storage.  In a pure row-store,
   // the stride is equivalent to the size of the tuple. In a pure column-store
   // (without compression), the stride is equivalent to the size of data type.
+  //
+  // A string column of a frozen tile group is also dictionary-encoded. For
+  // such a column, codes points to the codes of its tuples (code_width bytes
+  // each), and dictionary to the varlen slots of its distinct values, indexed
+  // by code. For all other columns, both are null.
   struct ColumnLayoutInfo {
     char *column;
     uint32_t stride;
     bool is_columnar;
+    char *codes;
+    uint32_t code_width;
+    char *dictionary;
+    uint32_t dictionary_size;
   };
 
   /**
@@ -77,6 +87,14 @@ class RuntimeFunctions {
    */
   static void GetTileGroupLayout(const storage::TileGroup *tile_group,
                                  ColumnLayoutInfo *infos, uint32_t num_cols);
+
+  /**
+   * Let go of the column data GetTileGroupLayout() produced for the tile group,
+   * once the scan of the tile group is done.
+   *
+   * @param tile_group The tile group whose layout was acquired
+   */
+  static void ReleaseTileGroupLayout(const storage::TileGroup *tile_group);
   
   /**
    * Execute a parallel scan over the given table in the given database.
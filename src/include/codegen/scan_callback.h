@@ -31,11 +31,26 @@ class ScanCallback {
   // Virtual destructor
   virtual ~ScanCallback() {}
 
+  // Callback to decide whether to scan the tile group at the given offset in
+  // the table, in addition to the zone maps. All tile groups are scanned by
+  // default.
+  virtual llvm::Value *ShouldScanTileGroup(
+      CodeGen &codegen, UNUSED_ATTRIBUTE llvm::Value *table_ptr,
+      UNUSED_ATTRIBUTE llvm::Value *tile_group_idx) {
+    return codegen.ConstBool(true);
+  }
+
   // Callback for when iteration begins over a new tile group. The second
   // parameter is a pointer to the tile group.
   virtual void TileGroupStart(CodeGen &codegen, llvm::Value *tile_group_id,
                               llvm::Value *tile_group_ptr) = 0;
 
+  // Callback for when the layout of the current tile group is known, before
+  // any of its tuples are processed
+  virtual void TileGroupLayout(
+      UNUSED_ATTRIBUTE CodeGen &codegen,
+      UNUSED_ATTRIBUTE TileGroup::TileGroupAccess &tile_group_access) {}
+
   // Callback to process the tuples with the provided range
   virtual void ProcessTuples(CodeGen &codegen, llvm::Value *tid_start,
                              llvm::Value *tid_end,
@@ -42,11 +42,14 @@ class Table {
 
   /// Generate code to perform a scan over the given table. The table pointer
   /// is provided as the second argument. The scan consumer (third argument)
-  /// should be notified when ready to generate the scan loop body.
+  /// should be notified when ready to generate the scan loop body. The
+  /// executor context provides the values of the parameters the predicates
+  /// may compare with.
   void GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                     llvm::Value *tilegroup_start, llvm::Value *tilegroup_end,
-                    uint32_t batch_size, llvm::Value *predicate_array,
-                    size_t num_predicates, ScanCallback &consumer) const;
+                    uint32_t batch_size, llvm::Value *executor_context_ptr,
+                    llvm::Value *predicate_array, size_t num_predicates,
+                    ScanCallback &consumer) const;
 
   /// Given a table instance, return the number of tile groups in the table.
   llvm::Value *GetTileGroupCount(CodeGen &codegen,
@@ -50,12 +50,19 @@ class TileGroup {
   llvm::Value *GetTileGroupId(CodeGen &codegen, llvm::Value *tile_group) const;
 
  private:
-  // A struct to capture enough information to perform strided accesses
+  // A struct to capture enough information to perform strided accesses. The
+  // codes of a string column are only set if the tile group stores the column
+  // dictionary-encoded, and are always null for the other columns.
   struct ColumnLayout {
     uint32_t col_id;
     llvm::Value *col_start_ptr;
     llvm::Value *col_stride;
     llvm::Value *is_columnar;
+    llvm::Value *codes = nullptr;
+    llvm::Value *code_width = nullptr;
+    llvm::Value *code_mask = nullptr;
+    llvm::Value *dictionary = nullptr;
+    llvm::Value *dictionary_size = nullptr;
   };
 
   /*
@@ -97,6 +104,14 @@ class TileGroup {
   codegen::Value LoadColumn(CodeGen &codegen, llvm::Value *tid,
                             const TileGroup::ColumnLayout &layout) const;
 
+  // Access the dictionary code of a given string column for the row with the
+  // given tid, or the dictionary entry with the given code
+  llvm::Value *LoadCode(CodeGen &codegen, llvm::Value *tid,
+                        const TileGroup::ColumnLayout &layout) const;
+  codegen::Value LoadDictionaryEntry(
+      CodeGen &codegen, llvm::Value *code,
+      const TileGroup::ColumnLayout &layout) const;
+
  public:
   //===--------------------------------------------------------------------===//
   // A convenience class that allows generic access (i.e., either row-oriented
@@ -120,6 +135,10 @@ class TileGroup {
       // Load the column at the given index
       codegen::Value LoadColumn(CodeGen &codegen, uint32_t col_idx) const;
 
+      // Load the dictionary code of the string column at the given index. The
+      // tile group must store the column dictionary-encoded.
+      llvm::Value *LoadCode(CodeGen &codegen, uint32_t col_idx) const;
+
       llvm::Value *GetTID() const { return tid_; }
 
      private:
@@ -134,6 +153,15 @@ class TileGroup {
     // Load a specific row from the batch
     Row GetRow(llvm::Value *tid) const;
 
+    // Is the string column at the given index dictionary-encoded in this tile
+    // group? The result is false for all other columns.
+    llvm::Value *HasDictionary(CodeGen &codegen, uint32_t col_idx) const;
+
+    // Load the entry with the given code from the dictionary of the string
+    // column at the given index
+    codegen::Value LoadDictionaryEntry(CodeGen &codegen, uint32_t col_idx,
+                                       llvm::Value *code) const;
+
     //===------------------------------------------------------------------===//
     // ACCESSORS
     //===------------------------------------------------------------------===//
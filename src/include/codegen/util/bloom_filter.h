@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "codegen/codegen.h"
@@ -35,6 +36,10 @@ class BloomFilter {
   static const double kFalsePositiveRate;
   // Number of hash functions to use.
   static const uint64_t kNumHashFuncs;
+  // Number of probes after which the filter is checked for selectivity
+  static const uint64_t kSelectivitySampleSize;
+  // Fraction of the probes that must miss for the filter to be worth probing
+  static const double kMinMissRate;
 
  public:
   // Initialize bloom filter states
@@ -43,6 +48,14 @@ class BloomFilter {
   // Destroy the bloom filter states
   void Destroy();
 
+  // Is the filter still worth probing? Once it has seen enough probes, it is
+  // not if too few of them missed. Since a filter that is no longer probed
+  // keeps its statistics, it stays that way.
+  bool IsSelective() const;
+
+  // Add the probes and misses a thread counted locally over a batch
+  void AddStatistics(uint64_t num_probes, uint64_t num_misses);
+
  private:
   // Number of hash functions to use
   uint64_t num_hash_funcs_;
@@ -53,11 +66,12 @@ class BloomFilter {
   // The capacity of the underlying bit array
   uint64_t num_bits_;
 
-  // Statistic: number of misses
-  uint64_t num_misses_;
+  // Statistic: number of misses. Parallel scans add their batch counts
+  // concurrently, so both are only ever updated atomically.
+  std::atomic<uint64_t> num_misses_;
 
   // Statistic: number of probes
-  uint64_t num_probes_;
+  std::atomic<uint64_t> num_probes_;
 };
 
 }  // namespace util
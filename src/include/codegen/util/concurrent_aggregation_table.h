@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table.h
+//
+// Identification: src/include/codegen/util/concurrent_aggregation_table.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "executor/executor_context.h"
+
+namespace peloton {
+
+namespace type {
+class AbstractPool;
+}  // namespace type
+
+namespace codegen {
+namespace util {
+
+/**
+ * A linear-probing hash table of groups and their aggregates that all threads
+ * of a parallel aggregation share, instead of each building a table of its own
+ * that must be merged afterwards. This pays off when there are few groups.
+ *
+ * Every group has a fixed-size key, compared bytewise, and a fixed number of
+ * 64-bit aggregates. Each aggregate is updated with its own operation (add,
+ * min or max). Upsert() finds or inserts the group of a key and folds a row's
+ * values into its aggregates, without taking any locks: slots are claimed with
+ * a compare-and-swap, and aggregates are updated atomically.
+ *
+ * The table doubles in size once it's half full. A resize waits for the
+ * threads that are upserting to finish, and stops new upserts from starting.
+ * The old slots are then split into partitions, which all waiting threads
+ * claim and move into the new slots in parallel.
+ *
+ * Each slot holds a tag, the aggregates and the key, in that order. The tag is
+ * zero if the slot is free, one while a thread sets up a new group in it, and
+ * the hash of the key with the top bit set otherwise.
+ */
+class ConcurrentAggregationTable {
+ public:
+  // How an aggregate is updated with a value
+  enum class UpdateOp : uint64_t { Add = 0, Min = 1, Max = 2 };
+
+  // The number of bits that encode the update operation of an aggregate in
+  // the operations passed to Init()
+  static constexpr uint32_t kUpdateOpBits = 2;
+  static constexpr uint32_t kMaxNumValues = 64 / kUpdateOpBits;
+
+  // The top bit of the tag of occupied slots
+  static constexpr uint64_t kOccupied = 1ull << 63;
+
+  /** Constructor */
+  ConcurrentAggregationTable(::peloton::type::AbstractPool &memory,
+                             uint32_t key_size, uint32_t num_values,
+                             uint64_t update_ops, uint64_t num_groups);
+
+  /** Destructor */
+  ~ConcurrentAggregationTable();
+
+  /**
+   * Initialize the provided table
+   *
+   * @param table The table we're setting up
+   * @param key_size The size of the keys in bytes
+   * @param num_values The number of aggregates of each group
+   * @param update_ops The update operation of every aggregate, with
+   * kUpdateOpBits bits each, the first aggregate's in the lowest bits
+   * @param num_groups The estimated number of groups
+   */
+  static void Init(ConcurrentAggregationTable &table,
+                   executor::ExecutorContext &exec_ctx, uint32_t key_size,
+                   uint32_t num_values, uint64_t update_ops,
+                   uint64_t num_groups);
+
+  /**
+   * Clean up all resources allocated by the provided table
+   *
+   * @param table The table we're cleaning up
+   */
+  static void Destroy(ConcurrentAggregationTable &table);
+
+  /**
+   * Fold the given values into the aggregates of the group with the given key,
+   * inserting the group if it doesn't exist yet. The aggregates of a new group
+   * start out as the identity of their update operation.
+   *
+   * This function is called from different threads!
+   *
+   * @param hash The hash value of the key
+   * @param key The key of the group
+   * @param values One value for every aggregate
+   */
+  void Upsert(uint64_t hash, const char *key, const int64_t *values);
+
+  //////////////////////////////////////////////////////////////////////////////
+  ///
+  /// Accessors
+  ///
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t NumEntries() const { return num_entries_; }
+
+  uint64_t Capacity() const { return capacity_; }
+
+  // The aggregates and the key of the group in the slot at the given position,
+  // or nullptr if the slot is free. Only valid while no thread is upserting.
+  const int64_t *Values(uint64_t slot_idx) const;
+  const char *Key(uint64_t slot_idx) const;
+
+  // Where the aggregates and the key are in a slot
+  static constexpr uint32_t ValuesOffset() { return sizeof(uint64_t); }
+
+  static constexpr uint32_t KeyOffset(uint32_t num_values) {
+    return ValuesOffset() + num_values * sizeof(int64_t);
+  }
+
+  static constexpr uint32_t SlotSize(uint32_t key_size, uint32_t num_values) {
+    return KeyOffset(num_values) +
+           ((key_size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1));
+  }
+
+  // The state of a resize, shared by all the threads that move slots
+  struct ResizeState {
+    // Is a resize in progress?
+    std::atomic<bool> resizing;
+    // Are the slots being moved? Threads help moving only while this is set.
+    std::atomic<bool> moving;
+    // The number of threads upserting, and of threads helping to move slots
+    std::atomic<uint32_t> num_upserting;
+    std::atomic<uint32_t> num_helping;
+    // The slots being moved into
+    char *new_slots;
+    uint64_t new_capacity;
+    // The next partition to move, and the number of partitions moved
+    std::atomic<uint64_t> next_partition;
+    std::atomic<uint64_t> num_moved;
+    uint64_t num_partitions;
+  };
+
+ private:
+  // Try to upsert into the current slots, failing if all of them are taken
+  bool TryUpsert(uint64_t hash, const char *key, const int64_t *values,
+                 bool &inserted);
+
+  // Fold the values into the aggregates of the slot
+  void Update(char *slot, const int64_t *values) const;
+
+  // Double the size of the table, unless it was resized since it had the
+  // given capacity
+  void Resize(uint64_t capacity);
+
+  // Wait for a resize to finish, helping to move the slots in the meantime
+  void WaitForResize();
+
+  // Move the partitions of the old slots that aren't claimed yet
+  void MovePartitions();
+
+  char *AllocateSlots(uint64_t capacity);
+
+  std::atomic<uint64_t> &Tag(char *slot) const {
+    return *reinterpret_cast<std::atomic<uint64_t> *>(slot);
+  }
+
+  std::atomic<int64_t> *Aggregates(char *slot) const {
+    return reinterpret_cast<std::atomic<int64_t> *>(slot + ValuesOffset());
+  }
+
+  UpdateOp GetUpdateOp(uint32_t value_idx) const {
+    return static_cast<UpdateOp>(
+        (update_ops_ >> (value_idx * kUpdateOpBits)) &
+        ((1ull << kUpdateOpBits) - 1));
+  }
+
+ private:
+  // The memory allocator used for the slots
+  ::peloton::type::AbstractPool &memory_;
+
+  uint64_t key_size_;
+  uint64_t num_values_;
+  uint64_t update_ops_;
+  uint64_t slot_size_;
+
+  // The slots, a power of two of them
+  char *slots_;
+  uint64_t capacity_;
+  uint64_t mask_;
+  uint64_t resize_threshold_;
+
+  std::atomic<uint64_t> num_entries_;
+
+  ResizeState resize_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
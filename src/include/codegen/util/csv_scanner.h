@@ -16,14 +16,11 @@
 #include <vector>
 
 #include "codegen/type/type.h"
+#include "executor/executor_context.h"
 #include "util/file.h"
 
 namespace peloton {
 
-namespace executor {
-class ExecutorContext;
-}  // namespace executor
-
 namespace type {
 class AbstractPool;
 }  // namespace type
@@ -52,9 +49,17 @@ class CSVScanner {
   // We allocate a maximum of 1GB for the line buffer
   static constexpr uint64_t kMaxAllocSize = (1ul << 30ul);
 
+  // 4MB morsels when scanning a file in parallel
+  static constexpr uint64_t kDefaultMorselSize = (1ul << 22ul);
+
   // The signature of the callback function
   using Callback = void (*)(void *);
 
+  // The signature of the function each thread runs during a parallel scan. It
+  // receives the query state, the thread's state, and a thread-local scanner
+  // from which it pulls rows using NextRow().
+  using ParallelScanFunc = void (*)(void *, void *, CSVScanner *);
+
   /**
    * Column information
    */
@@ -147,6 +152,71 @@ class CSVScanner {
    */
   void Produce();
 
+  /**
+   * Scan the given CSV file in parallel. This is the entry point from codegen
+   * for parallel CSV scans.
+   *
+   * The file is mapped into memory and split into byte-range morsels. Since
+   * quoted fields may contain new-lines, we first determine the quoting state
+   * at the start of every morsel (in parallel) so that each morsel can be
+   * aligned to the first real line boundary at or after its start. One task
+   * per worker thread is then launched; each task owns a thread-local scanner
+   * that dynamically claims morsels until none remain, and invokes the provided
+   * function exactly once with that scanner and the task's thread state.
+   *
+   * @param query_state An opaque (but usually a JITed struct) state used during
+   * query execution.
+   * @param thread_states The set of all thread states.
+   * @param file_path The full path to the CSV file
+   * @param col_types A description of the rows stored in the CSV
+   * @param num_cols The number of columns to expect
+   * @param delimiter The character that separates columns within a row
+   * @param quote The quoting character used to quote data (i.e., strings)
+   * @param escape The character that should appear before any data characters
+   * that match the quote character.
+   * @param func The (ParallelScanFunc) function each task invokes
+   */
+  static void ExecuteParallel(
+      void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+      const char *file_path, const codegen::type::Type *col_types,
+      uint32_t num_cols, char delimiter, char quote, char escape, void *func);
+
+  /**
+   * Like ExecuteParallel(), but with a configurable morsel size.
+   */
+  static void ProduceParallel(
+      void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+      const std::string &file_path, const codegen::type::Type *col_types,
+      uint32_t num_cols, char delimiter, char quote, char escape,
+      ParallelScanFunc func, uint64_t morsel_size);
+
+  /**
+   * Move to the next row of a parallel scan. The columns of the row are
+   * available through GetColumns() if this function returns true.
+   *
+   * @return True if there was another row. False if the scan is complete.
+   */
+  bool NextRow();
+
+  /**
+   * Push a chunk of raw CSV data into the scanner. This is the entry point when
+   * the scanner isn't backed by a file, but is fed data from an external source
+   * (e.g., the CopyData messages of a COPY FROM STDIN). The callback is invoked
+   * once for every complete line in the chunk. A trailing partial line is
+   * buffered until the next chunk arrives, so lines (and quoted sections) may
+   * span chunk boundaries.
+   *
+   * @param data A pointer to the raw CSV bytes
+   * @param len The number of bytes in the chunk
+   */
+  void Feed(const char *data, uint32_t len);
+
+  /**
+   * Signal the end of a pushed stream, producing the buffered trailing line, if
+   * any.
+   */
+  void Finish();
+
   /**
    * Return the list of columns
    *
@@ -170,6 +240,19 @@ class CSVScanner {
   // Produce CSV data stored in the provided line
   void ProduceCSV(char *line);
 
+  // Split the provided line into the column array
+  void ParseLine(char *line);
+
+  // Transfer the next line in the current morsel into the line buffer
+  char *NextLineInMorsel();
+
+  // Claim the next morsel of a parallel scan
+  bool NextMorsel();
+
+  // Produce the line that has been accumulated in the line buffer while being
+  // fed data through Feed()
+  void ProduceBufferedLine();
+
  private:
   // All memory allocations happen from this pool
   peloton::type::AbstractPool &memory_;
@@ -186,6 +269,13 @@ class CSVScanner {
   uint32_t buffer_pos_;
   uint32_t buffer_end_;
 
+  // In a parallel scan, the state shared by all scanners and the unconsumed
+  // portion of the morsel this scanner is working on
+  struct ParallelState;
+  ParallelState *parallel_state_;
+  const char *morsel_pos_;
+  const char *morsel_end_;
+
   // A pointer to the start of a line in the CSV file
   char *line_;
   uint32_t line_len_;
@@ -194,6 +284,10 @@ class CSVScanner {
   // Line number
   uint32_t line_number_;
 
+  // Quoting state carried across chunks when data is pushed through Feed()
+  bool in_quote_;
+  bool last_was_escape_;
+
   // The column delimiter, quote, and escape characters configured for this CSV
   char delimiter_;
   char quote_;
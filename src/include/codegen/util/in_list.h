@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// in_list.h
+//
+// Identification: src/include/codegen/util/in_list.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+namespace peloton {
+namespace codegen {
+
+class QueryParameters;
+
+namespace util {
+
+//===----------------------------------------------------------------------===//
+// The values of a large integral IN-list, e.g., "x IN (1, 2, ..., 100)". The
+// values of the list are query parameters, so we only know them when the query
+// starts. We sort them once then, and generated code looks them up with a
+// binary search instead of comparing against every value.
+//===----------------------------------------------------------------------===//
+class InList {
+ public:
+  // Collect the values of the list, which are the query parameters at the
+  // positions [first_index, first_index + num_values)
+  void Init(const QueryParameters &parameters, uint32_t first_index,
+            uint32_t num_values);
+
+  // Free the values
+  void Destroy();
+
+ private:
+  // The distinct non-NULL values in ascending order. There is always room for
+  // at least one value, so lookups never have to check for an empty list.
+  int64_t *values_;
+
+  // The number of distinct non-NULL values
+  uint64_t num_values_;
+
+  // Does the list contain a NULL?
+  bool has_null_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_matcher.h
+//
+// Identification: src/include/codegen/util/like_matcher.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+namespace peloton {
+
+namespace function {
+class LikePattern;
+}  // namespace function
+
+namespace codegen {
+
+class QueryParameters;
+
+namespace util {
+
+//===----------------------------------------------------------------------===//
+// The pattern of "x LIKE 'pattern'", where the pattern is a constant or a
+// parameter of the query. We only know the pattern when the query starts, so
+// we compile it once then, and generated code matches every row against the
+// compiled pattern.
+//===----------------------------------------------------------------------===//
+class LikeMatcher {
+ public:
+  // Compile the pattern, which is the query parameter at the given position
+  void Init(const QueryParameters &parameters, uint32_t index);
+
+  // Does the given string match the pattern? A NULL pattern matches nothing.
+  bool Match(const char *str, uint32_t length) const;
+
+  // Free the compiled pattern
+  void Destroy();
+
+ private:
+  // The compiled pattern, or nullptr if the pattern is NULL
+  function::LikePattern *pattern_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_id_map.h
+//
+// Identification: src/include/codegen/util/string_id_map.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "type/varlen_slot.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+//===----------------------------------------------------------------------===//
+// Query-wide IDs of strings. A hash aggregation that groups on a string column
+// groups on the IDs of its values instead, and turns them back into strings
+// when it produces its results. Frozen tile groups encode the column with a
+// dictionary of their own, which is mapped to IDs once, so that their rows are
+// grouped by looking up their code rather than by hashing their string.
+//
+// The ID 0 stands for NULL.
+//===----------------------------------------------------------------------===//
+class StringIdMap {
+ public:
+  // Constructor
+  StringIdMap();
+
+  // Destructor
+  ~StringIdMap();
+
+  // Initialize and destroy the given map. These are used from codegen to
+  // invoke the constructor and destructor.
+  static void Init(StringIdMap &map);
+  static void Destroy(StringIdMap &map);
+
+  // Return the ID of the given string, which is NULL if str is null
+  uint32_t GetId(const char *str, uint32_t length);
+
+  // Return the IDs of all entries of the given dictionary, indexed by code.
+  // The dictionary is an array of varlen slots, and a null dictionary has no
+  // IDs. The IDs of the last dictionary are kept, so looking it up again (e.g.,
+  // for the next batch of the same tile group) is free.
+  const uint32_t *GetDictionaryIds(const char *dictionary, uint32_t size);
+
+  // Return the strings of all IDs handed out so far, as an array of varlen
+  // slots indexed by ID
+  const char *GetStrings() const;
+
+ private:
+  // The ID of every string seen so far
+  std::unordered_map<std::string, uint32_t> ids_;
+
+  // A copy of the string of every ID
+  std::vector<peloton::type::VarlenSlot> strings_;
+
+  // The string being looked up, reused to avoid allocating for every lookup
+  std::string key_;
+
+  // The last dictionary looked up, and the IDs of its entries
+  const char *last_dictionary_;
+  std::vector<uint32_t> dictionary_ids_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -12,58 +12,75 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "codegen/codegen.h"
-#include "codegen/lang/if.h"
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/proxy/varlen_proxy.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace codegen {
 
 class Varlen {
  public:
-  // Get the length and the pointer to the variable length object
-  static void SafeGetPtrAndLength(CodeGen &codegen, llvm::Value *varlen_ptr,
+  // Get the length and the pointer to the data of the value stored in the
+  // varlen slot (see type::VarlenSlot) at the given address. The value must
+  // not be NULL.
+  static void SafeGetPtrAndLength(CodeGen &codegen, llvm::Value *slot_ptr,
                                   llvm::Value *&data_ptr, llvm::Value *&len) {
-    auto *varlen_type = VarlenProxy::GetType(codegen);
-
     // The first four bytes are the length, load it here
     auto *len_ptr =
-        codegen->CreateConstInBoundsGEP2_32(varlen_type, varlen_ptr, 0, 0);
-    len = codegen->CreateLoad(codegen.Int32Type(), len_ptr);
+        codegen->CreateBitCast(slot_ptr, codegen.Int32Type()->getPointerTo());
+    len = codegen->CreateLoad(len_ptr);
+
+    // A short value is stored in the slot, right after the length
+    auto *inlined_data = codegen->CreateConstInBoundsGEP1_32(
+        codegen.ByteType(), slot_ptr,
+        offsetof(peloton::type::VarlenSlot, prefix));
 
-    // The four bytes after the start is where the (contiguous) data is
-    data_ptr =
-        codegen->CreateConstInBoundsGEP2_32(varlen_type, varlen_ptr, 0, 1);
+    // A long value is stored in the area the slot points to, after the length.
+    // The area pointer of a short value is garbage, but it is never followed.
+    auto *varlen_type = VarlenProxy::GetType(codegen);
+    auto *area_ptr = codegen->CreateBitCast(
+        codegen->CreateConstInBoundsGEP1_32(
+            codegen.ByteType(), slot_ptr,
+            offsetof(peloton::type::VarlenSlot, area)),
+        varlen_type->getPointerTo()->getPointerTo());
+    auto *area = codegen->CreateLoad(area_ptr);
+    auto *pooled_data = codegen->CreateConstGEP2_32(varlen_type, area, 0, 1);
+
+    auto *is_inlined = codegen->CreateICmpULE(
+        len, codegen.Const32(peloton::type::VARLEN_SLOT_INLINE_LENGTH));
+    data_ptr = codegen->CreateSelect(
+        is_inlined, inlined_data,
+        codegen->CreateBitCast(pooled_data, codegen.CharPtrType()));
   }
 
-  // Get the length and the pointer to the variable length object
-  static void GetPtrAndLength(CodeGen &codegen, llvm::Value *varlen_ptr,
+  // Get the length and the pointer to the data of the value stored in the
+  // varlen slot at the given address, and whether it is NULL
+  static void GetPtrAndLength(CodeGen &codegen, llvm::Value *slot_ptr,
                               llvm::Value *&data_ptr, llvm::Value *&len,
                               llvm::Value *&is_null) {
-    // First check if varlen_ptr (i.e., the Varlen *) is NULL
-    auto *null_varlen =
-        codegen.NullPtr(VarlenProxy::GetType(codegen)->getPointerTo());
-    is_null = codegen->CreateICmpEQ(varlen_ptr, null_varlen);
+    SafeGetPtrAndLength(codegen, slot_ptr, data_ptr, len);
 
-    // Depending on NULL-ness, perform load
-    llvm::Value *null_data = nullptr, *null_len = nullptr;
-    lang::If varlen_is_null{codegen, is_null};
-    {
-      // The pointer is null
-      null_data = codegen.Null(codegen.CharPtrType());
-      null_len = codegen.Const32(0);
-    }
-    varlen_is_null.ElseBlock();
-    {
-      // The pointer is not null, safely load the data and length values
-      SafeGetPtrAndLength(codegen, varlen_ptr, data_ptr, len);
-    }
-    varlen_is_null.EndIf();
+    // A NULL value has the NULL length, and gets a null pointer and length 0
+    is_null = codegen->CreateICmpEQ(
+        len, codegen.Const32(
+                 static_cast<int32_t>(peloton::type::PELOTON_VALUE_NULL)));
+    data_ptr = codegen->CreateSelect(
+        is_null, codegen.Null(codegen.CharPtrType()), data_ptr);
+    len = codegen->CreateSelect(is_null, codegen.Const32(0), len);
+  }
 
-    // Build PHI nodes for the data pointer and length
-    data_ptr = varlen_is_null.BuildPHI(null_data, data_ptr);
-    len = varlen_is_null.BuildPHI(null_len, len);
+  // Store the NULL value in the varlen slot at the given address
+  static void StoreNull(CodeGen &codegen, llvm::Value *slot_ptr) {
+    auto *len_ptr =
+        codegen->CreateBitCast(slot_ptr, codegen.Int32Type()->getPointerTo());
+    codegen->CreateStore(
+        codegen.Const32(
+            static_cast<int32_t>(peloton::type::PELOTON_VALUE_NULL)),
+        len_ptr);
   }
 };
 
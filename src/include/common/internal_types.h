@@ -339,6 +339,11 @@ enum class NetworkMessageType : unsigned char {
   READY_FOR_QUERY = 'Z',
   ROW_DESCRIPTION = 'T',
   DATA_ROW = 'D',
+  COPY_IN_RESPONSE = 'G',
+  COPY_OUT_RESPONSE = 'H',
+  // Copy sub-protocol (sent in both directions)
+  COPY_DATA = 'd',
+  COPY_DONE = 'c',
   // Errors
   HUMAN_READABLE_ERROR = 'M',
   SQLSTATE_CODE_ERROR = 'C',
@@ -351,6 +356,7 @@ enum class NetworkMessageType : unsigned char {
   PARSE_COMMAND = 'P',
   SIMPLE_QUERY_COMMAND = 'Q',
   CLOSE_COMMAND = 'C',
+  COPY_FAIL_COMMAND = 'f',
   // SSL willingness
   SSL_YES = 'S',
   SSL_NO = 'N',
@@ -754,7 +760,8 @@ enum class JoinType {
   RIGHT = 2,                  // right
   INNER = 3,                  // inner
   OUTER = 4,                  // outer
-  SEMI = 5                    // IN+Subquery is SEMI
+  SEMI = 5,                   // EXISTS+Subquery is SEMI
+  ANTI = 6                    // NOT EXISTS+Subquery is ANTI
 };
 std::string JoinTypeToString(JoinType type);
 JoinType StringToJoinType(const std::string &str);
@@ -832,6 +839,8 @@ std::ostream &operator<<(std::ostream &os, const CopyType &type);
 
 enum class ExternalFileFormat {
   CSV,
+  TEXT,
+  BINARY,
 };
 std::string ExternalFileFormatToString(ExternalFileFormat format);
 ExternalFileFormat StringToExternalFileFormat(const std::string &str);
@@ -1363,9 +1372,12 @@ enum class RuleType : uint32_t {
   INSERT_TO_PHYSICAL,
   INSERT_SELECT_TO_PHYSICAL,
   AGGREGATE_TO_HASH_AGGREGATE,
+  AGGREGATE_TO_SORT_AGGREGATE,
   AGGREGATE_TO_PLAIN_AGGREGATE,
   INNER_JOIN_TO_NL_JOIN,
   INNER_JOIN_TO_HASH_JOIN,
+  INNER_JOIN_TO_MERGE_JOIN,
+  SEMI_JOIN_TO_HASH_JOIN,
   IMPLEMENT_DISTINCT,
   IMPLEMENT_LIMIT,
   EXPORT_EXTERNAL_FILE_TO_PHYSICAL,
@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache.h
+//
+// Identification: src/include/common/plan_cache.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/container/cuckoo_map.h"
+#include "common/statement.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace parser {
+class SQLStatement;
+}  // namespace parser
+
+namespace planner {
+class AbstractPlan;
+}  // namespace planner
+
+#define DEFAULT_PLAN_CACHE_CAPACITY 1024
+
+/**
+ * The plan shared by all the queries with the same plan cache key.
+ *
+ * A plan tree is bound to the parameters of the query that executes it, so it
+ * can only run one query at a time. The cached plan therefore keeps a list of
+ * idle instances of the plan tree: a query takes one out with Acquire(), and
+ * the instance is put back once the query drops it. If all instances are busy,
+ * the query plans itself and adds its plan tree with Wrap().
+ */
+class CachedPlan : public std::enable_shared_from_this<CachedPlan> {
+ public:
+  CachedPlan(uint64_t catalog_version, std::set<oid_t> table_oids,
+             std::vector<FieldInfo> tuple_descriptor)
+      : catalog_version_(catalog_version),
+        table_oids_(std::move(table_oids)),
+        tuple_descriptor_(std::move(tuple_descriptor)),
+        invalid_(false) {}
+
+  DISALLOW_COPY(CachedPlan)
+
+  // Take an idle instance of the plan. Returns nullptr if all are busy.
+  std::shared_ptr<planner::AbstractPlan> Acquire();
+
+  // Make the plan tree an instance of this plan, which becomes idle once it
+  // is dropped
+  std::shared_ptr<planner::AbstractPlan> Wrap(
+      std::shared_ptr<planner::AbstractPlan> plan);
+
+  // Drop the idle instances, and the busy ones once they become idle
+  void Invalidate();
+
+  uint64_t GetCatalogVersion() const { return catalog_version_; }
+
+  const std::set<oid_t> &GetReferencedTables() const { return table_oids_; }
+
+  const std::vector<FieldInfo> &GetTupleDescriptor() const {
+    return tuple_descriptor_;
+  }
+
+ private:
+  void Release(std::shared_ptr<planner::AbstractPlan> plan);
+
+  // The version of the catalog the plan was built against
+  const uint64_t catalog_version_;
+
+  const std::set<oid_t> table_oids_;
+
+  const std::vector<FieldInfo> tuple_descriptor_;
+
+  std::mutex idle_plans_lock_;
+
+  // Guarded by idle_plans_lock_
+  bool invalid_;
+
+  std::vector<std::shared_ptr<planner::AbstractPlan>> idle_plans_;
+};
+
+//===--------------------------------------------------------------------===//
+// Plan Cache
+//===--------------------------------------------------------------------===//
+
+/**
+ * Server-wide cache of the plans of the simple query protocol, shared by all
+ * connections.
+ *
+ * Queries are keyed by their fingerprint, which ignores their constants. The
+ * constants a SELECT, UPDATE or DELETE statement compares columns with in its
+ * WHERE clause are lifted into parameters, so all the queries that only differ
+ * in them share a plan. The values of all other constants are part of the key.
+ *
+ * The first query with a key is planned with its own constants, and only
+ * registers the key. The queries with a key that was seen before share a plan
+ * with the lifted constants. The scans of both skip tile groups by the values
+ * of the constants.
+ *
+ * A cached plan is only used by transactions that see the catalog version it
+ * was built against. The plans referencing a table are also dropped when the
+ * StatementCacheManager is notified that the table is no longer valid.
+ */
+class PlanCache {
+ public:
+  PlanCache() {}
+  DISALLOW_COPY(PlanCache)
+
+  static PlanCache &GetInstance();
+
+  /**
+   * @brief Get the plan cache key of the statement
+   *
+   * @param query_string the query the statement was parsed from
+   * @param database_name the database the query runs in
+   * @param statement the parse tree of the statement
+   * @param parameters receives the values of the constants that
+   *  LiftConstants() lifts into parameters
+   * @return the key, or an empty string if the plan of the statement can not
+   *  be cached
+   */
+  static std::string GetKey(const std::string &query_string,
+                            const std::string &database_name,
+                            parser::SQLStatement *statement,
+                            std::vector<type::Value> &parameters);
+
+  // Replace the constants of the statement that are not part of its key by
+  // parameters, in the order GetKey() returned their values in
+  static void LiftConstants(parser::SQLStatement *statement);
+
+  /**
+   * Get the plan of the key. Returns nullptr if it is not cached, or was built
+   * against another version of the catalog.
+   */
+  std::shared_ptr<CachedPlan> Find(const std::string &key,
+                                   uint64_t catalog_version) const;
+
+  // Cache the plan of the key, unless the catalog changed since it was built
+  void Insert(const std::string &key, std::shared_ptr<CachedPlan> plan);
+
+  // Drop the plans referencing the table
+  void InvalidateTableOid(oid_t table_oid);
+
+  // Drop the plans referencing any of the tables
+  void InvalidateTableOids(const std::set<oid_t> &table_oids);
+
+  // Drop all plans
+  void Clear();
+
+  size_t GetSize() const { return plans_.GetSize(); }
+
+ private:
+  CuckooMap<std::string, std::shared_ptr<CachedPlan>> plans_;
+};
+
+}  // namespace peloton
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <array>
 #include <thread>
 #include <vector>
 
@@ -28,6 +29,10 @@
 namespace peloton {
 namespace concurrency {
 
+// Number of threads that can register with the epoch manager. Thread ids
+// must be below it.
+static const size_t MAX_EPOCH_THREAD_COUNT = 1024;
+
 /**
  * @brief      Class for decentralized epoch manager.
  */
@@ -36,6 +41,7 @@ class DecentralizedEpochManager : public EpochManager {
 
 public:
   DecentralizedEpochManager() : 
+    thread_count_(0),
     current_global_epoch_id_(1), 
     next_txn_id_(0),
     snapshot_global_epoch_id_(1),
@@ -70,8 +76,14 @@ public:
     current_global_epoch_id_ = current_epoch_id;
     next_txn_id_ = 0;
     snapshot_global_epoch_id_ = 1;
-    local_epochs_.clear();
-    
+
+    local_epoch_lock_.Lock();
+    for (auto &local_epoch : local_epochs_) {
+      local_epoch.reset();
+    }
+    thread_count_ = 0;
+    local_epoch_lock_.Unlock();
+
     RegisterThread(0);
   }
 
@@ -114,9 +126,14 @@ public:
   }
 
   virtual void RegisterThread(const size_t thread_id) override {
+    PELOTON_ASSERT(thread_id < MAX_EPOCH_THREAD_COUNT);
+
     local_epoch_lock_.Lock();
 
     local_epochs_[thread_id].reset(new LocalEpoch(thread_id));
+    if (thread_id >= thread_count_) {
+      thread_count_ = thread_id + 1;
+    }
 
     local_epoch_lock_.Unlock();
   }
@@ -124,7 +141,7 @@ public:
   virtual void DeregisterThread(const size_t thread_id) override {
     local_epoch_lock_.Lock();
 
-    local_epochs_.erase(thread_id);
+    local_epochs_[thread_id].reset();
 
     local_epoch_lock_.Unlock();
   }
@@ -210,11 +227,15 @@ private:
 private:
 
   /**
-   * Each thread holds a pointer to a local epoch.
+   * Each thread holds a pointer to a local epoch, indexed by thread id.
    * It updates the local epoch to report their local time.
+   * The latch only guards registering and deregistering threads.
    */
   common::synchronization::SpinLatch local_epoch_lock_;
-  std::unordered_map<int, std::unique_ptr<LocalEpoch>> local_epochs_;
+  std::array<std::unique_ptr<LocalEpoch>, MAX_EPOCH_THREAD_COUNT> local_epochs_;
+
+  /** One past the highest thread id registered so far */
+  size_t thread_count_;
   
   /** The global epoch reflects the true time of the system. */
   std::atomic<eid_t> current_global_epoch_id_;
@@ -13,60 +13,56 @@
 
 #pragma once
 
-#include <thread>
-#include <queue>
-#include <vector>
-#include <unordered_map>
-#include <functional>
+#include <map>
 #include <cstdint>
 
 #include "common/internal_types.h"
+#include "common/platform.h"
 #include "common/synchronization/spin_latch.h"
 
 namespace peloton {
 namespace concurrency {
 
+// Number of epochs a thread can have transactions in before it falls back to
+// the (allocating) overflow map
+static const size_t EPOCH_SLOT_COUNT = 8;
+
 /**
- * @brief      Epoch struct
+ * @brief      Epoch slot
  *
  * @param[in]  epoch_id  The epoch identifier
  * @param[in]  txn_count  Number of transactions currently in this epoch
- * 
+ *
  */
-struct Epoch {
-  Epoch(const uint64_t epoch_id, const size_t txn_count):
-    epoch_id_(epoch_id),
-    txn_count_(txn_count) {}
-
-  Epoch(const Epoch& epoch) {
-    this->epoch_id_ = epoch.epoch_id_;
-    this->txn_count_ = epoch.txn_count_;
-  }
-
+struct EpochSlot {
   uint64_t epoch_id_;
-  size_t txn_count_;  /* number of transactions currently in this epoch*/
-};
-
-struct EpochCompare {
-  bool operator()(const std::shared_ptr<Epoch> &lhs, const std::shared_ptr<Epoch> &rhs) {
-    return lhs->epoch_id_ > rhs->epoch_id_;
-  }
+  size_t txn_count_;  /* number of transactions currently in this epoch, the slot is free if 0 */
 };
 
 /**
  * @brief      Class for local epoch.
+ *
+ * A thread is almost always in a handful of epochs only, so they are tracked
+ * in a fixed array of slots that is scanned on every call. Entering and
+ * exiting an epoch does not allocate unless all the slots are taken. The
+ * local epoch is padded so that threads do not share its cache lines.
  */
 class LocalEpoch {
 
 public:
-  LocalEpoch(const size_t thread_id) : 
-    epoch_id_lower_bound_(UINT64_MAX), 
-    thread_id_(thread_id) {}
+  LocalEpoch(const size_t thread_id) :
+    epoch_id_lower_bound_(UINT64_MAX),
+    thread_id_(thread_id) {
+    for (auto &slot : epoch_slots_) {
+      slot.epoch_id_ = 0;
+      slot.txn_count_ = 0;
+    }
+  }
 
   bool EnterEpoch(const eid_t epoch_id, const TimestampType ts_type);
 
   void ExitEpoch(const eid_t epoch_id);
-  
+
   /**
    * @brief      Gets the expired epoch identifier.
    *
@@ -77,14 +73,23 @@ public:
   uint64_t GetExpiredEpochId(const uint64_t current_epoch_id);
 
 private:
+  // Lowest epoch that has transactions, or 0 if there is none
+  uint64_t GetMinActiveEpochId() const;
+
+  char head_padding_[CACHELINE_SIZE];
+
   common::synchronization::SpinLatch epoch_lock_;
-  
+
   uint64_t epoch_id_lower_bound_;
 
   size_t thread_id_;
-  
-  std::priority_queue<std::shared_ptr<Epoch>, std::vector<std::shared_ptr<Epoch>>, EpochCompare> epoch_queue_;
-  std::unordered_map<uint64_t, std::shared_ptr<Epoch>> epoch_map_;
+
+  EpochSlot epoch_slots_[EPOCH_SLOT_COUNT];
+
+  // Transaction counts of the epochs that did not fit in the slots
+  std::map<uint64_t, size_t> overflow_epochs_;
+
+  char tail_padding_[CACHELINE_SIZE];
 };
 
 }
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -152,13 +153,32 @@ class TransactionContext : public Printable {
   void RecordCreate(oid_t database_oid, oid_t table_oid, oid_t index_oid) {
     rw_object_set_.push_back(std::make_tuple(database_oid, table_oid,
                                 index_oid, DDLType::CREATE));
+    catalog_modified_ = true;
   }
 
   void RecordDrop(oid_t database_oid, oid_t table_oid, oid_t index_oid) {
     rw_object_set_.push_back(std::make_tuple(database_oid, table_oid,
                                 index_oid, DDLType::DROP));
+    catalog_modified_ = true;
   }
 
+  /**
+   * @brief      Mark the transaction as having written to the system catalogs.
+   *             The global catalog cache is invalidated when it ends.
+   */
+  inline void SetCatalogModified() { catalog_modified_ = true; }
+
+  inline bool IsCatalogModified() const { return catalog_modified_; }
+
+  /**
+   * @brief      Set the version of the global catalog cache when the
+   *             transaction began. Anything cached from the catalog the
+   *             transaction reads is stamped with it.
+   */
+  inline void SetCatalogVersion(uint64_t version) { catalog_version_ = version; }
+
+  inline uint64_t GetCatalogVersion() const { return catalog_version_; }
+
   void RecordReadOwn(const ItemPointer &);
 
   void RecordUpdate(const ItemPointer &);
@@ -184,6 +204,20 @@ class TransactionContext : public Printable {
 
   void ExecOnCommitTriggers();
 
+  /**
+   * @brief      Adds a function to run once the transaction has committed or
+   *             aborted, e.g., to release a lock it holds until then. The
+   *             actions run in the order they were added.
+   *
+   * @param      action  The function
+   * @param      commit_only  Whether the function only runs if the
+   *             transaction committed, e.g., to publish what it wrote to an
+   *             in-memory cache
+   */
+  void AddOnEndAction(std::function<void()> action, bool commit_only = false);
+
+  void ExecOnEndActions();
+
   /**
    * @brief      Determines if in rw set.
    *
@@ -340,8 +374,21 @@ class TransactionContext : public Printable {
 
   std::unique_ptr<trigger::TriggerSet> on_commit_triggers_;
 
+  struct EndAction {
+    std::function<void()> action;
+    bool commit_only;
+  };
+
+  std::vector<EndAction> on_end_actions_;
+
   /** one default transaction is NOT 'read only' unless it is marked 'read only' explicitly*/
   bool read_only_ = false;
+
+  /** whether the transaction wrote to the system catalogs */
+  bool catalog_modified_ = false;
+
+  /** the global catalog cache version when the transaction began */
+  uint64_t catalog_version_ = 0;
 };
 
 }  // namespace concurrency
@@ -152,8 +152,12 @@ class AbstractJoinExecutor : public AbstractExecutor {
     switch (join_type_) {
       case JoinType::RIGHT:
       case JoinType::OUTER:
+      case JoinType::ANTI:
         no_matching_right_row_sets_[tile_idx].erase(row_idx);
         break;
+      case JoinType::SEMI:
+        matching_right_row_sets_[tile_idx].insert(row_idx);
+        break;
       default:
         break;
     }
@@ -161,7 +165,7 @@ class AbstractJoinExecutor : public AbstractExecutor {
 
   bool BuildOuterJoinOutput();
   bool BuildLeftJoinOutput();
-  bool BuildRightJoinOutput();
+  bool BuildRightJoinOutput(const RowSets &right_row_sets);
 
   //===--------------------------------------------------------------------===//
   // Executor State
@@ -191,6 +195,10 @@ class AbstractJoinExecutor : public AbstractExecutor {
   RowSets no_matching_left_row_sets_;
   RowSets no_matching_right_row_sets_;
 
+  /** @brief Right row sets corresponding to tuples with a matching
+   * counterpart, only tracked by SEMI joins */
+  RowSets matching_right_row_sets_;
+
   /** @brief Left and right matching iterator */
   size_t left_matching_idx = 0;
   size_t right_matching_idx = 0;
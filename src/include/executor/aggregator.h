@@ -12,8 +12,11 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/container_tuple.h"
 #include "executor/abstract_executor.h"
@@ -31,8 +34,14 @@ namespace storage {
 class AbstractTable;
 }
 
+namespace type {
+struct VarlenSlot;
+}
+
 namespace executor {
 
+class LogicalTile;
+
 /*
  * Base class for an individual aggregate that aggregates a specific
  * column for a group
@@ -245,6 +254,10 @@ class AbstractAggregator {
 
   virtual bool Advance(AbstractTuple *next_tuple) = 0;
 
+  /** @brief Advance all visible tuples of a tile. Advances tuple-at-a-time
+   * unless overridden. */
+  virtual bool AdvanceTile(LogicalTile *tile);
+
   virtual bool Finalize() = 0;
 
   virtual ~AbstractAggregator() {}
@@ -324,6 +337,113 @@ class HashAggregator : public AbstractAggregator {
   HashAggregateMapType aggregates_map;
 };
 
+/*
+ * Per-group state of an individual aggregate in the VectorizedAggregator.
+ * Implementations are specialized on the type of the aggregated column, so
+ * a batch of values is advanced without boxing them into type::Values.
+ */
+class AbstractVectorAccumulator {
+ public:
+  virtual ~AbstractVectorAccumulator() {}
+
+  /** @brief Make room for the state of the given number of groups */
+  virtual void Resize(size_t num_groups) = 0;
+
+  /** @brief Advance the groups of the given visible tuples of a tile */
+  virtual void Advance(LogicalTile *tile, const std::vector<oid_t> &tuple_ids,
+                       const std::vector<uint32_t> &group_ids) = 0;
+
+  /** @brief Advance a group with a single tuple */
+  virtual void Advance(const AbstractTuple *tuple, uint32_t group_id) = 0;
+
+  /** @brief Produce the aggregate of a group */
+  virtual type::Value Finalize(uint32_t group_id) const = 0;
+};
+
+/**
+ * @brief Used instead of the HashAggregator and PlainAggregator when all
+ * group-by columns are fixed-width numeric or string columns, and all
+ * aggregated columns are fixed-width numeric columns, see IsSupported().
+ *
+ * Works a tile at a time: the group-by columns are packed into fixed-width
+ * keys that are looked up in a flat open-addressing table, and each aggregate
+ * is then advanced column-at-a-time by a type-specialized accumulator.
+ * Strings are packed as the IDs they are given the first time they are met.
+ * The dictionary codes of frozen tiles are mapped to IDs once per distinct
+ * value, so their strings are neither hashed nor compared per tuple.
+ *
+ * The accumulators are specialized on the column types of the first tile.
+ * Tiles whose columns don't match them, and tuples passed to Advance(), are
+ * aggregated tuple-at-a-time into the same groups.
+ */
+class VectorizedAggregator : public AbstractAggregator {
+ public:
+  VectorizedAggregator(const planner::AggregatePlan *node,
+                       storage::AbstractTable *output_table,
+                       executor::ExecutorContext *econtext, LogicalTile *tile);
+
+  /** @brief Whether the plan can be executed on input like the given tile */
+  static bool IsSupported(const planner::AggregatePlan *node,
+                          LogicalTile *tile);
+
+  bool Advance(AbstractTuple *next_tuple) override;
+
+  bool AdvanceTile(LogicalTile *tile) override;
+
+  bool Finalize() override;
+
+ private:
+  // Whether the columns of the tile have the types we're specialized on
+  bool SupportsTile(LogicalTile *tile) const;
+
+  // Return the ID of the group with the given key, creating it if needed
+  uint32_t FindOrCreateGroup(const int64_t *key, uint64_t hash,
+                             const AbstractTuple *tuple);
+
+  // Double the number of slots in the hash table
+  void Grow();
+
+  // Pack a string group-by column into its word of the keys of the tile
+  void PackStringKeyColumn(LogicalTile *tile, oid_t column_id, size_t key_idx,
+                           size_t num_keys);
+
+  // Pack a group-by value of a single tuple into its word of a key
+  int64_t PackKeyValue(const type::Value &value, type::TypeId type_id);
+
+  // Return the ID of the given string, giving it one if needed
+  int64_t GetStringId(const type::VarlenSlot &slot);
+  int64_t GetStringId(const char *data, uint32_t length);
+
+ private:
+  const size_t num_input_columns_;
+
+  /** @brief The types of the input columns the accumulators are built for */
+  std::vector<type::TypeId> input_types_;
+
+  /** @brief One accumulator per unique aggregate term */
+  std::vector<std::unique_ptr<AbstractVectorAccumulator>> accumulators_;
+
+  /** @brief Hash table slots, holding a group ID + 1, or 0 if empty */
+  std::vector<uint32_t> slots_;
+
+  /** @brief The packed keys and key hashes of all groups */
+  std::vector<int64_t> group_keys_;
+  std::vector<uint64_t> group_hashes_;
+
+  /** @brief The IDs of the strings of the string group-by columns */
+  std::unordered_map<std::string, int64_t> string_ids_;
+
+  /** @brief Deep copy of the first tuple of every group */
+  std::vector<std::vector<type::Value>> first_tuple_values_;
+
+  /** @brief Scratch space for the tile being processed */
+  std::vector<oid_t> tuple_ids_;
+  std::vector<int64_t> tile_keys_;
+  std::vector<uint64_t> tile_hashes_;
+  std::vector<uint32_t> group_ids_;
+  std::vector<int64_t> code_ids_;
+};
+
 /**
  * @brief Used when input is sorted on group-by keys.
  */
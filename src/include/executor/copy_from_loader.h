@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// copy_from_loader.h
+//
+// Identification: src/include/executor/copy_from_loader.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "codegen/type/type.h"
+#include "codegen/util/csv_scanner.h"
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+#include "type/ephemeral_pool.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace concurrency {
+class TransactionContext;
+}  // namespace concurrency
+
+namespace storage {
+class DataTable;
+class TileGroup;
+class Tuple;
+}  // namespace storage
+
+namespace executor {
+
+/**
+ * Loads a stream of CSV or text data into a table. This is the server-side
+ * half of a COPY ... FROM STDIN: the network layer pushes the payload of every
+ * CopyData message into Consume(), and calls Finish() once the client sends
+ * CopyDone.
+ *
+ * CSV rows are split and tokenized by a push-mode codegen::util::CSVScanner.
+ * Rows in Postgres' text format (the default of COPY FROM STDIN) have no
+ * quoting: columns are separated by the delimiter, "\N" is NULL, and special
+ * characters are backslash-escaped. The loader splits and unescapes them
+ * itself. Each attribute is parsed with the same input functions the compiled
+ * CSV scan uses and written straight into a freshly claimed tuple slot, so no
+ * intermediate storage::Tuple or type::Value is materialized per row. Only
+ * tile groups that aren't row stores get the row through a scratch tuple.
+ *
+ * By default, every row is inserted through the regular MVCC path. Callers
+ * can opt into bulk loading, which only takes effect if the loader gets the
+ * table's bulk load lock, i.e., if the table is empty and nobody else is bulk
+ * loading it. Rows are then written into tile groups that are private to the
+ * loader and handed to DataTable::BulkLoad() in Finish(), which builds the
+ * indexes in one go and registers all rows with the transaction at once.
+ * Other transactions can't insert into the table until the loading
+ * transaction commits or aborts.
+ *
+ * All rows are inserted on behalf of the provided transaction. The loader
+ * throws on malformed input or constraint violations; the caller is
+ * responsible for aborting the transaction in that case.
+ */
+class CopyFromLoader {
+ public:
+  CopyFromLoader(storage::DataTable *table,
+                 concurrency::TransactionContext *txn, char delimiter = ',',
+                 char quote = '"', char escape = '"', bool bulk_load = false,
+                 ExternalFileFormat format = ExternalFileFormat::CSV);
+
+  ~CopyFromLoader();
+
+  /// Push a chunk of raw data. Complete rows are loaded immediately.
+  void Consume(const char *data, uint32_t len);
+
+  /// Load the trailing row (if any) after the last chunk was pushed, and
+  /// publish the rows if bulk loading
+  void Finish();
+
+  /// Return the number of rows loaded so far
+  uint64_t GetNumRowsLoaded() const;
+
+ private:
+  // The callback the CSV scanner invokes for every row
+  static void LoadRowCallback(void *loader);
+
+  // Load the row whose attributes have just been tokenized
+  void LoadRow(const codegen::util::CSVScanner::Column *cols);
+
+  // Split and unescape a complete line in text format, and load it
+  void LoadTextLine();
+
+  // Claim a slot in the loader's private tile groups
+  ItemPointer GetBulkLoadSlot();
+
+  // Write all attributes of the row into the given tuple storage
+  void WriteRow(const codegen::util::CSVScanner::Column *cols, char *storage,
+                type::AbstractPool &pool);
+
+  // Free the out-of-line varlen areas the scratch tuple holds
+  void FreeVarlenAreas(char *storage);
+
+  // Parse and write a single attribute into its slot in the tuple storage
+  void WriteAttribute(uint32_t col_idx, const char *ptr, uint32_t len,
+                      char *storage, type::AbstractPool &pool) const;
+
+ private:
+  // The table we're loading into
+  storage::DataTable *table_;
+
+  // The transaction all rows are inserted on behalf of
+  concurrency::TransactionContext *txn_;
+
+  // Scratch memory for the CSV scanner
+  type::EphemeralPool pool_;
+
+  // Per-column type, offset into the tuple and pre-built NULL value
+  std::vector<codegen::type::Type> col_types_;
+  std::vector<uint32_t> col_offsets_;
+  std::vector<type::Value> null_values_;
+
+  // The push-mode CSV tokenizer, only used for CSV data
+  std::unique_ptr<codegen::util::CSVScanner> scanner_;
+
+  // For data in text format, the column delimiter, the line accumulated so
+  // far, and the attributes of the last line
+  char delimiter_;
+  std::string text_line_;
+  std::vector<codegen::util::CSVScanner::Column> text_cols_;
+
+  // The tuple rows are written into before being copied into tile groups
+  // that aren't row stores
+  std::unique_ptr<storage::Tuple> scratch_tuple_;
+
+  // Whether we're bulk loading, and the tile groups we've filled so far
+  bool bulk_load_;
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups_;
+
+  // The number of rows loaded so far
+  uint64_t num_rows_loaded_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(CopyFromLoader);
+};
+
+}  // namespace executor
+}  // namespace peloton
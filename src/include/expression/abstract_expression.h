@@ -119,7 +119,10 @@ class AbstractExpression : public Printable {
   ///
   //////////////////////////////////////////////////////////////////////////////
 
-  bool IsZoneMappable();
+  // The predicates on parameters are only zone mappable given the map of the
+  // parameters of the query, which locates their values when it runs
+  bool IsZoneMappable(
+      const codegen::QueryParametersMap *parameters_map = nullptr);
 
   size_t GetNumberofParsedPredicates() const {
     return parsed_predicates.size();
@@ -153,6 +156,17 @@ class AbstractExpression : public Printable {
     return true;
   }
 
+  // Does this expression always return the same result for the same input?
+  // Only then can it be evaluated once for many tuples with equal values.
+  virtual bool IsDeterministic() const {
+    for (uint32_t i = 0; i < GetChildrenSize(); i++) {
+      if (!children_[i]->IsDeterministic()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Get all the attributes this expression uses
   virtual void GetUsedAttributes(
       std::unordered_set<const planner::AttributeInfo *> &attributes) const;
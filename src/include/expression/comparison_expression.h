@@ -58,6 +58,13 @@ class ComparisonExpression : public AbstractExpression {
   const std::string GetInfo(int num_indent) const override;
 
   const std::string GetInfo() const override;
+
+ private:
+  // Evaluate "needle IN (v1, v2, ...)", where the right child is the list
+  type::Value EvaluateInList(const type::Value &needle,
+                             const AbstractTuple *tuple1,
+                             const AbstractTuple *tuple2,
+                             executor::ExecutorContext *context) const;
 };
 
 }  // namespace expression
@@ -692,21 +692,25 @@ class ExpressionUtil {
 
   /*
    * Recursively call on each child and fill in the predicate array.
-   * Returns true for zone mappable predicate.
+   * Returns true for zone mappable predicate. Given the map of the query
+   * parameters (see codegen::QueryParametersMap), which hold the values of
+   * the constants too, a predicate gets the position of its value in them as
+   * a PARAMETER_OFFSET value. Predicates on parameters need the map.
    * */
   static bool GetPredicateForZoneMap(
       std::vector<storage::PredicateInfo> &predicate_restrictions,
-      const expression::AbstractExpression *expr) {
+      const expression::AbstractExpression *expr,
+      const codegen::QueryParametersMap *parameters_map = nullptr) {
     if (expr == nullptr) {
       return false;
     }
     auto expr_type = expr->GetExpressionType();
     // If its and, split children and parse again
     if (expr_type == ExpressionType::CONJUNCTION_AND) {
-      bool left_expr =
-          GetPredicateForZoneMap(predicate_restrictions, expr->GetChild(0));
-      bool right_expr =
-          GetPredicateForZoneMap(predicate_restrictions, expr->GetChild(1));
+      bool left_expr = GetPredicateForZoneMap(
+          predicate_restrictions, expr->GetChild(0), parameters_map);
+      bool right_expr = GetPredicateForZoneMap(
+          predicate_restrictions, expr->GetChild(1), parameters_map);
 
       if ((!left_expr) || (!right_expr)) {
         return false;
@@ -718,13 +722,24 @@ class ExpressionUtil {
                expr_type == ExpressionType::COMPARE_LESSTHANOREQUALTO ||
                expr_type == ExpressionType::COMPARE_GREATERTHAN ||
                expr_type == ExpressionType::COMPARE_GREATERTHANOREQUALTO) {
-      // The right child should be a constant.
+      // The right child should be a constant, or a parameter whose value is
+      // filled in when the query runs.
       auto right_child = expr->GetModifiableChild(1);
 
-      if (right_child->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
-        auto right_exp = (const expression::ConstantValueExpression
-                              *)(expr->GetModifiableChild(1));
-        auto predicate_val = right_exp->GetValue();
+      if (right_child->GetExpressionType() == ExpressionType::VALUE_CONSTANT ||
+          (right_child->GetExpressionType() ==
+               ExpressionType::VALUE_PARAMETER &&
+           parameters_map != nullptr)) {
+        type::Value predicate_val;
+        if (parameters_map != nullptr) {
+          predicate_val = type::ValueFactory::GetParameterOffsetValue(
+              static_cast<int32_t>(parameters_map->GetIndex(right_child)));
+        } else {
+          predicate_val =
+              static_cast<const expression::ConstantValueExpression *>(
+                  right_child)
+                  ->GetValue();
+        }
         // Get the column id for this predicate
         auto left_exp =
             (const expression::TupleValueExpression *)(expr->GetModifiableChild(
@@ -55,6 +55,14 @@ class FunctionExpression : public AbstractExpression {
 
   const std::string GetInfo() const override;
 
+  // The volatility of UDFs is unknown, and now() changes between calls
+  bool IsDeterministic() const override {
+    if (is_udf_ || func_.op_id == OperatorId::Now) {
+      return false;
+    }
+    return AbstractExpression::IsDeterministic();
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Accessors
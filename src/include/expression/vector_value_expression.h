@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vector_value_expression.h
+//
+// Identification: src/include/expression/vector_value_expression.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "expression/abstract_expression.h"
+
+#include <string>
+#include <vector>
+
+#include "common/sql_node_visitor.h"
+
+namespace peloton {
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// VectorValueExpression
+//
+// A list of values, e.g., the right side of "x IN (1, 2, 3)". The values are
+// the children of the expression. A vector does not evaluate to a single
+// value, its parent (i.e., the IN comparison) evaluates the children itself.
+//===----------------------------------------------------------------------===//
+class VectorValueExpression : public AbstractExpression {
+ public:
+  // The vector takes ownership of the values
+  explicit VectorValueExpression(const std::vector<AbstractExpression *> &values)
+      : AbstractExpression(ExpressionType::VALUE_VECTOR) {
+    for (auto *value : values) {
+      children_.emplace_back(value);
+    }
+    DeduceExpressionType();
+  }
+
+  type::Value Evaluate(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                       executor::ExecutorContext *context) const override;
+
+  // All the values of a vector are of the type of its first value
+  void DeduceExpressionType() override {
+    if (!children_.empty()) {
+      return_value_type_ = children_[0]->GetValueType();
+    }
+  }
+
+  AbstractExpression *Copy() const override {
+    return new VectorValueExpression(*this);
+  }
+
+  void Accept(SqlNodeVisitor *v) override { v->Visit(this); }
+
+  const std::string GetInfo(int num_indent) const override;
+
+  const std::string GetInfo() const override;
+
+ protected:
+  VectorValueExpression(const VectorValueExpression &other)
+      : AbstractExpression(other) {}
+};
+
+}  // namespace expression
+}  // namespace peloton
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// like_pattern.h
+//
+// Identification: src/include/function/like_pattern.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace peloton {
+namespace function {
+
+/**
+ * A LIKE pattern, compiled once and matched against any number of strings.
+ * Like StringFunctions::Like, matching ignores the case of ASCII letters, and
+ * '\' escapes the next character of the pattern.
+ *
+ * The pattern is split at its '%' wildcards into segments of fixed length,
+ * which are matched left to right: the first and last segments at the ends of
+ * the string (unless the pattern starts or ends with '%'), and every other
+ * segment at its leftmost occurrence after the previous one. This never needs
+ * to backtrack. The common shapes of patterns are classified so that they are
+ * matched with a single comparison or substring search.
+ */
+class LikePattern {
+ public:
+  enum class Kind {
+    EXACT,     // "abc"
+    PREFIX,    // "abc%"
+    SUFFIX,    // "%abc"
+    CONTAINS,  // "%abc%"
+    GENERAL    // anything else, e.g., "a_c%" or "%a%b%"
+  };
+
+  // The empty pattern
+  LikePattern() { Compile("", 0); }
+
+  LikePattern(const char *pattern, uint32_t length) { Compile(pattern, length); }
+
+  /**
+   * Compile the given pattern. As for all VARCHAR values, the length may
+   * include a terminating '\0', which is not part of the pattern.
+   */
+  void Compile(const char *pattern, uint32_t length);
+
+  /**
+   * Does the given string match the pattern? The length may include a
+   * terminating '\0'.
+   */
+  bool Match(const char *str, uint32_t length) const;
+
+  Kind GetKind() const { return kind_; }
+
+ private:
+  // A run of the pattern without '%'
+  struct Segment {
+    // The position of the first byte in bytes_
+    uint32_t offset;
+    uint32_t length;
+    // Does the segment contain '_'?
+    bool has_any;
+  };
+
+  // Find the leftmost occurrence of the segment in str[begin, end), or return
+  // end if there is none
+  uint32_t Find(const Segment &segment, const char *str, uint32_t begin,
+                uint32_t end) const;
+
+  // Does the segment occur at the given position of the string?
+  bool MatchAt(const Segment &segment, const char *str) const;
+
+ private:
+  Kind kind_;
+
+  // A pattern ending with an unmatched '\' matches nothing
+  bool never_matches_;
+
+  // Does the pattern start or end with '%'?
+  bool leading_wildcard_;
+  bool trailing_wildcard_;
+
+  // Does the pattern contain no ASCII letters? Then its bytes are compared as
+  // they are, without folding the case of the string.
+  bool caseless_;
+
+  // The lower-cased bytes of all segments, without escapes. '_' is kept as a
+  // placeholder, and any_ tells it from an escaped '_'.
+  std::string bytes_;
+  std::vector<bool> any_;
+
+  std::vector<Segment> segments_;
+};
+
+}  // namespace function
+}  // namespace peloton
@@ -13,13 +13,16 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "common/item_pointer.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/internal_types.h"
+#include "common/synchronization/readwrite_latch.h"
 
 namespace peloton {
 
@@ -27,6 +30,10 @@ namespace concurrency {
 class TransactionContext;
 }
 
+namespace index {
+class Index;
+}
+
 namespace storage {
 class TileGroup;
 }
@@ -78,12 +85,36 @@ class GCManager {
   virtual void RecycleTransaction(
                       concurrency::TransactionContext *txn UNUSED_ATTRIBUTE) {}
 
+  // A tile group that was replaced by a copy of it (e.g., a frozen one) is
+  // handed over here, as the transactions that started before the swap may
+  // still read it. Without a GC there is no telling when they are done, so it
+  // is kept around.
+  virtual void RecycleTileGroup(std::shared_ptr<storage::TileGroup> tile_group);
+
+  // Indexes that defer freeing their own nodes until no transaction can read
+  // them (e.g., the Bw-Tree) register here, so that the GC threads reclaim
+  // their garbage. The registry does not depend on the configured GC type.
+  // Such indexes may only be accessed from within a transaction, except by
+  // the GC threads themselves.
+  static void RegisterIndex(index::Index *index);
+
+  static void DeregisterIndex(index::Index *index);
+
  protected:
   void CheckAndReclaimVarlenColumns(storage::TileGroup *tile_group,
                                     oid_t tuple_id);
 
  protected:
   volatile bool is_running_;
+
+  // The replaced tile groups that are kept around
+  std::mutex replaced_tile_groups_mutex_;
+  std::vector<std::shared_ptr<storage::TileGroup>> replaced_tile_groups_;
+
+  // Latch protecting the registered indexes
+  static common::synchronization::ReadWriteLatch index_latch_;
+
+  static std::unordered_set<index::Index *> indexes_;
 };
 
 }  // namespace gc
@@ -36,14 +36,19 @@ namespace gc {
 class TransactionLevelGCManager : public GCManager {
  public:
   TransactionLevelGCManager(const int thread_count)
-      : gc_thread_count_(thread_count), reclaim_maps_(thread_count) {
+      : gc_thread_count_(thread_count),
+        reclaim_maps_(thread_count),
+        tile_group_reclaim_maps_(thread_count) {
     unlink_queues_.reserve(thread_count);
+    tile_group_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
       std::shared_ptr<LockFreeQueue<concurrency::TransactionContext* >>
           unlink_queue(new LockFreeQueue<concurrency::TransactionContext* >(
               MAX_QUEUE_LENGTH));
       unlink_queues_.push_back(unlink_queue);
       local_unlink_queues_.emplace_back();
+      tile_group_queues_.emplace_back(
+          new LockFreeQueue<ReplacedTileGroup>(MAX_QUEUE_LENGTH));
     }
   }
 
@@ -67,6 +72,15 @@ class TransactionLevelGCManager : public GCManager {
     reclaim_maps_.resize(gc_thread_count_);
     recycle_queue_map_.clear();
 
+    tile_group_queues_.clear();
+    tile_group_reclaim_maps_.clear();
+    tile_group_reclaim_maps_.resize(gc_thread_count_);
+    tile_group_queues_.reserve(gc_thread_count_);
+    for (int i = 0; i < gc_thread_count_; ++i) {
+      tile_group_queues_.emplace_back(
+          new LockFreeQueue<ReplacedTileGroup>(MAX_QUEUE_LENGTH));
+    }
+
     is_running_ = false;
   }
 
@@ -107,6 +121,9 @@ class TransactionLevelGCManager : public GCManager {
 
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual void RecycleTileGroup(
+      std::shared_ptr<storage::TileGroup> tile_group) override;
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
@@ -156,7 +173,18 @@ class TransactionLevelGCManager : public GCManager {
   // this function unlinks a specified version from the index.
   void UnlinkVersion(const ItemPointer location, const GCVersionType type);
 
+  // this function frees the garbage of the registered indexes that are
+  // assigned to this thread.
+  void ReclaimIndexGarbage(const int &thread_id);
+
+  // Release the replaced tile groups no active transaction can read anymore
+  int ReclaimTileGroups(const int &thread_id, const eid_t &expired_eid);
+
  private:
+  // A replaced tile group, and the epoch in which it was replaced
+  using ReplacedTileGroup =
+      std::pair<eid_t, std::shared_ptr<storage::TileGroup>>;
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -186,6 +214,16 @@ class TransactionLevelGCManager : public GCManager {
   std::unordered_map<oid_t,
                      std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>>
       recycle_queue_map_;
+
+  // index entries are deleted under the read latch, index garbage is freed
+  // under the write latch.
+  common::synchronization::ReadWriteLatch index_unlink_latch_;
+
+  std::vector<std::unique_ptr<peloton::LockFreeQueue<ReplacedTileGroup>>>
+      tile_group_queues_;
+
+  std::vector<std::multimap<eid_t, std::shared_ptr<storage::TileGroup>>>
+      tile_group_reclaim_maps_;
 };
 }
 }  // namespace peloton
@@ -53,6 +53,7 @@
 
 #ifdef BWTREE_PELOTON
 
+#include "concurrency/epoch_manager_factory.h"
 #include "index/index.h"
 
 #endif
@@ -87,6 +88,17 @@ using NodeID = uint64_t;
  */
 #define USE_OLD_EPOCH
 
+/*
+ * USE_TXN_EPOCH - This flag lets the epoch manager of the DBMS decide when
+ *                 garbage nodes could be freed, instead of the epochs of the
+ *                 tree. Worker threads then do not join or leave any epoch
+ *                 inside the tree, since their transaction has already
+ *                 entered one. This takes precedence over USE_OLD_EPOCH
+ */
+#ifdef BWTREE_PELOTON
+#define USE_TXN_EPOCH
+#endif
+
 /*
  * BWTREE_TEMPLATE_ARGUMENTS - Save some key strokes
  */
@@ -7007,6 +7019,202 @@ class BwTree : public BwTreeBase {
     return ret;
   }
 
+  /*
+   * BulkLoad() - Build the tree bottom-up from a sorted list of key-value pairs
+   *
+   * Instead of inserting items one by one (which traverses the tree and posts
+   * a delta record per item), leaf nodes are packed directly from the sorted
+   * input, and each level of inner nodes is then built from the low keys of
+   * the level below it until a single root remains. Nodes are filled to three
+   * quarters of the split threshold so that subsequent inserts do not
+   * immediately trigger SMOs. Items with equal keys are never separated across
+   * two leaf nodes, the same invariant that leaf splits maintain.
+   *
+   * Readers may access the tree during the load. All new nodes except the
+   * left-most leaf are installed under fresh NodeIDs where nobody could reach
+   * them. The new tree is then published with a single CAS that replaces the
+   * empty first leaf: from then on the old root reaches all new leaves
+   * through their sibling links. Installing the new root afterwards only
+   * shortens traversals. The old root and leaf are retired through the epoch
+   * manager, since readers could still be on them.
+   *
+   * The caller must guarantee that no other thread modifies the tree during
+   * the load. Items must be sorted by key.
+   *
+   * This function returns false without modifying the tree if it is not empty
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &items) {
+    // Check that the tree is still in its initial state
+    NodeID old_root_id = root_id.load();
+    const BaseNode *root_p = GetNode(old_root_id);
+    const BaseNode *leaf_p = GetNode(first_leaf_id);
+    if (root_p->GetType() != NodeType::InnerType ||
+        root_p->GetItemCount() != 1 || leaf_p->GetType() != NodeType::LeafType ||
+        leaf_p->GetItemCount() != 0) {
+      return false;
+    }
+
+    if (items.empty() == true) {
+      return true;
+    }
+
+    static constexpr size_t leaf_fill = LEAF_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+    static constexpr size_t inner_fill =
+        INNER_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+
+    // Splits [0, count) into evenly-sized chunks no larger than the given fill
+    auto chunk_size = [](size_t count, size_t fill) {
+      size_t num_chunks = (count + fill - 1) / fill;
+      return (count + num_chunks - 1) / num_chunks;
+    };
+
+    // 1. Carve the input into leaf ranges, extending a range until the key
+    //    changes so that equal keys stay within a single leaf
+    std::vector<std::pair<size_t, size_t>> leaf_ranges;
+    size_t target = chunk_size(items.size(), leaf_fill);
+    for (size_t start = 0; start < items.size();) {
+      size_t end = std::min(start + target, items.size());
+      while ((end < items.size()) &&
+             (KeyCmpEqual(items[end].first, items[end - 1].first) == true)) {
+        end++;
+      }
+      leaf_ranges.emplace_back(start, end);
+      start = end;
+    }
+
+    // The left-most leaf keeps the first leaf ID since iterators start their
+    // traversal there. It is only installed once the whole tree is built.
+    std::vector<NodeID> leaf_ids(leaf_ranges.size());
+    leaf_ids[0] = first_leaf_id;
+    for (size_t i = 1; i < leaf_ids.size(); i++) {
+      leaf_ids[i] = GetNextNodeID();
+    }
+
+    // All NodeIDs we install before publishing, so that we could take them
+    // back if publishing fails
+    std::vector<NodeID> new_ids;
+    const LeafNode *first_leaf_p = nullptr;
+
+    // The separators (low key, node ID) of the level we just built
+    std::vector<KeyNodeIDPair> level;
+    level.reserve(leaf_ranges.size());
+
+    for (size_t i = 0; i < leaf_ranges.size(); i++) {
+      size_t start = leaf_ranges[i].first, end = leaf_ranges[i].second;
+      int size = static_cast<int>(end - start);
+
+      // The left-most leaf has -Inf as low key; the last leaf +Inf as high key
+      KeyNodeIDPair low_key =
+          (i == 0 ? std::make_pair(KeyType(), INVALID_NODE_ID)
+                  : std::make_pair(items[start].first, ~INVALID_NODE_ID));
+      KeyNodeIDPair high_key =
+          (i + 1 == leaf_ranges.size()
+               ? std::make_pair(KeyType(), INVALID_NODE_ID)
+               : std::make_pair(items[end].first, leaf_ids[i + 1]));
+
+      LeafNode *node_p =
+          reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
+              size, NodeType::LeafType, 0, size, low_key, high_key));
+      node_p->PushBack(items.data() + start, items.data() + end);
+      if (i == 0) {
+        first_leaf_p = node_p;
+      } else {
+        InstallNewNode(leaf_ids[i], node_p);
+        new_ids.push_back(leaf_ids[i]);
+      }
+
+      level.emplace_back(i == 0 ? KeyType() : items[start].first, leaf_ids[i]);
+    }
+
+    // 2. Build levels of inner nodes until we've produced the root. There is
+    //    always at least one inner level since the root must be an inner node.
+    do {
+      size_t fill = chunk_size(level.size(), inner_fill);
+      size_t num_nodes = (level.size() + fill - 1) / fill;
+
+      std::vector<NodeID> node_ids(num_nodes);
+      for (size_t i = 0; i < num_nodes; i++) {
+        node_ids[i] = GetNextNodeID();
+      }
+
+      std::vector<KeyNodeIDPair> next_level;
+      next_level.reserve(num_nodes);
+
+      for (size_t i = 0; i < num_nodes; i++) {
+        size_t start = i * fill;
+        size_t end = std::min(start + fill, level.size());
+        int size = static_cast<int>(end - start);
+
+        KeyNodeIDPair high_key =
+            (i + 1 == num_nodes
+                 ? std::make_pair(KeyType(), INVALID_NODE_ID)
+                 : std::make_pair(level[end].first, node_ids[i + 1]));
+
+        // The first separator doubles as the low key of the node
+        InnerNode *node_p =
+            reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
+                size, NodeType::InnerType, 0, size, level[start], high_key));
+        node_p->PushBack(level.data() + start, level.data() + end);
+        InstallNewNode(node_ids[i], node_p);
+        new_ids.push_back(node_ids[i]);
+
+        next_level.emplace_back(level[start].first, node_ids[i]);
+      }
+
+      level = std::move(next_level);
+    } while (level.size() > 1);
+
+    NodeID new_root_id = level[0].second;
+
+    // 3. Publish all leaves at once by replacing the empty first leaf. If
+    //    someone got in before us, nobody could have seen the new nodes, so
+    //    we free them right away
+    if (InstallNodeToReplace(first_leaf_id, first_leaf_p, leaf_p) == false) {
+      epoch_manager.FreeEpochDeltaChain(first_leaf_p);
+      FreeUnpublishedNodes(new_ids, true);
+
+      return false;
+    }
+
+    epoch_manager.AddGarbageNode(leaf_p);
+
+    // 4. Switch to the new root. Nothing but the load could have changed the
+    //    root of an empty tree, so this should not fail. If it does, the old
+    //    root still reaches all leaves, and the new inner nodes were never
+    //    reachable, so we free them right away
+    if (InstallRootNode(old_root_id, new_root_id) == true) {
+      epoch_manager.AddGarbageNode(new InnerRemoveNode{old_root_id, root_p});
+      epoch_manager.AddGarbageNode(root_p);
+    } else {
+      FreeUnpublishedNodes(new_ids, false);
+    }
+
+    return true;
+  }
+
+  /*
+   * FreeUnpublishedNodes() - Free nodes built by BulkLoad() that no thread
+   *                          could have reached
+   *
+   * Inner nodes are always freed. Leaf nodes are only freed if free_leaves
+   * is true, since they could already be linked into the tree
+   */
+  void FreeUnpublishedNodes(const std::vector<NodeID> &node_ids,
+                            bool free_leaves) {
+    for (NodeID node_id : node_ids) {
+      const BaseNode *node_p = GetNode(node_id);
+      if (free_leaves == false && node_p->IsOnLeafDeltaChain() == true) {
+        continue;
+      }
+
+      // Not InvalidateNodeID(), since these IDs were never published
+      mapping_table[node_id] = nullptr;
+      epoch_manager.FreeEpochDeltaChain(node_p);
+    }
+
+    return;
+  }
+
   /*
    * Insert() - Insert a key-value pair
    *
@@ -7324,11 +7532,17 @@ class BwTree : public BwTreeBase {
    * time GC was called, then GC is unnecessary since read operation does not
    * modify any data structure
    *
-   * Currently we just leave the interface as a placeholder, which returns true
-   * everytime to force GC thred to at least take a look into the epoch
-   * counter.
+   * With USE_TXN_EPOCH we know exactly whether there are garbage nodes
+   * waiting. Otherwise this returns true everytime to force GC thread to at
+   * least take a look into the epoch counter.
    */
-  bool NeedGarbageCollection() { return true; }
+  bool NeedGarbageCollection() {
+#ifdef USE_TXN_EPOCH
+    return epoch_manager.garbage_count.load() != 0UL;
+#else
+    return true;
+#endif
+  }
 
   /*
    * PerformGarbageCollection() - Interface function for external users to
@@ -7435,6 +7649,9 @@ class BwTree : public BwTreeBase {
     struct GarbageNode {
       const BaseNode *node_p;
 
+      // The DBMS epoch in which the node was unlinked (USE_TXN_EPOCH only)
+      uint64_t delete_epoch;
+
       // This does not have to be atomic, since we only
       // insert at the head of garbage list
       GarbageNode *next_p;
@@ -7481,6 +7698,11 @@ class BwTree : public BwTreeBase {
     // Otherwise it points to a thread created by EpochManager internally
     std::thread *thread_p;
 
+#ifdef USE_TXN_EPOCH
+    // The number of garbage nodes waiting to be freed
+    std::atomic<size_t> garbage_count;
+#endif
+
 // The counter that counts how many free is called
 // inside the epoch manager
 // NOTE: We cannot precisely count the size of memory freed
@@ -7526,6 +7748,10 @@ class BwTree : public BwTreeBase {
       // This is used to notify the cleaner thread that it has ended
       exited_flag.store(false);
 
+#ifdef USE_TXN_EPOCH
+      garbage_count = 0UL;
+#endif
+
 // Initialize atomic counter to record how many
 // freed has been called inside epoch manager
 #ifdef BWTREE_DEBUG
@@ -7671,7 +7897,129 @@ class BwTree : public BwTreeBase {
       return;
     }
 
-#ifdef USE_OLD_EPOCH
+#if defined(USE_TXN_EPOCH)
+
+    /*
+     * AddGarbageNode() - Add garbage node tagged with the current DBMS epoch
+     *
+     * All garbage nodes live in the garbage list of the only epoch node. The
+     * node could be freed once all transactions that have entered an epoch
+     * no later than the tag have exited, since only those could have seen
+     * the node before it was unlinked
+     *
+     * NOTE: This function is called by worker threads so it has
+     * to consider race conditions
+     */
+    void AddGarbageNode(const BaseNode *node_p) {
+      GarbageNode *garbage_node_p = new GarbageNode;
+      garbage_node_p->node_p = node_p;
+      garbage_node_p->delete_epoch =
+          concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+
+      PushGarbageList(garbage_node_p, garbage_node_p);
+      garbage_count.fetch_add(1);
+
+      return;
+    }
+
+    /*
+     * PushGarbageList() - CAS a linked list of garbage nodes onto the head
+     *                     of the garbage list
+     */
+    void PushGarbageList(GarbageNode *first_p, GarbageNode *last_p) {
+      last_p->next_p = current_epoch_p->garbage_list_p.load();
+
+      while (1) {
+        bool ret = current_epoch_p->garbage_list_p.compare_exchange_strong(
+            last_p->next_p, first_p);
+
+        if (ret == true) {
+          break;
+        } else {
+          LOG_TRACE("Add garbage node CAS failed. Retry");
+        }
+      }  // while 1
+
+      return;
+    }
+
+    /*
+     * JoinEpoch() - Nothing to do, since the transaction of the calling
+     *               thread protects all nodes it could reach
+     */
+    inline EpochNode *JoinEpoch() { return nullptr; }
+
+    /*
+     * LeaveEpoch() - Nothing to do (see JoinEpoch())
+     */
+    inline void LeaveEpoch(EpochNode *epoch_p) {
+      (void)epoch_p;
+      return;
+    }
+
+    /*
+     * PerformGarbageCollection() - Free all garbage nodes that no transaction
+     *                              could still be reading
+     */
+    void PerformGarbageCollection() {
+      eid_t expired_eid =
+          concurrency::EpochManagerFactory::GetInstance().GetExpiredEpochId();
+
+      // No thread has registered with the epoch manager, so we could not
+      // tell whether anyone still reads the garbage
+      if (expired_eid == MAX_EID) {
+        return;
+      }
+
+      ReclaimGarbage(expired_eid);
+
+      return;
+    }
+
+    /*
+     * ReclaimGarbage() - Free garbage nodes unlinked in or before the given
+     *                    epoch, and put the others back
+     *
+     * The whole list is detached at once, so this could run concurrently with
+     * worker threads adding garbage, and with other threads reclaiming
+     */
+    void ReclaimGarbage(uint64_t expired_eid) {
+      GarbageNode *garbage_node_p =
+          current_epoch_p->garbage_list_p.exchange(nullptr);
+
+      GarbageNode *keep_first_p = nullptr;
+      GarbageNode *keep_last_p = nullptr;
+      size_t freed_count = 0UL;
+
+      while (garbage_node_p != nullptr) {
+        GarbageNode *next_garbage_node_p = garbage_node_p->next_p;
+
+        if (garbage_node_p->delete_epoch <= expired_eid) {
+          FreeEpochDeltaChain(garbage_node_p->node_p);
+          delete garbage_node_p;
+          freed_count++;
+        } else {
+          garbage_node_p->next_p = keep_first_p;
+          keep_first_p = garbage_node_p;
+          if (keep_last_p == nullptr) {
+            keep_last_p = garbage_node_p;
+          }
+        }
+
+        garbage_node_p = next_garbage_node_p;
+      }
+
+      if (keep_first_p != nullptr) {
+        PushGarbageList(keep_first_p, keep_last_p);
+      }
+
+      garbage_count.fetch_sub(freed_count);
+      LOG_TRACE("Freed %lu garbage nodes", freed_count);
+
+      return;
+    }
+
+#elif defined(USE_OLD_EPOCH)
 
     /*
      * AddGarbageNode() - Add garbage node into the current epoch
@@ -7790,7 +8138,7 @@ class BwTree : public BwTreeBase {
       return;
     }
 
-#else  // #ifdef USE_OLD_EPOCH
+#else  // #if defined(USE_TXN_EPOCH)
 
     /*
      * AddGarbageNode() - This encapsulates BwTree::AddGarbageNode()
@@ -7820,7 +8168,7 @@ class BwTree : public BwTreeBase {
       return;
     }
 
-#endif  // #ifdef USE_OLD_EPOCH
+#endif  // #if defined(USE_TXN_EPOCH)
 
     /*
      * FreeEpochDeltaChain() - Free a delta chain (used by EpochManager)
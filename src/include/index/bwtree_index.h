@@ -75,6 +75,10 @@ class BWTreeIndex : public Index {
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate) override;
 
+  bool BulkLoad(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entries) override;
+
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -106,7 +110,7 @@ class BWTreeIndex : public Index {
   }
 
   void PerformGC() override {
-    LOG_INFO("Bw-Tree Garbage Collection!");
+    LOG_TRACE("Bw-Tree Garbage Collection!");
     container.PerformGarbageCollection();
     
     return;
@@ -251,6 +251,25 @@ class Index : public Printable {
   virtual bool CondInsertEntry(const storage::Tuple *key, ItemPointer *location,
                                std::function<bool(const void *)> predicate) = 0;
 
+  /**
+   * Insert a batch of key-value pairs into an empty index. This is designed
+   * for bulk loading a table: implementations may sort the batch and build the
+   * index bottom-up instead of inserting entries one by one.
+   *
+   * The default implementation inserts entries one by one. For unique indexes
+   * the load fails if two entries in the batch share a key. On failure, the
+   * index is left unmodified.
+   *
+   * The caller must guarantee that no other thread accesses the index during
+   * the load.
+   *
+   * @param entries The key-value pairs to insert
+   * @return True on successful insertion of all pairs
+   */
+  virtual bool BulkLoad(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+          &entries);
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
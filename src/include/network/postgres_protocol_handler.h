@@ -31,10 +31,23 @@
 
 namespace peloton {
 
+namespace concurrency {
+class TransactionContext;
+}  // namespace concurrency
+
+namespace executor {
+class CopyFromLoader;
+}  // namespace executor
+
 namespace parser {
+class CopyStatement;
 class ExplainStatement;
 }  // namespace parser
 
+namespace storage {
+class DataTable;
+}  // namespace storage
+
 namespace network {
 
 typedef std::vector<std::unique_ptr<OutputPacket>> ResponseBuffer;
@@ -150,6 +163,24 @@ class PostgresProtocolHandler : public ProtocolHandler {
   // Specific response for empty or NULL queries
   void SendEmptyQueryResponse();
 
+  // Sends the CopyInResponse/CopyOutResponse that switches the connection into
+  // the copy sub-protocol
+  void SendCopyResponse(NetworkMessageType type, int colcount);
+
+  // Send the next chunk of CopyData rows of the table a COPY TO STDOUT is
+  // copying out. Once the last row was sent, the copy is completed and its
+  // transaction committed.
+  void SendCopyOutChunk();
+
+  // Send query results as CopyData rows, used by COPY (SELECT ...) TO STDOUT
+  void SendCopyOutRows(std::vector<ResultValue> &results, int colcount);
+
+  // Encode a single attribute of a CopyData row into the packet, in the
+  // format of the current COPY
+  void PutCopyValue(OutputPacket *pkt, const type::Value &val);
+  void PutCopyNull(OutputPacket *pkt);
+  void PutCopyField(OutputPacket *pkt, const char *data, size_t len);
+
   /* Helper function used to make hardcoded ParameterStatus('S')
    * packets during startup
    */
@@ -165,6 +196,20 @@ class PostgresProtocolHandler : public ProtocolHandler {
   /* Execute a Simple query protocol message */
   ProcessResult ExecQueryMessage(InputPacket *pkt, const size_t thread_id);
 
+  /* Execute a COPY ... FROM STDIN / TO STDOUT query message */
+  ProcessResult ExecCopyQuery(const std::string &query,
+                              parser::CopyStatement &copy_stmt,
+                              const size_t thread_id);
+
+  /* Process a CopyData message of an in-progress COPY FROM STDIN */
+  void ExecCopyDataMessage(InputPacket *pkt);
+
+  /* Process the CopyDone message, committing the rows of a COPY FROM STDIN */
+  void ExecCopyDoneMessage();
+
+  /* Process the CopyFail message, aborting a COPY FROM STDIN */
+  void ExecCopyFailMessage(InputPacket *pkt);
+
   /* Execute a EXPLAIN query message */
   ResultType ExecQueryExplain(const std::string &query,
                               parser::ExplainStatement &explain_stmt);
@@ -228,6 +273,32 @@ class PostgresProtocolHandler : public ProtocolHandler {
 
   std::unordered_map<std::string, std::string> cmdline_options_;
 
+  // State of an in-progress COPY FROM STDIN. The copy runs in its own
+  // transaction that is committed on CopyDone. A COPY TO STDOUT of a table
+  // also runs in copy_txn_.
+  std::unique_ptr<executor::CopyFromLoader> copy_loader_;
+  concurrency::TransactionContext *copy_txn_ = nullptr;
+  std::string copy_error_;
+
+  // True while a COPY (SELECT ...) TO STDOUT executes through the traffic cop
+  bool copy_out_ = false;
+
+  // State of an in-progress COPY TO STDOUT of a table, which runs in
+  // copy_txn_. The rows are sent in chunks of about kCopyOutChunkSize bytes,
+  // and every chunk is written to the client before the next one is encoded,
+  // so the table is never buffered as a whole.
+  static constexpr size_t kCopyOutChunkSize = (1ul << 16ul);
+  storage::DataTable *copy_out_table_ = nullptr;
+  size_t copy_out_tile_group_ = 0;
+  oid_t copy_out_tuple_ = 0;
+  uint64_t copy_out_num_rows_ = 0;
+
+  // Data format and CSV options of the current COPY
+  ExternalFileFormat copy_format_ = ExternalFileFormat::TEXT;
+  char copy_delimiter_ = ',';
+  char copy_quote_ = '"';
+  char copy_escape_ = '"';
+
   //===--------------------------------------------------------------------===//
   // STATIC DATA
   //===--------------------------------------------------------------------===//
@@ -69,7 +69,7 @@ class DefaultCostModel : public AbstractCostModel {
     output_cost_ = 0.f;
   }
 
-  void Visit(const PhysicalOrderBy *) { SortCost(); }
+  void Visit(const PhysicalOrderBy *) { output_cost_ = SortCost(); }
 
   void Visit(const PhysicalLimit *op) {
     auto child_num_rows =
@@ -100,6 +100,23 @@ class DefaultCostModel : public AbstractCostModel {
   void Visit(UNUSED_ATTRIBUTE const PhysicalLeftHashJoin *op) {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalRightHashJoin *op) {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalOuterHashJoin *op) {}
+  void Visit(UNUSED_ATTRIBUTE const PhysicalInnerMergeJoin *op) {
+    auto left_child_rows = std::max(
+        0, memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows());
+    auto right_child_rows = std::max(
+        0, memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows());
+    // Both inputs are already sorted, so we only walk through each of them
+    output_cost_ = (left_child_rows + right_child_rows) * DEFAULT_TUPLE_COST;
+  }
+  void Visit(UNUSED_ATTRIBUTE const PhysicalSemiHashJoin *op) {
+    auto left_child_rows =
+        memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
+    auto right_child_rows =
+        memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows();
+    // Like an inner hash join, plus a pass over the hash table at the end
+    output_cost_ =
+        (2 * left_child_rows + right_child_rows) * DEFAULT_TUPLE_COST;
+  }
   void Visit(UNUSED_ATTRIBUTE const PhysicalInsert *op) {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalInsertSelect *op) {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalDelete *op) {}
@@ -133,11 +150,14 @@ class DefaultCostModel : public AbstractCostModel {
     return child_num_rows * DEFAULT_TUPLE_COST;
   }
 
+  // Charged by the sort enforcer beneath the sort-based operators (merge join,
+  // sort group by) whenever their input isn't sorted already. The row count
+  // is -1 if unknown, which must not turn the cost negative or NaN.
   double SortCost() {
-    auto child_num_rows =
-        memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
+    auto child_num_rows = std::max(
+        0, memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows());
 
-    if (child_num_rows == 0) {
+    if (child_num_rows <= 1) {
       return 1.0f;
     }
     // O(tuple * log(tuple))
@@ -78,7 +78,7 @@ class PostgresCostModel : public AbstractCostModel {
   }
 
   void Visit(UNUSED_ATTRIBUTE const PhysicalOrderBy *) override {
-    SortCost();
+    output_cost_ = SortCost();
   }
 
   void Visit(const PhysicalLimit *op) override {
@@ -178,6 +178,31 @@ class PostgresCostModel : public AbstractCostModel {
   void Visit(UNUSED_ATTRIBUTE const PhysicalLeftHashJoin *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalRightHashJoin *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalOuterHashJoin *op) override {}
+
+  // Both inputs are already sorted, so a merge join walks through each of them
+  // once. The cost of sorting them is charged to the sort enforcers.
+  void Visit(UNUSED_ATTRIBUTE const PhysicalInnerMergeJoin *op) override {
+    auto left_child_rows =
+        std::max(0, memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows());
+    auto right_child_rows =
+        std::max(0, memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows());
+    output_cost_ = (left_child_rows + right_child_rows) * DEFAULT_TUPLE_COST;
+    LOG_DEBUG("--------Merge Join Output-------");
+    LOG_DEBUG("Left: %s | Rows: %d", GetTableName(op->left_keys).c_str(), left_child_rows);
+    LOG_DEBUG("Right: %s | Rows: %d", GetTableName(op->right_keys).c_str(), right_child_rows);
+    LOG_DEBUG("Cost: %f", output_cost_);
+    LOG_DEBUG("--------------------------------");
+  }
+
+  // The left tuples are built into the hash table, which every right tuple
+  // probes, and which is walked through once more to produce them
+  void Visit(UNUSED_ATTRIBUTE const PhysicalSemiHashJoin *op) override {
+    auto left_child_rows =
+        std::max(0, memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows());
+    auto right_child_rows =
+        std::max(0, memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows());
+    output_cost_ = (2 * left_child_rows + right_child_rows) * DEFAULT_TUPLE_COST;
+  }
   void Visit(UNUSED_ATTRIBUTE const PhysicalInsert *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalInsertSelect *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalDelete *op) override{}
@@ -211,11 +236,14 @@ class PostgresCostModel : public AbstractCostModel {
     return child_num_rows * DEFAULT_TUPLE_COST;
   }
 
+  // Charged by the sort enforcer beneath the sort-based operators (merge join,
+  // sort group by) whenever their input isn't sorted already. The row count
+  // is -1 if unknown, which must not turn the cost negative or NaN.
   double SortCost() {
-    auto child_num_rows =
-        memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
+    auto child_num_rows = std::max(
+        0, memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows());
 
-    if (child_num_rows == 0) {
+    if (child_num_rows <= 1) {
       return 1.0f;
     }
     // O(tuple * log(tuple))
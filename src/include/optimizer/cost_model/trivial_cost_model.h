@@ -90,6 +90,14 @@ class TrivialCostModel : public AbstractCostModel {
   void Visit(UNUSED_ATTRIBUTE const PhysicalLeftHashJoin *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalRightHashJoin *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalOuterHashJoin *op) override {}
+
+  void Visit(UNUSED_ATTRIBUTE const PhysicalInnerMergeJoin *op) override {
+    output_cost_ = 2.f;
+  }
+
+  void Visit(UNUSED_ATTRIBUTE const PhysicalSemiHashJoin *op) override {
+    output_cost_ = 1.f;
+  }
   void Visit(UNUSED_ATTRIBUTE const PhysicalInsert *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalInsertSelect *op) override {}
   void Visit(UNUSED_ATTRIBUTE const PhysicalDelete *op) override{}
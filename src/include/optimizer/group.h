@@ -15,6 +15,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "common/synchronization/spin_latch.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/property.h"
@@ -28,9 +29,13 @@ using GroupID = int32_t;
 
 const GroupID UNDEFINED_GROUP = -1;
 class ColumnStats;
+class OptimizerTask;
 
 //===--------------------------------------------------------------------===//
 // Group
+//
+// Expressions and costs are latched so that optimizer tasks can add to the
+// group concurrently. Stats are latched by the memo (see Memo::GetStatsLatch).
 //===--------------------------------------------------------------------===//
 class Group : public Printable {
  public:
@@ -42,7 +47,9 @@ class Group : public Printable {
   void AddExpression(std::shared_ptr<GroupExpression> expr, bool enforced);
 
   void RemoveLogicalExpression(size_t idx) {
+    latch_.Lock();
     logical_expressions_.erase(logical_expressions_.begin() + idx);
+    latch_.Unlock();
   }
 
   bool SetExpressionCost(GroupExpression *expr, double cost,
@@ -54,22 +61,41 @@ class Group : public Printable {
     return table_aliases_;
   }
 
-  // TODO: thread safety?
-  const std::vector<std::shared_ptr<GroupExpression>> GetLogicalExpressions()
-      const {
-    return logical_expressions_;
-  }
+  // Return a snapshot, expressions may be added concurrently
+  std::vector<std::shared_ptr<GroupExpression>> GetLogicalExpressions()
+      const;
 
-  // TODO: thread safety?
-  const std::vector<std::shared_ptr<GroupExpression>> GetPhysicalExpressions()
-      const {
-    return physical_expressions_;
-  }
+  // Return a snapshot, expressions may be added concurrently
+  std::vector<std::shared_ptr<GroupExpression>> GetPhysicalExpressions()
+      const;
 
   inline double GetCostLB() { return cost_lower_bound_; }
 
-  inline void SetExplorationFlag() { has_explored_ = true; }
-  inline bool HasExplored() { return has_explored_; }
+  /*
+   * StartExploration - Claim the exploration of the group's logical
+   * expressions for the calling task, which must push a MarkGroupExplored task
+   * ahead of the tasks exploring them
+   *
+   * return: false if another task has claimed it already
+   */
+  bool StartExploration();
+
+  /*
+   * AddExplorationWaiter - Register a task to be resumed once the exploration
+   * of the group is finished
+   *
+   * return: false if the group is explored already
+   */
+  bool AddExplorationWaiter(OptimizerTask *task);
+
+  /*
+   * FinishExploration - Mark the group as explored
+   *
+   * return: the tasks waiting for the exploration to finish
+   */
+  std::vector<OptimizerTask *> FinishExploration();
+
+  bool HasExplored();
 
   std::shared_ptr<ColumnStats> GetStats(std::string column_name);
 
@@ -98,6 +124,7 @@ class Group : public Printable {
   // This is called in rewrite phase to erase the only logical expression in the
   // group
   inline void EraseLogicalExpression() {
+    // No latching, the rewrite phase runs one task at a time
     PELOTON_ASSERT(logical_expressions_.size() == 1);
     PELOTON_ASSERT(physical_expressions_.size() == 0);
     logical_expressions_.clear();
@@ -120,8 +147,11 @@ class Group : public Printable {
                      std::tuple<double, GroupExpression *>, PropSetPtrHash,
                      PropSetPtrEq> lowest_cost_expressions_;
 
-  // Whether equivalent logical expressions have been explored for this group
-  bool has_explored_;
+  // Whether equivalent logical expressions have been explored for this group,
+  // or are being explored, and the tasks waiting for the exploration to finish
+  enum class ExplorationState { UNEXPLORED, EXPLORING, EXPLORED };
+  ExplorationState exploration_state_;
+  std::vector<OptimizerTask *> exploration_waiters_;
 
   std::vector<std::shared_ptr<GroupExpression>> logical_expressions_;
   std::vector<std::shared_ptr<GroupExpression>> physical_expressions_;
@@ -134,6 +164,8 @@ class Group : public Printable {
   std::unordered_map<std::string, std::shared_ptr<ColumnStats>> stats_;
   int num_rows_ = -1;
   double cost_lower_bound_ = -1;
+
+  mutable common::synchronization::SpinLatch latch_;
 };
 
 }  // namespace optimizer
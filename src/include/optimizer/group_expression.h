@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "common/synchronization/spin_latch.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/stats/stats.h"
 #include "optimizer/util.h"
@@ -81,10 +82,12 @@ class GroupExpression {
   bool stats_derived_;
 
   // Mapping from output properties to the corresponding best cost, statistics,
-  // and child properties
+  // and child properties. Latched, the expression may be costed for different
+  // properties concurrently.
   std::unordered_map<std::shared_ptr<PropertySet>,
                      std::tuple<double, std::vector<std::shared_ptr<PropertySet>>>,
                      PropSetPtrHash, PropSetPtrEq> lowest_cost_table_;
+  mutable common::synchronization::SpinLatch latch_;
 };
 
 }  // namespace optimizer
@@ -77,6 +77,10 @@ class InputColumnDeriver : public OperatorVisitor {
 
   void Visit(const PhysicalOuterHashJoin *) override;
 
+  void Visit(const PhysicalInnerMergeJoin *) override;
+
+  void Visit(const PhysicalSemiHashJoin *) override;
+
   void Visit(const PhysicalInsert *) override;
 
   void Visit(const PhysicalInsertSelect *) override;
@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_enumerator.h
+//
+// Identification: src/include/optimizer/join_enumerator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace optimizer {
+
+class GroupExpression;
+class OptimizerMetadata;
+using GroupID = int32_t;
+
+/**
+ * @brief Enumerates the join orders of a tree of inner joins with DPhyp
+ *  (Moerkotte and Neumann, "Dynamic Programming Strikes Back", SIGMOD 2008).
+ *
+ * The relations of the tree are the groups below its inner joins, and every
+ * join predicate becomes an (hyper)edge between the relations it references.
+ * DPhyp visits every connected subgraph of that join graph, and every pair of
+ * connected subgraphs that can be joined without a cross product, exactly
+ * once. For every such pair, we add a join expression in both orders to the
+ * group of their union, creating the group the first time we see the union.
+ * All expressions are marked so that the join order transformation rules do
+ * not explore them again.
+ */
+class JoinEnumerator {
+ public:
+  JoinEnumerator(OptimizerMetadata *metadata, size_t max_relations)
+      : metadata_(metadata), max_relations_(max_relations) {}
+
+  /**
+   * @brief Enumerate the join orders of the tree of inner joins rooted at the
+   *  given group
+   *
+   * @param root_group The group of the topmost join of the tree
+   *
+   * @return False if the tree has too many relations, or if its join graph is
+   *  not connected. The memo is left untouched in that case.
+   */
+  bool Enumerate(GroupID root_group);
+
+  /**
+   * @brief The group expressions added to the memo by Enumerate()
+   */
+  const std::vector<GroupExpression *> &GetNewExpressions() const {
+    return new_exprs_;
+  }
+
+  /**
+   * @brief The groups the joins of the tree are over
+   */
+  const std::vector<GroupID> &GetRelations() const { return relations_; }
+
+ private:
+  // A set of relations, one bit per relation
+  using RelationSet = uint64_t;
+
+  // Collect relations and predicates of the join tree rooted at the group
+  bool CollectJoinTree(GroupID group_id, RelationSet &relations);
+
+  // Build the hyperedges of the join graph, and check that it is connected
+  bool BuildJoinGraph();
+
+  // Mark a join expression as explored by the join order transformation rules
+  void MarkExplored(GroupExpression *gexpr);
+
+  //===--------------------------------------------------------------------===//
+  // DPhyp
+  //===--------------------------------------------------------------------===//
+  void EmitCsg(RelationSet s1);
+  void EnumerateCsgRec(RelationSet s1, RelationSet exclusion);
+  void EnumerateCmpRec(RelationSet s1, RelationSet s2, RelationSet exclusion);
+  void EmitCsgCmp(RelationSet s1, RelationSet s2);
+  RelationSet Neighborhood(RelationSet s, RelationSet exclusion) const;
+  bool IsConnected(RelationSet s1, RelationSet s2) const;
+
+  // Add a join of two groups to the group of their union
+  GroupID AddJoin(GroupID left, GroupID right,
+                  const std::vector<AnnotatedExpression> &predicates,
+                  GroupID target_group);
+
+ private:
+  struct HyperEdge {
+    RelationSet left;
+    RelationSet right;
+  };
+
+  OptimizerMetadata *metadata_;
+  const size_t max_relations_;
+
+  // The groups the joins are over, indexed by relation
+  std::vector<GroupID> relations_;
+  std::unordered_map<std::string, size_t> alias_to_relation_;
+
+  // All join predicates and the relations they reference
+  std::vector<AnnotatedExpression> predicates_;
+  std::vector<RelationSet> predicate_relations_;
+
+  std::vector<HyperEdge> edges_;
+
+  // Groups of the join tree we started from, by the relations they join
+  std::unordered_map<RelationSet, GroupID> tree_groups_;
+  std::vector<GroupExpression *> tree_exprs_;
+
+  // Groups of the connected subgraphs enumerated so far
+  std::unordered_map<RelationSet, GroupID> dp_table_;
+
+  std::vector<GroupExpression *> new_exprs_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -13,9 +13,11 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
+#include "common/synchronization/readwrite_latch.h"
 #include "operator_expression.h"
 #include "optimizer/group.h"
 
@@ -35,11 +37,17 @@ struct GExprPtrEq {
 
 //===--------------------------------------------------------------------===//
 // Memo
+//
+// Expressions may be inserted and groups looked up by concurrent optimizer
+// tasks. The rewrite phase and plan generation run alone and do not latch.
 //===--------------------------------------------------------------------===//
 class Memo {
  public:
   Memo();
 
+  // The latches are not moved, no task may be running on either memo
+  Memo &operator=(Memo &&other);
+
   /* InsertExpression - adds a group expression into the proper group in the
    * memo, checking for duplicates
    *
@@ -65,6 +73,10 @@ class Memo {
     rule_set_size_ = rule_set_size;
   }
 
+  // The latch serializing stats derivation and costing, which read and write
+  // the stats of the groups, and look up table stats through the transaction
+  std::mutex &GetStatsLatch() { return stats_latch_; }
+
   //===--------------------------------------------------------------------===//
   // For rewrite phase: remove and add expression directly for the set
   //===--------------------------------------------------------------------===//
@@ -86,11 +98,18 @@ class Memo {
  private:
   GroupID AddNewGroup(std::shared_ptr<GroupExpression> gexpr);
 
+  // Requires the latch to be held
+  Group* GetGroupByIDLocked(GroupID id) { return groups_[id].get(); }
+
   // The group owns the group expressions, not the memo
   std::unordered_set<GroupExpression*, GExprPtrHash, GExprPtrEq>
       group_expressions_;
   std::vector<std::unique_ptr<Group>> groups_;
   size_t rule_set_size_;
+
+  // Protects the expression set and the group list
+  common::synchronization::ReadWriteLatch latch_;
+  std::mutex stats_latch_;
 };
 
 }  // namespace optimizer
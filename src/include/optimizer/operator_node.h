@@ -66,6 +66,8 @@ enum class OpType {
   LeftHashJoin,
   RightHashJoin,
   OuterHashJoin,
+  InnerMergeJoin,
+  SemiHashJoin,
   Insert,
   InsertSelect,
   Delete,
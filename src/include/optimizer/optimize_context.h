@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "common/timer.h"
 
 #include "optimizer/property_set.h"
@@ -33,9 +35,17 @@ class OptimizeContext {
         required_prop(required_prop),
         cost_upper_bound(cost_upper_bound) {}
 
+  // Tasks sharing the context may update the upper bound concurrently
+  void SubtractCostUpperBound(double cost) {
+    double upper_bound = cost_upper_bound;
+    while (!cost_upper_bound.compare_exchange_weak(upper_bound,
+                                                   upper_bound - cost)) {
+    }
+  }
+
   OptimizerMetadata *metadata;
   std::shared_ptr<PropertySet> required_prop;
-  double cost_upper_bound;
+  std::atomic<double> cost_upper_bound;
 };
 
 }  // namespace optimizer
@@ -164,6 +164,13 @@ class Optimizer : public AbstractOptimizer {
   void ExecuteTaskStack(OptimizerTaskStack &task_stack, int root_group_id,
                         std::shared_ptr<OptimizeContext> root_context);
 
+  /* ExecuteTaskPool - Execute the tasks of the given concurrent task pool on
+   * multiple threads, with the same time limit as ExecuteTaskStack
+   */
+  void ExecuteTaskPool(ConcurrentOptimizerTaskPool &task_pool,
+                       int root_group_id,
+                       std::shared_ptr<OptimizeContext> root_context);
+
   //////////////////////////////////////////////////////////////////////////////
   /// Metadata
   OptimizerMetadata metadata_;
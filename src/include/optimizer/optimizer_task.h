@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -44,6 +45,8 @@ enum class OptimizerTaskType {
   APPLY_RULE,
   OPTIMIZE_INPUTS,
   DERIVE_STATS,
+  ENUMERATE_JOIN_ORDER,
+  MARK_GROUP_EXPLORED,
   REWRITE_EXPR,
   APPLY_REWIRE_RULE,
   TOP_DOWN_REWRITE,
@@ -80,6 +83,21 @@ class OptimizerTask {
 
   void PushTask(OptimizerTask *task);
 
+  /**
+   * @brief Push a task that must only run once the tasks pushed after it, and
+   *  all the tasks those push, are done (see OptimizerTaskPool)
+   */
+  void PushContinuation(OptimizerTask *task);
+
+  /**
+   * @brief Wait for another task to finish exploring a group. The current task
+   *  must return right away if this returns true, it is executed again once
+   *  the group is explored.
+   *
+   * @return False if the group is explored already
+   */
+  bool WaitForExploration(Group *group);
+
   inline Memo &GetMemo() const;
 
   inline RuleSet &GetRuleSet() const;
@@ -89,6 +107,20 @@ class OptimizerTask {
  protected:
   OptimizerTaskType type_;
   std::shared_ptr<OptimizeContext> context_;
+
+ private:
+  friend class ConcurrentOptimizerTaskPool;
+
+  // Bookkeeping of ConcurrentOptimizerTaskPool: the task waiting for this one,
+  // the number of tasks this one waits for, and whether it has executed
+  OptimizerTask *parent_ = nullptr;
+  std::atomic<uint32_t> num_pending_{0};
+  bool executed_ = false;
+
+  // Whether the task asked to be suspended, and whether it is running,
+  // suspended or resumed
+  bool suspend_requested_ = false;
+  std::atomic<int> run_state_{0};
 };
 
 /**
@@ -241,6 +273,40 @@ class DeriveStats : public OptimizerTask {
   ExprSet required_cols_;
 };
 
+/**
+ * @brief Enumerate the join orders of every tree of inner joins at or below a
+ *  group with DPhyp (see JoinEnumerator), rather than exploring them with the
+ *  join order transformation rules. This runs once after the rewrite phase,
+ *  when every group still has a single logical expression.
+ */
+class EnumerateJoinOrder : public OptimizerTask {
+ public:
+  EnumerateJoinOrder(GroupID group_id, std::shared_ptr<OptimizeContext> context)
+      : OptimizerTask(context, OptimizerTaskType::ENUMERATE_JOIN_ORDER),
+        group_id_(group_id) {}
+
+  virtual void execute() override;
+
+ private:
+  GroupID group_id_;
+};
+
+/**
+ * @brief Mark a group as explored once the task that started exploring it, and
+ *  all its subtasks, are done. Resumes the tasks waiting for that.
+ */
+class MarkGroupExplored : public OptimizerTask {
+ public:
+  MarkGroupExplored(Group *group, std::shared_ptr<OptimizeContext> context)
+      : OptimizerTask(context, OptimizerTaskType::MARK_GROUP_EXPLORED),
+        group_(group) {}
+
+  virtual void execute() override;
+
+ private:
+  Group *group_;
+};
+
 /**
  * @brief Apply top-down rewrite pass, take in a rule set which must fulfill
  * that the lower level rewrite in the operator tree will not enable upper
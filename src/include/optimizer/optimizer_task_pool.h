@@ -13,22 +13,43 @@
 #pragma once
 
 #include "optimizer/optimizer_task.h"
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <stack>
 #include <memory>
 
+#include "common/exception.h"
+#include "common/synchronization/spin_latch.h"
+
 namespace peloton {
 namespace optimizer {
 /**
  * @brief The base class of a task pool, which needs to support adding tasks and
- *  getting available tasks from the pool. Note that a single-threaded task pool
- *  is identical to a stack but we may need to implement a different data
- *  structure for multi-threaded optimization
+ *  getting available tasks from the pool.
+ *
+ * Tasks express the order they have to run in through the way they are pushed:
+ * a continuation only runs once every task pushed after it by the same task,
+ * and all the tasks those push in turn, are done. Other tasks pushed by the
+ * same task are independent of each other. A single-threaded task pool is
+ * identical to a stack, which runs every task after the ones pushed after it.
  */
 class OptimizerTaskPool {
  public:
-  virtual std::unique_ptr<OptimizerTask> Pop() = 0;
+  virtual ~OptimizerTaskPool() {}
+
   virtual void Push(OptimizerTask *task) = 0;
+  virtual void PushContinuation(OptimizerTask *task) = 0;
   virtual bool Empty() = 0;
+
+  /**
+   * @brief Park the task being executed once it returns, until Resume() is
+   *  called on it, after which it is executed again. Only used to wait for
+   *  another task to finish exploring a group.
+   */
+  virtual void Suspend(OptimizerTask *task) = 0;
+  virtual void Resume(OptimizerTask *task) = 0;
 };
 
 /**
@@ -46,11 +67,121 @@ class OptimizerTaskStack : public OptimizerTaskPool {
     task_stack_.push(std::unique_ptr<OptimizerTask>(task));
   }
 
+  virtual void PushContinuation(OptimizerTask *task) { Push(task); }
+
   virtual bool Empty() { return task_stack_.empty(); }
 
+  // A stack explores a group and everything below it before running any other
+  // task, so no task ever finds a group being explored. A task that would be
+  // parked here would never run again, so fail the optimization instead.
+  virtual void Suspend(UNUSED_ATTRIBUTE OptimizerTask *task) {
+    throw OptimizerException("Cannot suspend a task on a task stack");
+  }
+
+  virtual void Resume(UNUSED_ATTRIBUTE OptimizerTask *task) {
+    throw OptimizerException("Cannot resume a task on a task stack");
+  }
+
  private:
   std::stack<std::unique_ptr<OptimizerTask>> task_stack_;
 };
 
+/**
+ * @brief Work-stealing implementation of the task pool, running independent
+ *  tasks concurrently.
+ *
+ * Every worker owns a deque of tasks that are ready to run. A worker pushes the
+ * tasks that become ready to the back of its own deque and pops from there, so
+ * that it runs tasks depth-first like a stack, and steals from the front of
+ * the deques of other workers when its own is empty.
+ *
+ * The tasks a task pushes are collected while it executes and scheduled once
+ * it returns. A task is done once it has executed and all the tasks it pushed
+ * are done; continuations are held back until everything pushed after them is
+ * done. Tasks pushed from outside of Execute() run one after the other, last
+ * one first, like on a stack.
+ */
+class ConcurrentOptimizerTaskPool : public OptimizerTaskPool {
+ public:
+  explicit ConcurrentOptimizerTaskPool(uint32_t num_workers);
+
+  ~ConcurrentOptimizerTaskPool();
+
+  void Push(OptimizerTask *task) override;
+
+  void PushContinuation(OptimizerTask *task) override;
+
+  bool Empty() override {
+    return root_tasks_.empty() && num_incomplete_roots_ == 0;
+  }
+
+  void Suspend(OptimizerTask *task) override;
+
+  void Resume(OptimizerTask *task) override;
+
+  /**
+   * @brief Run the tasks pushed so far, and all the tasks they push, on the
+   *  calling thread and on up to (num_workers - 1) threads of the execution
+   *  pool
+   *
+   * @param should_stop Polled by the calling thread between tasks, tasks that
+   *  have not run yet are abandoned once it returns true
+   *
+   * @return False if tasks were abandoned. Rethrows the first exception thrown
+   *  by a task, after abandoning all remaining tasks.
+   */
+  bool Execute(const std::function<bool()> &should_stop);
+
+ private:
+  struct Worker {
+    common::synchronization::SpinLatch latch;
+    std::deque<OptimizerTask *> tasks;
+    // Tasks pushed by the task being executed, and whether each of them is a
+    // continuation
+    std::vector<std::pair<OptimizerTask *, bool>> pushed_tasks;
+  };
+
+  // Run tasks until there are none left, or execution is abandoned
+  void RunWorker(uint32_t worker_id, const std::function<bool()> *should_stop);
+
+  OptimizerTask *NextTask(uint32_t worker_id);
+
+  void RunTask(Worker &worker, OptimizerTask *task);
+
+  // Wire the tasks pushed by a task (or from outside if it's null) to the
+  // tasks that wait for them, and return those that are ready to run
+  void WireTasks(OptimizerTask *task,
+                 std::vector<std::pair<OptimizerTask *, bool>> &pushed_tasks,
+                 std::vector<OptimizerTask *> &ready_tasks);
+
+  void Schedule(OptimizerTask *task);
+
+  // Free a task that is done and notify the task waiting for it
+  void Complete(OptimizerTask *task);
+
+  // Free every task that has not completed after abandoning execution
+  void FreeIncompleteTasks();
+
+ private:
+  const uint32_t num_workers_;
+  std::unique_ptr<Worker[]> workers_;
+
+  // Tasks pushed from outside of Execute()
+  std::vector<std::pair<OptimizerTask *, bool>> root_tasks_;
+  std::atomic<uint32_t> num_incomplete_roots_;
+
+  std::atomic<bool> stop_;
+
+  // The worker the current thread runs tasks for, if any
+  static thread_local Worker *current_worker_;
+
+  std::exception_ptr exception_;
+  common::synchronization::SpinLatch exception_latch_;
+
+  // Suspended tasks, which are not in any deque
+  std::vector<OptimizerTask *> suspended_tasks_;
+  common::synchronization::SpinLatch suspended_latch_;
+};
+
 }  // namespace optimizer
 }  // namespace peloton
@@ -79,6 +79,10 @@ class PlanGenerator : public OperatorVisitor {
 
   void Visit(const PhysicalOuterHashJoin *) override;
 
+  void Visit(const PhysicalInnerMergeJoin *) override;
+
+  void Visit(const PhysicalSemiHashJoin *) override;
+
   void Visit(const PhysicalInsert *) override;
 
   void Visit(const PhysicalInsertSelect *) override;
@@ -156,6 +160,18 @@ class PlanGenerator : public OperatorVisitor {
           *groupby_cols,
       std::unique_ptr<expression::AbstractExpression> having);
 
+  /**
+   * @brief Build a hash join plan whose left child builds the hash table and
+   *  whose right child probes it
+   */
+  void BuildHashJoinPlan(
+      JoinType join_type,
+      const std::vector<AnnotatedExpression> &join_predicates,
+      const std::vector<std::unique_ptr<expression::AbstractExpression>>
+          &left_keys,
+      const std::vector<std::unique_ptr<expression::AbstractExpression>>
+          &right_keys);
+
   /**
    * @brief The required output property. Note that we have previously enforced
    *  properties so this is fulfilled by the current operator
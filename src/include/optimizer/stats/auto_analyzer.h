@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// auto_analyzer.h
+//
+// Identification: src/include/optimizer/stats/auto_analyzer.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}  // namespace storage
+
+namespace optimizer {
+
+//===--------------------------------------------------------------------===//
+// Auto Analyzer
+//===--------------------------------------------------------------------===//
+
+/**
+ * Background service that keeps the stats of the registered tables fresh.
+ *
+ * A table is analyzed again, from a sample of its tuples, once the number of
+ * versions inserted or removed since it was last analyzed (see
+ * DataTable::GetModificationCount) exceeds
+ *
+ *   min_modifications + churn_ratio * (# of tuples when last analyzed)
+ *
+ * The size of the sample is the analyze_sample_size setting, as for ANALYZE.
+ */
+class AutoAnalyzer {
+ public:
+  AutoAnalyzer(const AutoAnalyzer &) = delete;
+  AutoAnalyzer &operator=(const AutoAnalyzer &) = delete;
+  AutoAnalyzer(AutoAnalyzer &&) = delete;
+  AutoAnalyzer &operator=(AutoAnalyzer &&) = delete;
+
+  AutoAnalyzer() : analyzer_stop_(true) {}
+
+  static AutoAnalyzer &GetInstance();
+
+  void Start();
+
+  void Stop();
+
+  /**
+   * Go over all registered tables once and analyze the ones that changed
+   * enough since they were last analyzed.
+   *
+   * @return     The number of tables that were analyzed
+   */
+  size_t AnalyzeTables();
+
+  void AddTable(storage::DataTable *table);
+
+  void RemoveTable(oid_t table_oid);
+
+  void ClearTables();
+
+  void SetMinModifications(size_t min_modifications) {
+    min_modifications_ = min_modifications;
+  }
+
+  void SetChurnRatio(double churn_ratio) { churn_ratio_ = churn_ratio; }
+
+ private:
+  void Running();
+
+  struct TableEntry {
+    storage::DataTable *table;
+
+    // The modification count of the table when it was last analyzed
+    size_t analyzed_modification_count;
+
+    // The tuple count of the table when it was last analyzed
+    size_t analyzed_tuple_count;
+  };
+
+  // Registered tables, by table oid
+  std::unordered_map<oid_t, TableEntry> tables_;
+
+  std::mutex analyzer_mutex_;
+
+  // Signaled when the analyzer is done with a table
+  std::condition_variable analyzer_cv_;
+
+  // The table being sampled, which RemoveTable waits for
+  oid_t analyzing_table_oid_ = INVALID_OID;
+
+  std::atomic<bool> analyzer_stop_;
+
+  std::thread analyzer_thread_;
+
+  // Number of modifications that always triggers an analyze
+  size_t min_modifications_ = 50;
+
+  // Fraction of the tuples whose modification triggers an analyze
+  double churn_ratio_ = 0.1;
+
+  // Sleeping period between two rounds (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -46,13 +46,22 @@ class ColumnStatsCollector {
 
   void AddValue(const type::Value& value);
 
+  // Merge the stats another collector gathered on the same column, e.g., from
+  // a different part of the table.
+  void Merge(const ColumnStatsCollector& other);
+
+  // Mark the collected values as a sample covering the given fraction of the
+  // table, so that counts are extrapolated to the whole table.
+  inline void SetSampleFraction(double fraction) {
+    PELOTON_ASSERT(fraction > 0 && fraction <= 1);
+    sample_fraction_ = fraction;
+  }
+
   double GetFracNull();
 
-  inline std::vector<ValueFrequencyPair> GetCommonValueAndFrequency() {
-    return topk_.GetAllOrderedMaxFirst();
-  }
+  std::vector<ValueFrequencyPair> GetCommonValueAndFrequency();
 
-  inline uint64_t GetCardinality() { return hll_.EstimateCardinality(); }
+  uint64_t GetCardinality();
 
   inline double GetCardinalityError() { return hll_.RelativeError(); }
 
@@ -80,6 +89,9 @@ class ColumnStatsCollector {
   size_t null_count_ = 0;
   size_t total_count_ = 0;
 
+  // The fraction of the table's tuples that were added
+  double sample_fraction_ = 1.0;
+
   ColumnStatsCollector(const ColumnStatsCollector&);
   void operator=(const ColumnStatsCollector&);
 };
@@ -19,7 +19,9 @@
 #include <cstring>
 #include <vector>
 
+#include "common/exception.h"
 #include "common/logger.h"
+#include "common/macros.h"
 #include "murmur3/MurmurHash3.h"
 
 namespace peloton {
@@ -120,6 +122,24 @@ class CountMinSketch {
     }
   }
 
+  // Merge another sketch with the same dimensions into this one. All sketches
+  // hash items the same way, so the merged table is exactly the one we would
+  // have built from both streams. The distinct item count (size) becomes an
+  // upper bound since items seen by both sketches are counted twice.
+  // Throws a StatException if the dimensions differ.
+  void Merge(const CountMinSketch& other) {
+    if (depth != other.depth || width != other.width) {
+      throw StatException(
+          "cannot merge count-min sketches of different dimensions");
+    }
+    for (int i = 0; i < depth; i++) {
+      for (int j = 0; j < width; j++) {
+        table[i][j] += other.table[i][j];
+      }
+    }
+    size += other.size;
+  }
+
   uint64_t EstimateItemCount(int64_t item) {
     uint64_t count = UINT64_MAX;
     std::vector<int> bins = getHashBins(item);
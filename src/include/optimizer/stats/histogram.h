@@ -89,6 +89,23 @@ class Histogram {
     }
   }
 
+  /*
+   * Input: A histogram h built with the same max_bins
+   *
+   * Merge h into this histogram (Algorithm 2), so that it represents the union
+   * of both sets. Keep bin number unchanged.
+   */
+  void Merge(const Histogram &other) {
+    for (const Bin &bin : other.bins) {
+      InsertBin(bin);
+    }
+    while (bins.size() > max_bins_) {
+      MergeTwoBinsWithMinGap();
+    }
+    minimum_ = std::min(minimum_, other.minimum_);
+    maximum_ = std::max(maximum_, other.maximum_);
+  }
+
   /*
    * Input: a point b such that p1 < b < pB
    *
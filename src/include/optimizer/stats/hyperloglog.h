@@ -18,6 +18,7 @@
 #include <libcount/hll.h>
 
 #include "type/value.h"
+#include "common/exception.h"
 #include "common/macros.h"
 #include "common/logger.h"
 #include "optimizer/stats/stats_util.h"
@@ -47,6 +48,16 @@ class HyperLogLog {
     return cardinality;
   }
 
+  // Merge another HLL with the same precision into this one. The result
+  // estimates the cardinality of the union of both streams. Throws a
+  // StatException if the precisions differ.
+  void Merge(const HyperLogLog& other) {
+    if (precision_ != other.precision_) {
+      throw StatException("cannot merge HyperLogLogs of different precisions");
+    }
+    hll_->Merge(other.hll_);
+  }
+
   // Estimate relative error for HLL.
   inline double RelativeError() {
     PELOTON_ASSERT(register_count_ > 0);
@@ -15,8 +15,12 @@
 #include "optimizer/stats/table_stats_collector.h"
 #include "optimizer/stats/column_stats_collector.h"
 
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
+#include "common/container/cuckoo_map.h"
 #include "common/macros.h"
 #include "common/internal_types.h"
 #include "type/value_factory.h"
@@ -34,6 +38,20 @@ using ValueFrequencyPair = std::pair<type::Value, double>;
 class ColumnStats;
 class TableStats;
 
+// The column stats of a table, by column id. A cached entry is never changed,
+// it is replaced as a whole.
+struct CachedTableStats {
+  std::map<oid_t, std::shared_ptr<ColumnStats>> column_stats;
+};
+
+/**
+ * The stats of the tables are stored in 'pg_column_stats'. Reads go through an
+ * in-memory cache of it shared by all transactions, which ANALYZE refreshes
+ * once the transaction that wrote the stats of a table commits. Stats are only
+ * estimates, so the cache does not track which transactions may see them. It
+ * only keeps stats read from a snapshot older than the last change of the
+ * table from being cached again.
+ */
 class StatsStorage {
  public:
   // Global Singleton
@@ -78,12 +96,39 @@ class StatsStorage {
       storage::DataTable *table,
       concurrency::TransactionContext *txn = nullptr);
 
+  // Analyze the table from a random sample of the given number of tuples
+  // (0 means all of them)
+  ResultType AnalyzeStatsForTable(storage::DataTable *table,
+                                  concurrency::TransactionContext *txn,
+                                  size_t sample_size);
+
   ResultType AnalayzeStatsForColumns(storage::DataTable *table,
                                      std::vector<std::string> column_names);
 
  private:
+  // Get the cached stats of the table, reading them from the catalog if they
+  // are not cached yet
+  std::shared_ptr<CachedTableStats> GetCachedTableStats(
+      oid_t database_id, oid_t table_id, concurrency::TransactionContext *txn);
+
+  void InvalidateCachedTableStats(uint64_t key, cid_t commit_id);
+
+  static uint64_t GetCacheKey(oid_t database_id, oid_t table_id) {
+    return (static_cast<uint64_t>(database_id) << 32) | table_id;
+  }
+
   std::unique_ptr<type::AbstractPool> pool_;
 
+  // Stats of the tables, by database and table id
+  CuckooMap<uint64_t, std::shared_ptr<CachedTableStats>> stats_cache_;
+
+  // Serializes the changes to the cache with the invalidations
+  std::mutex stats_cache_latch_;
+
+  // Commit id of the last transaction that changed the stats of a table, by
+  // database and table id
+  std::unordered_map<uint64_t, cid_t> invalidation_cids_;
+
   std::shared_ptr<ColumnStats> ConvertVectorToColumnStats(
       oid_t database_id, oid_t table_id, oid_t column_id,
       std::unique_ptr<std::vector<type::Value>> &column_stats_vector);
@@ -24,9 +24,16 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 // TableStatsCollector
 //===--------------------------------------------------------------------===//
+/*
+ * Collects the column stats of a table. Tile groups are scanned in parallel on
+ * the execution pool, each worker building its own column stats collectors
+ * that are merged at the end. If a sample size is given, only a random sample
+ * of tile groups covering roughly that many tuples is scanned.
+ */
 class TableStatsCollector {
  public:
-  TableStatsCollector(storage::DataTable* table);
+  // sample_size - the number of tuples to sample, or 0 to scan all tuples
+  TableStatsCollector(storage::DataTable* table, size_t sample_size = 0);
 
   ~TableStatsCollector();
 
@@ -44,11 +51,21 @@ class TableStatsCollector {
   std::vector<std::unique_ptr<ColumnStatsCollector>> column_stats_collectors_;
   size_t active_tuple_count_;
   size_t column_count_;
+  size_t sample_size_;
 
   TableStatsCollector(const TableStatsCollector&);
   void operator=(const TableStatsCollector&);
 
-  void InitColumnStatsCollectors();
+  void InitColumnStatsCollectors(
+      std::vector<std::unique_ptr<ColumnStatsCollector>>& collectors) const;
+
+  // Pick the offsets of the tile groups to scan
+  std::vector<size_t> SampleTileGroups(size_t tile_group_count) const;
+
+  // Add the values of all tuples in a tile group to the given collectors
+  void CollectTileGroup(
+      storage::TileGroup* tile_group,
+      std::vector<std::unique_ptr<ColumnStatsCollector>>& collectors) const;
 };
 
 }  // namespace optimizer
@@ -9,6 +9,7 @@
 #include "common/logger.h"
 #include "count_min_sketch.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <cinttypes>
@@ -611,6 +612,30 @@ class TopKElements {
     }
   }
 
+  /*
+   * Merge another TopKElements built with the same sketch dimensions into
+   * this one. The sketches are merged first; then every candidate from either
+   * queue is re-estimated against the merged sketch and the top k are kept.
+   */
+  void Merge(const TopKElements& other) {
+    cmsketch.Merge(other.cmsketch);
+
+    std::vector<ApproxTopEntry> candidates = tkq.retrieve_all();
+    for (const auto& entry : other.tkq.retrieve_all()) {
+      if (std::find(candidates.begin(), candidates.end(), entry) ==
+          candidates.end()) {
+        candidates.push_back(entry);
+      }
+    }
+
+    TopKQueue merged{tkq.get_k()};
+    for (auto& entry : candidates) {
+      entry.approx_count = EstimateItemCount(entry.approx_top_elem);
+      merged.push(entry);
+    }
+    tkq = std::move(merged);
+  }
+
   // TODO:
   // Need to retrieve new elements after eviction of current element(s)
 
@@ -784,6 +809,16 @@ class TopKElements {
   }
 
  private:
+  /*
+   * Estimate the count of an element using the sketch
+   */
+  uint64_t EstimateItemCount(const ApproxTopEntryElem& elem) {
+    if (elem.item_type == ApproxTopEntryElem::ElemType::INT_TYPE) {
+      return cmsketch.EstimateItemCount(elem.int_item);
+    }
+    return cmsketch.EstimateItemCount(elem.str_item.c_str());
+  }
+
   /*
    * Forge an ApproxTopEntry of integer
    */
@@ -61,7 +61,8 @@ class CopyStatement : public SQLStatement {
   // The input or output file that is read of written into
   std::string file_path;
 
-  // The format of the file
+  // The format of the data. Files are always CSV, data streamed over the
+  // connection (STDIN/STDOUT) defaults to text.
   ExternalFileFormat format = ExternalFileFormat::CSV;
 
   bool is_from;
@@ -127,6 +127,9 @@ class PostgresParser {
   // transform helper for A_Expr nodes
   static expression::AbstractExpression *AExprTransform(A_Expr *root);
 
+  // transform helper for [NOT] IN lists
+  static expression::AbstractExpression *InListTransform(A_Expr *root);
+
   // transform helper for BoolExpr nodes
   static expression::AbstractExpression *BoolExprTransform(BoolExpr *root);
 
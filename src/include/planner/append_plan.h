@@ -14,6 +14,7 @@
 
 #include "abstract_plan.h"
 #include "common/internal_types.h"
+#include "planner/attribute_info.h"
 
 namespace peloton {
 namespace planner {
@@ -29,10 +30,29 @@ class AppendPlan : public AbstractPlan {
 
   const std::string GetInfo() const { return "AppendPlan"; }
 
+  // Every input is bound on its own. The output has the attributes of the
+  // first input.
+  void PerformBinding(BindingContext &binding_context) override;
+
+  void GetOutputColumns(std::vector<oid_t> &columns) const override {
+    GetChild(0)->GetOutputColumns(columns);
+  }
+
+  // The attributes the given child produces, in the order of its output
+  // columns
+  const std::vector<const AttributeInfo *> &GetInputAttributes(
+      uint32_t child_idx) const {
+    return input_ais_[child_idx];
+  }
+
   std::unique_ptr<AbstractPlan> Copy() const {
     return std::unique_ptr<AbstractPlan>(new AppendPlan());
   }
 
+ private:
+  /** @brief The attributes produced by each child, set during binding */
+  std::vector<std::vector<const AttributeInfo *>> input_ais_;
+
  private:
   DISALLOW_COPY_AND_MOVE(AppendPlan);
 };
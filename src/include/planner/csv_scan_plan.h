@@ -44,10 +44,12 @@ class CSVScanPlan : public AbstractScan {
    * @param quote The character used to quote data (i.e., strings)
    * @param escape The character that should appear before any data characters
    * that match the quote character.
+   * @param null The string that represents NULL values
+   * @param parallel Should the file be scanned in parallel?
    */
   CSVScanPlan(std::string file_name, std::vector<ColumnInfo> &&cols,
               char delimiter = ',', char quote = '"', char escape = '"',
-              std::string null = "");
+              std::string null = "", bool parallel = false);
 
   //////////////////////////////////////////////////////////////////////////////
   ///
@@ -29,6 +29,9 @@ class HashJoinPlan : public AbstractJoinPlan {
   using ExpressionPtr = std::unique_ptr<const expression::AbstractExpression>;
 
  public:
+  // SEMI and ANTI joins produce the rows of the right child (the outer side)
+  // that do or don't find a partner among the rows of the left child, each at
+  // most once. The compiled join builds its hash table over the left child.
   HashJoinPlan(JoinType join_type, ExpressionPtr &&predicate,
                std::unique_ptr<const ProjectInfo> &&proj_info,
                std::shared_ptr<const catalog::Schema> &proj_schema,
@@ -57,10 +57,12 @@ class MergeJoinPlan : public AbstractJoinPlan {
 
   void HandleSubplanBinding(bool from_left,
                             const BindingContext &input) override {
+    // The right side of a clause is evaluated against both the (left, right)
+    // tuple pair and a lone right tuple, so it may use either tuple index
     for (auto &join_clause : *GetJoinClauses()) {
       auto &exp = from_left ? join_clause.left_ : join_clause.right_;
       const_cast<expression::AbstractExpression *>(exp.get())
-          ->PerformBinding({&input});
+          ->PerformBinding({&input, &input});
     }
   }
 
@@ -83,7 +85,7 @@ class MergeJoinPlan : public AbstractJoinPlan {
     }
 
     std::unique_ptr<const expression::AbstractExpression> predicate_copy(
-        GetPredicate()->Copy());
+        GetPredicate() != nullptr ? GetPredicate()->Copy() : nullptr);
     std::shared_ptr<const catalog::Schema> schema_copy(
         catalog::Schema::CopySchema(GetSchema()));
     MergeJoinPlan *new_plan = new MergeJoinPlan(
@@ -127,6 +127,18 @@ SETTING_int(min_parallel_table_scan_size,
             1, std::numeric_limits<int32_t>::max(),
             true, true)
 
+SETTING_int(min_parallel_file_scan_size,
+            "Minimum size (in bytes) of an external file before we consider scanning it in parallel (default: 8MB)",
+            8 * 1024 * 1024,
+            1, std::numeric_limits<int32_t>::max(),
+            true, true)
+
+// Bulk load COPY ... FROM STDIN into empty tables
+SETTING_bool(copy_bulk_load,
+             "Build the indexes of empty tables bottom-up when loading them with COPY (default: false)",
+             false,
+             true, true)
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -146,6 +158,18 @@ SETTING_int(stats_mode,
            0, 16,
            true, true)
 
+SETTING_int(analyze_sample_size,
+            "Number of tuples ANALYZE samples from each table, or 0 to scan all tuples (default: 0)",
+            0,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
+// Enable or disable analyzing the tables that changed in the background
+SETTING_bool(auto_analyze,
+            "Enable analyzing changed tables in the background (default: false)",
+            false,
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // AI
 //===----------------------------------------------------------------------===//
@@ -162,6 +186,25 @@ SETTING_bool(layout_tuner,
             false,
             true, true)
 
+// Enable or disable compressing cold tile groups
+SETTING_bool(tile_group_freezer,
+            "Enable compressing cold tile groups (default: false)",
+            false,
+            true, true)
+
+// Memory for the decompressed tuples of frozen tile groups
+SETTING_int(decompressed_tile_cache_size,
+            "Megabytes of decompressed frozen tiles kept for scans (default: 64)",
+            64,
+            0, 65536,
+            true, true)
+
+// Enable or disable compacting sparse tile groups
+SETTING_bool(tile_group_compactor,
+            "Enable compacting sparse tile groups (default: false)",
+            false,
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // BRAIN
 //===----------------------------------------------------------------------===//
@@ -214,9 +257,31 @@ SETTING_bool(dump_ir,
              false,
              true, true)
 
+SETTING_int(min_prefetch_hash_table_size,
+            "Minimum estimated number of entries in the hash table of a hash "
+                "join or aggregation before the generated code prefetches "
+                "from it, 0 to always prefetch (default: 256K)",
+            256 * 1024,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
+SETTING_int(max_shared_aggregation_groups,
+            "Maximum estimated number of groups for which the threads of a "
+                "parallel hash aggregation share one hash table, 0 to "
+                "aggregate serially (default: 1024)",
+            1024,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // Optimizer
 //===----------------------------------------------------------------------===//
+SETTING_bool(plan_cache,
+             "Share the plans of simple queries that only differ in their "
+                 "constants across connections (default: true)",
+             true,
+             true, true)
+
 SETTING_bool(predicate_push_down,
              "Enable predicate push-down optimization (default: true)",
              true,
@@ -227,6 +292,21 @@ SETTING_bool(hash_join_bloom_filter,
              false,
              true, true)
 
+SETTING_int(max_dphyp_join_relations,
+            "Maximum number of relations in a join for the optimizer to "
+                "enumerate its join orders with DPhyp instead of "
+                "transformation rules, 0 to disable (default: 12)",
+            12,
+            0, 64,
+            true, true)
+
+SETTING_int(optimizer_task_threads,
+            "Number of threads the optimizer runs the tasks of a query on, "
+                "1 to run them all on the calling thread (default: 1)",
+            1,
+            1, 64,
+            true, true)
+
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task "
                 "execution step of optimizer, "
@@ -97,6 +97,10 @@ class BackendStatsContext {
   // Increment the insert stat for index
   void IncrementIndexInserts(index::IndexMetadata *metadata);
 
+  // Increment the insert stat for index by insert_count
+  void IncrementIndexInserts(size_t insert_count,
+                             index::IndexMetadata *metadata);
+
   // Increment the update stat for index
   void IncrementIndexUpdates(index::IndexMetadata *metadata);
 
@@ -0,0 +1,308 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_tile.h
+//
+// Identification: src/include/storage/compressed_tile.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/tile.h"
+#include "type/varlen_slot.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile
+//===--------------------------------------------------------------------===//
+
+/**
+ * A read-only, column-wise compressed copy of a tile of a frozen tile group.
+ *
+ * Every column is stored in whichever of the following encodings is the
+ * smallest for its values:
+ *
+ *  - PLAIN: the raw slot values, one after the other
+ *  - FRAME_OF_REFERENCE: integral values as bit-packed offsets from the
+ *    smallest value of the column
+ *  - DICTIONARY: bit-packed codes into the distinct values of the column.
+ *
+ * Variable-length values are always dictionary-encoded, with 1, 2 or 4-byte
+ * codes into a sorted dictionary of the distinct values of the column (the
+ * long values are copied into the pool of this tile). Codes compare like the
+ * values they stand for, with NULL sorting last, so scans and aggregations
+ * can work on the codes and only decode the values they output. Predicates
+ * on a single dictionary-encoded column, string or not, are evaluated once
+ * per distinct value. Compiled plans read the codes and the dictionary in
+ * place, and the other columns from the decompressed values, which are kept
+ * in the DecompressedTileCache while scans need them.
+ *
+ * The tile has no fixed-length tuple slots, so GetTupleLocation() must not be
+ * used on it. Values are decoded one at a time through GetValue(), or a whole
+ * column at a time through DecodeColumn(), which produces exactly the bytes
+ * the original tile stored for the column.
+ */
+class CompressedTile : public Tile {
+ public:
+  enum class Encoding { PLAIN, FRAME_OF_REFERENCE, DICTIONARY };
+
+  /**
+   * Compress the first num_tuples tuples of the given tile
+   */
+  CompressedTile(const Tile &tile, oid_t tile_id, TileGroupHeader *tile_header,
+                 TileGroup *tile_group, oid_t num_tuples);
+
+  ~CompressedTile();
+
+  bool IsCompressed() const override { return true; }
+
+  type::Value GetValue(const oid_t tuple_offset,
+                       const oid_t column_id) override;
+
+  type::Value GetValueFast(const oid_t tuple_offset,
+                           const size_t column_offset,
+                           const type::TypeId column_type,
+                           const bool is_inlined) override;
+
+  /**
+   * Write the stored bytes of the column for tuples [start, end) to the
+   * given buffer, one value every 'stride' bytes
+   */
+  void DecodeColumn(oid_t column_id, oid_t start, oid_t end, char *dest,
+                    size_t stride) const;
+
+  /**
+   * Write the tuples in the fixed-length slot format of the original tile to
+   * the given buffer, which must hold GetCompressedTupleCount() tuples
+   */
+  void Decompress(char *dest) const;
+
+  /**
+   * Get the tuples in the fixed-length slot format of the original tile, and
+   * keep them until the matching UnpinDecompressedData(). Concurrent scans
+   * share the decompressed tuples, and later scans reuse them until the
+   * DecompressedTileCache evicts them.
+   */
+  const char *PinDecompressedData() const;
+
+  void UnpinDecompressedData() const;
+
+  // The number of tuples that were compressed
+  oid_t GetCompressedTupleCount() const { return num_tuples_; }
+
+  /**
+   * Get the smallest and largest non-NULL value of the column. Returns false
+   * if the column has no such value.
+   */
+  bool GetColumnRange(oid_t column_id, type::Value &min,
+                      type::Value &max) const;
+
+  Encoding GetEncoding(oid_t column_id) const {
+    return columns_[column_id].encoding;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Dictionaries
+  //===--------------------------------------------------------------------===//
+
+  // Whether the values of the column are codes into a dictionary
+  bool IsDictionaryEncoded(oid_t column_id) const {
+    return columns_[column_id].encoding == Encoding::DICTIONARY;
+  }
+
+  // Whether the column has a sorted dictionary of variable-length values
+  bool HasStringDictionary(oid_t column_id) const {
+    return columns_[column_id].is_varlen;
+  }
+
+  // The number of entries of the dictionary, including NULL
+  uint32_t GetDictionarySize(oid_t column_id) const {
+    const auto &column = columns_[column_id];
+    return column.is_varlen ? column.varlen_dictionary.size()
+                            : column.dictionary.size();
+  }
+
+  // The value a code of a dictionary-encoded column stands for
+  type::Value GetDictionaryValue(oid_t column_id, uint32_t code) const;
+
+  const type::VarlenSlot &GetDictionaryEntry(oid_t column_id,
+                                             uint32_t code) const {
+    return columns_[column_id].varlen_dictionary[code];
+  }
+
+  // The code of NULL, or INVALID_OID if the column has no NULL
+  uint32_t GetNullCode(oid_t column_id) const {
+    return columns_[column_id].null_code;
+  }
+
+  uint32_t GetCode(oid_t column_id, oid_t tuple_offset) const {
+    const auto &column = columns_[column_id];
+    if (!column.is_varlen) {
+      return Unpack(column.packed, column.bit_width, tuple_offset);
+    }
+    uint32_t code = 0;
+    PELOTON_MEMCPY(&code, &column.codes[tuple_offset * column.code_width],
+                   column.code_width);
+    return code;
+  }
+
+  /**
+   * Get the codes of a string column, GetCodeWidth() bytes each. Any code may
+   * be read as a little-endian 4-byte integer whose high bytes are masked off,
+   * since the codes are followed by enough padding.
+   */
+  const char *GetCodes(oid_t column_id) const {
+    return columns_[column_id].codes.data();
+  }
+
+  uint32_t GetCodeWidth(oid_t column_id) const {
+    return columns_[column_id].code_width;
+  }
+
+  // The entries of the dictionary, indexed by code
+  const type::VarlenSlot *GetDictionary(oid_t column_id) const {
+    return columns_[column_id].varlen_dictionary.data();
+  }
+
+  // Write the codes of the column for tuples [start, end) to the given array
+  void DecodeCodes(oid_t column_id, oid_t start, oid_t end,
+                   uint32_t *dest) const;
+
+  /**
+   * Find the first code whose (non-NULL) value is not less than the given
+   * one. The value is in the dictionary iff its code is smaller than the
+   * number of non-NULL values and the entry is equal to it.
+   */
+  uint32_t FindCode(oid_t column_id, const char *data, uint32_t length) const;
+
+  // Whether the given (non-NULL) value is in the dictionary of the column
+  bool DictionaryContains(oid_t column_id, const char *data,
+                          uint32_t length) const;
+
+  // The number of bytes the compressed columns occupy
+  size_t GetCompressedSize() const;
+
+  const std::string GetInfo() const override;
+
+ private:
+  struct CompressedColumn {
+    Encoding encoding;
+
+    // The size of a stored value of the column
+    uint32_t value_length;
+
+    // The number of bits of every packed offset or code
+    uint32_t bit_width;
+
+    // The frame of reference
+    int64_t base;
+
+    // The packed offsets or codes
+    std::vector<uint64_t> packed;
+
+    // The distinct stored values (i.e., the slot bytes) of the column
+    std::vector<uint64_t> dictionary;
+
+    // Whether the values of the column are stored in varlen slots
+    bool is_varlen;
+
+    // The sorted distinct varlen slots of a variable-length column, followed
+    // by NULL if the column has NULLs
+    std::vector<type::VarlenSlot> varlen_dictionary;
+
+    // The code of NULL in the dictionary, or INVALID_OID
+    uint32_t null_code;
+
+    // The number of bytes of every code, and the codes
+    uint32_t code_width;
+    std::vector<char> codes;
+
+    // The raw values of a plain column
+    std::vector<char> plain;
+
+    bool has_range;
+    type::Value min;
+    type::Value max;
+  };
+
+  void CompressColumn(const Tile &tile, oid_t column_id, oid_t num_tuples);
+
+  // The stored bytes of a value, widened to 64 bits
+  uint64_t DecodeSlot(const CompressedColumn &column, oid_t tuple_offset) const;
+
+  static uint64_t Unpack(const std::vector<uint64_t> &packed,
+                         uint32_t bit_width, oid_t index);
+
+  // Free the decompressed tuples unless a scan pins them. Returns whether
+  // they were freed.
+  bool EvictDecompressedData() const;
+
+  friend class DecompressedTileCache;
+
+ private:
+  oid_t num_tuples_;
+
+  std::vector<CompressedColumn> columns_;
+
+  // The tuples in the format of the original tile while they are cached, and
+  // the number of scans using them
+  mutable std::mutex decompress_latch_;
+  mutable std::unique_ptr<char[]> decompressed_data_;
+  mutable uint32_t pin_count_;
+};
+
+//===--------------------------------------------------------------------===//
+// Decompressed Tile Cache
+//===--------------------------------------------------------------------===//
+
+/**
+ * Bounds the memory the decompressed tuples of compressed tiles take up to
+ * decompressed_tile_cache_size megabytes. When the limit is exceeded, the
+ * least recently used tiles that no scan pins are evicted, and decompressed
+ * again by the next scan that needs them. Pinned tiles are never evicted, so
+ * the cache may go over the limit while many scans run.
+ */
+class DecompressedTileCache {
+ public:
+  static DecompressedTileCache &GetInstance();
+
+  // Account for the tuples the tile just decompressed, and evict other tiles
+  // if we're over the limit
+  void Admit(const CompressedTile *tile, size_t size);
+
+  // Mark the tile as the most recently used one
+  void Touch(const CompressedTile *tile);
+
+  // Forget the tile, which is being destroyed
+  void Remove(const CompressedTile *tile);
+
+  // The number of bytes of decompressed tuples in the cache
+  size_t GetSize();
+
+ private:
+  using Entry = std::pair<const CompressedTile *, size_t>;
+
+  std::mutex cache_latch_;
+
+  // Most recently used first
+  std::list<Entry> lru_list_;
+  std::unordered_map<const CompressedTile *, std::list<Entry>::iterator>
+      entries_;
+  size_t size_ = 0;
+};
+
+}  // namespace storage
+}  // namespace peloton
@@ -137,6 +137,31 @@ class DataTable : public AbstractTable {
                    concurrency::TransactionContext *transaction,
                    ItemPointer **index_entry_ptr, bool check_fk = true);
 
+  //===--------------------------------------------------------------------===//
+  // BULK LOAD
+  //===--------------------------------------------------------------------===//
+
+  // whether no tuple slot has ever been claimed in this table
+  bool IsEmpty() const;
+
+  // lock the table for a bulk load by the transaction. fails if another bulk
+  // load holds the lock, or if the table is not empty. while the lock is
+  // held, inserts of other transactions fail. the lock is released when the
+  // transaction commits or aborts.
+  bool LockForBulkLoad(concurrency::TransactionContext *transaction);
+
+  // publish tile groups that were populated outside of the table (e.g., from
+  // GetTileGroupWithLayout()) as a whole. constraints are checked and every
+  // index is built from the sorted keys in one go. the tuples are then
+  // registered as inserts of the transaction, so they become visible when it
+  // commits, are logged with its other writes, and are rolled back if it
+  // aborts.
+  // the caller must hold the bulk load lock (see LockForBulkLoad()).
+  // returns false on an index or foreign key violation, in which case the
+  // table is left unmodified.
+  bool BulkLoad(const std::vector<std::shared_ptr<TileGroup>> &tile_groups,
+                concurrency::TransactionContext *transaction);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -146,7 +171,8 @@ class DataTable : public AbstractTable {
 
   void AddTileGroup(const std::shared_ptr<TileGroup> &tile_group);
 
-  // Offset is a 0-based number local to the table
+  // Offset is a 0-based number local to the table. Returns nullptr if the
+  // tile group at the offset was retired (see DropTileGroup).
   std::shared_ptr<storage::TileGroup> GetTileGroup(
       const std::size_t &tile_group_offset) const;
 
@@ -154,8 +180,16 @@ class DataTable : public AbstractTable {
   std::shared_ptr<storage::TileGroup> GetTileGroupById(
       const oid_t &tile_group_id) const;
 
+  // The number of tile group offsets, including those of retired tile groups
   size_t GetTileGroupCount() const;
 
+  size_t GetTuplesPerTileGroup() const { return tuples_per_tilegroup_; }
+
+  // Remove the tile group at the given offset from the table and drop it. The
+  // caller must make sure that no transaction can still reach any version in
+  // the tile group.
+  void DropTileGroup(const oid_t &tile_group_offset);
+
   // Get a tile group with given layout
   TileGroup *GetTileGroupWithLayout(std::shared_ptr<const Layout> layout);
 
@@ -214,6 +248,33 @@ class DataTable : public AbstractTable {
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  // Replace the tile group with a compressed, read-only copy if it is full
+  // and none of its tuples has been modified since the oldest running
+  // transaction started. Returns the frozen tile group, or nullptr if the
+  // tile group is not eligible.
+  storage::TileGroup *FreezeTileGroup(const oid_t &tile_group_offset);
+
+  // Move the live tuples of the tile group to other tile groups if it is full
+  // and at most max_occupancy of its slots still hold live tuples. The moves
+  // are ordinary MVCC updates, so the indexes follow the tuples through their
+  // indirection pointers. Returns the commit id of the relocating transaction,
+  // or INVALID_CID if the tile group was not compacted.
+  cid_t CompactTileGroup(const oid_t &tile_group_offset,
+                         const double &max_occupancy);
+
+  // Move up to batch_size live tuples of a full tile group whose layout
+  // differs from the default layout by at least theta to other tile groups,
+  // in the same way as CompactTileGroup. Returns the number of live tuples
+  // left in the tile group, or INVALID_OID if it is not migrated.
+  oid_t MigrateTileGroup(const oid_t &tile_group_offset, const double &theta,
+                         const size_t &batch_size);
+
+  // Drop a compacted or migrated tile group once none of its slots holds a
+  // version that a running transaction may still read or write, or that the
+  // GC has yet to recycle. Returns false if the tile group cannot be retired
+  // (yet).
+  bool RetireTileGroup(const oid_t &tile_group_offset);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -226,6 +287,10 @@ class DataTable : public AbstractTable {
 
   size_t GetTupleCount() const;
 
+  // Get the number of versions that were inserted into or removed from the
+  // table so far. Unlike the tuple count, it only ever grows.
+  size_t GetModificationCount() const { return modification_count_; }
+
   bool IsDirty() const;
 
   void ResetDirty();
@@ -333,13 +398,25 @@ class DataTable : public AbstractTable {
 
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
+  // release the bulk load lock held by the transaction
+  void UnlockBulkLoad(txn_id_t txn_id);
+
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
+  // Move the given live tuples of the tile group to other tile groups in a
+  // single transaction. Sets the commit id of the transaction and returns
+  // false if it had to abort.
+  bool MoveTuples(storage::TileGroup *tile_group,
+                  const std::vector<oid_t> &tuple_ids, cid_t &commit_id);
+
   //===--------------------------------------------------------------------===//
   // INDEX HELPERS
   //===--------------------------------------------------------------------===//
 
+  // allocate an indirection entry pointing to the given location
+  ItemPointer *AllocateIndirection(const ItemPointer &location);
+
   bool InsertInSecondaryIndexes(const AbstractTuple *tuple,
                                 const TargetList *targets_ptr,
                                 concurrency::TransactionContext *transaction,
@@ -408,6 +485,16 @@ class DataTable : public AbstractTable {
   // concurrently.
   std::atomic<size_t> number_of_tuples_ = ATOMIC_VAR_INIT(0);
 
+  // # of versions inserted or removed, for the auto-analyzer
+  std::atomic<size_t> modification_count_ = ATOMIC_VAR_INIT(0);
+
+  // the transaction that holds the bulk load lock, if any
+  std::atomic<txn_id_t> bulk_load_owner_ = ATOMIC_VAR_INIT(INVALID_TXN_ID);
+
+  // the indirection arrays of bulk loaded tuples
+  std::vector<std::shared_ptr<storage::IndirectionArray>>
+      bulk_load_indirection_arrays_;
+
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
 
@@ -86,15 +86,21 @@ class Tile : public Printable {
   /**
    * Returns value present at slot
    */
-  type::Value GetValue(const oid_t tuple_offset, const oid_t column_id);
+  virtual type::Value GetValue(const oid_t tuple_offset,
+                               const oid_t column_id);
 
   /*
    * Faster way to get value
    * By amortizing schema lookups
    */
-  type::Value GetValueFast(const oid_t tuple_offset, const size_t column_offset,
-                           const type::TypeId column_type,
-                           const bool is_inlined);
+  virtual type::Value GetValueFast(const oid_t tuple_offset,
+                                   const size_t column_offset,
+                                   const type::TypeId column_type,
+                                   const bool is_inlined);
+
+  // Whether the tuples are kept in a compressed format rather than in
+  // fixed-length tuple slots (see CompressedTile)
+  virtual bool IsCompressed() const { return false; }
 
   /**
    * Sets value at tuple slot.
@@ -178,6 +184,12 @@ class Tile : public Printable {
   void Sync();
 
  protected:
+  // Creates a tile without any tuple slots, for tiles that store their tuples
+  // in a format of their own
+  Tile(BackendType backend_type, TileGroupHeader *tile_header,
+       const catalog::Schema &tuple_schema, TileGroup *tile_group,
+       int tuple_count, bool allocate_slots);
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
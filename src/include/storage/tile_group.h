@@ -154,6 +154,10 @@ class TileGroup : public Printable {
 
   size_t GetTileCount() const { return tile_count_; }
 
+  // Whether the tiles of this tile group are compressed (see
+  // TileGroupFactory::GetFrozenTileGroup)
+  bool IsFrozen() const { return frozen_; }
+
   type::Value GetValue(oid_t tuple_id, oid_t column_id);
 
   void SetValue(type::Value &value, oid_t tuple_id, oid_t column_id);
@@ -192,6 +196,9 @@ class TileGroup : public Printable {
   // number of tiles
   uint32_t tile_count_;
 
+  // whether the tiles are compressed, read-only copies
+  bool frozen_;
+
   std::mutex tile_group_mutex;
 
   // Refernce to the layout of the TileGroup
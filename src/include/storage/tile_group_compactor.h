@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/storage/tile_group_compactor.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor
+//===--------------------------------------------------------------------===//
+
+/**
+ * Background service that reclaims the sparse tile groups of the registered
+ * tables (see DataTable::CompactTileGroup).
+ *
+ * The live tuples of a full tile group with few of them left are moved to
+ * other tile groups in a single transaction. The emptied tile group is
+ * retired in a later round, once no transaction that may still read the old
+ * versions is running anymore.
+ */
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+  TileGroupCompactor(TileGroupCompactor &&) = delete;
+  TileGroupCompactor &operator=(TileGroupCompactor &&) = delete;
+
+  TileGroupCompactor() : compactor_stop_(true) {}
+
+  static TileGroupCompactor &GetInstance();
+
+  void Start();
+
+  void Stop();
+
+  /**
+   * Go over all registered tables once, retire the tile groups that were
+   * compacted before and compact the sparse ones.
+   *
+   * @return     The number of tile groups that were retired
+   */
+  size_t CompactTables();
+
+  void AddTable(DataTable *table);
+
+  void RemoveTable(oid_t table_oid);
+
+  void ClearTables();
+
+  void SetMaxOccupancy(double max_occupancy) { max_occupancy_ = max_occupancy; }
+
+ private:
+  void Running();
+
+  struct TableEntry {
+    DataTable *table;
+
+    // Compacted tile groups waiting to be retired, as pairs of the tile group
+    // offset and the commit id of the relocating transaction
+    std::vector<std::pair<oid_t, cid_t>> compacted;
+  };
+
+  // Registered tables, by table oid
+  std::unordered_map<oid_t, TableEntry> tables_;
+
+  std::mutex compactor_mutex_;
+
+  std::atomic<bool> compactor_stop_;
+
+  std::thread compactor_thread_;
+
+  // Fraction of live tuples under which a tile group is compacted
+  double max_occupancy_ = 0.3;
+
+  // Sleeping period between two rounds (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // namespace storage
+}  // namespace peloton
@@ -34,6 +34,13 @@ class TileGroupFactory {
                                  const std::vector<catalog::Schema> &schemas,
                                  std::shared_ptr<const Layout> layout,
                                  int tuple_count);
+
+  /**
+   * Build a frozen copy of the given tile group: the tuples are the same, but
+   * every tile is compressed. The MVCC header is copied as it is, since the
+   * versions in a frozen tile group can still be updated or deleted.
+   */
+  static TileGroup *GetFrozenTileGroup(TileGroup *tile_group);
 };
 
 }  // namespace storage
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.h
+//
+// Identification: src/include/storage/tile_group_freezer.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer
+//===--------------------------------------------------------------------===//
+
+/**
+ * Background service that replaces the cold tile groups of the registered
+ * tables with compressed, read-only copies (see DataTable::FreezeTileGroup).
+ *
+ * A tile group is cold once it is full and none of its tuples has been
+ * modified since the oldest running transaction started. Tile groups that are
+ * not cold yet are retried in the next round.
+ */
+class TileGroupFreezer {
+ public:
+  TileGroupFreezer(const TileGroupFreezer &) = delete;
+  TileGroupFreezer &operator=(const TileGroupFreezer &) = delete;
+  TileGroupFreezer(TileGroupFreezer &&) = delete;
+  TileGroupFreezer &operator=(TileGroupFreezer &&) = delete;
+
+  TileGroupFreezer() : freezer_stop_(true) {}
+
+  static TileGroupFreezer &GetInstance();
+
+  void Start();
+
+  void Stop();
+
+  /**
+   * Go over all registered tables once and freeze their cold tile groups.
+   *
+   * @return     The number of tile groups that were frozen
+   */
+  size_t FreezeTables();
+
+  void AddTable(DataTable *table);
+
+  void RemoveTable(oid_t table_oid);
+
+  void ClearTables();
+
+ private:
+  void Running();
+
+  struct TableEntry {
+    DataTable *table;
+
+    // Every tile group before this offset is frozen
+    oid_t next_offset;
+  };
+
+  // Registered tables, by table oid
+  std::unordered_map<oid_t, TableEntry> tables_;
+
+  std::mutex freezer_mutex_;
+
+  std::atomic<bool> freezer_stop_;
+
+  std::thread freezer_thread_;
+
+  // Sleeping period between two rounds (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // namespace storage
+}  // namespace peloton
@@ -88,6 +88,7 @@ class TileGroupHeader : public Printable {
     num_tuple_slots = other.num_tuple_slots;
     next_tuple_slot.store(other.next_tuple_slot);
     immutable = other.immutable;
+    gc_pending_versions.store(other.gc_pending_versions);
 
     // copy tuple header values
     for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
@@ -263,6 +264,43 @@ class TileGroupHeader : public Printable {
 
   inline bool GetImmutability() const { return immutable; }
 
+  /*
+  * @brief The following method use Compare and Swap to seal the tilegroup,
+  so that no transaction can acquire the ownership of its tuples anymore.
+  */
+  inline bool SetSealed() {
+    bool unsealed = false;
+    return sealed.compare_exchange_strong(unsealed, true);
+  }
+
+  inline void ResetSealed() { sealed = false; }
+
+  inline bool IsSealed() const { return sealed; }
+
+  /*
+  * @brief The following method use Compare and Swap to mark the tilegroup as
+  draining, so that the GC and inserts no longer reuse its free slots while
+  its tuples are moved out of it.
+  */
+  inline bool SetDraining() {
+    bool not_draining = false;
+    return draining.compare_exchange_strong(not_draining, true);
+  }
+
+  inline void ResetDraining() { draining = false; }
+
+  inline bool IsDraining() const { return draining; }
+
+  // The number of versions in the tile group that committed or aborted
+  // transactions handed to the GC, and that it has yet to recycle
+  inline void AddGCPendingVersions(const size_t &count) {
+    gc_pending_versions.fetch_add(count);
+  }
+
+  inline void RemoveGCPendingVersion() { gc_pending_versions.fetch_sub(1); }
+
+  inline size_t GetGCPendingVersions() const { return gc_pending_versions; }
+
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
   // Getter for spin lock
@@ -301,6 +339,17 @@ class TileGroupHeader : public Printable {
   // Immmutable Flag. Should be set by the indextuner to be true.
   // By default it will be set to false.
   bool immutable;
+
+  // Sealed Flag. Set while the tile group is replaced by a frozen copy, and
+  // for good once it is. It is not copied along with the header.
+  std::atomic<bool> sealed;
+
+  // Draining Flag. Set while the tuples of the tile group are moved out of
+  // it, until it is retired. It is not copied along with the header.
+  std::atomic<bool> draining;
+
+  // Number of versions the GC has yet to recycle
+  std::atomic<size_t> gc_pending_versions;
 };
 
 }  // namespace storage
@@ -66,10 +66,18 @@ class ZoneMapManager {
   std::unique_ptr<ZoneMapManager::ColumnStatistics> GetZoneMapFromCatalog(
       oid_t database_id, oid_t table_id, oid_t tile_group_id, oid_t col_itr);
 
+  // Frozen tile groups are checked against the exact value ranges that were
+  // computed when they were compressed, everything else against the zone
+  // maps in the catalog (if any)
   bool ShouldScanTileGroup(storage::PredicateInfo *parsed_predicates,
                            int32_t num_predicates, storage::DataTable *table,
                            int64_t tile_group_id);
 
+  // Could the tile group hold a value of the (integral) column in the range
+  // [min, max]? An empty range (min > max) overlaps no tile group.
+  bool TileGroupOverlapsRange(storage::DataTable *table, int64_t tile_group_id,
+                              int32_t col_id, int64_t min, int64_t max);
+
   bool ZoneMapTableExists();
 
  private:
@@ -83,6 +91,14 @@ class ZoneMapManager {
     return val.CastAs(type_id);
   }
 
+  std::unique_ptr<ZoneMapManager::ColumnStatistics> GetZoneMapFromTileGroup(
+      storage::TileGroup *tile_group, oid_t column_id);
+
+  // Could the column of the frozen tile group hold the given value? Only
+  // string columns keep a dictionary of their values to check against.
+  bool DictionaryMayContain(storage::TileGroup *tile_group, oid_t column_id,
+                            const type::Value &value);
+
   std::unique_ptr<ZoneMapManager::ColumnStatistics> GetResultVectorAsZoneMap(
       std::unique_ptr<std::vector<type::Value>> &result_vector);
 
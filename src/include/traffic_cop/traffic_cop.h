@@ -78,11 +78,14 @@ class TrafficCop {
       const std::vector<type::Value> &params, std::vector<ResultValue> &result,
       const std::vector<int> &result_format, size_t thread_id = 0);
 
-  // Prepare a statement using the parse tree
+  // Prepare a statement using the parse tree. If param_values is given, the
+  // plan may be shared with other queries through the global plan cache, and
+  // param_values receives the constants that were lifted into parameters.
   std::shared_ptr<Statement> PrepareStatement(
       const std::string &statement_name, const std::string &query_string,
       std::unique_ptr<parser::SQLStatementList> sql_stmt_list,
-      size_t thread_id = 0);
+      size_t thread_id = 0,
+      std::vector<type::Value> *param_values = nullptr);
 
   bool BindParamsForCachePlan(
       const std::vector<std::unique_ptr<expression::AbstractExpression>> &,
@@ -14,7 +14,9 @@
 
 #include <atomic>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "clusterer.h"
@@ -91,12 +93,41 @@ class LayoutTuner {
    */
   bool UpdateDefaultPartition(storage::DataTable *table);
 
+  /**
+   * Move a batch of tuples out of the tile groups of the table whose layout
+   * differs from the default layout, and retire the drained tile groups. The
+   * batch shrinks as the share of updates in the workload samples grows.
+   *
+   * @param      table  The table
+   * @return     The number of tile groups that were retired
+   */
+  size_t MigrateTileGroups(storage::DataTable *table);
+
  private:
   /**
    * Tables whose layout must be tuned
    */
   std::vector<storage::DataTable *> tables;
 
+  /**
+   * Progress of the layout migration of a table
+   */
+  struct MigrationState {
+    /** Offset of the tile group being migrated */
+    oid_t tile_group_offset = 0;
+
+    /** Drained tile groups waiting to be retired */
+    std::set<oid_t> drained_offsets;
+
+    /** Share of updates in the last workload samples */
+    double update_ratio = 0;
+  };
+
+  /**
+   * Migration progress, by table oid
+   */
+  std::unordered_map<oid_t, MigrationState> migration_states;
+
   std::mutex layout_tuner_mutex;
 
   /**
@@ -135,6 +166,9 @@ class LayoutTuner {
   /** Desired layout tile count */
   oid_t tile_count = 2;
 
+  /** Largest number of tuples migrated per table and round */
+  size_t migration_batch_size = 100;
+
 };
 
 }  // namespace indextuner
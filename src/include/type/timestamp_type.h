@@ -21,6 +21,9 @@ class TimestampType : public Type {
  public:
   static constexpr uint64_t kUsecsPerDate = 86400000000ul;
 
+  // The size of a buffer that fits any formatted timestamp
+  static constexpr uint32_t kMaxStringLength = 32;
+
   ~TimestampType() {}
   TimestampType();
   
@@ -41,6 +44,10 @@ class TimestampType : public Type {
   // Debug
   std::string ToString(const Value& val) const override;
 
+  // Format the timestamp into a buffer of at least kMaxStringLength bytes,
+  // returning the number of characters written
+  static uint32_t FormatTo(uint64_t timestamp, char *buf);
+
   // Compute a hash value
   size_t Hash(const Value& val) const override;
   void HashCombine(const Value& val, size_t &seed) const override;
@@ -17,6 +17,7 @@
 
 #include "common/logger.h"
 #include "type/type.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace type {
@@ -54,7 +55,8 @@ class TypeUtil {
    * <B>WARNING:</B> This is dangerous AF. Use at your own risk!!
    */
   static CmpBool CompareEqualsRaw(type::Type type, const char* left,
-                                  const char* right, bool inlined) {
+                                  const char* right,
+                                  bool inlined UNUSED_ATTRIBUTE) {
     CmpBool result = CmpBool::NULL_;
     switch (type.GetTypeId()) {
       case TypeId::BOOLEAN:
@@ -103,21 +105,14 @@ class TypeUtil {
       }
       case TypeId::VARCHAR:
       case TypeId::VARBINARY: {
-        const char* leftPtr = left;
-        const char* rightPtr = right;
-        if (inlined == false) {
-          leftPtr = *reinterpret_cast<const char* const*>(left);
-          rightPtr = *reinterpret_cast<const char* const*>(right);
-        }
-        if (leftPtr == nullptr || rightPtr == nullptr) {
+        // Varlens are always stored in a slot, whether inlined or not
+        auto* leftSlot = reinterpret_cast<const VarlenSlot*>(left);
+        auto* rightSlot = reinterpret_cast<const VarlenSlot*>(right);
+        if (leftSlot->IsNull() || rightSlot->IsNull()) {
           result = CmpBool::CmpFalse;
           break;
         }
-        uint32_t leftLen = *reinterpret_cast<const uint32_t*>(leftPtr);
-        uint32_t rightLen = *reinterpret_cast<const uint32_t*>(rightPtr);
-        result = GetCmpBool(TypeUtil::CompareStrings(
-                                leftPtr + sizeof(uint32_t), leftLen,
-                                rightPtr + sizeof(uint32_t), rightLen) == 0);
+        result = GetCmpBool(VarlenSlot::Equals(*leftSlot, *rightSlot));
         break;
       }
       default: { break; }
@@ -133,7 +128,8 @@ class TypeUtil {
    * <B>WARNING:</B> This is dangerous AF. Use at your own risk!!
    */
   static CmpBool CompareLessThanRaw(const type::Type type, const char* left,
-                                    const char* right, bool inlined) {
+                                    const char* right,
+                                    bool inlined UNUSED_ATTRIBUTE) {
     CmpBool result = CmpBool::NULL_;
     switch (type.GetTypeId()) {
       case TypeId::BOOLEAN:
@@ -182,21 +178,14 @@ class TypeUtil {
       }
       case TypeId::VARCHAR:
       case TypeId::VARBINARY: {
-        const char* leftPtr = left;
-        const char* rightPtr = right;
-        if (inlined == false) {
-          leftPtr = *reinterpret_cast<const char* const*>(left);
-          rightPtr = *reinterpret_cast<const char* const*>(right);
-        }
-        if (leftPtr == nullptr || rightPtr == nullptr) {
+        // Varlens are always stored in a slot, whether inlined or not
+        auto* leftSlot = reinterpret_cast<const VarlenSlot*>(left);
+        auto* rightSlot = reinterpret_cast<const VarlenSlot*>(right);
+        if (leftSlot->IsNull() || rightSlot->IsNull()) {
           result = CmpBool::CmpFalse;
           break;
         }
-        uint32_t leftLen = *reinterpret_cast<const uint32_t*>(leftPtr);
-        uint32_t rightLen = *reinterpret_cast<const uint32_t*>(rightPtr);
-        result = GetCmpBool(TypeUtil::CompareStrings(
-                                leftPtr + sizeof(uint32_t), leftLen,
-                                rightPtr + sizeof(uint32_t), rightLen) < 0);
+        result = GetCmpBool(VarlenSlot::Compare(*leftSlot, *rightSlot) < 0);
         break;
       }
       default: { break; }
@@ -212,7 +201,8 @@ class TypeUtil {
    * <B>WARNING:</B> This is dangerous AF. Use at your own risk!!
    */
   static CmpBool CompareGreaterThanRaw(const type::Type type, const char* left,
-                                       const char* right, bool inlined) {
+                                       const char* right,
+                                       bool inlined UNUSED_ATTRIBUTE) {
     CmpBool result = CmpBool::NULL_;
     switch (type.GetTypeId()) {
       case TypeId::BOOLEAN:
@@ -261,21 +251,14 @@ class TypeUtil {
       }
       case TypeId::VARCHAR:
       case TypeId::VARBINARY: {
-        const char* leftPtr = left;
-        const char* rightPtr = right;
-        if (inlined == false) {
-          leftPtr = *reinterpret_cast<const char* const*>(left);
-          rightPtr = *reinterpret_cast<const char* const*>(right);
-        }
-        if (leftPtr == nullptr || rightPtr == nullptr) {
+        // Varlens are always stored in a slot, whether inlined or not
+        auto* leftSlot = reinterpret_cast<const VarlenSlot*>(left);
+        auto* rightSlot = reinterpret_cast<const VarlenSlot*>(right);
+        if (leftSlot->IsNull() || rightSlot->IsNull()) {
           result = CmpBool::CmpFalse;
           break;
         }
-        uint32_t leftLen = *reinterpret_cast<const uint32_t*>(leftPtr);
-        uint32_t rightLen = *reinterpret_cast<const uint32_t*>(rightPtr);
-        result = GetCmpBool(TypeUtil::CompareStrings(
-                                leftPtr + sizeof(uint32_t), leftLen,
-                                rightPtr + sizeof(uint32_t), rightLen) > 0);
+        result = GetCmpBool(VarlenSlot::Compare(*leftSlot, *rightSlot) > 0);
         break;
       }
       default: { break; }
@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// varlen_slot.h
+//
+// Identification: src/include/type/varlen_slot.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "type/abstract_pool.h"
+#include "type/limits.h"
+
+namespace peloton {
+namespace type {
+
+/**
+ * The in-tuple storage of a variable-length value. It takes 16 bytes:
+ *
+ *   short value: | length (4) | data (12)                     |
+ *   long value:  | length (4) | prefix (4) | area pointer (8) |
+ *
+ * Values of up to VARLEN_SLOT_INLINE_LENGTH bytes are stored in the slot
+ * itself. Longer values are stored in a length-prefixed area allocated from
+ * the pool, and the slot keeps a copy of their first VARLEN_SLOT_PREFIX_LENGTH
+ * bytes. Either way, the four bytes after the length are the first bytes of
+ * the value, so comparisons can often be decided without leaving the slot.
+ * Unused bytes are zero. A NULL value has length PELOTON_VALUE_NULL.
+ */
+struct VarlenSlot {
+  uint32_t length;
+  char prefix[4];
+  union {
+    char suffix[8];
+    const char *area;
+  };
+
+  inline bool IsNull() const { return length == PELOTON_VALUE_NULL; }
+
+  inline bool IsInlined() const;
+
+  // The bytes of the (non-NULL) value
+  inline const char *GetData() const;
+
+  // The pool area of a long value, or nullptr
+  inline char *GetArea() const;
+
+  inline static void SetNull(char *storage);
+
+  // Store the value in the slot, allocating the area of a long value from the
+  // pool (or the heap if there is no pool)
+  inline static void Set(char *storage, const char *data, uint32_t length,
+                         AbstractPool *pool);
+
+  // Make room for a value of the given length like Set(), and return where its
+  // bytes go. Once they are written, CopyPrefix() must be called.
+  inline static char *Reserve(char *storage, uint32_t length,
+                              AbstractPool *pool);
+
+  inline static void CopyPrefix(char *storage);
+
+  // Compare the (non-NULL) values like memcmp(), then by length
+  inline static int Compare(const VarlenSlot &left, const VarlenSlot &right);
+
+  // Check the (non-NULL) values for equality
+  inline static bool Equals(const VarlenSlot &left, const VarlenSlot &right);
+};
+
+static const uint32_t VARLEN_SLOT_INLINE_LENGTH = 12;
+static const uint32_t VARLEN_SLOT_PREFIX_LENGTH = 4;
+
+static_assert(sizeof(VarlenSlot) == 16, "varlen slots must take 16 bytes");
+
+bool VarlenSlot::IsInlined() const {
+  return length <= VARLEN_SLOT_INLINE_LENGTH;
+}
+
+const char *VarlenSlot::GetData() const {
+  return IsInlined() ? prefix : area + sizeof(uint32_t);
+}
+
+char *VarlenSlot::GetArea() const {
+  return (IsNull() || IsInlined()) ? nullptr : const_cast<char *>(area);
+}
+
+void VarlenSlot::SetNull(char *storage) {
+  auto *slot = reinterpret_cast<VarlenSlot *>(storage);
+  std::memset(slot, 0, sizeof(VarlenSlot));
+  slot->length = PELOTON_VALUE_NULL;
+}
+
+void VarlenSlot::Set(char *storage, const char *data, uint32_t length,
+                     AbstractPool *pool) {
+  std::memcpy(Reserve(storage, length, pool), data, length);
+  CopyPrefix(storage);
+}
+
+char *VarlenSlot::Reserve(char *storage, uint32_t length, AbstractPool *pool) {
+  auto *slot = reinterpret_cast<VarlenSlot *>(storage);
+  std::memset(slot, 0, sizeof(VarlenSlot));
+  slot->length = length;
+  if (length <= VARLEN_SLOT_INLINE_LENGTH) {
+    return slot->prefix;
+  }
+  uint32_t size = length + sizeof(uint32_t);
+  char *area = (pool == nullptr) ? new char[size]
+                                 : static_cast<char *>(pool->Allocate(size));
+  std::memcpy(area, &length, sizeof(uint32_t));
+  slot->area = area;
+  return area + sizeof(uint32_t);
+}
+
+void VarlenSlot::CopyPrefix(char *storage) {
+  auto *slot = reinterpret_cast<VarlenSlot *>(storage);
+  if (!slot->IsInlined()) {
+    std::memcpy(slot->prefix, slot->area + sizeof(uint32_t),
+                VARLEN_SLOT_PREFIX_LENGTH);
+  }
+}
+
+int VarlenSlot::Compare(const VarlenSlot &left, const VarlenSlot &right) {
+  uint32_t min_length = std::min(left.length, right.length);
+  int ret = std::memcmp(left.prefix, right.prefix,
+                        std::min(min_length, VARLEN_SLOT_PREFIX_LENGTH));
+  if (ret == 0 && min_length > VARLEN_SLOT_PREFIX_LENGTH) {
+    ret = std::memcmp(left.GetData(), right.GetData(), min_length);
+  }
+  if (ret == 0 && left.length != right.length) {
+    ret = left.length < right.length ? -1 : 1;
+  }
+  return ret;
+}
+
+bool VarlenSlot::Equals(const VarlenSlot &left, const VarlenSlot &right) {
+  // The unused bytes of the prefix are zero, so it is compared as a whole
+  if (left.length != right.length ||
+      std::memcmp(left.prefix, right.prefix, VARLEN_SLOT_PREFIX_LENGTH) != 0) {
+    return false;
+  }
+  if (left.length <= VARLEN_SLOT_PREFIX_LENGTH) {
+    return true;
+  }
+  return std::memcmp(left.GetData(), right.GetData(), left.length) == 0;
+}
+
+}  // namespace type
+}  // namespace peloton
@@ -56,6 +56,12 @@ class File {
 
   uint64_t Size() const;
 
+  // Map the first len bytes of the file into memory, read-only. The returned
+  // region must be released through Unmap().
+  const char *Map(uint64_t len) const;
+
+  static void Unmap(const char *addr, uint64_t len);
+
   bool IsOpen() const { return fd_ != kInvalid; }
 
   void Close();
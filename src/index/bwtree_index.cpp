@@ -12,6 +12,7 @@
 
 #include "index/bwtree_index.h"
 
+#include "gc/gc_manager.h"
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
 #include "statistics/stats_aggregator.h"
@@ -36,11 +37,13 @@ BWTREE_INDEX_TYPE::BWTreeIndex(IndexMetadata *metadata)
       // NOTE 2: We set the first parameter to false to disable automatic GC
       //
       container{false, comparator, equals, hash_func} {
+  // Garbage nodes of the tree are freed by the GC threads
+  gc::GCManager::RegisterIndex(this);
   return;
 }
         
 BWTREE_TEMPLATE_ARGUMENTS
-BWTREE_INDEX_TYPE::~BWTreeIndex() {}
+BWTREE_INDEX_TYPE::~BWTreeIndex() { gc::GCManager::DeregisterIndex(this); }
 
 /*
  * InsertEntry() - insert a key-value pair into the map
@@ -208,6 +211,50 @@ void BWTREE_INDEX_TYPE::Scan(
   return;
 }
 
+/*
+ * BulkLoad() - Sort the entries and build the tree bottom-up
+ *
+ * Unique indexes reject batches with duplicate keys before the tree is
+ * touched. If the tree is not empty we fall back to inserting one by one.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::BulkLoad(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entries) {
+  std::vector<std::pair<KeyType, ValueType>> items(entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    items[i].first.SetFromKey(entries[i].first);
+    items[i].second = entries[i].second;
+  }
+
+  std::stable_sort(items.begin(), items.end(),
+                   [this](const std::pair<KeyType, ValueType> &a,
+                          const std::pair<KeyType, ValueType> &b) {
+                     return comparator(a.first, b.first);
+                   });
+
+  if (HasUniqueKeys() == true) {
+    for (size_t i = 1; i < items.size(); i++) {
+      if (equals(items[i - 1].first, items[i].first) == true) {
+        return false;
+      }
+    }
+  }
+
+  if (container.BulkLoad(items) == false) {
+    return Index::BulkLoad(entries);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(
+        items.size(), metadata);
+  }
+
+  LOG_TRACE("BulkLoad(%lu entries) [SUCCESS]", items.size());
+
+  return true;
+}
+
 /*
  * ScanLimit() - Scan the index with predicate and limit/offset
  *
@@ -167,6 +167,37 @@ oid_t Index::TupleColumnToKeyColumn(oid_t tuple_column_id) const {
   return key_column_id;
 }
 
+/*
+ * BulkLoad() - Insert a batch of entries one by one
+ *
+ * Indexes that support building themselves from a sorted batch override this.
+ * Since the index is expected to be empty, any existing value for a unique key
+ * must come from the batch itself, so the predicate rejects all of them. If an
+ * insert fails, the entries inserted so far are removed again.
+ */
+bool Index::BulkLoad(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>>
+        &entries) {
+  bool unique = HasUniqueKeys();
+  std::function<bool(const void *)> conflict = [](const void *) {
+    return true;
+  };
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const auto &entry = entries[i];
+    bool res = (unique ? CondInsertEntry(entry.first, entry.second, conflict)
+                       : InsertEntry(entry.first, entry.second));
+    if (res == false) {
+      for (size_t j = 0; j < i; j++) {
+        DeleteEntry(entries[j].first, entries[j].second);
+      }
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /*
  * ScanTest() - This is used inside the unit test to check correctness of
  *              scan optimizer - do not change or remove this
@@ -11,14 +11,20 @@
 //===----------------------------------------------------------------------===//
 
 #include <boost/algorithm/string.hpp>
+#include <cinttypes>
 #include <cstdio>
+#include <cstring>
 #include <unordered_map>
 
+#include "catalog/catalog.h"
 #include "common/cache.h"
 #include "common/internal_types.h"
 #include "common/macros.h"
 #include "common/portal.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/copy_from_loader.h"
 #include "expression/expression_util.h"
+#include "function/date_functions.h"
 #include "network/marshal.h"
 #include "network/peloton_server.h"
 #include "network/postgres_protocol_handler.h"
@@ -26,7 +32,11 @@
 #include "parser/statements.h"
 #include "planner/plan_util.h"
 #include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 #include "traffic_cop/traffic_cop.h"
+#include "type/timestamp_type.h"
 #include "type/value.h"
 #include "type/value_factory.h"
 #include "util/string_util.h"
@@ -60,7 +70,16 @@ PostgresProtocolHandler::PostgresProtocolHandler(tcop::TrafficCop *traffic_cop)
       init_stage_(true),
       txn_state_(NetworkTransactionStateType::IDLE) {}
 
-PostgresProtocolHandler::~PostgresProtocolHandler() {}
+PostgresProtocolHandler::~PostgresProtocolHandler() {
+  // Abandon a COPY the client never finished, or that was never fully sent
+  if (copy_txn_ != nullptr) {
+    copy_loader_.reset();
+    copy_out_table_ = nullptr;
+    concurrency::TransactionManagerFactory::GetInstance().AbortTransaction(
+        copy_txn_);
+    copy_txn_ = nullptr;
+  }
+}
 
 void PostgresProtocolHandler::SendStartupResponse() {
   std::unique_ptr<OutputPacket> response(new OutputPacket());
@@ -152,6 +171,13 @@ ProcessResult PostgresProtocolHandler::ExecQueryMessage(
       StatementTypeToQueryType(sql_stmt->GetType(), sql_stmt.get());
   protocol_type_ = NetworkProtocolType::POSTGRES_PSQL;
 
+  // COPY from the client or to the client is driven by the handler itself
+  if (query_type == QueryType::QUERY_COPY &&
+      static_cast<parser::CopyStatement &>(*sql_stmt).file_path.empty()) {
+    return ExecCopyQuery(
+        query, static_cast<parser::CopyStatement &>(*sql_stmt), thread_id);
+  }
+
   switch (query_type) {
     case QueryType::QUERY_PREPARE: {
       std::shared_ptr<Statement> statement(nullptr);
@@ -229,15 +255,22 @@ ProcessResult PostgresProtocolHandler::ExecQueryMessage(
       std::unique_ptr<parser::SQLStatementList> unnamed_sql_stmt_list(
           new parser::SQLStatementList());
       unnamed_sql_stmt_list->PassInStatement(std::move(sql_stmt));
+      // The constants the plan was parameterized on
+      std::vector<type::Value> param_values;
       traffic_cop_->SetStatement(traffic_cop_->PrepareStatement(
-          stmt_name, query, std::move(unnamed_sql_stmt_list)));
+          stmt_name, query, std::move(unnamed_sql_stmt_list), thread_id,
+          &param_values));
       if (traffic_cop_->GetStatement().get() == nullptr) {
         SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
                             traffic_cop_->GetErrorMessage()}});
         SendReadyForQuery(NetworkTransactionStateType::IDLE);
         return ProcessResult::COMPLETE;
       }
-      traffic_cop_->SetParamVal(std::vector<type::Value>());
+      if (!param_values.empty()) {
+        traffic_cop_->GetStatement()->GetPlanTree()->SetParameterValues(
+            &param_values);
+      }
+      traffic_cop_->SetParamVal(param_values);
       bool unnamed = false;
       result_format_ = std::vector<int>(
           traffic_cop_->GetStatement()->GetTupleDescriptor().size(), 0);
@@ -277,7 +310,173 @@ ResultType PostgresProtocolHandler::ExecQueryExplain(
   return status;
 }
 
+ProcessResult PostgresProtocolHandler::ExecCopyQuery(
+    const std::string &query, parser::CopyStatement &copy_stmt,
+    const size_t thread_id) {
+  // A COPY streamed over the connection always runs as its own transaction
+  if (txn_state_ == NetworkTransactionStateType::BLOCK) {
+    SendErrorResponse(
+        {{NetworkMessageType::HUMAN_READABLE_ERROR,
+          "COPY FROM STDIN and COPY TO STDOUT are not supported inside a "
+          "transaction block"}});
+    SendReadyForQuery(txn_state_);
+    return ProcessResult::COMPLETE;
+  }
+
+  // Only the text and CSV formats are supported
+  if (copy_stmt.format == ExternalFileFormat::BINARY) {
+    SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                        "COPY in binary format is not supported"}});
+    SendReadyForQuery(txn_state_);
+    return ProcessResult::COMPLETE;
+  }
+
+  copy_format_ = copy_stmt.format;
+  copy_delimiter_ = copy_stmt.delimiter;
+  copy_quote_ = copy_stmt.quote;
+  copy_escape_ = copy_stmt.escape;
+
+  // COPY (SELECT ...) TO STDOUT executes the query as usual, and the result
+  // is framed as CopyData when it is sent
+  if (copy_stmt.select_stmt != nullptr) {
+    std::unique_ptr<parser::SQLStatementList> select_stmt_list(
+        new parser::SQLStatementList());
+    select_stmt_list->PassInStatement(std::move(copy_stmt.select_stmt));
+    traffic_cop_->SetStatement(traffic_cop_->PrepareStatement(
+        "unamed", query, std::move(select_stmt_list)));
+    if (traffic_cop_->GetStatement().get() == nullptr) {
+      SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                          traffic_cop_->GetErrorMessage()}});
+      SendReadyForQuery(NetworkTransactionStateType::IDLE);
+      return ProcessResult::COMPLETE;
+    }
+    traffic_cop_->SetParamVal(std::vector<type::Value>());
+    result_format_ = std::vector<int>(
+        traffic_cop_->GetStatement()->GetTupleDescriptor().size(), 0);
+    copy_out_ = true;
+    auto status = traffic_cop_->ExecuteStatement(
+        traffic_cop_->GetStatement(), traffic_cop_->GetParamVal(), false,
+        nullptr, result_format_, traffic_cop_->GetResult(), thread_id);
+    if (traffic_cop_->GetQueuing()) {
+      return ProcessResult::PROCESSING;
+    }
+    ExecQueryMessageGetResult(status);
+    return ProcessResult::COMPLETE;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction(thread_id);
+
+  storage::DataTable *table = nullptr;
+  try {
+    auto db_itr = cmdline_options_.find("database");
+    copy_stmt.table->TryBindDatabaseName(
+        db_itr != cmdline_options_.end() ? db_itr->second : DEFAULT_DB_NAME);
+    table = catalog::Catalog::GetInstance()->GetTableWithName(
+        txn, copy_stmt.table->GetDatabaseName(),
+        copy_stmt.table->GetSchemaName(), copy_stmt.table->GetTableName());
+  } catch (Exception &e) {
+    txn_manager.AbortTransaction(txn);
+    SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR, e.what()}});
+    SendReadyForQuery(NetworkTransactionStateType::IDLE);
+    return ProcessResult::COMPLETE;
+  }
+
+  int colcount = static_cast<int>(table->GetSchema()->GetColumnCount());
+
+  if (copy_stmt.is_from) {
+    // Switch into copy-in mode. The rows arrive in CopyData messages.
+    copy_txn_ = txn;
+    copy_error_.clear();
+    copy_loader_.reset(new executor::CopyFromLoader(
+        table, txn, copy_delimiter_, copy_quote_, copy_escape_,
+        settings::SettingsManager::GetBool(settings::SettingId::copy_bulk_load),
+        copy_format_));
+    SendCopyResponse(NetworkMessageType::COPY_IN_RESPONSE, colcount);
+    return ProcessResult::COMPLETE;
+  }
+
+  // Switch into copy-out mode. The rows are sent chunk by chunk, the first
+  // one right away and the others whenever the previous one was written.
+  SendCopyResponse(NetworkMessageType::COPY_OUT_RESPONSE, colcount);
+  copy_txn_ = txn;
+  copy_out_table_ = table;
+  copy_out_tile_group_ = 0;
+  copy_out_tuple_ = 0;
+  copy_out_num_rows_ = 0;
+  SendCopyOutChunk();
+  return ProcessResult::COMPLETE;
+}
+
+void PostgresProtocolHandler::ExecCopyDataMessage(InputPacket *pkt) {
+  // Once a load has failed, the rest of the stream is discarded until the
+  // client ends the copy
+  if (copy_loader_ == nullptr || !copy_error_.empty() || pkt->len == 0) {
+    return;
+  }
+  try {
+    copy_loader_->Consume(reinterpret_cast<const char *>(&*pkt->Begin()),
+                          static_cast<uint32_t>(pkt->len));
+  } catch (std::exception &e) {
+    copy_error_ = e.what();
+  }
+}
+
+void PostgresProtocolHandler::ExecCopyDoneMessage() {
+  if (copy_loader_ == nullptr) {
+    LOG_ERROR("Received CopyDone outside of COPY FROM STDIN");
+    return;
+  }
+
+  if (copy_error_.empty()) {
+    try {
+      copy_loader_->Finish();
+    } catch (std::exception &e) {
+      copy_error_ = e.what();
+    }
+  }
+  auto num_rows = copy_loader_->GetNumRowsLoaded();
+  copy_loader_.reset();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  if (copy_error_.empty()) {
+    auto result = txn_manager.CommitTransaction(copy_txn_);
+    if (result != ResultType::SUCCESS) {
+      copy_error_ = "COPY aborted: " + ResultTypeToString(result);
+    }
+  } else {
+    txn_manager.AbortTransaction(copy_txn_);
+  }
+  copy_txn_ = nullptr;
+
+  if (copy_error_.empty()) {
+    CompleteCommand(QueryType::QUERY_COPY, static_cast<int>(num_rows));
+  } else {
+    SendErrorResponse(
+        {{NetworkMessageType::HUMAN_READABLE_ERROR, copy_error_}});
+  }
+  SendReadyForQuery(NetworkTransactionStateType::IDLE);
+}
+
+void PostgresProtocolHandler::ExecCopyFailMessage(InputPacket *pkt) {
+  std::string reason;
+  GetStringToken(pkt, reason);
+  if (copy_loader_ != nullptr) {
+    copy_loader_.reset();
+    concurrency::TransactionManagerFactory::GetInstance().AbortTransaction(
+        copy_txn_);
+    copy_txn_ = nullptr;
+  }
+  SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                      "COPY from stdin failed: " + reason}});
+  SendReadyForQuery(NetworkTransactionStateType::IDLE);
+}
+
 void PostgresProtocolHandler::ExecQueryMessageGetResult(ResultType status) {
+  // Consume the copy-out flag, the result is sent in copy format only once
+  bool copy_out = copy_out_;
+  copy_out_ = false;
+
   std::vector<FieldInfo> tuple_descriptor;
   if (status == ResultType::SUCCESS) {
     tuple_descriptor = traffic_cop_->GetStatement()->GetTupleDescriptor();
@@ -296,6 +495,15 @@ void PostgresProtocolHandler::ExecQueryMessageGetResult(ResultType status) {
     return;
   }
 
+  if (copy_out) {
+    SendCopyResponse(NetworkMessageType::COPY_OUT_RESPONSE,
+                     tuple_descriptor.size());
+    SendCopyOutRows(traffic_cop_->GetResult(), tuple_descriptor.size());
+    CompleteCommand(QueryType::QUERY_COPY, traffic_cop_->getRowsAffected());
+    SendReadyForQuery(NetworkTransactionStateType::IDLE);
+    return;
+  }
+
   // send the attribute names
   PutTupleDescriptor(tuple_descriptor);
 
@@ -1046,6 +1254,12 @@ ProcessResult PostgresProtocolHandler::ProcessStartupPacket(
 
 ProcessResult PostgresProtocolHandler::Process(ReadBuffer &rbuf,
                                                const size_t thread_id) {
+  // The previous chunk of a COPY TO STDOUT has been written, send the next one
+  if (copy_out_table_ != nullptr) {
+    SendCopyOutChunk();
+    return ProcessResult::COMPLETE;
+  }
+
   if (!ParseInputPacket(rbuf, request_, init_stage_))
     return ProcessResult::MORE_DATA_REQUIRED;
 
@@ -1095,6 +1309,20 @@ ProcessResult PostgresProtocolHandler::ProcessNormalPacket(
       LOG_TRACE("CLOSE_COMMAND");
       ExecCloseMessage(pkt);
     } break;
+    case NetworkMessageType::COPY_DATA: {
+      LOG_TRACE("COPY_DATA");
+      ExecCopyDataMessage(pkt);
+    } break;
+    case NetworkMessageType::COPY_DONE: {
+      LOG_TRACE("COPY_DONE");
+      SetFlushFlag(true);
+      ExecCopyDoneMessage();
+    } break;
+    case NetworkMessageType::COPY_FAIL_COMMAND: {
+      LOG_TRACE("COPY_FAIL_COMMAND");
+      SetFlushFlag(true);
+      ExecCopyFailMessage(pkt);
+    } break;
     case NetworkMessageType::TERMINATE_COMMAND: {
       LOG_TRACE("TERMINATE_COMMAND");
       SetFlushFlag(true);
@@ -1177,6 +1405,260 @@ void PostgresProtocolHandler::SendDataRows(std::vector<ResultValue> &results,
   traffic_cop_->setRowsAffected(numrows);
 }
 
+void PostgresProtocolHandler::SendCopyResponse(NetworkMessageType type,
+                                               int colcount) {
+  std::unique_ptr<OutputPacket> pkt(new OutputPacket());
+  pkt->msg_type = type;
+  // Overall format is textual, as is every column
+  PacketPutByte(pkt.get(), 0);
+  PacketPutInt(pkt.get(), colcount, 2);
+  for (int i = 0; i < colcount; i++) {
+    PacketPutInt(pkt.get(), 0, 2);
+  }
+  responses_.push_back(std::move(pkt));
+}
+
+void PostgresProtocolHandler::SendCopyOutChunk() {
+  SetFlushFlag(true);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  const oid_t colcount = copy_out_table_->GetSchema()->GetColumnCount();
+  size_t chunk_size = 0;
+
+  // Values are encoded straight from the tile group into the packet. We stop
+  // once the chunk is full and pick up at the same tuple next time.
+  size_t tile_group_count = copy_out_table_->GetTileGroupCount();
+  for (; copy_out_tile_group_ < tile_group_count;
+       copy_out_tile_group_++, copy_out_tuple_ = 0) {
+    auto tile_group = copy_out_table_->GetTileGroup(copy_out_tile_group_);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto *tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (; copy_out_tuple_ < active_tuple_count; copy_out_tuple_++) {
+      if (chunk_size >= kCopyOutChunkSize) {
+        return;
+      }
+      if (txn_manager.IsVisible(copy_txn_, tile_group_header,
+                                copy_out_tuple_) != VisibilityType::OK) {
+        continue;
+      }
+      ItemPointer location(tile_group->GetTileGroupId(), copy_out_tuple_);
+      txn_manager.PerformRead(copy_txn_, location, tile_group_header, false);
+
+      // 1 packet per row
+      std::unique_ptr<OutputPacket> pkt(new OutputPacket());
+      pkt->msg_type = NetworkMessageType::COPY_DATA;
+      for (oid_t col_id = 0; col_id < colcount; col_id++) {
+        if (col_id != 0) PacketPutByte(pkt.get(), copy_delimiter_);
+        PutCopyValue(pkt.get(), tile_group->GetValue(copy_out_tuple_, col_id));
+      }
+      PacketPutByte(pkt.get(), '\n');
+      chunk_size += pkt->len;
+      responses_.push_back(std::move(pkt));
+      copy_out_num_rows_++;
+    }
+  }
+
+  // All rows were sent
+  std::unique_ptr<OutputPacket> done(new OutputPacket());
+  done->msg_type = NetworkMessageType::COPY_DONE;
+  responses_.push_back(std::move(done));
+
+  txn_manager.CommitTransaction(copy_txn_);
+  copy_txn_ = nullptr;
+  copy_out_table_ = nullptr;
+
+  CompleteCommand(QueryType::QUERY_COPY, static_cast<int>(copy_out_num_rows_));
+  SendReadyForQuery(NetworkTransactionStateType::IDLE);
+}
+
+void PostgresProtocolHandler::SendCopyOutRows(
+    std::vector<ResultValue> &results, int colcount) {
+  size_t numrows = (colcount == 0 ? 0 : results.size() / colcount);
+
+  // 1 packet per row
+  for (size_t i = 0; i < numrows; i++) {
+    std::unique_ptr<OutputPacket> pkt(new OutputPacket());
+    pkt->msg_type = NetworkMessageType::COPY_DATA;
+    for (int j = 0; j < colcount; j++) {
+      if (j != 0) PacketPutByte(pkt.get(), copy_delimiter_);
+      // Empty content is NULL
+      auto &content = results[i * colcount + j];
+      if (content.empty()) {
+        PutCopyNull(pkt.get());
+      } else {
+        PutCopyField(pkt.get(), content.data(), content.size());
+      }
+    }
+    PacketPutByte(pkt.get(), '\n');
+    responses_.push_back(std::move(pkt));
+  }
+  traffic_cop_->setRowsAffected(numrows);
+
+  std::unique_ptr<OutputPacket> done(new OutputPacket());
+  done->msg_type = NetworkMessageType::COPY_DONE;
+  responses_.push_back(std::move(done));
+}
+
+void PostgresProtocolHandler::PutCopyValue(OutputPacket *pkt,
+                                           const type::Value &val) {
+  if (val.IsNull()) {
+    PutCopyNull(pkt);
+    return;
+  }
+
+  switch (val.GetTypeId()) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+      break;
+    case type::TypeId::VARCHAR: {
+      // The stored length accounts for the null-terminator
+      uint32_t data_len = val.GetLength();
+      if (data_len > 0 && val.GetData()[data_len - 1] == '\0') data_len--;
+      PutCopyField(pkt, val.GetData(), data_len);
+      return;
+    }
+    default: {
+      auto str = val.ToString();
+      PutCopyField(pkt, str.data(), str.size());
+      return;
+    }
+  }
+
+  // Fixed-length values are formatted straight into the packet, in the same
+  // representation their ToString() has
+  static constexpr size_t kMaxFormattedLength = 64;
+  size_t begin = pkt->buf.size();
+  pkt->buf.resize(begin + kMaxFormattedLength);
+  char *out = reinterpret_cast<char *>(&pkt->buf[begin]);
+  int len = 0;
+  switch (val.GetTypeId()) {
+    case type::TypeId::BOOLEAN:
+      len = snprintf(out, kMaxFormattedLength, "%s",
+                     (val.IsTrue() ? "true" : "false"));
+      break;
+    case type::TypeId::TINYINT:
+      len = snprintf(out, kMaxFormattedLength, "%" PRId8, val.GetAs<int8_t>());
+      break;
+    case type::TypeId::SMALLINT:
+      len = snprintf(out, kMaxFormattedLength, "%" PRId16,
+                     val.GetAs<int16_t>());
+      break;
+    case type::TypeId::INTEGER:
+      len = snprintf(out, kMaxFormattedLength, "%" PRId32,
+                     val.GetAs<int32_t>());
+      break;
+    case type::TypeId::BIGINT:
+      len = snprintf(out, kMaxFormattedLength, "%" PRId64,
+                     val.GetAs<int64_t>());
+      break;
+    case type::TypeId::DECIMAL:
+      len = snprintf(out, kMaxFormattedLength, "%g", val.GetAs<double>());
+      break;
+    case type::TypeId::DATE: {
+      int32_t year, month, day;
+      function::DateFunctions::JulianToDate(val.GetAs<int32_t>(), year, month,
+                                            day);
+      len = snprintf(out, kMaxFormattedLength, "%04d-%02d-%02d", year, month,
+                     day);
+      break;
+    }
+    case type::TypeId::TIMESTAMP:
+      len = type::TimestampType::FormatTo(val.GetAs<uint64_t>(), out);
+      break;
+    default:
+      break;
+  }
+  pkt->buf.resize(begin + len);
+  pkt->len += len;
+
+  // Only a delimiter that is part of the value (e.g., a '-' in a date) needs
+  // the value to be quoted or escaped
+  if (memchr(out, copy_delimiter_, len) != nullptr) {
+    std::string str(out, len);
+    pkt->buf.resize(begin);
+    pkt->len -= len;
+    PutCopyField(pkt, str.data(), str.size());
+  }
+}
+
+void PostgresProtocolHandler::PutCopyNull(OutputPacket *pkt) {
+  // NULL is "\N" in text format, and an empty unquoted field in CSV
+  if (copy_format_ == ExternalFileFormat::TEXT) {
+    PacketPutByte(pkt, '\\');
+    PacketPutByte(pkt, 'N');
+  }
+}
+
+void PostgresProtocolHandler::PutCopyField(OutputPacket *pkt, const char *data,
+                                           size_t len) {
+  // Text format has no quoting, special characters are backslash-escaped
+  if (copy_format_ == ExternalFileFormat::TEXT) {
+    size_t run_begin = 0;
+    for (size_t i = 0; i < len; i++) {
+      char c = data[i];
+      char escaped;
+      switch (c) {
+        case '\\':
+          escaped = '\\';
+          break;
+        case '\n':
+          escaped = 'n';
+          break;
+        case '\r':
+          escaped = 'r';
+          break;
+        case '\t':
+          escaped = 't';
+          break;
+        default:
+          if (c != copy_delimiter_) continue;
+          escaped = c;
+          break;
+      }
+      PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(data + run_begin),
+                      i - run_begin);
+      PacketPutByte(pkt, '\\');
+      PacketPutByte(pkt, escaped);
+      run_begin = i + 1;
+    }
+    PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(data + run_begin),
+                    len - run_begin);
+    return;
+  }
+
+  // An empty string must be quoted to tell it apart from NULL, as must any
+  // value that contains a special character
+  bool needs_quote = (len == 0);
+  for (size_t i = 0; i < len && !needs_quote; i++) {
+    char c = data[i];
+    needs_quote = (c == copy_delimiter_ || c == copy_quote_ || c == '\n' ||
+                   c == '\r' || c == copy_escape_);
+  }
+
+  if (!needs_quote) {
+    PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(data), len);
+    return;
+  }
+
+  PacketPutByte(pkt, copy_quote_);
+  for (size_t i = 0; i < len; i++) {
+    char c = data[i];
+    if (c == copy_quote_ || c == copy_escape_) {
+      PacketPutByte(pkt, copy_escape_);
+    }
+    PacketPutByte(pkt, c);
+  }
+  PacketPutByte(pkt, copy_quote_);
+}
+
 void PostgresProtocolHandler::CompleteCommand(const QueryType &query_type,
                                               int rows) {
   std::unique_ptr<OutputPacket> pkt(new OutputPacket());
@@ -1258,6 +1740,14 @@ void PostgresProtocolHandler::Reset() {
   skipped_stmt_ = false;
   skipped_query_string_.clear();
   portals_.clear();
+  if (copy_txn_ != nullptr) {
+    copy_loader_.reset();
+    copy_out_table_ = nullptr;
+    concurrency::TransactionManagerFactory::GetInstance().AbortTransaction(
+        copy_txn_);
+    copy_txn_ = nullptr;
+  }
+  copy_out_ = false;
 }
 
 }  // namespace network
@@ -169,6 +169,30 @@ void ChildPropertyDeriver::Visit(const PhysicalInnerHashJoin *) {
 void ChildPropertyDeriver::Visit(const PhysicalLeftHashJoin *) {}
 void ChildPropertyDeriver::Visit(const PhysicalRightHashJoin *) {}
 void ChildPropertyDeriver::Visit(const PhysicalOuterHashJoin *) {}
+void ChildPropertyDeriver::Visit(const PhysicalInnerMergeJoin *op) {
+  // Both children must be sorted ascending on their join keys
+  vector<shared_ptr<PropertySet>> child_input_properties;
+  for (auto keys : {&op->left_keys, &op->right_keys}) {
+    vector<expression::AbstractExpression *> sort_cols;
+    for (auto &key : *keys) sort_cols.push_back(key.get());
+    vector<bool> sort_ascending(sort_cols.size(), true);
+    shared_ptr<Property> sort_prop(
+        new PropertySort(sort_cols, move(sort_ascending)));
+    child_input_properties.push_back(
+        make_shared<PropertySet>(vector<shared_ptr<Property>>{sort_prop}));
+  }
+
+  // The output follows the order of the right child, which is streamed through
+  // the join
+  auto provided_prop = child_input_properties[1];
+  output_.push_back(make_pair(provided_prop, move(child_input_properties)));
+}
+void ChildPropertyDeriver::Visit(const PhysicalSemiHashJoin *) {
+  // The left tuples are produced from the hash table, in no particular order
+  output_.push_back(make_pair(
+      make_shared<PropertySet>(),
+      vector<shared_ptr<PropertySet>>(2, make_shared<PropertySet>())));
+}
 void ChildPropertyDeriver::Visit(const PhysicalInsert *) {
   vector<shared_ptr<PropertySet>> child_input_properties;
 
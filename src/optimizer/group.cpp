@@ -21,20 +21,22 @@ namespace optimizer {
 // Group
 //===--------------------------------------------------------------------===//
 Group::Group(GroupID id, std::unordered_set<std::string> table_aliases)
-    : id_(id), table_aliases_(std::move(table_aliases)) {
-  has_explored_ = false;
-}
+    : id_(id),
+      table_aliases_(std::move(table_aliases)),
+      exploration_state_(ExplorationState::UNEXPLORED) {}
 
 void Group::AddExpression(std::shared_ptr<GroupExpression> expr,
                           bool enforced) {
   // Do duplicate detection
   expr->SetGroupID(id_);
+  latch_.Lock();
   if (enforced)
     enforced_exprs_.push_back(expr);
   else if (expr->Op().IsPhysical())
     physical_expressions_.push_back(expr);
   else
     logical_expressions_.push_back(expr);
+  latch_.Unlock();
 }
 
 bool Group::SetExpressionCost(GroupExpression *expr, double cost,
@@ -42,30 +44,93 @@ bool Group::SetExpressionCost(GroupExpression *expr, double cost,
   LOG_TRACE("Adding expression cost on group %d with op %s, req %s",
             expr->GetGroupID(), expr->Op().GetName().c_str(),
             properties->ToString().c_str());
+  bool lowest = false;
+  latch_.Lock();
   auto it = lowest_cost_expressions_.find(properties);
   if (it == lowest_cost_expressions_.end() || std::get<0>(it->second) > cost) {
     // No other cost to compare against or the cost is lower than the existing
     // cost
     lowest_cost_expressions_[properties] = std::make_tuple(cost, expr);
-    return true;
+    lowest = true;
   }
-  return false;
+  latch_.Unlock();
+  return lowest;
 }
 GroupExpression *Group::GetBestExpression(
     std::shared_ptr<PropertySet> &properties) {
+  GroupExpression *best_expr = nullptr;
+  latch_.Lock();
   auto it = lowest_cost_expressions_.find(properties);
   if (it != lowest_cost_expressions_.end()) {
-    return std::get<1>(it->second);
+    best_expr = std::get<1>(it->second);
   }
-  LOG_TRACE("Didn't get best expression with properties %s",
-            properties->ToString().c_str());
-  return nullptr;
+  latch_.Unlock();
+  if (best_expr == nullptr) {
+    LOG_TRACE("Didn't get best expression with properties %s",
+              properties->ToString().c_str());
+  }
+  return best_expr;
 }
 
 bool Group::HasExpressions(
     const std::shared_ptr<PropertySet> &properties) const {
-  const auto &it = lowest_cost_expressions_.find(properties);
-  return (it != lowest_cost_expressions_.end());
+  latch_.Lock();
+  bool found = (lowest_cost_expressions_.count(properties) != 0);
+  latch_.Unlock();
+  return found;
+}
+
+std::vector<std::shared_ptr<GroupExpression>>
+Group::GetLogicalExpressions() const {
+  latch_.Lock();
+  auto exprs = logical_expressions_;
+  latch_.Unlock();
+  return exprs;
+}
+
+std::vector<std::shared_ptr<GroupExpression>>
+Group::GetPhysicalExpressions() const {
+  latch_.Lock();
+  auto exprs = physical_expressions_;
+  latch_.Unlock();
+  return exprs;
+}
+
+bool Group::StartExploration() {
+  latch_.Lock();
+  bool claimed = (exploration_state_ == ExplorationState::UNEXPLORED);
+  if (claimed) {
+    exploration_state_ = ExplorationState::EXPLORING;
+  }
+  latch_.Unlock();
+  return claimed;
+}
+
+bool Group::AddExplorationWaiter(OptimizerTask *task) {
+  latch_.Lock();
+  bool exploring = (exploration_state_ == ExplorationState::EXPLORING);
+  if (exploring) {
+    exploration_waiters_.push_back(task);
+  }
+  latch_.Unlock();
+  return exploring;
+}
+
+std::vector<OptimizerTask *> Group::FinishExploration() {
+  std::vector<OptimizerTask *> waiters;
+  latch_.Lock();
+  PELOTON_ASSERT(exploration_state_ == ExplorationState::EXPLORING);
+  exploration_state_ = ExplorationState::EXPLORED;
+  waiters.swap(exploration_waiters_);
+  latch_.Unlock();
+  return waiters;
+}
+
+bool Group::HasExplored() {
+  latch_.Lock();
+  bool explored = (exploration_state_ == ExplorationState::EXPLORED);
+  latch_.Unlock();
+  return explored;
 }
 
 std::shared_ptr<ColumnStats> Group::GetStats(std::string column_name) {
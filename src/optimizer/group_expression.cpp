@@ -47,18 +47,25 @@ Operator GroupExpression::Op() const { return op; }
 
 double GroupExpression::GetCost(
     std::shared_ptr<PropertySet> &requirements) const {
-  return std::get<0>(lowest_cost_table_.find(requirements)->second);
+  latch_.Lock();
+  auto cost = std::get<0>(lowest_cost_table_.find(requirements)->second);
+  latch_.Unlock();
+  return cost;
 }
 
 std::vector<std::shared_ptr<PropertySet>> GroupExpression::GetInputProperties(
     std::shared_ptr<PropertySet> requirements) const {
-  return std::get<1>(lowest_cost_table_.find(requirements)->second);
+  latch_.Lock();
+  auto input_props = std::get<1>(lowest_cost_table_.find(requirements)->second);
+  latch_.Unlock();
+  return input_props;
 }
 
 void GroupExpression::SetLocalHashTable(
     const std::shared_ptr<PropertySet> &output_properties,
     const std::vector<std::shared_ptr<PropertySet>> &input_properties_list,
     double cost) {
+  latch_.Lock();
   auto it = lowest_cost_table_.find(output_properties);
   if (it == lowest_cost_table_.end()) {
     // No other cost to compare against
@@ -71,6 +78,7 @@ void GroupExpression::SetLocalHashTable(
           std::make_tuple(cost, input_properties_list);
     }
   }
+  latch_.Unlock();
 }
 
 hash_t GroupExpression::Hash() const {
@@ -0,0 +1,291 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_enumerator.cpp
+//
+// Identification: src/optimizer/join_enumerator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/join_enumerator.h"
+
+#include <algorithm>
+
+#include "common/logger.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/operators.h"
+#include "optimizer/optimizer_metadata.h"
+
+namespace peloton {
+namespace optimizer {
+
+namespace {
+
+// The number of bits of a relation set
+const size_t kMaxRelations = 64;
+
+// The set with only the lowest relation of the given set
+inline uint64_t Lowest(uint64_t s) { return s & (~s + 1); }
+
+// The set of all relations with an index lower than or equal to the lowest
+// relation of the given set
+inline uint64_t LowerOrEqual(uint64_t s) { return (Lowest(s) << 1) - 1; }
+
+inline bool IsSubsetOf(uint64_t s1, uint64_t s2) { return (s1 & ~s2) == 0; }
+
+}  // namespace
+
+bool JoinEnumerator::Enumerate(GroupID root_group) {
+  PELOTON_ASSERT(relations_.empty());
+
+  RelationSet all_relations;
+  if (!CollectJoinTree(root_group, all_relations) || relations_.size() < 3 ||
+      !BuildJoinGraph()) {
+    return false;
+  }
+  LOG_DEBUG("Enumerate join orders of %lu relations in group %d",
+            relations_.size(), root_group);
+
+  for (size_t rel = 0; rel < relations_.size(); rel++) {
+    dp_table_[RelationSet(1) << rel] = relations_[rel];
+  }
+
+  // Start from every relation in descending order, only adding relations
+  // with a higher index to the subgraphs grown from it
+  for (size_t rel = relations_.size(); rel-- > 0;) {
+    RelationSet start = RelationSet(1) << rel;
+    EmitCsg(start);
+    EnumerateCsgRec(start, LowerOrEqual(start));
+  }
+  PELOTON_ASSERT(dp_table_.at(all_relations) == root_group);
+
+  for (auto gexpr : tree_exprs_) {
+    MarkExplored(gexpr);
+  }
+  return true;
+}
+
+bool JoinEnumerator::CollectJoinTree(GroupID group_id,
+                                     RelationSet &relations) {
+  auto group = metadata_->memo.GetGroupByID(group_id);
+  auto gexpr = group->GetLogicalExpressions()[0].get();
+
+  if (gexpr->Op().GetType() != OpType::InnerJoin) {
+    // Anything but an inner join is a relation of the join graph
+    if (relations_.size() >= std::min(max_relations_, kMaxRelations)) {
+      return false;
+    }
+    size_t rel = relations_.size();
+    relations_.push_back(group_id);
+    for (auto &table_alias : group->GetTableAliases()) {
+      if (!alias_to_relation_.emplace(table_alias, rel).second) {
+        return false;
+      }
+    }
+    relations = RelationSet(1) << rel;
+    return true;
+  }
+
+  RelationSet left_relations, right_relations;
+  if (!CollectJoinTree(gexpr->GetChildGroupId(0), left_relations) ||
+      !CollectJoinTree(gexpr->GetChildGroupId(1), right_relations)) {
+    return false;
+  }
+  relations = left_relations | right_relations;
+
+  auto join_op = gexpr->Op().As<LogicalInnerJoin>();
+  predicates_.insert(predicates_.end(), join_op->join_predicates.begin(),
+                     join_op->join_predicates.end());
+  tree_groups_[relations] = group_id;
+  tree_exprs_.push_back(gexpr);
+  return true;
+}
+
+bool JoinEnumerator::BuildJoinGraph() {
+  for (auto &predicate : predicates_) {
+    RelationSet relations = 0;
+    for (auto &table_alias : predicate.table_alias_set) {
+      auto iter = alias_to_relation_.find(table_alias);
+      if (iter == alias_to_relation_.end()) {
+        // References a table outside of the join, e.g., a correlated column
+        return false;
+      }
+      relations |= RelationSet(1) << iter->second;
+    }
+    if (relations == Lowest(relations)) {
+      // Not a join predicate, we can't tell where it has to be evaluated
+      return false;
+    }
+    predicate_relations_.push_back(relations);
+
+    // Split the relations of the predicate into the lowest one and the rest,
+    // which is a simple edge for binary predicates
+    edges_.push_back({Lowest(relations), relations & ~Lowest(relations)});
+  }
+
+  // Check the graph is connected through binary predicates, otherwise DPhyp
+  // can't find a plan without cross products
+  RelationSet all_relations = (RelationSet(1) << (relations_.size() - 1)) * 2 - 1;
+  RelationSet reachable = 1;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto &edge : edges_) {
+      if (edge.right != Lowest(edge.right)) {
+        continue;
+      }
+      RelationSet edge_relations = edge.left | edge.right;
+      if ((reachable & edge_relations) != 0 &&
+          !IsSubsetOf(edge_relations, reachable)) {
+        reachable |= edge_relations;
+        changed = true;
+      }
+    }
+  }
+  return reachable == all_relations;
+}
+
+void JoinEnumerator::MarkExplored(GroupExpression *gexpr) {
+  for (auto &rule : metadata_->rule_set.GetTransformationRules()) {
+    if (rule->GetType() == RuleType::INNER_JOIN_COMMUTE ||
+        rule->GetType() == RuleType::INNER_JOIN_ASSOCIATE) {
+      gexpr->SetRuleExplored(rule.get());
+    }
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// DPhyp
+//===--------------------------------------------------------------------===//
+void JoinEnumerator::EmitCsg(RelationSet s1) {
+  RelationSet exclusion = s1 | LowerOrEqual(s1);
+  RelationSet neighbors = Neighborhood(s1, exclusion);
+
+  // Grow complements from every neighbor, in descending order
+  for (size_t rel = relations_.size(); rel-- > 0;) {
+    RelationSet s2 = RelationSet(1) << rel;
+    if ((neighbors & s2) == 0) {
+      continue;
+    }
+    if (IsConnected(s1, s2)) {
+      EmitCsgCmp(s1, s2);
+    }
+    EnumerateCmpRec(s1, s2, exclusion | (neighbors & ((s2 << 1) - 1)));
+  }
+}
+
+void JoinEnumerator::EnumerateCsgRec(RelationSet s1, RelationSet exclusion) {
+  RelationSet neighbors = Neighborhood(s1, exclusion);
+  if (neighbors == 0) {
+    return;
+  }
+
+  // Enumerate all non-empty subsets of the neighborhood
+  for (RelationSet subset = Lowest(neighbors); subset != 0;
+       subset = (subset - neighbors) & neighbors) {
+    if (dp_table_.count(s1 | subset) != 0) {
+      EmitCsg(s1 | subset);
+    }
+  }
+  for (RelationSet subset = Lowest(neighbors); subset != 0;
+       subset = (subset - neighbors) & neighbors) {
+    EnumerateCsgRec(s1 | subset, exclusion | neighbors);
+  }
+}
+
+void JoinEnumerator::EnumerateCmpRec(RelationSet s1, RelationSet s2,
+                                     RelationSet exclusion) {
+  RelationSet neighbors = Neighborhood(s2, exclusion);
+  if (neighbors == 0) {
+    return;
+  }
+
+  for (RelationSet subset = Lowest(neighbors); subset != 0;
+       subset = (subset - neighbors) & neighbors) {
+    if (dp_table_.count(s2 | subset) != 0 && IsConnected(s1, s2 | subset)) {
+      EmitCsgCmp(s1, s2 | subset);
+    }
+  }
+  for (RelationSet subset = Lowest(neighbors); subset != 0;
+       subset = (subset - neighbors) & neighbors) {
+    EnumerateCmpRec(s1, s2 | subset, exclusion | neighbors);
+  }
+}
+
+void JoinEnumerator::EmitCsgCmp(RelationSet s1, RelationSet s2) {
+  RelationSet s = s1 | s2;
+
+  // Evaluate every predicate at the lowest join that covers it
+  std::vector<AnnotatedExpression> join_predicates;
+  for (size_t i = 0; i < predicates_.size(); i++) {
+    RelationSet relations = predicate_relations_[i];
+    if (IsSubsetOf(relations, s) && !IsSubsetOf(relations, s1) &&
+        !IsSubsetOf(relations, s2)) {
+      join_predicates.push_back(predicates_[i]);
+    }
+  }
+
+  // Reuse the group of the original join tree, if there is one
+  GroupID target_group = UNDEFINED_GROUP;
+  auto dp_iter = dp_table_.find(s);
+  if (dp_iter != dp_table_.end()) {
+    target_group = dp_iter->second;
+  } else {
+    auto tree_iter = tree_groups_.find(s);
+    if (tree_iter != tree_groups_.end()) {
+      target_group = tree_iter->second;
+    }
+  }
+
+  GroupID left = dp_table_.at(s1);
+  GroupID right = dp_table_.at(s2);
+  target_group = AddJoin(left, right, join_predicates, target_group);
+  AddJoin(right, left, join_predicates, target_group);
+  dp_table_[s] = target_group;
+}
+
+JoinEnumerator::RelationSet JoinEnumerator::Neighborhood(
+    RelationSet s, RelationSet exclusion) const {
+  // Every hyperedge contributes its lowest relation on the other side
+  RelationSet excluded = s | exclusion;
+  RelationSet neighbors = 0;
+  for (auto &edge : edges_) {
+    if (IsSubsetOf(edge.left, s) && (edge.right & excluded) == 0) {
+      neighbors |= Lowest(edge.right);
+    } else if (IsSubsetOf(edge.right, s) && (edge.left & excluded) == 0) {
+      neighbors |= Lowest(edge.left);
+    }
+  }
+  return neighbors;
+}
+
+bool JoinEnumerator::IsConnected(RelationSet s1, RelationSet s2) const {
+  for (auto &edge : edges_) {
+    if ((IsSubsetOf(edge.left, s1) && IsSubsetOf(edge.right, s2)) ||
+        (IsSubsetOf(edge.left, s2) && IsSubsetOf(edge.right, s1))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+GroupID JoinEnumerator::AddJoin(
+    GroupID left, GroupID right,
+    const std::vector<AnnotatedExpression> &predicates, GroupID target_group) {
+  std::vector<AnnotatedExpression> join_predicates(predicates);
+  auto gexpr = std::make_shared<GroupExpression>(
+      LogicalInnerJoin::make(join_predicates), std::vector<GroupID>{left, right});
+
+  auto memo_expr = metadata_->memo.InsertExpression(gexpr, target_group, false);
+  if (memo_expr == gexpr.get()) {
+    new_exprs_.push_back(memo_expr);
+  }
+  MarkExplored(memo_expr);
+  return gexpr->GetGroupID();
+}
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -23,6 +23,13 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 Memo::Memo() {}
 
+Memo &Memo::operator=(Memo &&other) {
+  group_expressions_ = std::move(other.group_expressions_);
+  groups_ = std::move(other.groups_);
+  rule_set_size_ = other.rule_set_size_;
+  return *this;
+}
+
 GroupExpression *Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
                                         bool enforced) {
   return InsertExpression(gexpr, UNDEFINED_GROUP, enforced);
@@ -40,11 +47,14 @@ GroupExpression *Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
   }
 
   // Lookup in hash table
+  latch_.WriteLock();
   auto it = group_expressions_.find(gexpr.get());
 
   if (it != group_expressions_.end()) {
     gexpr->SetGroupID((*it)->GetGroupID());
-    return *it;
+    auto existing_gexpr = *it;
+    latch_.Unlock();
+    return existing_gexpr;
   } else {
     group_expressions_.insert(gexpr.get());
     // New expression, so try to insert into an existing group or
@@ -55,8 +65,9 @@ GroupExpression *Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
     } else {
       group_id = target_group;
     }
-    Group *group = GetGroupByID(group_id);
+    Group *group = GetGroupByIDLocked(group_id);
     group->AddExpression(gexpr, enforced);
+    latch_.Unlock();
     return gexpr.get();
   }
 }
@@ -65,7 +76,12 @@ std::vector<std::unique_ptr<Group>> &Memo::Groups() {
   return groups_;
 }
 
-Group *Memo::GetGroupByID(GroupID id) { return groups_[id].get(); }
+Group *Memo::GetGroupByID(GroupID id) {
+  latch_.ReadLock();
+  auto group = GetGroupByIDLocked(id);
+  latch_.Unlock();
+  return group;
+}
 
 const std::string Memo::GetInfo(int num_indent) const {
     std::ostringstream os;
@@ -103,7 +119,7 @@ GroupID Memo::AddNewGroup(std::shared_ptr<GroupExpression> gexpr) {
   } else {
     // For other groups, need to aggregate the table alias from children
     for (auto child_group_id : gexpr->GetChildGroupIDs()) {
-      Group *child_group = GetGroupByID(child_group_id);
+      Group *child_group = GetGroupByIDLocked(child_group_id);
       for (auto &table_alias : child_group->GetTableAliases()) {
         table_aliases.insert(table_alias);
       }
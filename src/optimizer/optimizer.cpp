@@ -98,16 +98,34 @@ void Optimizer::OptimizeLoop(int root_group_id,
 
   ExecuteTaskStack(*task_stack, root_group_id, root_context);
 
-  // Perform optimization after the rewrite
-  task_stack->Push(new OptimizeGroup(metadata_.memo.GetGroupByID(root_group_id),
-                                     root_context));
+  // Perform optimization after the rewrite, on multiple threads if configured
+  OptimizerTaskPool *task_pool = task_stack.get();
+  std::unique_ptr<ConcurrentOptimizerTaskPool> concurrent_task_pool;
+  auto num_threads = settings::SettingsManager::GetInt(
+      settings::SettingId::optimizer_task_threads);
+  if (num_threads > 1) {
+    concurrent_task_pool.reset(
+        new ConcurrentOptimizerTaskPool(static_cast<uint32_t>(num_threads)));
+    task_pool = concurrent_task_pool.get();
+    metadata_.SetTaskPool(task_pool);
+  }
+
+  task_pool->Push(new OptimizeGroup(metadata_.memo.GetGroupByID(root_group_id),
+                                    root_context));
+
+  // Enumerate join orders once the stats of the original tree are derived
+  task_pool->Push(new EnumerateJoinOrder(root_group_id, root_context));
 
   // Derive stats for the only one logical expression before optimizing
-  task_stack->Push(new DeriveStats(
+  task_pool->Push(new DeriveStats(
       metadata_.memo.GetGroupByID(root_group_id)->GetLogicalExpression(),
       ExprSet{}, root_context));
 
-  ExecuteTaskStack(*task_stack, root_group_id, root_context);
+  if (concurrent_task_pool != nullptr) {
+    ExecuteTaskPool(*concurrent_task_pool, root_group_id, root_context);
+  } else {
+    ExecuteTaskStack(*task_stack, root_group_id, root_context);
+  }
 }
 
 shared_ptr<planner::AbstractPlan> Optimizer::BuildPelotonPlanTree(
@@ -423,5 +441,31 @@ void Optimizer::ExecuteTaskStack(
   }
 }
 
+void Optimizer::ExecuteTaskPool(ConcurrentOptimizerTaskPool &task_pool,
+                                int root_group_id,
+                                std::shared_ptr<OptimizeContext> root_context) {
+  auto root_group = metadata_.memo.GetGroupByID(root_group_id);
+  auto &timer = metadata_.timer;
+  const auto timeout_limit = metadata_.timeout_limit;
+  const auto &required_props = root_context->required_prop;
+
+  if (timer.GetInvocations() == 0) {
+    timer.Start();
+  }
+  // Only the calling thread checks the timer, between the tasks it runs
+  auto timed_out = [&]() {
+    timer.Reset();
+    timer.Stop();
+    return timer.GetDuration() >= timeout_limit &&
+           root_group->HasExpressions(required_props);
+  };
+  if (!task_pool.Execute(timed_out)) {
+    throw OptimizerException("Optimizer task execution duration " +
+                             std::to_string(timer.GetDuration()) +
+                             " exceeds timeout limit " +
+                             std::to_string(timeout_limit));
+  }
+}
+
 }  // namespace optimizer
 }  // namespace peloton
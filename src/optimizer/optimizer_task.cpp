@@ -16,6 +16,7 @@
 #include "optimizer/optimizer_metadata.h"
 #include "optimizer/binding.h"
 #include "optimizer/child_property_deriver.h"
+#include "optimizer/join_enumerator.h"
 #include "optimizer/stats/stats_calculator.h"
 #include "optimizer/stats/child_stats_deriver.h"
 
@@ -49,6 +50,18 @@ void OptimizerTask::PushTask(OptimizerTask *task) {
   context_->metadata->task_pool->Push(task);
 }
 
+void OptimizerTask::PushContinuation(OptimizerTask *task) {
+  context_->metadata->task_pool->PushContinuation(task);
+}
+
+bool OptimizerTask::WaitForExploration(Group *group) {
+  if (!group->AddExplorationWaiter(this)) {
+    return false;
+  }
+  context_->metadata->task_pool->Suspend(this);
+  return true;
+}
+
 Memo &OptimizerTask::GetMemo() const { return context_->metadata->memo; }
 
 RuleSet &OptimizerTask::GetRuleSet() const {
@@ -67,19 +80,20 @@ void OptimizeGroup::execute() {
 
   // Push explore task first for logical expressions if the group has not been
   // explored
-  if (!group_->HasExplored()) {
+  if (group_->StartExploration()) {
+    PushContinuation(new MarkGroupExplored(group_, context_));
     for (auto &logical_expr : group_->GetLogicalExpressions())
       PushTask(new OptimizeExpression(logical_expr.get(), context_));
+  } else if (WaitForExploration(group_)) {
+    // Another task is exploring the group, we need all its physical
+    // expressions
+    return;
   }
 
   // Push implement tasks to ensure that they are run first (for early pruning)
   for (auto &physical_expr : group_->GetPhysicalExpressions()) {
     PushTask(new OptimizeInputs(physical_expr.get(), context_));
   }
-
-  // Since there is no cycle in the tree, it is safe to set the flag even before
-  // all expressions are explored
-  group_->SetExplorationFlag();
 }
 
 //===--------------------------------------------------------------------===//
@@ -100,7 +114,7 @@ void OptimizeExpression::execute() {
             static_cast<int>(group_expr_->Op().GetType()), valid_rules.size());
   // Apply rule
   for (auto &r : valid_rules) {
-    PushTask(new ApplyRule(group_expr_, r.rule, context_));
+    PushContinuation(new ApplyRule(group_expr_, r.rule, context_));
     int child_group_idx = 0;
     for (auto &child_pattern : r.rule->GetMatchPattern()->Children()) {
       // Only need to explore non-leaf children before applying rule to the
@@ -121,16 +135,26 @@ void OptimizeExpression::execute() {
 // ExploreGroup
 //===--------------------------------------------------------------------===//
 void ExploreGroup::execute() {
-  if (group_->HasExplored()) return;
+  if (!group_->StartExploration()) {
+    // Wait for the task exploring the group, if it has not finished yet
+    WaitForExploration(group_);
+    return;
+  }
   LOG_TRACE("ExploreGroup::execute() ");
 
+  PushContinuation(new MarkGroupExplored(group_, context_));
   for (auto &logical_expr : group_->GetLogicalExpressions()) {
     PushTask(new ExploreExpression(logical_expr.get(), context_));
   }
+}
 
-  // Since there is no cycle in the tree, it is safe to set the flag even before
-  // all expressions are explored
-  group_->SetExplorationFlag();
+//===--------------------------------------------------------------------===//
+// MarkGroupExplored
+//===--------------------------------------------------------------------===//
+void MarkGroupExplored::execute() {
+  for (auto waiter : group_->FinishExploration()) {
+    context_->metadata->task_pool->Resume(waiter);
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -148,7 +172,7 @@ void ExploreExpression::execute() {
 
   // Apply rule
   for (auto &r : valid_rules) {
-    PushTask(new ApplyRule(group_expr_, r.rule, context_, true));
+    PushContinuation(new ApplyRule(group_expr_, r.rule, context_, true));
     int child_group_idx = 0;
     for (auto &child_pattern : r.rule->GetMatchPattern()->Children()) {
       // Only need to explore non-leaf children before applying rule to the
@@ -189,7 +213,8 @@ void ApplyRule::execute() {
         // A new group expression is generated
         if (new_gexpr->Op().IsLogical()) {
           // Derive stats for the *logical expression*
-          PushTask(new DeriveStats(new_gexpr.get(), ExprSet{}, context_));
+          PushContinuation(
+              new DeriveStats(new_gexpr.get(), ExprSet{}, context_));
           if (explore_only) {
             // Explore this logical expression
             PushTask(new ExploreExpression(new_gexpr.get(), context_));
@@ -212,6 +237,8 @@ void ApplyRule::execute() {
 // DeriveStats
 //===--------------------------------------------------------------------===//
 void DeriveStats::execute() {
+  std::lock_guard<std::mutex> stats_lock(GetMemo().GetStatsLatch());
+
   // First do a top-down pass to get stats for required columns, then do a
   // bottom-up pass to calculate the stats
   ChildStatsDeriver deriver;
@@ -239,7 +266,7 @@ void DeriveStats::execute() {
       if (!derive_children) {
         derive_children = true;
         // Derive stats for root later
-        PushTask(new DeriveStats(this));
+        PushContinuation(new DeriveStats(this));
       }
       PushTask(
           new DeriveStats(child_group_gexpr, child_required_stats, context_));
@@ -255,6 +282,37 @@ void DeriveStats::execute() {
                             context_->metadata->txn);
   gexpr_->SetDerivedStats();
 }
+
+//===--------------------------------------------------------------------===//
+// EnumerateJoinOrder
+//===--------------------------------------------------------------------===//
+void EnumerateJoinOrder::execute() {
+  auto group = GetMemo().GetGroupByID(group_id_);
+  auto gexpr = group->GetLogicalExpressions()[0].get();
+
+  if (gexpr->Op().GetType() == OpType::InnerJoin) {
+    auto max_relations = static_cast<size_t>(settings::SettingsManager::GetInt(
+        settings::SettingId::max_dphyp_join_relations));
+    JoinEnumerator enumerator(context_->metadata, max_relations);
+    if (enumerator.Enumerate(group_id_)) {
+      // Derive stats for the new logical expressions, which also derives the
+      // stats of the new groups
+      for (auto new_gexpr : enumerator.GetNewExpressions()) {
+        PushTask(new DeriveStats(new_gexpr, ExprSet{}, context_));
+      }
+      for (auto relation : enumerator.GetRelations()) {
+        PushTask(new EnumerateJoinOrder(relation, context_));
+      }
+      return;
+    }
+  }
+
+  // Otherwise leave this group to the transformation rules, but there may be
+  // other joins further down
+  for (auto child_group_id : gexpr->GetChildGroupIDs()) {
+    PushTask(new EnumerateJoinOrder(child_group_id, context_));
+  }
+}
 //===--------------------------------------------------------------------===//
 // OptimizeInputs
 //===--------------------------------------------------------------------===//
@@ -293,6 +351,7 @@ void OptimizeInputs::execute() {
       // Compute the cost of the root operator
       // 1. Collect stats needed and cache them in the group
       // 2. Calculate cost based on children's stats
+      std::lock_guard<std::mutex> stats_lock(GetMemo().GetStatsLatch());
       cur_total_cost_ += context_->metadata->cost_model->CalculateCost(
           group_expr_, &context_->metadata->memo, context_->metadata->txn);
     }
@@ -313,7 +372,7 @@ void OptimizeInputs::execute() {
       } else if (prev_child_idx_ !=
                  cur_child_idx_) {  // We haven't optimized child group
         prev_child_idx_ = cur_child_idx_;
-        PushTask(new OptimizeInputs(this));
+        PushContinuation(new OptimizeInputs(this));
         PushTask(new OptimizeGroup(
             child_group, std::make_shared<OptimizeContext>(
                 context_->metadata, i_prop, context_->cost_upper_bound - cur_total_cost_)));
@@ -366,9 +425,12 @@ void OptimizeInputs::execute() {
           // Cost the enforced expression
           auto extended_prop_set =
               std::make_shared<PropertySet>(extended_output_properties);
-          cur_total_cost_ += context_->metadata->cost_model->CalculateCost(
-              memo_enforced_expr, &context_->metadata->memo,
-              context_->metadata->txn);
+          {
+            std::lock_guard<std::mutex> stats_lock(GetMemo().GetStatsLatch());
+            cur_total_cost_ += context_->metadata->cost_model->CalculateCost(
+                memo_enforced_expr, &context_->metadata->memo,
+                context_->metadata->txn);
+          }
 
           // Update hash tables for group and group expression
           memo_enforced_expr->SetLocalHashTable(
@@ -382,7 +444,7 @@ void OptimizeInputs::execute() {
       if (meet_requirement) {
         // If the cost is smaller than the winner, update the context upper
         // bound
-        context_->cost_upper_bound -= cur_total_cost_;
+        context_->SubtractCostUpperBound(cur_total_cost_);
         if (memo_enforced_expr != nullptr) {  // Enforcement takes place
           cur_group->SetExpressionCost(memo_enforced_expr, cur_total_cost_,
                                        context_->required_prop);
@@ -458,7 +520,8 @@ void BottomUpRewrite::execute() {
   auto cur_group_expr = cur_group->GetLogicalExpression();
 
   if (!has_optimized_child_) {
-    PushTask(new BottomUpRewrite(group_id_, context_, rule_set_name_, true));
+    PushContinuation(
+        new BottomUpRewrite(group_id_, context_, rule_set_name_, true));
     for (size_t child_group_idx = 0;
          child_group_idx < cur_group_expr->GetChildrenGroupsSize();
          child_group_idx++) {
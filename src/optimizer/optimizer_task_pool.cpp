@@ -0,0 +1,359 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimizer_task_pool.cpp
+//
+// Identification: src/optimizer/optimizer_task_pool.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/optimizer_task_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "common/logger.h"
+#include "threadpool/mono_queue_pool.h"
+
+namespace peloton {
+namespace optimizer {
+
+namespace {
+
+// The states of a task that asks to be suspended, see Suspend() and Resume()
+const int kTaskRunning = 0;
+const int kTaskSuspended = 1;
+const int kTaskResumed = 2;
+
+// Lets the helper threads of Execute() join, unless execution has finished by
+// the time they start
+struct HelperGate {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool closed = false;
+  uint32_t num_active = 0;
+};
+
+}  // namespace
+
+thread_local ConcurrentOptimizerTaskPool::Worker
+    *ConcurrentOptimizerTaskPool::current_worker_ = nullptr;
+
+ConcurrentOptimizerTaskPool::ConcurrentOptimizerTaskPool(uint32_t num_workers)
+    : num_workers_(std::max<uint32_t>(num_workers, 1)),
+      workers_(new Worker[num_workers_]),
+      num_incomplete_roots_(0),
+      stop_(false) {}
+
+ConcurrentOptimizerTaskPool::~ConcurrentOptimizerTaskPool() {
+  FreeIncompleteTasks();
+  for (auto &root_task : root_tasks_) {
+    delete root_task.first;
+  }
+}
+
+void ConcurrentOptimizerTaskPool::Push(OptimizerTask *task) {
+  if (current_worker_ == nullptr) {
+    // Tasks pushed from outside run one after the other
+    root_tasks_.emplace_back(task, true);
+    return;
+  }
+  current_worker_->pushed_tasks.emplace_back(task, false);
+}
+
+void ConcurrentOptimizerTaskPool::PushContinuation(OptimizerTask *task) {
+  if (current_worker_ == nullptr) {
+    root_tasks_.emplace_back(task, true);
+    return;
+  }
+  current_worker_->pushed_tasks.emplace_back(task, true);
+}
+
+void ConcurrentOptimizerTaskPool::Suspend(OptimizerTask *task) {
+  // Only a worker parks the task it runs once it returns, the request would
+  // otherwise be lost along with the task
+  if (current_worker_ == nullptr) {
+    throw OptimizerException("Cannot suspend a task outside of Execute()");
+  }
+  task->suspend_requested_ = true;
+}
+
+void ConcurrentOptimizerTaskPool::Resume(OptimizerTask *task) {
+  // If the task has not returned yet, the worker running it reschedules it
+  int state = kTaskRunning;
+  if (task->run_state_.compare_exchange_strong(state, kTaskResumed)) {
+    return;
+  }
+  if (state != kTaskSuspended) {
+    throw OptimizerException("Cannot resume a task that is not suspended");
+  }
+
+  suspended_latch_.Lock();
+  auto it = std::find(suspended_tasks_.begin(), suspended_tasks_.end(), task);
+  bool found = it != suspended_tasks_.end();
+  if (found) {
+    suspended_tasks_.erase(it);
+  }
+  suspended_latch_.Unlock();
+  if (!found) {
+    throw OptimizerException("Cannot resume a task that is not suspended");
+  }
+  Schedule(task);
+}
+
+bool ConcurrentOptimizerTaskPool::Execute(
+    const std::function<bool()> &should_stop) {
+  stop_ = false;
+
+  std::vector<OptimizerTask *> ready_tasks;
+  WireTasks(nullptr, root_tasks_, ready_tasks);
+  root_tasks_.clear();
+  for (auto task : ready_tasks) {
+    workers_[0].tasks.push_back(task);
+  }
+
+  // Helpers run on the execution pool. They may only start after we are done,
+  // in which case they must not touch the task pool anymore.
+  auto gate = std::make_shared<HelperGate>();
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+  for (uint32_t worker_id = 1; worker_id < num_workers_; worker_id++) {
+    work_pool.SubmitTask([this, gate, worker_id] {
+      {
+        std::lock_guard<std::mutex> lock(gate->mutex);
+        if (gate->closed) {
+          return;
+        }
+        gate->num_active++;
+      }
+      RunWorker(worker_id, nullptr);
+      {
+        std::lock_guard<std::mutex> lock(gate->mutex);
+        gate->num_active--;
+      }
+      gate->cv.notify_all();
+    });
+  }
+
+  RunWorker(0, &should_stop);
+
+  // Every task is done at this point, unless we stopped
+  {
+    std::unique_lock<std::mutex> lock(gate->mutex);
+    gate->closed = true;
+    gate->cv.wait(lock, [&gate] { return gate->num_active == 0; });
+  }
+
+  if (!stop_) {
+    PELOTON_ASSERT(num_incomplete_roots_ == 0);
+    return true;
+  }
+  FreeIncompleteTasks();
+  if (exception_ != nullptr) {
+    auto exception = exception_;
+    exception_ = nullptr;
+    std::rethrow_exception(exception);
+  }
+  return false;
+}
+
+void ConcurrentOptimizerTaskPool::RunWorker(
+    uint32_t worker_id, const std::function<bool()> *should_stop) {
+  auto &worker = workers_[worker_id];
+  current_worker_ = &worker;
+
+  while (num_incomplete_roots_ != 0 && !stop_) {
+    if (should_stop != nullptr && (*should_stop)()) {
+      stop_ = true;
+      break;
+    }
+
+    auto task = NextTask(worker_id);
+    if (task == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    try {
+      RunTask(worker, task);
+    } catch (...) {
+      exception_latch_.Lock();
+      if (exception_ == nullptr) {
+        exception_ = std::current_exception();
+      }
+      exception_latch_.Unlock();
+      stop_ = true;
+
+      // Abandon the task along with the ones it pushed
+      for (auto &pushed_task : worker.pushed_tasks) {
+        delete pushed_task.first;
+      }
+      worker.pushed_tasks.clear();
+      suspended_latch_.Lock();
+      suspended_tasks_.push_back(task);
+      suspended_latch_.Unlock();
+    }
+  }
+
+  current_worker_ = nullptr;
+}
+
+OptimizerTask *ConcurrentOptimizerTaskPool::NextTask(uint32_t worker_id) {
+  OptimizerTask *task = nullptr;
+
+  // Run the latest task of our own first
+  auto &worker = workers_[worker_id];
+  worker.latch.Lock();
+  if (!worker.tasks.empty()) {
+    task = worker.tasks.back();
+    worker.tasks.pop_back();
+  }
+  worker.latch.Unlock();
+
+  // Otherwise steal the oldest task of another worker, which is likely the
+  // root of a larger subtree of tasks
+  for (uint32_t i = 1; task == nullptr && i < num_workers_; i++) {
+    auto &victim = workers_[(worker_id + i) % num_workers_];
+    victim.latch.Lock();
+    if (!victim.tasks.empty()) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+    }
+    victim.latch.Unlock();
+  }
+  return task;
+}
+
+void ConcurrentOptimizerTaskPool::RunTask(Worker &worker, OptimizerTask *task) {
+  task->run_state_ = kTaskRunning;
+  task->suspend_requested_ = false;
+  task->execute();
+
+  if (task->suspend_requested_) {
+    // The tasks it pushed could not be waited for while it is parked
+    if (!worker.pushed_tasks.empty()) {
+      throw OptimizerException("A suspended task must not push other tasks");
+    }
+    int state = kTaskRunning;
+    suspended_latch_.Lock();
+    bool suspended =
+        task->run_state_.compare_exchange_strong(state, kTaskSuspended);
+    if (suspended) {
+      suspended_tasks_.push_back(task);
+    }
+    suspended_latch_.Unlock();
+    if (!suspended) {
+      // Resumed before it even returned
+      Schedule(task);
+    }
+    return;
+  }
+
+  std::vector<OptimizerTask *> ready_tasks;
+  WireTasks(task, worker.pushed_tasks, ready_tasks);
+  worker.pushed_tasks.clear();
+  if (task->num_pending_ == 0) {
+    Complete(task);
+    return;
+  }
+  for (auto ready_task : ready_tasks) {
+    Schedule(ready_task);
+  }
+}
+
+void ConcurrentOptimizerTaskPool::WireTasks(
+    OptimizerTask *task,
+    std::vector<std::pair<OptimizerTask *, bool>> &pushed_tasks,
+    std::vector<OptimizerTask *> &ready_tasks) {
+  // Every pushed task is waited for by the latest continuation pushed before
+  // it, or by the task that pushed it
+  OptimizerTask *parent = task;
+  for (auto &pushed_task : pushed_tasks) {
+    pushed_task.first->parent_ = parent;
+    if (parent == nullptr) {
+      num_incomplete_roots_++;
+    } else {
+      parent->num_pending_++;
+    }
+
+    if (pushed_task.second) {
+      parent = pushed_task.first;
+    } else {
+      ready_tasks.push_back(pushed_task.first);
+    }
+  }
+
+  // The last continuation may not wait for anything
+  if (parent != task && parent->num_pending_ == 0) {
+    ready_tasks.push_back(parent);
+  }
+
+  if (task != nullptr) {
+    task->executed_ = true;
+  }
+}
+
+void ConcurrentOptimizerTaskPool::Schedule(OptimizerTask *task) {
+  auto worker = (current_worker_ != nullptr ? current_worker_ : &workers_[0]);
+  worker->latch.Lock();
+  worker->tasks.push_back(task);
+  worker->latch.Unlock();
+}
+
+void ConcurrentOptimizerTaskPool::Complete(OptimizerTask *task) {
+  while (true) {
+    auto parent = task->parent_;
+    delete task;
+
+    if (parent == nullptr) {
+      num_incomplete_roots_--;
+      return;
+    }
+    if (parent->num_pending_.fetch_sub(1) != 1) {
+      return;
+    }
+    if (!parent->executed_) {
+      // A continuation whose prerequisites are all done
+      Schedule(parent);
+      return;
+    }
+    task = parent;
+  }
+}
+
+void ConcurrentOptimizerTaskPool::FreeIncompleteTasks() {
+  // Every task that is not done is either ready, suspended, or waits for one
+  // of those
+  std::unordered_set<OptimizerTask *> tasks;
+  auto add_with_ancestors = [&tasks](OptimizerTask *task) {
+    for (; task != nullptr && tasks.insert(task).second; task = task->parent_) {
+    }
+  };
+
+  for (uint32_t worker_id = 0; worker_id < num_workers_; worker_id++) {
+    for (auto task : workers_[worker_id].tasks) {
+      add_with_ancestors(task);
+    }
+    workers_[worker_id].tasks.clear();
+  }
+  for (auto task : suspended_tasks_) {
+    add_with_ancestors(task);
+  }
+  suspended_tasks_.clear();
+
+  if (!tasks.empty()) {
+    LOG_DEBUG("Abandoning %lu optimizer tasks", tasks.size());
+  }
+  for (auto task : tasks) {
+    delete task;
+  }
+  num_incomplete_roots_ = 0;
+}
+
+}  // namespace optimizer
+}  // namespace peloton
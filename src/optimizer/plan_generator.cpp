@@ -12,6 +12,8 @@
 
 #include "optimizer/plan_generator.h"
 
+#include <boost/filesystem.hpp>
+
 #include "catalog/column_catalog.h"
 #include "catalog/index_catalog.h"
 #include "catalog/table_catalog.h"
@@ -29,6 +31,7 @@
 #include "planner/index_scan_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/limit_plan.h"
+#include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
@@ -143,10 +146,23 @@ void PlanGenerator::Visit(const ExternalFileScan *op) {
         cols.emplace_back(std::move(col_info));
       }
 
+      // Check if we should do a parallel scan. Files are split into byte
+      // ranges, so only the size of the file matters.
+      bool parallel_scan = false;
+      if (settings::SettingsManager::GetBool(
+              settings::SettingId::parallel_execution)) {
+        boost::system::error_code ec;
+        auto file_size = boost::filesystem::file_size(op->file_name, ec);
+        auto min_parallel_file_scan_size =
+            static_cast<uint64_t>(settings::SettingsManager::GetInt(
+                settings::SettingId::min_parallel_file_scan_size));
+        parallel_scan = (!ec && file_size > min_parallel_file_scan_size);
+      }
+
       // Create the plan
-      output_plan_.reset(
-          new planner::CSVScanPlan(op->file_name, std::move(cols),
-                                   op->delimiter, op->quote, op->escape));
+      output_plan_.reset(new planner::CSVScanPlan(
+          op->file_name, std::move(cols), op->delimiter, op->quote, op->escape,
+          "", parallel_scan));
       break;
     }
   }
@@ -222,7 +238,7 @@ void PlanGenerator::Visit(const PhysicalHashGroupBy *op) {
 void PlanGenerator::Visit(const PhysicalSortGroupBy *op) {
   auto having_predicates =
       expression::ExpressionUtil::JoinAnnotatedExprs(op->having);
-  BuildAggregatePlan(AggregateType::HASH, &op->columns,
+  BuildAggregatePlan(AggregateType::SORTED, &op->columns,
                      std::move(having_predicates));
 }
 
@@ -290,6 +306,17 @@ void PlanGenerator::Visit(const PhysicalRightNLJoin *) {}
 void PlanGenerator::Visit(const PhysicalOuterNLJoin *) {}
 
 void PlanGenerator::Visit(const PhysicalInnerHashJoin *op) {
+  BuildHashJoinPlan(JoinType::INNER, op->join_predicates, op->left_keys,
+                    op->right_keys);
+}
+
+void PlanGenerator::Visit(const PhysicalLeftHashJoin *) {}
+
+void PlanGenerator::Visit(const PhysicalRightHashJoin *) {}
+
+void PlanGenerator::Visit(const PhysicalOuterHashJoin *) {}
+
+void PlanGenerator::Visit(const PhysicalInnerMergeJoin *op) {
   std::unique_ptr<const planner::ProjectInfo> proj_info;
   std::shared_ptr<const catalog::Schema> proj_schema;
   GenerateProjectionForJoin(proj_info, proj_schema);
@@ -301,46 +328,38 @@ void PlanGenerator::Visit(const PhysicalInnerHashJoin *op) {
   expression::ExpressionUtil::ConvertToTvExpr(join_predicate.get(),
                                               children_expr_map_);
 
-  vector<unique_ptr<const expression::AbstractExpression>> left_keys;
-  vector<unique_ptr<const expression::AbstractExpression>> right_keys;
-  vector<ExprMap> l_child_map{move(children_expr_map_[0])};
-  vector<ExprMap> r_child_map{move(children_expr_map_[1])};
-  for (auto &expr : op->left_keys) {
-    auto left_key = expr->Copy();
+  // Left keys read the left tuple, right keys read the right tuple (tuple
+  // index 1) of the pair the merge join compares
+  vector<ExprMap> l_child_map{children_expr_map_[0]};
+  vector<planner::MergeJoinPlan::JoinClause> join_clauses;
+  for (size_t i = 0; i < op->left_keys.size(); i++) {
+    auto left_key = op->left_keys[i]->Copy();
     expression::ExpressionUtil::EvaluateExpression(l_child_map, left_key);
-    left_keys.emplace_back(left_key);
-  }
-  for (auto &expr : op->right_keys) {
-    auto right_key = expr->Copy();
-    expression::ExpressionUtil::EvaluateExpression(r_child_map, right_key);
-    right_keys.emplace_back(right_key);
-  }
-  // Evaluate Expr for hash plan
-  vector<unique_ptr<const expression::AbstractExpression>> hash_keys;
-  for (auto &expr : op->right_keys) {
-    auto hash_key = expr->Copy();
-    expression::ExpressionUtil::EvaluateExpression(r_child_map, hash_key);
-    hash_keys.emplace_back(hash_key);
+    auto right_key = op->right_keys[i]->Copy();
+    expression::ExpressionUtil::EvaluateExpression(children_expr_map_,
+                                                   right_key);
+    join_clauses.emplace_back(left_key, right_key, false);
   }
 
-  unique_ptr<planner::HashPlan> hash_plan(new planner::HashPlan(hash_keys));
-  hash_plan->AddChild(move(children_plans_[1]));
-
-  auto join_plan = unique_ptr<planner::AbstractPlan>(new planner::HashJoinPlan(
-      JoinType::INNER, move(join_predicate), move(proj_info), proj_schema,
-      left_keys, right_keys, settings::SettingsManager::GetBool(
-                                 settings::SettingId::hash_join_bloom_filter)));
+  auto join_plan =
+      unique_ptr<planner::AbstractPlan>(new planner::MergeJoinPlan(
+          JoinType::INNER, move(join_predicate), move(proj_info), proj_schema,
+          join_clauses));
 
   join_plan->AddChild(move(children_plans_[0]));
-  join_plan->AddChild(move(hash_plan));
+  join_plan->AddChild(move(children_plans_[1]));
   output_plan_ = move(join_plan);
 }
 
-void PlanGenerator::Visit(const PhysicalLeftHashJoin *) {}
-
-void PlanGenerator::Visit(const PhysicalRightHashJoin *) {}
-
-void PlanGenerator::Visit(const PhysicalOuterHashJoin *) {}
+void PlanGenerator::Visit(const PhysicalSemiHashJoin *op) {
+  // The hash table is built over the inner (right) child, and the outer child
+  // probes it. Only the columns of the outer child are produced, which is all
+  // the input column deriver lets the parent require.
+  std::swap(children_plans_[0], children_plans_[1]);
+  std::swap(children_expr_map_[0], children_expr_map_[1]);
+  BuildHashJoinPlan(JoinType::SEMI, op->join_predicates, op->right_keys,
+                    op->left_keys);
+}
 
 void PlanGenerator::Visit(const PhysicalInsert *op) {
   unique_ptr<planner::AbstractPlan> insert_plan(new planner::InsertPlan(
@@ -601,6 +620,56 @@ void PlanGenerator::BuildAggregatePlan(
   output_plan_.reset(agg_plan);
 }
 
+void PlanGenerator::BuildHashJoinPlan(
+    JoinType join_type, const vector<AnnotatedExpression> &join_predicates,
+    const vector<unique_ptr<expression::AbstractExpression>> &join_left_keys,
+    const vector<unique_ptr<expression::AbstractExpression>> &join_right_keys) {
+  std::unique_ptr<const planner::ProjectInfo> proj_info;
+  std::shared_ptr<const catalog::Schema> proj_schema;
+  GenerateProjectionForJoin(proj_info, proj_schema);
+
+  auto join_predicate =
+      expression::ExpressionUtil::JoinAnnotatedExprs(join_predicates);
+  expression::ExpressionUtil::EvaluateExpression(children_expr_map_,
+                                                 join_predicate.get());
+  expression::ExpressionUtil::ConvertToTvExpr(join_predicate.get(),
+                                              children_expr_map_);
+
+  vector<unique_ptr<const expression::AbstractExpression>> left_keys;
+  vector<unique_ptr<const expression::AbstractExpression>> right_keys;
+  vector<ExprMap> l_child_map{move(children_expr_map_[0])};
+  vector<ExprMap> r_child_map{move(children_expr_map_[1])};
+  for (auto &expr : join_left_keys) {
+    auto left_key = expr->Copy();
+    expression::ExpressionUtil::EvaluateExpression(l_child_map, left_key);
+    left_keys.emplace_back(left_key);
+  }
+  for (auto &expr : join_right_keys) {
+    auto right_key = expr->Copy();
+    expression::ExpressionUtil::EvaluateExpression(r_child_map, right_key);
+    right_keys.emplace_back(right_key);
+  }
+  // Evaluate Expr for hash plan
+  vector<unique_ptr<const expression::AbstractExpression>> hash_keys;
+  for (auto &expr : join_right_keys) {
+    auto hash_key = expr->Copy();
+    expression::ExpressionUtil::EvaluateExpression(r_child_map, hash_key);
+    hash_keys.emplace_back(hash_key);
+  }
+
+  unique_ptr<planner::HashPlan> hash_plan(new planner::HashPlan(hash_keys));
+  hash_plan->AddChild(move(children_plans_[1]));
+
+  auto join_plan = unique_ptr<planner::AbstractPlan>(new planner::HashJoinPlan(
+      join_type, move(join_predicate), move(proj_info), proj_schema, left_keys,
+      right_keys, settings::SettingsManager::GetBool(
+                      settings::SettingId::hash_join_bloom_filter)));
+
+  join_plan->AddChild(move(children_plans_[0]));
+  join_plan->AddChild(move(hash_plan));
+  output_plan_ = move(join_plan);
+}
+
 void PlanGenerator::GenerateProjectionForJoin(
     std::unique_ptr<const planner::ProjectInfo> &proj_info,
     std::shared_ptr<const catalog::Schema> &proj_schema) {
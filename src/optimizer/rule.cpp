@@ -35,6 +35,7 @@ RuleSet::RuleSet() {
   AddImplementationRule(new LogicalInsertToPhysical());
   AddImplementationRule(new LogicalInsertSelectToPhysical());
   AddImplementationRule(new LogicalGroupByToHashGroupBy());
+  AddImplementationRule(new LogicalGroupByToSortGroupBy());
   AddImplementationRule(new LogicalAggregateToPhysical());
   AddImplementationRule(new GetToDummyScan());
   AddImplementationRule(new GetToSeqScan());
@@ -43,6 +44,8 @@ RuleSet::RuleSet() {
   AddImplementationRule(new LogicalQueryDerivedGetToPhysical());
   AddImplementationRule(new InnerJoinToInnerNLJoin());
   AddImplementationRule(new InnerJoinToInnerHashJoin());
+  AddImplementationRule(new InnerJoinToInnerMergeJoin());
+  AddImplementationRule(new SemiJoinToSemiHashJoin());
   AddImplementationRule(new ImplementDistinct());
   AddImplementationRule(new ImplementLimit());
   AddImplementationRule(new LogicalExportToPhysicalExport());
@@ -606,6 +606,46 @@ void LogicalGroupByToHashGroupBy::Transform(
   transformed.push_back(result);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalGroupByToSortGroupBy
+LogicalGroupByToSortGroupBy::LogicalGroupByToSortGroupBy() {
+  type_ = RuleType::AGGREGATE_TO_SORT_AGGREGATE;
+  match_pattern = std::make_shared<Pattern>(OpType::LogicalAggregateAndGroupBy);
+  std::shared_ptr<Pattern> child(std::make_shared<Pattern>(OpType::Leaf));
+  match_pattern->AddChild(child);
+}
+
+bool LogicalGroupByToSortGroupBy::Check(
+    std::shared_ptr<OperatorExpression> plan,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  const LogicalAggregateAndGroupBy *agg_op =
+      plan->Op().As<LogicalAggregateAndGroupBy>();
+  if (agg_op->columns.empty()) {
+    return false;
+  }
+  // The child is sorted on the group by columns, which we can only do for
+  // plain columns
+  for (auto &col : agg_op->columns) {
+    if (col->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LogicalGroupByToSortGroupBy::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  const LogicalAggregateAndGroupBy *agg_op =
+      input->Op().As<LogicalAggregateAndGroupBy>();
+  auto result = std::make_shared<OperatorExpression>(
+      PhysicalSortGroupBy::make(agg_op->columns, agg_op->having));
+  PELOTON_ASSERT(input->Children().size() == 1);
+  result->PushChild(input->Children().at(0));
+  transformed.push_back(result);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalAggregateToPhysical
 LogicalAggregateToPhysical::LogicalAggregateToPhysical() {
@@ -756,6 +796,126 @@ void InnerJoinToInnerHashJoin::Transform(
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerMergeJoin
+InnerJoinToInnerMergeJoin::InnerJoinToInnerMergeJoin() {
+  type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+}
+
+bool InnerJoinToInnerMergeJoin::Check(
+    UNUSED_ATTRIBUTE std::shared_ptr<OperatorExpression> plan,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  return true;
+}
+
+void InnerJoinToInnerMergeJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    OptimizeContext *context) const {
+  const LogicalInnerJoin *inner_join = input->Op().As<LogicalInnerJoin>();
+
+  auto children = input->Children();
+  PELOTON_ASSERT(children.size() == 2);
+  auto left_group_id = children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = children[1]->Op().As<LeafOperator>()->origin_group;
+  auto &left_group_alias =
+      context->metadata->memo.GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias =
+      context->metadata->memo.GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  util::ExtractEquiJoinKeys(inner_join->join_predicates, left_keys, right_keys,
+                            left_group_alias, right_group_alias);
+
+  // The equi-join keys become the sort order both children must provide,
+  // which we can only do for plain columns
+  PELOTON_ASSERT(right_keys.size() == left_keys.size());
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (left_keys[i]->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+        right_keys[i]->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+      return;
+    }
+  }
+  if (!left_keys.empty()) {
+    auto result_plan =
+        std::make_shared<OperatorExpression>(PhysicalInnerMergeJoin::make(
+            inner_join->join_predicates, left_keys, right_keys));
+
+    result_plan->PushChild(children[0]);
+    result_plan->PushChild(children[1]);
+
+    transformed.push_back(result_plan);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// SemiJoinToSemiHashJoin
+SemiJoinToSemiHashJoin::SemiJoinToSemiHashJoin() {
+  type_ = RuleType::SEMI_JOIN_TO_HASH_JOIN;
+
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::SemiJoin);
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+}
+
+bool SemiJoinToSemiHashJoin::Check(
+    UNUSED_ATTRIBUTE std::shared_ptr<OperatorExpression> plan,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  return true;
+}
+
+void SemiJoinToSemiHashJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    OptimizeContext *context) const {
+  const LogicalSemiJoin *semi_join = input->Op().As<LogicalSemiJoin>();
+  if (semi_join->join_predicate == nullptr) {
+    return;
+  }
+
+  auto children = input->Children();
+  PELOTON_ASSERT(children.size() == 2);
+  auto left_group_id = children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = children[1]->Op().As<LeafOperator>()->origin_group;
+  auto &left_group_alias =
+      context->metadata->memo.GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias =
+      context->metadata->memo.GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  // The left child is the outer side and the right child the inner side. The
+  // plan generator builds the hash table over the inner side and probes it
+  // with the outer side.
+  auto join_predicates =
+      util::ExtractPredicates(semi_join->join_predicate.get());
+  util::ExtractEquiJoinKeys(join_predicates, left_keys, right_keys,
+                            left_group_alias, right_group_alias);
+
+  PELOTON_ASSERT(right_keys.size() == left_keys.size());
+  if (!left_keys.empty()) {
+    auto result_plan =
+        std::make_shared<OperatorExpression>(PhysicalSemiHashJoin::make(
+            join_predicates, left_keys, right_keys));
+
+    result_plan->PushChild(children[0]);
+    result_plan->PushChild(children[1]);
+
+    transformed.push_back(result_plan);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// ImplementDistinct
 ImplementDistinct::ImplementDistinct() {
@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// auto_analyzer.cpp
+//
+// Identification: src/optimizer/stats/auto_analyzer.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/stats/auto_analyzer.h"
+
+#include <chrono>
+#include <vector>
+
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "optimizer/stats/stats_storage.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace optimizer {
+
+AutoAnalyzer &AutoAnalyzer::GetInstance() {
+  static AutoAnalyzer auto_analyzer;
+  return auto_analyzer;
+}
+
+void AutoAnalyzer::Start() {
+  analyzer_stop_ = false;
+  analyzer_thread_ = std::thread(&AutoAnalyzer::Running, this);
+  LOG_INFO("Started auto analyzer");
+}
+
+void AutoAnalyzer::Stop() {
+  if (analyzer_stop_ == true) {
+    return;
+  }
+  analyzer_stop_ = true;
+  analyzer_thread_.join();
+  LOG_INFO("Stopped auto analyzer");
+}
+
+void AutoAnalyzer::Running() {
+  while (analyzer_stop_ == false) {
+    AnalyzeTables();
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+size_t AutoAnalyzer::AnalyzeTables() {
+  size_t num_analyzed = 0;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Only pick the candidates under the latch. Sampling a table takes long,
+  // and the latch is taken by CREATE and DROP TABLE.
+  std::vector<oid_t> candidates;
+  {
+    std::lock_guard<std::mutex> lock(analyzer_mutex_);
+    for (auto &entry : tables_) {
+      auto churn = entry.second.table->GetModificationCount() -
+                   entry.second.analyzed_modification_count;
+      if (churn > min_modifications_ +
+                      churn_ratio_ * entry.second.analyzed_tuple_count) {
+        candidates.push_back(entry.first);
+      }
+    }
+  }
+
+  for (auto table_oid : candidates) {
+    // Pin the table, so that it is not dropped while we sample it
+    storage::DataTable *table;
+    {
+      std::lock_guard<std::mutex> lock(analyzer_mutex_);
+      auto entry = tables_.find(table_oid);
+      if (entry == tables_.end()) {
+        continue;
+      }
+      table = entry->second.table;
+      analyzing_table_oid_ = table_oid;
+    }
+
+    auto modification_count = table->GetModificationCount();
+    auto tuple_count = table->GetTupleCount();
+    auto *txn = txn_manager.BeginTransaction();
+    auto result =
+        StatsStorage::GetInstance()->AnalyzeStatsForTable(table, txn);
+    if (result != ResultType::SUCCESS) {
+      txn_manager.AbortTransaction(txn);
+    } else {
+      txn_manager.CommitTransaction(txn);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(analyzer_mutex_);
+      analyzing_table_oid_ = INVALID_OID;
+      auto entry = tables_.find(table_oid);
+      if (result == ResultType::SUCCESS && entry != tables_.end()) {
+        LOG_TRACE("Analyzed table %u after %lu modifications", table_oid,
+                  modification_count -
+                      entry->second.analyzed_modification_count);
+        entry->second.analyzed_modification_count = modification_count;
+        entry->second.analyzed_tuple_count = tuple_count;
+        num_analyzed++;
+      }
+    }
+    analyzer_cv_.notify_all();
+  }
+
+  return num_analyzed;
+}
+
+void AutoAnalyzer::AddTable(storage::DataTable *table) {
+  std::lock_guard<std::mutex> lock(analyzer_mutex_);
+  tables_[table->GetOid()] =
+      TableEntry{table, table->GetModificationCount(), 0};
+}
+
+void AutoAnalyzer::RemoveTable(oid_t table_oid) {
+  std::unique_lock<std::mutex> lock(analyzer_mutex_);
+  tables_.erase(table_oid);
+
+  // The caller frees the table next, so wait until it is no longer sampled
+  analyzer_cv_.wait(lock,
+                    [&] { return analyzing_table_oid_ != table_oid; });
+}
+
+void AutoAnalyzer::ClearTables() {
+  std::lock_guard<std::mutex> lock(analyzer_mutex_);
+  tables_.clear();
+}
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -47,7 +47,17 @@ void ChildStatsDeriver::Visit(const LogicalInnerJoin *op) {
 void ChildStatsDeriver::Visit(UNUSED_ATTRIBUTE const LogicalLeftJoin *) {}
 void ChildStatsDeriver::Visit(UNUSED_ATTRIBUTE const LogicalRightJoin *) {}
 void ChildStatsDeriver::Visit(UNUSED_ATTRIBUTE const LogicalOuterJoin *) {}
-void ChildStatsDeriver::Visit(const LogicalSemiJoin *) {}
+void ChildStatsDeriver::Visit(const LogicalSemiJoin *op) {
+  PassDownRequiredCols();
+  if (op->join_predicate != nullptr) {
+    ExprSet expr_set;
+    expression::ExpressionUtil::GetTupleValueExprs(expr_set,
+                                                   op->join_predicate.get());
+    for (auto &col : expr_set) {
+      PassDownColumn(col);
+    }
+  }
+}
 // TODO(boweic): support stats of aggregation
 void ChildStatsDeriver::Visit(const LogicalAggregateAndGroupBy *) {
   PassDownRequiredCols();
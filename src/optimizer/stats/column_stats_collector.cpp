@@ -52,6 +52,41 @@ void ColumnStatsCollector::AddValue(const type::Value &value) {
   }
 }
 
+void ColumnStatsCollector::Merge(const ColumnStatsCollector &other) {
+  PELOTON_ASSERT(column_id_ == other.column_id_);
+  total_count_ += other.total_count_;
+  null_count_ += other.null_count_;
+  hll_.Merge(other.hll_);
+  hist_.Merge(other.hist_);
+  topk_.Merge(other.topk_);
+}
+
+std::vector<ColumnStatsCollector::ValueFrequencyPair>
+ColumnStatsCollector::GetCommonValueAndFrequency() {
+  auto val_freqs = topk_.GetAllOrderedMaxFirst();
+  for (auto &val_freq : val_freqs) {
+    val_freq.second /= sample_fraction_;
+  }
+  return val_freqs;
+}
+
+/*
+ * Distinct counts do not scale linearly with the sample size. If every
+ * sampled value is distinct (within three times the error of the HLL), we
+ * assume the column is unique and scale up. Otherwise, we assume the sample
+ * has seen all distinct values.
+ */
+uint64_t ColumnStatsCollector::GetCardinality() {
+  uint64_t cardinality = hll_.EstimateCardinality();
+  if (sample_fraction_ < 1.0) {
+    double non_null_count = total_count_ - null_count_;
+    if (cardinality >= non_null_count * (1 - 3 * hll_.RelativeError())) {
+      cardinality = static_cast<uint64_t>(cardinality / sample_fraction_);
+    }
+  }
+  return cardinality;
+}
+
 double ColumnStatsCollector::GetFracNull() {
   if (total_count_ == 0) {
     LOG_TRACE("Cannot calculate stats for table size 0.");
@@ -158,7 +158,28 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalLeftJoin *op) {}
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalRightJoin *op) {}
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalOuterJoin *op) {}
-void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalSemiJoin *op) {}
+void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalSemiJoin *op) {
+  // A semi join produces each left tuple at most once, so the left child
+  // bounds its output
+  PELOTON_ASSERT(gexpr_->GetChildrenGroupsSize() == 2);
+  auto left_child_group = memo_->GetGroupByID(gexpr_->GetChildGroupId(0));
+  auto root_group = memo_->GetGroupByID(gexpr_->GetGroupID());
+  if (root_group->GetNumRows() == -1) {
+    root_group->SetNumRows(left_child_group->GetNumRows());
+  }
+  size_t num_rows = root_group->GetNumRows();
+  for (auto &col : required_cols_) {
+    PELOTON_ASSERT(col->GetExpressionType() == ExpressionType::VALUE_TUPLE);
+    auto tv_expr = reinterpret_cast<expression::TupleValueExpression *>(col);
+    if (!left_child_group->HasColumnStats(tv_expr->GetColFullName())) {
+      continue;
+    }
+    auto column_stats = std::make_shared<ColumnStats>(
+        *left_child_group->GetStats(tv_expr->GetColFullName()));
+    column_stats->num_rows = num_rows;
+    root_group->AddStats(tv_expr->GetColFullName(), column_stats);
+  }
+}
 void StatsCalculator::Visit(const LogicalAggregateAndGroupBy *) {
   // TODO(boweic): For now we just pass the stats needed without any
   // computation,
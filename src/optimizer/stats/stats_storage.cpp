@@ -12,17 +12,30 @@
 
 #include "optimizer/stats/stats_storage.h"
 
+#include <algorithm>
+
 #include "catalog/catalog.h"
 #include "catalog/column_stats_catalog.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "optimizer/stats/column_stats.h"
 #include "optimizer/stats/table_stats.h"
+#include "settings/settings_manager.h"
 #include "storage/storage_manager.h"
 #include "type/ephemeral_pool.h"
 
 namespace peloton {
 namespace optimizer {
 
+namespace {
+
+// The number of tuples ANALYZE samples from a table (0 means all of them)
+size_t GetAnalyzeSampleSize() {
+  return static_cast<size_t>(settings::SettingsManager::GetInt(
+      settings::SettingId::analyze_sample_size));
+}
+
+}  // namespace
+
 // Get instance of the global stats storage
 StatsStorage *StatsStorage::GetInstance() {
   static StatsStorage global_stats_storage;
@@ -62,6 +75,7 @@ void StatsStorage::InsertOrUpdateTableStats(
   oid_t table_id = table->GetOid();
   size_t num_rows = table_stats_collector->GetActiveTupleCount();
 
+  std::shared_ptr<CachedTableStats> table_stats(new CachedTableStats());
   oid_t column_count = table_stats_collector->GetColumnCount();
   for (oid_t column_id = 0; column_id < column_count; column_id++) {
     ColumnStatsCollector *column_stats_collector =
@@ -94,6 +108,27 @@ void StatsStorage::InsertOrUpdateTableStats(
                               cardinality, frac_null, most_common_vals_str,
                               most_common_freqs_str, histogram_bounds_str,
                               column_name, has_index, txn);
+
+    // Cache the stats as they are read back from the catalog
+    table_stats->column_stats[column_id] = std::make_shared<ColumnStats>(
+        database_id, table_id, column_id, column_name, has_index, num_rows,
+        cardinality, frac_null, ConvertStringToDoubleArray(most_common_vals_str),
+        ConvertStringToDoubleArray(most_common_freqs_str), histogram_bounds);
+  }
+
+  // Other transactions must not see the stats before they are committed, and
+  // never if they are rolled back
+  auto key = GetCacheKey(database_id, table_id);
+  auto cache_stats = [this, key, table_stats]() {
+    std::lock_guard<std::mutex> lock(stats_cache_latch_);
+    if (stats_cache_.Update(key, table_stats) == false) {
+      stats_cache_.Insert(key, table_stats);
+    }
+  };
+  if (txn == nullptr) {
+    cache_stats();
+  } else {
+    txn->AddOnEndAction(cache_stats, true);
   }
 }
 
@@ -132,30 +167,99 @@ void StatsStorage::InsertOrUpdateColumnStats(
                                           has_index,
                                           pool_.get());
 
+  // The cached stats of the table are read again on the next lookup. Stats
+  // cached until the transaction ends are dropped then, and the ones read
+  // before it committed are not cached anymore.
+  auto key = GetCacheKey(database_id, table_id);
+  InvalidateCachedTableStats(key, INVALID_CID);
+  txn->AddOnEndAction([this, key, txn]() {
+    InvalidateCachedTableStats(
+        key, txn->GetResult() == ResultType::SUCCESS ? txn->GetCommitId()
+                                                     : INVALID_CID);
+  });
   if (single_statement_txn) {
     txn_manager.CommitTransaction(txn);
   }
 }
 
 /**
- * GetColumnStatsByID - Query the 'pg_column_stats' table to get the column
- * stats by IDs.
+ * GetColumnStatsByID - Get the column stats by IDs. A transaction is only
+ * started to read the 'pg_column_stats' table if the stats of the table are
+ * not cached.
  */
 std::shared_ptr<ColumnStats> StatsStorage::GetColumnStatsByID(oid_t database_id,
                                                               oid_t table_id,
                                                               oid_t column_id) {
+  std::shared_ptr<CachedTableStats> table_stats;
+  if (stats_cache_.Find(GetCacheKey(database_id, table_id), table_stats) ==
+      false) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto txn = txn_manager.BeginTransaction();
+    table_stats = GetCachedTableStats(database_id, table_id, txn);
+    txn_manager.CommitTransaction(txn);
+  }
+
+  auto it = table_stats->column_stats.find(column_id);
+  if (it == table_stats->column_stats.end()) {
+    LOG_TRACE(
+        "ColumnStatsCollector not found for db: %u, table: %u, column: %u",
+        database_id, table_id, column_id);
+    return nullptr;
+  }
+  // The optimizer changes the stats it gets, so hand out a copy
+  return std::make_shared<ColumnStats>(*it->second);
+}
+
+/**
+ * GetCachedTableStats - Get the cached stats of a table. If they are not
+ * cached, they are read from the 'pg_column_stats' table.
+ */
+std::shared_ptr<CachedTableStats> StatsStorage::GetCachedTableStats(
+    oid_t database_id, oid_t table_id, concurrency::TransactionContext *txn) {
+  auto key = GetCacheKey(database_id, table_id);
+  std::shared_ptr<CachedTableStats> table_stats;
+  if (stats_cache_.Find(key, table_stats)) {
+    return table_stats;
+  }
+
   auto column_stats_catalog = catalog::ColumnStatsCatalog::GetInstance(nullptr);
-  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  auto txn = txn_manager.BeginTransaction();
-  // std::unique_ptr<std::vector<type::Value>> column_stats_vector
-  auto column_stats_vector = column_stats_catalog->GetColumnStats(txn,
-                                                                  database_id,
-                                                                  table_id,
-                                                                  column_id);
-  txn_manager.CommitTransaction(txn);
+  std::map<oid_t, std::unique_ptr<std::vector<type::Value>>> column_stats_map;
+  column_stats_catalog->GetTableStats(txn, database_id, table_id,
+                                      column_stats_map);
 
-  return ConvertVectorToColumnStats(database_id, table_id, column_id,
-                                    column_stats_vector);
+  table_stats.reset(new CachedTableStats());
+  for (auto it = column_stats_map.begin(); it != column_stats_map.end(); ++it) {
+    table_stats->column_stats[it->first] = ConvertVectorToColumnStats(
+        database_id, table_id, it->first, it->second);
+  }
+
+  // Stats ANALYZE cached meanwhile are newer than the ones read here. So are
+  // the ones it committed after our snapshot, which the cache must not lose.
+  cid_t read_id = (txn == nullptr) ? MAX_CID : txn->GetReadId();
+  std::lock_guard<std::mutex> lock(stats_cache_latch_);
+  auto invalidation = invalidation_cids_.find(key);
+  if (invalidation != invalidation_cids_.end() &&
+      invalidation->second > read_id) {
+    return table_stats;
+  }
+  if (stats_cache_.Insert(key, table_stats) == false) {
+    stats_cache_.Find(key, table_stats);
+  }
+  return table_stats;
+}
+
+/**
+ * InvalidateCachedTableStats - Drop the cached stats of a table. If they were
+ * changed by a transaction that committed with the given commit id, stats
+ * read from an older snapshot are not cached anymore.
+ */
+void StatsStorage::InvalidateCachedTableStats(uint64_t key, cid_t commit_id) {
+  std::lock_guard<std::mutex> lock(stats_cache_latch_);
+  if (commit_id != INVALID_CID) {
+    auto &invalidation_cid = invalidation_cids_[key];
+    invalidation_cid = std::max(invalidation_cid, commit_id);
+  }
+  stats_cache_.Erase(key);
 }
 
 /**
@@ -221,32 +325,27 @@ std::shared_ptr<ColumnStats> StatsStorage::ConvertVectorToColumnStats(
 }
 
 /**
- * GetTableStats - This function queries the column_stats_catalog for the table
- *stats.
+ * GetTableStats - This function gets the stats of a table from the stats
+ *cache.
  *
  * The return value is the shared_ptr of TableStats wrapper.
  */
 std::shared_ptr<TableStats> StatsStorage::GetTableStats(
     oid_t database_id, oid_t table_id, concurrency::TransactionContext *txn) {
-  auto column_stats_catalog = catalog::ColumnStatsCatalog::GetInstance(nullptr);
-  std::map<oid_t, std::unique_ptr<std::vector<type::Value>>> column_stats_map;
-  column_stats_catalog->GetTableStats(txn,
-                                      database_id,
-                                      table_id,
-                                      column_stats_map);
+  auto table_stats = GetCachedTableStats(database_id, table_id, txn);
 
   std::vector<std::shared_ptr<ColumnStats>> column_stats_ptrs;
-  for (auto it = column_stats_map.begin(); it != column_stats_map.end(); ++it) {
-    column_stats_ptrs.push_back(ConvertVectorToColumnStats(
-        database_id, table_id, it->first, it->second));
+  for (auto &column_stats : table_stats->column_stats) {
+    column_stats_ptrs.push_back(
+        std::make_shared<ColumnStats>(*column_stats.second));
   }
 
   return std::shared_ptr<TableStats>(new TableStats(column_stats_ptrs));
 }
 
 /**
- * GetTableStats - This function query the column_stats_catalog for the table
- *stats.
+ * GetTableStats - This function gets the stats of a table from the stats
+ *cache.
  * In this function, the column ids are specified.
  *
  * The return value is the shared_ptr of TableStats wrapper.
@@ -254,19 +353,13 @@ std::shared_ptr<TableStats> StatsStorage::GetTableStats(
 std::shared_ptr<TableStats> StatsStorage::GetTableStats(
     oid_t database_id, oid_t table_id, std::vector<oid_t> column_ids,
     concurrency::TransactionContext *txn) {
-  auto column_stats_catalog = catalog::ColumnStatsCatalog::GetInstance(nullptr);
-  std::map<oid_t, std::unique_ptr<std::vector<type::Value>>> column_stats_map;
-  column_stats_catalog->GetTableStats(txn,
-                                      database_id,
-                                      table_id,
-                                      column_stats_map);
+  auto table_stats = GetCachedTableStats(database_id, table_id, txn);
 
   std::vector<std::shared_ptr<ColumnStats>> column_stats_ptrs;
   for (oid_t col_id : column_ids) {
-    auto it = column_stats_map.find(col_id);
-    if (it != column_stats_map.end()) {
-      column_stats_ptrs.push_back(ConvertVectorToColumnStats(
-          database_id, table_id, col_id, it->second));
+    auto it = table_stats->column_stats.find(col_id);
+    if (it != table_stats->column_stats.end()) {
+      column_stats_ptrs.push_back(std::make_shared<ColumnStats>(*it->second));
     }
   }
 
@@ -298,7 +391,7 @@ ResultType StatsStorage::AnalyzeStatsForAllTables(
       auto table = database->GetTable(table_offset);
       LOG_DEBUG("Analyzing table: %s", table->GetName().c_str());
       std::unique_ptr<TableStatsCollector> table_stats_collector(
-          new TableStatsCollector(table));
+          new TableStatsCollector(table, GetAnalyzeSampleSize()));
       table_stats_collector->CollectColumnStats();
       InsertOrUpdateTableStats(table, table_stats_collector.get(), txn);
     }
@@ -312,13 +405,19 @@ ResultType StatsStorage::AnalyzeStatsForAllTables(
  */
 ResultType StatsStorage::AnalyzeStatsForTable(
     storage::DataTable *table, concurrency::TransactionContext *txn) {
+  return AnalyzeStatsForTable(table, txn, GetAnalyzeSampleSize());
+}
+
+ResultType StatsStorage::AnalyzeStatsForTable(
+    storage::DataTable *table, concurrency::TransactionContext *txn,
+    size_t sample_size) {
   if (txn == nullptr) {
     LOG_TRACE("Do not have transaction to analyze the table stats: %s",
               table->GetName().c_str());
     return ResultType::FAILURE;
   }
   std::unique_ptr<TableStatsCollector> table_stats_collector(
-      new TableStatsCollector(table));
+      new TableStatsCollector(table, sample_size));
   table_stats_collector->CollectColumnStats();
   InsertOrUpdateTableStats(table, table_stats_collector.get(), txn);
   return ResultType::SUCCESS;
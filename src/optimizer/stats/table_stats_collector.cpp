@@ -12,22 +12,33 @@
 
 #include "optimizer/stats/table_stats_collector.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
 
 #include "common/macros.h"
+#include "common/synchronization/count_down_latch.h"
+#include "settings/settings_manager.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "common/internal_types.h"
+#include "threadpool/mono_queue_pool.h"
 #include "type/value.h"
 
 namespace peloton {
 namespace optimizer {
 
-TableStatsCollector::TableStatsCollector(storage::DataTable *table)
+TableStatsCollector::TableStatsCollector(storage::DataTable *table,
+                                         size_t sample_size)
     : table_(table),
       column_stats_collectors_{},
       active_tuple_count_{0},
-      column_count_{0} {}
+      column_count_{0},
+      sample_size_{sample_size} {}
 
 TableStatsCollector::~TableStatsCollector() {}
 
@@ -40,44 +51,177 @@ void TableStatsCollector::CollectColumnStats() {
     return;
   }
 
-  InitColumnStatsCollectors();
+  InitColumnStatsCollectors(column_stats_collectors_);
 
+  // The active tuple count comes from the headers, so it's exact even if we
+  // only sample the tuples themselves
   size_t tile_group_count = table_->GetTileGroupCount();
-  // Collect stats for all tile groups.
+  std::vector<size_t> active_tuple_counts(tile_group_count);
   for (size_t offset = 0; offset < tile_group_count; offset++) {
-    std::shared_ptr<storage::TileGroup> tile_group =
-        table_->GetTileGroup(offset);
-    storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
-    oid_t tuple_count = tile_group->GetAllocatedTupleCount();
-    active_tuple_count_ += tile_group_header->GetActiveTupleCount();
-    // Collect stats for all tuples in the tile group.
-    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
-      txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
-      if (tuple_txn_id != INVALID_TXN_ID) {
-        // Collect stats for all columns.
-        for (oid_t column_id = 0; column_id < column_count_; column_id++) {
-          type::Value value = tile_group->GetValue(tuple_id, column_id);
-          column_stats_collectors_[column_id]->AddValue(value);
-        } /* column */
+    auto tile_group = table_->GetTileGroup(offset);
+    active_tuple_counts[offset] =
+        tile_group == nullptr ? 0
+                              : tile_group->GetHeader()->GetActiveTupleCount();
+    active_tuple_count_ += active_tuple_counts[offset];
+  }
+
+  std::vector<size_t> offsets = SampleTileGroups(tile_group_count);
+  if (offsets.empty()) {
+    return;
+  }
+
+  // Only go parallel if there is enough work for it
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+  size_t tuples_per_tile_group = table_->GetTuplesPerTileGroup();
+  bool parallel =
+      settings::SettingsManager::GetBool(
+          settings::SettingId::parallel_execution) &&
+      offsets.size() * tuples_per_tile_group >=
+          static_cast<size_t>(settings::SettingsManager::GetInt(
+              settings::SettingId::min_parallel_table_scan_size));
+  size_t num_tasks =
+      (parallel ? std::min<size_t>(work_pool.NumWorkers(), offsets.size())
+                : 1);
+
+  if (num_tasks <= 1) {
+    for (size_t offset : offsets) {
+      CollectTileGroup(table_->GetTileGroup(offset).get(),
+                       column_stats_collectors_);
+    }
+  } else {
+    // Every task builds its own collectors, pulling tile groups off a shared
+    // counter until all of them have been scanned
+    std::vector<std::vector<std::unique_ptr<ColumnStatsCollector>>>
+        task_collectors(num_tasks);
+    std::atomic<size_t> next_offset{0};
+
+    // The first error encountered by any task
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    common::synchronization::CountDownLatch latch(num_tasks);
+    for (size_t task_id = 0; task_id < num_tasks; task_id++) {
+      work_pool.SubmitTask([this, &task_collectors, &offsets, &next_offset,
+                            &error_mutex, &error, &latch, task_id]() {
+        auto &collectors = task_collectors[task_id];
+        try {
+          InitColumnStatsCollectors(collectors);
+          for (size_t idx = next_offset++; idx < offsets.size();
+               idx = next_offset++) {
+            CollectTileGroup(table_->GetTileGroup(offsets[idx]).get(),
+                             collectors);
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (error == nullptr) {
+            error = std::current_exception();
+          }
+        }
+        latch.CountDown();
+      });
+    }
+    latch.Await(0);
+
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+
+    // Merge the stats of all tasks
+    for (auto &collectors : task_collectors) {
+      for (oid_t column_id = 0; column_id < column_count_; column_id++) {
+        column_stats_collectors_[column_id]->Merge(*collectors[column_id]);
+      }
+    }
+  }
+
+  // Extrapolate from the sample to the whole table
+  if (offsets.size() < tile_group_count) {
+    size_t sampled_tuple_count = 0;
+    for (size_t offset : offsets) {
+      sampled_tuple_count += active_tuple_counts[offset];
+    }
+    if (sampled_tuple_count > 0) {
+      double fraction =
+          static_cast<double>(sampled_tuple_count) / active_tuple_count_;
+      for (auto &collector : column_stats_collectors_) {
+        collector->SetSampleFraction(fraction);
       }
-    } /* tuple */
-  }   /* tile group */
+    }
+  }
+}
+
+/*
+ * Block-level sampling: since tuples in a tile group are stored together, we
+ * sample whole tile groups rather than individual tuples. The tile groups are
+ * chosen with reservoir sampling (Algorithm R) and returned in storage order.
+ */
+std::vector<size_t> TableStatsCollector::SampleTileGroups(
+    size_t tile_group_count) const {
+  std::vector<size_t> offsets(tile_group_count);
+  std::iota(offsets.begin(), offsets.end(), 0);
+  if (sample_size_ == 0 || tile_group_count == 0) {
+    return offsets;
+  }
+
+  size_t tuples_per_tile_group =
+      std::max<size_t>(1, table_->GetTuplesPerTileGroup());
+  size_t num_samples =
+      (sample_size_ + tuples_per_tile_group - 1) / tuples_per_tile_group;
+  if (num_samples >= tile_group_count) {
+    return offsets;
+  }
+
+  std::mt19937_64 rng{std::random_device{}()};
+  offsets.resize(num_samples);
+  for (size_t offset = num_samples; offset < tile_group_count; offset++) {
+    std::uniform_int_distribution<size_t> dist(0, offset);
+    size_t slot = dist(rng);
+    if (slot < num_samples) {
+      offsets[slot] = offset;
+    }
+  }
+  std::sort(offsets.begin(), offsets.end());
+  return offsets;
+}
+
+void TableStatsCollector::CollectTileGroup(
+    storage::TileGroup *tile_group,
+    std::vector<std::unique_ptr<ColumnStatsCollector>> &collectors) const {
+  // Tile groups that were retired by compaction have no tuples
+  if (tile_group == nullptr) {
+    return;
+  }
+  storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
+  // Slots past the next free one have never been used
+  oid_t tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+  // Collect stats for all tuples in the tile group.
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id != INVALID_TXN_ID) {
+      // Collect stats for all columns.
+      for (oid_t column_id = 0; column_id < column_count_; column_id++) {
+        type::Value value = tile_group->GetValue(tuple_id, column_id);
+        collectors[column_id]->AddValue(value);
+      } /* column */
+    }
+  } /* tuple */
 }
 
-void TableStatsCollector::InitColumnStatsCollectors() {
+void TableStatsCollector::InitColumnStatsCollectors(
+    std::vector<std::unique_ptr<ColumnStatsCollector>> &collectors) const {
   oid_t database_id = table_->GetDatabaseOid();
   oid_t table_id = table_->GetOid();
   for (oid_t column_id = 0; column_id < column_count_; column_id++) {
     std::unique_ptr<ColumnStatsCollector> colstats(new ColumnStatsCollector(
         database_id, table_id, column_id, schema_->GetType(column_id),
         table_->GetName()+"."+schema_->GetColumn(column_id).GetName()));
-    column_stats_collectors_.push_back(std::move(colstats));
+    collectors.push_back(std::move(colstats));
   }
 
   // Set indexes in the column stats collectors.
   for (auto &column_set : table_->GetIndexColumns()) {
     auto column_id = *(column_set.begin());
-    column_stats_collectors_[column_id]->SetColumnIndexed();
+    collectors[column_id]->SetColumnIndexed();
   }
 }
 
@@ -44,8 +44,11 @@ size_t TupleSampler::AcquireSampleTuples(size_t target_sample_count) {
   while (sampled_tuples.size() < target_sample_count) {
     // Generate a random tilegroup offset
     rand_tilegroup_offset = rand() % tile_group_count;
-    storage::TileGroup *tile_group =
-        table->GetTileGroup(rand_tilegroup_offset).get();
+    auto tile_group_ptr = table->GetTileGroup(rand_tilegroup_offset);
+    storage::TileGroup *tile_group = tile_group_ptr.get();
+    if (tile_group == nullptr) {
+      continue;
+    }
     oid_t tuple_per_group = tile_group->GetActiveTupleCount();
     LOG_TRACE("tile_group: offset: %lu, addr: %p, tuple_per_group: %u",
               rand_tilegroup_offset, tile_group, tuple_per_group);
@@ -100,6 +103,17 @@ bool TupleSampler::GetTupleInTileGroup(storage::TileGroup *tile_group,
     const catalog::Schema &schema = *(tile->GetSchema());
     uint32_t tile_column_count = schema.GetColumnCount();
 
+    // The tiles of frozen tile groups decode their values one at a time
+    if (tile->IsCompressed()) {
+      for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
+           tile_column_itr++) {
+        type::Value val = tile->GetValue(tuple_offset, tile_column_itr);
+        tuple->SetValue(tuple_column_itr, val, pool_.get());
+        tuple_column_itr++;
+      }
+      continue;
+    }
+
     char *tile_tuple_location = tile->GetTupleLocation(tuple_offset);
     storage::Tuple tile_tuple(&schema, tile_tuple_location);
 
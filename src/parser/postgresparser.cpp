@@ -22,6 +22,7 @@
 #include "expression/star_expression.h"
 #include "expression/subquery_expression.h"
 #include "expression/tuple_value_expression.h"
+#include "expression/vector_value_expression.h"
 #include "parser/pg_list.h"
 #include "parser/pg_query.h"
 #include "parser/pg_trigger.h"
@@ -689,6 +690,10 @@ expression::AbstractExpression *PostgresParser::AExprTransform(A_Expr *root) {
 
   LOG_TRACE("A_Expr type: %d\n", root->type);
 
+  if (root->kind == AEXPR_IN) {
+    return InListTransform(root);
+  }
+
   UNUSED_ATTRIBUTE expression::AbstractExpression *result = nullptr;
   UNUSED_ATTRIBUTE ExpressionType target_type;
   const char *name =
@@ -736,6 +741,42 @@ expression::AbstractExpression *PostgresParser::AExprTransform(A_Expr *root) {
   return result;
 }
 
+// This function takes in a Postgres A_Expr parsenode of an "x [NOT] IN (...)"
+// list and transfers it into an IN comparison against a value vector.
+expression::AbstractExpression *PostgresParser::InListTransform(A_Expr *root) {
+  const char *name =
+      (reinterpret_cast<value *>(root->name->head->data.ptr_value))->val.str;
+  bool negated = (strcmp(name, "<>") == 0);
+
+  std::vector<expression::AbstractExpression *> values;
+  expression::AbstractExpression *left_expr = nullptr;
+  try {
+    left_expr = ExprTransform(root->lexpr);
+    auto list = reinterpret_cast<List *>(root->rexpr);
+    for (auto cell = list->head; cell != nullptr; cell = cell->next) {
+      values.push_back(
+          ExprTransform(reinterpret_cast<Node *>(cell->data.ptr_value)));
+    }
+  } catch (NotImplementedException e) {
+    delete left_expr;
+    for (auto *value : values) {
+      delete value;
+    }
+    throw NotImplementedException(
+        StringUtil::Format("Exception thrown in IN list:\n%s", e.what()));
+  }
+
+  expression::AbstractExpression *result =
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_IN, left_expr,
+          new expression::VectorValueExpression(values));
+  if (negated) {
+    result = new expression::OperatorExpression(
+        ExpressionType::OPERATOR_NOT, type::TypeId::BOOLEAN, result, nullptr);
+  }
+  return result;
+}
+
 expression::AbstractExpression *PostgresParser::SubqueryExprTransform(
     SubLink *node) {
   if (node == nullptr) {
@@ -1524,34 +1565,59 @@ parser::CopyStatement *PostgresParser::CopyTransform(CopyStmt *root) {
   result->file_path = (root->filename != nullptr ? root->filename : "");
   result->is_from = root->is_from;
 
-  // Handle options
+  // Handle options, a statement without any has none
+  bool has_format = false;
+  bool has_delimiter = false;
   ListCell *cell = nullptr;
-  for_each_cell(cell, root->options->head) {
-    auto *def_elem = reinterpret_cast<DefElem *>(cell->data.ptr_value);
+  if (root->options != nullptr) {
+    for_each_cell(cell, root->options->head) {
+      auto *def_elem = reinterpret_cast<DefElem *>(cell->data.ptr_value);
+
+      // Check delimiter
+      if (strncmp(def_elem->defname, kDelimiterTok, sizeof(kDelimiterTok)) ==
+          0) {
+        auto *delimiter_val = reinterpret_cast<value *>(def_elem->arg);
+        result->delimiter = *delimiter_val->val.str;
+        has_delimiter = true;
+      }
 
-    // Check delimiter
-    if (strncmp(def_elem->defname, kDelimiterTok, sizeof(kDelimiterTok)) == 0) {
-      auto *delimiter_val = reinterpret_cast<value *>(def_elem->arg);
-      result->delimiter = *delimiter_val->val.str;
-    }
+      // Check format
+      if (strncmp(def_elem->defname, kFormatTok, sizeof(kFormatTok)) == 0) {
+        auto *format_val = reinterpret_cast<value *>(def_elem->arg);
+        result->format = StringToExternalFileFormat(format_val->val.str);
+        has_format = true;
+      }
 
-    // Check format
-    if (strncmp(def_elem->defname, kFormatTok, sizeof(kFormatTok)) == 0) {
-      auto *format_val = reinterpret_cast<value *>(def_elem->arg);
-      result->format = StringToExternalFileFormat(format_val->val.str);
-    }
+      // Check quote
+      if (strncmp(def_elem->defname, kQuoteTok, sizeof(kQuoteTok)) == 0) {
+        auto *quote_val = reinterpret_cast<value *>(def_elem->arg);
+        result->quote = *quote_val->val.str;
+      }
 
-    // Check quote
-    if (strncmp(def_elem->defname, kQuoteTok, sizeof(kQuoteTok)) == 0) {
-      auto *quote_val = reinterpret_cast<value *>(def_elem->arg);
-      result->quote = *quote_val->val.str;
+      // Check escape
+      if (strncmp(def_elem->defname, kEscapeTok, sizeof(kEscapeTok)) == 0) {
+        auto *escape_val = reinterpret_cast<value *>(def_elem->arg);
+        result->escape = *escape_val->val.str;
+      }
     }
+  }
 
-    // Check escape
-    if (strncmp(def_elem->defname, kEscapeTok, sizeof(kEscapeTok)) == 0) {
-      auto *escape_val = reinterpret_cast<value *>(def_elem->arg);
-      result->escape = *escape_val->val.str;
+  // Like Postgres, data streamed over the connection defaults to the text
+  // format, which separates columns by tabs. Files are only read and written
+  // as CSV.
+  if (result->file_path.empty()) {
+    if (!has_format) {
+      result->format = ExternalFileFormat::TEXT;
     }
+    if (result->format == ExternalFileFormat::TEXT && !has_delimiter) {
+      result->delimiter = '\t';
+    }
+  } else if (result->format != ExternalFileFormat::CSV) {
+    auto format = ExternalFileFormatToString(result->format);
+    delete result;
+    throw NotImplementedException(StringUtil::Format(
+        "COPY %s a file only supports the CSV format, not %s",
+        (root->is_from ? "from" : "to"), format.c_str()));
   }
 
   return result;
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// append_plan.cpp
+//
+// Identification: src/planner/append_plan.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/append_plan.h"
+
+namespace peloton {
+namespace planner {
+
+void AppendPlan::PerformBinding(BindingContext &binding_context) {
+  const auto &children = GetChildren();
+  PELOTON_ASSERT(!children.empty());
+
+  // The inputs of an append match up by position only, so each of them is
+  // bound in a context of its own
+  input_ais_.clear();
+  std::vector<oid_t> output_col_ids;
+  for (uint32_t child_idx = 0; child_idx < children.size(); child_idx++) {
+    const auto &child = children[child_idx];
+    BindingContext child_context;
+    child->PerformBinding(child_context);
+
+    std::vector<oid_t> col_ids;
+    child->GetOutputColumns(col_ids);
+    std::vector<const AttributeInfo *> child_ais;
+    for (const oid_t col_id : col_ids) {
+      const auto *ai = child_context.Find(col_id);
+      PELOTON_ASSERT(ai != nullptr);
+      child_ais.push_back(ai);
+    }
+    input_ais_.emplace_back(std::move(child_ais));
+
+    if (child_idx == 0) {
+      output_col_ids = col_ids;
+    }
+  }
+
+  // We produce the attributes of the first input
+  for (uint32_t i = 0; i < output_col_ids.size(); i++) {
+    binding_context.Bind(output_col_ids[i], input_ais_[0][i]);
+  }
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -22,8 +22,9 @@ namespace planner {
 CSVScanPlan::CSVScanPlan(std::string file_name,
                          std::vector<CSVScanPlan::ColumnInfo> &&cols,
                          char delimiter, char quote, char escape,
-                         std::string null)
-    : file_name_(std::move(file_name)),
+                         std::string null, bool parallel)
+    : AbstractScan(nullptr, nullptr, {}, parallel),
+      file_name_(std::move(file_name)),
       delimiter_(delimiter),
       quote_(quote),
       escape_(escape),
@@ -48,7 +49,8 @@ std::unique_ptr<AbstractPlan> CSVScanPlan::Copy() const {
                                                .type = attribute.type.type_id});
   }
   return std::unique_ptr<AbstractPlan>(
-      new CSVScanPlan(file_name_, std::move(new_cols)));
+      new CSVScanPlan(file_name_, std::move(new_cols), delimiter_, quote_,
+                      escape_, null_, IsParallel()));
 }
 
 void CSVScanPlan::PerformBinding(BindingContext &binding_context) {
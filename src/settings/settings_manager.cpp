@@ -110,13 +110,21 @@ const std::string SettingsManager::GetInfo() const {
   info.append(StringUtil::Format("%34s:   %-34i\n", "Max Connections", GetInt(SettingId::max_connections)));
   info.append(StringUtil::Format("%34s:   %-34s\n", "Index Tuner", GetBool(SettingId::index_tuner) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   %-34s\n", "Layout Tuner", GetBool(SettingId::layout_tuner) ? "enabled" : "disabled"));
+  info.append(StringUtil::Format("%34s:   %-34s\n", "Tile Group Freezer", GetBool(SettingId::tile_group_freezer) ? "enabled" : "disabled"));
+  info.append(StringUtil::Format("%34s:   %-34i\n", "Decompressed Tile Cache (MB)", GetInt(SettingId::decompressed_tile_cache_size)));
+  info.append(StringUtil::Format("%34s:   %-34s\n", "Tile Group Compactor", GetBool(SettingId::tile_group_compactor) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   (queue size %i, %i threads)\n", "Worker Pool", GetInt(SettingId::monoqueue_task_queue_size), GetInt(SettingId::monoqueue_worker_pool_size)));
   info.append(StringUtil::Format("%34s:   %-34s\n", "Parallel Query Execution", GetBool(SettingId::parallel_execution) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   %-34i\n", "Min. Parallel Table Scan Size", GetInt(SettingId::min_parallel_table_scan_size)));
+  info.append(StringUtil::Format("%34s:   %-34i\n", "Min. Parallel File Scan Size", GetInt(SettingId::min_parallel_file_scan_size)));
+  info.append(StringUtil::Format("%34s:   %-34i\n", "ANALYZE Sample Size", GetInt(SettingId::analyze_sample_size)));
+  info.append(StringUtil::Format("%34s:   %-34s\n", "Auto-Analyze", GetBool(SettingId::auto_analyze) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   %-34s\n", "Code-generation", GetBool(SettingId::codegen) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   %-34s\n", "Print IR Statistics", GetBool(SettingId::print_ir_stats) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   %-34s\n", "Dump IR", GetBool(SettingId::dump_ir) ? "enabled" : "disabled"));
   info.append(StringUtil::Format("%34s:   %-34i\n", "Optimization Timeout", GetInt(SettingId::task_execution_timeout)));
+  info.append(StringUtil::Format("%34s:   %-34i\n", "Max DPhyp Join Relations", GetInt(SettingId::max_dphyp_join_relations)));
+  info.append(StringUtil::Format("%34s:   %-34i\n", "Optimizer Task Threads", GetInt(SettingId::optimizer_task_threads)));
   info.append(StringUtil::Format("%34s:   %-34i\n", "Number of GC threads", GetInt(SettingId::gc_num_threads)));
   // clang-format on
 
@@ -187,6 +187,16 @@ void BackendStatsContext::IncrementIndexInserts(
   index_metric->GetIndexAccess().IncrementInserts();
 }
 
+void BackendStatsContext::IncrementIndexInserts(
+    size_t insert_count, index::IndexMetadata *metadata) {
+  oid_t index_id = metadata->GetOid();
+  oid_t table_id = metadata->GetTableOid();
+  oid_t database_id = metadata->GetDatabaseOid();
+  auto index_metric = GetIndexMetric(database_id, table_id, index_id);
+  PELOTON_ASSERT(index_metric != nullptr);
+  index_metric->GetIndexAccess().IncrementInserts(insert_count);
+}
+
 void BackendStatsContext::IncrementIndexUpdates(
     index::IndexMetadata *metadata) {
   oid_t index_id = metadata->GetOid();
@@ -0,0 +1,637 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_tile.cpp
+//
+// Identification: src/storage/compressed_tile.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/compressed_tile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "catalog/schema.h"
+#include "common/macros.h"
+#include "settings/settings_manager.h"
+#include "storage/tile_group.h"
+#include "type/abstract_pool.h"
+#include "type/varlen_slot.h"
+
+namespace peloton {
+namespace storage {
+
+namespace {
+
+// Whether the stored values of the given type are integers
+bool IsIntegralType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether the values of the given type are stored in varlen slots
+bool IsVarlenType(type::TypeId type_id) {
+  return type_id == type::TypeId::VARCHAR || type_id == type::TypeId::VARBINARY;
+}
+
+// The number of bits needed to represent the given value
+uint32_t BitWidth(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+// Sign-extend the 'length' low bytes of the given stored value
+int64_t SignExtend(uint64_t slot, uint32_t length) {
+  if (length >= sizeof(uint64_t)) {
+    return static_cast<int64_t>(slot);
+  }
+  uint32_t shift = 64 - length * 8;
+  return static_cast<int64_t>(slot << shift) >> shift;
+}
+
+// The number of bytes of the codes into a dictionary of the given size
+uint32_t CodeWidth(size_t dictionary_size) {
+  if (dictionary_size <= (size_t{1} << 8)) {
+    return 1;
+  }
+  if (dictionary_size <= (size_t{1} << 16)) {
+    return 2;
+  }
+  return 4;
+}
+
+void Pack(std::vector<uint64_t> &packed, uint32_t bit_width, oid_t index,
+          uint64_t value) {
+  if (bit_width == 0) {
+    return;
+  }
+  uint64_t bit = static_cast<uint64_t>(index) * bit_width;
+  uint64_t word = bit / 64, offset = bit % 64;
+  packed[word] |= value << offset;
+  if (offset + bit_width > 64) {
+    packed[word + 1] |= value >> (64 - offset);
+  }
+}
+
+}  // namespace
+
+CompressedTile::CompressedTile(const Tile &tile, oid_t tile_id,
+                               TileGroupHeader *tile_header,
+                               TileGroup *tile_group, oid_t num_tuples)
+    : Tile(BackendType::MM, tile_header, *tile.GetSchema(), tile_group,
+           tile.GetAllocatedTupleCount(), false),
+      num_tuples_(num_tuples),
+      pin_count_(0) {
+  PELOTON_ASSERT(num_tuples <= tile.GetAllocatedTupleCount());
+  database_id = tile_group->GetDatabaseId();
+  table_id = tile_group->GetTableId();
+  tile_group_id = tile_group->GetTileGroupId();
+  this->tile_id = tile_id;
+
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    CompressColumn(tile, column_id, num_tuples);
+  }
+
+  // The range of every column, which is what lets scans skip the tile group.
+  // We read the values back from this tile, because the variable-length
+  // values of the original tile die with it.
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    auto &column = columns_[column_id];
+    column.has_range = false;
+    for (oid_t tuple_offset = 0; tuple_offset < num_tuples; tuple_offset++) {
+      type::Value value = GetValue(tuple_offset, column_id);
+      if (value.IsNull()) {
+        continue;
+      }
+      if (!column.has_range) {
+        column.min = value;
+        column.max = value;
+        column.has_range = true;
+      } else if (value.CompareLessThan(column.min) == CmpBool::CmpTrue) {
+        column.min = value;
+      } else if (value.CompareGreaterThan(column.max) == CmpBool::CmpTrue) {
+        column.max = value;
+      }
+    }
+  }
+}
+
+CompressedTile::~CompressedTile() {
+  DecompressedTileCache::GetInstance().Remove(this);
+}
+
+void CompressedTile::CompressColumn(const Tile &tile, oid_t column_id,
+                                    oid_t num_tuples) {
+  columns_.emplace_back();
+  auto &column = columns_.back();
+  column.value_length = schema.GetColumn(column_id).GetFixedLength();
+  column.bit_width = 0;
+  column.base = 0;
+  column.code_width = 0;
+  column.null_code = INVALID_OID;
+
+  const type::TypeId type_id = schema.GetType(column_id);
+  const size_t offset = schema.GetOffset(column_id);
+  const uint32_t length = column.value_length;
+
+  // Variable-length values are always dictionary-encoded, by their contents.
+  // The dictionary is sorted, so that codes compare like the values they
+  // stand for, and the distinct long values are copied into our own pool.
+  column.is_varlen = IsVarlenType(type_id);
+  if (column.is_varlen) {
+    std::map<std::string, uint32_t> distinct;
+    bool has_null = false;
+    for (oid_t i = 0; i < num_tuples; i++) {
+      auto *slot = reinterpret_cast<const type::VarlenSlot *>(
+          tile.GetTupleLocation(i) + offset);
+      if (slot->IsNull()) {
+        has_null = true;
+      } else {
+        distinct.emplace(std::string{slot->GetData(), slot->length}, 0);
+      }
+    }
+
+    for (auto &entry : distinct) {
+      entry.second = column.varlen_dictionary.size();
+      column.varlen_dictionary.emplace_back();
+      type::VarlenSlot::Set(
+          reinterpret_cast<char *>(&column.varlen_dictionary.back()),
+          entry.first.data(), entry.first.size(), pool);
+      if (!column.varlen_dictionary.back().IsInlined()) {
+        uninlined_data_size += entry.first.size() + sizeof(uint32_t);
+      }
+    }
+    // NULL sorts last
+    if (has_null) {
+      column.null_code = column.varlen_dictionary.size();
+      column.varlen_dictionary.emplace_back();
+      type::VarlenSlot::SetNull(
+          reinterpret_cast<char *>(&column.varlen_dictionary.back()));
+    }
+
+    column.encoding = Encoding::DICTIONARY;
+    column.code_width = CodeWidth(column.varlen_dictionary.size());
+    // Pad the codes, so that every code can be read as a 4-byte integer (see
+    // GetCodes())
+    column.codes.resize(uint64_t{num_tuples} * column.code_width +
+                        sizeof(uint32_t) - 1);
+    for (oid_t i = 0; i < num_tuples; i++) {
+      auto *slot = reinterpret_cast<const type::VarlenSlot *>(
+          tile.GetTupleLocation(i) + offset);
+      uint32_t code =
+          slot->IsNull()
+              ? column.null_code
+              : distinct.find(std::string{slot->GetData(), slot->length})
+                    ->second;
+      // The codes are stored as little-endian integers of code_width bytes
+      PELOTON_MEMCPY(&column.codes[i * column.code_width], &code,
+                     column.code_width);
+    }
+    return;
+  }
+
+  // Values of an unusual width are kept as they are
+  if (length > sizeof(uint64_t) || (length & (length - 1)) != 0) {
+    column.encoding = Encoding::PLAIN;
+    column.plain.resize(num_tuples * length);
+    for (oid_t i = 0; i < num_tuples; i++) {
+      PELOTON_MEMCPY(&column.plain[i * length],
+                     tile.GetTupleLocation(i) + offset, length);
+    }
+    return;
+  }
+
+  std::vector<uint64_t> slots(num_tuples, 0);
+  for (oid_t i = 0; i < num_tuples; i++) {
+    PELOTON_MEMCPY(&slots[i], tile.GetTupleLocation(i) + offset, length);
+  }
+
+  // Collect the distinct values and assign each value its code
+  std::vector<uint32_t> codes(num_tuples);
+  {
+    std::unordered_map<uint64_t, uint32_t> distinct;
+    for (oid_t i = 0; i < num_tuples; i++) {
+      auto iter = distinct.find(slots[i]);
+      if (iter == distinct.end()) {
+        iter = distinct.emplace(slots[i], column.dictionary.size()).first;
+        column.dictionary.push_back(slots[i]);
+      }
+      codes[i] = iter->second;
+    }
+
+    // Pick the smallest encoding (all sizes in bits)
+    uint32_t code_width =
+        BitWidth(column.dictionary.empty() ? 0 : column.dictionary.size() - 1);
+    uint64_t plain_size = uint64_t{num_tuples} * length * 8;
+    uint64_t dictionary_size = column.dictionary.size() * 64 +
+                               uint64_t{num_tuples} * code_width;
+    uint64_t for_size = plain_size;
+
+    int64_t min = 0, max = 0;
+    if (IsIntegralType(type_id) && num_tuples > 0) {
+      min = max = SignExtend(slots[0], length);
+      for (oid_t i = 1; i < num_tuples; i++) {
+        int64_t value = SignExtend(slots[i], length);
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+      uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+      for_size = uint64_t{num_tuples} * BitWidth(range);
+    }
+
+    if (for_size < plain_size && for_size <= dictionary_size) {
+      column.encoding = Encoding::FRAME_OF_REFERENCE;
+      column.base = min;
+      column.bit_width = BitWidth(static_cast<uint64_t>(max) -
+                                  static_cast<uint64_t>(min));
+      column.dictionary.clear();
+      for (oid_t i = 0; i < num_tuples; i++) {
+        codes[i] = 0;
+      }
+      column.packed.resize(
+          (uint64_t{num_tuples} * column.bit_width + 63) / 64, 0);
+      for (oid_t i = 0; i < num_tuples; i++) {
+        Pack(column.packed, column.bit_width, i,
+             static_cast<uint64_t>(SignExtend(slots[i], length)) -
+                 static_cast<uint64_t>(min));
+      }
+      column.dictionary.shrink_to_fit();
+      return;
+    } else if (dictionary_size >= plain_size) {
+      column.encoding = Encoding::PLAIN;
+      column.dictionary.clear();
+      column.dictionary.shrink_to_fit();
+      column.plain.resize(num_tuples * length);
+      for (oid_t i = 0; i < num_tuples; i++) {
+        PELOTON_MEMCPY(&column.plain[i * length], &slots[i], length);
+      }
+      return;
+    }
+    column.encoding = Encoding::DICTIONARY;
+  }
+
+  // Bit-pack the dictionary codes
+  column.bit_width =
+      BitWidth(column.dictionary.empty() ? 0 : column.dictionary.size() - 1);
+  column.packed.resize((uint64_t{num_tuples} * column.bit_width + 63) / 64, 0);
+  for (oid_t i = 0; i < num_tuples; i++) {
+    Pack(column.packed, column.bit_width, i, codes[i]);
+  }
+}
+
+uint64_t CompressedTile::Unpack(const std::vector<uint64_t> &packed,
+                                uint32_t bit_width, oid_t index) {
+  if (bit_width == 0) {
+    return 0;
+  }
+  uint64_t bit = static_cast<uint64_t>(index) * bit_width;
+  uint64_t word = bit / 64, offset = bit % 64;
+  uint64_t value = packed[word] >> offset;
+  if (offset + bit_width > 64) {
+    value |= packed[word + 1] << (64 - offset);
+  }
+  return bit_width == 64 ? value : value & ((uint64_t{1} << bit_width) - 1);
+}
+
+uint64_t CompressedTile::DecodeSlot(const CompressedColumn &column,
+                                    oid_t tuple_offset) const {
+  switch (column.encoding) {
+    case Encoding::FRAME_OF_REFERENCE:
+      return static_cast<uint64_t>(column.base) +
+             Unpack(column.packed, column.bit_width, tuple_offset);
+    case Encoding::DICTIONARY:
+      return column.dictionary[Unpack(column.packed, column.bit_width,
+                                      tuple_offset)];
+    case Encoding::PLAIN: {
+      uint64_t slot = 0;
+      PELOTON_MEMCPY(&slot, &column.plain[tuple_offset * column.value_length],
+                     column.value_length);
+      return slot;
+    }
+  }
+  return 0;
+}
+
+type::Value CompressedTile::GetValue(const oid_t tuple_offset,
+                                     const oid_t column_id) {
+  PELOTON_ASSERT(column_id < columns_.size());
+  const auto &column = columns_[column_id];
+  const type::TypeId column_type = schema.GetType(column_id);
+  const bool is_inlined = schema.IsInlined(column_id);
+
+  if (column.encoding == Encoding::PLAIN) {
+    return type::Value::DeserializeFrom(
+        &column.plain[tuple_offset * column.value_length], column_type,
+        is_inlined);
+  }
+
+  if (column.is_varlen) {
+    const auto &slot =
+        column.varlen_dictionary[GetCode(column_id, tuple_offset)];
+    return type::Value::DeserializeFrom(reinterpret_cast<const char *>(&slot),
+                                        column_type, is_inlined);
+  }
+
+  // The stored bytes are the low bytes of the decoded slot
+  uint64_t slot = DecodeSlot(column, tuple_offset);
+  return type::Value::DeserializeFrom(reinterpret_cast<const char *>(&slot),
+                                      column_type, is_inlined);
+}
+
+type::Value CompressedTile::GetDictionaryValue(oid_t column_id,
+                                               uint32_t code) const {
+  const auto &column = columns_[column_id];
+  PELOTON_ASSERT(column.encoding == Encoding::DICTIONARY);
+  const type::TypeId column_type = schema.GetType(column_id);
+  const bool is_inlined = schema.IsInlined(column_id);
+  if (column.is_varlen) {
+    return type::Value::DeserializeFrom(
+        reinterpret_cast<const char *>(&column.varlen_dictionary[code]),
+        column_type, is_inlined);
+  }
+  return type::Value::DeserializeFrom(
+      reinterpret_cast<const char *>(&column.dictionary[code]), column_type,
+      is_inlined);
+}
+
+type::Value CompressedTile::GetValueFast(const oid_t tuple_offset,
+                                         const size_t column_offset,
+                                         UNUSED_ATTRIBUTE const type::TypeId
+                                             column_type,
+                                         UNUSED_ATTRIBUTE const bool
+                                             is_inlined) {
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    if (schema.GetOffset(column_id) == column_offset) {
+      return GetValue(tuple_offset, column_id);
+    }
+  }
+  PELOTON_ASSERT(false);
+  return type::Value();
+}
+
+void CompressedTile::DecodeColumn(oid_t column_id, oid_t start, oid_t end,
+                                  char *dest, size_t stride) const {
+  const auto &column = columns_[column_id];
+  const uint32_t length = column.value_length;
+
+  if (column.encoding == Encoding::PLAIN) {
+    for (oid_t i = start; i < end; i++, dest += stride) {
+      PELOTON_MEMCPY(dest, &column.plain[i * length], length);
+    }
+    return;
+  }
+
+  if (column.is_varlen) {
+    for (oid_t i = start; i < end; i++, dest += stride) {
+      const auto &slot = column.varlen_dictionary[GetCode(column_id, i)];
+      PELOTON_MEMCPY(dest, &slot, sizeof(type::VarlenSlot));
+    }
+    return;
+  }
+
+  for (oid_t i = start; i < end; i++, dest += stride) {
+    uint64_t slot = DecodeSlot(column, i);
+    PELOTON_MEMCPY(dest, &slot, length);
+  }
+}
+
+void CompressedTile::DecodeCodes(oid_t column_id, oid_t start, oid_t end,
+                                 uint32_t *dest) const {
+  const auto &column = columns_[column_id];
+  PELOTON_ASSERT(column.is_varlen);
+  const char *codes = &column.codes[start * column.code_width];
+  switch (column.code_width) {
+    case 1:
+      for (oid_t i = start; i < end; i++) {
+        *dest++ = static_cast<uint8_t>(*codes++);
+      }
+      break;
+    default:
+      for (oid_t i = start; i < end; i++, codes += column.code_width) {
+        uint32_t code = 0;
+        PELOTON_MEMCPY(&code, codes, column.code_width);
+        *dest++ = code;
+      }
+      break;
+  }
+}
+
+uint32_t CompressedTile::FindCode(oid_t column_id, const char *data,
+                                  uint32_t length) const {
+  const auto &column = columns_[column_id];
+  PELOTON_ASSERT(column.is_varlen);
+  uint32_t num_values = GetDictionarySize(column_id);
+  if (column.null_code != INVALID_OID) {
+    num_values--;
+  }
+
+  type::VarlenSlot key;
+  type::VarlenSlot::Set(reinterpret_cast<char *>(&key), data, length, nullptr);
+  auto *begin = column.varlen_dictionary.data();
+  auto *iter = std::lower_bound(
+      begin, begin + num_values, key,
+      [](const type::VarlenSlot &left, const type::VarlenSlot &right) {
+        return type::VarlenSlot::Compare(left, right) < 0;
+      });
+  delete[] key.GetArea();
+  return static_cast<uint32_t>(iter - begin);
+}
+
+bool CompressedTile::DictionaryContains(oid_t column_id, const char *data,
+                                        uint32_t length) const {
+  uint32_t num_values = GetDictionarySize(column_id);
+  if (GetNullCode(column_id) != INVALID_OID) {
+    num_values--;
+  }
+  uint32_t code = FindCode(column_id, data, length);
+  if (code >= num_values) {
+    return false;
+  }
+  const auto &entry = GetDictionaryEntry(column_id, code);
+  return entry.length == length &&
+         std::memcmp(entry.GetData(), data, length) == 0;
+}
+
+void CompressedTile::Decompress(char *dest) const {
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    DecodeColumn(column_id, 0, num_tuples_, dest + schema.GetOffset(column_id),
+                 tuple_length);
+  }
+}
+
+const char *CompressedTile::PinDecompressedData() const {
+  const size_t size = uint64_t{num_tuples_} * tuple_length;
+  bool decompressed = false;
+  const char *data;
+  {
+    std::lock_guard<std::mutex> lock(decompress_latch_);
+    if (decompressed_data_ == nullptr) {
+      decompressed_data_.reset(new char[size]);
+      Decompress(decompressed_data_.get());
+      decompressed = true;
+    }
+    pin_count_++;
+    data = decompressed_data_.get();
+  }
+
+  // The cache evicts other tiles, so we must not hold our latch here
+  auto &cache = DecompressedTileCache::GetInstance();
+  if (decompressed) {
+    cache.Admit(this, size);
+  } else {
+    cache.Touch(this);
+  }
+  return data;
+}
+
+void CompressedTile::UnpinDecompressedData() const {
+  std::lock_guard<std::mutex> lock(decompress_latch_);
+  PELOTON_ASSERT(pin_count_ > 0);
+  pin_count_--;
+}
+
+bool CompressedTile::EvictDecompressedData() const {
+  // The cache latch is held, so don't wait for a scan that is busy
+  // decompressing the tile
+  std::unique_lock<std::mutex> lock(decompress_latch_, std::try_to_lock);
+  if (!lock.owns_lock() || pin_count_ > 0) {
+    return false;
+  }
+  decompressed_data_.reset();
+  return true;
+}
+
+bool CompressedTile::GetColumnRange(oid_t column_id, type::Value &min,
+                                    type::Value &max) const {
+  const auto &column = columns_[column_id];
+  if (!column.has_range) {
+    return false;
+  }
+  min = column.min;
+  max = column.max;
+  return true;
+}
+
+size_t CompressedTile::GetCompressedSize() const {
+  size_t size = uninlined_data_size;
+  for (const auto &column : columns_) {
+    size += column.packed.size() * sizeof(uint64_t) +
+            column.dictionary.size() * sizeof(uint64_t) + column.plain.size() +
+            column.varlen_dictionary.size() * sizeof(type::VarlenSlot) +
+            column.codes.size();
+  }
+  return size;
+}
+
+const std::string CompressedTile::GetInfo() const {
+  std::ostringstream os;
+  os << "\tCompressed Tile [" << tile_id << "] ";
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    const auto &column = columns_[column_id];
+    os << schema.GetColumn(column_id).GetName() << ":";
+    switch (column.encoding) {
+      case Encoding::PLAIN:
+        os << "PLAIN";
+        break;
+      case Encoding::FRAME_OF_REFERENCE:
+        os << "FOR(" << column.bit_width << ")";
+        break;
+      case Encoding::DICTIONARY:
+        if (column.is_varlen) {
+          os << "DICT(" << column.varlen_dictionary.size() << ", "
+             << column.code_width * 8 << ")";
+        } else {
+          os << "DICT(" << column.dictionary.size() << ", " << column.bit_width
+             << ")";
+        }
+        break;
+    }
+    os << " ";
+  }
+  os << "size=" << GetCompressedSize();
+  return os.str();
+}
+
+//===--------------------------------------------------------------------===//
+// Decompressed Tile Cache
+//===--------------------------------------------------------------------===//
+
+DecompressedTileCache &DecompressedTileCache::GetInstance() {
+  static DecompressedTileCache decompressed_tile_cache;
+  return decompressed_tile_cache;
+}
+
+void DecompressedTileCache::Admit(const CompressedTile *tile, size_t size) {
+  const size_t limit =
+      static_cast<size_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::decompressed_tile_cache_size)) *
+      1024 * 1024;
+
+  std::lock_guard<std::mutex> lock(cache_latch_);
+
+  // The tile was evicted and decompressed again
+  auto iter = entries_.find(tile);
+  if (iter != entries_.end()) {
+    size_ -= iter->second->second;
+    lru_list_.erase(iter->second);
+  }
+  lru_list_.emplace_front(tile, size);
+  entries_[tile] = lru_list_.begin();
+  size_ += size;
+
+  // Evict the least recently used tiles, but never the one just admitted
+  auto victim = std::prev(lru_list_.end());
+  while (size_ > limit && victim != lru_list_.begin()) {
+    auto prev = std::prev(victim);
+    if (victim->first->EvictDecompressedData()) {
+      size_ -= victim->second;
+      entries_.erase(victim->first);
+      lru_list_.erase(victim);
+    }
+    victim = prev;
+  }
+}
+
+void DecompressedTileCache::Touch(const CompressedTile *tile) {
+  std::lock_guard<std::mutex> lock(cache_latch_);
+  auto iter = entries_.find(tile);
+  if (iter != entries_.end()) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+  }
+}
+
+void DecompressedTileCache::Remove(const CompressedTile *tile) {
+  std::lock_guard<std::mutex> lock(cache_latch_);
+  auto iter = entries_.find(tile);
+  if (iter != entries_.end()) {
+    size_ -= iter->second->second;
+    lru_list_.erase(iter->second);
+    entries_.erase(iter);
+  }
+}
+
+size_t DecompressedTileCache::GetSize() {
+  std::lock_guard<std::mutex> lock(cache_latch_);
+  return size_;
+}
+
+}  // namespace storage
+}  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
 #include <utility>
 
@@ -21,6 +22,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
@@ -114,6 +116,9 @@ DataTable::~DataTable() {
     auto oid = indirection_array->GetOid();
     catalog_manager.DropIndirectionArray(oid);
   }
+  for (auto indirection_array : bulk_load_indirection_arrays_) {
+    catalog_manager.DropIndirectionArray(indirection_array->GetOid());
+  }
   // AbstractTable cleans up the schema
 }
 
@@ -211,11 +216,18 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   // check if there are recycled tuple slots
   auto &gc_manager = gc::GCManagerFactory::GetInstance();
   auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
-  if (free_item_pointer.IsNull() == false) {
+  while (free_item_pointer.IsNull() == false) {
+    auto tile_group = storage::StorageManager::GetInstance()->GetTileGroup(
+        free_item_pointer.block);
+    // The tile group may have started draining, or even have been retired,
+    // since the GC checked it
+    if (tile_group == nullptr ||
+        tile_group->GetHeader()->IsDraining() == true) {
+      free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
+      continue;
+    }
     // when inserting a tuple
     if (tuple != nullptr) {
-      auto tile_group = storage::StorageManager::GetInstance()->GetTileGroup(
-          free_item_pointer.block);
       tile_group->CopyTuple(tuple, free_item_pointer.offset);
     }
     return free_item_pointer;
@@ -327,6 +339,15 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple,
 bool DataTable::InsertTuple(const AbstractTuple *tuple, ItemPointer location,
                             concurrency::TransactionContext *transaction,
                             ItemPointer **index_entry_ptr, bool check_fk) {
+  // another transaction is bulk loading the table
+  txn_id_t bulk_load_owner = bulk_load_owner_.load();
+  if (bulk_load_owner != INVALID_TXN_ID &&
+      (transaction == nullptr ||
+       bulk_load_owner != transaction->GetTransactionId())) {
+    LOG_TRACE("InsertTuple(): Table is locked for a bulk load");
+    return false;
+  }
+
   if (CheckConstraints(tuple) == false) {
     LOG_TRACE("InsertTuple(): Constraint violated");
     return false;
@@ -403,29 +424,7 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
                                 ItemPointer **index_entry_ptr) {
   int index_count = GetIndexCount();
 
-  size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
-
-  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
-
-  while (true) {
-    auto active_indirection_array =
-        active_indirection_arrays_[active_indirection_array_id];
-    indirection_offset = active_indirection_array->AllocateIndirection();
-
-    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
-          active_indirection_array->GetIndirectionByOffset(indirection_offset);
-      break;
-    }
-  }
-
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
-
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
-  }
+  *index_entry_ptr = AllocateIndirection(location);
 
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
@@ -477,6 +476,35 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
   return true;
 }
 
+ItemPointer *DataTable::AllocateIndirection(const ItemPointer &location) {
+  size_t active_indirection_array_id =
+      number_of_tuples_ % active_indirection_array_count_;
+
+  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+  ItemPointer *index_entry_ptr = nullptr;
+
+  while (true) {
+    auto active_indirection_array =
+        active_indirection_arrays_[active_indirection_array_id];
+    indirection_offset = active_indirection_array->AllocateIndirection();
+
+    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+      index_entry_ptr =
+          active_indirection_array->GetIndirectionByOffset(indirection_offset);
+      break;
+    }
+  }
+
+  index_entry_ptr->block = location.block;
+  index_entry_ptr->offset = location.offset;
+
+  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+    AddDefaultIndirectionArray(active_indirection_array_id);
+  }
+
+  return index_entry_ptr;
+}
+
 bool DataTable::InsertInSecondaryIndexes(
     const AbstractTuple *tuple, const TargetList *targets_ptr,
     concurrency::TransactionContext *transaction,
@@ -802,6 +830,7 @@ bool DataTable::CheckForeignKeyConstraints(
  */
 void DataTable::IncreaseTupleCount(const size_t &amount) {
   number_of_tuples_ += amount;
+  modification_count_ += amount;
   dirty_ = true;
 }
 
@@ -811,6 +840,7 @@ void DataTable::IncreaseTupleCount(const size_t &amount) {
  */
 void DataTable::DecreaseTupleCount(const size_t &amount) {
   number_of_tuples_ -= amount;
+  modification_count_ += amount;
   dirty_ = true;
 }
 
@@ -840,6 +870,201 @@ bool DataTable::IsDirty() const { return dirty_; }
  */
 void DataTable::ResetDirty() { dirty_ = false; }
 
+//===--------------------------------------------------------------------===//
+// BULK LOAD
+//===--------------------------------------------------------------------===//
+
+bool DataTable::IsEmpty() const {
+  for (size_t offset = 0; offset < GetTileGroupCount(); offset++) {
+    auto tile_group = GetTileGroup(offset);
+    if (tile_group != nullptr &&
+        tile_group->GetHeader()->GetCurrentNextTupleSlot() != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Take the bulk load lock for the transaction
+ *
+ * The lock is only granted on an empty table, and is released when the
+ * transaction ends.
+ *
+ * @param transaction the transaction performing the load
+ * @return false if the table isn't empty or another load holds the lock
+ */
+bool DataTable::LockForBulkLoad(concurrency::TransactionContext *transaction) {
+  txn_id_t owner = INVALID_TXN_ID;
+  if (bulk_load_owner_.compare_exchange_strong(
+          owner, transaction->GetTransactionId()) == false) {
+    return false;
+  }
+
+  // Inserts claim their slot before they check the lock, so any insert that
+  // got past the check shows up here
+  if (IsEmpty() == false) {
+    bulk_load_owner_ = INVALID_TXN_ID;
+    return false;
+  }
+
+  // Other writers must not get in before the loaded rows are committed or
+  // rolled back
+  txn_id_t txn_id = transaction->GetTransactionId();
+  transaction->AddOnEndAction([this, txn_id] { UnlockBulkLoad(txn_id); });
+  return true;
+}
+
+void DataTable::UnlockBulkLoad(txn_id_t txn_id) {
+  UNUSED_ATTRIBUTE txn_id_t owner = bulk_load_owner_.exchange(INVALID_TXN_ID);
+  PELOTON_ASSERT(owner == txn_id);
+}
+
+/**
+ * @brief Publish a batch of pre-populated tile groups
+ *
+ * The per-tuple insert path claims one slot at a time and inserts one entry
+ * into every index, traversing it from the root each time. Here, each index is
+ * instead handed all of its entries at once, which lets it sort them and
+ * build itself bottom-up (see Index::BulkLoad()). The tuples are still
+ * registered with the transaction through PerformInsert(), so they become
+ * visible when it commits and are rolled back if it aborts.
+ *
+ * @param tile_groups tile groups whose claimed slots hold the loaded tuples
+ * @param transaction the transaction performing the load, which must hold
+ * the bulk load lock
+ * @return false on an index or foreign key violation
+ */
+bool DataTable::BulkLoad(
+    const std::vector<std::shared_ptr<TileGroup>> &tile_groups,
+    concurrency::TransactionContext *transaction) {
+  PELOTON_ASSERT(bulk_load_owner_ == transaction->GetTransactionId());
+
+  // Check the constraints of all tuples before touching the table
+  std::vector<ItemPointer> locations;
+  for (const auto &tile_group : tile_groups) {
+    oid_t tile_group_id = tile_group->GetTileGroupId();
+    oid_t tuple_count = tile_group->GetHeader()->GetCurrentNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      ContainerTuple<TileGroup> tuple(tile_group.get(), tuple_id);
+      if (CheckConstraints(&tuple) == false ||
+          CheckForeignKeyConstraints(&tuple, transaction) == false) {
+        LOG_TRACE("BulkLoad(): Constraint violated");
+        return false;
+      }
+      locations.push_back(ItemPointer(tile_group_id, tuple_id));
+    }
+  }
+
+  // Build the indexes. The keys are kept around until all indexes are loaded
+  // so that we can back out of the indexes built so far on a violation. The
+  // indirections come from arrays of their own, which are only kept if the
+  // load succeeds.
+  std::vector<std::shared_ptr<IndirectionArray>> indirection_arrays;
+  std::vector<ItemPointer *> index_entries;
+  int index_count = GetIndexCount();
+  if (index_count > 0) {
+    auto &manager = catalog::Manager::GetInstance();
+    index_entries.reserve(locations.size());
+    for (const auto &location : locations) {
+      size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+      if (indirection_arrays.empty() == false) {
+        indirection_offset = indirection_arrays.back()->AllocateIndirection();
+      }
+      if (indirection_offset == INVALID_INDIRECTION_OFFSET) {
+        indirection_arrays.emplace_back(
+            new IndirectionArray(manager.GetNextIndirectionArrayId()));
+        indirection_offset = indirection_arrays.back()->AllocateIndirection();
+      }
+      ItemPointer *index_entry_ptr =
+          indirection_arrays.back()->GetIndirectionByOffset(
+              indirection_offset);
+      *index_entry_ptr = location;
+      index_entries.push_back(index_entry_ptr);
+    }
+  }
+
+  std::vector<std::shared_ptr<index::Index>> loaded_indexes;
+  std::vector<std::vector<std::unique_ptr<storage::Tuple>>> keys;
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr) continue;
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    std::vector<std::unique_ptr<storage::Tuple>> index_keys;
+    std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+    index_keys.reserve(locations.size());
+    entries.reserve(locations.size());
+    size_t tuple_itr = 0;
+    for (const auto &tile_group : tile_groups) {
+      oid_t tuple_count = tile_group->GetHeader()->GetCurrentNextTupleSlot();
+      for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+        ContainerTuple<TileGroup> tuple(tile_group.get(), tuple_id);
+        std::unique_ptr<storage::Tuple> key(
+            new storage::Tuple(index_schema, true));
+        key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+        entries.emplace_back(key.get(), index_entries[tuple_itr++]);
+        index_keys.push_back(std::move(key));
+      }
+    }
+
+    if (index->BulkLoad(entries) == false) {
+      LOG_TRACE("BulkLoad(): Index constraint violated on %s",
+                index->GetName().c_str());
+      // Remove the entries of the indexes we've already loaded
+      for (size_t loaded = 0; loaded < loaded_indexes.size(); loaded++) {
+        for (size_t i = 0; i < keys[loaded].size(); i++) {
+          loaded_indexes[loaded]->DeleteEntry(keys[loaded][i].get(),
+                                              index_entries[i]);
+        }
+      }
+      return false;
+    }
+    loaded_indexes.push_back(index);
+    keys.push_back(std::move(index_keys));
+  }
+
+  // The indexes point into the indirection arrays now
+  for (const auto &indirection_array : indirection_arrays) {
+    catalog::Manager::GetInstance().AddIndirectionArray(
+        indirection_array->GetOid(), indirection_array);
+    bulk_load_indirection_arrays_.push_back(indirection_array);
+  }
+
+  // Publish the tile groups. They are appended behind the active tile groups,
+  // which keep serving regular inserts. Until the tuples are registered with
+  // the transaction below, their headers make them invisible to everyone.
+  for (const auto &tile_group : tile_groups) {
+    oid_t tile_group_id = tile_group->GetTileGroupId();
+
+    tile_groups_.Append(tile_group_id);
+
+    storage::StorageManager::GetInstance()->AddTileGroup(tile_group_id,
+                                                         tile_group);
+
+    // we must guarantee that the compiler always add tile group before adding
+    // tile_group_count_.
+    COMPILER_MEMORY_FENCE;
+
+    tile_group_count_++;
+
+    LOG_TRACE("Recording bulk loaded tile group : %u ", tile_group_id);
+  }
+
+  // Register the tuples as inserts of the loading transaction, which takes
+  // care of their visibility, logging and rollback like for any other insert
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  for (size_t tuple_itr = 0; tuple_itr < locations.size(); tuple_itr++) {
+    txn_manager.PerformInsert(
+        transaction, locations[tuple_itr],
+        index_count > 0 ? index_entries[tuple_itr] : nullptr);
+  }
+
+  IncreaseTupleCount(locations.size());
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // TILE GROUP
 //===--------------------------------------------------------------------===//
@@ -988,6 +1213,21 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
   return storage_manager->GetTileGroup(tile_group_id);
 }
 
+void DataTable::DropTileGroup(const oid_t &tile_group_offset) {
+  PELOTON_ASSERT(tile_group_offset < GetTileGroupCount());
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  if (tile_group_id == invalid_tile_group_id) {
+    return;
+  }
+
+  // The offset stays taken, so that the offsets of the other tile groups
+  // don't change under concurrent scans
+  tile_groups_.Erase(tile_group_offset, invalid_tile_group_id);
+  storage::StorageManager::GetInstance()->DropTileGroup(tile_group_id);
+}
+
 void DataTable::DropTileGroups() {
   auto storage_manager = storage::StorageManager::GetInstance();
   auto tile_groups_size = tile_groups_.GetSize();
@@ -1212,6 +1452,9 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Get orig tile group from catalog
   auto storage_tilegroup = storage::StorageManager::GetInstance();
   auto tile_group = storage_tilegroup->GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
   auto diff = tile_group->GetLayout().GetLayoutDifference(*default_layout_);
 
   // Check threshold for transformation
@@ -1242,6 +1485,243 @@ storage::TileGroup *DataTable::TransformTileGroup(
   return new_tile_group.get();
 }
 
+// Whether every version in the tile group is committed, still current, and
+// visible to all running transactions
+static bool IsColdTileGroup(const storage::TileGroup *tile_group) {
+  auto *header = tile_group->GetHeader();
+  auto num_tuples = header->GetCurrentNextTupleSlot();
+  if (num_tuples < tile_group->GetAllocatedTupleCount()) {
+    return false;
+  }
+
+  auto expired_cid =
+      concurrency::EpochManagerFactory::GetInstance().GetExpiredCid();
+  for (oid_t tuple_id = 0; tuple_id < num_tuples; tuple_id++) {
+    if (header->GetTransactionId(tuple_id) != INITIAL_TXN_ID ||
+        header->GetEndCommitId(tuple_id) != MAX_CID ||
+        header->GetBeginCommitId(tuple_id) > expired_cid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+storage::TileGroup *DataTable::FreezeTileGroup(const oid_t &tile_group_offset) {
+  if (tile_group_offset >= tile_groups_.GetSize()) {
+    LOG_ERROR("Tile group offset not found in table : %u ", tile_group_offset);
+    return nullptr;
+  }
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  if (tile_group_id == invalid_tile_group_id) {
+    return nullptr;
+  }
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto tile_group = storage_manager->GetTileGroup(tile_group_id);
+  if (tile_group == nullptr || tile_group->IsFrozen() ||
+      !IsColdTileGroup(tile_group.get())) {
+    return nullptr;
+  }
+
+  // Seal the tile group before copying it, so that no transaction can take
+  // ownership of its tuples anymore. A transaction may have done so before we
+  // sealed it, in which case we keep the original (see
+  // TimestampOrderingTransactionManager::AcquireOwnership()).
+  auto *header = tile_group->GetHeader();
+  if (header->SetSealed() == false) {
+    return nullptr;
+  }
+  if (!IsColdTileGroup(tile_group.get())) {
+    header->ResetSealed();
+    return nullptr;
+  }
+
+  LOG_TRACE("Freezing tile group : %u", tile_group_offset);
+
+  std::shared_ptr<storage::TileGroup> frozen_tile_group(
+      TileGroupFactory::GetFrozenTileGroup(tile_group.get()));
+
+  storage_manager->AddTileGroup(tile_group_id, frozen_tile_group);
+
+  // The original stays sealed, so that transactions still holding on to it
+  // fail to modify it, and is released once none of them can read it anymore
+  gc::GCManagerFactory::GetInstance().RecycleTileGroup(std::move(tile_group));
+
+  return frozen_tile_group.get();
+}
+
+bool DataTable::MoveTuples(storage::TileGroup *tile_group,
+                           const std::vector<oid_t> &tuple_ids,
+                           cid_t &commit_id) {
+  auto *header = tile_group->GetHeader();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto column_count = schema->GetColumnCount();
+
+  for (auto tuple_id : tuple_ids) {
+    // The tuple may have been updated or deleted meanwhile
+    if (txn_manager.IsVisible(txn, header, tuple_id) != VisibilityType::OK ||
+        txn_manager.IsOwnable(txn, header, tuple_id) == false ||
+        txn_manager.AcquireOwnership(txn, header, tuple_id) == false) {
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      txn_manager.AbortTransaction(txn);
+      return false;
+    }
+
+    ItemPointer new_location = AcquireVersion();
+    if (new_location.IsNull() == true) {
+      txn_manager.YieldOwnership(txn, header, tuple_id);
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      txn_manager.AbortTransaction(txn);
+      return false;
+    }
+
+    auto new_tile_group =
+        storage::StorageManager::GetInstance()->GetTileGroup(
+            new_location.block);
+    for (oid_t column_id = 0; column_id < column_count; column_id++) {
+      auto value = tile_group->GetValue(tuple_id, column_id);
+      new_tile_group->SetValue(value, new_location.offset, column_id);
+    }
+
+    txn_manager.PerformUpdate(txn, ItemPointer(tile_group_id, tuple_id),
+                              new_location);
+  }
+
+  commit_id = txn->GetCommitId();
+  return txn_manager.CommitTransaction(txn) == ResultType::SUCCESS;
+}
+
+// Collect the live tuples of a full tile group. Returns false if the tile
+// group is not full yet or a running transaction owns one of its tuples.
+static bool GetLiveTuples(const storage::TileGroup *tile_group,
+                          std::vector<oid_t> &live_tuples) {
+  auto *header = tile_group->GetHeader();
+  auto num_slots = tile_group->GetAllocatedTupleCount();
+  if (header->GetCurrentNextTupleSlot() < num_slots) {
+    return false;
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < num_slots; tuple_id++) {
+    auto txn_id = header->GetTransactionId(tuple_id);
+    if (txn_id == INITIAL_TXN_ID) {
+      if (header->GetEndCommitId(tuple_id) == MAX_CID) {
+        live_tuples.push_back(tuple_id);
+      }
+    } else if (txn_id != INVALID_TXN_ID) {
+      return false;
+    }
+  }
+  return true;
+}
+
+cid_t DataTable::CompactTileGroup(const oid_t &tile_group_offset,
+                                  const double &max_occupancy) {
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr || tile_group->IsFrozen()) {
+    return INVALID_CID;
+  }
+
+  // Only full tile groups are compacted, as no new tuples go to them
+  auto *header = tile_group->GetHeader();
+  std::vector<oid_t> live_tuples;
+  if (header->GetImmutability() == true || header->IsDraining() == true ||
+      GetLiveTuples(tile_group.get(), live_tuples) == false ||
+      live_tuples.size() >
+          max_occupancy * tile_group->GetAllocatedTupleCount()) {
+    return INVALID_CID;
+  }
+
+  LOG_TRACE("Compacting tile group : %u", tile_group_offset);
+
+  // Keep the GC and inserts from reusing the free slots of the tile group
+  header->SetDraining();
+
+  cid_t commit_id = INVALID_CID;
+  if (MoveTuples(tile_group.get(), live_tuples, commit_id) == false) {
+    header->ResetDraining();
+    return INVALID_CID;
+  }
+
+  return commit_id;
+}
+
+oid_t DataTable::MigrateTileGroup(const oid_t &tile_group_offset,
+                                  const double &theta,
+                                  const size_t &batch_size) {
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr || tile_group->IsFrozen() ||
+      tile_group->GetLayout().GetLayoutDifference(*default_layout_) < theta) {
+    return INVALID_OID;
+  }
+
+  std::vector<oid_t> live_tuples;
+  if (GetLiveTuples(tile_group.get(), live_tuples) == false) {
+    return INVALID_OID;
+  }
+
+  // Keep the GC and the inserts from reusing the free slots of the tile group,
+  // so that it drains for good. An empty tile group must stay empty until it
+  // is retired.
+  tile_group->GetHeader()->SetDraining();
+  if (live_tuples.empty()) {
+    return 0;
+  }
+
+  LOG_TRACE("Migrating tile group : %u", tile_group_offset);
+
+  // A failed batch is retried the next time
+  auto batch_end = std::min(live_tuples.size(), batch_size);
+  std::vector<oid_t> batch(live_tuples.begin(),
+                           live_tuples.begin() + batch_end);
+  cid_t commit_id = INVALID_CID;
+  if (MoveTuples(tile_group.get(), batch, commit_id) == false) {
+    return live_tuples.size();
+  }
+
+  return live_tuples.size() - batch.size();
+}
+
+bool DataTable::RetireTileGroup(const oid_t &tile_group_offset) {
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  // Every version left must be dead to all running transactions
+  auto expired_cid =
+      concurrency::EpochManagerFactory::GetInstance().GetExpiredCid();
+  auto *header = tile_group->GetHeader();
+  auto num_tuples = header->GetCurrentNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < num_tuples; tuple_id++) {
+    auto txn_id = header->GetTransactionId(tuple_id);
+    if (txn_id == INVALID_TXN_ID) {
+      continue;
+    }
+    if (txn_id != INITIAL_TXN_ID ||
+        header->GetEndCommitId(tuple_id) > expired_cid) {
+      return false;
+    }
+  }
+
+  // The GC must also have unlinked the garbage versions of the tile group
+  // from the indexes and recycled them, as it can't once the tile group is
+  // gone. Their transactions count them before the versions look dead above.
+  if (header->GetGCPendingVersions() != 0) {
+    return false;
+  }
+
+  LOG_TRACE("Retiring tile group : %u", tile_group_offset);
+  DropTileGroup(tile_group_offset);
+
+  // Scans that started before may still hold on to it
+  gc::GCManagerFactory::GetInstance().RecycleTileGroup(std::move(tile_group));
+  return true;
+}
+
 void DataTable::RecordLayoutSample(const tuning::Sample &sample) {
   // Add layout sample
   {
@@ -17,8 +17,11 @@
 #include "common/logger.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
+#include "optimizer/stats/auto_analyzer.h"
 #include "storage/database.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group_compactor.h"
+#include "storage/tile_group_freezer.h"
 
 namespace peloton {
 namespace storage {
@@ -29,6 +32,9 @@ Database::~Database() {
   // Clean up all the tables
   LOG_TRACE("Deleting tables from database");
   for (auto table : tables) {
+    TileGroupFreezer::GetInstance().RemoveTable(table->GetOid());
+    TileGroupCompactor::GetInstance().RemoveTable(table->GetOid());
+    optimizer::AutoAnalyzer::GetInstance().RemoveTable(table->GetOid());
     delete table;
   }
 
@@ -49,6 +55,15 @@ void Database::AddTable(storage::DataTable *table, bool is_catalog) {
       auto *gc_manager = &gc::GCManagerFactory::GetInstance();
       assert(gc_manager != nullptr);
       gc_manager->RegisterTable(table->GetOid());
+
+      // Let the freezer compress the cold tile groups of the table
+      TileGroupFreezer::GetInstance().AddTable(table);
+
+      // Let the compactor reclaim the sparse tile groups of the table
+      TileGroupCompactor::GetInstance().AddTable(table);
+
+      // Let the auto analyzer refresh the stats of the table
+      optimizer::AutoAnalyzer::GetInstance().AddTable(table);
     }
   }
 }
@@ -75,6 +90,10 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     PELOTON_ASSERT(gc_manager != nullptr);
     gc_manager->DeregisterTable(table_oid);
 
+    TileGroupFreezer::GetInstance().RemoveTable(table_oid);
+    TileGroupCompactor::GetInstance().RemoveTable(table_oid);
+    optimizer::AutoAnalyzer::GetInstance().RemoveTable(table_oid);
+
     // Deregister table from Query Cache manager
     codegen::QueryCache::Instance().Remove(table_oid);
 
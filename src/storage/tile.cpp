@@ -32,6 +32,12 @@ namespace storage {
 Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
            const catalog::Schema &tuple_schema, TileGroup *tile_group,
            int tuple_count)
+    : Tile(backend_type, tile_header, tuple_schema, tile_group, tuple_count,
+           true) {}
+
+Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
+           const catalog::Schema &tuple_schema, TileGroup *tile_group,
+           int tuple_count, bool allocate_slots)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -50,18 +56,20 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       tile_group_header(tile_header) {
   PELOTON_ASSERT(tuple_count > 0);
 
-  tile_size = tuple_count * tuple_length;
+  tile_size = allocate_slots ? tuple_count * tuple_length : 0;
 
   // allocate tuple storage space for inlined data
   // auto &storage_manager = storage::StorageManager::GetInstance();
   // data = reinterpret_cast<char *>(
   // storage_manager.Allocate(backend_type, tile_size));
 
-  data = new char[tile_size];
-  PELOTON_ASSERT(data != NULL);
+  if (allocate_slots) {
+    data = new char[tile_size];
+    PELOTON_ASSERT(data != NULL);
 
-  // zero out the data
-  PELOTON_MEMSET(data, 0, tile_size);
+    // zero out the data
+    PELOTON_MEMSET(data, 0, tile_size);
+  }
 
   // allocate pool for blob storage if schema not inlined
   // if (schema.IsInlined() == false) {
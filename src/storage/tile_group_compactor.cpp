@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/storage/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/tile_group_compactor.h"
+
+#include <chrono>
+
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace storage {
+
+TileGroupCompactor &TileGroupCompactor::GetInstance() {
+  static TileGroupCompactor tile_group_compactor;
+  return tile_group_compactor;
+}
+
+void TileGroupCompactor::Start() {
+  compactor_stop_ = false;
+  compactor_thread_ = std::thread(&TileGroupCompactor::Running, this);
+  LOG_INFO("Started tile group compactor");
+}
+
+void TileGroupCompactor::Stop() {
+  if (compactor_stop_ == true) {
+    return;
+  }
+  compactor_stop_ = true;
+  compactor_thread_.join();
+  LOG_INFO("Stopped tile group compactor");
+}
+
+void TileGroupCompactor::Running() {
+  while (compactor_stop_ == false) {
+    CompactTables();
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+size_t TileGroupCompactor::CompactTables() {
+  size_t num_retired = 0;
+
+  // Holding the latch keeps the tables from being dropped under us
+  std::lock_guard<std::mutex> lock(compactor_mutex_);
+  for (auto &entry : tables_) {
+    auto *table = entry.second.table;
+    auto &compacted = entry.second.compacted;
+
+    // Retire the tile groups whose old versions no transaction can see anymore
+    auto expired_cid =
+        concurrency::EpochManagerFactory::GetInstance().GetExpiredCid();
+    std::vector<std::pair<oid_t, cid_t>> still_compacted;
+    for (auto &tile_group : compacted) {
+      if (tile_group.second > expired_cid) {
+        still_compacted.push_back(tile_group);
+      } else if (table->RetireTileGroup(tile_group.first)) {
+        LOG_TRACE("Retired tile group %u of table %u", tile_group.first,
+                  table->GetOid());
+        num_retired++;
+      } else {
+        auto tile_group_ptr = table->GetTileGroup(tile_group.first);
+        if (tile_group_ptr == nullptr) {
+          continue;
+        }
+        if (tile_group_ptr->GetHeader()->GetGCPendingVersions() != 0) {
+          // The GC has yet to recycle the old versions
+          still_compacted.push_back(tile_group);
+        } else {
+          // A recycled slot was reused while the tile group was being
+          // compacted, so let the tile group be compacted again
+          tile_group_ptr->GetHeader()->ResetDraining();
+        }
+      }
+    }
+    compacted.swap(still_compacted);
+
+    auto tile_group_count = table->GetTileGroupCount();
+    for (oid_t offset = 0; offset < tile_group_count; offset++) {
+      auto commit_id = table->CompactTileGroup(offset, max_occupancy_);
+      if (commit_id != INVALID_CID) {
+        LOG_TRACE("Compacted tile group %u of table %u", offset,
+                  table->GetOid());
+        compacted.emplace_back(offset, commit_id);
+      }
+    }
+  }
+
+  return num_retired;
+}
+
+void TileGroupCompactor::AddTable(DataTable *table) {
+  std::lock_guard<std::mutex> lock(compactor_mutex_);
+  tables_[table->GetOid()] = TableEntry{table, {}};
+}
+
+void TileGroupCompactor::RemoveTable(oid_t table_oid) {
+  std::lock_guard<std::mutex> lock(compactor_mutex_);
+  tables_.erase(table_oid);
+}
+
+void TileGroupCompactor::ClearTables() {
+  std::lock_guard<std::mutex> lock(compactor_mutex_);
+  tables_.clear();
+}
+
+}  // namespace storage
+}  // namespace peloton
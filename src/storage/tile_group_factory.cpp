@@ -12,6 +12,8 @@
 
 #include "storage/tile_group_factory.h"
 // #include "logging/logging_util.h"
+#include "storage/compressed_tile.h"
+#include "storage/storage_manager.h"
 #include "storage/tile_group_header.h"
 
 //===--------------------------------------------------------------------===//
@@ -49,5 +51,40 @@ TileGroup *TileGroupFactory::GetTileGroup(
   return tile_group;
 }
 
+TileGroup *TileGroupFactory::GetFrozenTileGroup(TileGroup *tile_group) {
+  BackendType backend_type = BackendType::MM;
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  auto *header = tile_group->GetHeader();
+
+  TileGroupHeader *tile_header = new TileGroupHeader(backend_type, tuple_count);
+
+  // The tiles are added below, so the tile group starts without any
+  TileGroup *frozen_tile_group = new TileGroup(
+      backend_type, tile_header, tile_group->GetAbstractTable(), {},
+      tile_group->tile_group_layout_, tuple_count);
+
+  frozen_tile_group->database_id = tile_group->GetDatabaseId();
+  frozen_tile_group->tile_group_id = tile_group->GetTileGroupId();
+  frozen_tile_group->table_id = tile_group->GetTableId();
+
+  auto num_tuples = header->GetCurrentNextTupleSlot();
+  auto *storage_manager = StorageManager::GetInstance();
+  for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount(); tile_itr++) {
+    std::shared_ptr<Tile> tile(new CompressedTile(
+        *tile_group->GetTile(tile_itr), storage_manager->GetNextTileId(),
+        tile_header, frozen_tile_group, num_tuples));
+    frozen_tile_group->tiles.push_back(tile);
+  }
+  frozen_tile_group->tile_count_ = frozen_tile_group->tiles.size();
+  frozen_tile_group->frozen_ = true;
+
+  // Copy the MVCC header, which also copies the back pointer to the tile group
+  *tile_header = *header;
+  tile_header->SetTileGroup(frozen_tile_group);
+  tile_header->SetImmutability();
+
+  return frozen_tile_group;
+}
+
 }  // namespace storage
 }  // namespace peloton
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.cpp
+//
+// Identification: src/storage/tile_group_freezer.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/tile_group_freezer.h"
+
+#include <chrono>
+
+#include "common/logger.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace storage {
+
+TileGroupFreezer &TileGroupFreezer::GetInstance() {
+  static TileGroupFreezer tile_group_freezer;
+  return tile_group_freezer;
+}
+
+void TileGroupFreezer::Start() {
+  freezer_stop_ = false;
+  freezer_thread_ = std::thread(&TileGroupFreezer::Running, this);
+  LOG_INFO("Started tile group freezer");
+}
+
+void TileGroupFreezer::Stop() {
+  if (freezer_stop_ == true) {
+    return;
+  }
+  freezer_stop_ = true;
+  freezer_thread_.join();
+  LOG_INFO("Stopped tile group freezer");
+}
+
+void TileGroupFreezer::Running() {
+  while (freezer_stop_ == false) {
+    FreezeTables();
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+size_t TileGroupFreezer::FreezeTables() {
+  size_t num_frozen = 0;
+
+  // Holding the latch keeps the tables from being dropped under us
+  std::lock_guard<std::mutex> lock(freezer_mutex_);
+  for (auto &entry : tables_) {
+    auto *table = entry.second.table;
+    auto tile_group_count = table->GetTileGroupCount();
+
+    // The tile groups are frozen in order, so we stop at the first one that
+    // is not cold yet and retry it next time
+    auto &offset = entry.second.next_offset;
+    for (; offset < tile_group_count; offset++) {
+      auto tile_group = table->GetTileGroup(offset);
+      if (tile_group == nullptr || tile_group->IsFrozen()) {
+        continue;
+      }
+      if (table->FreezeTileGroup(offset) == nullptr) {
+        break;
+      }
+      LOG_TRACE("Froze tile group %u of table %u", offset,
+                table->GetOid());
+      num_frozen++;
+    }
+  }
+
+  return num_frozen;
+}
+
+void TileGroupFreezer::AddTable(DataTable *table) {
+  std::lock_guard<std::mutex> lock(freezer_mutex_);
+  tables_[table->GetOid()] = TableEntry{table, 0};
+}
+
+void TileGroupFreezer::RemoveTable(oid_t table_oid) {
+  std::lock_guard<std::mutex> lock(freezer_mutex_);
+  tables_.erase(table_oid);
+}
+
+void TileGroupFreezer::ClearTables() {
+  std::lock_guard<std::mutex> lock(freezer_mutex_);
+  tables_.clear();
+}
+
+}  // namespace storage
+}  // namespace peloton
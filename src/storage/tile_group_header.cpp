@@ -53,6 +53,9 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
 
   // Initially immutabile flag to false initially.
   immutable = false;
+  sealed = false;
+  draining = false;
+  gc_pending_versions = 0;
 }
 
 //===--------------------------------------------------------------------===//
@@ -66,7 +69,8 @@ const std::string TileGroupHeader::GetInfo() const {
   os << "Address:" << this << ", ";
   os << "NumActiveTuples:";
   os << GetActiveTupleCount() << ", ";
-  os << "Immutable: " << GetImmutability();
+  os << "Immutable: " << GetImmutability() << ", ";
+  os << "Draining: " << IsDraining();
   os << ")";
   os << std::endl;
 
@@ -17,9 +17,12 @@
 #include "catalog/database_catalog.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "storage/compressed_tile.h"
 #include "storage/storage_manager.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace storage {
@@ -64,7 +67,10 @@ void ZoneMapManager::CreateZoneMapsForTable(
   for (size_t i = 0; i < num_tile_groups; i++) {
     auto tile_group = table->GetTileGroup(i);
     auto tile_group_ptr = tile_group.get();
-    PELOTON_ASSERT(tile_group_ptr != nullptr);
+    // Skip tile groups that were retired by compaction
+    if (tile_group_ptr == nullptr) {
+      continue;
+    }
     auto tile_group_header = tile_group_ptr->GetHeader();
     PELOTON_ASSERT(tile_group_header != nullptr);
     bool immutable = tile_group_header->GetImmutability();
@@ -217,6 +223,61 @@ ZoneMapManager::GetResultVectorAsZoneMap(
            GetValueAsOriginal(max_varchar, type_varchar)}));
 }
 
+/**
+ * @brief The function gets the zone map of a column of a frozen tile group
+ * from its compressed tiles
+ *
+ * @param tile_group The frozen tile group
+ * @param column_id The column of the table
+ *
+ * @return unique pointer to the column statistics, or nullptr if the column
+ * has no non-NULL value
+ */
+std::unique_ptr<ZoneMapManager::ColumnStatistics>
+ZoneMapManager::GetZoneMapFromTileGroup(storage::TileGroup *tile_group,
+                                        oid_t column_id) {
+  PELOTON_ASSERT(tile_group->IsFrozen());
+  oid_t tile_offset, tile_column_id;
+  tile_group->GetLayout().LocateTileAndColumn(column_id, tile_offset,
+                                              tile_column_id);
+  auto *tile = static_cast<storage::CompressedTile *>(
+      tile_group->GetTile(tile_offset));
+
+  type::Value min, max;
+  if (!tile->GetColumnRange(tile_column_id, min, max)) {
+    return nullptr;
+  }
+  return std::unique_ptr<ColumnStatistics>(new ColumnStatistics{min, max});
+}
+
+/**
+ * @brief The function checks whether the value is in the dictionary of a
+ * string column of a frozen tile group
+ *
+ * @param tile_group The frozen tile group
+ * @param column_id The column of the table
+ * @param value The value of an equality predicate on the column
+ *
+ * @return False if the column can't hold the value
+ */
+bool ZoneMapManager::DictionaryMayContain(storage::TileGroup *tile_group,
+                                          oid_t column_id,
+                                          const type::Value &value) {
+  PELOTON_ASSERT(tile_group->IsFrozen());
+  oid_t tile_offset, tile_column_id;
+  tile_group->GetLayout().LocateTileAndColumn(column_id, tile_offset,
+                                              tile_column_id);
+  auto *tile = static_cast<storage::CompressedTile *>(
+      tile_group->GetTile(tile_offset));
+  if (!tile->HasStringDictionary(tile_column_id) || value.IsNull() ||
+      (value.GetTypeId() != type::TypeId::VARCHAR &&
+       value.GetTypeId() != type::TypeId::VARBINARY)) {
+    return true;
+  }
+  return tile->DictionaryContains(tile_column_id, value.GetData(),
+                                  value.GetLength());
+}
+
 /**
  * The function compares the predicate against the zone map for the column
  * present in catalog.
@@ -231,6 +292,15 @@ ZoneMapManager::GetResultVectorAsZoneMap(
 bool ZoneMapManager::ShouldScanTileGroup(
     storage::PredicateInfo *parsed_predicates, int32_t num_predicates,
     storage::DataTable *table, int64_t tile_group_idx) {
+  std::shared_ptr<storage::TileGroup> tile_group;
+  if (num_predicates > 0) {
+    tile_group = table->GetTileGroup(tile_group_idx);
+  }
+  bool is_frozen = tile_group != nullptr && tile_group->IsFrozen();
+  if (!is_frozen && !ZoneMapTableExists()) {
+    return true;
+  }
+
   for (int32_t i = 0; i < num_predicates; i++) {
     // Extract the col_id, operator and predicate_value
     int col_id = parsed_predicates[i].col_id;
@@ -241,7 +311,9 @@ bool ZoneMapManager::ShouldScanTileGroup(
     oid_t table_id = table->GetOid();
 
     std::unique_ptr<ZoneMapManager::ColumnStatistics> stats =
-        GetZoneMapFromCatalog(database_id, table_id, tile_group_idx, col_id);
+        is_frozen ? GetZoneMapFromTileGroup(tile_group.get(), col_id)
+                  : GetZoneMapFromCatalog(database_id, table_id,
+                                          tile_group_idx, col_id);
 
     if (stats == nullptr) {
       return true;
@@ -251,6 +323,12 @@ bool ZoneMapManager::ShouldScanTileGroup(
         if (!CheckEqual(predicate_value, stats.get())) {
           return false;
         }
+        // The value may still be missing from the dictionary of a string
+        // column, which is cheaper to look up than to decompress the tiles
+        if (is_frozen &&
+            !DictionaryMayContain(tile_group.get(), col_id, predicate_value)) {
+          return false;
+        }
         break;
       case (int)ExpressionType::COMPARE_LESSTHAN:
         if (!CheckLessThan(predicate_value, stats.get())) {
@@ -278,6 +356,48 @@ bool ZoneMapManager::ShouldScanTileGroup(
   return true;
 }
 
+/**
+ * Checks whether a tile group may hold a value of an integral column within a
+ * range, e.g., the range of the join keys on the build side of a hash join.
+ * As in ShouldScanTileGroup, frozen tile groups are checked against their exact
+ * value ranges and all others against the zone maps in the catalog.
+ *
+ * @param table The table the tile group belongs to
+ * @param tile_group_idx The offset of the tile group in the table
+ * @param col_id The column the range is over
+ * @param min The lower bound of the range
+ * @param max The upper bound of the range
+ * @return False if no value of the column in the tile group is in the range
+ */
+bool ZoneMapManager::TileGroupOverlapsRange(storage::DataTable *table,
+                                            int64_t tile_group_idx,
+                                            int32_t col_id, int64_t min,
+                                            int64_t max) {
+  if (min > max) {
+    return false;
+  }
+
+  auto tile_group = table->GetTileGroup(tile_group_idx);
+  bool is_frozen = tile_group != nullptr && tile_group->IsFrozen();
+  if (!is_frozen && !ZoneMapTableExists()) {
+    return true;
+  }
+
+  std::unique_ptr<ZoneMapManager::ColumnStatistics> stats =
+      is_frozen ? GetZoneMapFromTileGroup(tile_group.get(), col_id)
+                : GetZoneMapFromCatalog(table->GetDatabaseOid(),
+                                        table->GetOid(), tile_group_idx,
+                                        col_id);
+  if (stats == nullptr) {
+    return true;
+  }
+
+  type::Value min_val = type::ValueFactory::GetBigIntValue(min);
+  type::Value max_val = type::ValueFactory::GetBigIntValue(max);
+  return stats->min.CompareLessThanEquals(max_val) == CmpBool::CmpTrue &&
+         stats->max.CompareGreaterThanEquals(min_val) == CmpBool::CmpTrue;
+}
+
 /**
  * Checks whether a zone map table in catalog was created.
  *
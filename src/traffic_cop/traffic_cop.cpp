@@ -16,6 +16,7 @@
 
 #include "binder/bind_node_visitor.h"
 #include "common/internal_types.h"
+#include "common/plan_cache.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "expression/expression_util.h"
@@ -248,7 +249,8 @@ void TrafficCop::ExecuteStatementPlanGetResult() {
 std::shared_ptr<Statement> TrafficCop::PrepareStatement(
     const std::string &stmt_name, const std::string &query_string,
     std::unique_ptr<parser::SQLStatementList> sql_stmt_list,
-    const size_t thread_id UNUSED_ATTRIBUTE) {
+    const size_t thread_id UNUSED_ATTRIBUTE,
+    std::vector<type::Value> *param_values) {
   LOG_TRACE("Prepare Statement query: %s", query_string.c_str());
 
   // Empty statement
@@ -312,6 +314,40 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
   // TODO(Tianyi) Move Statement Planing into Statement's method
   // to increase coherence
   try {
+    // Look for a plan of a query with the same fingerprint. A transaction
+    // that changed the catalog must plan against its own changes.
+    auto *txn = tcop_txn_state_.top().first;
+    auto &plan_cache = PlanCache::GetInstance();
+    std::string plan_cache_key;
+    std::shared_ptr<CachedPlan> cached_plan;
+    if (param_values != nullptr && !txn->IsCatalogModified() &&
+        settings::SettingsManager::GetBool(settings::SettingId::plan_cache)) {
+      plan_cache_key = PlanCache::GetKey(
+          query_string, default_database_name_,
+          statement->GetStmtParseTreeList()->GetStatement(0), *param_values);
+    }
+    if (!plan_cache_key.empty()) {
+      cached_plan = plan_cache.Find(plan_cache_key, txn->GetCatalogVersion());
+      auto plan = cached_plan != nullptr ? cached_plan->Acquire() : nullptr;
+      if (plan != nullptr) {
+        LOG_TRACE("Reusing cached plan");
+        statement->SetPlanTree(plan);
+        statement->SetReferencedTables(cached_plan->GetReferencedTables());
+        statement->SetTupleDescriptor(cached_plan->GetTupleDescriptor());
+        return statement;
+      }
+    }
+
+    // Only a query that was seen before is planned for sharing. A one-off
+    // query is planned with its own constants, for the optimizer to estimate
+    // its selectivity from.
+    if (cached_plan != nullptr) {
+      PlanCache::LiftConstants(
+          statement->GetStmtParseTreeList()->GetStatement(0));
+    } else if (param_values != nullptr) {
+      param_values->clear();
+    }
+
     // Run binder
     auto bind_node_visitor = binder::BindNodeVisitor(
         tcop_txn_state_.top().first, default_database_name_);
@@ -332,6 +368,20 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
       statement->SetTupleDescriptor(tuple_descriptor);
       LOG_TRACE("select query, finish setting");
     }
+
+    // Share the plan. All instances of it are busy if there already is a
+    // cached plan, so this plan becomes another instance. Otherwise the key
+    // is registered, without the plan of this query's constants.
+    if (!plan_cache_key.empty()) {
+      if (cached_plan == nullptr) {
+        plan_cache.Insert(plan_cache_key,
+                          std::make_shared<CachedPlan>(
+                              txn->GetCatalogVersion(), table_oids,
+                              statement->GetTupleDescriptor()));
+      } else {
+        statement->SetPlanTree(cached_plan->Wrap(plan));
+      }
+    }
   } catch (Exception &e) {
     error_message_ = e.what();
     ProcessInvalidStatement();
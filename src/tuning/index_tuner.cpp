@@ -102,30 +102,46 @@ void IndexTuner::BuildIndex(storage::DataTable *table,
   auto indexed_columns = index_schema->GetIndexedColumns();
   std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
 
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
   while (index_tile_group_offset < table_tile_group_count &&
          (tile_groups_indexed < tile_groups_indexed_per_iteration)) {
     std::unique_ptr<storage::Tuple> tuple_ptr(
         new storage::Tuple(table_schema, true));
 
     auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
+    // Skip tile groups that were retired by compaction
+    if (tile_group == nullptr) {
+      index_tile_group_offset++;
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+    // The index frees its nodes once no transaction can reach them anymore
+    // (see GCManager::RegisterIndex()), so only access it from within one.
+    // Every tile group gets its own, so that the GC is not held up for long.
+    auto txn = txn_manager.BeginTransaction();
     for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      // Index entries point to the indirection of the version chain, like
+      // those of DataTable::InsertInIndexes()
+      ItemPointer *index_entry_ptr =
+          tile_group_header->GetIndirection(tuple_id);
+      if (index_entry_ptr == nullptr) {
+        continue;
+      }
+
       // Setup container tuple
       ContainerTuple<storage::TileGroup> container_tuple(tile_group.get(),
                                                          tuple_id);
 
-      // Set the location
-      ItemPointer location(tile_group_id, tuple_id);
-
       // Set the key
       key->SetFromTuple(&container_tuple, indexed_columns, index->GetPool());
 
       // Insert in specific index
-      // TODO: Allocate itempointer ?
-      index->InsertEntry(key.get(), &location);
+      index->InsertEntry(key.get(), index_entry_ptr);
     }
+    txn_manager.CommitTransaction(txn);
 
     // Update indexed tile group offset (set of tgs indexed)
     index->IncrementIndexedTileGroupOffset();
@@ -92,6 +92,19 @@ bool LayoutTuner::UpdateDefaultPartition(storage::DataTable *table) {
     return false;
   }
 
+  // Track the share of updates, which throttles the migration
+  double total_weight = 0, update_weight = 0;
+  for (auto &sample : samples) {
+    total_weight += sample.GetWeight();
+    if (sample.GetSampleType() == SampleType::UPDATE) {
+      update_weight += sample.GetWeight();
+    }
+  }
+  if (total_weight > 0) {
+    migration_states[table->GetOid()].update_ratio =
+        update_weight / total_weight;
+  }
+
   for (auto sample : samples) {
     if (sample.GetColumnsAccessed().size() == 0) {
       continue;
@@ -131,18 +144,58 @@ bool LayoutTuner::UpdateDefaultPartition(storage::DataTable *table) {
   return true;
 }
 
+size_t LayoutTuner::MigrateTileGroups(storage::DataTable *table) {
+  auto &state = migration_states[table->GetOid()];
+  size_t num_retired = 0;
+
+  // Retire the drained tile groups once no transaction can see their old
+  // versions anymore
+  for (auto itr = state.drained_offsets.begin();
+       itr != state.drained_offsets.end();) {
+    if (table->RetireTileGroup(*itr)) {
+      LOG_TRACE("Retired tile group %u of table %u", *itr, table->GetOid());
+      num_retired++;
+      itr = state.drained_offsets.erase(itr);
+    } else if (table->GetTileGroup(*itr) == nullptr) {
+      itr = state.drained_offsets.erase(itr);
+    } else {
+      itr++;
+    }
+  }
+
+  // Back off while the workload is dominated by updates
+  size_t batch_size = migration_batch_size * (1 - state.update_ratio);
+  if (batch_size == 0) {
+    return num_retired;
+  }
+
+  // Move a single batch per round, starting over once all tile groups were
+  // visited, as the default layout keeps changing
+  auto tile_group_count = table->GetTileGroupCount();
+  auto &offset = state.tile_group_offset;
+  for (; offset < tile_group_count; offset++) {
+    auto tuples_left = table->MigrateTileGroup(offset, theta, batch_size);
+    if (tuples_left == 0) {
+      state.drained_offsets.insert(offset);
+    } else if (tuples_left != INVALID_OID) {
+      break;
+    }
+  }
+  if (offset >= tile_group_count) {
+    offset = 0;
+  }
+
+  return num_retired;
+}
+
 void LayoutTuner::Tune() {
   Timer<std::milli> timer;
   // Continue till signal is not false
   while (layout_tuning_stop == false) {
     // Go over all tables
     for (auto table : tables) {
-      // Transform
-      auto tile_group_count = table->GetTileGroupCount();
-      auto tile_group_offset = rand() % tile_group_count;
-
-      LOG_TRACE("Transforming tile group at offset: %lu", tile_group_offset);
-      table->TransformTileGroup(tile_group_offset, theta);
+      // Transform the existing tile groups incrementally
+      MigrateTileGroups(table);
 
       // Update partitioning periodically
       // TODO Lin/Tianyu - Add Failure Handling/Retry logic.
@@ -177,6 +230,7 @@ void LayoutTuner::ClearTables() {
   {
     std::lock_guard<std::mutex> lock(layout_tuner_mutex);
     tables.clear();
+    migration_states.clear();
   }
 }
 
@@ -83,7 +83,13 @@ Value TimestampType::Max(const Value& left, const Value& right) const {
 std::string TimestampType::ToString(const Value& val) const {
   if (val.IsNull())
     return "timestamp_null";
-  uint64_t tm = val.value_.timestamp;
+  char str[kMaxStringLength];
+  uint32_t len = FormatTo(val.value_.timestamp, str);
+  return std::string(str, len);
+}
+
+uint32_t TimestampType::FormatTo(uint64_t timestamp, char *buf) {
+  uint64_t tm = timestamp;
   uint32_t micro = tm % 1000000;
   tm /= 1000000;
   uint32_t second = tm % 100000;
@@ -101,20 +107,10 @@ std::string TimestampType::ToString(const Value& val) const {
   uint16_t day = tm % 32;
   tm /= 32;
   uint16_t month = tm;
-  char str[30];
-  char zone[5];
-  sprintf(str, "%04d-%02d-%02d %02d:%02d:%02d.%06d",
-    year, month, day, hour, min, sec, micro);
-  if(tz >= 0) {
-    str[26] = '+';
-  }
-  else
-    str[26] = '-';
-  if (tz < 0)
-    tz = -tz;
-  sprintf(zone, "%02d", tz);
-  str[27] = 0;
-  return std::string(std::string(str) + std::string(zone));
+  int len = snprintf(buf, kMaxStringLength,
+    "%04d-%02d-%02d %02d:%02d:%02d.%06d%c%02d", year, month, day, hour, min,
+    sec, micro, (tz >= 0 ? '+' : '-'), (tz < 0 ? -tz : tz));
+  return static_cast<uint32_t>(len);
 }
 
 // Compute a hash value
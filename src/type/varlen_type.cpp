@@ -17,6 +17,7 @@
 #include "type/type_util.h"
 #include "type/value_factory.h"
 #include "type/abstract_pool.h"
+#include "type/varlen_slot.h"
 
 namespace peloton {
 namespace type {
@@ -50,9 +51,9 @@ const char *VarlenType::GetData(const Value &val) const {
 uint32_t VarlenType::GetLength(const Value &val) const { return val.size_.len; }
 
 // Access the raw varlen data stored from the tuple storage
+// (i.e., the pool area of a long value, or nullptr if there is none)
 char *VarlenType::GetData(char *storage) {
-  char *ptr = *reinterpret_cast<char **>(storage);
-  return ptr;
+  return reinterpret_cast<const VarlenSlot *>(storage)->GetArea();
 }
 
 CmpBool VarlenType::CompareEquals(const Value &left, const Value &right) const {
@@ -173,29 +174,24 @@ void VarlenType::SerializeTo(const Value &val, char *storage,
                              bool inlined UNUSED_ATTRIBUTE,
                              AbstractPool *pool) const {
   uint32_t len = GetLength(val);
-  char *data;
   if (len == PELOTON_VALUE_NULL) {
-    data = nullptr;
+    VarlenSlot::SetNull(storage);
   } else {
-    uint32_t size = len + sizeof(uint32_t);
-    data = (pool == nullptr) ? new char[size] : (char *)pool->Allocate(size);
-    PELOTON_MEMCPY(data, &len, sizeof(uint32_t));
-    PELOTON_MEMCPY(data + sizeof(uint32_t), val.value_.varlen,
-              size - sizeof(uint32_t));
+    VarlenSlot::Set(storage, val.value_.varlen, len, pool);
   }
-  *reinterpret_cast<const char **>(storage) = data;
 }
 
 // Deserialize a value of the given type from the given storage space.
 Value VarlenType::DeserializeFrom(const char *storage,
                                   const bool inlined UNUSED_ATTRIBUTE,
                                   AbstractPool *pool UNUSED_ATTRIBUTE) const {
-  const char *ptr = *reinterpret_cast<const char *const *>(storage);
-  if (ptr == nullptr) {
+  auto *slot = reinterpret_cast<const VarlenSlot *>(storage);
+  if (slot->IsNull()) {
     return Value(type_id_, nullptr, 0, false);
   }
-  uint32_t len = *reinterpret_cast<const uint32_t *>(ptr);
-  return Value(type_id_, ptr + sizeof(uint32_t), len, false);
+  // A short value lives in the slot, which may be overwritten while the value
+  // is still in use, so it gets its own copy
+  return Value(type_id_, slot->GetData(), slot->length, slot->IsInlined());
 }
 Value VarlenType::DeserializeFrom(SerializeInput &in UNUSED_ATTRIBUTE,
                                   AbstractPool *pool UNUSED_ATTRIBUTE) const {
@@ -12,6 +12,8 @@
 
 #include "util/file.h"
 
+#include <sys/mman.h>
+
 #include "util/string_util.h"
 
 namespace peloton {
@@ -24,7 +26,7 @@ void File::Open(const std::string &name, File::AccessMode access_mode) {
   int flags;
   switch (access_mode) {
     case AccessMode::ReadOnly: {
-      flags = O_RDWR;
+      flags = O_RDONLY;
       break;
     }
     case AccessMode::WriteOnly: {
@@ -114,6 +116,30 @@ uint64_t File::Size() const {
   return static_cast<uint64_t>(off);
 }
 
+const char *File::Map(uint64_t len) const {
+  // Ensure open
+  PELOTON_ASSERT(IsOpen() && len > 0);
+
+  // Perform mapping
+  void *addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd_, 0);
+
+  // Check error
+  if (addr == MAP_FAILED) {
+    throw Exception(
+        StringUtil::Format("unable to map file: %s", strerror(errno)));
+  }
+
+  // The contents are (mostly) read front-to-back, let the kernel read ahead
+  madvise(addr, len, MADV_SEQUENTIAL);
+
+  // Done
+  return static_cast<const char *>(addr);
+}
+
+void File::Unmap(const char *addr, uint64_t len) {
+  munmap(const_cast<char *>(addr), len);
+}
+
 void File::Close() {
   if (IsOpen()) {
     close(fd_);
@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// global_catalog_cache_test.cpp
+//
+// Identification: test/catalog/global_catalog_cache_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/catalog.h"
+#include "catalog/column.h"
+#include "catalog/global_catalog_cache.h"
+#include "catalog/table_catalog.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Global Catalog Cache Tests
+//===--------------------------------------------------------------------===//
+
+class GlobalCatalogCacheTests : public PelotonTest {};
+
+TEST_F(GlobalCatalogCacheTests, KeyTest) {
+  std::vector<oid_t> columns{0, 1};
+  auto key = catalog::GlobalCatalogCache::GetKey(
+      1, 2, 0, columns, {type::ValueFactory::GetVarcharValue("ab"),
+                         type::ValueFactory::GetVarcharValue("c")});
+
+  // The values are not simply concatenated
+  EXPECT_NE(key, catalog::GlobalCatalogCache::GetKey(
+                     1, 2, 0, columns,
+                     {type::ValueFactory::GetVarcharValue("a"),
+                      type::ValueFactory::GetVarcharValue("bc")}));
+  EXPECT_NE(key, catalog::GlobalCatalogCache::GetKey(
+                     1, 2, 1, columns,
+                     {type::ValueFactory::GetVarcharValue("ab"),
+                      type::ValueFactory::GetVarcharValue("c")}));
+  EXPECT_EQ(key, catalog::GlobalCatalogCache::GetKey(
+                     1, 2, 0, columns,
+                     {type::ValueFactory::GetVarcharValue("ab"),
+                      type::ValueFactory::GetVarcharValue("c")}));
+}
+
+TEST_F(GlobalCatalogCacheTests, VersionTest) {
+  catalog::GlobalCatalogCache cache;
+  auto old_version = cache.GetVersion();
+  cache.Insert("old", old_version, {});
+  EXPECT_NE(nullptr, cache.Find("old", old_version));
+
+  // Nothing is cached or found while a catalog change becomes visible
+  cache.BeginChange();
+  auto changing_version = cache.GetVersion();
+  EXPECT_EQ(nullptr, cache.Find("old", old_version));
+  cache.Insert("changing", changing_version, {});
+  EXPECT_EQ(nullptr, cache.Find("changing", changing_version));
+  cache.Invalidate();
+  EXPECT_EQ(nullptr, cache.Find("changing", changing_version));
+
+  // A transaction that began before the change can't use the results read
+  // after it, nor the other way around
+  auto new_version = cache.GetVersion();
+  EXPECT_LT(changing_version, new_version);
+  cache.Insert("new", new_version, {});
+  EXPECT_NE(nullptr, cache.Find("new", new_version));
+  EXPECT_EQ(nullptr, cache.Find("new", old_version));
+  cache.Insert("old", old_version, {});
+  EXPECT_EQ(nullptr, cache.Find("old", new_version));
+}
+
+TEST_F(GlobalCatalogCacheTests, InvalidationTest) {
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->Bootstrap();
+  auto &global_cache = catalog::GlobalCatalogCache::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  catalog->CreateDatabase(txn, "cache_db");
+  auto id_column = catalog::Column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "id", true);
+  std::unique_ptr<catalog::Schema> table_schema(
+      new catalog::Schema({id_column}));
+  catalog->CreateTable(txn, "cache_db", DEFAULT_SCHEMA_NAME,
+                       std::move(table_schema), "cache_table", false);
+  txn_manager.CommitTransaction(txn);
+
+  // The first lookup fills the cache
+  auto version = global_cache.GetVersion();
+  txn = txn_manager.BeginTransaction();
+  auto table_object = catalog->GetTableCatalogEntry(
+      txn, "cache_db", DEFAULT_SCHEMA_NAME, "cache_table");
+  oid_t table_oid = table_object->GetTableOid();
+  txn_manager.CommitTransaction(txn);
+  auto cache_size = global_cache.GetSize();
+  EXPECT_LT(0, cache_size);
+
+  // Another transaction reads the same results
+  txn = txn_manager.BeginTransaction();
+  table_object = catalog->GetTableCatalogEntry(
+      txn, "cache_db", DEFAULT_SCHEMA_NAME, "cache_table");
+  EXPECT_EQ(table_oid, table_object->GetTableOid());
+  EXPECT_EQ(1, table_object->GetColumnCatalogEntries().size());
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(version, global_cache.GetVersion());
+
+  // Dropping the table invalidates the cache, but not before the dropping
+  // transaction ends
+  txn = txn_manager.BeginTransaction();
+  catalog->DropTable(txn, "cache_db", DEFAULT_SCHEMA_NAME, "cache_table");
+  EXPECT_EQ(version, global_cache.GetVersion());
+  EXPECT_THROW(catalog->GetTableCatalogEntry(txn, "cache_db",
+                                             DEFAULT_SCHEMA_NAME,
+                                             "cache_table"),
+               CatalogException);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_LT(version, global_cache.GetVersion());
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_THROW(catalog->GetTableCatalogEntry(txn, "cache_db",
+                                             DEFAULT_SCHEMA_NAME,
+                                             "cache_table"),
+               CatalogException);
+  catalog->DropDatabaseWithName(txn, "cache_db");
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
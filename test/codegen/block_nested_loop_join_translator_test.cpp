@@ -54,7 +54,8 @@ class BlockNestedLoopJoinTranslatorTest : public PelotonCodeGenTest {
   void PerformTest(ExpressionPtr &&predicate,
                    const std::vector<oid_t> &left_join_cols,
                    const std::vector<oid_t> &right_join_cols,
-                   std::vector<codegen::WrappedTuple> &results);
+                   std::vector<codegen::WrappedTuple> &results,
+                   JoinType join_type = JoinType::INNER);
 
   type::Value GetCol(const AbstractTuple &t, JoinOutputColPos p);
 };
@@ -62,24 +63,30 @@ class BlockNestedLoopJoinTranslatorTest : public PelotonCodeGenTest {
 void BlockNestedLoopJoinTranslatorTest::PerformTest(
     ExpressionPtr &&predicate, const std::vector<oid_t> &left_join_cols,
     const std::vector<oid_t> &right_join_cols,
-    std::vector<codegen::WrappedTuple> &results) {
-  // Output all columns
-  DirectMapList direct_map_list = {{0, std::make_pair(0, 0)},
-                                   {1, std::make_pair(0, 1)},
-                                   {2, std::make_pair(0, 2)},
-                                   {3, std::make_pair(1, 0)},
-                                   {4, std::make_pair(1, 1)},
-                                   {5, std::make_pair(1, 2)}};
+    std::vector<codegen::WrappedTuple> &results, JoinType join_type) {
+  // Output all columns, except for semi and anti joins which only produce the
+  // columns of the left side
+  bool left_only = join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+  DirectMapList direct_map_list;
+  std::vector<catalog::Column> columns;
+  std::vector<oid_t> output_cols;
+  for (oid_t side = 0; side < (left_only ? 1 : 2); side++) {
+    for (oid_t col_id = 0; col_id < 3; col_id++) {
+      oid_t output_col = static_cast<oid_t>(output_cols.size());
+      direct_map_list.push_back({output_col, std::make_pair(side, col_id)});
+      columns.push_back(GetTestColumn(col_id));
+      output_cols.push_back(output_col);
+    }
+  }
   std::unique_ptr<planner::ProjectInfo> projection{
       new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
 
   // Output schema
-  auto schema = std::shared_ptr<const catalog::Schema>(new catalog::Schema(
-      {GetTestColumn(0), GetTestColumn(1), GetTestColumn(2), GetTestColumn(0),
-       GetTestColumn(1), GetTestColumn(2)}));
+  auto schema =
+      std::shared_ptr<const catalog::Schema>(new catalog::Schema(columns));
 
   PlanPtr nlj_plan{new planner::NestedLoopJoinPlan(
-      JoinType::INNER, std::move(predicate), std::move(projection), schema,
+      join_type, std::move(predicate), std::move(projection), schema,
       left_join_cols, right_join_cols)};
 
   PlanPtr left_scan{
@@ -95,7 +102,7 @@ void BlockNestedLoopJoinTranslatorTest::PerformTest(
   nlj_plan->PerformBinding(context);
 
   // We collect the results of the query into an in-memory buffer
-  codegen::BufferingConsumer buffer{{0, 1, 2, 3, 4, 5}, context};
+  codegen::BufferingConsumer buffer{output_cols, context};
 
   // COMPILE and run
   CompileAndExecute(*nlj_plan, buffer);
@@ -268,5 +275,118 @@ TEST_F(BlockNestedLoopJoinTranslatorTest, NonEqualityJoin) {
   }
 }
 
+TEST_F(BlockNestedLoopJoinTranslatorTest, NonInnerJoins) {
+  // Every left tuple has exactly one partner among the right tuples, whose A
+  // values are the same as those of the left tuples for the first 20 rows
+  auto make_predicate = [this]() {
+    bool left_side = true;
+    auto left_a_col = ColRefExpr(type::TypeId::INTEGER, left_side, 0);
+    auto right_a_col = ColRefExpr(type::TypeId::INTEGER, !left_side, 0);
+    return CmpEqExpr(std::move(left_a_col), std::move(right_a_col));
+  };
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 LEFT OUTER JOIN table2 ON table1.A = table2.A");
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(make_predicate(), {0}, {0}, results, JoinType::LEFT);
+    EXPECT_EQ(20, results.size());
+  }
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 RIGHT OUTER JOIN table2 ON table1.A = table2.A");
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(make_predicate(), {0}, {0}, results, JoinType::RIGHT);
+
+    // All right tuples are produced, those without a partner with NULL values
+    // for the left side
+    EXPECT_EQ(80, results.size());
+    uint32_t num_null_padded = 0;
+    for (const auto &t : results) {
+      auto a1 = GetCol(t, JoinOutputColPos::Table1_ColA);
+      auto a2 = GetCol(t, JoinOutputColPos::Table2_ColA);
+      if (a1.IsNull()) {
+        num_null_padded++;
+      } else {
+        EXPECT_TRUE(a1.CompareEquals(a2) == CmpBool::CmpTrue);
+      }
+    }
+    EXPECT_EQ(60, num_null_padded);
+  }
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 FULL OUTER JOIN table2 ON table1.A = table2.B");
+    bool left_side = true;
+    auto left_a_col = ColRefExpr(type::TypeId::INTEGER, left_side, 0);
+    auto right_b_col = ColRefExpr(type::TypeId::INTEGER, !left_side, 1);
+    auto left_a_eq_right_b =
+        CmpEqExpr(std::move(left_a_col), std::move(right_b_col));
+
+    // Nothing matches, so every tuple of either side is produced on its own
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(std::move(left_a_eq_right_b), {0}, {1}, results,
+                JoinType::OUTER);
+    EXPECT_EQ(100, results.size());
+  }
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 WHERE EXISTS "
+        "(SELECT * FROM table2 WHERE table1.A = table2.A)");
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(make_predicate(), {0}, {0}, results, JoinType::SEMI);
+    EXPECT_EQ(20, results.size());
+  }
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 WHERE NOT EXISTS "
+        "(SELECT * FROM table2 WHERE table1.A = table2.A)");
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(make_predicate(), {0}, {0}, results, JoinType::ANTI);
+    EXPECT_EQ(0, results.size());
+  }
+
+  // Every left tuple but the first (with A = 0) has many partners
+  auto make_lt_predicate = [this]() {
+    bool left_side = true;
+    auto left_a_col = ColRefExpr(type::TypeId::INTEGER, left_side, 0);
+    auto right_a_col = ColRefExpr(type::TypeId::INTEGER, !left_side, 0);
+    return CmpLtExpr(std::move(right_a_col), std::move(left_a_col));
+  };
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 WHERE EXISTS "
+        "(SELECT * FROM table2 WHERE table2.A < table1.A)");
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(make_lt_predicate(), {0}, {0}, results, JoinType::SEMI);
+    EXPECT_EQ(19, results.size());
+    for (const auto &t : results) {
+      EXPECT_GT(GetCol(t, JoinOutputColPos::Table1_ColA).GetAs<int32_t>(), 0);
+    }
+  }
+
+  {
+    LOG_INFO(
+        "Testing: "
+        "SELECT * FROM table1 WHERE NOT EXISTS "
+        "(SELECT * FROM table2 WHERE table2.A < table1.A)");
+    std::vector<codegen::WrappedTuple> results;
+    PerformTest(make_lt_predicate(), {0}, {0}, results, JoinType::ANTI);
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(0, GetCol(results[0], JoinOutputColPos::Table1_ColA)
+                     .GetAs<int32_t>());
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
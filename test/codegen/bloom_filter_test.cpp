@@ -188,6 +188,29 @@ TEST_F(BloomFilterCodegenTest, FalsePositiveRateTest) {
   bloom_filter.Destroy();
 }
 
+TEST_F(BloomFilterCodegenTest, SelectivityTest) {
+  const uint64_t sample_size =
+      codegen::util::BloomFilter::kSelectivitySampleSize;
+
+  // Statistics are published in batches. Too few probes say nothing yet.
+  codegen::util::BloomFilter bloom_filter;
+  bloom_filter.Init(1000);
+  bloom_filter.AddStatistics(sample_size / 2, 0);
+  EXPECT_TRUE(bloom_filter.IsSelective());
+
+  // Enough probes, but almost none of them missed
+  bloom_filter.AddStatistics(sample_size / 2, sample_size / 100);
+  EXPECT_FALSE(bloom_filter.IsSelective());
+  bloom_filter.Destroy();
+
+  // Enough probes, and half of them missed
+  bloom_filter.Init(1000);
+  bloom_filter.AddStatistics(sample_size, sample_size / 2);
+  bloom_filter.AddStatistics(0, 0);
+  EXPECT_TRUE(bloom_filter.IsSelective());
+  bloom_filter.Destroy();
+}
+
 // Testing whether bloom filter can improve the performance of hash join
 // when the hash table is bigger than L3 cache and selectivity is low
 TEST_F(BloomFilterCodegenTest, PerformanceTest) {
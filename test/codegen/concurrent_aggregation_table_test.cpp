@@ -0,0 +1,300 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_aggregation_table_test.cpp
+//
+// Identification: test/codegen/concurrent_aggregation_table_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <unordered_set>
+#include <vector>
+
+#include "murmur3/MurmurHash3.h"
+
+#include "codegen/codegen.h"
+#include "codegen/concurrent_aggregation_table.h"
+#include "codegen/function_builder.h"
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/concurrent_aggregation_table_proxy.h"
+#include "codegen/proxy/executor_context_proxy.h"
+#include "codegen/util/concurrent_aggregation_table.h"
+#include "common/harness.h"
+#include "executor/executor_context.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace test {
+
+class ConcurrentAggregationTableTest : public PelotonTest {
+ public:
+  using UpdateOp = codegen::util::ConcurrentAggregationTable::UpdateOp;
+
+  // The aggregates of every group: COUNT(*), SUM(v), MIN(v), MAX(v)
+  static constexpr uint32_t kNumValues = 4;
+
+  ConcurrentAggregationTableTest()
+      : pool_(new ::peloton::type::EphemeralPool()) {}
+
+  static uint64_t Hash(uint32_t key) {
+    static constexpr uint32_t seed = 12345;
+    return MurmurHash3_x86_32(&key, sizeof(uint32_t), seed);
+  }
+
+  static uint64_t UpdateOps() {
+    const uint32_t bits =
+        codegen::util::ConcurrentAggregationTable::kUpdateOpBits;
+    return (static_cast<uint64_t>(UpdateOp::Add) << (0 * bits)) |
+           (static_cast<uint64_t>(UpdateOp::Add) << (1 * bits)) |
+           (static_cast<uint64_t>(UpdateOp::Min) << (2 * bits)) |
+           (static_cast<uint64_t>(UpdateOp::Max) << (3 * bits));
+  }
+
+  static void Upsert(codegen::util::ConcurrentAggregationTable &table,
+                     uint32_t key, int64_t val) {
+    int64_t values[kNumValues] = {1, val, val, val};
+    table.Upsert(Hash(key), reinterpret_cast<const char *>(&key), values);
+  }
+
+  type::AbstractPool &GetMemPool() const { return *pool_; }
+
+ private:
+  std::unique_ptr<::peloton::type::AbstractPool> pool_;
+};
+
+TEST_F(ConcurrentAggregationTableTest, CanAggregateGroups) {
+  codegen::util::ConcurrentAggregationTable table{
+      GetMemPool(), sizeof(uint32_t), kNumValues, UpdateOps(), 16};
+
+  constexpr uint32_t num_groups = 50;
+  constexpr uint32_t num_rows = 10000;
+
+  for (uint32_t i = 0; i < num_rows; i++) {
+    Upsert(table, i % num_groups, i);
+  }
+
+  EXPECT_EQ(num_groups, table.NumEntries());
+
+  std::unordered_set<uint32_t> seen;
+  for (uint64_t slot = 0; slot < table.Capacity(); slot++) {
+    const char *key_ptr = table.Key(slot);
+    if (key_ptr == nullptr) {
+      continue;
+    }
+    uint32_t key = *reinterpret_cast<const uint32_t *>(key_ptr);
+    EXPECT_TRUE(seen.insert(key).second) << "Found duplicate group " << key;
+
+    // The group has the rows key, key + num_groups, key + 2 * num_groups, ...
+    const int64_t *values = table.Values(slot);
+    const int64_t count = num_rows / num_groups;
+    EXPECT_EQ(count, values[0]);
+    EXPECT_EQ(count * key + num_groups * count * (count - 1) / 2, values[1]);
+    EXPECT_EQ(key, values[2]);
+    EXPECT_EQ(key + (count - 1) * num_groups, values[3]);
+  }
+  EXPECT_EQ(num_groups, seen.size());
+}
+
+TEST_F(ConcurrentAggregationTableTest, CanUpsertInParallel) {
+  // Start out small, so the table is resized many times while threads upsert
+  codegen::util::ConcurrentAggregationTable table{
+      GetMemPool(), sizeof(uint32_t), kNumValues, UpdateOps(), 1};
+
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_groups = 20000;
+
+  // Every thread upserts every group, in a different order
+  auto upsert_fn = [&table](uint64_t tid) {
+    for (uint32_t i = 0; i < num_groups; i++) {
+      uint32_t key = (i * 7919 + tid * 104729) % num_groups;
+      Upsert(table, key, static_cast<int64_t>(tid));
+    }
+  };
+
+  LaunchParallelTest(num_threads, upsert_fn);
+
+  EXPECT_EQ(num_groups, table.NumEntries());
+  EXPECT_LE(2 * num_groups, table.Capacity());
+
+  std::unordered_set<uint32_t> seen;
+  for (uint64_t slot = 0; slot < table.Capacity(); slot++) {
+    const char *key_ptr = table.Key(slot);
+    if (key_ptr == nullptr) {
+      continue;
+    }
+    uint32_t key = *reinterpret_cast<const uint32_t *>(key_ptr);
+    EXPECT_TRUE(seen.insert(key).second) << "Found duplicate group " << key;
+
+    const int64_t *values = table.Values(slot);
+    EXPECT_EQ(num_threads, values[0]);
+    EXPECT_EQ(num_threads * (num_threads - 1) / 2, values[1]);
+    EXPECT_EQ(0, values[2]);
+    EXPECT_EQ(num_threads - 1, values[3]);
+  }
+  EXPECT_EQ(num_groups, seen.size());
+}
+
+// Stores the aggregates of every group at out[key * kNumValues]
+class StoreGroupsCallback
+    : public codegen::ConcurrentAggregationTable::IterateCallback {
+ public:
+  explicit StoreGroupsCallback(llvm::Value *out) : out_(out) {}
+
+  void ProcessEntry(
+      codegen::CodeGen &codegen, const std::vector<codegen::Value> &key,
+      const std::vector<llvm::Value *> &aggregates) const override {
+    llvm::Value *base = codegen->CreateMul(
+        codegen->CreateZExt(key[0].GetValue(), codegen.Int64Type()),
+        codegen.Const64(ConcurrentAggregationTableTest::kNumValues));
+    for (uint32_t i = 0; i < aggregates.size(); i++) {
+      llvm::Value *idx = codegen->CreateAdd(base, codegen.Const64(i));
+      codegen->CreateStore(aggregates[i],
+                           codegen->CreateInBoundsGEP(codegen.Int64Type(),
+                                                      out_, idx));
+    }
+  }
+
+ private:
+  llvm::Value *out_;
+};
+
+TEST_F(ConcurrentAggregationTableTest, CanAggregateInGeneratedCode) {
+  codegen::CodeContext code_context;
+  codegen::CodeGen codegen{code_context};
+
+  codegen::type::Type key_type{peloton::type::TypeId::INTEGER, false};
+  codegen::ConcurrentAggregationTable agg_table{
+      codegen,
+      {key_type},
+      {UpdateOp::Add, UpdateOp::Add, UpdateOp::Min, UpdateOp::Max}};
+
+  auto *table_type =
+      codegen::ConcurrentAggregationTableProxy::GetType(codegen)->getPointerTo();
+
+  // define void @InitTable(ConcurrentAggregationTable *table,
+  //                        ExecutorContext *exec_ctx)
+  codegen::FunctionBuilder init_func{
+      code_context,
+      "InitTable",
+      codegen.VoidType(),
+      {{"table", table_type},
+       {"exec_ctx",
+        codegen::ExecutorContextProxy::GetType(codegen)->getPointerTo()}}};
+  {
+    agg_table.Init(codegen, init_func.GetArgumentByPosition(1),
+                   init_func.GetArgumentByPosition(0), 16);
+    init_func.ReturnAndFinish();
+  }
+
+  // define void @UpsertRows(ConcurrentAggregationTable *table, i32 *keys,
+  //                         i64 *vals, i32 num_rows) {
+  //   for (i32 i = 0; i < num_rows; i++) {
+  //     table.Upsert(keys[i], {1, vals[i], vals[i], vals[i]});
+  //   }
+  // }
+  codegen::FunctionBuilder upsert_func{
+      code_context,
+      "UpsertRows",
+      codegen.VoidType(),
+      {{"table", table_type},
+       {"keys", codegen.Int32Type()->getPointerTo()},
+       {"vals", codegen.Int64Type()->getPointerTo()},
+       {"num_rows", codegen.Int32Type()}}};
+  {
+    llvm::Value *table = upsert_func.GetArgumentByPosition(0);
+    llvm::Value *keys = upsert_func.GetArgumentByPosition(1);
+    llvm::Value *vals = upsert_func.GetArgumentByPosition(2);
+    llvm::Value *num_rows = upsert_func.GetArgumentByPosition(3);
+
+    llvm::Value *idx = codegen.Const32(0);
+    codegen::lang::Loop loop{
+        codegen, codegen->CreateICmpULT(idx, num_rows), {{"i", idx}}};
+    {
+      idx = loop.GetLoopVar(0);
+      llvm::Value *key = codegen->CreateLoad(
+          codegen->CreateInBoundsGEP(codegen.Int32Type(), keys, idx));
+      llvm::Value *val = codegen->CreateLoad(
+          codegen->CreateInBoundsGEP(codegen.Int64Type(), vals, idx));
+      agg_table.Upsert(codegen, table, {codegen::Value{key_type, key}},
+                       {codegen.Const64(1), val, val, val});
+
+      idx = codegen->CreateAdd(idx, codegen.Const32(1));
+      loop.LoopEnd(codegen->CreateICmpULT(idx, num_rows), {idx});
+    }
+    upsert_func.ReturnAndFinish();
+  }
+
+  // define void @ReadGroups(ConcurrentAggregationTable *table, i64 *out)
+  codegen::FunctionBuilder read_func{
+      code_context,
+      "ReadGroups",
+      codegen.VoidType(),
+      {{"table", table_type}, {"out", codegen.Int64Type()->getPointerTo()}}};
+  {
+    llvm::Value *table = read_func.GetArgumentByPosition(0);
+    StoreGroupsCallback callback{read_func.GetArgumentByPosition(1)};
+    agg_table.Iterate(codegen, table, callback);
+    agg_table.Destroy(codegen, table);
+    read_func.ReturnAndFinish();
+  }
+
+  code_context.Compile();
+
+  using table_t = codegen::util::ConcurrentAggregationTable;
+  typedef void (*init_t)(table_t *, executor::ExecutorContext *);
+  typedef void (*upsert_t)(table_t *, uint32_t *, int64_t *, uint32_t);
+  typedef void (*read_t)(table_t *, int64_t *);
+  auto init_fn =
+      (init_t)code_context.GetRawFunctionPointer(init_func.GetFunction());
+  auto upsert_fn =
+      (upsert_t)code_context.GetRawFunctionPointer(upsert_func.GetFunction());
+  auto read_fn =
+      (read_t)code_context.GetRawFunctionPointer(read_func.GetFunction());
+
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_groups = 1000;
+  constexpr uint32_t num_rows = 5000;
+
+  // Thread t upserts the rows t, t + num_threads, t + 2 * num_threads, ...
+  // The group of row i is i % num_groups, and its value is i.
+  std::vector<std::vector<uint32_t>> keys(num_threads);
+  std::vector<std::vector<int64_t>> vals(num_threads);
+  for (uint32_t i = 0; i < num_rows; i++) {
+    keys[i % num_threads].push_back(i % num_groups);
+    vals[i % num_threads].push_back(i);
+  }
+
+  executor::ExecutorContext exec_ctx{nullptr};
+  alignas(table_t) char table_storage[sizeof(table_t)];
+  auto *table = reinterpret_cast<table_t *>(table_storage);
+
+  init_fn(table, &exec_ctx);
+
+  // The table starts out too small for all groups, so upserts race resizes
+  LaunchParallelTest(num_threads, [&](uint64_t tid) {
+    upsert_fn(table, &keys[tid][0], &vals[tid][0],
+              static_cast<uint32_t>(keys[tid].size()));
+  });
+
+  EXPECT_EQ(num_groups, table->NumEntries());
+
+  std::vector<int64_t> out(num_groups * kNumValues, 0);
+  read_fn(table, &out[0]);
+
+  // Group k has the rows k, k + num_groups, k + 2 * num_groups, ...
+  const int64_t count = num_rows / num_groups;
+  for (uint32_t key = 0; key < num_groups; key++) {
+    const int64_t *values = &out[key * kNumValues];
+    EXPECT_EQ(count, values[0]) << "Group " << key;
+    EXPECT_EQ(count * key + num_groups * count * (count - 1) / 2, values[1])
+        << "Group " << key;
+    EXPECT_EQ(key, values[2]) << "Group " << key;
+    EXPECT_EQ(key + (count - 1) * num_groups, values[3]) << "Group " << key;
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
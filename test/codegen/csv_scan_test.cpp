@@ -14,6 +14,7 @@
 
 #include "codegen/util/csv_scanner.h"
 #include "common/timer.h"
+#include "type/ephemeral_pool.h"
 #include "util/file_util.h"
 #include "util/string_util.h"
 
@@ -157,6 +158,116 @@ TEST_F(CSVScanTest, MixedStringTest) {
   EXPECT_EQ(rows.size(), rows_read);
 }
 
+TEST_F(CSVScanTest, StreamedScanTest) {
+  // Rows with a quoted new-line, so that both lines and quoted sections span
+  // the boundaries of the chunks we feed the scanner
+  std::vector<std::string> rows = {"1,\"first\",3", "4,\"sec\nond\",6",
+                                   "7,third,9"};
+  std::vector<codegen::type::Type> types = {{type::TypeId::INTEGER, false},
+                                            {type::TypeId::VARCHAR, false},
+                                            {type::TypeId::INTEGER, false}};
+
+  std::string csv_data;
+  for (const auto &row : rows) {
+    csv_data.append(row).append("\n");
+  }
+  // Drop the final new-line, the last row must be produced by Finish()
+  csv_data.pop_back();
+
+  auto &pool = *TestingHarness::GetInstance().GetTestingPool();
+
+  uint32_t rows_read = 0;
+  State state = {.scanner = nullptr,
+                 .callback = [&rows, &rows_read, &types](
+                     const codegen::util::CSVScanner::Column *cols) {
+                   auto input_parts = StringUtil::Split(rows[rows_read++], ',');
+                   for (uint32_t i = 0; i < types.size(); i++) {
+                     EXPECT_FALSE(cols[i].is_null);
+                     EXPECT_EQ(StringUtil::Strip(input_parts[i], '"'),
+                               std::string(cols[i].ptr, cols[i].len));
+                   }
+                 }};
+
+  codegen::util::CSVScanner scanner(
+      pool, "", types.data(), static_cast<uint32_t>(types.size()),
+      CSVRowCallback, reinterpret_cast<void *>(&state));
+  state.scanner = &scanner;
+
+  // Push the data in tiny chunks
+  const uint32_t chunk_size = 3;
+  for (uint32_t pos = 0; pos < csv_data.size(); pos += chunk_size) {
+    auto len = std::min<uint32_t>(chunk_size, csv_data.size() - pos);
+    scanner.Feed(csv_data.data() + pos, len);
+  }
+  EXPECT_EQ(rows.size() - 1, rows_read);
+
+  scanner.Finish();
+  EXPECT_EQ(rows.size(), rows_read);
+}
+
+namespace {
+
+struct ParallelScanCounts {
+  uint64_t num_rows;
+  uint64_t sum;
+};
+
+void CountRowsInParallel(UNUSED_ATTRIBUTE void *query_state,
+                         void *thread_state,
+                         codegen::util::CSVScanner *scanner) {
+  auto *counts = reinterpret_cast<ParallelScanCounts *>(thread_state);
+  counts->num_rows = counts->sum = 0;
+  while (scanner->NextRow()) {
+    const auto *cols = scanner->GetColumns();
+    auto key = std::stoull(std::string(cols[0].ptr, cols[0].len));
+    auto doubled = std::stoull(std::string(cols[2].ptr, cols[2].len));
+    EXPECT_EQ(key * 2, doubled);
+    counts->num_rows++;
+    counts->sum += key;
+  }
+}
+
+}  // namespace
+
+TEST_F(CSVScanTest, ParallelScanTest) {
+  // Every seventh row has a quoted new-line, so some morsels begin inside a
+  // quoted section
+  const uint64_t num_rows = 1000;
+  std::string csv_data;
+  for (uint64_t i = 0; i < num_rows; i++) {
+    auto str = (i % 7 == 0 ? StringUtil::Format("\"row\n%" PRIu64 "\"", i)
+                           : StringUtil::Format("row%" PRIu64, i));
+    csv_data.append(
+        StringUtil::Format("%" PRIu64 ",%s,%" PRIu64 "\n", i, str.c_str(), i * 2));
+  }
+
+  TempFileHandle fh(FileUtil::WriteTempFile(csv_data, "", "tmp"));
+
+  std::vector<codegen::type::Type> types = {{type::TypeId::BIGINT, false},
+                                            {type::TypeId::VARCHAR, false},
+                                            {type::TypeId::BIGINT, false}};
+
+  type::EphemeralPool pool;
+  executor::ExecutorContext::ThreadStates thread_states{pool};
+  thread_states.Reset(sizeof(ParallelScanCounts));
+
+  // Use tiny morsels to exercise the boundary alignment
+  codegen::util::CSVScanner::ProduceParallel(
+      nullptr, thread_states, fh.name, types.data(),
+      static_cast<uint32_t>(types.size()), ',', '"', '"', CountRowsInParallel,
+      64);
+
+  uint64_t rows_read = 0, sum = 0;
+  for (uint32_t i = 0; i < thread_states.NumThreads(); i++) {
+    auto *counts = reinterpret_cast<ParallelScanCounts *>(
+        thread_states.AccessThreadState(i));
+    rows_read += counts->num_rows;
+    sum += counts->sum;
+  }
+  EXPECT_EQ(num_rows, rows_read);
+  EXPECT_EQ(num_rows * (num_rows - 1) / 2, sum);
+}
+
 TEST_F(CSVScanTest, CatchErrorsTest) {
   ////////////////////////////////////////////////////////////////////
   ///
@@ -455,5 +455,225 @@ TEST_F(GroupByTranslatorTest, MinAndMax) {
               CmpBool::CmpTrue);
 }
 
+TEST_F(GroupByTranslatorTest, ParallelSharedTableGrouping) {
+  //
+  // SELECT a, COUNT(*), SUM(b), MIN(b), MAX(b), AVG(b) FROM table GROUP BY a;
+  //
+  // The scan runs in parallel, and the aggregation expects few enough groups
+  // for all threads to share one hash table
+  //
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}, {2, {1, 1}},
+                                   {3, {1, 2}}, {4, {1, 3}}, {5, {1, 4}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations on column 'b'
+  auto b_col = [] {
+    return new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1);
+  };
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, b_col()},
+      {ExpressionType::AGGREGATE_SUM, b_col()},
+      {ExpressionType::AGGREGATE_MIN, b_col()},
+      {ExpressionType::AGGREGATE_MAX, b_col()},
+      {ExpressionType::AGGREGATE_AVG, b_col()}};
+
+  // 3) The grouping column
+  std::vector<oid_t> gb_cols = {0};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::INTEGER, 4, "COL_A"},
+                           {type::TypeId::BIGINT, 8, "COUNT_*"},
+                           {type::TypeId::INTEGER, 4, "SUM_B"},
+                           {type::TypeId::INTEGER, 4, "MIN_B"},
+                           {type::TypeId::INTEGER, 4, "MAX_B"},
+                           {type::TypeId::DECIMAL, 8, "AVG_B"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+  agg_plan->SetCardinality(10);
+
+  // 6) The parallel scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1}, false, true)};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3, 4, 5}, context};
+
+  // Compile it all
+  CompileAndExecute(*agg_plan, buffer);
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  EXPECT_EQ(10, results.size());
+
+  // Every group has one row, where b = a + 1
+  type::Value const_one = type::ValueFactory::GetIntegerValue(1);
+  for (const auto &tuple : results) {
+    type::Value b = tuple.GetValue(0).Add(const_one);
+    EXPECT_EQ(CmpBool::CmpTrue, tuple.GetValue(1).CompareEquals(const_one));
+    EXPECT_EQ(CmpBool::CmpTrue, tuple.GetValue(2).CompareEquals(b));
+    EXPECT_EQ(CmpBool::CmpTrue, tuple.GetValue(3).CompareEquals(b));
+    EXPECT_EQ(CmpBool::CmpTrue, tuple.GetValue(4).CompareEquals(b));
+    EXPECT_EQ(CmpBool::CmpTrue, tuple.GetValue(5).CompareEquals(b));
+  }
+}
+
+TEST_F(GroupByTranslatorTest, FrozenStringGrouping) {
+  //
+  // SELECT d, COUNT(*), MIN(a) FROM table GROUP BY d;
+  //
+  // The first tile group is frozen, so its rows are grouped on their dictionary
+  // codes, while the rows of the second are grouped on their strings
+  //
+
+  uint32_t num_rows = DEFAULT_TUPLES_PER_TILEGROUP + 10;
+  uint32_t num_names = 3;
+  oid_t table_id = test_table_oids[1];
+  LoadFrozenTestTable(table_id, num_rows, num_names);
+  ASSERT_TRUE(GetTestTable(table_id).GetTileGroup(0)->IsFrozen());
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 1}}, {1, {1, 0}}, {2, {1, 1}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0)},
+      {ExpressionType::AGGREGATE_MIN,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0)}};
+
+  // 3) The grouping column
+  std::vector<oid_t> gb_cols = {1};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::VARCHAR, 32, "COL_D"},
+                           {type::TypeId::BIGINT, 8, "COUNT_*"},
+                           {type::TypeId::INTEGER, 4, "MIN_A"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(table_id), nullptr, {0, 3})};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+
+  // Compile and run
+  CompileAndExecute(*agg_plan, buffer);
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(num_names, results.size());
+
+  // Name i is in the rows i, i + 3, ..., the first of which has a = 10 * i
+  std::vector<bool> seen(num_names, false);
+  for (const auto &tuple : results) {
+    std::string name = tuple.GetValue(0).ToString();
+    ASSERT_EQ("name", name.substr(0, 4));
+    uint32_t i = std::stoi(name.substr(4));
+    ASSERT_LT(i, num_names);
+    EXPECT_FALSE(seen[i]);
+    seen[i] = true;
+
+    int64_t count = (num_rows - i + num_names - 1) / num_names;
+    EXPECT_EQ(CmpBool::CmpTrue,
+              tuple.GetValue(1).CompareEquals(
+                  type::ValueFactory::GetBigIntValue(count)));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              tuple.GetValue(2).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(10 * i)));
+  }
+}
+
+TEST_F(GroupByTranslatorTest, SingleColumnSortedGrouping) {
+  //
+  // SELECT a, count(*) FROM table GROUP BY a;
+  //
+  // The test table is loaded in order of 'a', so the scan produces its rows
+  // sorted on the grouping column and we can aggregate group by group.
+  //
+
+  LOG_INFO("Query: SELECT a, COUNT(*) FROM table1 GROUP BY a;");
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations
+  auto *tve_expr =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, tve_expr}};
+
+  // 3) The grouping column
+  std::vector<oid_t> gb_cols = {0};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::INTEGER, 4, "COL_A"},
+                           {type::TypeId::BIGINT, 8, "COUNT_A"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::SORTED)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{
+      new planner::SeqScanPlan(&GetTestTable(TestTableId()), nullptr, {0})};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // Compile and run
+  CompileAndExecute(*agg_plan, buffer);
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(10, results.size());
+
+  // The groups come out in order, each with a count of one
+  type::Value const_one = type::ValueFactory::GetIntegerValue(1);
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_TRUE(results[i].GetValue(0).CompareEquals(
+                    type::ValueFactory::GetIntegerValue(10 * i)) ==
+                CmpBool::CmpTrue);
+    EXPECT_TRUE(results[i].GetValue(1).CompareEquals(const_one) ==
+                CmpBool::CmpTrue);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
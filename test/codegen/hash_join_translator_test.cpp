@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <limits>
+
+#include "codegen/operator/hash_join_translator.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -19,6 +22,7 @@
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
 
 #include "codegen/testing_codegen_util.h"
 
@@ -45,8 +49,64 @@ class HashJoinTranslatorTest : public PelotonCodeGenTest {
   storage::DataTable &GetRightTable() const {
     return GetTestTable(RightTableId());
   }
+
+  // Join both tables on their A columns with the given join type, producing
+  // left_table.a and right_table.a, or only right_table.a for semi and anti
+  // joins. The tables are filtered by the given predicates, if any.
+  void PerformJoinOnA(JoinType join_type,
+                      std::vector<codegen::WrappedTuple> &results,
+                      ExpressionPtr left_predicate = nullptr,
+                      ExpressionPtr right_predicate = nullptr);
 };
 
+void HashJoinTranslatorTest::PerformJoinOnA(
+    JoinType join_type, std::vector<codegen::WrappedTuple> &results,
+    ExpressionPtr left_predicate, ExpressionPtr right_predicate) {
+  bool right_only = join_type == JoinType::SEMI || join_type == JoinType::ANTI;
+  DirectMapList direct_map_list;
+  std::vector<catalog::Column> columns;
+  std::vector<oid_t> output_cols;
+  for (oid_t side = (right_only ? 1 : 0); side < 2; side++) {
+    oid_t output_col = static_cast<oid_t>(output_cols.size());
+    direct_map_list.push_back({output_col, std::make_pair(side, 0)});
+    columns.push_back(TestingExecutorUtil::GetColumnInfo(0));
+    output_cols.push_back(output_col);
+  }
+  std::unique_ptr<planner::ProjectInfo> projection{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+  auto schema =
+      std::shared_ptr<const catalog::Schema>(new catalog::Schema(columns));
+
+  std::vector<ConstExpressionPtr> left_hash_keys;
+  left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+  std::vector<ConstExpressionPtr> right_hash_keys;
+  right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+  std::vector<ConstExpressionPtr> hash_keys;
+  hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::unique_ptr<planner::HashJoinPlan> hj_plan{
+      new planner::HashJoinPlan(join_type, nullptr, std::move(projection),
+                                schema, left_hash_keys, right_hash_keys, true)};
+  std::unique_ptr<planner::HashPlan> hash_plan{
+      new planner::HashPlan(hash_keys)};
+
+  std::unique_ptr<planner::AbstractPlan> left_scan{new planner::SeqScanPlan(
+      &GetLeftTable(), left_predicate.release(), {0, 1, 2})};
+  std::unique_ptr<planner::AbstractPlan> right_scan{new planner::SeqScanPlan(
+      &GetRightTable(), right_predicate.release(), {0, 1, 2})};
+
+  hash_plan->AddChild(std::move(right_scan));
+  hj_plan->AddChild(std::move(left_scan));
+  hj_plan->AddChild(std::move(hash_plan));
+
+  planner::BindingContext context;
+  hj_plan->PerformBinding(context);
+
+  codegen::BufferingConsumer buffer{output_cols, context};
+  CompileAndExecute(*hj_plan, buffer);
+  results = buffer.GetOutputTuples();
+}
+
 TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
   //
   // SELECT
@@ -127,5 +187,164 @@ TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
   }
 }
 
+TEST_F(HashJoinTranslatorTest, OuterHashJoinTest) {
+  // Every left tuple has a partner, so a left outer join adds nothing
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(JoinType::LEFT, results);
+    EXPECT_EQ(20, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+    }
+  }
+
+  // The 60 right tuples without a partner are padded with NULL values
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(JoinType::RIGHT, results);
+    EXPECT_EQ(80, results.size());
+    uint32_t num_null_padded = 0;
+    for (const auto &tuple : results) {
+      EXPECT_FALSE(tuple.GetValue(1).IsNull());
+      if (tuple.GetValue(0).IsNull()) {
+        num_null_padded++;
+      }
+    }
+    EXPECT_EQ(60, num_null_padded);
+  }
+
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(JoinType::OUTER, results);
+    EXPECT_EQ(80, results.size());
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, SemiAndAntiHashJoinTest) {
+  // The left side is built and the right side probes it. The 20 right tuples
+  // with A in [0, 190] have a partner and are produced once.
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(JoinType::SEMI, results);
+    ASSERT_EQ(20, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 200);
+    }
+  }
+
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(JoinType::ANTI, results);
+    ASSERT_EQ(60, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_GE(tuple.GetValue(0).GetAs<int32_t>(), 200);
+    }
+  }
+
+  // Only five right tuples (with A in [0, 40]) are left, and all of them have
+  // a partner
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(
+        JoinType::SEMI, results, nullptr,
+        CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50)));
+    ASSERT_EQ(5, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 50);
+    }
+  }
+
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(
+        JoinType::ANTI, results, nullptr,
+        CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50)));
+    EXPECT_EQ(0, results.size());
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, SelectiveHashJoinTest) {
+  // Only five left tuples (with A in [0, 40]) are built, so the bloom filter
+  // and the key range pushed into the right scan drop most right tuples
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(
+        JoinType::INNER, results,
+        CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50)));
+    ASSERT_EQ(5, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+      EXPECT_LT(tuple.GetValue(1).GetAs<int32_t>(), 50);
+    }
+  }
+
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(
+        JoinType::SEMI, results,
+        CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50)));
+    ASSERT_EQ(5, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 50);
+    }
+  }
+
+  // ANTI joins produce the right rows without a partner, so the filters can't
+  // drop them in the scan
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(
+        JoinType::ANTI, results,
+        CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50)));
+    ASSERT_EQ(75, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_GE(tuple.GetValue(0).GetAs<int32_t>(), 50);
+    }
+  }
+
+  // Nothing is built, so no right row is produced
+  {
+    std::vector<codegen::WrappedTuple> results;
+    PerformJoinOnA(
+        JoinType::INNER, results,
+        CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(0)));
+    EXPECT_EQ(0, results.size());
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, PrefetchingHashJoinTest) {
+  // Probing in groups of prefetched rows must not change the results, so run
+  // the joins both with and without prefetching
+  auto default_min_size = settings::SettingsManager::GetInt(
+      settings::SettingId::min_prefetch_hash_table_size);
+  for (int32_t min_size : {0, std::numeric_limits<int32_t>::max()}) {
+    settings::SettingsManager::SetInt(
+        settings::SettingId::min_prefetch_hash_table_size, min_size);
+
+    {
+      std::vector<codegen::WrappedTuple> results;
+      PerformJoinOnA(JoinType::INNER, results);
+      EXPECT_EQ(20, results.size());
+      for (const auto &tuple : results) {
+        EXPECT_EQ(CmpBool::CmpTrue,
+                  tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+      }
+    }
+
+    {
+      std::vector<codegen::WrappedTuple> results;
+      PerformJoinOnA(
+          JoinType::ANTI, results,
+          CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50)));
+      EXPECT_EQ(75, results.size());
+    }
+  }
+
+  settings::SettingsManager::SetInt(
+      settings::SettingId::min_prefetch_hash_table_size, default_min_size);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// set_op_translator_test.cpp
+//
+// Identification: test/codegen/set_op_translator_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "planner/append_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "planner/set_op_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+class SetOpTranslatorTest : public PelotonCodeGenTest {
+ public:
+  SetOpTranslatorTest() : PelotonCodeGenTest() {
+    // The first 20 rows of both tables are the same
+    LoadTestTable(LeftTableId(), 20);
+    LoadTestTable(RightTableId(), 80);
+  }
+
+  oid_t LeftTableId() const { return test_table_oids[0]; }
+
+  oid_t RightTableId() const { return test_table_oids[1]; }
+
+  // Scan columns a and b of the given table
+  PlanPtr ScanAB(oid_t table_id) const {
+    return PlanPtr{
+        new planner::SeqScanPlan(&GetTestTable(table_id), nullptr, {0, 1})};
+  }
+
+  PlanPtr MakeSetOp(SetOpType set_op, PlanPtr &&left, PlanPtr &&right) const {
+    PlanPtr set_op_plan{new planner::SetOpPlan(set_op)};
+    set_op_plan->AddChild(std::move(left));
+    set_op_plan->AddChild(std::move(right));
+    return set_op_plan;
+  }
+
+  PlanPtr MakeAppend(PlanPtr &&first, PlanPtr &&second) const {
+    PlanPtr append_plan{new planner::AppendPlan()};
+    append_plan->AddChild(std::move(first));
+    append_plan->AddChild(std::move(second));
+    return append_plan;
+  }
+
+  // Run the given plan, returning the number of result rows
+  uint32_t CountResults(planner::AbstractPlan &plan) {
+    EXPECT_TRUE(codegen::QueryCompiler::IsSupported(plan));
+
+    planner::BindingContext context;
+    plan.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(plan, buffer);
+    return static_cast<uint32_t>(buffer.GetOutputTuples().size());
+  }
+};
+
+TEST_F(SetOpTranslatorTest, UnionTest) {
+  // SELECT a, b FROM table1 UNION ALL SELECT a, b FROM table2
+  {
+    auto plan = MakeAppend(ScanAB(LeftTableId()), ScanAB(RightTableId()));
+    EXPECT_EQ(100, CountResults(*plan));
+  }
+
+  // SELECT a, b FROM table1 UNION SELECT a, b FROM table2
+  {
+    std::vector<std::unique_ptr<const expression::AbstractExpression>> keys;
+    keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+    keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 1));
+    PlanPtr plan{new planner::HashPlan(keys)};
+    plan->AddChild(MakeAppend(ScanAB(LeftTableId()), ScanAB(RightTableId())));
+    EXPECT_EQ(80, CountResults(*plan));
+  }
+}
+
+TEST_F(SetOpTranslatorTest, IntersectTest) {
+  // SELECT a, b FROM table2 INTERSECT SELECT a, b FROM table1
+  {
+    auto plan = MakeSetOp(SetOpType::INTERSECT, ScanAB(RightTableId()),
+                          ScanAB(LeftTableId()));
+    EXPECT_EQ(20, CountResults(*plan));
+  }
+
+  // Every left tuple appears twice on the left but once on the right
+  {
+    auto plan = MakeSetOp(
+        SetOpType::INTERSECT_ALL,
+        MakeAppend(ScanAB(LeftTableId()), ScanAB(LeftTableId())),
+        ScanAB(RightTableId()));
+    EXPECT_EQ(20, CountResults(*plan));
+  }
+}
+
+TEST_F(SetOpTranslatorTest, ExceptTest) {
+  // SELECT a, b FROM table2 EXCEPT SELECT a, b FROM table1
+  {
+    auto plan = MakeSetOp(SetOpType::EXCEPT, ScanAB(RightTableId()),
+                          ScanAB(LeftTableId()));
+    EXPECT_EQ(60, CountResults(*plan));
+  }
+
+  // SELECT a, b FROM table1 EXCEPT SELECT a, b FROM table2
+  {
+    auto plan = MakeSetOp(SetOpType::EXCEPT, ScanAB(LeftTableId()),
+                          ScanAB(RightTableId()));
+    EXPECT_EQ(0, CountResults(*plan));
+  }
+
+  // One of the two copies of each left tuple remains
+  {
+    auto plan = MakeSetOp(
+        SetOpType::EXCEPT_ALL,
+        MakeAppend(ScanAB(LeftTableId()), ScanAB(LeftTableId())),
+        ScanAB(RightTableId()));
+    EXPECT_EQ(20, CountResults(*plan));
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -15,8 +15,11 @@
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "expression/comparison_expression.h"
 #include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
 #include "expression/operator_expression.h"
+#include "expression/vector_value_expression.h"
 #include "planner/seq_scan_plan.h"
 #include "storage/storage_manager.h"
 #include "storage/table_factory.h"
@@ -636,6 +639,100 @@ TEST_F(TableScanTranslatorTest, ScanWithModuloPredicate) {
                                   type::ValueFactory::GetIntegerValue(1)));
 }
 
+TEST_F(TableScanTranslatorTest, ScanWithInListPredicate) {
+  auto in_list_scan = [this](const std::vector<int32_t> &values,
+                             bool with_null) {
+    std::vector<expression::AbstractExpression *> list;
+    for (auto value : values) {
+      list.push_back(ConstIntExpr(value).release());
+    }
+    if (with_null) {
+      list.push_back(new expression::ConstantValueExpression(
+          type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER)));
+    }
+    ExpressionPtr a_in_list{new expression::ComparisonExpression(
+        ExpressionType::COMPARE_IN,
+        ColRefExpr(type::TypeId::INTEGER, 0).release(),
+        new expression::VectorValueExpression(list))};
+
+    auto &table = GetTestTable(TestTableId());
+    planner::SeqScanPlan scan{&table, a_in_list.release(), {0, 1}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0}, context};
+    CompileAndExecute(scan, buffer);
+    return buffer.GetOutputTuples().size();
+  };
+
+  //
+  // SELECT a FROM table where a IN (0, 10, 20, 35);
+  //
+  EXPECT_EQ(3, in_list_scan({0, 10, 20, 35}, false));
+  EXPECT_EQ(3, in_list_scan({0, 10, 20, 35}, true));
+
+  //
+  // SELECT a FROM table where a IN (0, 20, ..., 480, 5, 15, ..., 45);
+  //
+  // The list is long enough to be looked up in a sorted array
+  std::vector<int32_t> values;
+  for (int32_t i = 0; i <= 480; i += 20) {
+    values.push_back(i);
+  }
+  for (int32_t i = 5; i < 50; i += 10) {
+    values.push_back(i);
+  }
+  // Duplicates don't matter
+  values.push_back(40);
+  EXPECT_EQ(25, in_list_scan(values, false));
+  EXPECT_EQ(25, in_list_scan(values, true));
+}
+
+TEST_F(TableScanTranslatorTest, ScanFrozenWithStringPredicate) {
+  //
+  // SELECT a, d FROM table where d = 'name1';
+  //
+  // The first tile group is frozen, so the predicate is evaluated once for
+  // every entry of its dictionary, and its rows look up the result of their
+  // code. The rows of the second are checked one by one.
+  //
+
+  uint32_t num_rows = DEFAULT_TUPLES_PER_TILEGROUP + 10;
+  uint32_t num_names = 3;
+  oid_t table_id = test_table_oids[1];
+  LoadFrozenTestTable(table_id, num_rows, num_names);
+  ASSERT_TRUE(GetTestTable(table_id).GetTileGroup(0)->IsFrozen());
+
+  // Setup the predicate
+  ExpressionPtr name1{new expression::ConstantValueExpression(
+      type::ValueFactory::GetVarcharValue("name1"))};
+  ExpressionPtr d_eq_name1 =
+      CmpEqExpr(ColRefExpr(type::TypeId::VARCHAR, 3), std::move(name1));
+
+  // Setup the scan plan node
+  auto &table = GetTestTable(table_id);
+  planner::SeqScanPlan scan{&table, d_eq_name1.release(), {0, 3}};
+
+  // Do binding
+  planner::BindingContext context;
+  scan.PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(scan, buffer);
+
+  // Every third row, starting with the second, has the name
+  const auto &results = buffer.GetOutputTuples();
+  EXPECT_EQ((num_rows + 1) / num_names, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_EQ(10, tuple.GetValue(0).GetAs<int32_t>() % (10 * num_names));
+    EXPECT_EQ("name1", tuple.GetValue(1).ToString());
+  }
+}
+
 TEST_F(TableScanTranslatorTest, ScanRowLayout) {
   //
   // Creates a table with LayoutType::ROW and
@@ -19,6 +19,7 @@
 #include "codegen/proxy/value_proxy.h"
 #include "codegen/proxy/values_runtime_proxy.h"
 #include "codegen/query_cache.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "executor/plan_executor.h"
@@ -190,6 +191,43 @@ void PelotonCodeGenTest::LoadTestTable(oid_t table_id, uint32_t num_rows,
   txn_manager.CommitTransaction(txn);
 }
 
+void PelotonCodeGenTest::LoadFrozenTestTable(oid_t table_id, uint32_t num_rows,
+                                             uint32_t num_names) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+
+  auto &test_table = GetTestTable(table_id);
+  auto *table_schema = test_table.GetSchema();
+
+  const bool allocate = true;
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  for (uint32_t rowid = 0; rowid < num_rows; rowid++) {
+    storage::Tuple tuple{table_schema, allocate};
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(10 * rowid));
+    tuple.SetValue(1, type::ValueFactory::GetIntegerValue(10 * rowid + 1));
+    tuple.SetValue(2, type::ValueFactory::GetDecimalValue(10 * rowid + 2));
+    auto string_value = type::ValueFactory::GetVarcharValue(
+        "name" + std::to_string(rowid % num_names));
+    tuple.SetValue(3, string_value, testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    ItemPointer tuple_slot_id =
+        test_table.InsertTuple(&tuple, txn, &index_entry_ptr);
+    PELOTON_ASSERT(tuple_slot_id.block != INVALID_OID);
+    txn_manager.PerformInsert(txn, tuple_slot_id, index_entry_ptr);
+  }
+
+  txn_manager.CommitTransaction(txn);
+
+  // The rows can only be frozen once no transaction can see an older version
+  // of them
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.SetCurrentEpochId(epoch_manager.GetCurrentEpochId() + 1);
+  for (oid_t offset = 0; offset < test_table.GetTileGroupCount(); offset++) {
+    test_table.FreezeTileGroup(offset);
+  }
+}
+
 void PelotonCodeGenTest::CreateAndLoadTableWithLayout(
     peloton::LayoutType layout_type, uint32_t tuples_per_tilegroup,
     uint32_t tile_group_count, uint32_t column_count, bool is_inlined) {
@@ -150,5 +150,27 @@ TEST_F(ZoneMapScanTest, ScanwithConjunctionPredicate) {
   EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(1).CompareEquals(
                                      type::ValueFactory::GetIntegerValue(21)));
 }
+
+TEST_F(ZoneMapScanTest, TileGroupOverlapsRange) {
+  // The tile groups hold A in [0, 40], [50, 90], [100, 140] and [150, 190],
+  // and the last one has no zone map
+  auto &table = GetTestTable(TestTableId());
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+  auto overlaps = [&](int64_t tile_group_idx, int64_t min, int64_t max) {
+    return zone_map_manager->TileGroupOverlapsRange(&table, tile_group_idx, 0,
+                                                    min, max);
+  };
+
+  EXPECT_TRUE(overlaps(0, 40, 60));
+  EXPECT_TRUE(overlaps(1, 40, 60));
+  EXPECT_FALSE(overlaps(2, 40, 60));
+  EXPECT_TRUE(overlaps(1, 90, 90));
+  EXPECT_FALSE(overlaps(1, 91, 99));
+  EXPECT_TRUE(overlaps(3, 0, 10));
+
+  // An empty range overlaps nothing
+  EXPECT_FALSE(overlaps(0, 10, 0));
+  EXPECT_FALSE(overlaps(3, 10, 0));
+}
 }
 }
\ No newline at end of file
@@ -292,7 +292,8 @@ TEST_F(InternalTypesTests, HybridScanTypeTest) {
 TEST_F(InternalTypesTests, JoinTypeTest) {
   std::vector<JoinType> list = {JoinType::INVALID, JoinType::LEFT,
                                 JoinType::RIGHT,   JoinType::INNER,
-                                JoinType::OUTER,   JoinType::SEMI};
+                                JoinType::OUTER,   JoinType::SEMI,
+                                JoinType::ANTI};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache_test.cpp
+//
+// Identification: test/common/plan_cache_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/plan_cache.h"
+
+#include "catalog/global_catalog_cache.h"
+#include "common/harness.h"
+#include "common/statement_cache_manager.h"
+#include "parser/postgresparser.h"
+#include "parser/select_statement.h"
+#include "planner/limit_plan.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Plan Cache Tests
+//===--------------------------------------------------------------------===//
+
+class PlanCacheTests : public PelotonTest {};
+
+static std::string GetKey(const std::string &query,
+                          std::vector<type::Value> &parameters) {
+  auto &parser = parser::PostgresParser::GetInstance();
+  auto stmt_list = parser.BuildParseTree(query);
+  return PlanCache::GetKey(query, DEFAULT_DB_NAME, stmt_list->GetStatement(0),
+                           parameters);
+}
+
+TEST_F(PlanCacheTests, KeyTest) {
+  std::vector<type::Value> parameters;
+  auto key = GetKey("SELECT a, b FROM foo WHERE a = 1 AND 'x' < b", parameters);
+  EXPECT_FALSE(key.empty());
+  ASSERT_EQ(2, parameters.size());
+  EXPECT_EQ(1, parameters[0].GetAs<int32_t>());
+  EXPECT_EQ("x", parameters[1].ToString());
+
+  // The lifted constants are not part of the key
+  std::vector<type::Value> other_parameters;
+  EXPECT_EQ(key, GetKey("SELECT a, b FROM foo WHERE a = 42 AND 'y' < b",
+                        other_parameters));
+  EXPECT_EQ(42, other_parameters[0].GetAs<int32_t>());
+
+  // All other constants are
+  EXPECT_NE(key, GetKey("SELECT a, b FROM foo WHERE a = 'z' AND 'y' < b",
+                        other_parameters));
+  EXPECT_NE(GetKey("SELECT a + 1 FROM foo WHERE a = 1", other_parameters),
+            GetKey("SELECT a + 2 FROM foo WHERE a = 1", other_parameters));
+  EXPECT_NE(GetKey("SELECT a FROM foo LIMIT 1", other_parameters),
+            GetKey("SELECT a FROM foo LIMIT 2", other_parameters));
+  EXPECT_NE(GetKey("SELECT a AS x FROM foo", other_parameters),
+            GetKey("SELECT a AS y FROM foo", other_parameters));
+
+  // Only SELECT, UPDATE and DELETE statements are cached
+  EXPECT_FALSE(GetKey("UPDATE foo SET b = 2 WHERE a = 1", parameters).empty());
+  EXPECT_EQ(1, parameters.size());
+  EXPECT_FALSE(GetKey("DELETE FROM foo WHERE a = 1", parameters).empty());
+  EXPECT_EQ(1, parameters.size());
+  EXPECT_TRUE(GetKey("INSERT INTO foo VALUES (1, 2)", parameters).empty());
+}
+
+TEST_F(PlanCacheTests, LiftConstantsTest) {
+  auto &parser = parser::PostgresParser::GetInstance();
+  auto stmt_list = parser.BuildParseTree("SELECT a FROM foo WHERE a = 1");
+  auto *statement = stmt_list->GetStatement(0);
+  auto *predicate =
+      static_cast<parser::SelectStatement *>(statement)->where_clause.get();
+
+  // Building the key leaves the constants for the first plan of the query
+  std::vector<type::Value> parameters;
+  EXPECT_FALSE(PlanCache::GetKey("SELECT a FROM foo WHERE a = 1",
+                                 DEFAULT_DB_NAME, statement, parameters)
+                   .empty());
+  EXPECT_EQ(ExpressionType::VALUE_CONSTANT,
+            predicate->GetChild(1)->GetExpressionType());
+
+  // The shared plan is built with parameters in their place
+  PlanCache::LiftConstants(statement);
+  EXPECT_EQ(ExpressionType::VALUE_PARAMETER,
+            predicate->GetChild(1)->GetExpressionType());
+}
+
+TEST_F(PlanCacheTests, InvalidationTest) {
+  StatementCacheManager::Init();
+  auto &plan_cache = PlanCache::GetInstance();
+  plan_cache.Clear();
+  auto version = catalog::GlobalCatalogCache::GetInstance().GetVersion();
+
+  auto cached_plan = std::make_shared<CachedPlan>(
+      version, std::set<oid_t>{1, 2}, std::vector<FieldInfo>());
+  plan_cache.Insert("key", cached_plan);
+  EXPECT_EQ(cached_plan, plan_cache.Find("key", version));
+  EXPECT_EQ(nullptr, plan_cache.Find("key", version + 1));
+
+  // An instance of the plan is idle once it is dropped
+  std::shared_ptr<planner::AbstractPlan> limit_plan(
+      new planner::LimitPlan(1, 0));
+  auto plan = cached_plan->Wrap(limit_plan);
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+  plan.reset();
+  plan = cached_plan->Acquire();
+  EXPECT_EQ(limit_plan.get(), plan.get());
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+
+  // Dropping a referenced table drops the plan
+  StatementCacheManager::GetStmtCacheManager()->InvalidateTableOid(3);
+  EXPECT_EQ(cached_plan, plan_cache.Find("key", version));
+  StatementCacheManager::GetStmtCacheManager()->InvalidateTableOid(2);
+  EXPECT_EQ(nullptr, plan_cache.Find("key", version));
+  EXPECT_EQ(0, plan_cache.GetSize());
+
+  // The busy instance is not reused
+  plan.reset();
+  EXPECT_EQ(nullptr, cached_plan->Acquire());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <thread>
 
 #include "concurrency/epoch_manager_factory.h"
 #include "concurrency/testing_transaction_util.h"
@@ -137,6 +138,68 @@ TEST_F(DecentralizedEpochManagerTests, MultipleThreadsTest) {
 }
 
 
+TEST_F(DecentralizedEpochManagerTests, CrossThreadOrderTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  epoch_manager.RegisterThread(1);
+
+  // the threads enter the epoch one after another. each id must be larger
+  // than all the ids handed out before it, no matter which thread got them.
+  cid_t last_id = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    size_t thread_id = i % 2;
+    cid_t txn_id = 0;
+    std::thread thread([&epoch_manager, thread_id, &txn_id] {
+      txn_id = epoch_manager.EnterEpoch(thread_id, TimestampType::READ);
+      epoch_manager.ExitEpoch(thread_id, txn_id >> 32);
+    });
+    thread.join();
+
+    EXPECT_LT(last_id, txn_id);
+    last_id = txn_id;
+  }
+
+  epoch_manager.DeregisterThread(1);
+}
+
+
+TEST_F(DecentralizedEpochManagerTests, CrossThreadVisibilityTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  epoch_manager.RegisterThread(1);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  // the threads take turns updating the tuple. a transaction that begins
+  // after the update committed must see it, even on the other thread.
+  for (int value = 1; value <= 4; ++value) {
+    size_t writer_id = value % 2;
+    size_t reader_id = 1 - writer_id;
+
+    std::thread writer([&txn_manager, table, writer_id, value] {
+      auto txn = txn_manager.BeginTransaction(writer_id);
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 0, value));
+      EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+    });
+    writer.join();
+
+    std::thread reader([&txn_manager, table, reader_id, value] {
+      auto txn = txn_manager.BeginTransaction(reader_id);
+      int result = -1;
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 0, result));
+      EXPECT_EQ(value, result);
+      EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+    });
+    reader.join();
+  }
+
+  epoch_manager.DeregisterThread(1);
+}
+
+
 }  // namespace test
 }  // namespace peloton
 
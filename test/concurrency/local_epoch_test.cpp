@@ -24,21 +24,6 @@ namespace test {
 class LocalEpochTests : public PelotonTest {};
 
 
-TEST_F(LocalEpochTests, EpochCompareTest) {
-  concurrency::EpochCompare comp;
-  
-  std::shared_ptr<concurrency::Epoch> epoch0(new concurrency::Epoch(10, 20));
-  std::shared_ptr<concurrency::Epoch> epoch1(new concurrency::Epoch(10, 20));
-  bool rt = comp(epoch0, epoch1);
-  EXPECT_FALSE(rt);
-
-  std::shared_ptr<concurrency::Epoch> epoch2(new concurrency::Epoch(11, 21));
-  std::shared_ptr<concurrency::Epoch> epoch3(new concurrency::Epoch(12, 20));
-  rt = comp(epoch2, epoch3);
-  EXPECT_FALSE(rt);
-}
-
-
 TEST_F(LocalEpochTests, TransactionTest) {
   concurrency::LocalEpoch local_epoch(0);
   
@@ -92,6 +77,34 @@ TEST_F(LocalEpochTests, TransactionTest) {
 }
 
 
+TEST_F(LocalEpochTests, OverflowTest) {
+  concurrency::LocalEpoch local_epoch(0);
+
+  // enter twice as many epochs as there are slots.
+  const uint64_t epoch_count = 2 * concurrency::EPOCH_SLOT_COUNT;
+  for (uint64_t epoch_id = 10; epoch_id < 10 + epoch_count; ++epoch_id) {
+    EXPECT_TRUE(local_epoch.EnterEpoch(epoch_id, TimestampType::READ));
+    EXPECT_TRUE(local_epoch.EnterEpoch(epoch_id, TimestampType::READ));
+  }
+
+  uint64_t max_eid = local_epoch.GetExpiredEpochId(100);
+  EXPECT_EQ(max_eid, 9);
+
+  // leave the epochs in the slots first.
+  for (uint64_t epoch_id = 10; epoch_id < 10 + epoch_count; ++epoch_id) {
+    local_epoch.ExitEpoch(epoch_id);
+    local_epoch.ExitEpoch(epoch_id);
+
+    max_eid = local_epoch.GetExpiredEpochId(100);
+    if (epoch_id + 1 < 10 + epoch_count) {
+      EXPECT_EQ(max_eid, epoch_id);
+    } else {
+      EXPECT_EQ(max_eid, 99);
+    }
+  }
+}
+
+
 }  // namespace test
 }  // namespace peloton
 
@@ -29,5 +29,25 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+TEST_F(TimestampOrderingTransactionManagerTests, EndActionsTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Committed transactions run all their end actions, in order
+  std::vector<int> actions;
+  auto txn = txn_manager.BeginTransaction();
+  txn->AddOnEndAction([&actions] { actions.push_back(1); }, true);
+  txn->AddOnEndAction([&actions] { actions.push_back(2); });
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(std::vector<int>({1, 2}), actions);
+
+  // Aborted transactions skip those only meant for a commit
+  actions.clear();
+  txn = txn_manager.BeginTransaction();
+  txn->AddOnEndAction([&actions] { actions.push_back(1); }, true);
+  txn->AddOnEndAction([&actions] { actions.push_back(2); });
+  txn_manager.AbortTransaction(txn);
+  EXPECT_EQ(std::vector<int>({2}), actions);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -20,8 +20,10 @@
 
 #include "common/internal_types.h"
 #include "type/value.h"
+#include "type/value_peeker.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/aggregate_executor.h"
+#include "executor/aggregator.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
@@ -29,6 +31,9 @@
 #include "planner/abstract_plan.h"
 #include "planner/aggregate_plan.h"
 #include "storage/data_table.h"
+#include "storage/table_factory.h"
+#include "storage/temp_table.h"
+#include "storage/tile_group.h"
 
 #include "executor/mock_executor.h"
 
@@ -863,5 +868,302 @@ TEST_F(AggregateTests, PlainSumCountDistinctTest) {
   EXPECT_TRUE(cmp == CmpBool::CmpTrue);
 }
 
+TEST_F(AggregateTests, HashVectorizedGroupByTest) {
+  // SELECT a, COUNT(*), SUM(b), MIN(c), MAX(c), AVG(b) from table GROUP BY a;
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  // Create a table and wrap it in logical tiles
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), 2 * tuple_count, false,
+                                   false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  // (1-5) Setup plan node
+
+  // 1) Set up group-by columns
+  std::vector<oid_t> group_by_columns = {0};
+
+  // 2) Set up project info
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}, {2, {1, 1}},
+                                   {3, {1, 2}}, {4, {1, 3}}, {5, {1, 4}}};
+
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  // 3) Set up unique aggregates
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_COUNT_STAR, nullptr);
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_SUM,
+                         expression::ExpressionUtil::TupleValueFactory(
+                             type::TypeId::INTEGER, 0, 1));
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_MIN,
+                         expression::ExpressionUtil::TupleValueFactory(
+                             type::TypeId::DECIMAL, 0, 2));
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_MAX,
+                         expression::ExpressionUtil::TupleValueFactory(
+                             type::TypeId::DECIMAL, 0, 2));
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_AVG,
+                         expression::ExpressionUtil::TupleValueFactory(
+                             type::TypeId::INTEGER, 0, 1));
+
+  // 4) Set up predicate (empty)
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  // 5) Create output table schema
+  auto data_table_schema = data_table.get()->GetSchema();
+  std::vector<oid_t> set = {0, 0, 1, 2, 2, 2};
+  std::vector<catalog::Column> columns;
+  for (auto column_index : set) {
+    columns.push_back(data_table_schema->GetColumn(column_index));
+  }
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(columns));
+
+  // OK) Create the plan node
+  planner::AggregatePlan node(std::move(proj_info), std::move(predicate),
+                              std::move(agg_terms), std::move(group_by_columns),
+                              output_table_schema, AggregateType::HASH);
+
+  // All columns are fixed-width, so this runs vectorized
+  EXPECT_TRUE(executor::VectorizedAggregator::IsSupported(
+      &node, source_logical_tile1.get()));
+
+  // Create and set up executor
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::AggregateExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  EXPECT_TRUE(executor.Init());
+
+  EXPECT_TRUE(executor.Execute());
+
+  txn_manager.CommitTransaction(txn);
+
+  // Verify result. The first tile group holds all tuples with a = 0, the
+  // second one all tuples with a = 10.
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_TRUE(result_tile.get() != nullptr);
+  ASSERT_EQ(2, result_tile->GetTupleCount());
+  for (oid_t tuple_id = 0; tuple_id < 2; tuple_id++) {
+    int group = (type::ValuePeeker::PeekInteger(
+                     result_tile->GetValue(tuple_id, 0)) == 0
+                     ? 0
+                     : 1);
+    int first_row = group * tuple_count;
+    int last_row = first_row + tuple_count - 1;
+    int sum_b = 0;
+    for (int row = first_row; row <= last_row; row++) {
+      sum_b += TestingExecutorUtil::PopulatedValue(row, 1);
+    }
+
+    type::Value val = (result_tile->GetValue(tuple_id, 1));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              val.CompareEquals(type::ValueFactory::GetIntegerValue(tuple_count)));
+    val = (result_tile->GetValue(tuple_id, 2));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              val.CompareEquals(type::ValueFactory::GetIntegerValue(sum_b)));
+    val = (result_tile->GetValue(tuple_id, 3));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              val.CompareEquals(type::ValueFactory::GetDecimalValue(
+                  TestingExecutorUtil::PopulatedValue(first_row, 2))));
+    val = (result_tile->GetValue(tuple_id, 4));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              val.CompareEquals(type::ValueFactory::GetDecimalValue(
+                  TestingExecutorUtil::PopulatedValue(last_row, 2))));
+    val = (result_tile->GetValue(tuple_id, 5));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              val.CompareEquals(type::ValueFactory::GetDecimalValue(
+                  static_cast<double>(sum_b) / tuple_count)));
+  }
+}
+
+TEST_F(AggregateTests, HashVectorizedStringGroupByTest) {
+  // SELECT d, COUNT(*) from table GROUP BY d;
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  // Create a table with duplicated strings and wrap it in logical tiles
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), 2 * tuple_count, false,
+                                   true, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  std::vector<oid_t> group_by_columns = {3};
+  DirectMapList direct_map_list = {{0, {0, 3}}, {1, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_COUNT_STAR, nullptr);
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  auto data_table_schema = data_table.get()->GetSchema();
+  std::vector<catalog::Column> columns = {data_table_schema->GetColumn(3),
+                                          data_table_schema->GetColumn(0)};
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(columns));
+
+  planner::AggregatePlan node(std::move(proj_info), std::move(predicate),
+                              std::move(agg_terms), std::move(group_by_columns),
+                              output_table_schema, AggregateType::HASH);
+
+  // Strings are grouped by their IDs
+  EXPECT_TRUE(executor::VectorizedAggregator::IsSupported(
+      &node, source_logical_tile1.get()));
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::AggregateExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  EXPECT_TRUE(executor.Init());
+
+  EXPECT_TRUE(executor.Execute());
+
+  txn_manager.CommitTransaction(txn);
+
+  // Every string is in exactly one group, and all tuples are counted
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  ASSERT_TRUE(result_tile.get() != nullptr);
+  std::set<std::string> groups;
+  int64_t total_count = 0;
+  for (auto tuple_id : *result_tile) {
+    EXPECT_TRUE(groups.insert(result_tile->GetValue(tuple_id, 0).ToString())
+                    .second);
+    total_count += type::ValuePeeker::PeekInteger(
+        result_tile->GetValue(tuple_id, 1));
+  }
+  EXPECT_EQ(2 * tuple_count, total_count);
+}
+
+TEST_F(AggregateTests, VectorizedTupleAtATimeTest) {
+  // SELECT d, COUNT(*), SUM(b) from table GROUP BY d;
+  // The first tile is aggregated vectorized, the second tuple-at-a-time.
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), 2 * tuple_count, false,
+                                   true, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  std::vector<oid_t> group_by_columns = {3};
+  DirectMapList direct_map_list = {{0, {0, 3}}, {1, {1, 0}}, {2, {1, 1}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_COUNT_STAR, nullptr);
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_SUM,
+                         expression::ExpressionUtil::TupleValueFactory(
+                             type::TypeId::INTEGER, 0, 1));
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  auto data_table_schema = data_table.get()->GetSchema();
+  std::vector<catalog::Column> columns = {data_table_schema->GetColumn(3),
+                                          data_table_schema->GetColumn(0),
+                                          data_table_schema->GetColumn(1)};
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(columns));
+
+  planner::AggregatePlan node(std::move(proj_info), std::move(predicate),
+                              std::move(agg_terms), std::move(group_by_columns),
+                              output_table_schema, AggregateType::HASH);
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  std::unique_ptr<storage::TempTable> output_table(
+      storage::TableFactory::GetTempTable(
+          const_cast<catalog::Schema *>(node.GetOutputSchema()), false));
+
+  executor::VectorizedAggregator aggregator(
+      &node, output_table.get(), context.get(), source_logical_tile1.get());
+  EXPECT_TRUE(aggregator.AdvanceTile(source_logical_tile1.get()));
+  for (oid_t tuple_id : *source_logical_tile2) {
+    ContainerTuple<executor::LogicalTile> tuple(source_logical_tile2.get(),
+                                                tuple_id);
+    EXPECT_TRUE(aggregator.Advance(&tuple));
+  }
+  EXPECT_TRUE(aggregator.Finalize());
+  txn_manager.CommitTransaction(txn);
+
+  // Both paths put equal strings into the same group
+  int expected_sum = 0;
+  for (int row = 0; row < 2 * tuple_count; row++) {
+    expected_sum += TestingExecutorUtil::PopulatedValue(row, 1);
+  }
+  std::set<std::string> groups;
+  int64_t total_count = 0;
+  int64_t total_sum = 0;
+  for (oid_t offset = 0; offset < output_table->GetTileGroupCount();
+       offset++) {
+    auto tile_group = output_table->GetTileGroup(offset);
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+         tuple_id++) {
+      EXPECT_TRUE(
+          groups.insert(tile_group->GetValue(tuple_id, 0).ToString()).second);
+      total_count +=
+          type::ValuePeeker::PeekInteger(tile_group->GetValue(tuple_id, 1));
+      total_sum +=
+          type::ValuePeeker::PeekInteger(tile_group->GetValue(tuple_id, 2));
+    }
+  }
+  EXPECT_EQ(2 * tuple_count, total_count);
+  EXPECT_EQ(expected_sum, total_sum);
+}
+
 }  // namespace test
 }  // namespace peloton
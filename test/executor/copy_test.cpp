@@ -19,13 +19,18 @@
 #include "common/logger.h"
 #include "common/statement.h"
 #include "executor/copy_executor.h"
+#include "executor/copy_from_loader.h"
 #include "executor/executor_context.h"
 #include "executor/seq_scan_executor.h"
+#include "executor/testing_executor_util.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/rule.h"
 #include "parser/postgresparser.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "traffic_cop/traffic_cop.h"
+#include "util/string_util.h"
 
 #include "gtest/gtest.h"
 #include "statistics/testing_stats_util.h"
@@ -162,5 +167,287 @@ TEST_F(CopyTests, Copying) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(CopyTests, CopyFromStream) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true));
+
+  // Rows of (INTEGER, INTEGER, DECIMAL, VARCHAR), with a quoted delimiter in
+  // the string column
+  const int num_rows = 20;
+  std::string csv_data;
+  for (int i = 0; i < num_rows; i++) {
+    csv_data.append(StringUtil::Format("%d,%d,%d.5,\"row, %d\"\n", i, i * 10,
+                                       i, i));
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+  {
+    executor::CopyFromLoader loader(table.get(), txn, ',', '"', '"', true);
+
+    // Push the data the way CopyData messages would arrive
+    const uint32_t chunk_size = 7;
+    for (uint32_t pos = 0; pos < csv_data.size(); pos += chunk_size) {
+      auto len = std::min<uint32_t>(chunk_size, csv_data.size() - pos);
+      loader.Consume(csv_data.data() + pos, len);
+    }
+    loader.Finish();
+    EXPECT_EQ(num_rows, loader.GetNumRowsLoaded());
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(num_rows, table->GetTupleCount());
+
+  // The table was empty, so the rows were bulk loaded. The primary key index
+  // was built from all of them at once.
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  EXPECT_EQ(num_rows, index_entries.size());
+
+  // Check the values of the first row. Bulk loaded tile groups are appended
+  // behind the (still empty) active tile group.
+  auto tile_group = table->GetTileGroupById(index_entries[0]->block);
+  EXPECT_EQ(0, index_entries[0]->offset);
+  EXPECT_EQ(0, tile_group->GetValue(0, 0).GetAs<int32_t>());
+  EXPECT_EQ(0, tile_group->GetValue(0, 1).GetAs<int32_t>());
+  EXPECT_EQ(0.5, tile_group->GetValue(0, 2).GetAs<double>());
+  EXPECT_EQ("row, 0", tile_group->GetValue(0, 3).ToString());
+
+  // Loading a duplicate primary key fails
+  txn = txn_manager.BeginTransaction();
+  {
+    executor::CopyFromLoader loader(table.get(), txn);
+    std::string duplicate = "0,0,0.5,dup\n";
+    EXPECT_THROW(loader.Consume(duplicate.data(), duplicate.size()),
+                 ConstraintException);
+  }
+  txn_manager.AbortTransaction(txn);
+  EXPECT_EQ(num_rows, table->GetTupleCount());
+}
+
+TEST_F(CopyTests, CopyFromStreamTextFormat) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true));
+
+  // Rows of (INTEGER, INTEGER, DECIMAL, VARCHAR) in text format: tabs
+  // separate the columns, "\N" is NULL and special characters are escaped
+  std::string text_data =
+      "0\t0\t0.5\tplain\n"
+      "1\t10\t\\N\t\\N\n"
+      "2\t20\t2.5\ttab\\there, new\\nline\n"
+      "3\t30\t3.5\tback\\\\slash \\101\\x42\r\n"
+      "4\t40\t4.5\t\n"
+      "\\.\n";
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+  {
+    executor::CopyFromLoader loader(table.get(), txn, '\t', '"', '"', false,
+                                    ExternalFileFormat::TEXT);
+
+    // Lines and escape sequences may span chunks
+    const uint32_t chunk_size = 3;
+    for (uint32_t pos = 0; pos < text_data.size(); pos += chunk_size) {
+      auto len = std::min<uint32_t>(chunk_size, text_data.size() - pos);
+      loader.Consume(text_data.data() + pos, len);
+    }
+    loader.Finish();
+    EXPECT_EQ(5, loader.GetNumRowsLoaded());
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  ASSERT_EQ(5, index_entries.size());
+  std::vector<std::string> names(5);
+  for (auto *entry : index_entries) {
+    auto tile_group = table->GetTileGroupById(entry->block);
+    int32_t i = tile_group->GetValue(entry->offset, 0).GetAs<int32_t>();
+    EXPECT_EQ(i * 10, tile_group->GetValue(entry->offset, 1).GetAs<int32_t>());
+    auto name = tile_group->GetValue(entry->offset, 3);
+    if (i == 1) {
+      EXPECT_TRUE(tile_group->GetValue(entry->offset, 2).IsNull());
+      EXPECT_TRUE(name.IsNull());
+    } else {
+      EXPECT_EQ(i + 0.5,
+                tile_group->GetValue(entry->offset, 2).GetAs<double>());
+      EXPECT_FALSE(name.IsNull());
+      names[i] = name.ToString();
+    }
+  }
+  EXPECT_EQ("plain", names[0]);
+  EXPECT_EQ("tab\there, new\nline", names[2]);
+  EXPECT_EQ("back\\slash AB", names[3]);
+  EXPECT_EQ("", names[4]);
+
+  // A row with too few or too many columns is rejected
+  for (std::string bad_row : {"5\t50\t5.5\n", "5\t50\t5.5\ta\tb\n"}) {
+    txn = txn_manager.BeginTransaction();
+    {
+      executor::CopyFromLoader loader(table.get(), txn, '\t', '"', '"', false,
+                                      ExternalFileFormat::TEXT);
+      EXPECT_THROW(loader.Consume(bad_row.data(), bad_row.size()), Exception);
+    }
+    txn_manager.AbortTransaction(txn);
+  }
+}
+
+TEST_F(CopyTests, CopyFromStreamColumnLayout) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true));
+  table->ResetDefaultLayout(LayoutType::COLUMN);
+
+  const int num_rows = 20;
+  std::string csv_data;
+  for (int i = 0; i < num_rows; i++) {
+    csv_data.append(StringUtil::Format("%d,%d,%d.5,\"row, %d\"\n", i, i * 10,
+                                       i, i));
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+  {
+    executor::CopyFromLoader loader(table.get(), txn, ',', '"', '"', true);
+    loader.Consume(csv_data.data(), csv_data.size());
+    loader.Finish();
+    EXPECT_EQ(num_rows, loader.GetNumRowsLoaded());
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // Tile groups that aren't row stores get every attribute in its own tile
+  std::vector<ItemPointer *> index_entries;
+  table->GetIndex(0)->ScanAllKeys(index_entries);
+  ASSERT_EQ(num_rows, index_entries.size());
+  uint32_t num_column_store_rows = 0;
+  for (auto *entry : index_entries) {
+    auto tile_group = table->GetTileGroupById(entry->block);
+    if (tile_group->GetLayout().IsColumnStore()) {
+      num_column_store_rows++;
+    }
+    int32_t i = tile_group->GetValue(entry->offset, 0).GetAs<int32_t>();
+    EXPECT_EQ(i * 10, tile_group->GetValue(entry->offset, 1).GetAs<int32_t>());
+    EXPECT_EQ(i + 0.5, tile_group->GetValue(entry->offset, 2).GetAs<double>());
+    EXPECT_EQ(StringUtil::Format("row, %d", i),
+              tile_group->GetValue(entry->offset, 3).ToString());
+  }
+  EXPECT_LT(0, num_column_store_rows);
+}
+
+TEST_F(CopyTests, CopyFromStreamBulkLoadViolation) {
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true));
+
+  // The duplicate primary key is only detected when the rows are published
+  std::string csv_data;
+  for (int i = 0; i < 10; i++) {
+    csv_data.append(StringUtil::Format("%d,0,0.5,a\n", i));
+  }
+  csv_data.append("3,0,0.5,dup\n");
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+  {
+    executor::CopyFromLoader loader(table.get(), txn, ',', '"', '"', true);
+    loader.Consume(csv_data.data(), csv_data.size());
+    EXPECT_THROW(loader.Finish(), ConstraintException);
+  }
+  txn_manager.AbortTransaction(txn);
+
+  // Nothing was published, and the indexes were left empty
+  EXPECT_EQ(0, table->GetTupleCount());
+  EXPECT_TRUE(table->IsEmpty());
+  for (oid_t index_itr = 0; index_itr < table->GetIndexCount(); index_itr++) {
+    std::vector<ItemPointer *> index_entries;
+    table->GetIndex(index_itr)->ScanAllKeys(index_entries);
+    EXPECT_EQ(0, index_entries.size());
+  }
+}
+
+TEST_F(CopyTests, CopyFromStreamAbort) {
+  // Whether bulk loaded or not, the rows belong to the loading transaction
+  for (bool bulk_load : {false, true}) {
+    std::unique_ptr<storage::DataTable> table(
+        TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true));
+
+    const int num_rows = 12;
+    std::string csv_data;
+    for (int i = 0; i < num_rows; i++) {
+      csv_data.append(StringUtil::Format("%d,0,0.5,a\n", i));
+    }
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto *txn = txn_manager.BeginTransaction();
+    auto *other_txn = txn_manager.BeginTransaction();
+    {
+      executor::CopyFromLoader loader(table.get(), txn, ',', '"', '"',
+                                      bulk_load);
+      loader.Consume(csv_data.data(), csv_data.size());
+
+      // Other transactions can't insert while the table is bulk loaded
+      auto tuple = TestingExecutorUtil::GetTuple(table.get(), num_rows, nullptr);
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer location =
+          table->InsertTuple(tuple.get(), other_txn, &index_entry_ptr);
+      EXPECT_EQ(bulk_load, location.IsNull());
+      if (!location.IsNull()) {
+        txn_manager.PerformInsert(other_txn, location, index_entry_ptr);
+      }
+
+      loader.Finish();
+      EXPECT_EQ(num_rows, loader.GetNumRowsLoaded());
+    }
+
+    // The lock is held until the loading transaction ends, not just as long
+    // as the loader lives
+    {
+      auto tuple =
+          TestingExecutorUtil::GetTuple(table.get(), num_rows + 1, nullptr);
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer location =
+          table->InsertTuple(tuple.get(), other_txn, &index_entry_ptr);
+      EXPECT_EQ(bulk_load, location.IsNull());
+      if (!location.IsNull()) {
+        txn_manager.PerformInsert(other_txn, location, index_entry_ptr);
+      }
+    }
+    txn_manager.AbortTransaction(other_txn);
+
+    // The rows are in the indexes, but only the loading transaction sees them
+    std::vector<ItemPointer *> index_entries;
+    table->GetIndex(0)->ScanAllKeys(index_entries);
+    EXPECT_LE(num_rows, index_entries.size());
+
+    auto *reader_txn = txn_manager.BeginTransaction();
+    for (auto *entry : index_entries) {
+      auto tile_group = table->GetTileGroupById(entry->block);
+      EXPECT_EQ(VisibilityType::INVISIBLE,
+                txn_manager.IsVisible(reader_txn, tile_group->GetHeader(),
+                                      entry->offset));
+    }
+    txn_manager.CommitTransaction(reader_txn);
+
+    // Nothing is left behind once the load is rolled back
+    txn_manager.AbortTransaction(txn);
+    reader_txn = txn_manager.BeginTransaction();
+    for (auto *entry : index_entries) {
+      auto tile_group = table->GetTileGroupById(entry->block);
+      EXPECT_EQ(VisibilityType::INVISIBLE,
+                txn_manager.IsVisible(reader_txn, tile_group->GetHeader(),
+                                      entry->offset));
+    }
+    txn_manager.CommitTransaction(reader_txn);
+
+    // Other transactions can insert again
+    auto *writer_txn = txn_manager.BeginTransaction();
+    auto tuple =
+        TestingExecutorUtil::GetTuple(table.get(), num_rows + 2, nullptr);
+    ItemPointer *index_entry_ptr = nullptr;
+    ItemPointer location =
+        table->InsertTuple(tuple.get(), writer_txn, &index_entry_ptr);
+    EXPECT_FALSE(location.IsNull());
+    txn_manager.PerformInsert(writer_txn, location, index_entry_ptr);
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(writer_txn));
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -21,6 +21,8 @@
 #include "expression/function_expression.h"
 #include "expression/comparison_expression.h"
 #include "expression/case_expression.h"
+#include "function/date_functions.h"
+#include "function/numeric_functions.h"
 #include "type/value.h"
 #include "type/value_factory.h"
 #include "storage/tuple.h"
@@ -387,5 +389,32 @@ TEST_F(ExpressionTests, SimpleCaseWithDefault) {
   EXPECT_EQ(CmpBool::CmpTrue, expected.CompareEquals(result));
 }
 
+TEST_F(ExpressionTests, DeterministicTest) {
+  // a = abs(a) only depends on the value of a
+  auto abs_expr = new expression::FunctionExpression(
+      function::BuiltInFuncType{OperatorId::Abs,
+                                function::NumericFunctions::_Abs},
+      type::TypeId::INTEGER, {type::TypeId::INTEGER},
+      {new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0)});
+  std::unique_ptr<expression::ComparisonExpression> abs_cmp(
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_EQUAL,
+          new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0),
+          abs_expr));
+  EXPECT_TRUE(abs_cmp->IsDeterministic());
+
+  // a < now() changes over time, even for the same value of a
+  auto now_expr = new expression::FunctionExpression(
+      function::BuiltInFuncType{OperatorId::Now, function::DateFunctions::_Now},
+      type::TypeId::TIMESTAMP, {}, {});
+  std::unique_ptr<expression::ComparisonExpression> now_cmp(
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_LESSTHAN,
+          new expression::TupleValueExpression(type::TypeId::TIMESTAMP, 0, 0),
+          now_expr));
+  EXPECT_FALSE(now_expr->IsDeterministic());
+  EXPECT_FALSE(now_cmp->IsDeterministic());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -17,6 +17,7 @@
 #include "common/harness.h"
 
 #include "executor/executor_context.h"
+#include "function/like_pattern.h"
 #include "function/string_functions.h"
 #include "function/old_engine_string_functions.h"
 
@@ -72,6 +73,58 @@ TEST_F(StringFunctionsTests, LikeTest) {
       GetExecutorContext(), s4.c_str(), s4.size(), p4.c_str(), p4.size()));
 }
 
+TEST_F(StringFunctionsTests, LikePatternTest) {
+  using Kind = function::LikePattern::Kind;
+  struct {
+    std::string pattern;
+    Kind kind;
+  } patterns[] = {{"error", Kind::EXACT},
+                  {"error%", Kind::PREFIX},
+                  {"%error", Kind::SUFFIX},
+                  {"%error%", Kind::CONTAINS},
+                  {"%%", Kind::CONTAINS},
+                  {"e_ror%", Kind::GENERAL},
+                  {"%err%or%", Kind::GENERAL},
+                  {"100\\%", Kind::EXACT}};
+  for (const auto &p : patterns) {
+    function::LikePattern pattern{p.pattern.c_str(),
+                                  static_cast<uint32_t>(p.pattern.size())};
+    EXPECT_EQ(p.kind, pattern.GetKind()) << p.pattern;
+  }
+
+  // The terminating '\0' of VARCHAR values is not part of the pattern or the
+  // string, and letters match regardless of their case
+  function::LikePattern contains{"%Error%", 8};
+  EXPECT_TRUE(contains.Match("an ERROR occurred", 18));
+  EXPECT_TRUE(contains.Match("error", 5));
+  EXPECT_FALSE(contains.Match("errr", 5));
+  EXPECT_FALSE(contains.Match("", 1));
+
+  // Long strings are searched a block at a time, with the match anywhere
+  for (uint32_t pos = 0; pos < 100; pos++) {
+    std::string text(100, 'x');
+    text.replace(pos, 5, "eRrOr");
+    text.resize(100);
+    bool expected = pos <= 95;
+    EXPECT_EQ(expected, contains.Match(text.c_str(), text.size())) << pos;
+
+    function::LikePattern general{"%x_r%or%", 8};
+    EXPECT_EQ(expected && pos > 0,
+              general.Match(text.c_str(), text.size()))
+        << pos;
+  }
+
+  // Digits and punctuation are compared as they are
+  function::LikePattern prefix{"[42]%", 5};
+  EXPECT_TRUE(prefix.Match("[42] done", 9));
+  EXPECT_FALSE(prefix.Match("[4] done", 8));
+
+  // A trailing escape character matches nothing
+  function::LikePattern broken{"abc\\", 4};
+  EXPECT_FALSE(broken.Match("abc", 3));
+  EXPECT_FALSE(broken.Match("abc\\", 4));
+}
+
 TEST_F(StringFunctionsTests, AsciiTest) {
   const char column_char = 'A';
   for (int i = 0; i < 52; i++) {
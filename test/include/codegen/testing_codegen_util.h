@@ -100,6 +100,12 @@ class PelotonCodeGenTest : public PelotonTest {
   void LoadTestTable(oid_t table_id, uint32_t num_rows,
                      bool insert_nulls = false);
 
+  // Load the given table with the given number of rows, in which column "d"
+  // only takes the values "name0" to "name<num_names - 1>", then freeze every
+  // full tile group of the table so that it stores "d" with a dictionary
+  void LoadFrozenTestTable(oid_t table_id, uint32_t num_rows,
+                           uint32_t num_names);
+
   // Load tables with the specified layout
   void CreateAndLoadTableWithLayout(peloton::LayoutType layout_type,
                                     oid_t tuples_per_tilegroup,
@@ -62,11 +62,25 @@ class TestingSQLUtil {
       std::vector<FieldInfo> &tuple_descriptor, int &rows_changed,
       std::string &error_message);
 
+  // Execute an already parsed SQL query end-to-end with the specific optimizer,
+  // for queries the parser can't produce
+  static ResultType ExecuteSQLQueryWithOptimizer(
+      std::unique_ptr<optimizer::AbstractOptimizer> &optimizer,
+      std::unique_ptr<parser::SQLStatementList> parsed_stmt,
+      std::vector<ResultValue> &result,
+      std::vector<FieldInfo> &tuple_descriptor, int &rows_changed,
+      std::string &error_message);
+
   // Generate the plan tree for a SQL query with the specific optimizer
   static std::shared_ptr<planner::AbstractPlan> GeneratePlanWithOptimizer(
       std::unique_ptr<optimizer::AbstractOptimizer> &optimizer,
       const std::string query, concurrency::TransactionContext *txn);
 
+  static std::shared_ptr<planner::AbstractPlan> GeneratePlanWithOptimizer(
+      std::unique_ptr<optimizer::AbstractOptimizer> &optimizer,
+      std::unique_ptr<parser::SQLStatementList> parsed_stmt,
+      concurrency::TransactionContext *txn);
+
   // A simpler wrapper around ExecuteSQLQuery
   static ResultType ExecuteSQLQuery(const std::string query,
                                     std::vector<ResultValue> &result);
@@ -74,6 +88,11 @@ class TestingSQLUtil {
   // A another simpler wrapper around ExecuteSQLQuery
   static ResultType ExecuteSQLQuery(const std::string query);
 
+  // Execute a SQL query end-to-end as a query of the simple query protocol,
+  // which may share its plan with other queries through the plan cache
+  static ResultType ExecuteSimpleSQLQuery(const std::string query,
+                                          std::vector<ResultValue> &result);
+
   // Executes a query and compares the result with the given rows, either
   // ordered or not
   // The result vector has to be specified as follows:
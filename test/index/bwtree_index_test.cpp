@@ -13,6 +13,9 @@
 #include "common/harness.h"
 #include "gtest/gtest.h"
 
+#include "concurrency/epoch_manager_factory.h"
+#include "index/bwtree.h"
+
 #include "index/testing_index_util.h"
 #include "index/testing_index_util.h"
 
@@ -65,5 +68,39 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, EpochGarbageCollectionTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+  epoch_manager.SetCurrentEpochId(1);
+  epoch_manager.RegisterThread(0);
+
+  // A transaction that could still read the nodes being unlinked
+  epoch_manager.SetCurrentEpochId(2);
+  cid_t txn_id = epoch_manager.EnterEpoch(0, TimestampType::READ);
+  eid_t epoch_id = txn_id >> 32;
+
+  index::BwTree<int64_t, int64_t> tree{false};
+  for (int64_t i = 0; i < 1000; i++) {
+    EXPECT_TRUE(tree.Insert(i, i));
+  }
+  for (int64_t i = 0; i < 1000; i++) {
+    EXPECT_TRUE(tree.Delete(i, i));
+  }
+
+  // Consolidations and splits have unlinked nodes, which must be kept until
+  // the transaction exits its epoch
+  EXPECT_TRUE(tree.NeedGarbageCollection());
+  tree.PerformGarbageCollection();
+  EXPECT_TRUE(tree.NeedGarbageCollection());
+
+  epoch_manager.ExitEpoch(0, epoch_id);
+  epoch_manager.SetCurrentEpochId(3);
+
+  tree.PerformGarbageCollection();
+  EXPECT_FALSE(tree.NeedGarbageCollection());
+
+  epoch_manager.DeregisterThread(0);
+}
+
 }  // namespace test
 }  // namespace peloton
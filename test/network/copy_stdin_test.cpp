@@ -0,0 +1,198 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// copy_stdin_test.cpp
+//
+// Identification: test/network/copy_stdin_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <thread>
+#include <pqxx/pqxx> /* libpqxx is used to instantiate C++ client */
+
+#include "common/harness.h"
+#include "common/logger.h"
+#include "gtest/gtest.h"
+#include "network/peloton_server.h"
+#include "network/postgres_protocol_handler.h"
+#include "util/string_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// COPY FROM STDIN / COPY TO STDOUT Tests
+//===--------------------------------------------------------------------===//
+
+class CopyStdinTests : public PelotonTest {};
+
+/**
+ * Stream rows in with COPY FROM STDIN, then back out with COPY TO STDOUT.
+ * The client sends both statements without any options. There are enough
+ * rows for the server to send them out in several chunks.
+ */
+void *CopyStdinTest(int port) {
+  try {
+    pqxx::connection C(StringUtil::Format(
+        "host=127.0.0.1 port=%d user=default_database sslmode=disable "
+        "application_name=psql",
+        port));
+
+    const size_t num_rows = 20000;
+
+    pqxx::work txn1(C);
+    txn1.exec("DROP TABLE IF EXISTS copy_test;");
+    txn1.exec("CREATE TABLE copy_test(id INT);");
+    txn1.commit();
+
+    // COPY runs as its own transaction, so it must not be in a BEGIN block
+    {
+      pqxx::nontransaction txn2(C);
+      pqxx::tablewriter writer(txn2, "copy_test");
+      for (size_t i = 0; i < num_rows; i++) {
+        writer.push_back(std::vector<std::string>{std::to_string(i)});
+      }
+      writer.complete();
+    }
+
+    pqxx::work txn3(C);
+    pqxx::result R = txn3.exec("SELECT id FROM copy_test;");
+    txn3.commit();
+    EXPECT_EQ(num_rows, R.size());
+
+    std::vector<int> ids;
+    {
+      pqxx::nontransaction txn4(C);
+      pqxx::tablereader reader(txn4, "copy_test");
+      std::vector<std::string> row;
+      while (reader >> row) {
+        EXPECT_EQ(1U, row.size());
+        ids.push_back(std::stoi(row[0]));
+        row.clear();
+      }
+      reader.complete();
+    }
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(num_rows, ids.size());
+    for (int i = 0; i < static_cast<int>(ids.size()); i++) {
+      EXPECT_EQ(i, ids[i]);
+    }
+
+  } catch (const std::exception &e) {
+    LOG_INFO("[CopyStdinTest] Exception occurred: %s", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  LOG_INFO("[CopyStdinTest] Client has closed");
+  return NULL;
+}
+
+/**
+ * Stream rows with several columns in Postgres' text format, which is what
+ * clients send for a COPY without options. Attributes contain NULLs, empty
+ * strings and escaped delimiters.
+ */
+void *CopyStdinTextFormatTest(int port) {
+  try {
+    pqxx::connection C(StringUtil::Format(
+        "host=127.0.0.1 port=%d user=default_database sslmode=disable "
+        "application_name=psql",
+        port));
+
+    pqxx::work txn1(C);
+    txn1.exec("DROP TABLE IF EXISTS copy_text_test;");
+    txn1.exec(
+        "CREATE TABLE copy_text_test(id INT, name VARCHAR(32), "
+        "score DECIMAL);");
+    txn1.commit();
+
+    // Tab-separated, "\N" is NULL and special characters are escaped
+    std::vector<std::string> lines = {
+        "1\tplain\t1.5",
+        "2\t\\N\t\\N",
+        "3\twith\\ttab\t2.5",
+        "4\tback\\\\slash, comma\t\\N",
+        "5\t\t3.5",
+    };
+    {
+      pqxx::nontransaction txn2(C);
+      pqxx::tablewriter writer(txn2, "copy_text_test");
+      for (const auto &line : lines) {
+        writer.write_raw_line(line);
+      }
+      writer.complete();
+    }
+
+    pqxx::work txn3(C);
+    pqxx::result R = txn3.exec(
+        "SELECT id, name, score FROM copy_text_test WHERE id < 5 ORDER BY "
+        "id;");
+    txn3.commit();
+    EXPECT_EQ(4U, R.size());
+    EXPECT_EQ("plain", R[0][1].as<std::string>());
+    EXPECT_TRUE(R[1][1].is_null());
+    EXPECT_TRUE(R[1][2].is_null());
+    EXPECT_EQ("with\ttab", R[2][1].as<std::string>());
+    EXPECT_EQ("back\\slash, comma", R[3][1].as<std::string>());
+    EXPECT_TRUE(R[3][2].is_null());
+
+    // The rows come back out exactly the way they went in. This also tells
+    // the empty string apart from NULL.
+    std::vector<std::string> out_lines;
+    {
+      pqxx::nontransaction txn4(C);
+      pqxx::tablereader reader(txn4, "copy_text_test");
+      std::string line;
+      while (reader.get_raw_line(line)) {
+        out_lines.push_back(line);
+      }
+      reader.complete();
+    }
+    std::sort(out_lines.begin(), out_lines.end());
+    EXPECT_EQ(lines, out_lines);
+
+    // Binary format isn't supported
+    pqxx::nontransaction txn5(C);
+    EXPECT_THROW(txn5.exec("COPY copy_text_test FROM STDIN WITH (FORMAT "
+                           "binary);"),
+                 pqxx::sql_error);
+
+  } catch (const std::exception &e) {
+    LOG_INFO("[CopyStdinTextFormatTest] Exception occurred: %s", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  LOG_INFO("[CopyStdinTextFormatTest] Client has closed");
+  return NULL;
+}
+
+TEST_F(CopyStdinTests, CopyStdinTest) {
+  peloton::PelotonInit::Initialize();
+  LOG_INFO("Server initialized");
+  peloton::network::PelotonServer server;
+
+  int port = 15721;
+  try {
+    server.SetPort(port);
+    server.SetupServer();
+  } catch (peloton::ConnectionException &exception) {
+    LOG_INFO("[LaunchServer] exception when launching server");
+  }
+  std::thread serverThread([&]() { server.ServerLoop(); });
+
+  CopyStdinTest(port);
+  CopyStdinTextFormatTest(port);
+
+  server.Close();
+  serverThread.join();
+  LOG_INFO("Peloton is shutting down");
+  peloton::PelotonInit::Shutdown();
+  LOG_INFO("Peloton has shut down");
+}
+
+}  // namespace test
+}  // namespace peloton
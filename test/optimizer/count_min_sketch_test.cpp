@@ -77,5 +77,27 @@ TEST_F(CountMinSketchTests, SimpleCountMinSketchMixTest) {
   sketch.Remove("1", 3);
   EXPECT_EQ(sketch.size, 3);
 }
+
+TEST_F(CountMinSketchTests, MergeTest) {
+  CountMinSketch sketch1(10, 20, 0), sketch2(10, 20, 0);
+
+  sketch1.Add(1, 10);
+  sketch1.Add("two", 5);
+  sketch2.Add(1, 3);
+  sketch2.Add(4, 1000000);
+
+  sketch1.Merge(sketch2);
+
+  // This case count min sketch should give exact counting
+  EXPECT_EQ(sketch1.EstimateItemCount(1), 13);
+  EXPECT_EQ(sketch1.EstimateItemCount("two"), 5);
+  EXPECT_EQ(sketch1.EstimateItemCount(4), 1000000);
+
+  // Sketches of different dimensions can't be merged
+  CountMinSketch narrow(10, 10, 0), shallow(5, 20, 0);
+  EXPECT_THROW(sketch1.Merge(narrow), StatException);
+  EXPECT_THROW(sketch1.Merge(shallow), StatException);
+  EXPECT_EQ(sketch1.EstimateItemCount(1), 13);
+}
 }
 }
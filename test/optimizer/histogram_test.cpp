@@ -141,5 +141,26 @@ TEST_F(HistogramTests, SumTest) {
   EXPECT_EQ(h.Sum(6), 1);
 }
 
+// Histograms built over two halves of a uniform distribution, merged.
+TEST_F(HistogramTests, MergeTest) {
+  Histogram h1{}, h2{};
+  int n = 100000;
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int> distribution(1, 100);
+  for (int i = 0; i < n; i++) {
+    int number = distribution(generator);
+    (i % 2 == 0 ? h1 : h2).Update(number);
+  }
+  h1.Merge(h2);
+  EXPECT_EQ(n, h1.GetTotalValueCount());
+  EXPECT_EQ(1, h1.GetMinValue());
+  EXPECT_EQ(100, h1.GetMaxValue());
+  std::vector<double> res = h1.Uniform();
+  EXPECT_EQ(99, res.size());
+  for (int i = 1; i < 100; i++) {
+    EXPECT_NEAR(i, res[i - 1], 1.0);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -24,6 +24,7 @@
 #include "expression/tuple_value_expression.h"
 #include "optimizer/mock_task.h"
 #include "optimizer/operators.h"
+#include "optimizer/optimizer_task.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/rule_impls.h"
 #include "parser/mock_sql_statement.h"
@@ -35,6 +36,7 @@
 #include "planner/insert_plan.h"
 #include "planner/seq_scan_plan.h"
 #include "planner/update_plan.h"
+#include "settings/settings_manager.h"
 #include "sql/testing_sql_util.h"
 #include "traffic_cop/traffic_cop.h"
 
@@ -475,6 +477,162 @@ TEST_F(OptimizerTests, PredicatePushDownRewriteTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(OptimizerTests, JoinEnumerationTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  for (int i = 1; i <= 4; i++) {
+    TestingSQLUtil::ExecuteSQLQuery("CREATE TABLE t" + std::to_string(i) +
+                                    "(a INT PRIMARY KEY, b INT, c INT);");
+  }
+
+  // A chain of four tables
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto stmt = peloton_parser.BuildParseTree(
+      "SELECT * FROM t1, t2, t3, t4 WHERE t1.a = t2.a AND t2.b = t3.b AND "
+      "t3.c = t4.c");
+  auto parse_tree = stmt->GetStatement(0);
+
+  optimizer::Optimizer optimizer;
+  txn = txn_manager.BeginTransaction();
+  optimizer.GetMetadata().txn = txn;
+
+  auto bind_node_visitor = binder::BindNodeVisitor(txn, DEFAULT_DB_NAME);
+  bind_node_visitor.BindNameToNode(parse_tree);
+
+  std::shared_ptr<GroupExpression> gexpr =
+      optimizer.TestInsertQueryTree(parse_tree, txn);
+
+  std::shared_ptr<OptimizeContext> root_context =
+      std::make_shared<OptimizeContext>(&(optimizer.GetMetadata()), nullptr);
+  auto task_stack =
+      std::unique_ptr<OptimizerTaskStack>(new OptimizerTaskStack());
+  optimizer.GetMetadata().SetTaskPool(task_stack.get());
+  task_stack->Push(new EnumerateJoinOrder(gexpr->GetGroupID(), root_context));
+  task_stack->Push(new TopDownRewrite(gexpr->GetGroupID(), root_context,
+                                      RewriteRuleSetName::PREDICATE_PUSH_DOWN));
+
+  while (!task_stack->Empty()) {
+    auto task = task_stack->Pop();
+    task->execute();
+  }
+
+  // Every connected subgraph of the chain has exactly one group, with a join
+  // expression in both orders for every way to split it into two connected
+  // subgraphs
+  auto &memo = optimizer.GetMetadata().memo;
+  Rule *commutativity = nullptr;
+  for (auto &rule : optimizer.GetMetadata().rule_set.GetTransformationRules()) {
+    if (rule->GetType() == RuleType::INNER_JOIN_COMMUTE) {
+      commutativity = rule.get();
+    }
+  }
+  ASSERT_NE(nullptr, commutativity);
+
+  std::vector<std::unordered_set<std::string>> join_groups;
+  for (auto &group : memo.Groups()) {
+    auto exprs = group->GetLogicalExpressions();
+    if (exprs.empty() || exprs[0]->Op().GetType() != OpType::InnerJoin) {
+      continue;
+    }
+    for (auto &joined : join_groups) {
+      EXPECT_NE(joined, group->GetTableAliases());
+    }
+    join_groups.push_back(group->GetTableAliases());
+
+    // Splits of a chain of n tables into two chains
+    size_t num_splits = group->GetTableAliases().size() - 1;
+    EXPECT_EQ(2 * num_splits, exprs.size());
+    for (auto &expr : exprs) {
+      EXPECT_TRUE(expr->HasRuleExplored(commutativity));
+    }
+  }
+  EXPECT_EQ(6, join_groups.size());
+
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(OptimizerTests, ConcurrentTaskPoolTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  for (int i = 1; i <= 4; i++) {
+    TestingSQLUtil::ExecuteSQLQuery("CREATE TABLE t" + std::to_string(i) +
+                                    "(a INT PRIMARY KEY, b INT, c INT);");
+  }
+
+  // Explore the join orders with the transformation rules, which gives the
+  // workers plenty of groups to race for
+  settings::SettingsManager::SetInt(
+      settings::SettingId::max_dphyp_join_relations, 0);
+
+  auto optimize = [&txn_manager](int num_threads) {
+    settings::SettingsManager::SetInt(
+        settings::SettingId::optimizer_task_threads, num_threads);
+
+    auto &peloton_parser = parser::PostgresParser::GetInstance();
+    auto stmt = peloton_parser.BuildParseTree(
+        "SELECT * FROM t1, t2, t3, t4 WHERE t1.a = t2.a AND t2.b = t3.b AND "
+        "t3.c = t4.c");
+    auto parse_tree = stmt->GetStatement(0);
+
+    optimizer::Optimizer optimizer;
+    auto txn = txn_manager.BeginTransaction();
+    optimizer.GetMetadata().txn = txn;
+
+    auto bind_node_visitor = binder::BindNodeVisitor(txn, DEFAULT_DB_NAME);
+    bind_node_visitor.BindNameToNode(parse_tree);
+
+    auto gexpr = optimizer.TestInsertQueryTree(parse_tree, txn);
+    auto root_group_id = gexpr->GetGroupID();
+    auto required_props = std::make_shared<PropertySet>();
+    optimizer.OptimizeLoop(root_group_id, required_props);
+
+    auto best_expr = optimizer.GetMetadata()
+                         .memo.GetGroupByID(root_group_id)
+                         ->GetBestExpression(required_props);
+    EXPECT_NE(nullptr, best_expr);
+    double cost = (best_expr != nullptr ? best_expr->GetCost(required_props)
+                                        : -1);
+
+    txn_manager.CommitTransaction(txn);
+    return cost;
+  };
+
+  // The search space is the same no matter how many threads explore it
+  double expected_cost = optimize(1);
+  for (int run = 0; run < 5; run++) {
+    EXPECT_DOUBLE_EQ(expected_cost, optimize(4));
+  }
+
+  settings::SettingsManager::SetInt(
+      settings::SettingId::optimizer_task_threads, 1);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::max_dphyp_join_relations, 12);
+}
+
+TEST_F(OptimizerTests, SuspendTaskErrorTest) {
+  // Currently need database for test teardown
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  // A task that is parked where no worker would ever resume it must fail the
+  // optimization rather than vanish
+  optimizer::test::MockTask task;
+  OptimizerTaskStack task_stack;
+  EXPECT_THROW(task_stack.Suspend(&task), OptimizerException);
+  EXPECT_THROW(task_stack.Resume(&task), OptimizerException);
+
+  ConcurrentOptimizerTaskPool task_pool(2);
+  EXPECT_THROW(task_pool.Suspend(&task), OptimizerException);
+}
+
 TEST_F(OptimizerTests, ExecuteTaskStackTest) {
   // Currently need database for test teardown
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
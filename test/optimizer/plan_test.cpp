@@ -13,6 +13,7 @@
 
 #include "optimizer_test_util.cpp"
 #include "planner/abstract_scan_plan.h"
+#include "planner/aggregate_plan.h"
 
 namespace peloton {
 namespace test {
@@ -281,6 +282,49 @@ TEST_F(PlanTest, PostgresThreeJoinOrderTestSmall) {
   EXPECT_EQ(test3_table_name, right_scan->GetTable()->GetName().c_str());
 }
 
+// Sort-based operators need sorted input, so they must not win over their
+// hash-based counterparts when the sort has to be added for them
+TEST_F(PlanTest, UnsortedInputPrefersHashOperatorsTest) {
+  std::string test1_table_name = "test1";
+  std::string test2_table_name = "test2";
+  OptimizerTestUtil::CreateTable(test1_table_name, 10);
+  OptimizerTestUtil::CreateTable(test2_table_name, 100);
+  OptimizerTestUtil::AnalyzeTable(test1_table_name);
+  OptimizerTestUtil::AnalyzeTable(test2_table_name);
 
+  // Return the first plan node of the given type, in pre-order
+  std::function<planner::AbstractPlan *(planner::AbstractPlan *, PlanNodeType)>
+      find_node = [&find_node](planner::AbstractPlan *plan,
+                               PlanNodeType type) -> planner::AbstractPlan * {
+    if (plan->GetPlanNodeType() == type) return plan;
+    for (auto &child : plan->GetChildren()) {
+      auto *node = find_node(child.get(), type);
+      if (node != nullptr) return node;
+    }
+    return nullptr;
+  };
+
+  for (auto cost_model :
+       {optimizer::CostModels::DEFAULT, optimizer::CostModels::POSTGRES}) {
+    OptimizerTestUtil::SetCostModel(cost_model);
+
+    // Nothing provides the order of b, so the group by hashes
+    auto plan =
+        OptimizerTestUtil::GeneratePlan("SELECT b, COUNT(*) FROM test2 GROUP BY b");
+    auto *agg_plan = dynamic_cast<planner::AggregatePlan *>(
+        find_node(plan.get(), PlanNodeType::AGGREGATE_V2));
+    ASSERT_NE(nullptr, agg_plan);
+    EXPECT_EQ(AggregateType::HASH, agg_plan->GetAggregateStrategy());
+    EXPECT_EQ(nullptr, find_node(plan.get(), PlanNodeType::ORDERBY));
+
+    // Same for the join keys
+    plan = OptimizerTestUtil::GeneratePlan(
+        OptimizerTestUtil::CreateTwoWayJoinQuery(test1_table_name,
+                                                 test2_table_name, "b", "b"));
+    EXPECT_EQ(nullptr, find_node(plan.get(), PlanNodeType::MERGEJOIN));
+    EXPECT_NE(nullptr, find_node(plan.get(), PlanNodeType::HASHJOIN));
+  }
+}
+
+}
 }
-}
\ No newline at end of file
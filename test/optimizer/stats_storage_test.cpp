@@ -12,6 +12,7 @@
 
 #include "common/harness.h"
 
+#include "optimizer/stats/auto_analyzer.h"
 #include "optimizer/stats/stats_storage.h"
 #include "optimizer/stats/column_stats.h"
 #include "optimizer/stats/table_stats.h"
@@ -252,5 +253,94 @@ TEST_F(StatsStorageTests, GetTableStatsTest) {
   EXPECT_EQ(table_stats->num_rows, tuple_count);
 }
 
+TEST_F(StatsStorageTests, AbortedAnalyzeTest) {
+  auto data_table = InitializeTestTable();
+  StatsStorage *stats_storage = StatsStorage::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // The stats are not cached before the analyzing transaction commits, and
+  // never if it aborts
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(ResultType::SUCCESS,
+            stats_storage->AnalyzeStatsForTable(data_table.get(), txn));
+  txn_manager.AbortTransaction(txn);
+
+  txn = txn_manager.BeginTransaction();
+  auto table_stats = stats_storage->GetTableStats(
+      data_table->GetDatabaseOid(), data_table->GetOid(), txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(0U, table_stats->GetColumnCount());
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(ResultType::SUCCESS,
+            stats_storage->AnalyzeStatsForTable(data_table.get(), txn));
+  txn_manager.CommitTransaction(txn);
+
+  txn = txn_manager.BeginTransaction();
+  table_stats = stats_storage->GetTableStats(data_table->GetDatabaseOid(),
+                                             data_table->GetOid(), txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(4U, table_stats->GetColumnCount());
+  EXPECT_EQ(tuple_count, table_stats->num_rows);
+}
+
+TEST_F(StatsStorageTests, StaleCachedStatsTest) {
+  StatsStorage *stats_storage = StatsStorage::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  oid_t database_id = 1;
+  oid_t table_id = 4;
+
+  // A transaction that started before the stats changed reads the old ones,
+  // which must not be cached for the transactions that come after it
+  auto old_txn = txn_manager.BeginTransaction();
+  auto txn = txn_manager.BeginTransaction();
+  stats_storage->InsertOrUpdateColumnStats(database_id, table_id, 0, 10, 8,
+                                           0.5, "", "", "", "random", false,
+                                           txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto table_stats =
+      stats_storage->GetTableStats(database_id, table_id, old_txn);
+  txn_manager.CommitTransaction(old_txn);
+  EXPECT_EQ(0U, table_stats->GetColumnCount());
+
+  txn = txn_manager.BeginTransaction();
+  table_stats = stats_storage->GetTableStats(database_id, table_id, txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(1U, table_stats->GetColumnCount());
+}
+
+TEST_F(StatsStorageTests, AutoAnalyzeTest) {
+  auto &auto_analyzer = AutoAnalyzer::GetInstance();
+  auto_analyzer.ClearTables();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_per_tilegroup, false));
+  auto_analyzer.AddTable(data_table.get());
+
+  // Nothing changed since the table was registered
+  EXPECT_EQ(0, auto_analyzer.AnalyzeTables());
+
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(tuple_count, data_table->GetModificationCount());
+
+  // The inserts are enough to analyze the table again
+  EXPECT_EQ(1, auto_analyzer.AnalyzeTables());
+  txn = txn_manager.BeginTransaction();
+  auto table_stats = StatsStorage::GetInstance()->GetTableStats(
+      data_table->GetDatabaseOid(), data_table->GetOid(), txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(tuple_count, table_stats->num_rows);
+
+  // The table has not changed since
+  EXPECT_EQ(0, auto_analyzer.AnalyzeTables());
+
+  auto_analyzer.RemoveTable(data_table->GetOid());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -149,5 +149,41 @@ TEST_F(TableStatsCollectorTests, MultiColumnTableTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(TableStatsCollectorTests, ParallelAndSampledTest) {
+  // Enough tuples for the tile groups to be scanned in parallel
+  const int tuples_per_tile_group = 100;
+  const int nrow = 20000;
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuples_per_tile_group, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), nrow, false, false,
+                                     false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The first column holds a distinct value per tuple
+  TableStatsCollector stats{data_table.get()};
+  stats.CollectColumnStats();
+  EXPECT_EQ(stats.GetActiveTupleCount(), nrow);
+  auto column_stats_collector = stats.GetColumnStats(0);
+  EXPECT_EQ(column_stats_collector->GetFracNull(), 0);
+  uint64_t cardinality = column_stats_collector->GetCardinality();
+  double cardinality_error = column_stats_collector->GetCardinalityError();
+  EXPECT_GE(cardinality, nrow * (1 - cardinality_error));
+  EXPECT_LE(cardinality, nrow * (1 + cardinality_error));
+  EXPECT_GE(column_stats_collector->GetHistogramBound().size(), 1);
+
+  // Sample a tenth of the tile groups. The tuple count is still exact, and
+  // the distinct count is extrapolated since all sampled values are distinct.
+  TableStatsCollector sampled_stats{data_table.get(), nrow / 10};
+  sampled_stats.CollectColumnStats();
+  EXPECT_EQ(sampled_stats.GetActiveTupleCount(), nrow);
+  column_stats_collector = sampled_stats.GetColumnStats(0);
+  EXPECT_EQ(column_stats_collector->GetFracNull(), 0);
+  cardinality = column_stats_collector->GetCardinality();
+  EXPECT_GE(cardinality, nrow * (1 - 3 * cardinality_error));
+  EXPECT_LE(cardinality, nrow * (1 + 3 * cardinality_error));
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -165,5 +165,33 @@ TEST_F(TopKElementsTests, UniformTest) {
 
   top_k_elements.PrintAllOrderedMaxFirst();
 }
+
+TEST_F(TopKElementsTests, MergeTest) {
+  CountMinSketch sketch(10, 20, 0);
+  const int k = 3;
+  TopKElements top_k1(sketch, k), top_k2(sketch, k);
+
+  // Item 1 is only among the top items of the first half, item 5 only among
+  // those of the second, but both are frequent overall
+  top_k1.Add(1, 100);
+  top_k1.Add(2, 50);
+  top_k1.Add(3, 40);
+  top_k2.Add(1, 10);
+  top_k2.Add(4, 30);
+  top_k2.Add(5, 90);
+  top_k2.Add(3, 20);
+
+  top_k1.Merge(top_k2);
+  EXPECT_EQ(top_k1.tkq.get_size(), k);
+
+  auto entries = top_k1.RetrieveAllOrderedMaxFirst();
+  ASSERT_EQ(entries.size(), k);
+  EXPECT_EQ(entries[0].approx_top_elem.int_item, 1);
+  EXPECT_EQ(entries[0].approx_count, 110);
+  EXPECT_EQ(entries[1].approx_top_elem.int_item, 5);
+  EXPECT_EQ(entries[1].approx_count, 90);
+  EXPECT_EQ(entries[2].approx_top_elem.int_item, 3);
+  EXPECT_EQ(entries[2].approx_count, 60);
+}
 }
 }
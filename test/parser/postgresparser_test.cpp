@@ -1241,5 +1241,90 @@ TEST_F(PostgresParserTests, TypeCastInExpressionTest) {
   }
 }
 
+TEST_F(PostgresParserTests, InListTest) {
+  auto parser = parser::PostgresParser::GetInstance();
+
+  std::string query = "SELECT * FROM foo WHERE id IN (1, 2, 3);";
+  std::unique_ptr<parser::SQLStatementList> stmt_list(
+      parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  auto select_stmt =
+      (parser::SelectStatement *)(stmt_list->statements[0].get());
+  auto *in_list = select_stmt->where_clause.get();
+  EXPECT_EQ(ExpressionType::COMPARE_IN, in_list->GetExpressionType());
+  EXPECT_EQ(ExpressionType::VALUE_VECTOR,
+            in_list->GetChild(1)->GetExpressionType());
+  EXPECT_EQ(3, in_list->GetChild(1)->GetChildrenSize());
+
+  query = "SELECT * FROM foo WHERE id NOT IN (1, 2);";
+  stmt_list.reset(parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  select_stmt = (parser::SelectStatement *)(stmt_list->statements[0].get());
+  auto *not_in_list = select_stmt->where_clause.get();
+  EXPECT_EQ(ExpressionType::OPERATOR_NOT, not_in_list->GetExpressionType());
+  EXPECT_EQ(ExpressionType::COMPARE_IN,
+            not_in_list->GetChild(0)->GetExpressionType());
+}
+
+TEST_F(PostgresParserTests, CopyFromStdinTest) {
+  auto parser = parser::PostgresParser::GetInstance();
+
+  // Without any options, the data is in text format
+  std::string query = "COPY foo FROM STDIN;";
+  std::unique_ptr<parser::SQLStatementList> stmt_list(
+      parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  EXPECT_EQ(StatementType::COPY, stmt_list->GetStatement(0)->GetType());
+  auto copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ("foo", copy_stmt->table->GetTableName());
+  EXPECT_TRUE(copy_stmt->is_from);
+  EXPECT_TRUE(copy_stmt->file_path.empty());
+  EXPECT_EQ(ExternalFileFormat::TEXT, copy_stmt->format);
+  EXPECT_EQ('\t', copy_stmt->delimiter);
+
+  // Text format with a custom delimiter
+  query = "COPY foo TO STDOUT WITH (FORMAT text, DELIMITER '|');";
+  stmt_list.reset(parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_FALSE(copy_stmt->is_from);
+  EXPECT_EQ(ExternalFileFormat::TEXT, copy_stmt->format);
+  EXPECT_EQ('|', copy_stmt->delimiter);
+
+  // CSV without options gets the CSV defaults
+  query = "COPY foo FROM STDIN WITH (FORMAT csv);";
+  stmt_list.reset(parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ(ExternalFileFormat::CSV, copy_stmt->format);
+  EXPECT_EQ(',', copy_stmt->delimiter);
+  EXPECT_EQ('"', copy_stmt->quote);
+  EXPECT_EQ('"', copy_stmt->escape);
+
+  // Binary is parsed, the network layer rejects it
+  query = "COPY foo FROM STDIN WITH (FORMAT binary);";
+  stmt_list.reset(parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ(ExternalFileFormat::BINARY, copy_stmt->format);
+  EXPECT_EQ('"', copy_stmt->quote);
+  EXPECT_EQ('"', copy_stmt->escape);
+
+  // With options
+  query =
+      "COPY foo FROM STDIN WITH (FORMAT csv, DELIMITER '|', QUOTE '$', "
+      "ESCAPE '#');";
+  stmt_list.reset(parser.BuildParseTree(query).release());
+  EXPECT_TRUE(stmt_list->is_valid);
+  copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ("foo", copy_stmt->table->GetTableName());
+  EXPECT_TRUE(copy_stmt->is_from);
+  EXPECT_TRUE(copy_stmt->file_path.empty());
+  EXPECT_EQ(ExternalFileFormat::CSV, copy_stmt->format);
+  EXPECT_EQ('|', copy_stmt->delimiter);
+  EXPECT_EQ('$', copy_stmt->quote);
+  EXPECT_EQ('#', copy_stmt->escape);
+}
+
 }  // namespace test
 }  // namespace peloton
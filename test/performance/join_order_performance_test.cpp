@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_order_performance_test.cpp
+//
+// Identification: test/performance/join_order_performance_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "binder/bind_node_visitor.h"
+#include "catalog/catalog.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/property_set.h"
+#include "parser/postgresparser.h"
+#include "settings/settings_manager.h"
+#include "sql/testing_sql_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Join Order Performance Tests
+//
+// Compares optimization latency and the cost of the resulting plan between
+// join order enumeration with DPhyp and with the join order transformation
+// rules, on star and snowflake joins of 4 to 12 tables.
+//===--------------------------------------------------------------------===//
+
+class JoinOrderPerformanceTests : public PelotonTest {
+ protected:
+  virtual void SetUp() override {
+    PelotonTest::SetUp();
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto txn = txn_manager.BeginTransaction();
+    catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+    txn_manager.CommitTransaction(txn);
+  }
+
+  virtual void TearDown() override {
+    settings::SettingsManager::SetInt(
+        settings::SettingId::max_dphyp_join_relations, 12);
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto txn = txn_manager.BeginTransaction();
+    catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+    txn_manager.CommitTransaction(txn);
+    PelotonTest::TearDown();
+  }
+};
+
+// Create a table with the given number of rows, where column "id" is unique
+// and column "fk" references rows of another table with the given size
+static void CreateTable(const std::string &name, int num_rows,
+                        int referenced_rows) {
+  TestingSQLUtil::ExecuteSQLQuery("CREATE TABLE " + name +
+                                  "(id INT PRIMARY KEY, fk INT, val INT);");
+  for (int row = 0; row < num_rows; row++) {
+    TestingSQLUtil::ExecuteSQLQuery(
+        "INSERT INTO " + name + " VALUES (" + std::to_string(row) + ", " +
+        std::to_string(row % referenced_rows) + ", " +
+        std::to_string(row % 7) + ");");
+  }
+}
+
+// Optimize the query and report the optimization latency (in ms) and the cost
+// of the best plan found
+static void OptimizeQuery(const std::string &query, int max_dphyp_relations,
+                          double &latency, double &cost) {
+  settings::SettingsManager::SetInt(
+      settings::SettingId::max_dphyp_join_relations, max_dphyp_relations);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto stmt = peloton_parser.BuildParseTree(query);
+  auto parse_tree = stmt->GetStatement(0);
+  auto bind_node_visitor = binder::BindNodeVisitor(txn, DEFAULT_DB_NAME);
+  bind_node_visitor.BindNameToNode(parse_tree);
+
+  optimizer::Optimizer optimizer;
+  optimizer.GetMetadata().txn = txn;
+  auto gexpr = optimizer.TestInsertQueryTree(parse_tree, txn);
+  auto root_group_id = gexpr->GetGroupID();
+  auto required_props = std::make_shared<optimizer::PropertySet>();
+
+  Timer<std::milli> timer;
+  timer.Start();
+  try {
+    optimizer.OptimizeLoop(root_group_id, required_props);
+  } catch (OptimizerException &e) {
+    LOG_WARN("Optimize Loop ended prematurely: %s", e.what());
+  }
+  timer.Stop();
+  latency = timer.GetDuration();
+
+  auto best_expr = optimizer.GetMetadata()
+                       .memo.GetGroupByID(root_group_id)
+                       ->GetBestExpression(required_props);
+  EXPECT_NE(nullptr, best_expr);
+  cost = (best_expr != nullptr ? best_expr->GetCost(required_props) : -1);
+
+  optimizer.Reset();
+  txn_manager.CommitTransaction(txn);
+}
+
+// Optimize a join of the tables, connected by the given pairs of referencing
+// and referenced tables, with and without DPhyp
+static void RunJoinBenchmark(
+    const std::string &shape, const std::vector<std::string> &tables,
+    const std::vector<std::pair<std::string, std::string>> &edges) {
+  std::string query = "SELECT * FROM ";
+  for (size_t i = 0; i < tables.size(); i++) {
+    query += (i == 0 ? "" : ", ") + tables[i];
+  }
+  for (size_t i = 0; i < edges.size(); i++) {
+    query += (i == 0 ? " WHERE " : " AND ") + edges[i].first + ".fk = " +
+             edges[i].second + ".id";
+  }
+
+  double rule_latency, rule_cost, dphyp_latency, dphyp_cost;
+  OptimizeQuery(query, 0, rule_latency, rule_cost);
+  OptimizeQuery(query, 64, dphyp_latency, dphyp_cost);
+
+  LOG_INFO("%s join of %lu tables: rules %.2f ms (cost %.2f), "
+           "DPhyp %.2f ms (cost %.2f)",
+           shape.c_str(), tables.size(), rule_latency, rule_cost,
+           dphyp_latency, dphyp_cost);
+}
+
+TEST_F(JoinOrderPerformanceTests, StarJoinTest) {
+  // A fact table referencing every dimension table
+  const size_t max_tables = 12;
+  CreateTable("fact", 1000, 1000);
+  std::vector<std::string> tables = {"fact"};
+  std::vector<std::pair<std::string, std::string>> edges;
+  for (int i = 1; i < static_cast<int>(max_tables); i++) {
+    auto dim = "dim" + std::to_string(i);
+    CreateTable(dim, 10 * i, 10 * i);
+    tables.push_back(dim);
+    edges.emplace_back("fact", dim);
+  }
+  TestingSQLUtil::ExecuteSQLQuery("ANALYZE;");
+
+  for (size_t num_tables = 4; num_tables <= max_tables; num_tables += 2) {
+    RunJoinBenchmark(
+        "Star", std::vector<std::string>(tables.begin(),
+                                         tables.begin() + num_tables),
+        std::vector<std::pair<std::string, std::string>>(
+            edges.begin(), edges.begin() + num_tables - 1));
+  }
+}
+
+TEST_F(JoinOrderPerformanceTests, SnowflakeJoinTest) {
+  // A fact table referencing dimension tables, each of which references a
+  // sub-dimension table
+  const int max_tables = 12;
+  CreateTable("fact", 1000, 1000);
+  std::vector<std::string> tables = {"fact"};
+  std::vector<std::pair<std::string, std::string>> edges;
+  for (int i = 1; 2 * i <= max_tables; i++) {
+    auto dim = "dim" + std::to_string(i);
+    auto subdim = "subdim" + std::to_string(i);
+    CreateTable(dim, 20 * i, 5 * i);
+    CreateTable(subdim, 5 * i, 5 * i);
+    tables.push_back(dim);
+    edges.emplace_back("fact", dim);
+    tables.push_back(subdim);
+    edges.emplace_back(dim, subdim);
+  }
+  TestingSQLUtil::ExecuteSQLQuery("ANALYZE;");
+
+  for (size_t num_tables = 5; num_tables <= tables.size();
+       num_tables += 2) {
+    RunJoinBenchmark(
+        "Snowflake", std::vector<std::string>(tables.begin(),
+                                              tables.begin() + num_tables),
+        std::vector<std::pair<std::string, std::string>>(
+            edges.begin(), edges.begin() + num_tables - 1));
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
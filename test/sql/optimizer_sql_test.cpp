@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
 
 #include "catalog/catalog.h"
@@ -17,8 +18,13 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/create_executor.h"
 #include "optimizer/optimizer.h"
+#include "parser/postgresparser.h"
+#include "parser/select_statement.h"
 #include "planner/create_plan.h"
+#include "planner/hash_join_plan.h"
 #include "planner/order_by_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
 #include "sql/testing_sql_util.h"
 
 using std::shared_ptr;
@@ -671,6 +677,70 @@ TEST_F(OptimizerSQLTests, JoinTest) {
       false);
 }
 
+TEST_F(OptimizerSQLTests, SemiJoinTest) {
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test2(a INT PRIMARY KEY, b INT, c INT);");
+
+  // Two partners for test.b = 22, one for test.b = 11, none for 33 and 0
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (1, 22, 000);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (2, 22, 000);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (3, 11, 000);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (4, 99, 000);");
+
+  // SQL has no syntax for semi joins, so turn an inner join into one. Every
+  // use binds the statement, so parse a fresh one each time.
+  auto parse_semi_join = []() {
+    auto &peloton_parser = parser::PostgresParser::GetInstance();
+    auto parsed_stmt = peloton_parser.BuildParseTree(
+        "SELECT test.a FROM test JOIN test2 ON test.b = test2.b");
+    auto select =
+        static_cast<parser::SelectStatement *>(parsed_stmt->GetStatement(0));
+    select->from_table->join->type = JoinType::SEMI;
+    return parsed_stmt;
+  };
+
+  // The optimizer plans a semi hash join that builds the hash table over the
+  // inner side and probes it with the outer side, which it produces
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto plan = TestingSQLUtil::GeneratePlanWithOptimizer(
+      optimizer, parse_semi_join(), txn);
+  txn_manager.CommitTransaction(txn);
+
+  ASSERT_EQ(PlanNodeType::HASHJOIN, plan->GetPlanNodeType());
+  auto join_plan = static_cast<planner::HashJoinPlan *>(plan.get());
+  EXPECT_EQ(JoinType::SEMI, join_plan->GetJoinType());
+  ASSERT_EQ(2U, join_plan->GetChildren().size());
+  ASSERT_EQ(PlanNodeType::SEQSCAN,
+            join_plan->GetChild(0)->GetPlanNodeType());
+  auto build_scan =
+      static_cast<const planner::SeqScanPlan *>(join_plan->GetChild(0));
+  EXPECT_EQ("test2", build_scan->GetTable()->GetName());
+  ASSERT_EQ(PlanNodeType::HASH, join_plan->GetChild(1)->GetPlanNodeType());
+  ASSERT_EQ(PlanNodeType::SEQSCAN,
+            join_plan->GetChild(1)->GetChild(0)->GetPlanNodeType());
+  auto probe_scan = static_cast<const planner::SeqScanPlan *>(
+      join_plan->GetChild(1)->GetChild(0));
+  EXPECT_EQ("test", probe_scan->GetTable()->GetName());
+
+  // Every row of test with a partner is produced once, however many it has,
+  // both by the compiled and by the interpreted plan
+  for (bool codegen : {true, false}) {
+    settings::SettingsManager::SetBool(settings::SettingId::codegen, codegen);
+    TestingSQLUtil::ExecuteSQLQueryWithOptimizer(
+        optimizer, parse_semi_join(), result, tuple_descriptor, rows_changed,
+        error_message);
+    vector<string> actual_result;
+    for (unsigned i = 0; i < result.size(); i++) {
+      actual_result.push_back(
+          TestingSQLUtil::GetResultValueAsString(result, i));
+    }
+    std::sort(actual_result.begin(), actual_result.end());
+    EXPECT_EQ(vector<string>({"1", "2"}), actual_result);
+  }
+  settings::SettingsManager::SetBool(settings::SettingId::codegen, true);
+}
+
 TEST_F(OptimizerSQLTests, IndexTest) {
   TestingSQLUtil::ExecuteSQLQuery(
       "create table foo(a int, b varchar(32), primary key(a, b));");
@@ -668,5 +668,47 @@ TEST_F(OrderBySQLTests, OrderByWithNullCheck) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(OrderBySQLTests, OrderByVarcharPrefixTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  TestingSQLUtil::ExecuteSQLQuery("CREATE TABLE test(a INT, d VARCHAR);");
+
+  // Strings that share, or only differ in the last byte of, the 4-byte prefix
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (1, 'abda');");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (2, 'abcz');");
+  TestingSQLUtil::ExecuteSQLQuery(
+      "INSERT INTO test VALUES (3, 'abcdefghijklmnop');");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (4, 'abcd');");
+  TestingSQLUtil::ExecuteSQLQuery(
+      "INSERT INTO test VALUES (5, 'abcdefghijklmnoq');");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (6, 'abc');");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (7, 'zaaa');");
+
+  std::string query = "SELECT d FROM test ORDER BY d ASC";
+  std::vector<std::string> exp = {"abc", "abcd", "abcdefghijklmnop",
+                                  "abcdefghijklmnoq", "abcz", "abda", "zaaa"};
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(query, exp, true);
+
+  query = "SELECT a FROM test WHERE d = 'abcdefghijklmnoq'";
+  exp = {"5"};
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(query, exp, false);
+
+  query = "SELECT a FROM test WHERE d < 'abcz'";
+  exp = {"3", "4", "5", "6"};
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(query, exp, false);
+
+  query = "SELECT a FROM test WHERE d >= 'abda'";
+  exp = {"1", "7"};
+  TestingSQLUtil::ExecuteSQLQueryAndCheckResult(query, exp, false);
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache_sql_test.cpp
+//
+// Identification: test/sql/plan_cache_sql_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "common/plan_cache.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "settings/settings_manager.h"
+#include "sql/testing_sql_util.h"
+#include "storage/data_table.h"
+#include "storage/zone_map_manager.h"
+
+namespace peloton {
+namespace test {
+
+class PlanCacheSQLTests : public PelotonTest {};
+
+TEST_F(PlanCacheSQLTests, ZoneMapSkippingTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  settings::SettingsManager::SetBool(settings::SettingId::plan_cache, true);
+  auto &plan_cache = PlanCache::GetInstance();
+  plan_cache.Clear();
+
+  TestingSQLUtil::ExecuteSQLQuery("CREATE TABLE test(a INT, b INT);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (1, 10);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (2, 20);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (3, 30);");
+
+  // Claim that no tile group holds a value of A below 100, so a scan that
+  // skips tile groups by the zone maps finds none of the rows
+  txn = txn_manager.BeginTransaction();
+  auto *table = catalog::Catalog::GetInstance()->GetTableWithName(
+      txn, DEFAULT_DB_NAME, DEFAULT_SCHEMA_NAME, "test");
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+  zone_map_manager->CreateZoneMapTableInCatalog();
+  for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset++) {
+    zone_map_manager->CreateOrUpdateZoneMapInCatalog(
+        table->GetDatabaseOid(), table->GetOid(), offset, 0, "100", "200",
+        TypeIdToString(type::TypeId::INTEGER), txn);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // B has no zone maps, so its rows are found
+  std::vector<ResultValue> result;
+  EXPECT_EQ(ResultType::SUCCESS,
+            TestingSQLUtil::ExecuteSimpleSQLQuery(
+                "SELECT a FROM test WHERE b = 20;", result));
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ("2", TestingSQLUtil::GetResultValueAsString(result, 0));
+
+  // The first query is planned with its constant, the second one plans the
+  // shared plan and the last one reuses it. All of them skip the tile groups.
+  for (auto &query : {"SELECT b FROM test WHERE a = 1;",
+                      "SELECT b FROM test WHERE a = 2;",
+                      "SELECT b FROM test WHERE a = 3;"}) {
+    result.clear();
+    EXPECT_EQ(ResultType::SUCCESS,
+              TestingSQLUtil::ExecuteSimpleSQLQuery(query, result));
+    EXPECT_EQ(0, result.size());
+  }
+  EXPECT_EQ(2, plan_cache.GetSize());
+
+  plan_cache.Clear();
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
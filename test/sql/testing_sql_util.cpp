@@ -120,13 +120,21 @@ ResultType TestingSQLUtil::ExecuteSQLQueryWithOptimizer(
     std::vector<FieldInfo> &tuple_descriptor, int &rows_changed,
     std::string &error_message) {
   auto &peloton_parser = parser::PostgresParser::GetInstance();
+  return ExecuteSQLQueryWithOptimizer(
+      optimizer, peloton_parser.BuildParseTree(query), result,
+      tuple_descriptor, rows_changed, error_message);
+}
+
+ResultType TestingSQLUtil::ExecuteSQLQueryWithOptimizer(
+    std::unique_ptr<optimizer::AbstractOptimizer> &optimizer,
+    std::unique_ptr<parser::SQLStatementList> parsed_stmt,
+    std::vector<ResultValue> &result, std::vector<FieldInfo> &tuple_descriptor,
+    int &rows_changed, std::string &error_message) {
   std::vector<type::Value> params;
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
   traffic_cop_.SetTcopTxnState(txn);
 
-  auto parsed_stmt = peloton_parser.BuildParseTree(query);
-
   auto bind_node_visitor = binder::BindNodeVisitor(txn, DEFAULT_DB_NAME);
   bind_node_visitor.BindNameToNode(parsed_stmt->GetStatement(0));
 
@@ -163,9 +171,15 @@ TestingSQLUtil::GeneratePlanWithOptimizer(
     std::unique_ptr<optimizer::AbstractOptimizer> &optimizer,
     const std::string query, concurrency::TransactionContext *txn) {
   auto &peloton_parser = parser::PostgresParser::GetInstance();
+  return GeneratePlanWithOptimizer(
+      optimizer, peloton_parser.BuildParseTree(query), txn);
+}
 
-  auto parsed_stmt = peloton_parser.BuildParseTree(query);
-
+std::shared_ptr<planner::AbstractPlan>
+TestingSQLUtil::GeneratePlanWithOptimizer(
+    std::unique_ptr<optimizer::AbstractOptimizer> &optimizer,
+    std::unique_ptr<parser::SQLStatementList> parsed_stmt,
+    concurrency::TransactionContext *txn) {
   auto bind_node_visitor = binder::BindNodeVisitor(txn, DEFAULT_DB_NAME);
   bind_node_visitor.BindNameToNode(parsed_stmt->GetStatement(0));
 
@@ -211,6 +225,41 @@ ResultType TestingSQLUtil::ExecuteSQLQuery(const std::string query,
   return status;
 }
 
+// Execute a SQL query end-to-end as a query of the simple query protocol,
+// which may share its plan with other queries through the plan cache
+ResultType TestingSQLUtil::ExecuteSimpleSQLQuery(
+    const std::string query, std::vector<ResultValue> &result) {
+  std::string unnamed_statement = "unnamed";
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto sql_stmt_list = peloton_parser.BuildParseTree(query);
+  PELOTON_ASSERT(sql_stmt_list);
+  if (!sql_stmt_list->is_valid) {
+    return ResultType::FAILURE;
+  }
+  std::vector<type::Value> param_values;
+  auto statement = traffic_cop_.PrepareStatement(
+      unnamed_statement, query, std::move(sql_stmt_list), 0, &param_values);
+  if (statement.get() == nullptr) {
+    traffic_cop_.setRowsAffected(0);
+    return ResultType::FAILURE;
+  }
+  if (!param_values.empty()) {
+    statement->GetPlanTree()->SetParameterValues(&param_values);
+  }
+  bool unnamed = false;
+  std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
+  counter_.store(1);
+  auto status = traffic_cop_.ExecuteStatement(statement, param_values, unnamed,
+                                              nullptr, result_format, result);
+  if (traffic_cop_.GetQueuing()) {
+    ContinueAfterComplete();
+    traffic_cop_.ExecuteStatementPlanGetResult();
+    status = traffic_cop_.ExecuteStatementGetResult();
+    traffic_cop_.SetQueuing(false);
+  }
+  return status;
+}
+
 ResultType TestingSQLUtil::ExecuteSQLQuery(const std::string query) {
   std::vector<ResultValue> result;
   std::vector<FieldInfo> tuple_descriptor;
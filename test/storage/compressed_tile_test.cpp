@@ -0,0 +1,345 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_tile_test.cpp
+//
+// Identification: test/storage/compressed_tile_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "settings/settings_manager.h"
+#include "storage/compressed_tile.h"
+#include "storage/data_table.h"
+#include "storage/layout.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "storage/zone_map_manager.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile Tests
+//===--------------------------------------------------------------------===//
+
+class CompressedTileTests : public PelotonTest {};
+
+TEST_F(CompressedTileTests, EncodingTest) {
+  const int tuple_count = 100;
+
+  std::vector<catalog::Column> columns{
+      catalog::Column(type::TypeId::BIGINT,
+                      type::Type::GetTypeSize(type::TypeId::BIGINT), "A", true),
+      catalog::Column(type::TypeId::DECIMAL,
+                      type::Type::GetTypeSize(type::TypeId::DECIMAL), "B",
+                      true),
+      catalog::Column(type::TypeId::DECIMAL,
+                      type::Type::GetTypeSize(type::TypeId::DECIMAL), "C",
+                      true),
+      catalog::Column(type::TypeId::VARCHAR, 25, "D", false)};
+  catalog::Schema schema(columns);
+  std::shared_ptr<const storage::Layout> layout(
+      new const storage::Layout(schema.GetColumnCount()));
+
+  std::unique_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr,
+          {schema}, layout, tuple_count));
+
+  // A: large values in a small range, B: few distinct values, C: all distinct
+  // values, D: few distinct strings and NULLs
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int i = 0; i < tuple_count; i++) {
+    storage::Tuple tuple(&schema, true);
+    tuple.SetValue(0, type::ValueFactory::GetBigIntValue(1000000000000 + i),
+                   pool);
+    tuple.SetValue(1, type::ValueFactory::GetDecimalValue(i % 4 * 0.5), pool);
+    tuple.SetValue(2, type::ValueFactory::GetDecimalValue(i * 1.1), pool);
+    if (i % 3 == 0) {
+      tuple.SetValue(
+          3, type::ValueFactory::GetNullValueByType(type::TypeId::VARCHAR),
+          pool);
+    } else {
+      tuple.SetValue(3, type::ValueFactory::GetVarcharValue(
+                            "value" + std::to_string(i % 2)),
+                     pool);
+    }
+    EXPECT_NE(INVALID_OID, tile_group->InsertTuple(&tuple));
+  }
+
+  auto *tile = tile_group->GetTile(0);
+  storage::CompressedTile compressed_tile(
+      *tile, INVALID_OID, tile_group->GetHeader(), tile_group.get(),
+      tuple_count);
+
+  EXPECT_TRUE(compressed_tile.IsCompressed());
+  EXPECT_EQ(storage::CompressedTile::Encoding::FRAME_OF_REFERENCE,
+            compressed_tile.GetEncoding(0));
+  EXPECT_EQ(storage::CompressedTile::Encoding::DICTIONARY,
+            compressed_tile.GetEncoding(1));
+  EXPECT_EQ(storage::CompressedTile::Encoding::PLAIN,
+            compressed_tile.GetEncoding(2));
+  EXPECT_EQ(storage::CompressedTile::Encoding::DICTIONARY,
+            compressed_tile.GetEncoding(3));
+  EXPECT_LT(compressed_tile.GetCompressedSize(),
+            tuple_count * schema.GetLength());
+
+  // Every value must survive the round trip
+  for (int i = 0; i < tuple_count; i++) {
+    for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+         column_id++) {
+      type::Value expected = tile->GetValue(i, column_id);
+      type::Value actual = compressed_tile.GetValue(i, column_id);
+      if (expected.IsNull()) {
+        EXPECT_TRUE(actual.IsNull());
+      } else {
+        EXPECT_EQ(CmpBool::CmpTrue, expected.CompareEquals(actual));
+      }
+    }
+  }
+
+  // Decompressing gives back the original fixed-length slots
+  std::unique_ptr<char[]> data{new char[tuple_count * schema.GetLength()]};
+  compressed_tile.Decompress(data.get());
+  for (int i = 0; i < tuple_count; i++) {
+    storage::Tuple tuple(&schema, data.get() + i * schema.GetLength());
+    for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+         column_id++) {
+      type::Value expected = tile->GetValue(i, column_id);
+      type::Value actual = tuple.GetValue(column_id);
+      if (expected.IsNull()) {
+        EXPECT_TRUE(actual.IsNull());
+      } else {
+        EXPECT_EQ(CmpBool::CmpTrue, expected.CompareEquals(actual));
+      }
+    }
+  }
+
+  // Concurrent scans share a single decompressed copy. Without any room in
+  // the cache, it is only kept while scans pin it.
+  settings::SettingsManager::SetInt(
+      settings::SettingId::decompressed_tile_cache_size, 0);
+  auto &cache = storage::DecompressedTileCache::GetInstance();
+  const size_t size = tuple_count * schema.GetLength();
+  const char *decompressed = compressed_tile.PinDecompressedData();
+  EXPECT_EQ(0, std::memcmp(data.get(), decompressed, size));
+  EXPECT_EQ(decompressed, compressed_tile.PinDecompressedData());
+  EXPECT_EQ(size, cache.GetSize());
+
+  storage::CompressedTile other_tile(*tile, INVALID_OID,
+                                     tile_group->GetHeader(), tile_group.get(),
+                                     tuple_count);
+  other_tile.PinDecompressedData();
+  other_tile.UnpinDecompressedData();
+  EXPECT_EQ(2 * size, cache.GetSize());
+
+  // Once unpinned, the copies are evicted by the next tile decompressed
+  compressed_tile.UnpinDecompressedData();
+  compressed_tile.UnpinDecompressedData();
+  storage::CompressedTile third_tile(*tile, INVALID_OID,
+                                     tile_group->GetHeader(), tile_group.get(),
+                                     tuple_count);
+  third_tile.PinDecompressedData();
+  EXPECT_EQ(size, cache.GetSize());
+  third_tile.UnpinDecompressedData();
+
+  // ... and decompressed again when a scan needs them
+  decompressed = compressed_tile.PinDecompressedData();
+  EXPECT_EQ(0, std::memcmp(data.get(), decompressed, size));
+  compressed_tile.UnpinDecompressedData();
+  settings::SettingsManager::SetInt(
+      settings::SettingId::decompressed_tile_cache_size, 64);
+
+  // Predicates can be evaluated on the distinct values of dictionary columns
+  EXPECT_TRUE(compressed_tile.IsDictionaryEncoded(1));
+  EXPECT_FALSE(compressed_tile.IsDictionaryEncoded(2));
+  EXPECT_EQ(4U, compressed_tile.GetDictionarySize(1));
+  for (int i = 0; i < tuple_count; i++) {
+    type::Value value = compressed_tile.GetDictionaryValue(
+        1, compressed_tile.GetCode(1, i));
+    EXPECT_EQ(CmpBool::CmpTrue,
+              value.CompareEquals(compressed_tile.GetValue(i, 1)));
+  }
+
+  // The value ranges skip NULLs
+  type::Value min, max;
+  EXPECT_TRUE(compressed_tile.GetColumnRange(0, min, max));
+  EXPECT_EQ(1000000000000, min.GetAs<int64_t>());
+  EXPECT_EQ(1000000000000 + tuple_count - 1, max.GetAs<int64_t>());
+  EXPECT_TRUE(compressed_tile.GetColumnRange(3, min, max));
+  EXPECT_EQ("value0", min.ToString());
+  EXPECT_EQ("value1", max.ToString());
+}
+
+TEST_F(CompressedTileTests, StringDictionaryTest) {
+  const int tuple_count = 100;
+  const std::vector<std::string> strs{"pending", "a long shipped string",
+                                      "cancelled", "delivered"};
+
+  std::vector<catalog::Column> columns{
+      catalog::Column(type::TypeId::VARCHAR, 25, "A", false)};
+  catalog::Schema schema(columns);
+  std::shared_ptr<const storage::Layout> layout(
+      new const storage::Layout(schema.GetColumnCount()));
+
+  std::unique_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr,
+          {schema}, layout, tuple_count));
+
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int i = 0; i < tuple_count; i++) {
+    storage::Tuple tuple(&schema, true);
+    if (i % 10 == 0) {
+      tuple.SetValue(
+          0, type::ValueFactory::GetNullValueByType(type::TypeId::VARCHAR),
+          pool);
+    } else {
+      tuple.SetValue(
+          0, type::ValueFactory::GetVarcharValue(strs[i % strs.size()]), pool);
+    }
+    EXPECT_NE(INVALID_OID, tile_group->InsertTuple(&tuple));
+  }
+
+  auto *tile = tile_group->GetTile(0);
+  storage::CompressedTile compressed_tile(
+      *tile, INVALID_OID, tile_group->GetHeader(), tile_group.get(),
+      tuple_count);
+  EXPECT_TRUE(compressed_tile.HasStringDictionary(0));
+
+  // The distinct strings are sorted, and NULL comes last
+  EXPECT_EQ(strs.size() + 1, compressed_tile.GetDictionarySize(0));
+  EXPECT_EQ(strs.size(), compressed_tile.GetNullCode(0));
+  EXPECT_TRUE(compressed_tile.GetDictionaryEntry(0, strs.size()).IsNull());
+  for (uint32_t code = 1; code < strs.size(); code++) {
+    EXPECT_LT(type::VarlenSlot::Compare(
+                  compressed_tile.GetDictionaryEntry(0, code - 1),
+                  compressed_tile.GetDictionaryEntry(0, code)),
+              0);
+  }
+
+  // Every tuple's code stands for its value
+  std::vector<uint32_t> codes(tuple_count);
+  compressed_tile.DecodeCodes(0, 0, tuple_count, codes.data());
+  for (int i = 0; i < tuple_count; i++) {
+    EXPECT_EQ(compressed_tile.GetCode(0, i), codes[i]);
+    type::Value expected = tile->GetValue(i, 0);
+    if (expected.IsNull()) {
+      EXPECT_EQ(compressed_tile.GetNullCode(0), codes[i]);
+      continue;
+    }
+    uint32_t code = compressed_tile.FindCode(0, expected.GetData(),
+                                             expected.GetLength());
+    EXPECT_EQ(code, codes[i]);
+  }
+
+  // Values missing from the dictionary fall between the codes
+  EXPECT_EQ(0U, compressed_tile.FindCode(0, "", 1));
+  EXPECT_EQ(2U, compressed_tile.FindCode(0, "d", 2));
+  EXPECT_EQ(strs.size(), compressed_tile.FindCode(0, "zzz", 4));
+  EXPECT_FALSE(compressed_tile.DictionaryContains(0, "d", 2));
+  EXPECT_TRUE(compressed_tile.DictionaryContains(0, "pending", 8));
+}
+
+TEST_F(CompressedTileTests, FreezeTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count + 1, false,
+                                     false, false, txn);
+
+  // Uncommitted tuples must not be frozen
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(0));
+  txn_manager.CommitTransaction(txn);
+
+  // The tuples are only cold once no running transaction can see an older
+  // version of them
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(0));
+  epoch_manager.SetCurrentEpochId(2);
+
+  // The second tile group is not full yet
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(1));
+
+  std::vector<std::vector<type::Value>> values;
+  auto tile_group = data_table->GetTileGroup(0);
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    values.emplace_back();
+    for (oid_t column_id = 0; column_id < 4; column_id++) {
+      values.back().push_back(tile_group->GetValue(tuple_id, column_id));
+    }
+  }
+
+  auto *frozen_tile_group = data_table->FreezeTileGroup(0);
+  ASSERT_NE(nullptr, frozen_tile_group);
+  EXPECT_TRUE(frozen_tile_group->IsFrozen());
+  EXPECT_TRUE(frozen_tile_group->GetHeader()->GetImmutability());
+  EXPECT_EQ(frozen_tile_group, data_table->GetTileGroup(0).get());
+  EXPECT_EQ(frozen_tile_group,
+            frozen_tile_group->GetHeader()->GetTileGroup());
+
+  // Equality predicates on a string column are checked against its
+  // dictionary, even if the value is within its range
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+  storage::PredicateInfo predicate;
+  predicate.col_id = 3;
+  predicate.comparison_operator =
+      static_cast<int>(ExpressionType::COMPARE_EQUAL);
+  predicate.predicate_value = type::ValueFactory::GetVarcharValue("13");
+  EXPECT_TRUE(zone_map_manager->ShouldScanTileGroup(&predicate, 1,
+                                                    data_table.get(), 0));
+  predicate.predicate_value = type::ValueFactory::GetVarcharValue("5");
+  EXPECT_FALSE(zone_map_manager->ShouldScanTileGroup(&predicate, 1,
+                                                     data_table.get(), 0));
+
+  // A frozen tile group stays as it is
+  EXPECT_EQ(nullptr, data_table->FreezeTileGroup(0));
+
+  // The tuples and their versions are the same as before
+  auto *header = frozen_tile_group->GetHeader();
+  EXPECT_EQ(tuple_count, header->GetCurrentNextTupleSlot());
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    EXPECT_EQ(INITIAL_TXN_ID, header->GetTransactionId(tuple_id));
+    EXPECT_EQ(MAX_CID, header->GetEndCommitId(tuple_id));
+    for (oid_t column_id = 0; column_id < 4; column_id++) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                values[tuple_id][column_id].CompareEquals(
+                    frozen_tile_group->GetValue(tuple_id, column_id)));
+    }
+  }
+
+  // The original stays sealed, so that transactions still holding on to it
+  // can't modify it anymore, while the frozen tile group takes writes
+  auto *old_header = tile_group->GetHeader();
+  EXPECT_TRUE(old_header->IsSealed());
+  EXPECT_FALSE(header->IsSealed());
+  txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(txn_manager.AcquireOwnership(txn, old_header, 0));
+  EXPECT_EQ(INITIAL_TXN_ID, old_header->GetTransactionId(0));
+  EXPECT_TRUE(txn_manager.AcquireOwnership(txn, header, 0));
+  txn_manager.YieldOwnership(txn, header, 0);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -18,7 +18,9 @@
 #include "storage/tile_group.h"
 #include "storage/database.h"
 
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace test {
@@ -72,6 +74,66 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
   data_table->TransformTileGroup(0, theta);
 }
 
+TEST_F(DataTableTests, MigrateTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  // Fill the first tile group, and switch to a column store before the next
+  // one is created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count - 1, false,
+                                     false, false, txn);
+  EXPECT_EQ(INVALID_OID, data_table->MigrateTileGroup(0, 0.0001, 2));
+  data_table->ResetDefaultLayout(LayoutType::COLUMN);
+  TestingExecutorUtil::PopulateTable(data_table.get(), 1, false, false, false,
+                                     txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The tuples are moved a batch at a time
+  auto tile_group = data_table->GetTileGroup(0);
+  EXPECT_EQ(tuple_count - 2, data_table->MigrateTileGroup(0, 0.0001, 2));
+  EXPECT_TRUE(tile_group->GetHeader()->IsDraining());
+  EXPECT_FALSE(tile_group->GetHeader()->GetImmutability());
+  EXPECT_EQ(0, data_table->MigrateTileGroup(0, 0.0001, tuple_count));
+
+  // A drained tile group is marked as draining as well
+  tile_group->GetHeader()->ResetDraining();
+  EXPECT_EQ(0, data_table->MigrateTileGroup(0, 0.0001, tuple_count));
+  EXPECT_TRUE(tile_group->GetHeader()->IsDraining());
+  EXPECT_FALSE(tile_group->GetHeader()->GetImmutability());
+
+  // The drained tile group is retired once no transaction can see its old
+  // versions anymore
+  EXPECT_FALSE(data_table->RetireTileGroup(0));
+  epoch_manager.SetCurrentEpochId(2);
+
+  // ... and the GC has recycled the old versions
+  tile_group->GetHeader()->AddGCPendingVersions(1);
+  EXPECT_FALSE(data_table->RetireTileGroup(0));
+  tile_group->GetHeader()->RemoveGCPendingVersion();
+  EXPECT_TRUE(data_table->RetireTileGroup(0));
+  EXPECT_EQ(nullptr, data_table->GetTileGroup(0));
+
+  // All tuples now live in column store tile groups
+  int live_tuple_count = 0;
+  for (oid_t offset = 1; offset < data_table->GetTileGroupCount(); offset++) {
+    auto new_tile_group = data_table->GetTileGroup(offset);
+    EXPECT_TRUE(new_tile_group->GetLayout().IsColumnStore());
+    auto *header = new_tile_group->GetHeader();
+    for (oid_t tuple_id = 0; tuple_id < header->GetCurrentNextTupleSlot();
+         tuple_id++) {
+      if (header->GetTransactionId(tuple_id) == INITIAL_TXN_ID &&
+          header->GetEndCommitId(tuple_id) == MAX_CID) {
+        live_tuple_count++;
+      }
+    }
+  }
+  EXPECT_EQ(tuple_count, live_tuple_count);
+}
 
 TEST_F(DataTableTests, GlobalTableTest) {
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
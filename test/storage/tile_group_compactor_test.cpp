@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor_test.cpp
+//
+// Identification: test/storage/tile_group_compactor_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_compactor.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactorTests : public PelotonTest {};
+
+TEST_F(TileGroupCompactorTests, CompactTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto &compactor = storage::TileGroupCompactor::GetInstance();
+  compactor.ClearTables();
+
+  auto database = TestingExecutorUtil::InitializeDatabase("database0");
+  oid_t db_id = database->GetOid();
+
+  // Two full tile groups with five keys each
+  const int num_key = 10;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TABLE0", db_id, 12346, 1235, true, 5));
+
+  // Leave a single live tuple in the first tile group
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler delete_scheduler(1, table.get(), &txn_manager);
+  for (int key = 0; key < 4; key++) {
+    delete_scheduler.Txn(0).Delete(key);
+  }
+  delete_scheduler.Txn(0).Commit();
+  delete_scheduler.Run();
+  EXPECT_EQ(ResultType::SUCCESS, delete_scheduler.schedules[0].txn_result);
+
+  // The second tile group is not sparse
+  EXPECT_EQ(INVALID_CID, table->CompactTileGroup(1, 0.3));
+
+  // The first tile group is compacted, but may not be retired while a
+  // transaction could still read its old versions
+  EXPECT_EQ(0, compactor.CompactTables());
+  auto tile_group = table->GetTileGroup(0);
+  ASSERT_NE(nullptr, tile_group);
+  EXPECT_TRUE(tile_group->GetHeader()->IsDraining());
+  EXPECT_FALSE(tile_group->GetHeader()->GetImmutability());
+  EXPECT_EQ(INVALID_CID, table->CompactTileGroup(0, 0.3));
+
+  epoch_manager.SetCurrentEpochId(2);
+  EXPECT_EQ(1, compactor.CompactTables());
+  EXPECT_EQ(nullptr, table->GetTileGroup(0));
+  EXPECT_NE(nullptr, table->GetTileGroup(1));
+
+  // The moved tuple is still found through the index
+  TransactionScheduler read_scheduler(1, table.get(), &txn_manager);
+  read_scheduler.Txn(0).Read(4);
+  read_scheduler.Txn(0).Read(9);
+  read_scheduler.Txn(0).Read(0);
+  read_scheduler.Txn(0).Commit();
+  read_scheduler.Run();
+  EXPECT_EQ(ResultType::SUCCESS, read_scheduler.schedules[0].txn_result);
+  ASSERT_EQ(3, read_scheduler.schedules[0].results.size());
+  EXPECT_EQ(0, read_scheduler.schedules[0].results[0]);
+  EXPECT_EQ(0, read_scheduler.schedules[0].results[1]);
+  EXPECT_EQ(-1, read_scheduler.schedules[0].results[2]);
+
+  compactor.ClearTables();
+  table.release();
+  TestingExecutorUtil::DeleteDatabase("database0");
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -25,7 +25,12 @@
 
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "common/init.h"
+#include "gc/gc_manager_factory.h"
+#include "index/index_factory.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace test {
@@ -36,6 +41,12 @@ namespace test {
 
 class IndexTunerTests : public PelotonTest {};
 
+// Lets the tests build an index the way the tuner does
+class TestingIndexTuner : public tuning::IndexTuner {
+ public:
+  using tuning::IndexTuner::BuildIndex;
+};
+
 TEST_F(IndexTunerTests, BasicTest) {
 
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
@@ -144,5 +155,84 @@ TEST_F(IndexTunerTests, BasicTest) {
 
 }
 
+TEST_F(IndexTunerTests, BuildIndexWithGCTest) {
+  // The GC threads free the Bw-Tree nodes no transaction can reach anymore
+  thread_pool.Initialize(0, CONNECTION_THREAD_COUNT + 3);
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  concurrency::EpochManagerFactory::GetInstance().StartEpoch();
+  gc::GCManagerFactory::Configure();
+  gc::GCManagerFactory::GetInstance().StartGC();
+
+  // Create a table and populate it
+  const int tuple_count = 20 * TESTS_TUPLES_PER_TILEGROUP;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Create an index on the first column, which the tuner fills
+  auto tuple_schema = data_table->GetSchema();
+  std::vector<oid_t> key_attrs = {0};
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto index_metadata = new index::IndexMetadata(
+      "tuner_gc_index", 1234, data_table->GetOid(),
+      data_table->GetDatabaseOid(), IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, tuple_schema, key_schema, key_attrs,
+      false);
+  std::shared_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(index_metadata));
+
+  // Meanwhile, keep inserting and deleting other keys, which leaves garbage
+  // nodes in the index for the GC to free
+  std::atomic<bool> done(false);
+  std::thread writer([&txn_manager, &index, &done] {
+    ItemPointer location(0, 0);
+    storage::Tuple key(index->GetKeySchema(), true);
+    const int key_count = 1000;
+    while (!done) {
+      for (bool insert : {true, false}) {
+        auto txn = txn_manager.BeginTransaction();
+        for (int i = 0; i < key_count; i++) {
+          key.SetValue(0, type::ValueFactory::GetIntegerValue(100000 + i),
+                       index->GetPool());
+          if (insert) {
+            index->InsertEntry(&key, &location);
+          } else {
+            index->DeleteEntry(&key, &location);
+          }
+        }
+        txn_manager.CommitTransaction(txn);
+      }
+    }
+  });
+
+  TestingIndexTuner index_tuner;
+  while (index->GetIndexedTileGroupOff() < data_table->GetTileGroupCount()) {
+    index_tuner.BuildIndex(data_table.get(), index);
+  }
+
+  done = true;
+  writer.join();
+
+  // Every tuple is indexed once, pointing to its version chain
+  std::vector<ItemPointer *> result;
+  txn = txn_manager.BeginTransaction();
+  index->ScanAllKeys(result);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(static_cast<size_t>(tuple_count), result.size());
+  for (auto *index_entry_ptr : result) {
+    EXPECT_NE(nullptr, index_entry_ptr);
+  }
+
+  gc::GCManagerFactory::GetInstance().StopGC();
+  concurrency::EpochManagerFactory::GetInstance().StopEpoch();
+  thread_pool.Shutdown();
+  gc::GCManagerFactory::Configure(0);
+}
+
 }  // namespace test
 }  // namespace peloton
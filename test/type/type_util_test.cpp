@@ -15,6 +15,7 @@
 
 #include "storage/tuple.h"
 #include "type/type_util.h"
+#include "type/varlen_slot.h"
 #include "type/value_factory.h"
 
 namespace peloton {
@@ -239,5 +240,54 @@ TEST_F(TypeUtilTests, CompareStringsTest) {
   } // FOR (str1)
 }
 
+TEST_F(TypeUtilTests, VarlenSlotTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<std::string> strs = {
+      "", "a", "abcd", "abcde", "abcdefghijk", "abcdefghijkl", "abcdefghijklm",
+      "abcdefghijklmnopqrstuvwxyz", "abce", "abcdefghijkz"};
+
+  std::vector<type::VarlenSlot> slots(strs.size());
+  for (size_t i = 0; i < strs.size(); i++) {
+    type::VarlenSlot::Set(reinterpret_cast<char *>(&slots[i]), strs[i].data(),
+                          strs[i].size(), pool);
+    EXPECT_FALSE(slots[i].IsNull());
+    EXPECT_EQ(strs[i].size(), slots[i].length);
+    EXPECT_EQ(strs[i].size() <= type::VARLEN_SLOT_INLINE_LENGTH,
+              slots[i].IsInlined());
+    EXPECT_EQ(slots[i].IsInlined(), slots[i].GetArea() == nullptr);
+    EXPECT_EQ(strs[i], std::string(slots[i].GetData(), slots[i].length));
+  }
+
+  for (size_t i = 0; i < strs.size(); i++) {
+    for (size_t j = 0; j < strs.size(); j++) {
+      int expected = strs[i].compare(strs[j]);
+      int result = type::VarlenSlot::Compare(slots[i], slots[j]);
+      EXPECT_EQ(expected < 0, result < 0);
+      EXPECT_EQ(expected > 0, result > 0);
+      EXPECT_EQ(expected == 0, type::VarlenSlot::Equals(slots[i], slots[j]));
+    }
+  }
+
+  type::VarlenSlot null_slot;
+  type::VarlenSlot::SetNull(reinterpret_cast<char *>(&null_slot));
+  EXPECT_TRUE(null_slot.IsNull());
+  EXPECT_EQ(nullptr, null_slot.GetArea());
+
+  // Short and long strings survive a roundtrip through a tuple
+  std::unique_ptr<catalog::Schema> schema(TypeUtilTestsGenerateSchema());
+  const oid_t column_id = schema->GetColumnCount() - 1;
+  for (auto &str : strs) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(column_id, type::ValueFactory::GetVarcharValue(str), pool);
+    auto value = tuple.GetValue(column_id);
+    EXPECT_EQ(str, value.ToString());
+  }
+  storage::Tuple tuple(schema.get(), true);
+  tuple.SetValue(column_id, type::ValueFactory::GetNullValueByType(
+                                type::TypeId::VARCHAR),
+                 pool);
+  EXPECT_TRUE(tuple.GetValue(column_id).IsNull());
+}
+
 }  // namespace test
 }  // namespace peloton